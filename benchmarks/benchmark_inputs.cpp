@@ -0,0 +1,336 @@
+/**
+* @file benchmarks/benchmark_inputs.cpp
+* @brief Inputs of the benchmarks.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <random>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "retdec/utils/filesystem.h"
+
+namespace retdec {
+namespace benchmarks {
+
+namespace {
+
+/// Name of the environment variable with a directory of sample files.
+const char *SampleFilesVariable = "RETDEC_BENCHMARK_INPUTS";
+
+std::size_t alignUp(std::size_t value, std::size_t alignment) {
+	return (value + alignment - 1) / alignment * alignment;
+}
+
+void put16(std::vector<std::uint8_t> &data, std::size_t offset,
+		std::uint16_t value) {
+	data[offset] = value & 0xff;
+	data[offset + 1] = value >> 8;
+}
+
+void put32(std::vector<std::uint8_t> &data, std::size_t offset,
+		std::uint32_t value) {
+	put16(data, offset, value & 0xffff);
+	put16(data, offset + 2, value >> 16);
+}
+
+} // anonymous namespace
+
+/**
+* @brief Returns @a size pseudo-random bytes generated from @a seed.
+*/
+std::vector<std::uint8_t> makeRandomBytes(std::size_t size,
+		std::uint32_t seed) {
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> byte(0, 255);
+
+	std::vector<std::uint8_t> data(size);
+	for (auto &b : data) {
+		b = byte(generator);
+	}
+	return data;
+}
+
+/**
+* @brief Returns @a size bytes that resemble a data section: runs of random
+*        bytes interleaved with zeros, ASCII strings, and little-endian wide
+*        strings.
+*/
+std::vector<std::uint8_t> makeStringRichBytes(std::size_t size,
+		std::uint32_t seed) {
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> kind(0, 3);
+	std::uniform_int_distribution<int> length(1, 40);
+	std::uniform_int_distribution<int> byte(0, 255);
+	std::uniform_int_distribution<int> printable(0x20, 0x7e);
+
+	std::vector<std::uint8_t> data;
+	data.reserve(size + 80);
+	while (data.size() < size) {
+		auto n = length(generator);
+		switch (kind(generator)) {
+			case 0:
+				for (int i = 0; i < n; ++i) {
+					data.push_back(byte(generator));
+				}
+				break;
+			case 1:
+				data.insert(data.end(), n % 8, 0);
+				break;
+			case 2:
+				for (int i = 0; i < n; ++i) {
+					data.push_back(printable(generator));
+				}
+				data.push_back(0);
+				break;
+			default:
+				for (int i = 0; i < n; ++i) {
+					data.push_back(printable(generator));
+					data.push_back(0);
+				}
+				data.insert(data.end(), 2, 0);
+				break;
+		}
+	}
+	data.resize(size);
+	return data;
+}
+
+/**
+* @brief Returns 32-bit x86 code of @a functions functions.
+*
+* Every function has a stack frame, arithmetic, memory accesses, a
+* conditional branch, and a relative call of the next function (the last one
+* calls the first one), so the whole code is reachable from its start at any
+* address.
+*/
+std::vector<std::uint8_t> makeX86Code(std::size_t functions) {
+	const std::size_t FunctionSize = 50;
+	const std::size_t CallEnd = 43;
+
+	std::vector<std::uint8_t> code;
+	code.reserve(functions * FunctionSize);
+	for (std::size_t i = 0; i < functions; ++i) {
+		auto start = code.size();
+		auto imm = static_cast<std::uint32_t>(i);
+		code.insert(code.end(), {
+			0x55,                   // push ebp
+			0x89, 0xe5,             // mov ebp, esp
+			0x83, 0xec, 0x10,       // sub esp, 0x10
+			0x8b, 0x45, 0x08,       // mov eax, [ebp+8]
+			0x05, 0, 0, 0, 0,       // add eax, i
+			0x89, 0x45, 0xfc,       // mov [ebp-4], eax
+			0x8b, 0x4d, 0xfc,       // mov ecx, [ebp-4]
+			0x0f, 0xaf, 0xc1,       // imul eax, ecx
+			0x29, 0xd1,             // sub ecx, edx
+			0x83, 0xf8, 0x0a,       // cmp eax, 10
+			0x7e, 0x05,             // jle +5
+			0xb8, 0, 0, 0, 0,       // mov eax, i
+			0x31, 0xd2,             // xor edx, edx
+			0x50,                   // push eax
+			0xe8, 0, 0, 0, 0,       // call next
+			0x83, 0xc4, 0x04,       // add esp, 4
+			0x89, 0xec,             // mov esp, ebp
+			0x5d,                   // pop ebp
+			0xc3                    // ret
+		});
+		put32(code, start + 10, imm);
+		put32(code, start + 31, imm);
+		auto next = (i + 1) % functions * FunctionSize;
+		put32(code, start + CallEnd - 4,
+			static_cast<std::uint32_t>(next - (start + CallEnd)));
+	}
+	return code;
+}
+
+/**
+* @brief Returns a 32-bit PE executable with @a sections sections of
+*        @a sectionSize bytes.
+*
+* The first section contains x86 code, the other ones string-rich data.
+*/
+std::vector<std::uint8_t> makePe(std::size_t sections,
+		std::size_t sectionSize) {
+	const std::size_t PeHeaderOffset = 0x40;
+	const std::size_t OptionalHeaderOffset = PeHeaderOffset + 4 + 20;
+	const std::size_t OptionalHeaderSize = 0xe0;
+	const std::size_t SectionTableOffset = OptionalHeaderOffset + OptionalHeaderSize;
+	const std::size_t FileAlignment = 0x200;
+	const std::size_t SectionAlignment = 0x1000;
+
+	auto headersSize = alignUp(SectionTableOffset + 40 * sections, FileAlignment);
+	auto rawSize = alignUp(sectionSize, FileAlignment);
+	auto virtualSize = alignUp(sectionSize, SectionAlignment);
+	auto imageSize = SectionAlignment + sections * virtualSize;
+
+	std::vector<std::uint8_t> pe(headersSize + sections * rawSize);
+
+	// DOS header.
+	put16(pe, 0x00, 0x5a4d);
+	put32(pe, 0x3c, PeHeaderOffset);
+
+	// PE signature and file header.
+	put32(pe, PeHeaderOffset, 0x4550);
+	put16(pe, PeHeaderOffset + 4, 0x14c);
+	put16(pe, PeHeaderOffset + 6, static_cast<std::uint16_t>(sections));
+	put16(pe, PeHeaderOffset + 20, OptionalHeaderSize);
+	put16(pe, PeHeaderOffset + 22, 0x102);
+
+	// Optional header.
+	auto oh = OptionalHeaderOffset;
+	put16(pe, oh + 0, 0x10b);
+	put32(pe, oh + 4, static_cast<std::uint32_t>(rawSize));
+	put32(pe, oh + 8, static_cast<std::uint32_t>(rawSize * (sections - 1)));
+	put32(pe, oh + 16, SectionAlignment);
+	put32(pe, oh + 20, SectionAlignment);
+	put32(pe, oh + 24, SectionAlignment);
+	put32(pe, oh + 28, static_cast<std::uint32_t>(ImageBase));
+	put32(pe, oh + 32, SectionAlignment);
+	put32(pe, oh + 36, FileAlignment);
+	put16(pe, oh + 40, 6);
+	put16(pe, oh + 48, 6);
+	put32(pe, oh + 56, static_cast<std::uint32_t>(imageSize));
+	put32(pe, oh + 60, static_cast<std::uint32_t>(headersSize));
+	put16(pe, oh + 68, 3);
+	put32(pe, oh + 72, 0x100000);
+	put32(pe, oh + 76, 0x1000);
+	put32(pe, oh + 80, 0x100000);
+	put32(pe, oh + 84, 0x1000);
+	put32(pe, oh + 92, 16);
+
+	// Section table and section data.
+	for (std::size_t i = 0; i < sections; ++i) {
+		auto sh = SectionTableOffset + 40 * i;
+		auto name = i == 0 ? std::string(".text") : ".s" + std::to_string(i);
+		std::copy_n(name.begin(), std::min<std::size_t>(name.size(), 8),
+			pe.begin() + sh);
+		auto rawOffset = headersSize + i * rawSize;
+		put32(pe, sh + 8, static_cast<std::uint32_t>(sectionSize));
+		put32(pe, sh + 12, static_cast<std::uint32_t>(SectionAlignment + i * virtualSize));
+		put32(pe, sh + 16, static_cast<std::uint32_t>(rawSize));
+		put32(pe, sh + 20, static_cast<std::uint32_t>(rawOffset));
+		put32(pe, sh + 36, i == 0 ? 0x60000020 : 0xc0000040);
+
+		auto content = i == 0
+			? makeX86Code(sectionSize / 50 + 1)
+			: makeStringRichBytes(sectionSize, static_cast<std::uint32_t>(i));
+		std::copy_n(content.begin(), sectionSize, pe.begin() + rawOffset);
+	}
+
+	return pe;
+}
+
+/**
+* @brief Returns a 32-bit x86 ELF executable with @a sections sections of
+*        @a sectionSize bytes.
+*
+* The first section contains x86 code, the other ones string-rich data.
+*/
+std::vector<std::uint8_t> makeElf(std::size_t sections,
+		std::size_t sectionSize) {
+	const std::size_t HeaderSize = 52;
+	const std::size_t SectionHeaderSize = 40;
+	const std::size_t DataOffset = 64;
+	const std::uint32_t ElfBase = 0x8048000;
+
+	// Section names: "", ".s1", ..., ".shstrtab".
+	std::string names(1, '\0');
+	std::vector<std::size_t> nameOffsets;
+	for (std::size_t i = 0; i < sections; ++i) {
+		nameOffsets.push_back(names.size());
+		names += (i == 0 ? std::string(".text") : ".s" + std::to_string(i));
+		names += '\0';
+	}
+	auto shstrtabName = names.size();
+	names += std::string(".shstrtab") + '\0';
+
+	auto stride = alignUp(sectionSize, 16);
+	auto namesOffset = DataOffset + sections * stride;
+	auto headersOffset = alignUp(namesOffset + names.size(), 4);
+	auto count = sections + 2;
+
+	std::vector<std::uint8_t> elf(headersOffset + count * SectionHeaderSize);
+
+	// ELF header.
+	std::copy_n("\x7f" "ELF\x01\x01\x01", 7, elf.begin());
+	put16(elf, 16, 2);
+	put16(elf, 18, 3);
+	put32(elf, 20, 1);
+	put32(elf, 24, ElfBase + DataOffset);
+	put32(elf, 32, static_cast<std::uint32_t>(headersOffset));
+	put16(elf, 40, HeaderSize);
+	put16(elf, 42, 32);
+	put16(elf, 46, SectionHeaderSize);
+	put16(elf, 48, static_cast<std::uint16_t>(count));
+	put16(elf, 50, static_cast<std::uint16_t>(count - 1));
+
+	// Sections (the first header is the null section).
+	for (std::size_t i = 0; i < sections; ++i) {
+		auto offset = DataOffset + i * stride;
+		auto content = i == 0
+			? makeX86Code(sectionSize / 50 + 1)
+			: makeStringRichBytes(sectionSize, static_cast<std::uint32_t>(i));
+		std::copy_n(content.begin(), sectionSize, elf.begin() + offset);
+
+		auto sh = headersOffset + (i + 1) * SectionHeaderSize;
+		put32(elf, sh + 0, static_cast<std::uint32_t>(nameOffsets[i]));
+		put32(elf, sh + 4, 1);
+		put32(elf, sh + 8, i == 0 ? 6 : 3);
+		put32(elf, sh + 12, static_cast<std::uint32_t>(ElfBase + offset));
+		put32(elf, sh + 16, static_cast<std::uint32_t>(offset));
+		put32(elf, sh + 20, static_cast<std::uint32_t>(sectionSize));
+		put32(elf, sh + 32, 16);
+	}
+
+	// Section names.
+	std::copy(names.begin(), names.end(), elf.begin() + namesOffset);
+	auto sh = headersOffset + (count - 1) * SectionHeaderSize;
+	put32(elf, sh + 0, static_cast<std::uint32_t>(shstrtabName));
+	put32(elf, sh + 4, 3);
+	put32(elf, sh + 16, static_cast<std::uint32_t>(namesOffset));
+	put32(elf, sh + 20, static_cast<std::uint32_t>(names.size()));
+	put32(elf, sh + 32, 1);
+
+	return elf;
+}
+
+/**
+* @brief Returns paths to sample files that should be benchmarked in addition
+*        to the synthetic inputs.
+*
+* Sample files are all regular files in the directory given by the
+* @c RETDEC_BENCHMARK_INPUTS environment variable (if set).
+*/
+std::vector<std::string> getSampleFiles() {
+	std::vector<std::string> files;
+	const char *directory = std::getenv(SampleFilesVariable);
+	if (!directory || !*directory) {
+		return files;
+	}
+
+	std::error_code ec;
+	for (fs::directory_iterator it(directory, ec), end; !ec && it != end;
+			it.increment(ec)) {
+		if (it->is_regular_file(ec)) {
+			files.push_back(it->path().string());
+		}
+	}
+	std::sort(files.begin(), files.end());
+	return files;
+}
+
+/**
+* @brief Returns the contents of the file with the given @a path (or nothing
+*        if it cannot be read).
+*/
+std::vector<std::uint8_t> readFile(const std::string &path) {
+	std::ifstream file(path, std::ios::binary);
+	return std::vector<std::uint8_t>(std::istreambuf_iterator<char>(file),
+		std::istreambuf_iterator<char>());
+}
+
+} // namespace benchmarks
+} // namespace retdec
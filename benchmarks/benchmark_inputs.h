@@ -0,0 +1,38 @@
+/**
+* @file benchmarks/benchmark_inputs.h
+* @brief Inputs of the benchmarks.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef BENCHMARKS_BENCHMARK_INPUTS_H
+#define BENCHMARKS_BENCHMARK_INPUTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace retdec {
+namespace benchmarks {
+
+/// Image base of synthetic executables.
+constexpr std::uint64_t ImageBase = 0x400000;
+
+std::vector<std::uint8_t> makeRandomBytes(std::size_t size,
+	std::uint32_t seed = 1);
+std::vector<std::uint8_t> makeStringRichBytes(std::size_t size,
+	std::uint32_t seed = 1);
+std::vector<std::uint8_t> makeX86Code(std::size_t functions);
+
+std::vector<std::uint8_t> makePe(std::size_t sections,
+	std::size_t sectionSize);
+std::vector<std::uint8_t> makeElf(std::size_t sections,
+	std::size_t sectionSize);
+
+std::vector<std::string> getSampleFiles();
+std::vector<std::uint8_t> readFile(const std::string &path);
+
+} // namespace benchmarks
+} // namespace retdec
+
+#endif
@@ -0,0 +1,281 @@
+/**
+* @file benchmarks/bin2llvmir_benchmarks.cpp
+* @brief Benchmarks of the @c bin2llvmir library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <limits>
+#include <sstream>
+
+#include <benchmark/benchmark.h>
+#include <llvm/AsmParser/Parser.h>
+#include <llvm/IR/Function.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/SourceMgr.h>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "retdec/bin2llvmir/analyses/reaching_definitions.h"
+#include "retdec/bin2llvmir/optimizations/decoder/disassembly.h"
+#include "retdec/bin2llvmir/providers/config.h"
+#include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
+#include "retdec/utils/thread_pool.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::bin2llvmir;
+
+namespace
+{
+
+/// Number of global variables that model registers.
+const std::size_t Registers = 16;
+/// Number of diamonds (if-then-else) in every function.
+const std::size_t Diamonds = 32;
+
+/**
+ * Returns LLVM IR of a module with the given number of functions similar to
+ * the output of the decoder: registers are global variables, and every
+ * function is a chain of diamonds whose blocks load and store the registers.
+ */
+std::string makeModuleIr(std::size_t functions)
+{
+	std::ostringstream ir;
+	for (std::size_t r = 0; r < Registers; ++r)
+	{
+		ir << "@r" << r << " = global i32 0\n";
+	}
+
+	auto reg = [](std::size_t i) { return "@r" + std::to_string(i % Registers); };
+	for (std::size_t f = 0; f < functions; ++f)
+	{
+		ir << "define void @f" << f << "(i1 %c) {\n"
+			<< "entry:\n"
+			<< "  store i32 " << f << ", i32* " << reg(f) << "\n"
+			<< "  br label %d0\n";
+		for (std::size_t d = 0; d < Diamonds; ++d)
+		{
+			auto i = f + d;
+			ir << "d" << d << ":\n"
+				<< "  %a" << d << " = load i32, i32* " << reg(i) << "\n"
+				<< "  %b" << d << " = add i32 %a" << d << ", 1\n"
+				<< "  store i32 %b" << d << ", i32* " << reg(i + 1) << "\n"
+				<< "  br i1 %c, label %t" << d << ", label %e" << d << "\n"
+				<< "t" << d << ":\n"
+				<< "  store i32 %b" << d << ", i32* " << reg(i + 2) << "\n"
+				<< "  br label %j" << d << "\n"
+				<< "e" << d << ":\n"
+				<< "  %x" << d << " = load i32, i32* " << reg(i + 3) << "\n"
+				<< "  store i32 %x" << d << ", i32* " << reg(i + 2) << "\n"
+				<< "  br label %j" << d << "\n"
+				<< "j" << d << ":\n"
+				<< "  %y" << d << " = load i32, i32* " << reg(i + 2) << "\n"
+				<< "  store i32 %y" << d << ", i32* " << reg(i) << "\n"
+				<< "  br label %d" << d + 1 << "\n";
+		}
+		ir << "d" << Diamonds << ":\n"
+			<< "  ret void\n"
+			<< "}\n";
+	}
+	return ir.str();
+}
+
+std::unique_ptr<llvm::Module> parseModule(llvm::LLVMContext& context, std::size_t functions)
+{
+	llvm::SMDiagnostic error;
+	return llvm::parseAssemblyString(makeModuleIr(functions), error, context);
+}
+
+/**
+ * Reaching definitions analysis of a module with the given number of
+ * functions.
+ */
+void RdaRunOnModule(benchmark::State& state)
+{
+	llvm::LLVMContext context;
+	auto module = parseModule(context, state.range(0));
+	if (!module)
+	{
+		state.SkipWithError("module cannot be parsed");
+		return;
+	}
+
+	for (auto _ : state)
+	{
+		ReachingDefinitionsAnalysis rda;
+		rda.runOnModule(*module);
+		benchmark::DoNotOptimize(rda.wasRun());
+	}
+	state.SetItemsProcessed(state.iterations() * module->size());
+}
+BENCHMARK(RdaRunOnModule)->Arg(16)->Arg(256);
+
+/**
+ * Reaching definitions analysis of 256 functions on a thread pool with the
+ * given number of threads (--analysis-jobs).
+ */
+void RdaParallelUpdate(benchmark::State& state)
+{
+	llvm::LLVMContext context;
+	auto module = parseModule(context, 256);
+	if (!module)
+	{
+		state.SkipWithError("module cannot be parsed");
+		return;
+	}
+	utils::ThreadPool pool(state.range(0));
+
+	for (auto _ : state)
+	{
+		ReachingDefinitionsAnalysis rda;
+		rda.update(*module, nullptr, false, &pool);
+		benchmark::DoNotOptimize(rda.getCacheStatistics().recomputes);
+	}
+	state.SetItemsProcessed(state.iterations() * module->size());
+}
+BENCHMARK(RdaParallelUpdate)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+/**
+ * Re-running the cached reaching definitions analysis after one function of
+ * 256 was changed.
+ */
+void RdaCachedUpdate(benchmark::State& state)
+{
+	llvm::LLVMContext context;
+	auto module = parseModule(context, 256);
+	if (!module)
+	{
+		state.SkipWithError("module cannot be parsed");
+		return;
+	}
+
+	ReachingDefinitionsAnalysis rda;
+	rda.update(*module);
+	auto* changed = &*module->begin();
+	for (auto _ : state)
+	{
+		rda.invalidate(changed);
+		rda.update(*module);
+	}
+	state.counters["hits"] = rda.getCacheStatistics().hits;
+}
+BENCHMARK(RdaCachedUpdate);
+
+/**
+ * Generated x86 code with everything needed to disassemble and translate it.
+ */
+struct X86Input
+{
+	explicit X86Input(std::size_t functions)
+		: code(makeX86Code(functions))
+		, format(std::make_shared<fileformat::RawDataFormat>(code.data(), code.size()))
+		, module("benchmark", context)
+		, config(Config::empty(&module))
+	{
+		format->initArchitecture(fileformat::Architecture::X86, utils::Endianness::LITTLE, 4, ImageBase, ImageBase);
+		image = std::make_unique<FileImage>(&module, format, &config);
+		c2l = capstone2llvmir::Capstone2LlvmIrTranslator::createX86_32(&module);
+		ranges.addPrimary(ImageBase, ImageBase + code.size() - 1);
+	}
+
+	std::vector<std::uint8_t> code;
+	std::shared_ptr<fileformat::RawDataFormat> format;
+	llvm::LLVMContext context;
+	llvm::Module module;
+	Config config;
+	std::unique_ptr<FileImage> image;
+	std::unique_ptr<capstone2llvmir::Capstone2LlvmIrTranslator> c2l;
+	RangesToDecode ranges;
+};
+
+/**
+ * Parallel disassembly of x86 code reachable from its start (the first phase
+ * of the decoder) on a thread pool with the given number of threads. All the
+ * code is disassembled (no look-ahead limit), as nothing is taken.
+ */
+void DisassembleX86(benchmark::State& state)
+{
+	X86Input input(20000);
+	utils::ThreadPool pool(state.range(0));
+
+	std::size_t instructions = 0;
+	for (auto _ : state)
+	{
+		Disassembly disassembly;
+		disassembly.run(pool, *input.c2l, input.image.get(), input.ranges, {{ImageBase, CS_MODE_32}}, std::numeric_limits<std::size_t>::max());
+		instructions += disassembly.getInstructionCount();
+	}
+	state.SetBytesProcessed(state.iterations() * input.code.size());
+	state.counters["instructions"] = benchmark::Counter(instructions, benchmark::Counter::kIsRate);
+}
+BENCHMARK(DisassembleX86)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+/**
+ * Disassembly and translation of x86 code into LLVM IR with the given number
+ * of threads (--analysis-jobs), as the decoder does it. With less than two
+ * threads, the translator disassembles every instruction itself. Otherwise,
+ * the code is disassembled ahead on a thread pool with the default look-ahead
+ * limit, and the translation takes the disassembled instructions, which
+ * resumes the disassembly. Control flow discovery of the decoder is not
+ * included, the code is translated in the order of addresses.
+ */
+void DecodeX86(benchmark::State& state)
+{
+	X86Input input(2000);
+	auto pool = state.range(0) < 2
+			? nullptr
+			: std::make_unique<utils::ThreadPool>(state.range(0));
+	auto* type = llvm::FunctionType::get(llvm::Type::getVoidTy(input.context), false);
+
+	std::size_t instructions = 0;
+	for (auto _ : state)
+	{
+		auto* fnc = llvm::Function::Create(type, llvm::GlobalValue::ExternalLinkage, "decoded", &input.module);
+		llvm::IRBuilder<> irb(llvm::BasicBlock::Create(input.context, "entry", fnc));
+
+		Disassembly disassembly;
+		if (pool)
+		{
+			disassembly.run(*pool, *input.c2l, input.image.get(), input.ranges, {{ImageBase, CS_MODE_32}});
+		}
+
+		const std::uint8_t* bytes = input.code.data();
+		std::size_t size = input.code.size();
+		common::Address address = ImageBase;
+		while (size > 0)
+		{
+			capstone2llvmir::Capstone2LlvmIrTranslator::TranslationResultOne res;
+			if (auto* insn = disassembly.take(address, CS_MODE_32, size))
+			{
+				bytes += insn->size;
+				size -= insn->size;
+				res = input.c2l->translateOne(insn, address, irb);
+			}
+			else
+			{
+				res = input.c2l->translateOne(bytes, size, address, irb);
+			}
+			if (res.failed())
+			{
+				state.SkipWithError("instruction cannot be translated");
+				break;
+			}
+			capstone2llvmir::freeRetainedInsn(res.capstoneInsn);
+			++instructions;
+		}
+
+		disassembly.clear();
+		fnc->eraseFromParent();
+	}
+	state.SetBytesProcessed(state.iterations() * input.code.size());
+	state.counters["instructions"] = benchmark::Counter(instructions, benchmark::Counter::kIsRate);
+}
+BENCHMARK(DecodeX86)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,196 @@
+/**
+* @file benchmarks/capstone2llvmir_benchmarks.cpp
+* @brief Benchmarks of the @c capstone2llvmir library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <functional>
+
+#include <benchmark/benchmark.h>
+#include <llvm/IR/IRBuilder.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "retdec/capstone2llvmir/capstone2llvmir.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::capstone2llvmir;
+
+namespace
+{
+
+/// Size of translated code (in bytes).
+const std::size_t CodeSize = 0x1000;
+
+using TranslatorFactory = std::function<std::unique_ptr<Capstone2LlvmIrTranslator>(llvm::Module*)>;
+
+/**
+ * Returns @a block repeated to CodeSize bytes.
+ */
+std::vector<std::uint8_t> repeat(const std::vector<std::uint8_t>& block)
+{
+	std::vector<std::uint8_t> code;
+	while (code.size() + block.size() <= CodeSize)
+	{
+		code.insert(code.end(), block.begin(), block.end());
+	}
+	return code;
+}
+
+/**
+ * Translation of the given code into LLVM IR. Every iteration translates the
+ * code into a new function, which is removed afterwards.
+ */
+void translate(benchmark::State& state, const TranslatorFactory& createTranslator, const std::vector<std::uint8_t>& code)
+{
+	llvm::LLVMContext context;
+	llvm::Module module("benchmark", context);
+	auto translator = createTranslator(&module);
+	if (!translator)
+	{
+		state.SkipWithError("translator cannot be created");
+		return;
+	}
+
+	std::size_t instructions = 0;
+	std::size_t retainedBytes = 0;
+	for (auto _ : state)
+	{
+		auto* f = llvm::Function::Create(
+				llvm::FunctionType::get(llvm::Type::getVoidTy(context), false),
+				llvm::GlobalValue::ExternalLinkage,
+				"",
+				&module);
+		auto* bb = llvm::BasicBlock::Create(context, "", f);
+		llvm::IRBuilder<> irb(bb);
+		irb.SetInsertPoint(irb.CreateRetVoid());
+
+		auto result = translator->translate(code.data(), code.size(), ImageBase, irb);
+		if (result.failed())
+		{
+			state.SkipWithError("code cannot be translated");
+			break;
+		}
+		instructions += result.count;
+
+		state.PauseTiming();
+		for (auto& insn : result.insns)
+		{
+			retainedBytes += getRetainedInsnSize(
+					translator->getArchitecture(),
+					insn.second);
+			freeRetainedInsn(insn.second);
+		}
+		f->eraseFromParent();
+		state.ResumeTiming();
+	}
+	state.SetBytesProcessed(state.iterations() * code.size());
+	state.counters["instructions"] = benchmark::Counter(instructions, benchmark::Counter::kIsRate);
+	if (instructions)
+	{
+		// Memory kept for every translated instruction until the end of
+		// decoding.
+		state.counters["bytesPerInsn"] = double(retainedBytes) / instructions;
+	}
+}
+
+void TranslateX86(benchmark::State& state)
+{
+	// Straight-line part of the functions of makeX86Code().
+	translate(state, [](llvm::Module* m) { return Capstone2LlvmIrTranslator::createX86_32(m); },
+			repeat({
+				0x55,                               // push ebp
+				0x89, 0xe5,                         // mov ebp, esp
+				0x8b, 0x45, 0x08,                   // mov eax, [ebp+8]
+				0x05, 0x78, 0x56, 0x34, 0x12,       // add eax, 0x12345678
+				0x89, 0x45, 0xfc,                   // mov [ebp-4], eax
+				0x0f, 0xaf, 0xc1,                   // imul eax, ecx
+				0x29, 0xd1,                         // sub ecx, edx
+				0x83, 0xf8, 0x0a,                   // cmp eax, 10
+				0x31, 0xd2,                         // xor edx, edx
+				0x5d                                // pop ebp
+			}));
+}
+BENCHMARK(TranslateX86);
+
+void TranslateX86_64(benchmark::State& state)
+{
+	translate(state, [](llvm::Module* m) { return Capstone2LlvmIrTranslator::createX86_64(m); },
+			repeat({
+				0x55,                               // push rbp
+				0x48, 0x89, 0xe5,                   // mov rbp, rsp
+				0x48, 0x8b, 0x45, 0x10,             // mov rax, [rbp+16]
+				0x48, 0x05, 0x78, 0x56, 0x34, 0x12, // add rax, 0x12345678
+				0x48, 0x89, 0x45, 0xf8,             // mov [rbp-8], rax
+				0x48, 0x0f, 0xaf, 0xc1,             // imul rax, rcx
+				0x48, 0x29, 0xd1,                   // sub rcx, rdx
+				0x48, 0x83, 0xf8, 0x0a,             // cmp rax, 10
+				0x31, 0xd2,                         // xor edx, edx
+				0x5d                                // pop rbp
+			}));
+}
+BENCHMARK(TranslateX86_64);
+
+void TranslateArm(benchmark::State& state)
+{
+	translate(state, [](llvm::Module* m) { return Capstone2LlvmIrTranslator::createArm(m); },
+			repeat({
+				0x02, 0x00, 0x81, 0xe0,             // add r0, r1, r2
+				0x01, 0x30, 0x43, 0xe2,             // sub r3, r3, #1
+				0x04, 0x00, 0x91, 0xe5,             // ldr r0, [r1, #4]
+				0x08, 0x00, 0x8d, 0xe5,             // str r0, [sp, #8]
+				0x0a, 0x00, 0x50, 0xe3,             // cmp r0, #10
+				0x00, 0x40, 0xa0, 0xe1              // mov r4, r0
+			}));
+}
+BENCHMARK(TranslateArm);
+
+void TranslateArm64(benchmark::State& state)
+{
+	translate(state, [](llvm::Module* m) { return Capstone2LlvmIrTranslator::createArm64(m); },
+			repeat({
+				0x20, 0x00, 0x02, 0x8b,             // add x0, x1, x2
+				0x63, 0x04, 0x00, 0xd1,             // sub x3, x3, #1
+				0x20, 0x04, 0x40, 0xf9,             // ldr x0, [x1, #8]
+				0xe0, 0x0b, 0x00, 0xf9,             // str x0, [sp, #16]
+				0x1f, 0x28, 0x00, 0xf1,             // cmp x0, #10
+				0xe4, 0x03, 0x00, 0xaa              // mov x4, x0
+			}));
+}
+BENCHMARK(TranslateArm64);
+
+void TranslateMips(benchmark::State& state)
+{
+	translate(state, [](llvm::Module* m) { return Capstone2LlvmIrTranslator::createMips32(m); },
+			repeat({
+				0x21, 0x10, 0x85, 0x00,             // addu $v0, $a0, $a1
+				0xf8, 0xff, 0xbd, 0x27,             // addiu $sp, $sp, -8
+				0x04, 0x00, 0x88, 0x8c,             // lw $t0, 4($a0)
+				0x08, 0x00, 0xa8, 0xaf,             // sw $t0, 8($sp)
+				0x2a, 0x10, 0x85, 0x00,             // slt $v0, $a0, $a1
+				0x25, 0x30, 0x80, 0x00              // move $a2, $a0
+			}));
+}
+BENCHMARK(TranslateMips);
+
+void TranslatePowerPc(benchmark::State& state)
+{
+	translate(state, [](llvm::Module* m) { return Capstone2LlvmIrTranslator::createPpc32(m, CS_MODE_BIG_ENDIAN); },
+			repeat({
+				0x7c, 0x64, 0x2a, 0x14,             // add r3, r4, r5
+				0x38, 0x21, 0xff, 0xf0,             // addi r1, r1, -16
+				0x81, 0x23, 0x00, 0x04,             // lwz r9, 4(r3)
+				0x91, 0x21, 0x00, 0x08,             // stw r9, 8(r1)
+				0x2c, 0x03, 0x00, 0x0a,             // cmpwi r3, 10
+				0x7c, 0x7f, 0x1b, 0x78              // mr r31, r3
+			}));
+}
+BENCHMARK(TranslatePowerPc);
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
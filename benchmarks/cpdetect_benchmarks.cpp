@@ -0,0 +1,125 @@
+/**
+* @file benchmarks/cpdetect_benchmarks.cpp
+* @brief Benchmarks of the @c cpdetect library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <random>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "retdec/cpdetect/search.h"
+#include "retdec/cpdetect/signature_matcher.h"
+#include "retdec/fileformat/format_factory.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::cpdetect;
+using namespace retdec::fileformat;
+
+namespace
+{
+
+/**
+ * Returns @a count signature patterns of 8 to 32 bytes with wildcard nibbles,
+ * similar to the patterns of compilers and packers.
+ */
+std::vector<std::string> makePatterns(std::size_t count)
+{
+	const char* HexDigits = "0123456789ABCDEF";
+	std::mt19937 generator(1);
+	std::uniform_int_distribution<int> length(8, 32);
+	std::uniform_int_distribution<int> nibble(0, 15);
+	std::uniform_int_distribution<int> wildcard(0, 7);
+
+	std::vector<std::string> patterns;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		std::string pattern;
+		auto bytes = length(generator);
+		for (int j = 0; j < bytes; ++j)
+		{
+			// The first bytes are fixed, so that every pattern has an anchor.
+			if (j >= 4 && wildcard(generator) == 0)
+			{
+				pattern += "--";
+			}
+			else
+			{
+				pattern += HexDigits[nibble(generator)];
+				pattern += HexDigits[nibble(generator)];
+			}
+		}
+		patterns.push_back(pattern + ";");
+	}
+	return patterns;
+}
+
+/**
+ * Compilation of the given number of signature patterns into SignatureMatcher.
+ */
+void CompileSignatures(benchmark::State& state)
+{
+	auto patterns = makePatterns(state.range(0));
+
+	for (auto _ : state)
+	{
+		SignatureMatcher matcher(patterns);
+		benchmark::DoNotOptimize(matcher.getNumberOfPatterns());
+	}
+	state.SetItemsProcessed(state.iterations() * patterns.size());
+}
+BENCHMARK(CompileSignatures)->Arg(100)->Arg(10000);
+
+/**
+ * Search of the given number of signature patterns in a 4 MiB PE file.
+ */
+void FindSignatures(benchmark::State& state)
+{
+	auto bytes = makePe(64, 0x10000);
+	auto format = createFileFormat(bytes.data(), bytes.size(), false, LoadFlags::NO_FILE_HASHES);
+	Search search(*format);
+	auto patterns = makePatterns(state.range(0));
+	SignatureMatcher matcher(patterns);
+	std::vector<SignatureMatcher::Area> areas(patterns.size(), {0, bytes.size() - 1});
+
+	for (auto _ : state)
+	{
+		std::vector<unsigned long long> result;
+		matcher.findPatterns(search, areas, result);
+		benchmark::DoNotOptimize(result.data());
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(FindSignatures)->Arg(100)->Arg(10000);
+
+/**
+ * Search of the given number of signature patterns one by one (one pass over
+ * the file per pattern), as done by Search::findUnslashedSignature().
+ */
+void FindSignaturesOneByOne(benchmark::State& state)
+{
+	auto bytes = makePe(64, 0x10000);
+	auto format = createFileFormat(bytes.data(), bytes.size(), false, LoadFlags::NO_FILE_HASHES);
+	Search search(*format);
+	auto patterns = makePatterns(state.range(0));
+
+	for (auto _ : state)
+	{
+		unsigned long long found = 0;
+		for (const auto& pattern : patterns)
+		{
+			found += search.findUnslashedSignature(pattern, 0, bytes.size() - 1);
+		}
+		benchmark::DoNotOptimize(found);
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(FindSignaturesOneByOne)->Arg(100);
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
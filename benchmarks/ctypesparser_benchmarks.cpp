@@ -0,0 +1,167 @@
+/**
+* @file benchmarks/ctypesparser_benchmarks.cpp
+* @brief Benchmarks of the @c ctypesparser library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "retdec/ctypes/context.h"
+#include "retdec/ctypes/module.h"
+#include "retdec/ctypesparser/binary_ctypes_parser.h"
+#include "retdec/ctypesparser/binary_ctypes_writer.h"
+#include "retdec/ctypesparser/json_ctypes_parser.h"
+#include "retdec/utils/filesystem.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::ctypesparser;
+
+namespace
+{
+
+/// Number of functions looked up after the initialization, which is about
+/// the number of imported functions of a typical executable.
+const std::size_t LookedUpFunctions = 256;
+
+/**
+ * Returns a JSON file with library type information (LTI) of the given
+ * number of functions, in the format of @c support/generic/types/*.json.
+ * Every function takes a structure, a pointer to it and a string, and the
+ * structures are shared by several functions.
+ */
+std::string makeLtiJson(std::size_t functions)
+{
+	const std::size_t structures = functions / 16 + 1;
+
+	std::ostringstream json;
+	json << "{\"functions\": {";
+	for (std::size_t f = 0; f < functions; ++f)
+	{
+		auto s = "s" + std::to_string(f % structures);
+		json << (f ? "," : "")
+			<< "\"f" << f << "\": {"
+			<< "\"decl\": \"int f" << f << "(struct " << s << " a, struct "
+				<< s << " *b, char *c);\","
+			<< "\"header\": \"header" << f % 64 << ".h\","
+			<< "\"name\": \"f" << f << "\","
+			<< "\"params\": ["
+			<< "{\"name\": \"a\", \"type\": \"" << s << "\"},"
+			<< "{\"name\": \"b\", \"type\": \"p" << s << "\"},"
+			<< "{\"name\": \"c\", \"type\": \"pchar\"}"
+			<< "],"
+			<< "\"ret_type\": \"int\""
+			<< "}";
+	}
+	json << "}, \"types\": {"
+		<< "\"int\": {\"name\": \"int\", \"type\": \"integral_type\"},"
+		<< "\"char\": {\"name\": \"char\", \"type\": \"integral_type\"},"
+		<< "\"pchar\": {\"pointed_type\": \"char\", \"type\": \"pointer\"}";
+	for (std::size_t s = 0; s < structures; ++s)
+	{
+		json << ",\"s" << s << "\": {"
+			<< "\"members\": ["
+			<< "{\"name\": \"x\", \"type\": \"int\"},"
+			<< "{\"name\": \"y\", \"type\": \"int\"},"
+			<< "{\"name\": \"name\", \"type\": \"pchar\"}"
+			<< "],"
+			<< "\"name\": \"s" << s << "\","
+			<< "\"type\": \"structure\""
+			<< "}"
+			<< ",\"ps" << s << "\": {"
+			<< "\"pointed_type\": \"s" << s << "\", \"type\": \"pointer\""
+			<< "}";
+	}
+	json << "}}";
+	return json.str();
+}
+
+/**
+ * Returns names of functions looked up after the initialization.
+ */
+std::vector<std::string> makeLookedUpNames(std::size_t functions)
+{
+	std::mt19937 generator(1);
+	std::vector<std::string> names;
+	for (std::size_t i = 0; i < LookedUpFunctions; ++i)
+	{
+		names.push_back("f" + std::to_string(generator() % functions));
+	}
+	return names;
+}
+
+/**
+ * Initialization of library type information from a JSON file with the given
+ * number of functions, followed by lookups of functions. This is what the LTI
+ * provider of @c bin2llvmir does when there is no binary (@c .lti) version of
+ * the file: the whole file is parsed at startup.
+ */
+void LtiInitFromJson(benchmark::State& state)
+{
+	const auto functions = static_cast<std::size_t>(state.range(0));
+	const auto json = makeLtiJson(functions);
+	const auto names = makeLookedUpNames(functions);
+
+	for (auto _ : state)
+	{
+		auto module = std::make_unique<ctypes::Module>(
+				std::make_shared<ctypes::Context>());
+		std::istringstream in(json);
+		JSONCTypesParser(32).parseInto(in, module, {}, ctypes::CallConvention("stdcall"));
+		for (const auto& name : names)
+		{
+			benchmark::DoNotOptimize(module->getFunctionWithName(name));
+		}
+	}
+	state.counters["fileBytes"] = json.size();
+}
+BENCHMARK(LtiInitFromJson)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Initialization of library type information from a binary (@c .lti) file
+ * compiled from the same JSON file as in LtiInitFromJson, followed by the
+ * same lookups. The file is memory-mapped and only the looked up functions
+ * (and their types) are parsed.
+ */
+void LtiInitFromBinary(benchmark::State& state)
+{
+	const auto functions = static_cast<std::size_t>(state.range(0));
+	const auto path = fs::temp_directory_path()
+			/ ("retdec-benchmarks-" + std::to_string(std::random_device{}()) + ".lti");
+	{
+		std::istringstream json(makeLtiJson(functions));
+		std::ofstream out(path, std::ios::binary);
+		BinaryCTypesWriter().write(json, out);
+	}
+	const auto names = makeLookedUpNames(functions);
+
+	for (auto _ : state)
+	{
+		auto module = std::make_unique<ctypes::Module>(
+				std::make_shared<ctypes::Context>());
+		BinaryCTypesParser parser(32);
+		parser.openInto(path.string(), module, {}, ctypes::CallConvention("stdcall"));
+		for (const auto& name : names)
+		{
+			benchmark::DoNotOptimize(parser.getFunction(name));
+		}
+	}
+	state.counters["fileBytes"] = fs::file_size(path);
+
+	std::error_code ec;
+	fs::remove(path, ec);
+}
+BENCHMARK(LtiInitFromBinary)->Arg(1000)->Arg(20000)->Unit(benchmark::kMillisecond);
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
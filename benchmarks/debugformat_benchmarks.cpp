@@ -0,0 +1,63 @@
+/**
+* @file benchmarks/debugformat_benchmarks.cpp
+* @brief Benchmarks of the @c debugformat library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "retdec/debugformat/debugformat.h"
+#include "retdec/demangler/demangler.h"
+#include "retdec/loader/image_factory.h"
+#include "retdec/utils/thread_pool.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::debugformat;
+
+namespace
+{
+
+/**
+ * Loading of DWARF debug information of sample files (see getSampleFiles())
+ * by the given number of jobs. Use a binary compiled with @c -g to see the
+ * effect of the number of jobs.
+ */
+const bool sampleBenchmarksRegistered = []()
+{
+	for (const auto& path : getSampleFiles())
+	{
+		auto benchmark = benchmark::RegisterBenchmark(("LoadDwarf/" + path).c_str(), [path](benchmark::State& state) {
+			auto image = loader::createImage(path);
+			if (!image)
+			{
+				state.SkipWithError("file cannot be loaded");
+				return;
+			}
+
+			demangler::ItaniumDemangler demangler;
+			std::unique_ptr<utils::ThreadPool> pool;
+			if (state.range(0) > 1)
+			{
+				pool = std::make_unique<utils::ThreadPool>(state.range(0));
+			}
+
+			std::size_t functions = 0;
+			for (auto _ : state)
+			{
+				DebugFormat debug(image.get(), "", nullptr, &demangler, pool.get());
+				functions = debug.functions.size();
+			}
+			state.counters["functions"] = functions;
+		});
+		benchmark->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime()->Unit(benchmark::kMillisecond);
+	}
+	return true;
+}();
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
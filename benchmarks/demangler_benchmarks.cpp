@@ -0,0 +1,91 @@
+/**
+* @file benchmarks/demangler_benchmarks.cpp
+* @brief Benchmarks of the @c demangler library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "retdec/demangler/demangler.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::demangler;
+
+namespace
+{
+
+const std::vector<std::string> itaniumNames =
+{
+	"_ZN3fooILi1EEC5Ev",
+	"_ZN6System5Sound4beepEv",
+	"_ZN1AIfEcvT_IiEEv",
+	"_Z2f1IiEDTppfp_ET_",
+	"_ZNSt6vectorIiSaIiEE9push_backERKi",
+	"_ZNKSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEE4findEPKcmm",
+	"_ZNSt3mapINSt7__cxx1112basic_stringIcSt11char_traitsIcESaIcEEEiSt4lessIS5_ESaISt4pairIKS5_iEEEixEOS5_",
+	"_ZZN4llvm2cl3optIbLb0ENS0_6parserIbEEEC1IJA21_cNS0_4descENS0_11initializerIbEENS0_18NumOccurrencesFlagEEEEDpRKT_ENKUlRKbE_clESH_",
+};
+
+const std::vector<std::string> microsoftNames =
+{
+	"?x@@3QEBHEB",
+	"??Jklass@@QEAAHH@Z",
+	"?foo_pad@@YAXPEAD@Z",
+	"?foo_qapad@@YAXQEAPEAD@Z",
+	"?foo_p6ahxz@@YAXP6AHXZ@Z",
+	"?mbb@S@@QAEX_N0@Z",
+	"?foofoo@NA@PR13207@@YAXV?$Y@V?$Y@VX@NA@PR13207@@@NA@PR13207@@@12@@Z",
+	"??$?BH@CompoundTypeOps@@QAE?AU?$Bar@U?$Foo@H@@@@XZ",
+};
+
+const std::vector<std::string> borlandNames =
+{
+	"@myFunc_int_$qi",
+	"@myFunc_fastcall_$qqrv",
+	"@myFunc_i_$qiii",
+	"@myFunc_s_$q60std@%basic_string$c19std@%char_traits$c%17std@%allocator$c%%t1t1",
+	"@myFunc_unsigned_short_int_$qus",
+};
+
+/**
+ * Demangling of the given names by the given demangler.
+ */
+void demangle(benchmark::State& state, Demangler& demangler, const std::vector<std::string>& names)
+{
+	for (auto _ : state)
+	{
+		for (const auto& name : names)
+		{
+			benchmark::DoNotOptimize(demangler.demangleToString(name));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * names.size());
+}
+
+void DemangleItanium(benchmark::State& state)
+{
+	ItaniumDemangler demangler;
+	demangle(state, demangler, itaniumNames);
+}
+BENCHMARK(DemangleItanium);
+
+void DemangleMicrosoft(benchmark::State& state)
+{
+	MicrosoftDemangler demangler;
+	demangle(state, demangler, microsoftNames);
+}
+BENCHMARK(DemangleMicrosoft);
+
+void DemangleBorland(benchmark::State& state)
+{
+	BorlandDemangler demangler;
+	demangle(state, demangler, borlandNames);
+}
+BENCHMARK(DemangleBorland);
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,259 @@
+/**
+* @file benchmarks/fileformat_benchmarks.cpp
+* @brief Benchmarks of the @c fileformat library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <fstream>
+#include <random>
+#include <string>
+#include <system_error>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "benchmarks/memory_counters.h"
+#include "retdec/fileformat/file_format/file_format.h"
+#include "retdec/fileformat/format_factory.h"
+#include "retdec/fileformat/types/strings/string_scanner.h"
+#include "retdec/fileformat/utils/crypto.h"
+#include "retdec/utils/filesystem.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::fileformat;
+
+namespace
+{
+
+/// Size of sections of synthetic files.
+const std::size_t SectionSize = 0x1000;
+
+/**
+ * Creates file formats from the given bytes with the given flags.
+ */
+void loadFormat(benchmark::State& state, const std::vector<std::uint8_t>& bytes, LoadFlags flags)
+{
+	for (auto _ : state)
+	{
+		auto format = createFileFormat(bytes.data(), bytes.size(), false, flags);
+		if (!format || !format->isInValidState())
+		{
+			state.SkipWithError("file cannot be loaded");
+			break;
+		}
+		benchmark::DoNotOptimize(format->getNumberOfSections());
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+/**
+ * Loading of a PE file with the given number of sections.
+ */
+void LoadPe(benchmark::State& state)
+{
+	loadFormat(state, makePe(state.range(0), SectionSize), LoadFlags::NO_FILE_HASHES);
+}
+BENCHMARK(LoadPe)->Arg(4)->Arg(96)->Arg(1024);
+
+/**
+ * Loading of an ELF file with the given number of sections.
+ */
+void LoadElf(benchmark::State& state)
+{
+	loadFormat(state, makeElf(state.range(0), SectionSize), LoadFlags::NO_FILE_HASHES);
+}
+BENCHMARK(LoadElf)->Arg(4)->Arg(96)->Arg(1024);
+
+/**
+ * Loads a file of several hundred MB (the given number of 4 MiB sections)
+ * either from its path, when it is memory-mapped, or from a buffer, which
+ * FileFormat copies. The peak memory shows how much of the input is held in
+ * memory while it is loaded.
+ */
+void loadLargeFormat(benchmark::State& state, std::vector<std::uint8_t> bytes, bool fromPath)
+{
+	const auto path = fs::temp_directory_path()
+			/ ("retdec-benchmarks-" + std::to_string(std::random_device{}()));
+	const auto size = bytes.size();
+	if (fromPath)
+	{
+		std::ofstream(path, std::ios::binary).write(
+				reinterpret_cast<const char*>(bytes.data()),
+				bytes.size());
+		bytes = std::vector<std::uint8_t>();
+	}
+
+	PeakMemoryCounter memory;
+	for (auto _ : state)
+	{
+		auto format = fromPath
+				? createFileFormat(path.string(), false, LoadFlags::NO_FILE_HASHES)
+				: createFileFormat(bytes.data(), bytes.size(), false, LoadFlags::NO_FILE_HASHES);
+		if (!format || !format->isInValidState())
+		{
+			state.SkipWithError("file cannot be loaded");
+			break;
+		}
+		benchmark::DoNotOptimize(format->getNumberOfSections());
+	}
+	memory.report(state);
+	state.SetBytesProcessed(state.iterations() * size);
+
+	std::error_code ec;
+	fs::remove(path, ec);
+}
+
+/**
+ * Loading of a large PE file from its path.
+ */
+void LoadLargePeFromPath(benchmark::State& state)
+{
+	loadLargeFormat(state, makePe(state.range(0), 4 << 20), true);
+}
+BENCHMARK(LoadLargePeFromPath)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/**
+ * Loading of a large PE file from a buffer in memory.
+ */
+void LoadLargePeFromMemory(benchmark::State& state)
+{
+	loadLargeFormat(state, makePe(state.range(0), 4 << 20), false);
+}
+BENCHMARK(LoadLargePeFromMemory)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/**
+ * Loading of a large ELF file from its path.
+ */
+void LoadLargeElfFromPath(benchmark::State& state)
+{
+	loadLargeFormat(state, makeElf(state.range(0), 4 << 20), true);
+}
+BENCHMARK(LoadLargeElfFromPath)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/**
+ * Loading of a large ELF file from a buffer in memory.
+ */
+void LoadLargeElfFromMemory(benchmark::State& state)
+{
+	loadLargeFormat(state, makeElf(state.range(0), 4 << 20), false);
+}
+BENCHMARK(LoadLargeElfFromMemory)->Arg(64)->Unit(benchmark::kMillisecond);
+
+/**
+ * Loading of a PE file with 64 KiB sections including the detection of
+ * strings in all of them.
+ */
+void LoadPeWithStrings(benchmark::State& state)
+{
+	loadFormat(state, makePe(state.range(0), 0x10000), LoadFlags::DETECT_STRINGS);
+}
+BENCHMARK(LoadPeWithStrings)->Arg(16)->Arg(256);
+
+/**
+ * Computation of CRC32, MD5 and SHA256 of the given number of bytes in one
+ * pass (the file hashes of FileFormat).
+ */
+void FileHashes(benchmark::State& state)
+{
+	auto bytes = makeRandomBytes(state.range(0));
+
+	for (auto _ : state)
+	{
+		std::string crc32, md5, sha256;
+		getCrc32Md5Sha256(bytes.data(), bytes.size(), crc32, md5, sha256);
+		benchmark::DoNotOptimize(sha256);
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+BENCHMARK(FileHashes)->Arg(1 << 20)->Arg(16 << 20);
+
+/**
+ * Detection of strings in 16 MiB of string-rich data by the given
+ * implementation of StringScanner.
+ */
+void ScanStrings(benchmark::State& state)
+{
+	auto implementation = static_cast<StringScanner::Implementation>(state.range(0));
+	if (!StringScanner::isSupported(implementation))
+	{
+		state.SkipWithError("implementation is not supported by the CPU");
+		return;
+	}
+
+	auto bytes = makeStringRichBytes(16 << 20);
+	StringScanner scanner(4, CharacterEndianness::Little, implementation);
+	std::size_t strings = 0;
+	for (auto _ : state)
+	{
+		std::vector<String> result;
+		scanner.scan(bytes.data(), bytes.size(), 0, ".data", result);
+		strings = result.size();
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+	state.counters["strings"] = strings;
+}
+BENCHMARK(ScanStrings)
+	->Arg(static_cast<int>(StringScanner::Implementation::Scalar))
+	->Arg(static_cast<int>(StringScanner::Implementation::Sse2))
+	->Arg(static_cast<int>(StringScanner::Implementation::Avx2));
+
+/**
+ * Lookups of sections containing random addresses in a PE file with the given
+ * number of sections.
+ */
+void SectionFromAddress(benchmark::State& state)
+{
+	auto bytes = makePe(state.range(0), SectionSize);
+	auto format = createFileFormat(bytes.data(), bytes.size(), false, LoadFlags::NO_FILE_HASHES);
+
+	std::mt19937_64 generator(1);
+	std::uniform_int_distribution<std::uint64_t> address(ImageBase + 0x1000, ImageBase + 0x1000 * (state.range(0) + 1) - 1);
+	std::vector<std::uint64_t> addresses(4096);
+	for (auto& a : addresses)
+	{
+		a = address(generator);
+	}
+
+	for (auto _ : state)
+	{
+		for (auto a : addresses)
+		{
+			benchmark::DoNotOptimize(format->getSectionFromAddress(a));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * addresses.size());
+}
+BENCHMARK(SectionFromAddress)->Arg(4)->Arg(96)->Arg(1024);
+
+/**
+ * Loading of sample files (see getSampleFiles()) including their hashes and
+ * strings.
+ */
+const bool sampleBenchmarksRegistered = []()
+{
+	for (const auto& path : getSampleFiles())
+	{
+		benchmark::RegisterBenchmark(("LoadSample/" + path).c_str(), [path](benchmark::State& state) {
+			auto bytes = readFile(path);
+			for (auto _ : state)
+			{
+				auto format = createFileFormat(bytes.data(), bytes.size(), false, LoadFlags::DETECT_STRINGS);
+				if (!format)
+				{
+					state.SkipWithError("file cannot be loaded");
+					break;
+				}
+				benchmark::DoNotOptimize(format->getSha256());
+			}
+			state.SetBytesProcessed(state.iterations() * bytes.size());
+		});
+	}
+	return true;
+}();
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
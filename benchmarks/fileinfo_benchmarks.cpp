@@ -0,0 +1,145 @@
+/**
+* @file benchmarks/fileinfo_benchmarks.cpp
+* @brief Benchmarks of the @c fileinfo library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+#include <fstream>
+#include <ostream>
+#include <random>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "benchmarks/memory_counters.h"
+#include "retdec/fileformat/format_factory.h"
+#include "retdec/utils/filesystem.h"
+#include "fileinfo/batch_processor/batch_processor.h"
+#include "fileinfo/file_information/file_information.h"
+#include "fileinfo/file_presentation/json_presentation.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::fileinfo;
+
+namespace
+{
+
+/**
+ * Stream buffer that only counts the written characters.
+ */
+class CountingBuffer : public std::streambuf
+{
+	public:
+		std::size_t count = 0;
+
+	protected:
+		int_type overflow(int_type c) override
+		{
+			++count;
+			return traits_type::not_eof(c);
+		}
+
+		std::streamsize xsputn(const char*, std::streamsize n) override
+		{
+			count += n;
+			return n;
+		}
+};
+
+/**
+ * JSON presentation of a file with the given number of detected strings
+ * into a stream that discards the output. The peak memory shows how much the
+ * presentation itself needs on top of the already loaded strings.
+ */
+void PresentJsonStrings(benchmark::State& state)
+{
+	std::vector<fileformat::String> strings;
+	strings.reserve(state.range(0));
+	for (std::int64_t i = 0; i < state.range(0); ++i)
+	{
+		strings.emplace_back(
+				i % 2 ? fileformat::StringType::Ascii : fileformat::StringType::Wide,
+				i * 16,
+				".data",
+				"string number " + std::to_string(i));
+	}
+	FileInformation fileinfo;
+	fileinfo.setStrings(&strings);
+
+	std::size_t size = 0;
+	PeakMemoryCounter memory;
+	for (auto _ : state)
+	{
+		CountingBuffer buffer;
+		std::ostream out(&buffer);
+		JsonPresentation(fileinfo, false, true).present(out);
+		size = buffer.count;
+	}
+	memory.report(state);
+	state.SetItemsProcessed(state.iterations() * strings.size());
+	state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(PresentJsonStrings)->Arg(1 << 16)->Arg(1 << 21)->Unit(benchmark::kMillisecond);
+
+/**
+ * Batch processing of 64 generated PE files by the given number of jobs.
+ * Every file is loaded by fileformat, including its hashes, so the benchmark
+ * shows the throughput of the batch mode of fileinfo without signature
+ * scanning.
+ */
+void BatchProcessFiles(benchmark::State& state)
+{
+	const auto directory = fs::temp_directory_path()
+			/ ("retdec-benchmarks-" + std::to_string(std::random_device{}()));
+	fs::create_directories(directory);
+	std::vector<std::string> files;
+	for (std::size_t i = 0; i < 64; ++i)
+	{
+		auto bytes = makePe(16, 0x10000);
+		files.push_back((directory / ("file" + std::to_string(i))).string());
+		std::ofstream(files.back(), std::ios::binary).write(
+				reinterpret_cast<const char*>(bytes.data()),
+				bytes.size());
+	}
+
+	BatchProcessor processor(
+			[](const std::string& path)
+			{
+				auto format = fileformat::createFileFormat(path);
+				return "{\"sha256\":\""
+						+ (format ? format->getSha256() : std::string())
+						+ "\"}";
+			},
+			state.range(0),
+			std::chrono::seconds(0));
+	for (auto _ : state)
+	{
+		CountingBuffer buffer;
+		std::ostream out(&buffer);
+		if (processor.process(files, out) != 0)
+		{
+			state.SkipWithError("a file cannot be processed");
+			break;
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * files.size());
+
+	std::error_code ec;
+	fs::remove_all(directory, ec);
+}
+BENCHMARK(BatchProcessFiles)
+	->Arg(1)
+	->Arg(4)
+	->Unit(benchmark::kMillisecond)
+	->UseRealTime();
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
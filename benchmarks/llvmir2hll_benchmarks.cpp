@@ -0,0 +1,261 @@
+/**
+* @file benchmarks/llvmir2hll_benchmarks.cpp
+* @brief Benchmarks of the @c llvmir2hll library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <llvm/IR/LLVMContext.h>
+#include <llvm/IR/Module.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "retdec/llvmir2hll/analysis/alias_analysis/alias_analyses/simple_alias_analysis.h"
+#include "retdec/llvmir2hll/analysis/value_analysis.h"
+#include "retdec/llvmir2hll/config/configs/json_config.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluators/c_arithm_expr_evaluator.h"
+#include "retdec/llvmir2hll/hll/hll_writers/c_hll_writer.h"
+#include "retdec/llvmir2hll/ir/add_op_expr.h"
+#include "retdec/llvmir2hll/ir/assign_stmt.h"
+#include "retdec/llvmir2hll/ir/const_int.h"
+#include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/function_builder.h"
+#include "retdec/llvmir2hll/ir/if_stmt.h"
+#include "retdec/llvmir2hll/ir/int_type.h"
+#include "retdec/llvmir2hll/ir/lt_op_expr.h"
+#include "retdec/llvmir2hll/ir/module.h"
+#include "retdec/llvmir2hll/ir/return_stmt.h"
+#include "retdec/llvmir2hll/ir/var_def_stmt.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/ir/while_loop_stmt.h"
+#include "retdec/llvmir2hll/obtainer/call_info_obtainers/optim_call_info_obtainer.h"
+#include "retdec/llvmir2hll/optimizer/optimizer_manager.h"
+#include "retdec/llvmir2hll/semantics/semantics/default_semantics.h"
+#include "retdec/llvmir2hll/var_name_gen/var_name_gens/num_var_name_gen.h"
+#include "retdec/llvmir2hll/var_renamer/var_renamers/readable_var_renamer.h"
+#include "retdec/utils/pass_profiler.h"
+#include "retdec/utils/small_block_pool.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::llvmir2hll;
+
+namespace {
+
+/// Number of conditional statements in the loop of every synthetic function.
+const int IfsPerFunction = 32;
+
+/**
+* @brief Creates a function with a loop of @c IfsPerFunction conditional
+*        updates of a local variable:
+*
+* @code
+* int funcN() {
+*     int a = 0;
+*     int i = 0;
+*     while (i < 100) {
+*         if (a < 0) { a = a + i; } else { a = a + 1; }
+*         ...
+*         i = i + 1;
+*     }
+*     return a;
+* }
+* @endcode
+*/
+ShPtr<Function> makeFunction(const std::string &name) {
+	auto intType = IntType::create(32);
+	auto a = Variable::create("a", intType);
+	auto i = Variable::create("i", intType);
+
+	ShPtr<Statement> loopBody = AssignStmt::create(i,
+		AddOpExpr::create(i, ConstInt::create(1, 32)));
+	for (int k = IfsPerFunction - 1; k >= 0; --k) {
+		auto ifStmt = IfStmt::create(
+			LtOpExpr::create(a, ConstInt::create(k, 32), LtOpExpr::Variant::SCmp),
+			AssignStmt::create(a, AddOpExpr::create(a, i)),
+			loopBody);
+		ifStmt->setElseClause(
+			AssignStmt::create(a, AddOpExpr::create(a, ConstInt::create(1, 32))));
+		loopBody = ifStmt;
+	}
+
+	auto body = VarDefStmt::create(a, ConstInt::create(0, 32),
+		VarDefStmt::create(i, ConstInt::create(0, 32),
+			WhileLoopStmt::create(
+				LtOpExpr::create(i, ConstInt::create(100, 32), LtOpExpr::Variant::SCmp),
+				loopBody,
+				ReturnStmt::create(a))));
+
+	return FunctionBuilder(name)
+		.definitionWithBody(body)
+		.withRetType(intType)
+		.withLocalVar(a)
+		.withLocalVar(i)
+		.build();
+}
+
+/**
+* @brief Creates a module with the given number of synthetic functions.
+*/
+ShPtr<Module> makeModule(const llvm::Module &llvmModule, std::size_t functions) {
+	auto module = std::make_shared<Module>(&llvmModule,
+		llvmModule.getModuleIdentifier(), DefaultSemantics::create(),
+		ShPtr<Config>(JSONConfig::empty()));
+	for (std::size_t f = 0; f < functions; ++f) {
+		module->addFunc(makeFunction("func" + std::to_string(f)));
+	}
+	return module;
+}
+
+/**
+* @brief Construction (and destruction) of a module in the backend IR with the
+*        given number of functions.
+*
+* The @c poolBytes counter is the memory reserved by the pool from which the
+* values of the IR are allocated.
+*/
+void BuildModule(benchmark::State &state) {
+	llvm::LLVMContext context;
+	llvm::Module llvmModule("benchmark", context);
+
+	for (auto _ : state) {
+		auto module = makeModule(llvmModule, state.range(0));
+		benchmark::DoNotOptimize(module.get());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["poolBytes"] = utils::SmallBlockPool::getReservedSize();
+}
+BENCHMARK(BuildModule)->Arg(16)->Arg(256);
+
+/**
+* @brief Default optimizations of a module with the given number of functions,
+*        run by the given number of jobs.
+*/
+void Optimize(benchmark::State &state) {
+	llvm::LLVMContext context;
+	llvm::Module llvmModule("benchmark", context);
+	std::string code;
+	llvm::raw_string_ostream out(code);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto module = makeModule(llvmModule, state.range(0));
+		auto aliasAnalysis = SimpleAliasAnalysis::create();
+		aliasAnalysis->init(module);
+		OptimizerManager optManager({}, {}, CHLLWriter::create(out),
+			ValueAnalysis::create(aliasAnalysis, true),
+			OptimCallInfoObtainer::create(), CArithmExprEvaluator::create(),
+			false, state.range(1));
+		state.ResumeTiming();
+
+		optManager.optimize(module);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(Optimize)
+	->Args({64, 1})->Args({64, 2})->Args({64, 4})->Args({64, 8})
+	->UseRealTime();
+
+/**
+* @brief Emission of C code of a module with the given number of functions.
+*/
+void EmitC(benchmark::State &state) {
+	llvm::LLVMContext context;
+	llvm::Module llvmModule("benchmark", context);
+	auto module = makeModule(llvmModule, state.range(0));
+
+	std::size_t bytes = 0;
+	for (auto _ : state) {
+		std::string code;
+		llvm::raw_string_ostream out(code);
+		CHLLWriter::create(out)->emitTargetCode(module);
+		bytes += out.str().size();
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetBytesProcessed(bytes);
+}
+BENCHMARK(EmitC)->Arg(16)->Arg(256);
+
+/**
+* @brief Optimizations, variable renaming, and emission of C code of a module
+*        with the given number of functions, run by the given number of jobs.
+*
+* This is the part of the decompilation done by the backend after the
+* conversion of LLVM IR. Wall times are summed by the categories of the
+* profiler of the optimizer manager. The @c serialShare counter is the share
+* of the time spent outside the optimizations that are run over functions in
+* parallel (OptimizerManager::ParallelCategory), i.e. in the serial
+* optimizations, variable renaming, and emission. Measured with one job, it
+* bounds the speedup by more jobs.
+*/
+void BackendSerialShare(benchmark::State &state) {
+	llvm::LLVMContext context;
+	llvm::Module llvmModule("benchmark", context);
+
+	std::uint64_t serialUs = 0;
+	std::uint64_t parallelUs = 0;
+	std::uint64_t renamingUs = 0;
+	std::uint64_t emissionUs = 0;
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto module = makeModule(llvmModule, state.range(0));
+		auto aliasAnalysis = SimpleAliasAnalysis::create();
+		aliasAnalysis->init(module);
+		std::string code;
+		llvm::raw_string_ostream out(code);
+		auto writer = CHLLWriter::create(out);
+		OptimizerManager optManager({}, {}, writer,
+			ValueAnalysis::create(aliasAnalysis, true),
+			OptimCallInfoObtainer::create(), CArithmExprEvaluator::create(),
+			false, state.range(1));
+		utils::PassProfiler profiler;
+		optManager.setPassProfiler(&profiler);
+		state.ResumeTiming();
+
+		optManager.optimize(module);
+		auto renamingStart = std::chrono::steady_clock::now();
+		ReadableVarRenamer::create(NumVarNameGen::create(), true)
+			->renameVars(module);
+		auto emissionStart = std::chrono::steady_clock::now();
+		writer->emitTargetCode(module);
+		auto emissionEnd = std::chrono::steady_clock::now();
+
+		for (const auto &record : profiler.getRecords()) {
+			if (record.category == OptimizerManager::ParallelCategory) {
+				parallelUs += record.wallUs;
+			} else {
+				serialUs += record.wallUs;
+			}
+		}
+		renamingUs += std::chrono::duration_cast<std::chrono::microseconds>(
+			emissionStart - renamingStart).count();
+		emissionUs += std::chrono::duration_cast<std::chrono::microseconds>(
+			emissionEnd - emissionStart).count();
+	}
+
+	serialUs += renamingUs + emissionUs;
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["serialShare"] = serialUs + parallelUs == 0 ? 0.0 :
+		static_cast<double>(serialUs) / (serialUs + parallelUs);
+	state.counters["serialOptimizationsMs"] = benchmark::Counter(
+		(serialUs - renamingUs - emissionUs) / 1000.0,
+		benchmark::Counter::kAvgIterations);
+	state.counters["parallelOptimizationsMs"] = benchmark::Counter(
+		parallelUs / 1000.0, benchmark::Counter::kAvgIterations);
+	state.counters["renamingMs"] = benchmark::Counter(
+		renamingUs / 1000.0, benchmark::Counter::kAvgIterations);
+	state.counters["emissionMs"] = benchmark::Counter(
+		emissionUs / 1000.0, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BackendSerialShare)
+	->Args({64, 1})->Args({64, 4})->Args({64, 8})
+	->UseRealTime();
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,15 @@
+/**
+* @file benchmarks/main.cpp
+* @brief Entry point of the benchmarks.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*
+* Benchmarks of all the libraries are linked into one executable and
+* registered by their translation units. Use the standard Google Benchmark
+* options, e.g. @c --benchmark_filter to select benchmarks, and
+* @c --benchmark_out=FILE @c --benchmark_out_format=json to store the results
+* in a machine-readable form that can be compared across commits.
+*/
+
+#include <benchmark/benchmark.h>
+
+BENCHMARK_MAIN();
@@ -0,0 +1,41 @@
+/**
+* @file benchmarks/memory_counters.cpp
+* @brief Counters of memory used by benchmarks.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include "benchmarks/memory_counters.h"
+#include "retdec/utils/memory.h"
+
+namespace retdec {
+namespace benchmarks {
+
+/**
+* @brief Resets the peak resident set size of the process and remembers the
+*        current size.
+*/
+PeakMemoryCounter::PeakMemoryCounter():
+	supported(utils::resetPeakProcessMemoryUsage()),
+	baseline(utils::getProcessMemoryUsage()) {}
+
+/**
+* @brief Sets the counters of @a state:
+*        - @c peakRss: peak resident set size of the process (in bytes),
+*        - @c peakRssGrowth: how much the peak exceeds the size at the creation
+*          of this object (in bytes).
+*/
+void PeakMemoryCounter::report(benchmark::State &state) const {
+	if (!supported) {
+		return;
+	}
+
+	auto peak = utils::getPeakProcessMemoryUsage();
+	state.counters["peakRss"] = benchmark::Counter(static_cast<double>(peak),
+		benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+	state.counters["peakRssGrowth"] = benchmark::Counter(
+		static_cast<double>(peak > baseline ? peak - baseline : 0),
+		benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+}
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,40 @@
+/**
+* @file benchmarks/memory_counters.h
+* @brief Counters of memory used by benchmarks.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef BENCHMARKS_MEMORY_COUNTERS_H
+#define BENCHMARKS_MEMORY_COUNTERS_H
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+namespace retdec {
+namespace benchmarks {
+
+/**
+* @brief Measures the peak resident set size of the process while a benchmark
+*        runs.
+*
+* Create it right before the measured loop and call report() after it. The
+* peak is reset when the object is created, so benchmarks that run before do
+* not affect it. Where the peak cannot be reset (all systems but Linux), the
+* counters are not reported, because they would be meaningless.
+*/
+class PeakMemoryCounter {
+public:
+	PeakMemoryCounter();
+
+	void report(benchmark::State &state) const;
+
+private:
+	bool supported = false;
+	std::size_t baseline = 0;
+};
+
+} // namespace benchmarks
+} // namespace retdec
+
+#endif
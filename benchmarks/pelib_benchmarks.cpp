@@ -0,0 +1,82 @@
+/**
+* @file benchmarks/pelib_benchmarks.cpp
+* @brief Benchmarks of the @c pelib library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "benchmarks/memory_counters.h"
+#include "retdec/pelib/ImageLoader.h"
+
+namespace retdec {
+namespace benchmarks {
+
+namespace
+{
+
+/**
+ * Loads the given image and reads all its sections by RVA.
+ */
+void loadImage(benchmark::State& state, const std::vector<std::uint8_t>& bytes)
+{
+	std::vector<std::uint8_t> buffer(0x1000);
+
+	for (auto _ : state)
+	{
+		PeLib::ImageLoader loader;
+		if (loader.Load(PeLib::ByteView(bytes)) != PeLib::ERROR_NONE)
+		{
+			state.SkipWithError("image cannot be loaded");
+			break;
+		}
+		for (std::uint32_t i = 0; i < loader.getNumberOfSections(); ++i)
+		{
+			auto* section = loader.getSectionHeader(i);
+			benchmark::DoNotOptimize(loader.readImage(buffer.data(), section->VirtualAddress, buffer.size()));
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * bytes.size());
+}
+
+/**
+ * ImageLoader::Load() of a PE file with the given number of 4 KiB sections.
+ */
+void ImageLoaderLoad(benchmark::State& state)
+{
+	loadImage(state, makePe(state.range(0), 0x1000));
+}
+BENCHMARK(ImageLoaderLoad)->Arg(4)->Arg(96)->Arg(1024);
+
+/**
+ * ImageLoader::Load() of a PE file of several hundred MB (the given number
+ * of 4 MiB sections). The peak memory does not include the loaded file.
+ */
+void ImageLoaderLoadLarge(benchmark::State& state)
+{
+	auto bytes = makePe(state.range(0), 4 << 20);
+	PeakMemoryCounter memory;
+	loadImage(state, bytes);
+	memory.report(state);
+}
+BENCHMARK(ImageLoaderLoadLarge)->Arg(64)->Arg(80)->Unit(benchmark::kMillisecond);
+
+/**
+ * ImageLoader::Load() of sample files (see getSampleFiles()).
+ */
+const bool sampleBenchmarksRegistered = []()
+{
+	for (const auto& path : getSampleFiles())
+	{
+		benchmark::RegisterBenchmark(("ImageLoaderLoad/" + path).c_str(), [path](benchmark::State& state) {
+			loadImage(state, readFile(path));
+		});
+	}
+	return true;
+}();
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,309 @@
+/**
+* @file benchmarks/utils_benchmarks.cpp
+* @brief Benchmarks of the @c utils library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "benchmarks/benchmark_inputs.h"
+#include "benchmarks/memory_counters.h"
+#include "retdec/utils/crc32.h"
+#include "retdec/utils/disk_cache.h"
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/interval_index.h"
+#include "retdec/utils/ordinal_database.h"
+#include "retdec/utils/small_block_pool.h"
+#include "retdec/utils/thread_pool.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::utils;
+
+namespace {
+
+/**
+* @brief CRC32 of the given number of bytes.
+*/
+void Crc32(benchmark::State &state) {
+	auto data = makeRandomBytes(state.range(0));
+
+	for (auto _ : state) {
+		CRC32 crc32;
+		benchmark::DoNotOptimize(crc32(data.data(), data.size()));
+	}
+	state.SetBytesProcessed(state.iterations() * data.size());
+}
+BENCHMARK(Crc32)->Arg(1 << 20)->Arg(16 << 20);
+
+/**
+* @brief Lookups of random addresses in an index of the given number of
+*        adjacent intervals (e.g. sections of a file).
+*/
+void IntervalIndexLookup(benchmark::State &state) {
+	const std::uint64_t IntervalSize = 0x1000;
+	const auto count = static_cast<std::uint64_t>(state.range(0));
+
+	IntervalIndex<std::uint64_t> index;
+	for (std::uint64_t i = 0; i < count; ++i) {
+		index.add(ImageBase + i * IntervalSize, IntervalSize, i);
+	}
+	index.build();
+
+	std::mt19937_64 generator(1);
+	std::uniform_int_distribution<std::uint64_t> address(ImageBase,
+		ImageBase + count * IntervalSize - 1);
+	std::vector<std::uint64_t> addresses(4096);
+	for (auto &a : addresses) {
+		a = address(generator);
+	}
+
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+		for (auto a : addresses) {
+			index.forEachContaining(a, [&sum](std::uint64_t value) {
+				sum += value;
+				return false;
+			});
+		}
+		benchmark::DoNotOptimize(sum);
+	}
+	state.SetItemsProcessed(state.iterations() * addresses.size());
+}
+BENCHMARK(IntervalIndexLookup)->Arg(16)->Arg(1024)->Arg(65536);
+
+/**
+* @brief Lookups of random ordinals in a database of the given number of
+*        entries (400 ordinals per library).
+*/
+void OrdinalDatabaseLookup(benchmark::State &state) {
+	const std::uint32_t OrdinalsPerLibrary = 400;
+	const auto count = static_cast<std::uint32_t>(state.range(0));
+
+	std::vector<OrdinalDatabase::Entry> entries;
+	for (std::uint32_t i = 0; i < count; ++i) {
+		entries.push_back({"x86",
+			"library" + std::to_string(i / OrdinalsPerLibrary) + ".dll",
+			i % OrdinalsPerLibrary + 1, "function" + std::to_string(i)});
+	}
+	std::ostringstream out;
+	if (!OrdinalDatabase::write(out, entries)) {
+		state.SkipWithError("database cannot be written");
+		return;
+	}
+	const auto content = out.str();
+	OrdinalDatabase database;
+	database.open(reinterpret_cast<const std::uint8_t *>(content.data()),
+		content.size());
+
+	std::mt19937_64 generator(1);
+	std::uniform_int_distribution<std::size_t> entry(0, entries.size() - 1);
+	std::vector<const OrdinalDatabase::Entry *> lookups(4096);
+	for (auto &l : lookups) {
+		l = &entries[entry(generator)];
+	}
+
+	for (auto _ : state) {
+		for (const auto *l : lookups) {
+			benchmark::DoNotOptimize(
+				database.getName(l->arch, l->library, l->ordinal));
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * lookups.size());
+	state.counters["databaseBytes"] = content.size();
+}
+BENCHMARK(OrdinalDatabaseLookup)->Arg(4000)->Arg(400000);
+
+/**
+* @brief ThreadPool::parallelFor() over many small work items with the given
+*        number of threads.
+*/
+void ThreadPoolParallelFor(benchmark::State &state) {
+	const std::size_t Items = 100000;
+	ThreadPool pool(state.range(0));
+
+	for (auto _ : state) {
+		std::atomic<std::uint64_t> sum(0);
+		pool.parallelFor(Items, [&sum](std::size_t i) {
+			sum.fetch_add(i * i, std::memory_order_relaxed);
+		});
+		benchmark::DoNotOptimize(sum.load());
+	}
+	state.SetItemsProcessed(state.iterations() * Items);
+}
+BENCHMARK(ThreadPoolParallelFor)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->UseRealTime();
+
+/**
+* @brief Allocations and deallocations of small blocks by the given allocation
+*        functions.
+*/
+template<typename Allocate, typename Deallocate>
+void allocateSmallBlocks(benchmark::State &state, Allocate allocate,
+		Deallocate deallocate) {
+	const std::size_t Blocks = 4096;
+	const auto size = static_cast<std::size_t>(state.range(0));
+	std::vector<void *> blocks(Blocks);
+
+	for (auto _ : state) {
+		for (auto &block : blocks) {
+			block = allocate(size);
+		}
+		benchmark::DoNotOptimize(blocks.data());
+		for (auto block : blocks) {
+			deallocate(block, size);
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * Blocks);
+}
+
+void SmallBlockPoolAllocate(benchmark::State &state) {
+	allocateSmallBlocks(state, &SmallBlockPool::allocate,
+		&SmallBlockPool::deallocate);
+}
+BENCHMARK(SmallBlockPoolAllocate)->Arg(24)->Arg(64)->Arg(256);
+
+void OperatorNewAllocate(benchmark::State &state) {
+	allocateSmallBlocks(state,
+		[](std::size_t size) { return ::operator new(size); },
+		[](void *block, std::size_t) { ::operator delete(block); });
+}
+BENCHMARK(OperatorNewAllocate)->Arg(24)->Arg(64)->Arg(256);
+
+/**
+* @brief A node of a graph of shared objects, allocated either from
+*        SmallBlockPool or by the global operator new.
+*/
+template<bool UsePool>
+struct SharedNode {
+	virtual ~SharedNode() = default;
+
+	static void *operator new(std::size_t size) {
+		return UsePool ? SmallBlockPool::allocate(size) : ::operator new(size);
+	}
+
+	static void operator delete(void *block, std::size_t size) noexcept {
+		UsePool ? SmallBlockPool::deallocate(block, size)
+			: ::operator delete(block);
+	}
+
+	std::shared_ptr<SharedNode> child;
+	std::weak_ptr<SharedNode> parent;
+};
+
+template<bool UsePool, std::size_t PayloadSize>
+struct SharedNodeWithPayload: SharedNode<UsePool> {
+	char payload[PayloadSize];
+};
+
+/**
+* @brief Creates a shared pointer to a new node the way BIR values are created
+*        (see llvmir2hll::makeValuePtr()).
+*/
+template<bool UsePool, std::size_t PayloadSize>
+std::shared_ptr<SharedNode<UsePool>> makeSharedNode() {
+	using Node = SharedNodeWithPayload<UsePool, PayloadSize>;
+	if (UsePool) {
+		return std::shared_ptr<Node>(new Node(), std::default_delete<Node>(),
+			SmallBlockAllocator<Node>());
+	}
+	return std::shared_ptr<Node>(new Node());
+}
+
+/**
+* @brief Builds and destroys graphs of the given number of shared nodes of
+*        several sizes, which resembles the creation and destruction of BIR
+*        modules.
+*
+* The pool never returns its memory to the system, so its peak memory is
+* comparable to that of the global heap only when each benchmark runs in its
+* own process (e.g. <tt>--benchmark_filter=^SmallBlockPoolSharedGraph/1048576$</tt>).
+*/
+template<bool UsePool>
+void buildSharedGraphs(benchmark::State &state) {
+	const auto count = static_cast<std::size_t>(state.range(0));
+
+	PeakMemoryCounter memory;
+	for (auto _ : state) {
+		std::mt19937 generator(1);
+		std::vector<std::shared_ptr<SharedNode<UsePool>>> nodes;
+		nodes.reserve(count);
+		for (std::size_t i = 0; i < count; ++i) {
+			std::shared_ptr<SharedNode<UsePool>> node;
+			switch (generator() % 4) {
+				case 0: node = makeSharedNode<UsePool, 8>(); break;
+				case 1: node = makeSharedNode<UsePool, 24>(); break;
+				case 2: node = makeSharedNode<UsePool, 40>(); break;
+				default: node = makeSharedNode<UsePool, 72>(); break;
+			}
+			if (i > 0) {
+				node->child = nodes[generator() % i];
+				node->child->parent = node;
+			}
+			nodes.push_back(node);
+			// Optimizations replace nodes that are no longer needed.
+			if (generator() % 3 == 0) {
+				nodes[generator() % nodes.size()] = makeSharedNode<UsePool, 24>();
+			}
+		}
+		std::shuffle(nodes.begin(), nodes.end(), generator);
+	}
+	memory.report(state);
+	state.SetItemsProcessed(state.iterations() * count);
+}
+
+void SmallBlockPoolSharedGraph(benchmark::State &state) {
+	buildSharedGraphs<true>(state);
+	state.counters["poolBytes"] = SmallBlockPool::getReservedSize();
+}
+BENCHMARK(SmallBlockPoolSharedGraph)->Arg(1 << 16)->Arg(1 << 20);
+
+void OperatorNewSharedGraph(benchmark::State &state) {
+	buildSharedGraphs<false>(state);
+}
+BENCHMARK(OperatorNewSharedGraph)->Arg(1 << 16)->Arg(1 << 20);
+
+/**
+* @brief Loads of a cached entry of the given size from DiskCache (e.g. a
+*        cache hit of the output of bin2llvmir).
+*/
+void DiskCacheHit(benchmark::State &state) {
+	auto directory = fs::temp_directory_path() /
+		("retdec-benchmarks-disk-cache-" + std::to_string(std::random_device{}()));
+	auto bytes = makeRandomBytes(state.range(0));
+
+	{
+		DiskCache cache(directory.string());
+		cache.store("key", {
+			{"module.bc", std::string(bytes.begin(), bytes.end())},
+			{"config.json", std::string(1024, '{')}
+		});
+
+		for (auto _ : state) {
+			DiskCache::Entry entry;
+			if (!cache.load("key", entry)) {
+				state.SkipWithError("cached entry cannot be loaded");
+				break;
+			}
+			benchmark::DoNotOptimize(entry);
+		}
+		state.SetBytesProcessed(state.iterations() * bytes.size());
+	}
+
+	std::error_code ec;
+	fs::remove_all(directory, ec);
+}
+BENCHMARK(DiskCacheHit)->Arg(1 << 20)->Arg(16 << 20);
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
@@ -0,0 +1,328 @@
+/**
+* @file benchmarks/yaracpp_benchmarks.cpp
+* @brief Benchmarks of the @c yaracpp library.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <cstdint>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <yara.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/yaracpp/yara_detector.h"
+
+namespace retdec {
+namespace benchmarks {
+
+using namespace retdec::yaracpp;
+
+namespace
+{
+
+/**
+ * Returns @a count YARA rules, each with a hex string of 16 bytes with a
+ * wildcard, similar to the rules of static code signatures.
+ */
+std::string makeYaraRules(std::size_t count, std::uint32_t seed = 1)
+{
+	const char* HexDigits = "0123456789ABCDEF";
+	std::mt19937 generator(seed);
+	std::uniform_int_distribution<int> nibble(0, 15);
+
+	std::ostringstream rules;
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		rules << "rule r" << i << " {\n\tstrings:\n\t\t$a = {";
+		for (int j = 0; j < 16; ++j)
+		{
+			if (j == 8)
+			{
+				rules << " ??";
+			}
+			else
+			{
+				rules << " " << HexDigits[nibble(generator)]
+					<< HexDigits[nibble(generator)];
+			}
+		}
+		rules << " }\n\tcondition:\n\t\t$a\n}\n";
+	}
+	return rules.str();
+}
+
+/**
+ * Temporary directory with a rule file of the given number of rules.
+ */
+class RuleFile
+{
+	public:
+		explicit RuleFile(std::size_t rules)
+			: directory(fs::temp_directory_path()
+					/ ("retdec-benchmarks-" + std::to_string(std::random_device{}())))
+		{
+			fs::create_directories(directory);
+			std::ofstream(getPath()) << makeYaraRules(rules);
+		}
+
+		~RuleFile()
+		{
+			YaraDetector::setCacheDirectory(std::string());
+			YaraDetector::releaseCompiledRules();
+			std::error_code ec;
+			fs::remove_all(directory, ec);
+		}
+
+		std::string getPath() const
+		{
+			return (directory / "rules.yar").string();
+		}
+
+		std::string getCacheDirectory() const
+		{
+			return (directory / "cache").string();
+		}
+
+	private:
+		const fs::path directory;
+};
+
+/**
+ * Creates a detector of rules from @a file and scans a small input by it.
+ */
+void startDetector(benchmark::State& state, const RuleFile& file)
+{
+	std::vector<std::uint8_t> input(0x1000);
+	YaraDetector detector;
+	detector.addRuleFile(file.getPath());
+	if (!detector.analyze(input))
+	{
+		state.SkipWithError("rules cannot be compiled");
+	}
+}
+
+/**
+ * Startup of a detector of the given number of rules whose compiled version
+ * is neither in memory nor in the cache directory, so they are compiled.
+ */
+void YaraStartupCompile(benchmark::State& state)
+{
+	RuleFile file(state.range(0));
+
+	for (auto _ : state)
+	{
+		YaraDetector::releaseCompiledRules();
+		startDetector(state, file);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(YaraStartupCompile)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Startup of a detector of the given number of rules whose compiled version
+ * is loaded from the cache directory (e.g. in a new process).
+ */
+void YaraStartupFromCacheDirectory(benchmark::State& state)
+{
+	RuleFile file(state.range(0));
+	YaraDetector::setCacheDirectory(file.getCacheDirectory());
+	startDetector(state, file);
+
+	for (auto _ : state)
+	{
+		YaraDetector::releaseCompiledRules();
+		startDetector(state, file);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(YaraStartupFromCacheDirectory)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Startup of a detector of the given number of rules which were already
+ * compiled by another detector in the same process.
+ */
+void YaraStartupFromMemory(benchmark::State& state)
+{
+	RuleFile file(state.range(0));
+	startDetector(state, file);
+
+	for (auto _ : state)
+	{
+		startDetector(state, file);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(YaraStartupFromMemory)->Arg(1000)->Arg(10000)->Unit(benchmark::kMillisecond);
+
+/// Number of precompiled rule files in the directory of
+/// YaraScanPrecompiledFiles and YaraScanMergedRules, which is about the number
+/// of static code signature files of one architecture.
+const std::size_t PrecompiledFiles = 16;
+
+/// Number of rules in every precompiled rule file.
+const std::size_t RulesPerFile = 2000;
+
+/**
+ * Compiles @a sources (pairs of namespace and rules) into precompiled rule
+ * file @a path, like @c yarac does.
+ * @return @c true if the file was written, @c false otherwise.
+ */
+bool saveCompiledRules(
+		const std::string& path,
+		const std::vector<std::pair<std::string, std::string>>& sources)
+{
+	if (yr_initialize() != ERROR_SUCCESS)
+	{
+		return false;
+	}
+
+	auto result = false;
+	YR_COMPILER* compiler = nullptr;
+	if (yr_compiler_create(&compiler) == ERROR_SUCCESS)
+	{
+		result = true;
+		for (const auto& source : sources)
+		{
+			result = result && yr_compiler_add_string(
+					compiler,
+					source.second.c_str(),
+					source.first.empty() ? nullptr : source.first.c_str()) == 0;
+		}
+
+		YR_RULES* rules = nullptr;
+		result = result
+				&& yr_compiler_get_rules(compiler, &rules) == ERROR_SUCCESS
+				&& yr_rules_save(rules, path.c_str()) == ERROR_SUCCESS;
+		if (rules)
+		{
+			yr_rules_destroy(rules);
+		}
+		yr_compiler_destroy(compiler);
+	}
+
+	yr_finalize();
+	return result;
+}
+
+/**
+ * Temporary directory with @c PrecompiledFiles precompiled rule files, and
+ * optionally with their merged rules, as installed by
+ * @c support/install-yara.py.
+ */
+class PrecompiledDirectory
+{
+	public:
+		explicit PrecompiledDirectory(bool merge)
+			: directory(fs::temp_directory_path()
+					/ ("retdec-benchmarks-" + std::to_string(std::random_device{}())))
+		{
+			fs::create_directories(directory);
+			std::vector<std::pair<std::string, std::string>> sources;
+			for (std::size_t i = 0; i < PrecompiledFiles; ++i)
+			{
+				const auto name = "file" + std::to_string(i) + ".yarac";
+				sources.emplace_back(name, makeYaraRules(RulesPerFile, i + 1));
+				valid = saveCompiledRules(
+						(directory / name).string(),
+						{{std::string(), sources.back().second}}) && valid;
+				paths.push_back((directory / name).string());
+			}
+			if (merge)
+			{
+				valid = saveCompiledRules(
+						(directory / "merged.yaracm").string(),
+						sources) && valid;
+			}
+		}
+
+		~PrecompiledDirectory()
+		{
+			YaraDetector::releaseCompiledRules();
+			std::error_code ec;
+			fs::remove_all(directory, ec);
+		}
+
+		bool isValid() const
+		{
+			return valid;
+		}
+
+		/**
+		 * Returns paths to the first @a count rule files.
+		 */
+		std::vector<std::string> getPaths(std::size_t count) const
+		{
+			return std::vector<std::string>(paths.begin(), paths.begin() + count);
+		}
+
+	private:
+		const fs::path directory;
+		std::vector<std::string> paths;
+		bool valid = true;
+};
+
+/**
+ * Scan of a 4 MiB input by the given number of precompiled rule files of a
+ * directory, as static code detection does. The compiled rules are already
+ * loaded, so the benchmark shows the time of scanning.
+ */
+void scanPrecompiledFiles(benchmark::State& state, bool merge)
+{
+	PrecompiledDirectory directory(merge);
+	if (!directory.isValid())
+	{
+		state.SkipWithError("rules cannot be compiled");
+		return;
+	}
+
+	const auto paths = directory.getPaths(state.range(0));
+	std::vector<std::uint8_t> input(4 << 20);
+	std::mt19937 generator(1);
+	for (auto& byte : input)
+	{
+		byte = static_cast<std::uint8_t>(generator());
+	}
+
+	for (auto _ : state)
+	{
+		YaraDetector detector;
+		detector.addRuleFiles(paths);
+		if (!detector.analyze(input.data(), input.size()))
+		{
+			state.SkipWithError("input cannot be scanned");
+			break;
+		}
+	}
+	state.SetBytesProcessed(state.iterations() * input.size());
+}
+
+/**
+ * Scan by precompiled rule files one by one (no merged rules).
+ */
+void YaraScanPrecompiledFiles(benchmark::State& state)
+{
+	scanPrecompiledFiles(state, false);
+}
+BENCHMARK(YaraScanPrecompiledFiles)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+/**
+ * Scan by merged rules of all the precompiled rule files in the directory,
+ * reporting only rules of the selected files.
+ */
+void YaraScanMergedRules(benchmark::State& state)
+{
+	scanPrecompiledFiles(state, true);
+}
+BENCHMARK(YaraScanMergedRules)->Arg(4)->Arg(16)->Unit(benchmark::kMillisecond);
+
+} // anonymous namespace
+
+} // namespace benchmarks
+} // namespace retdec
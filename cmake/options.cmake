@@ -3,6 +3,7 @@
 #
 option(RETDEC_DOC "Build public API documentation (requires Doxygen)." OFF)
 option(RETDEC_TESTS "Build tests." OFF)
+option(RETDEC_BENCHMARKS "Build benchmarks (requires Google Benchmark)." OFF)
 option(RETDEC_DEV_TOOLS "Build dev tools." OFF)
 option(RETDEC_COMPILE_YARA "Compile YARA rules at installation." ON)
 option(RETDEC_MSVC_STATIC_RUNTIME "Use a multi-threaded statically-linked runtime library." OFF)
@@ -20,6 +21,7 @@ option(RETDEC_ENABLE_CONFIG "" OFF)
 option(RETDEC_ENABLE_CPDETECT "" OFF)
 option(RETDEC_ENABLE_CTYPES "" OFF)
 option(RETDEC_ENABLE_CTYPESPARSER "" OFF)
+option(RETDEC_ENABLE_CTYPESPARSERTOOL "" OFF)
 option(RETDEC_ENABLE_DEBUGFORMAT "" OFF)
 option(RETDEC_ENABLE_DEMANGLER "" OFF)
 option(RETDEC_ENABLE_DEMANGLERTOOL "" OFF)
@@ -33,6 +35,7 @@ option(RETDEC_ENABLE_LLVMIR2HLL "" OFF)
 option(RETDEC_ENABLE_LOADER "" OFF)
 option(RETDEC_ENABLE_MACHO_EXTRACTOR "" OFF)
 option(RETDEC_ENABLE_MACHO_EXTRACTORTOOL "" OFF)
+option(RETDEC_ENABLE_ORDINALSTOOL "" OFF)
 option(RETDEC_ENABLE_PAT2YARA "" OFF)
 option(RETDEC_ENABLE_PATTERNGEN "" OFF)
 option(RETDEC_ENABLE_PDBPARSER "" OFF)
@@ -77,6 +80,7 @@ foreach(t ${RETDEC_ENABLE})
 	set_if_equal(${t} "cpdetect" RETDEC_ENABLE_CPDETECT)
 	set_if_equal(${t} "ctypes" RETDEC_ENABLE_CTYPES)
 	set_if_equal(${t} "ctypesparser" RETDEC_ENABLE_CTYPESPARSER)
+	set_if_equal(${t} "ctypesparsertool" RETDEC_ENABLE_CTYPESPARSERTOOL)
 	set_if_equal(${t} "debugformat" RETDEC_ENABLE_DEBUGFORMAT)
 	set_if_equal(${t} "demangler" RETDEC_ENABLE_DEMANGLER)
 	set_if_equal(${t} "demanglertool" RETDEC_ENABLE_DEMANGLERTOOL)
@@ -89,6 +93,7 @@ foreach(t ${RETDEC_ENABLE})
 	set_if_equal(${t} "loader" RETDEC_ENABLE_LOADER)
 	set_if_equal(${t} "extractor" RETDEC_ENABLE_MACHO_EXTRACTOR)
 	set_if_equal(${t} "extractortool" RETDEC_ENABLE_MACHO_EXTRACTORTOOL)
+	set_if_equal(${t} "ordinalstool" RETDEC_ENABLE_ORDINALSTOOL)
 	set_if_equal(${t} "pat2yara" RETDEC_ENABLE_PAT2YARA)
 	set_if_equal(${t} "patterngen" RETDEC_ENABLE_PATTERNGEN)
 	set_if_equal(${t} "pdbparser" RETDEC_ENABLE_PDBPARSER)
@@ -119,6 +124,7 @@ if (RETDEC_ENABLE_AR_EXTRACTOR
 	OR RETDEC_ENABLE_CPDETECT
 	OR RETDEC_ENABLE_CTYPES
 	OR RETDEC_ENABLE_CTYPESPARSER
+	OR RETDEC_ENABLE_CTYPESPARSERTOOL
 	OR RETDEC_ENABLE_DEBUGFORMAT
 	OR RETDEC_ENABLE_DEMANGLER
 	OR RETDEC_ENABLE_DEMANGLERTOOL
@@ -132,6 +138,7 @@ if (RETDEC_ENABLE_AR_EXTRACTOR
 	OR RETDEC_ENABLE_LOADER
 	OR RETDEC_ENABLE_MACHO_EXTRACTOR
 	OR RETDEC_ENABLE_MACHO_EXTRACTORTOOL
+	OR RETDEC_ENABLE_ORDINALSTOOL
 	OR RETDEC_ENABLE_PAT2YARA
 	OR RETDEC_ENABLE_PATTERNGEN
 	OR RETDEC_ENABLE_PDBPARSER
@@ -193,6 +200,12 @@ if(RETDEC_DEV_TOOLS)
 			RETDEC_ENABLE_ALL)
 endif()
 
+set_if_at_least_one_set(RETDEC_ENABLE_CTYPESPARSERTOOL
+		RETDEC_ENABLE_ALL)
+
+set_if_at_least_one_set(RETDEC_ENABLE_ORDINALSTOOL
+		RETDEC_ENABLE_ALL)
+
 set_if_at_least_one_set(RETDEC_ENABLE_FILEINFO
 		RETDEC_ENABLE_ALL)
 
@@ -287,6 +300,7 @@ set_if_at_least_one_set(RETDEC_ENABLE_DEMANGLER
 set_if_at_least_one_set(RETDEC_ENABLE_CTYPESPARSER
 		RETDEC_ENABLE_ALL
 		RETDEC_ENABLE_BIN2LLVMIR
+		RETDEC_ENABLE_CTYPESPARSERTOOL
 		RETDEC_ENABLE_DEMANGLER)
 
 set_if_at_least_one_set(RETDEC_ENABLE_CTYPES
@@ -356,11 +370,13 @@ set_if_at_least_one_set(RETDEC_ENABLE_UTILS
 		RETDEC_ENABLE_AR_EXTRACTORTOOL
 		RETDEC_ENABLE_BIN2LLVMIR
 		RETDEC_ENABLE_BIN2PAT
+		RETDEC_ENABLE_CAPSTONE2LLVMIR
 		RETDEC_ENABLE_CAPSTONE2LLVMIRTOOL
 		RETDEC_ENABLE_CONFIG
 		RETDEC_ENABLE_COMMON
 		RETDEC_ENABLE_CTYPES
 		RETDEC_ENABLE_CTYPESPARSER
+		RETDEC_ENABLE_CTYPESPARSERTOOL
 		RETDEC_ENABLE_FILEFORMAT
 		RETDEC_ENABLE_FILEINFO
 		RETDEC_ENABLE_IDR2PAT
@@ -369,8 +385,10 @@ set_if_at_least_one_set(RETDEC_ENABLE_UTILS
 		RETDEC_ENABLE_LOADER
 		RETDEC_ENABLE_MACHO_EXTRACTOR
 		RETDEC_ENABLE_MACHO_EXTRACTORTOOL
+		RETDEC_ENABLE_ORDINALSTOOL
 		RETDEC_ENABLE_CPDETECT
 		RETDEC_ENABLE_PATTERNGEN
+		RETDEC_ENABLE_PDBPARSER
 		RETDEC_ENABLE_RTTI_FINDER
 		RETDEC_ENABLE_STACOFIN
 		RETDEC_ENABLE_UNPACKERTOOL)
@@ -391,18 +409,27 @@ set_if_all_set(RETDEC_ENABLE_CAPSTONE2LLVMIR_TESTS
 set_if_all_set(RETDEC_ENABLE_CONFIG_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_CONFIG)
+set_if_all_set(RETDEC_ENABLE_CPDETECT_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_CPDETECT)
 set_if_all_set(RETDEC_ENABLE_CTYPES_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_CTYPES)
 set_if_all_set(RETDEC_ENABLE_CTYPESPARSER_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_CTYPESPARSER)
+set_if_all_set(RETDEC_ENABLE_DEBUGFORMAT_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_DEBUGFORMAT)
 set_if_all_set(RETDEC_ENABLE_DEMANGLER_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_DEMANGLER)
 set_if_all_set(RETDEC_ENABLE_FILEFORMAT_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_FILEFORMAT)
+set_if_all_set(RETDEC_ENABLE_FILEINFO_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_FILEINFO)
 set_if_all_set(RETDEC_ENABLE_LLVMIR_EMUL_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_LLVMIR_EMUL)
@@ -412,6 +439,15 @@ set_if_all_set(RETDEC_ENABLE_LLVMIR2HLL_TESTS
 set_if_all_set(RETDEC_ENABLE_LOADER_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_LOADER)
+set_if_all_set(RETDEC_ENABLE_PDBPARSER_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_PDBPARSER)
+set_if_all_set(RETDEC_ENABLE_PELIB_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_PELIB)
+set_if_all_set(RETDEC_ENABLE_RETDEC_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_RETDEC)
 set_if_all_set(RETDEC_ENABLE_SERDES_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_SERDES)
@@ -424,10 +460,20 @@ set_if_all_set(RETDEC_ENABLE_COMMON_TESTS
 set_if_all_set(RETDEC_ENABLE_UTILS_TESTS
 		RETDEC_TESTS
 		RETDEC_ENABLE_UTILS)
+set_if_all_set(RETDEC_ENABLE_YARACPP_TESTS
+		RETDEC_TESTS
+		RETDEC_ENABLE_YARACPP)
+
+# benchmarks
+set_if_all_set(RETDEC_ENABLE_BENCHMARKS
+		RETDEC_BENCHMARKS
+		RETDEC_ENABLE_UTILS)
 
 # src depending on tests
 set_if_at_least_one_set(RETDEC_ENABLE_LLVMIR_EMUL
 		RETDEC_ENABLE_CAPSTONE2LLVMIR_TESTS)
+set_if_at_least_one_set(RETDEC_ENABLE_SERDES
+		RETDEC_ENABLE_DEBUGFORMAT_TESTS)
 
 # deps
 set_if_at_least_one_set(RETDEC_ENABLE_AUTHENTICODE_PARSER
@@ -445,16 +491,26 @@ set_if_at_least_one_set(RETDEC_ENABLE_GOOGLETEST
 		RETDEC_ENABLE_CAPSTONE2LLVMIR_TESTS
 		RETDEC_ENABLE_COMMON_TESTS
 		RETDEC_ENABLE_CONFIG_TESTS
+		RETDEC_ENABLE_CPDETECT_TESTS
 		RETDEC_ENABLE_CTYPES_TESTS
 		RETDEC_ENABLE_CTYPESPARSER_TESTS
+		RETDEC_ENABLE_DEBUGFORMAT_TESTS
 		RETDEC_ENABLE_DEMANGLER_TESTS
 		RETDEC_ENABLE_FILEFORMAT_TESTS
+		RETDEC_ENABLE_FILEINFO_TESTS
 		RETDEC_ENABLE_LLVMIR_EMUL_TESTS
 		RETDEC_ENABLE_LLVMIR2HLL_TESTS
 		RETDEC_ENABLE_LOADER_TESTS
+		RETDEC_ENABLE_PDBPARSER_TESTS
+		RETDEC_ENABLE_PELIB_TESTS
+		RETDEC_ENABLE_RETDEC_TESTS
 		RETDEC_ENABLE_SERDES_TESTS
 		RETDEC_ENABLE_UNPACKER_TESTS
-		RETDEC_ENABLE_UTILS_TESTS)
+		RETDEC_ENABLE_UTILS_TESTS
+		RETDEC_ENABLE_YARACPP_TESTS)
+
+set_if_at_least_one_set(RETDEC_ENABLE_GOOGLEBENCHMARK
+		RETDEC_ENABLE_BENCHMARKS)
 
 set_if_at_least_one_set(RETDEC_ENABLE_KEYSTONE
 		RETDEC_ENABLE_CAPSTONE2LLVMIRTOOL
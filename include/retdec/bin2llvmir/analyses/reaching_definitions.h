@@ -3,9 +3,11 @@
 * @brief Reaching definitions analysis (RDA) builds UD and DU chains.
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 *
-* Right now, this works on an entire module. But we could insert an another layer
-* that represents functions. Then it would be possible to associate BBs with
-* functions that own them and recompute RDA only for the selected function.
+* Results are computed and stored per function, so they can be kept between
+* passes and recomputed only for functions that were changed (see update()).
+*
+* Definitions of a function are densely numbered and reaching definitions are
+* propagated as bit vectors by a worklist solver.
 */
 
 #ifndef RETDEC_BIN2LLVMIR_ANALYSES_REACHING_DEFINITIONS_H
@@ -20,6 +22,7 @@
 #include <llvm/ADT/SmallPtrSet.h>
 #include <llvm/IR/Module.h>
 
+#include "retdec/utils/thread_pool.h"
 #include "retdec/bin2llvmir/providers/abi/abi.h"
 #include "retdec/bin2llvmir/utils/debug.h"
 
@@ -29,12 +32,9 @@ namespace bin2llvmir {
 class Definition;
 class Use;
 class BasicBlockEntry;
+class FunctionEntry;
 class ReachingDefinitionsAnalysis;
 
-using Changed = bool;
-
-using BBEntrySet = std::unordered_set<BasicBlockEntry*>;
-
 using DefSet = std::unordered_set<Definition*>;
 using UseSet = std::unordered_set<Use*>;
 
@@ -86,35 +86,53 @@ class BasicBlockEntry
 		BasicBlockEntry(const llvm::BasicBlock* b = nullptr, std::size_t _id = 0);
 
 		std::string getName() const;
-		friend std::ostream& operator<<(
-				std::ostream& out,
-				const BasicBlockEntry& bbe);
 
-		void initializeKillDefSets();
-		Changed initDefsOut();
+	public:
+		const llvm::BasicBlock* bb;
+
+		/// Definitions of this BB are <defsBegin, defsEnd) in FunctionEntry::defs.
+		unsigned defsBegin = 0;
+		unsigned defsEnd = 0;
+		/// Uses of this BB are <usesBegin, usesEnd) in FunctionEntry::uses.
+		unsigned usesBegin = 0;
+		unsigned usesEnd = 0;
+
+		/// Indexes of predecessors in FunctionEntry::bbs.
+		std::vector<unsigned> prevBBs;
+		/// Indexes of successors in FunctionEntry::bbs.
+		std::vector<unsigned> nextBBs;
 
+	private:
+		unsigned id;
+};
+
+/**
+ * RDA results of one function.
+ * Definitions are numbered by their indexes in @c defs. Definitions and uses
+ * of each basic block are stored in @c defs and @c uses continuously, in the
+ * order of their instructions.
+ */
+class FunctionEntry
+{
+	public:
 		const DefSet& defsFromUse(const llvm::Instruction* I) const;
 		const UseSet& usesFromDef(const llvm::Instruction* I) const;
 		const Definition* getDef(const llvm::Instruction* I) const;
 		const Use* getUse(const llvm::Instruction* I) const;
 
-	public:
-		const llvm::BasicBlock* bb;
+		friend std::ostream& operator<<(
+				std::ostream& out,
+				const FunctionEntry& fe);
 
+	public:
+		std::vector<BasicBlockEntry> bbs;
 		DefVector defs;
 		UseVector uses;
 
-		BBEntrySet prevBBs;
-
-		// defsIn is union of prevBBs' defsOuts
-		DefSet defsOut;
-		DefSet genDefs;
-		std::unordered_set<llvm::Value*> killDefs;
-
-		bool changed = false;
-
-	private:
-		unsigned id;
+		/// Definition instruction -> index of its definition in @c defs.
+		std::unordered_map<const llvm::Instruction*, unsigned> inst2def;
+		/// Use instruction -> index of its first use in @c uses.
+		std::unordered_map<const llvm::Instruction*, unsigned> inst2use;
 };
 
 class ReachingDefinitionsAnalysis
@@ -131,6 +149,34 @@ class ReachingDefinitionsAnalysis
 		void clear();
 		bool wasRun() const;
 
+	// Cached interface.
+	//
+	public:
+		/// Counters of reused and recomputed function results.
+		struct CacheStatistics
+		{
+			/// Functions whose results were reused.
+			std::size_t hits = 0;
+			/// Functions whose results were (re)computed.
+			std::size_t recomputes = 0;
+			/// Functions whose results were invalidated by invalidate() or
+			/// invalidateAll().
+			std::size_t invalidations = 0;
+		};
+
+		void update(
+				llvm::Module& M,
+				Abi* abi = nullptr,
+				bool trackFlagRegs = false,
+				utils::ThreadPool* pool = nullptr);
+		void update(
+				llvm::Function& F,
+				Abi* abi = nullptr,
+				bool trackFlagRegs = false);
+		void invalidate(const llvm::Function* F);
+		void invalidateAll();
+		const CacheStatistics& getCacheStatistics() const;
+
 	// Full instance interface.
 	//
 	public:
@@ -152,22 +198,24 @@ class ReachingDefinitionsAnalysis
 				llvm::Instruction* I);
 
 	private:
-		void run();
-		const BasicBlockEntry& getBasicBlockEntry(const llvm::Instruction* I) const;
-		void initializeBasicBlocks(llvm::Module& M);
-		void initializeBasicBlocks(llvm::Function& F);
-		void initializeBasicBlocksPrev();
-		void initializeKillGenSets();
-		void propagate();
-		void initializeDefsAndUses();
-		void clearInternal();
+		void run(llvm::Function& F, FunctionEntry& fe) const;
+		void setParameters(llvm::Module& M, Abi* abi, bool trackFlagRegs);
+		void updateFunction(llvm::Function& F);
+		const FunctionEntry& getFunctionEntry(const llvm::Instruction* I) const;
+		FunctionEntry* resetFunctionEntry(llvm::Function& F);
+		void initializeBasicBlocks(llvm::Function& F, FunctionEntry& fe) const;
 
 	private:
-		std::map<const llvm::Function*, std::map<const llvm::BasicBlock*, BasicBlockEntry>> bbMap;
+		std::map<const llvm::Function*, FunctionEntry> fncMap;
 		bool _trackFlagRegs = false;
 		const llvm::GlobalVariable* _specialGlobal = nullptr;
 		bool _run = false;
 		Abi* _abi = nullptr;
+
+		/// Functions whose results in fncMap are up to date, i.e. which were
+		/// not invalidated since their results were computed.
+		std::set<const llvm::Function*> _upToDate;
+		CacheStatistics _cacheStatistics;
 };
 
 } // namespace bin2llvmir
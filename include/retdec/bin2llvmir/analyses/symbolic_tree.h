@@ -11,6 +11,7 @@
 #ifndef RETDEC_BIN2LLVMIR_ANALYSES_SYMBOLIC_TREE_H
 #define RETDEC_BIN2LLVMIR_ANALYSES_SYMBOLIC_TREE_H
 
+#include <mutex>
 #include <set>
 #include <unordered_set>
 #include <vector>
@@ -38,6 +39,11 @@ namespace bin2llvmir {
  * In such a case, global data members and global behaviour configuration is
  * not a problem. If you, for whatever reason, want to store instances, keep
  * this in mind.
+ * The static data members are thread-local, so modules processed in
+ * different threads do not share them. Trees of a single module can be built
+ * in several threads if each of them gets the module's configuration (see
+ * getConfiguration() and setConfiguration()) with a mutex that guards the
+ * module's LLVM context.
  */
 class SymbolicTree
 {
@@ -134,8 +140,30 @@ class SymbolicTree
 
 	// Global SymbolicTree configuration methods and data.
 	//
+	public:
+		/**
+		 * Snapshot of the (thread-local) global configuration.
+		 */
+		struct Configuration
+		{
+			Abi* abi = nullptr;
+			Config* config = nullptr;
+			bool val2valUsed = false;
+			bool trackThroughAllocaLoads = true;
+			bool trackThroughGeneralRegisterLoads = true;
+			bool trackOnlyFlagRegisters = false;
+			bool simplifyAtCreation = true;
+			unsigned naryLimit = 3;
+			/// If set, it is locked whenever a tree creates a new constant in
+			/// the LLVM context, which is not thread-safe.
+			std::mutex* llvmContextMutex = nullptr;
+		};
+
 	public:
 		static void clear();
+		static void clear(llvm::Module* m);
+		static Configuration getConfiguration();
+		static void setConfiguration(const Configuration& c);
 		static bool isVal2ValMapUsed();
 		static void setAbi(Abi* abi);
 		static void setConfig(Config* config);
@@ -147,14 +175,15 @@ class SymbolicTree
 		static void setNaryLimit(unsigned n);
 
 	private:
-		static Abi* _abi;
-		static Config* _config;
-		static bool _val2valUsed;
-		static bool _trackThroughAllocaLoads;
-		static bool _trackThroughGeneralRegisterLoads;
-		static bool _trackOnlyFlagRegisters;
-		static bool _simplifyAtCreation;
-		static unsigned _naryLimit;
+		static thread_local Abi* _abi;
+		static thread_local Config* _config;
+		static thread_local bool _val2valUsed;
+		static thread_local bool _trackThroughAllocaLoads;
+		static thread_local bool _trackThroughGeneralRegisterLoads;
+		static thread_local bool _trackOnlyFlagRegisters;
+		static thread_local bool _simplifyAtCreation;
+		static thread_local unsigned _naryLimit;
+		static thread_local std::mutex* _llvmContextMutex;
 
 	// Private methods.
 	//
@@ -166,6 +195,10 @@ class SymbolicTree
 				bool linear);
 
 		void _simplifyNode();
+
+		static llvm::Constant* getUndefValue(llvm::Type* t);
+		static llvm::Constant* getConstantInt(llvm::Type* t, uint64_t v);
+		static std::unique_lock<std::mutex> lockLlvmContext();
 		void fixLevel(unsigned level = 0);
 
 		void _getPreOrder(std::vector<SymbolicTree*>& res) const;
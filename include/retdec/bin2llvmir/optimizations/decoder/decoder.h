@@ -29,6 +29,7 @@
 #include "retdec/bin2llvmir/providers/names.h"
 #include "retdec/bin2llvmir/optimizations/decoder/decoder_debug.h"
 #include "retdec/bin2llvmir/optimizations/decoder/decoder_ranges.h"
+#include "retdec/bin2llvmir/optimizations/decoder/disassembly.h"
 #include "retdec/bin2llvmir/optimizations/decoder/jump_targets.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 #include "retdec/bin2llvmir/utils/symbolic_tree_match.h"
@@ -85,6 +86,7 @@ class Decoder : public llvm::ModulePass
 		void initVtables();
 
 	private:
+		void disassemble();
 		void decode();
 		bool getJumpTarget(JumpTarget& jt);
 		void decodeJumpTarget(const JumpTarget& jt);
@@ -304,6 +306,7 @@ class Decoder : public llvm::ModulePass
 
 		RangesToDecode _ranges;
 		JumpTargets _jumpTargets;
+		Disassembly _disassembly;
 
 		/// Name of all extern functions gathered from object files
 		std::set<std::string> _externs;
@@ -32,6 +32,7 @@ class RangesToDecode
 		bool primaryEmpty() const;
 		bool alternativeEmpty() const;
 
+		const common::AddressRangeContainer& getPrimaryRanges() const;
 		const common::AddressRange& primaryFront() const;
 		const common::AddressRange& alternativeFront() const;
 
@@ -0,0 +1,108 @@
+/**
+* @file include/retdec/bin2llvmir/optimizations/decoder/disassembly.h
+* @brief Parallel disassembly of the input binary ahead of its translation.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_DECODER_DISASSEMBLY_H
+#define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_DECODER_DISASSEMBLY_H
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "retdec/bin2llvmir/optimizations/decoder/decoder_ranges.h"
+#include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/capstone2llvmir/capstone2llvmir.h"
+#include "retdec/common/address.h"
+#include "retdec/utils/non_copyable.h"
+#include "retdec/utils/thread_pool.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Capstone instructions disassembled ahead of their translation to LLVM IR.
+ *
+ * This is the first phase of decoding: starting from the given addresses,
+ * code is disassembled by recursive descent on a thread pool -- every basic
+ * block is a task, tasks submitted from a worker are stolen by idle workers,
+ * and every thread uses its own Capstone handle. No LLVM IR is created.
+ *
+ * The second phase (Decoder) takes the instructions by take() instead of
+ * disassembling them again, so it only translates them. It discovers
+ * control flow on its own, so its output does not depend on what was (or was
+ * not) disassembled here.
+ *
+ * Disassembly looks ahead by at most the given number of instructions which
+ * were not taken yet. Basic blocks found when the limit is reached are
+ * deferred, and they are disassembled on the pool (in parallel with the
+ * translation) once the second phase takes half of the retained instructions.
+ */
+class Disassembly : private utils::NonCopyable
+{
+	public:
+		/// Address and Capstone basic mode to disassemble it in.
+		using Start = std::pair<common::Address, cs_mode>;
+
+		/// Default maximal number of retained instructions.
+		static const std::size_t DefaultMaxInstructions = 1 << 15;
+
+	public:
+		~Disassembly();
+
+		void run(
+				utils::ThreadPool& pool,
+				const capstone2llvmir::Capstone2LlvmIrTranslator& c2l,
+				FileImage* image,
+				const RangesToDecode& ranges,
+				const std::vector<Start>& starts,
+				std::size_t maxInstructions = DefaultMaxInstructions);
+		cs_insn* take(common::Address a, cs_mode m, std::size_t maxSize);
+		void clear();
+
+		std::size_t getInstructionCount() const;
+		std::size_t getBasicBlockCount() const;
+
+	private:
+		void disassembleBasicBlock(const Start& start);
+		void submitBasicBlock(const Start& start);
+		void submitTask(const Start& start);
+
+		csh acquireHandle(cs_mode m);
+		void releaseHandle(cs_mode m, csh h);
+		void closeHandles();
+
+	private:
+		utils::ThreadPool* _pool = nullptr;
+		const capstone2llvmir::Capstone2LlvmIrTranslator* _c2l = nullptr;
+		cs_arch _arch = CS_ARCH_X86;
+		cs_mode _extraMode = CS_MODE_LITTLE_ENDIAN;
+		FileImage* _image = nullptr;
+		const RangesToDecode* _ranges = nullptr;
+		std::size_t _maxInstructions = DefaultMaxInstructions;
+		/// Set when the remaining tasks should not disassemble anything.
+		std::atomic<bool> _stopping{false};
+
+		/// Guards all the members below.
+		mutable std::mutex _mutex;
+		/// Starts of basic blocks already submitted for disassembly.
+		std::set<Start> _bbs;
+		/// Disassembled instructions that were not taken yet.
+		std::map<Start, cs_insn*> _insns;
+		/// Basic blocks deferred because there were too many instructions
+		/// which were not taken yet.
+		std::vector<Start> _deferred;
+		/// Number of all disassembled instructions.
+		std::size_t _insnCount = 0;
+		/// Capstone handles not used by any thread at the moment.
+		std::map<cs_mode, std::vector<csh>> _freeHandles;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
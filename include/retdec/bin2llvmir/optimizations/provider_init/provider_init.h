@@ -29,6 +29,8 @@ class ProviderInitialization : public llvm::ModulePass
 
 		void setConfig(retdec::config::Config* c);
 
+		static void clearProviders(llvm::Module* m);
+
 	private:
 		retdec::config::Config* _config = nullptr;
 };
@@ -7,6 +7,7 @@
 #ifndef RETDEC_BIN2LLVMIR_OPTIMIZATIONS_STACK_STACK_H
 #define RETDEC_BIN2LLVMIR_OPTIMIZATIONS_STACK_STACK_H
 
+#include <mutex>
 #include <optional>
 #include <unordered_set>
 
@@ -35,12 +36,17 @@ class StackAnalysis : public llvm::ModulePass
 
 	private:
 		bool run();
+		void runOnFunction(
+				ReachingDefinitionsAnalysis& RDA,
+				llvm::Function& f,
+				std::unordered_set<llvm::Value*>& toRemove);
 		void handleInstruction(
 				ReachingDefinitionsAnalysis& RDA,
 				llvm::Instruction* inst,
 				llvm::Value* val,
 				llvm::Type* type,
-				std::map<llvm::Value*, llvm::Value*>& val2val);
+				std::map<llvm::Value*, llvm::Value*>& val2val,
+				std::unordered_set<llvm::Value*>& toRemove);
 		std::optional<int> getBaseOffset(SymbolicTree &root);
 		const retdec::common::Object* getDebugStackVariable(
 				llvm::Function* fnc,
@@ -55,7 +61,9 @@ class StackAnalysis : public llvm::ModulePass
 		Abi* _abi = nullptr;
 		DebugFormat* _dbgf = nullptr;
 
-		std::unordered_set<llvm::Value*> _toRemove;
+		/// Serializes changes of the module when functions are processed
+		/// in parallel.
+		std::mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -10,6 +10,7 @@
 #include <map>
 #include <memory>
 #include <set>
+#include <shared_mutex>
 #include <vector>
 
 #include <llvm/IR/Module.h>
@@ -165,9 +166,11 @@ class AbiProvider
 		static Abi* getAbi(llvm::Module* m);
 		static bool getAbi(llvm::Module* m, Abi*& abi);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, std::unique_ptr<Abi>> _module2abi;
+		static std::shared_mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -7,6 +7,14 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_ASM_INSTRUCTION_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_ASM_INSTRUCTION_H
 
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <utility>
+#include <vector>
+
 #include <capstone/capstone.h>
 #include "retdec/capstone2llvmir/arm/arm_defs.h"
 #include "retdec/capstone2llvmir/mips/mips_defs.h"
@@ -22,7 +30,65 @@
 namespace retdec {
 namespace bin2llvmir {
 
-using Llvm2CapstoneInsnMap = typename std::map<llvm::StoreInst*, cs_insn*>;
+/**
+ * Capstone instructions allocated by capstone2llvmir::retainInsn(), indexed by
+ * their addresses. Special LLVM IR instructions are mapped to them through the
+ * addresses they store (see AsmInstruction::getCapstoneInsn()).
+ *
+ * Addresses are split into pages of @c PageSize consecutive addresses. A page
+ * is an array of instructions indexed by the offset of their address in the
+ * page, and it is allocated only when an instruction on it is added. Pages are
+ * kept in a vector sorted by their addresses, so a lookup is a binary search
+ * over the pages followed by an access to the array, and there is no
+ * allocation per instruction.
+ *
+ * The map does not own the instructions, they are freed by
+ * AsmInstructionRemover.
+ */
+class Llvm2CapstoneInsnMap
+{
+	public:
+		void add(cs_insn* insn);
+		cs_insn* find(std::uint64_t address) const;
+		std::size_t size() const;
+		void clear();
+
+		/**
+		 * Call @a func for every instruction added to the map, including
+		 * instructions replaced by a later instruction on the same address.
+		 */
+		template<typename Func>
+		void forEach(Func func) const
+		{
+			for (auto& page : _pages)
+			{
+				for (auto* insn : *page.second)
+				{
+					if (insn)
+					{
+						func(insn);
+					}
+				}
+			}
+			for (auto* insn : _replaced)
+			{
+				func(insn);
+			}
+		}
+
+	private:
+		static constexpr std::size_t PageBits = 10;
+		static constexpr std::size_t PageSize = std::size_t(1) << PageBits;
+		using Page = std::array<cs_insn*, PageSize>;
+
+	private:
+		/// Pages sorted by their addresses (address >> PageBits).
+		std::vector<std::pair<std::uint64_t, std::unique_ptr<Page>>> _pages;
+		/// Instructions replaced by a later instruction on the same address.
+		std::vector<cs_insn*> _replaced;
+		/// Number of instructions in the pages.
+		std::size_t _size = 0;
+};
 
 /**
  * Assembly instruction representation.
@@ -175,24 +241,18 @@ class AsmInstruction
 				llvm::Function* f);
 		static bool isLlvmToAsmInstruction(const llvm::Value* inst);
 		static void clear();
+		static void clear(const llvm::Module* m);
 
 	private:
 		const llvm::GlobalVariable* getLlvmToAsmGlobalVariablePrivate(
 				llvm::Module* m) const;
 		bool isLlvmToAsmInstructionPrivate(llvm::Value* inst) const;
 
-	private:
-		using ModuleGlobalPair = std::pair<
-				const llvm::Module*,
-				llvm::GlobalVariable*>;
-		using ModuleInstructionMap = std::pair<
-				const llvm::Module*,
-				std::map<llvm::StoreInst*, cs_insn*>>;
-
 	private:
 		llvm::StoreInst* _llvmToAsmInstr = nullptr;
-		static std::vector<ModuleGlobalPair> _module2global;
-		static std::vector<ModuleInstructionMap> _module2instMap;
+		static std::map<const llvm::Module*, llvm::GlobalVariable*> _module2global;
+		static std::map<const llvm::Module*, Llvm2CapstoneInsnMap> _module2instMap;
+		static std::shared_mutex _mutex;
 
 	public:
 		template<
@@ -7,7 +7,9 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_CONFIG_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_CONFIG_H
 
+#include <map>
 #include <optional>
+#include <shared_mutex>
 
 #include "retdec/config/config.h"
 
@@ -206,9 +208,11 @@ class ConfigProvider
 		static bool getConfig(llvm::Module* m, Config*& c);
 		static void doFinalization(llvm::Module* m);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, Config> _module2config;
+		static std::shared_mutex _mutex;
 };
 
 } // namespace bin2llvmir
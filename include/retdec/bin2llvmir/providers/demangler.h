@@ -8,6 +8,7 @@
 #define RETDEC_BIN2LLVMIR_PROVIDERS_DEMANGLER_H
 
 #include <map>
+#include <shared_mutex>
 
 #include <llvm/IR/Module.h>
 
@@ -107,10 +108,12 @@ public:
 		Demangler *&d);
 
 	static void clear();
+	static void clear(llvm::Module *m);
 
 private:
 	/// Mapping of modules to demanglers associated with them.
 	static std::map<llvm::Module *, std::unique_ptr<Demangler>> _module2demangler;
+	static std::shared_mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -7,8 +7,14 @@
 #ifndef RETDEC_BIN2LLVMIR_PROVIDERS_LTI_H
 #define RETDEC_BIN2LLVMIR_PROVIDERS_LTI_H
 
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <vector>
+
 #include <llvm/IR/Module.h>
 
+#include "retdec/ctypesparser/binary_ctypes_parser.h"
 #include "retdec/ctypesparser/json_ctypes_parser.h"
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
@@ -42,6 +48,9 @@ class Lti
 
 	private:
 		void loadLtiFile(const std::string& filePath);
+		bool loadBinaryLtiFile(
+				const std::string& filePath,
+				const std::string& callConvention);
 		llvm::Type* getLlvmType(std::shared_ptr<retdec::ctypes::Type> type);
 
 	private:
@@ -51,6 +60,8 @@ class Lti
 		retdec::loader::Image* _image = nullptr;
 		std::unique_ptr<retdec::ctypes::Module> _ltiModule;
 		ctypesparser::JSONCTypesParser _ltiParser;
+		/// Lazily parsed binary LTI files, in the order of loading.
+		std::vector<std::unique_ptr<ctypesparser::BinaryCTypesParser>> _ltiDatabases;
 };
 
 class LtiProvider
@@ -64,9 +75,11 @@ class LtiProvider
 		static Lti* getLti(llvm::Module* m);
 		static bool getLti(llvm::Module* m, Lti*& lti);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, Lti> _module2lti;
+		static std::shared_mutex _mutex;
 };
 
 } // namespace bin2llvmir
@@ -8,7 +8,9 @@
 #define RETDEC_BIN2LLVMIR_PROVIDERS_NAMES_H
 
 #include <map>
+#include <memory>
 #include <set>
+#include <shared_mutex>
 
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/debugformat.h"
@@ -16,6 +18,7 @@
 #include "retdec/bin2llvmir/providers/fileimage.h"
 #include "retdec/bin2llvmir/providers/lti.h"
 #include "retdec/common/address.h"
+#include "retdec/utils/ordinal_database.h"
 
 namespace retdec {
 namespace bin2llvmir {
@@ -178,6 +181,8 @@ class NameContainer
 		std::string getNameFromImportLibAndOrd(
 				const std::string& libName,
 				int ord);
+		std::string getOrdinalsArch() const;
+		const retdec::utils::OrdinalDatabase* getOrdinalDatabase();
 		bool loadImportOrds(const std::string& libName);
 
 	private:
@@ -193,6 +198,11 @@ class NameContainer
 		std::map<retdec::common::Address, Names> _data;
 		/// <library name without suffix ".dll", map with ordinals>
 		std::map<std::string, ImportOrdMap> _dllOrds;
+		/// Database of all ordinal numbers, used instead of _dllOrds if it
+		/// exists.
+		std::unique_ptr<retdec::utils::OrdinalDatabase> _ordinals;
+		/// Has opening of _ordinals already been tried?
+		bool _ordinalsOpened = false;
 };
 
 /**
@@ -211,9 +221,11 @@ class NamesProvider
 		static NameContainer* getNames(llvm::Module* m);
 		static bool getNames(llvm::Module* m, NameContainer*& names);
 		static void clear();
+		static void clear(llvm::Module* m);
 
 	private:
 		static std::map<llvm::Module*, NameContainer> _module2names;
+		static std::shared_mutex _mutex;
 };
 
 } // namespace bin2llvmir
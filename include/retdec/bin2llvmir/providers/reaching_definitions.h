@@ -0,0 +1,70 @@
+/**
+ * @file include/retdec/bin2llvmir/providers/reaching_definitions.h
+ * @brief Reaching definitions analysis shared by passes.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_BIN2LLVMIR_PROVIDERS_REACHING_DEFINITIONS_H
+#define RETDEC_BIN2LLVMIR_PROVIDERS_REACHING_DEFINITIONS_H
+
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <utility>
+
+#include <llvm/IR/Module.h>
+
+#include "retdec/bin2llvmir/analyses/reaching_definitions.h"
+#include "retdec/bin2llvmir/providers/abi/abi.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Completely static object -- all members and methods are static -> it can be
+ * used by anywhere in bin2llvmirl. It provides mapping of modules to reaching
+ * definitions analyses computed for them.
+ *
+ * Analyses are kept between passes. When a pass requests an analysis, it is
+ * recomputed only for functions that changed since the last request (see
+ * ReachingDefinitionsAnalysis::update()). Passes that change functions must
+ * report it by invalidate(). The results of passes that do not report their
+ * changes are invalidated as a whole by invalidate(llvm::Module*) after them.
+ */
+class ReachingDefinitionsProvider
+{
+	public:
+		static ReachingDefinitionsAnalysis& getAnalysis(
+				llvm::Module* m,
+				Abi* abi,
+				bool trackFlagRegs = false);
+		static ReachingDefinitionsAnalysis& getAnalysis(
+				llvm::Function* f,
+				Abi* abi,
+				bool trackFlagRegs = false);
+		static void invalidate(llvm::Function* f);
+		static void invalidate(llvm::Module* m);
+
+		static ReachingDefinitionsAnalysis::CacheStatistics getStatistics(
+				llvm::Module* m);
+
+		static void clear();
+		static void clear(llvm::Module* m);
+
+	private:
+		static ReachingDefinitionsAnalysis& getAnalysisEntry(
+				llvm::Module* m,
+				bool trackFlagRegs);
+
+	private:
+		/// Analyses for (module, tracking of flag registers) pairs.
+		static std::map<
+				std::pair<llvm::Module*, bool>,
+				ReachingDefinitionsAnalysis> _module2rda;
+		static std::shared_mutex _mutex;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
@@ -0,0 +1,50 @@
+/**
+ * @file include/retdec/bin2llvmir/providers/thread_pool.h
+ * @brief Thread pool provider for bin2llvmirl.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_BIN2LLVMIR_PROVIDERS_THREAD_POOL_H
+#define RETDEC_BIN2LLVMIR_PROVIDERS_THREAD_POOL_H
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+
+#include <llvm/IR/Module.h>
+
+#include "retdec/utils/thread_pool.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+/**
+ * Completely static object -- all members and methods are static -> it can be
+ * used by anywhere in bin2llvmirl. It provides mapping of modules to thread
+ * pools used to analyze their functions in parallel.
+ *
+ * If there is no thread pool for a module, its functions are analyzed
+ * serially.
+ */
+class ThreadPoolProvider
+{
+	public:
+		static utils::ThreadPool* addThreadPool(
+				llvm::Module* m,
+				std::size_t jobs);
+		static utils::ThreadPool* getThreadPool(llvm::Module* m);
+		static void clear();
+		static void clear(llvm::Module* m);
+
+	private:
+		static std::map<
+				llvm::Module*,
+				std::unique_ptr<utils::ThreadPool>> _module2pool;
+		static std::shared_mutex _mutex;
+};
+
+} // namespace bin2llvmir
+} // namespace retdec
+
+#endif
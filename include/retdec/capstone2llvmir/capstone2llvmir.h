@@ -20,6 +20,7 @@
 
 #include "retdec/common/address.h"
 #include "retdec/capstone2llvmir/exceptions.h"
+#include "retdec/capstone2llvmir/retained_insn.h"
 
 // These are additions to capstone - include them all here.
 #include "retdec/capstone2llvmir/arm/arm_defs.h"
@@ -353,8 +354,9 @@ class Capstone2LlvmIrTranslator
 			/// All created LLVM IR instructions are added to the working LLVM
 			/// module and should be automatically destroyed when module is
 			/// destroyed.
-			/// All capstone instructions are dynamically allocated by this
-			/// method, and must be freed by caller to avoid memory leaks.
+			/// All capstone instructions are allocated by retainInsn() in
+			/// this method, and must be freed by caller with
+			/// freeRetainedInsn() to avoid memory leaks.
 			std::list<std::pair<llvm::StoreInst*, cs_insn*>> insns;
 			/// Byte size of the translated binary chunk.
 			std::size_t size = 0;
@@ -402,8 +404,9 @@ class Capstone2LlvmIrTranslator
 			/// destroyed.
 			llvm::StoreInst* llvmInsn = nullptr;
 			/// Translated capstone instruction.
-			/// Capstone instruction is dynamically allocated by this
-			/// method, and must be freed by caller to avoid memory leaks.
+			/// Capstone instruction is allocated by retainInsn() in this
+			/// method, and must be freed by caller with freeRetainedInsn()
+			/// to avoid memory leaks.
 			cs_insn* capstoneInsn = nullptr;
 			/// Byte size of the translated binary chunk.
 			std::size_t size = 0;
@@ -433,6 +436,23 @@ class Capstone2LlvmIrTranslator
 				std::size_t& size,
 				retdec::common::Address& a,
 				llvm::IRBuilder<>& irb) = 0;
+		/**
+		 * Translate one already disassembled assembly instruction.
+		 * @param insn  Capstone instruction to translate. It must have been
+		 *              disassembled with details, for the architecture and
+		 *              mode of this translator, and allocated by
+		 *              retainInsn(). Its ownership is passed to the returned
+		 *              result.
+		 * @param a     This will be set to point to the next instruction.
+		 * @param irb   LLVM IR builder used to create LLVM IR translation.
+		 *              Translated LLVM IR instructions are created at its
+		 *              current position.
+		 * @return See @c TranslationResult structure.
+		 */
+		virtual TranslationResultOne translateOne(
+				cs_insn* insn,
+				retdec::common::Address& a,
+				llvm::IRBuilder<>& irb) = 0;
 //
 //==============================================================================
 // Capstone related getters and query methods.
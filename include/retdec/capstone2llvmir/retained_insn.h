@@ -0,0 +1,52 @@
+/**
+ * @file include/retdec/capstone2llvmir/retained_insn.h
+ * @brief Compact pooled storage of Capstone instructions that are kept
+ *        after their translation.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_CAPSTONE2LLVMIR_RETAINED_INSN_H
+#define RETDEC_CAPSTONE2LLVMIR_RETAINED_INSN_H
+
+#include <cstddef>
+
+#include <capstone/capstone.h>
+
+namespace retdec {
+namespace capstone2llvmir {
+
+/**
+ * Copy the given decoded instruction into a compact block allocated from
+ * utils::SmallBlockPool.
+ *
+ * Capstone details are a union of all the architectures with room for the
+ * maximal number of operands (e.g. 36 operands on ARM), so instructions
+ * allocated by @c cs_malloc() take a few kilobytes each. The copy keeps only
+ * the part of the details used by architecture @a arch and only the first
+ * @c op_count operands, and it is stored in a single block together with
+ * the instruction. Operands past @c op_count must not be accessed in
+ * the copy.
+ *
+ * @param arch Architecture @a insn was disassembled for.
+ * @param insn Instruction to copy. It is usually a scratch instruction that
+ *             is reused for decoding of the following instructions.
+ * @return The copy, which must be freed by freeRetainedInsn().
+ */
+cs_insn* retainInsn(cs_arch arch, const cs_insn* insn);
+
+/**
+ * Free an instruction created by retainInsn().
+ * It does nothing if @a insn is @c nullptr.
+ */
+void freeRetainedInsn(cs_insn* insn);
+
+/**
+ * @return Size (in bytes) of the block retainInsn() would allocate for
+ *         instruction @a insn of architecture @a arch.
+ */
+std::size_t getRetainedInsnSize(cs_arch arch, const cs_insn* insn);
+
+} // namespace capstone2llvmir
+} // namespace retdec
+
+#endif
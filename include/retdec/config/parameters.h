@@ -50,6 +50,10 @@ class Parameters
 		void setIsKeepAllFunctions(bool b);
 		void setIsSelectedDecodeOnly(bool b);
 		void setOrdinalNumbersDirectory(const std::string& n);
+		void setYaraCacheDirectory(const std::string& n);
+		void setProfilePassesFile(const std::string& n);
+		void setBin2llvmirCacheDirectory(const std::string& n);
+		void setBin2llvmirCacheMaxSize(uint64_t size);
 		void setInputFile(const std::string& file);
 		void setInputPdbFile(const std::string& file);
 		void setOutputFile(const std::string& n);
@@ -64,6 +68,7 @@ class Parameters
 		void setMaxMemoryLimit(uint64_t limit);
 		void setIsMaxMemoryLimitHalfRam(bool f);
 		void setTimeout(uint64_t seconds);
+		void setAnalysisJobs(uint64_t jobs);
 		void setEntryPoint(const retdec::common::Address& a);
 		void setMainAddress(const retdec::common::Address& a);
 		void setSectionVMA(const retdec::common::Address& a);
@@ -71,6 +76,7 @@ class Parameters
 		void setBackendEnabledOpts(const std::string& o);
 		void setBackendCallInfoObtainer(const std::string& val);
 		void setBackendVarRenamer(const std::string& val);
+		void setBackendJobs(uint64_t jobs);
 		void setIsDetectStaticCode(bool b);
 		void setIsBackendNoOpts(bool b);
 		void setIsBackendEmitCfg(bool b);
@@ -86,6 +92,10 @@ class Parameters
 		/// @name Parameters get methods.
 		/// @{
 		const std::string& getOrdinalNumbersDirectory() const;
+		const std::string& getYaraCacheDirectory() const;
+		const std::string& getProfilePassesFile() const;
+		const std::string& getBin2llvmirCacheDirectory() const;
+		uint64_t getBin2llvmirCacheMaxSize() const;
 		const std::string& getInputFile() const;
 		const std::string& getInputPdbFile() const;
 		const std::string& getOutputFile() const;
@@ -99,6 +109,7 @@ class Parameters
 		const std::string& getErrFile() const;
 		uint64_t getMaxMemoryLimit() const;
 		uint64_t getTimeout() const;
+		uint64_t getAnalysisJobs() const;
 		retdec::common::Address getEntryPoint() const;
 		retdec::common::Address getMainAddress() const;
 		retdec::common::Address getSectionVMA() const;
@@ -106,6 +117,7 @@ class Parameters
 		const std::string& getBackendEnabledOpts() const;
 		const std::string& getBackendCallInfoObtainer() const;
 		const std::string& getBackendVarRenamer() const;
+		uint64_t getBackendJobs() const;
 		/// @}
 
 		void fixRelativePaths(const std::string& configPath);
@@ -151,6 +163,17 @@ class Parameters
 		bool _selectedDecodeOnly = false;
 
 		std::string _ordinalNumbersDirectory;
+		/// Directory for compiled YARA rules shared between runs.
+		/// Compiled rules are cached only in memory if empty.
+		std::string _yaraCacheDirectory;
+		/// File into which per-pass profile is written.
+		/// Passes are not profiled if empty.
+		std::string _profilePassesFile;
+		/// Directory for bin2llvmir outputs shared between runs.
+		/// The outputs are not cached if empty.
+		std::string _bin2llvmirCacheDirectory;
+		/// Maximal size of the bin2llvmir cache (in bytes), 0 means unlimited.
+		uint64_t _bin2llvmirCacheMaxSize = 1024 * 1024 * 1024;
 		std::string _inputFile;
 		std::string _inputPdbFile;
 		std::string _outputFile;
@@ -165,12 +188,16 @@ class Parameters
 		uint64_t _maxMemoryLimit = 0;
 		bool _maxMemoryLimitHalfRam = true;
 		uint64_t _timeout = 0;
+		/// Number of threads used to analyze functions in bin2llvmir.
+		uint64_t _analysisJobs = 1;
 
 		bool _detectStaticCode = true;
 		std::string _backendDisabledOpts;
 		std::string _backendEnabledOpts;
 		std::string _backendCallInfoObtainer = "optim";
 		std::string _backendVarRenamer = "readable";
+		/// Number of threads used to optimize functions in the backend.
+		uint64_t _backendJobs = 1;
 		bool _backendNoOpts = false;
 		bool _backendEmitCfg = false;
 		bool _backendEmitCg = false;
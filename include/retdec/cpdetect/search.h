@@ -7,7 +7,11 @@
 #ifndef RETDEC_CPDETECT_SEARCH_H
 #define RETDEC_CPDETECT_SEARCH_H
 
+#include <map>
+#include <memory>
+
 #include "retdec/cpdetect/cptypes.h"
+#include "retdec/cpdetect/signature_matcher.h"
 #include "retdec/fileformat/file_format/file_format.h"
 
 namespace retdec {
@@ -41,8 +45,10 @@ class Search
 		};
 	private:
 		retdec::fileformat::FileFormat &parser;
-		/// content of file in hexadecimal string representation
-		std::string nibbles;
+		/// content of file in little endian
+		llvm::ArrayRef<unsigned char> bytes;
+		/// copy of content of file with swapped bytes if file is in big endian
+		std::vector<unsigned char> swappedBytes;
 		/// content of file as plain string
 		std::string plain;
 		/// representation of supported relative jumps
@@ -54,12 +60,19 @@ class Search
 		/// @c true if search of patterns is supported for input file,
 		/// @c false otherwise
 		bool fileSupported;
+		/// matchers of single patterns compiled so far
+		mutable std::map<std::string, std::unique_ptr<SignatureMatcher>> matchers;
 
 		/// @name Auxiliary methods
 		/// @{
-		bool haveSlashes() const;
 		std::size_t nibblesFromBytes(std::size_t nBytes) const;
 		std::size_t bytesFromNibbles(std::size_t nNibbles) const;
+		std::size_t getNumberOfNibbles() const;
+		const SignatureMatcher& getMatcher(const std::string &signPattern) const;
+		char getNibble(std::size_t nibbleIndex) const;
+		bool hasNibblesOnPosition(
+				const std::string &hexNibbles,
+				std::size_t nibbleIndex) const;
 		/// @}
 	public:
 		Search(retdec::fileformat::FileFormat &fileParser);
@@ -72,12 +85,13 @@ class Search
 
 		/// @name Getters
 		/// @{
-		const std::string& getNibbles() const;
+		llvm::ArrayRef<unsigned char> getBytes() const;
 		const std::string& getPlainString() const;
 		/// @}
 
 		/// @name Jump methods
 		/// @{
+		bool haveSlashes() const;
 		const RelativeJump* getRelativeJump(
 				std::size_t fileOffset,
 				std::size_t shift,
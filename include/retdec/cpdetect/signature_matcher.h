@@ -0,0 +1,125 @@
+/**
+ * @file include/retdec/cpdetect/signature_matcher.h
+ * @brief Matcher of several signature patterns in one pass over file.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_CPDETECT_SIGNATURE_MATCHER_H
+#define RETDEC_CPDETECT_SIGNATURE_MATCHER_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace retdec {
+namespace cpdetect {
+
+class Search;
+
+/**
+ * Set of signature patterns compiled for search in raw bytes of file
+ *
+ * Patterns are compiled into sequences of masked bytes separated by relative
+ * jumps (slashes). The longest run of fixed bytes before the first jump of
+ * each pattern is inserted into an Aho-Corasick automaton, so all patterns
+ * are searched in one pass over the file. Each candidate found by the
+ * automaton is then verified against the whole pattern. Patterns without
+ * fixed bytes before the first jump are verified on each position.
+ *
+ * Like the nibble-wise search, patterns may start on the high or on the low
+ * nibble of a byte. Each pattern is therefore compiled twice: as it is, and
+ * shifted by one nibble (with a wildcard in front of it). Patterns whose
+ * slashes fall in the middle of a byte cannot be compiled and are compared
+ * nibble by nibble on each position of their areas instead.
+ */
+class SignatureMatcher
+{
+	public:
+		/**
+		 * Area of file in which one pattern is searched
+		 */
+		struct Area
+		{
+			std::size_t startOffset = 0; ///< start offset in file (in bytes)
+			std::size_t stopOffset = 0;  ///< stop offset in file (in bytes)
+		};
+	private:
+		/**
+		 * Byte of pattern with mask of significant bits
+		 */
+		struct MaskedByte
+		{
+			std::uint8_t value = 0;
+			std::uint8_t mask = 0;
+		};
+
+		/**
+		 * Compiled signature pattern
+		 */
+		struct CompiledPattern
+		{
+			/// original pattern
+			std::string pattern;
+			/// index of original pattern
+			std::size_t index = 0;
+			/// number of nibbles by which pattern is shifted (0 or 1)
+			std::size_t shift = 0;
+			/// length of shifted pattern in nibbles without terminating
+			/// semicolon
+			std::size_t nibbleLength = 0;
+			/// parts of pattern separated by slashes
+			std::vector<std::vector<MaskedByte>> parts;
+			/// offset of anchor (run of fixed bytes) in the first part
+			std::size_t anchorOffset = 0;
+			/// length of anchor in bytes (zero if pattern has no anchor)
+			std::size_t anchorLength = 0;
+			/// @c true if pattern can be matched on byte boundaries
+			bool compiled = false;
+		};
+
+		/**
+		 * State of Aho-Corasick automaton
+		 */
+		struct State
+		{
+			/// transitions of automaton (including failure transitions)
+			std::array<std::uint32_t, 256> next;
+			/// indexes of patterns whose anchor ends in this state
+			std::vector<std::size_t> outputs;
+		};
+
+		std::size_t numberOfPatterns = 0;      ///< number of original patterns
+		std::vector<CompiledPattern> patterns; ///< compiled patterns
+		std::vector<State> states;             ///< states of automaton
+
+		/// @name Auxiliary methods
+		/// @{
+		static bool compilePattern(CompiledPattern &compiledPattern);
+		void buildAutomaton();
+		bool matchesAt(
+				const Search &search,
+				const CompiledPattern &compiledPattern,
+				std::size_t offset) const;
+		/// @}
+	public:
+		SignatureMatcher(const std::vector<std::string> &signPatterns);
+
+		/// @name Getters
+		/// @{
+		std::size_t getNumberOfPatterns() const;
+		/// @}
+
+		/// @name Search methods
+		/// @{
+		void findPatterns(
+				const Search &search,
+				const std::vector<Area> &areas,
+				std::vector<unsigned long long> &result) const;
+		/// @}
+};
+
+} // namespace cpdetect
+} // namespace retdec
+
+#endif
@@ -0,0 +1,101 @@
+/**
+* @file include/retdec/ctypesparser/binary_ctypes_format.h
+* @brief Layout of binary C-types files.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_CTYPESPARSER_BINARY_CTYPES_FORMAT_H
+#define RETDEC_CTYPESPARSER_BINARY_CTYPES_FORMAT_H
+
+#include <cstdint>
+
+namespace retdec {
+namespace ctypesparser {
+namespace binary_ctypes {
+
+/*
+* A binary C-types file is a JSON C-types file compiled by
+* @c BinaryCTypesWriter. All numbers are 32-bit little-endian words and all
+* offsets are byte offsets from the beginning of the file.
+*
+* The file starts with a header of @c HeaderWord::Count words. It is followed
+* by these tables (in this order):
+*  - strings: each string is its length (one word) followed by its bytes
+*    padded to a multiple of four bytes,
+*  - functions: pairs (name offset, record offset) sorted by name,
+*  - named types: pairs (name offset, type index) sorted by name,
+*  - types: record offset of each type, indexed by type index,
+*  - records of functions and types.
+*
+* Function record:
+*   name, declaration, header, call convention (or @c NO_STRING), return
+*   type, var-argness, parameter count, (name, type, annotations) for each
+*   parameter.
+*
+* Type record starts with its @c TypeKind followed by:
+*  - @c Void, @c Unknown: nothing,
+*  - @c Integral, @c FloatingPoint: name, bit width (or @c NO_BIT_WIDTH),
+*  - @c Typedef: name, aliased type (or @c NO_TYPE for unknown type),
+*  - @c Struct, @c Union: name, member count, (name, type) for each member,
+*  - @c Pointer: pointed type,
+*  - @c Array: element type, dimension count, dimensions,
+*  - @c Enum: name, item count, (name, low word, high word) for each item,
+*  - @c Function: return type, call convention (or @c NO_STRING),
+*    var-argness, parameter count, parameter types.
+*
+* Names, types and bit widths are stored as they are in JSON. Bit widths that
+* are not in JSON are computed when the file is loaded, so one file can be used
+* for all architectures.
+*/
+
+/// Magic bytes at the beginning of the file ("RLTI").
+constexpr std::uint32_t MAGIC = 0x49544c52;
+/// Version of the layout.
+constexpr std::uint32_t VERSION = 1;
+
+/// Missing string.
+constexpr std::uint32_t NO_STRING = 0xffffffff;
+/// Missing type.
+constexpr std::uint32_t NO_TYPE = 0xffffffff;
+/// Bit width which is not stored in the file.
+constexpr std::uint32_t NO_BIT_WIDTH = 0xffffffff;
+
+/**
+* @brief Words of the header.
+*/
+enum HeaderWord: std::uint32_t
+{
+	Magic = 0,
+	Version,
+	FunctionsOffset,
+	FunctionsCount,
+	NamedTypesOffset,
+	NamedTypesCount,
+	TypesOffset,
+	TypesCount,
+	Count
+};
+
+/**
+* @brief Kinds of type records.
+*/
+enum class TypeKind: std::uint32_t
+{
+	Void = 0,
+	Unknown,
+	Integral,
+	FloatingPoint,
+	Typedef,
+	Struct,
+	Union,
+	Pointer,
+	Array,
+	Enum,
+	Function
+};
+
+} // namespace binary_ctypes
+} // namespace ctypesparser
+} // namespace retdec
+
+#endif
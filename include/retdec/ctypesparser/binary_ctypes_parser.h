@@ -0,0 +1,127 @@
+/**
+* @file include/retdec/ctypesparser/binary_ctypes_parser.h
+* @brief Lazy parser for C-types from binary files.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_CTYPESPARSER_BINARY_CTYPES_PARSER_H
+#define RETDEC_CTYPESPARSER_BINARY_CTYPES_PARSER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "retdec/ctypesparser/ctypes_parser.h"
+
+namespace retdec {
+
+namespace utils {
+class MemoryMappedFile;
+} // namespace utils
+
+namespace ctypesparser {
+
+/**
+* @brief Parser for C-types compiled by @c BinaryCTypesWriter.
+*
+* Unlike @c JSONCTypesParser, this parser does not parse the whole input at
+* once. The input is only checked when it is opened, and functions (together
+* with their types) are parsed into the module when they are requested by
+* getFunction(). Files are memory-mapped, so only the parts of the input that
+* are really used are read.
+*
+* When more files are loaded into one module, named types from previously
+* loaded files take precedence, like when the files are parsed by
+* @c JSONCTypesParser in the same order. See setPreviousParsers().
+*/
+class BinaryCTypesParser: public CTypesParser
+{
+	public:
+		BinaryCTypesParser();
+		BinaryCTypesParser(unsigned defaultBitWidth);
+		~BinaryCTypesParser() override;
+
+		void openInto(
+			const std::string &path,
+			std::unique_ptr<retdec::ctypes::Module> &module,
+			const TypeWidths &typeWidths = {},
+			const retdec::ctypes::CallConvention &callConvention = retdec::ctypes::CallConvention());
+		void openInto(
+			const std::uint8_t *data,
+			std::size_t size,
+			std::unique_ptr<retdec::ctypes::Module> &module,
+			const TypeWidths &typeWidths = {},
+			const retdec::ctypes::CallConvention &callConvention = retdec::ctypes::CallConvention());
+		void setPreviousParsers(const std::vector<BinaryCTypesParser*> &parsers);
+
+		std::size_t getFunctionCount() const;
+		bool hasFunction(const std::string &name) const;
+		std::shared_ptr<retdec::ctypes::Function> getFunction(const std::string &name);
+		std::shared_ptr<retdec::ctypes::Type> getNamedType(const std::string &name);
+
+	private:
+		/// @name Reading of the input.
+		/// @{
+		std::uint32_t readWord(std::size_t offset) const;
+		std::string readString(std::uint32_t offset) const;
+		std::string_view readStringView(std::uint32_t offset) const;
+		std::size_t findInIndex(
+			std::uint32_t indexOffset,
+			std::uint32_t count,
+			const std::string &name
+		) const;
+		/// @}
+
+		/// @name Parsing methods.
+		/// @{
+		std::shared_ptr<retdec::ctypes::Function> parseFunction(
+			const std::string &name,
+			std::uint32_t offset
+		);
+		std::shared_ptr<retdec::ctypes::Type> getOrParseType(std::uint32_t index);
+		std::shared_ptr<retdec::ctypes::Type> parseType(std::uint32_t index);
+		std::shared_ptr<retdec::ctypes::Type> getPreviousNamedType(
+			std::uint32_t offset
+		);
+		std::shared_ptr<retdec::ctypes::Type> parseComposite(
+			std::uint32_t index,
+			std::uint32_t offset,
+			bool isStruct
+		);
+		std::shared_ptr<retdec::ctypes::Type> parseFunctionType(std::uint32_t offset);
+		retdec::ctypes::CallConvention parseCallConv(std::uint32_t stringOffset) const;
+		/// @}
+
+	private:
+		/// Mapped input file, if the input was opened from file.
+		std::unique_ptr<retdec::utils::MemoryMappedFile> file;
+		/// Content of the input.
+		const std::uint8_t *data = nullptr;
+		/// Size of the input.
+		std::size_t size = 0;
+		/// Module into which functions are parsed.
+		retdec::ctypes::Module *module = nullptr;
+
+		std::uint32_t functionsOffset = 0;
+		std::uint32_t functionsCount = 0;
+		std::uint32_t namedTypesOffset = 0;
+		std::uint32_t namedTypesCount = 0;
+		std::uint32_t typesOffset = 0;
+		std::uint32_t typesCount = 0;
+
+		/// Already parsed types by their indexes.
+		std::vector<std::shared_ptr<retdec::ctypes::Type>> parsedTypes;
+
+		/// Parsers of files loaded into the module before this one.
+		std::vector<BinaryCTypesParser*> previousParsers;
+
+		/// Call convention used when the input does not contain one.
+		retdec::ctypes::CallConvention defaultCallConv;
+};
+
+} // namespace ctypesparser
+} // namespace retdec
+
+#endif
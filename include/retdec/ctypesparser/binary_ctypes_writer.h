@@ -0,0 +1,152 @@
+/**
+* @file include/retdec/ctypesparser/binary_ctypes_writer.h
+* @brief Compiler of JSON C-types files into binary C-types files.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_CTYPESPARSER_BINARY_CTYPES_WRITER_H
+#define RETDEC_CTYPESPARSER_BINARY_CTYPES_WRITER_H
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <rapidjson/document.h>
+
+#include "retdec/ctypesparser/exceptions.h"
+
+namespace retdec {
+namespace ctypesparser {
+
+/**
+* @brief Compiles C-types represented in JSON into binary C-types files.
+*
+* Only functions and the types reachable from them are stored. Types are
+* resolved in the same order as in @c JSONCTypesParser, so the same types are
+* shared by the same functions when the file is loaded by
+* @c BinaryCTypesParser.
+*
+* See binary_ctypes_format.h for the layout of the output.
+*/
+class BinaryCTypesWriter
+{
+	public:
+		void write(std::istream &json, std::ostream &out);
+
+	private:
+		/// Type resolved from JSON.
+		struct TypeNode
+		{
+			std::uint32_t kind = 0;
+			std::string name;
+			std::uint32_t bitWidth = 0;
+			std::uint32_t type = 0;
+			std::string callConv;
+			bool hasCallConv = false;
+			bool varArg = false;
+			std::vector<std::uint32_t> words;
+			std::vector<std::pair<std::string, std::uint32_t>> members;
+			std::vector<std::pair<std::string, std::int64_t>> items;
+		};
+
+		/// Parameter of function resolved from JSON.
+		struct ParameterNode
+		{
+			std::string name;
+			std::uint32_t type = 0;
+			std::string annotations;
+		};
+
+		/// Function resolved from JSON.
+		struct FunctionNode
+		{
+			std::string name;
+			std::string declaration;
+			std::string header;
+			std::string callConv;
+			bool hasCallConv = false;
+			std::uint32_t returnType = 0;
+			bool varArg = false;
+			std::vector<ParameterNode> parameters;
+		};
+
+	private:
+		void clear();
+
+		/// @name Resolution of JSON.
+		/// @{
+		void addFunction(const std::string &name, const rapidjson::Value &jsonFunction);
+		std::uint32_t getOrAddType(const std::string &typeKey);
+		std::uint32_t addType(const std::string &typeKey);
+		std::uint32_t addNode(TypeNode node);
+		std::uint32_t getOrAddNamedType(
+			const rapidjson::Value &jsonType,
+			std::uint32_t kind
+		);
+		std::uint32_t addTypedef(
+			const rapidjson::Value &jsonTypedef,
+			const std::string &typeName
+		);
+		std::uint32_t addComposite(
+			const rapidjson::Value &jsonComposite,
+			const std::string &typeName,
+			std::uint32_t kind
+		);
+		std::uint32_t addFunctionType(const rapidjson::Value &jsonFuncType);
+		std::uint32_t addArray(const rapidjson::Value &jsonArray);
+		std::uint32_t addEnum(
+			const rapidjson::Value &jsonEnum,
+			const std::string &typeName
+		);
+		/// @}
+
+		/// @name Output.
+		/// @{
+		void emitWord(std::vector<std::uint8_t> &out, std::uint32_t word) const;
+		void patchWord(
+			std::vector<std::uint8_t> &out,
+			std::size_t offset,
+			std::uint32_t word
+		) const;
+		std::uint32_t emitString(std::vector<std::uint8_t> &out, const std::string &str);
+		void emitOptionalString(
+			std::vector<std::uint8_t> &out,
+			const std::string &str,
+			bool present
+		);
+		std::uint32_t emitFunction(
+			std::vector<std::uint8_t> &out,
+			const FunctionNode &function
+		);
+		std::uint32_t emitType(std::vector<std::uint8_t> &out, const TypeNode &type);
+		/// @}
+
+	private:
+		/// JSON types by their keys.
+		std::unordered_map<std::string, rapidjson::Value::ConstMemberIterator> typesMap;
+		/// Indexes of already resolved types by their keys.
+		std::unordered_map<std::string, std::uint32_t> keysToTypes;
+		/// Indexes of named types by their names.
+		std::unordered_map<std::string, std::uint32_t> namedTypes;
+		/// Names of typedefs which are being resolved.
+		std::vector<std::string> previousTypedefs;
+		/// Index of void type.
+		std::uint32_t voidType = 0;
+		/// Index of unknown type.
+		std::uint32_t unknownType = 0;
+
+		/// Resolved types.
+		std::vector<TypeNode> types;
+		/// Resolved functions sorted by their names.
+		std::map<std::string, FunctionNode> functions;
+		/// Offsets of already emitted strings.
+		std::unordered_map<std::string, std::uint32_t> strings;
+};
+
+} // namespace ctypesparser
+} // namespace retdec
+
+#endif
@@ -36,6 +36,15 @@ class CTypesParser
 		CTypesParser();
 		CTypesParser(unsigned defaultBitWidth);
 
+		/// @name Parsing helpers shared by all parsers.
+		/// @{
+		retdec::ctypes::Parameter::Annotations parseAnnotations(
+			const std::string &annot
+		) const;
+		unsigned getIntegralTypeBitWidth(const std::string &type) const;
+		unsigned getBitWidthOrDefault(const std::string &typeName) const;
+		/// @}
+
 	protected:
 		/// Container for already parsed functions, types.
 		std::shared_ptr<retdec::ctypes::Context> context;
@@ -68,9 +68,6 @@ class JSONCTypesParser: public CTypesParser
 		std::string parseCallConv(
 			const rapidjson::Value &function
 		) const;
-		retdec::ctypes::Parameter::Annotations parseAnnotations(
-			const std::string &annot
-		) const;
 		std::shared_ptr<retdec::ctypes::FunctionType> parseFunctionType(
 			const rapidjson::Value &jsonFuncType
 		);
@@ -122,8 +119,6 @@ class JSONCTypesParser: public CTypesParser
 				std::shared_ptr<retdec::ctypes::Type> (const std::string &typeName)
 			> &parseType
 		);
-		unsigned getIntegralTypeBitWidth(const std::string &type) const;
-		unsigned getBitWidthOrDefault(const std::string &typeName) const;
 		/// @}
 
 	private:
@@ -7,6 +7,9 @@
 #ifndef RETDEC_DEBUGFORMAT_DEBUGFORMAT_H
 #define RETDEC_DEBUGFORMAT_DEBUGFORMAT_H
 
+#include <unordered_map>
+#include <vector>
+
 #include <llvm/DebugInfo/DIContext.h>
 #include <llvm/DebugInfo/DWARF/DWARFContext.h>
 #include <llvm/Object/ObjectFile.h>
@@ -22,6 +25,7 @@
 #include "retdec/demangler/demangler.h"
 #include "retdec/fileformat/fileformat.h"
 #include "retdec/loader/loader.h"
+#include "retdec/utils/thread_pool.h"
 
 namespace retdec {
 namespace debugformat {
@@ -40,7 +44,8 @@ class DebugFormat
 				retdec::loader::Image* inFile,
 				const std::string& pdbFile,
 				SymbolTable* symtab,
-				retdec::demangler::Demangler* demangler
+				retdec::demangler::Demangler* demangler,
+				retdec::utils::ThreadPool* pool = nullptr
 		);
 
 		retdec::common::Function* getFunction(retdec::common::Address a);
@@ -55,15 +60,38 @@ class DebugFormat
 		void loadPdbFunctions();
 		retdec::common::Type loadPdbType(retdec::pdbparser::PDBTypeDef* type);
 
-		void loadDwarf();
-		void loadDwarf_CU(llvm::DWARFDie die);
-		retdec::common::Function loadDwarf_subprogram(llvm::DWARFDie die);
-		std::string loadDwarf_type(llvm::DWARFDie die);
-		std::string _loadDwarf_type(llvm::DWARFDie die);
+		/// Debug information loaded from one DWARF compile unit.
+		struct DwarfUnitInfo
+		{
+			/// Line table of the unit, or @c nullptr if there is none.
+			const llvm::DWARFDebugLine::LineTable* lines = nullptr;
+			/// Functions in the order of their DIEs.
+			std::vector<retdec::common::Function> functions;
+			/// Global variables in the order of their DIEs.
+			std::vector<retdec::common::Object> globals;
+			/// Named types in the order in which they were loaded.
+			std::vector<std::string> types;
+			/// Type cache: DIE offset -> type.
+			std::unordered_map<uint64_t, std::string> dieOff2type;
+		};
+
+		void loadDwarf(retdec::utils::ThreadPool* pool);
+		void loadDwarf_CU(DwarfUnitInfo& info, llvm::DWARFDie die) const;
+		retdec::common::Function loadDwarf_subprogram(
+				DwarfUnitInfo& info,
+				llvm::DWARFDie die) const;
+		std::string loadDwarf_type(DwarfUnitInfo& info, llvm::DWARFDie die) const;
+		std::string _loadDwarf_type(DwarfUnitInfo& info, llvm::DWARFDie die) const;
 		retdec::common::Object loadDwarf_formal_parameter(
+				DwarfUnitInfo& info,
 				llvm::DWARFDie die,
-				unsigned argCntr);
-		retdec::common::Object loadDwarf_variable(llvm::DWARFDie die);
+				unsigned argCntr) const;
+		retdec::common::Object loadDwarf_variable(
+				DwarfUnitInfo& info,
+				llvm::DWARFDie die) const;
+		void mergeDwarfUnit(
+				DwarfUnitInfo& info,
+				const std::unordered_map<uint64_t, const retdec::fileformat::Symbol*>& symbols);
 
 		void loadSymtab();
 
@@ -79,9 +107,6 @@ class DebugFormat
 		/// Demangler.
 		retdec::demangler::Demangler* _demangler = nullptr;
 
-		/// Dwarf named types cache.
-		std::map<std::pair<llvm::DWARFUnit*, uint32_t>, std::string> dieOff2type;
-
 	public:
 		retdec::common::GlobalVarContainer globals;
 		retdec::common::TypeContainer types;
@@ -7,15 +7,22 @@
 #ifndef RETDEC_FILEFORMAT_FILE_FORMAT_FILE_FORMAT_H
 #define RETDEC_FILEFORMAT_FILE_FORMAT_FILE_FORMAT_H
 
+#include <atomic>
 #include <fstream>
 #include <initializer_list>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <set>
+#include <shared_mutex>
 #include <utility>
 #include <vector>
 
+#include <llvm/ADT/ArrayRef.h>
+
 #include "retdec/utils/byte_value_storage.h"
+#include "retdec/utils/memory_mapped_file.h"
 #include "retdec/utils/non_copyable.h"
 #include "retdec/fileformat/fftypes.h"
 #include "retdec/fileformat/utils/byte_array_buffer.h"
@@ -41,15 +48,27 @@ struct LoaderErrorInfo
 class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils::NonCopyable
 {
 	private:
-		byte_array_buffer auxBuff;               ///< auxiliary input buffer
-		std::ifstream auxFStream;                ///< auxiliary input file stream
-		std::istream auxIStream;                 ///< auxiliary input stream
-		std::vector<unsigned char> *loadedBytes; ///< reference to serialized content of input file
-		LoadFlags loadFlags;                     ///< load flags for configurable file loading
+		std::unique_ptr<retdec::utils::MemoryMappedFile> mappedFile; ///< input file mapped into memory
+		std::vector<unsigned char> streamBytes;        ///< content of input file read from stream or copied from memory
+		byte_array_buffer auxBuff;                     ///< auxiliary input buffer
+		std::ifstream auxFStream;                      ///< auxiliary input file stream
+		std::istream auxIStream;                       ///< auxiliary input stream
+		llvm::ArrayRef<unsigned char> loadedBytes;     ///< serialized content of input file
+		LoadFlags loadFlags;                           ///< load flags for configurable file loading
+		mutable std::once_flag fileHashesComputed;     ///< file hashes are computed lazily
+
+		struct SecSegIndex;
+		std::unique_ptr<SecSegIndex> secSegIndex;      ///< index of sections and segments by offsets and addresses
+		mutable std::shared_mutex secSegIndexMutex;    ///< guards @c secSegIndex
+		mutable std::atomic<std::uint64_t> secSegLayoutGeneration{0}; ///< number of layout changes of sections and segments
 
 		/// @name Initialization methods
 		/// @{
 		void init();
+		void initBytes();
+		void initBytes(const std::uint8_t *data, std::size_t size);
+		void computeFileHashes() const;
+		std::shared_lock<std::shared_mutex> lockSecSegIndex() const;
 		void initStream();
 		/// @}
 
@@ -58,9 +77,9 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		virtual std::size_t initSectionTableHashOffsets() = 0;
 		/// @}
 	protected:
-		std::string crc32;                                                ///< CRC32 of file content
-		std::string md5;                                                  ///< MD5 of file content
-		std::string sha256;                                               ///< SHA256 of file content
+		mutable std::string crc32;                                        ///< CRC32 of file content
+		mutable std::string md5;                                          ///< MD5 of file content
+		mutable std::string sha256;                                       ///< SHA256 of file content
 		std::string sectionCrc32;                                         ///< CRC32 of section table
 		std::string sectionMd5;                                           ///< MD5 of section table
 		std::string sectionSha256;                                        ///< SHA256 of section table
@@ -71,7 +90,7 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		std::vector<SymbolTable*> symbolTables;                           ///< symbol tables
 		std::vector<RelocationTable*> relocationTables;                   ///< relocation tables
 		std::vector<DynamicTable*> dynamicTables;                         ///< tables with dynamic records
-		std::vector<unsigned char> bytes;                                 ///< content of file as bytes
+		llvm::ArrayRef<unsigned char> bytes;                              ///< content of file as bytes
 		std::vector<String> strings;                                      ///< detected strings
 		std::vector<ElfNoteSecSeg> noteSecSegs;                           ///< note sections or segemnts found in ELF file
 		std::set<std::uint64_t> unknownRelocs;                            ///< unknown relocations
@@ -105,6 +124,7 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		/// @name Setters
 		/// @{
 		void setLoadedBytes(std::vector<unsigned char> *lBytes);
+		void appendBytes(const unsigned char *data, std::size_t size);
 		/// @}
 
 	public:
@@ -122,13 +142,13 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 				retdec::common::Address entryPoint = retdec::common::Address::Undefined,
 				retdec::common::Address sectionVMA = retdec::common::Address::Undefined);
 		void loadStrings();
-		void loadStrings(StringType type, std::size_t charSize);
-		void loadStrings(StringType type, std::size_t charSize, const SecSeg* secSeg);
+		void loadStrings(const SecSeg* secSeg);
 		void loadImpHash();
 		void loadExpHash();
 		void loadResourceIconHash();
 		bool isInValidState() const;
 		LoadFlags getLoadFlags() const;
+		void invalidateSecSegIndex() const;
 		/// @}
 
 		/// @name Auxiliary offset detection methods
@@ -259,8 +279,8 @@ class FileFormat : public retdec::utils::ByteValueStorage, private retdec::utils
 		const std::vector<SymbolTable*>& getSymbolTables() const;
 		const std::vector<RelocationTable*>& getRelocationTables() const;
 		const std::vector<DynamicTable*>& getDynamicTables() const;
-		const std::vector<unsigned char>& getBytes() const;
-		const std::vector<unsigned char>& getLoadedBytes() const;
+		llvm::ArrayRef<unsigned char> getBytes() const;
+		llvm::ArrayRef<unsigned char> getLoadedBytes() const;
 		const unsigned char* getBytesData() const;
 		const unsigned char* getLoadedBytesData() const;
 		const std::vector<String>& getStrings() const;
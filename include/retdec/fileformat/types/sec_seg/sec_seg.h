@@ -54,7 +54,25 @@ class SecSeg
 		bool loaded = false;                  ///< @c true if content of section or segment was successfully loaded from input file
 		bool isEntropyValid = false;          ///< @c true if entropy has been computed
 
+		/**
+		 * File format whose index of sections and segments has to be
+		 * invalidated when the layout changes. Copies of sections and
+		 * segments do not belong to any file format.
+		 */
+		struct LayoutOwner
+		{
+			const FileFormat *format = nullptr;
+
+			LayoutOwner() = default;
+			LayoutOwner(const LayoutOwner &) {}
+			LayoutOwner &operator=(const LayoutOwner &) { return *this; }
+		};
+		LayoutOwner layoutOwner;              ///< owner notified about layout changes
+
 		void computeHashes();
+		void layoutChanged();
+
+		friend class FileFormat;
 	public:
 		virtual ~SecSeg() = default;
 
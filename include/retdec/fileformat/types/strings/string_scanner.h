@@ -0,0 +1,68 @@
+/**
+ * @file include/retdec/fileformat/types/strings/string_scanner.h
+ * @brief Class for finding strings in raw bytes.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef RETDEC_FILEFORMAT_TYPES_STRINGS_STRING_SCANNER_H
+#define RETDEC_FILEFORMAT_TYPES_STRINGS_STRING_SCANNER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "retdec/fileformat/types/strings/character_iterator.h"
+#include "retdec/fileformat/types/strings/string.h"
+
+namespace retdec {
+namespace fileformat {
+
+/**
+ * Finds ASCII and wide (UTF-16) strings of printable characters in raw bytes.
+ *
+ * Bytes are classified as printable or zero by SIMD instructions (AVX2 or
+ * SSE2, selected at runtime, with a scalar fallback), 64 bytes at a time, and
+ * runs of both string types are then found in the resulting bit masks in a
+ * single pass over the data.
+ *
+ * A character is printable if it is in the range 0x20-0x7e. An ASCII string is
+ * a maximal run of printable bytes. A wide string is a maximal run of 2-byte
+ * characters whose one byte is printable and the other one is zero (their
+ * order is given by the endianness). Wide strings may start at any offset.
+ */
+class StringScanner
+{
+	public:
+		/// Implementation of the classification of bytes.
+		enum class Implementation
+		{
+			Scalar,
+			Sse2,
+			Avx2
+		};
+	private:
+		std::size_t minLength;                  ///< minimal length of strings (in characters)
+		CharacterEndianness endian;             ///< endianness of wide characters
+		Implementation implementation;          ///< used implementation
+	public:
+		StringScanner(std::size_t minLength, CharacterEndianness endian);
+		StringScanner(std::size_t minLength, CharacterEndianness endian, Implementation implementation);
+
+		Implementation getImplementation() const;
+
+		void scan(
+				const std::uint8_t* data,
+				std::size_t size,
+				std::uint64_t fileOffset,
+				const std::string& sectionName,
+				std::vector<String>& strings) const;
+
+		static Implementation getBestImplementation();
+		static bool isSupported(Implementation implementation);
+};
+
+} // namespace fileformat
+} // namespace retdec
+
+#endif
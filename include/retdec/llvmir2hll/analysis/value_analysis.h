@@ -229,6 +229,8 @@ public:
 	bool mayBePointed(ShPtr<Variable> var) const;
 	/// @}
 
+	ShPtr<ValueAnalysis> clone() const;
+
 	static ShPtr<ValueAnalysis> create(ShPtr<AliasAnalysis> aliasAnalysis,
 		bool enableCaching = false);
 
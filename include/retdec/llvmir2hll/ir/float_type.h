@@ -8,6 +8,7 @@
 #define RETDEC_LLVMIR2HLL_IR_FLOAT_TYPE_H
 
 #include <map>
+#include <mutex>
 
 #include "retdec/llvmir2hll/ir/type.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
@@ -53,6 +54,9 @@ private:
 	/// Set of already created float point types of the given size.
 	static SizeToFloatTypeMap createdTypes;
 
+	/// Guards the set of already created types.
+	static std::mutex createdTypesMutex;
+
 private:
 	// Since instances are created by calling the static function create(), the
 	// constructor can be private.
@@ -7,7 +7,9 @@
 #ifndef RETDEC_LLVMIR2HLL_IR_VALUE_H
 #define RETDEC_LLVMIR2HLL_IR_VALUE_H
 
+#include <cstddef>
 #include <iosfwd>
+#include <memory>
 #include <string>
 
 #include <llvm/Support/raw_ostream.h>
@@ -18,6 +20,7 @@
 #include "retdec/llvmir2hll/support/subject.h"
 #include "retdec/llvmir2hll/support/visitable.h"
 #include "retdec/utils/non_copyable.h"
+#include "retdec/utils/small_block_pool.h"
 
 namespace retdec {
 namespace llvmir2hll {
@@ -68,10 +71,35 @@ public:
 
 	std::string getTextRepr();
 
+	/// @name Memory Management
+	/// @{
+	static void *operator new(std::size_t size);
+	static void operator delete(void *ptr, std::size_t size) noexcept;
+	/// @}
+
 protected:
 	Value() = default;
 };
 
+/**
+* @brief Returns a shared pointer owning the given newly created @a value.
+*
+* Values are allocated from utils::SmallBlockPool. This function allocates the
+* control block of the pointer from the pool as well, so create() functions of
+* values should use it instead of constructing ShPtr directly.
+*
+* The pool is shared by all modules rather than owned by a module because
+* types are cached globally and values may outlive their module. Blocks of a
+* destroyed module are reused by the next one.
+*
+* @tparam T Type of the value.
+*/
+template<typename T>
+ShPtr<T> makeValuePtr(T *value) {
+	return ShPtr<T>(value, std::default_delete<T>(),
+		retdec::utils::SmallBlockAllocator<T>());
+}
+
 /// @name Emission To Streams
 /// @{
 
@@ -76,6 +76,7 @@
 #include "retdec/utils/container.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/pass_profiler.h"
 #include "retdec/utils/string.h"
 
 #ifndef RETDEC_LLVMIR2HLL_LLVMIR2HLL_H
@@ -110,6 +111,7 @@ public:
 
 	void setConfig(retdec::config::Config* c);
 	void setOutputString(std::string* outString);
+	void setPassProfiler(retdec::utils::PassProfiler* profiler);
 
 private:
 	bool initialize(llvm::Module &m);
@@ -180,6 +182,9 @@ private:
 
 	/// Output string stream.
 	std::unique_ptr<llvm::raw_string_ostream> outStringStream;
+
+	/// Profiler of the backend (if it is profiled).
+	retdec::utils::PassProfiler* passProfiler = nullptr;
 };
 
 } // namespace llvmir2hll
@@ -25,6 +25,8 @@ class Module;
 *    Optimizer (if necessary; by default, they do nothing)
 *  - override the runOnFunction() function (if necessary; by default, it just
 *    calls @c func->accept(this))
+*  - override the doModuleOptimization() function if a part of the
+*    optimization is not local to a function (by default, it does nothing)
 *  - override the needed functions from OrderedAllVisitor (remember that
 *    non-overridden functions have to brought to scope using the <tt>using
 *    OrderedAllVisitor::visit;</tt> declaration; otherwise, they'll be hidden
@@ -42,6 +44,10 @@ class Module;
 * Instances of this class have reference object semantics.
 */
 class FuncOptimizer: public Optimizer {
+public:
+	virtual void doModuleOptimization();
+	void optimizeFunction(ShPtr<Function> func);
+
 protected:
 	FuncOptimizer(ShPtr<Module> module);
 
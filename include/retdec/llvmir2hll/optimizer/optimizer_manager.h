@@ -7,10 +7,15 @@
 #ifndef RETDEC_LLVMIR2HLL_OPTIMIZER_OPTIMIZER_MANAGER_H
 #define RETDEC_LLVMIR2HLL_OPTIMIZER_OPTIMIZER_MANAGER_H
 
+#include <functional>
+#include <string>
+
 #include "retdec/llvmir2hll/optimizer/optimizer.h"
 #include "retdec/llvmir2hll/support/smart_ptr.h"
 #include "retdec/llvmir2hll/support/types.h"
 #include "retdec/utils/non_copyable.h"
+#include "retdec/utils/pass_profiler.h"
+#include "retdec/utils/thread_pool.h"
 
 namespace retdec {
 namespace llvmir2hll {
@@ -28,23 +33,39 @@ class ValueAnalysis;
 * meant to be subclassed.
 */
 class OptimizerManager final: private retdec::utils::NonCopyable {
+public:
+	/// Profiler category of the serial parts of the backend.
+	static const std::string SerialCategory;
+
+	/// Profiler category of optimizations run over functions in parallel.
+	static const std::string ParallelCategory;
+
 public:
 	OptimizerManager(const StringSet &enabledOpts, const StringSet &disabledOpts,
 		ShPtr<HLLWriter> hllWriter, ShPtr<ValueAnalysis> va,
 		ShPtr<CallInfoObtainer> cio, ShPtr<ArithmExprEvaluator> arithmExprEvaluator,
-		bool enableDebug = false);
+		bool enableDebug = false, std::size_t jobs = 1);
+
+	void setPassProfiler(retdec::utils::PassProfiler *profiler);
 
 	void optimize(ShPtr<Module> m);
 
 private:
+	static retdec::utils::PassProfiler::IrSize getIrSize(ShPtr<Module> m);
 	void printOptimization(const std::string &optName) const;
 	bool optShouldBeRun(const std::string &optName) const;
-	void runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer);
+	void runOptimizerProvidedItShouldBeRun(ShPtr<Module> m,
+		ShPtr<Optimizer> optimizer);
+	void runProvidedItShouldBeRun(const std::string &optId, ShPtr<Module> m,
+		const std::string &category, const std::function<void ()> &optimize);
 	bool shouldSecondCopyPropagationBeRun() const;
 
 	template<typename Optimization, typename... Args>
 	void run(ShPtr<Module> m, Args &&... args);
 
+	template<typename Optimization, typename... Args>
+	void runPerFunc(ShPtr<Module> m, const Args &... args);
+
 private:
 	/// No other optimization than these will be run.
 	const StringSet enabledOpts;
@@ -70,8 +91,15 @@ private:
 	/// Should we recover from out-of-memory errors during optimizations?
 	bool recoverFromOutOfMemory;
 
+	/// Profiler of the optimizations (if they are profiled).
+	retdec::utils::PassProfiler *profiler = nullptr;
+
 	/// List of our optimizations that were run.
 	StringSet backendRunOpts;
+
+	/// Pool used to optimize functions in parallel (if more than one job has
+	/// been requested).
+	UPtr<retdec::utils::ThreadPool> threadPool;
 };
 
 } // namespace llvmir2hll
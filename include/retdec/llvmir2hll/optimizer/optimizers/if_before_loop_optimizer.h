@@ -67,7 +67,8 @@ public:
 	virtual std::string getId() const override { return "IfBeforeLoop"; }
 
 private:
-	virtual void doOptimization() override;
+	virtual void doInitialization() override;
+	virtual void doFinalization() override;
 
 	bool tryOptimizationCase1(ShPtr<IfStmt> stmt);
 	bool tryOptimizationCase2(ShPtr<IfStmt> stmt);
@@ -123,8 +123,11 @@ public:
 
 	virtual std::string getId() const override { return "PreWhileTrueLoopConv"; }
 
+	virtual void doModuleOptimization() override;
+
 private:
-	virtual void doOptimization() override;
+	virtual void doInitialization() override;
+	virtual void doFinalization() override;
 
 	/// @name Visitor Interface
 	/// @{
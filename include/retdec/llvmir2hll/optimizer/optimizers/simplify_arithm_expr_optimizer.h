@@ -26,15 +26,17 @@ class ArithmExprEvaluator;
 *
 * This is a concrete optimizer which should not be subclassed.
 */
-class SimplifyArithmExprOptimizer final: public Optimizer {
+class SimplifyArithmExprOptimizer final: public FuncOptimizer {
 public:
 	SimplifyArithmExprOptimizer(ShPtr<Module> module,
 		ShPtr<ArithmExprEvaluator> arithmExprEvaluator);
 
 	virtual std::string getId() const override { return "SimplifyArithmExpr"; }
 
+	virtual void doModuleOptimization() override;
+
 private:
-	virtual void doOptimization() override;
+	virtual void runOnFunction(ShPtr<Function> func) override;
 
 	/// @name Visitor Interface
 	/// @{
@@ -51,7 +51,8 @@ public:
 	virtual std::string getId() const override { return "WhileTrueToForLoop"; }
 
 private:
-	virtual void doOptimization() override;
+	virtual void doInitialization() override;
+	virtual void doFinalization() override;
 
 	/// @name Visitor Interface
 	/// @{
@@ -8,6 +8,8 @@
 #define RETDEC_LLVMIR2HLL_SUPPORT_SUBJECT_H
 
 #include <algorithm>
+#include <cstdint>
+#include <mutex>
 #include <vector>
 
 #include "retdec/llvmir2hll/support/smart_ptr.h"
@@ -15,6 +17,19 @@
 namespace retdec {
 namespace llvmir2hll {
 
+/**
+* @brief Returns a mutex guarding the list of observers of the given subject.
+*
+* Subjects shared by several functions (e.g. global variables) may get their
+* observers modified from several threads when functions are optimized in
+* parallel. To keep subjects small, there is no mutex in every subject. Instead,
+* a fixed table of mutexes is indexed by the address of the subject.
+*/
+inline std::mutex &getObserversMutex(const void *subject) {
+	static std::mutex mutexes[64];
+	return mutexes[(reinterpret_cast<std::uintptr_t>(subject) >> 4) % 64];
+}
+
 /**
 * @brief Implementation of a generic typed observer using shared pointers
 *        (subject part).
@@ -89,6 +104,7 @@ public:
 	* @param[in] observer Observer to be added.
 	*/
 	void addObserver(ObserverPtr observer) {
+		std::lock_guard<std::mutex> lock(getObserversMutex(this));
 		observers.push_back(observer);
 	}
 
@@ -105,6 +121,7 @@ public:
 	* @brief Removes all observers.
 	*/
 	void removeObservers() {
+		std::lock_guard<std::mutex> lock(getObserversMutex(this));
 		observers.clear();
 	}
 
@@ -125,7 +142,7 @@ public:
 	void notifyObservers(ShPtr<ArgType> arg = nullptr) {
 		// We have to iterate over a copy of the container because it can be
 		// modified during the iteration (either by us or in an update() call).
-		for (const auto &observer : ObserverContainer(observers)) {
+		for (const auto &observer : getObservers()) {
 			notifyObserverOrRemoveItIfNotExists(observer, arg);
 		}
 	}
@@ -136,22 +153,16 @@ protected:
 	// observers are added to it.
 	using ObserverContainer = std::vector<ObserverPtr>;
 
-	// Observer iterator.
-	using observer_iterator = typename ObserverContainer::const_iterator;
-
 protected:
 	/**
-	* @brief Returns a constant iterator to the first observer.
-	*/
-	observer_iterator observer_begin() const {
-		return observers.begin();
-	}
-
-	/**
-	* @brief Returns a constant iterator past the last observer.
+	* @brief Returns a copy of the list of observers.
+	*
+	* The list is copied under the lock guarding the observers, so it may be
+	* iterated over while other threads add or remove observers.
 	*/
-	observer_iterator observer_end() const {
-		return observers.end();
+	ObserverContainer getObservers() const {
+		std::lock_guard<std::mutex> lock(getObserversMutex(this));
+		return observers;
 	}
 
 private:
@@ -189,11 +200,12 @@ private:
 	* @brief Removes the given observer and all the non-existing observers.
 	*/
 	void removeObserverAndNonExistingObservers(ObserverPtr observer) {
+		std::lock_guard<std::mutex> lock(getObserversMutex(this));
 		observers.erase(std::remove_if(observers.begin(), observers.end(),
 			[&observer](const auto &other) {
 				return other.expired() || observer.lock() == other.lock();
 			}
-		));
+		), observers.end());
 	}
 
 private:
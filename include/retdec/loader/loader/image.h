@@ -8,8 +8,10 @@
 #define RETDEC_LOADER_RETDEC_LOADER_IMAGE_H
 
 #include <memory>
+#include <shared_mutex>
 
 #include "retdec/utils/byte_value_storage.h"
+#include "retdec/utils/interval_index.h"
 #include "retdec/fileformat/fftypes.h"
 #include "retdec/fileformat/file_format/file_format.h"
 #include "retdec/loader/loader/segment.h"
@@ -84,16 +86,25 @@ protected:
 	void setStatusMessage(const std::string& message);
 
 private:
+	friend class Segment;
+
 	const Segment* _getSegment(std::size_t index) const;
 	const Segment* _getSegment(const std::string& name) const;
 	const Segment* _getSegmentWithIndex(std::size_t index) const;
 	const Segment* _getSegmentFromAddress(std::uint64_t address) const;
+	std::shared_lock<std::shared_mutex> _lockSegmentIndex() const;
+	void _invalidateSegmentIndex();
 
 	std::shared_ptr<retdec::fileformat::FileFormat> _fileFormat;
 	std::vector<std::unique_ptr<Segment>> _segments;
 	std::uint64_t _baseAddress;
 	NameGenerator _namelessSegNameGen;
 	std::string _statusMessage;
+
+	/// Positions of segments in @c _segments indexed by their addresses.
+	mutable retdec::utils::IntervalIndex<std::size_t> _segmentIndex;
+	mutable bool _segmentIndexValid = false;
+	mutable std::shared_mutex _segmentIndexMutex;
 };
 
 } // namespace loader
@@ -21,6 +21,8 @@
 namespace retdec {
 namespace loader {
 
+class Image;
+
 class Segment
 {
 public:
@@ -57,6 +59,12 @@ public:
 	void addNonDecodableRange(retdec::common::Range<std::uint64_t> range);
 
 private:
+	friend class Image;
+
+	void _layoutChanged();
+
+	/// Image which contains the segment and indexes it by its address.
+	Image* _image = nullptr;
 	const retdec::fileformat::SecSeg* _secSeg;
 	std::uint64_t _address;
 	std::uint64_t _size;
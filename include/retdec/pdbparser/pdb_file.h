@@ -7,10 +7,13 @@
 #ifndef RETDEC_PDBPARSER_PDB_FILE_H
 #define RETDEC_PDBPARSER_PDB_FILE_H
 
+#include <memory>
+
 #include "retdec/pdbparser/pdb_info.h"
 #include "retdec/pdbparser/pdb_symbols.h"
 #include "retdec/pdbparser/pdb_types.h"
 #include "retdec/pdbparser/pdb_utils.h"
+#include "retdec/utils/memory_mapped_file.h"
 
 namespace retdec {
 namespace pdbparser {
@@ -152,13 +155,7 @@ class PDBFile
 		{
 			return pdb_version;
 		}
-		PDBStream * get_stream(unsigned int num)
-		{
-			if (num < num_streams)
-				return &streams[num];
-			else
-				return nullptr;
-		}
+		PDBStream * get_stream(unsigned int num);
 		const char * get_module_name(unsigned int num)
 		{
 			if (num < modules.size())
@@ -212,6 +209,7 @@ class PDBFile
 		unsigned int page_size;
 		unsigned int pdb_file_size;
 		char * pdb_file_data;
+		std::unique_ptr<retdec::utils::MemoryMappedFile> pdb_file;
 		unsigned int num_streams;
 		int pdb_fpo_num;
 		int pdb_newfpo_num;
@@ -93,10 +93,11 @@ typedef struct PDB__IMAGE_SECTION_HEADER
 // PDB Stream
 typedef struct _PDBStream
 {
-		char * data;  // stream data pointer
+		char * data;  // stream data pointer (nullptr until the stream is requested)
 		int size;  // stream size in bytes
 		bool unused;  // indicates unused stream
 		bool linear;  // stream is linear in PDB file
+		PDB_DWORD * pages;  // indexes of pages used by stream
 } PDBStream;
 
 // PDB Modules vector
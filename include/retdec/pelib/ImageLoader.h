@@ -13,6 +13,7 @@
 #ifndef RETDEC_PELIB_IMAGE_LOADER_H
 #define RETDEC_PELIB_IMAGE_LOADER_H
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -92,19 +93,19 @@ struct PELIB_FILE_PAGE
 {
 	PELIB_FILE_PAGE()
 	{
+		fileData = nullptr;
+		fileDataSize = 0;
 		isInvalidPage = true;
 		isZeroPage = false;
 	}
 
-	// Initializes the page with a valid data
+	// Initializes the page with a valid data. The page only references the data,
+	// which must outlive it. A private copy is made on the first write (copy-on-write).
 	bool setValidPage(const void * data, size_t length)
 	{
-		// Write the valid data to the page
-		writeToPage(data, 0, length);
-
-		// Write zero data to the end of the page
-		memset(buffer.data() + length, 0, PELIB_PAGE_SIZE - length);
-
+		buffer.clear();
+		fileData = static_cast<const std::uint8_t *>(data);
+		fileDataSize = (length < PELIB_PAGE_SIZE) ? length : PELIB_PAGE_SIZE;
 		isInvalidPage = false;
 		isZeroPage = false;
 		return true;
@@ -114,17 +115,53 @@ struct PELIB_FILE_PAGE
 	void setZeroPage()
 	{
 		buffer.clear();
+		fileData = nullptr;
+		fileDataSize = 0;
 		isInvalidPage = false;
 		isZeroPage = true;
 	}
 
+	// Returns the data of the page, or nullptr if the page has no data (zero or invalid page).
+	// Only the first getDataSize() bytes are returned; the rest of the page is zeroed.
+	const std::uint8_t * getData() const
+	{
+		return buffer.size() ? buffer.data() : fileData;
+	}
+
+	size_t getDataSize() const
+	{
+		return buffer.size() ? buffer.size() : fileDataSize;
+	}
+
+	void readFromPage(void * data, size_t offset, size_t length) const
+	{
+		const std::uint8_t * pageData = getData();
+		size_t pageDataSize = getDataSize();
+		size_t bytesFromData = 0;
+
+		// Copy the data that are present in the page, the rest is zeroed
+		if(pageData != nullptr && offset < pageDataSize)
+		{
+			bytesFromData = (length < pageDataSize - offset) ? length : (pageDataSize - offset);
+			memcpy(data, pageData + offset, bytesFromData);
+		}
+		memset(static_cast<std::uint8_t *>(data) + bytesFromData, 0, length - bytesFromData);
+	}
+
 	void writeToPage(const void * data, size_t offset, size_t length)
 	{
 		if(offset < PELIB_PAGE_SIZE)
 		{
-			// Make sure that there is buffer allocated
+			// Make sure that there is a private buffer allocated. If the page references
+			// the file data, copy them to the buffer first
 			if(buffer.size() != PELIB_PAGE_SIZE)
+			{
 				buffer.resize(PELIB_PAGE_SIZE);
+				if(fileData != nullptr)
+					memcpy(buffer.data(), fileData, fileDataSize);
+				fileData = nullptr;
+				fileDataSize = 0;
+			}
 
 			// Copy the data, up to page size
 			if((offset + length) > PELIB_PAGE_SIZE)
@@ -133,7 +170,9 @@ struct PELIB_FILE_PAGE
 		}
 	}
 
-	ByteBuffer buffer;                    // A page-sized buffer, holding one image page. Empty if isInvalidPage
+	ByteBuffer buffer;                    // A page-sized private copy of the page. Empty until the page is written to
+	const std::uint8_t * fileData;        // Data of the page in the loaded file, if it has no private copy
+	size_t fileDataSize;                  // Number of valid bytes at fileData. The rest of the page is zeroed
 	bool isInvalidPage;                   // For invalid pages within image (SectionAlignment > 0x1000)
 	bool isZeroPage;                      // For sections with VirtualSize != 0, RawSize = 0
 };
@@ -147,7 +186,12 @@ class ImageLoader
 
 	ImageLoader(std::uint32_t loaderFlags = 0);
 
-	int Load(ByteBuffer & fileData, bool loadHeadersOnly = false);
+	// The mapped image references fileData instead of copying it (pages are copied on the first write).
+	// The caller must keep fileData alive and unchanged for the whole lifetime of the loader,
+	// or until the next Load(). Use the shared_ptr overload to hand the ownership over to the loader.
+	// The stream and file name overloads read the file into a buffer owned by the loader.
+	int Load(ByteView fileData, bool loadHeadersOnly = false);
+	int Load(std::shared_ptr<const ByteBuffer> fileData, bool loadHeadersOnly = false);
 	int Load(std::istream & fs, std::streamoff fileOffset = 0, bool loadHeadersOnly = false);
 	int Load(const char * fileName, bool loadHeadersOnly = false);
 
@@ -161,7 +205,7 @@ class ImageLoader
 
 	std::uint32_t readString(std::string & str, std::uint32_t rva, std::uint32_t maxLength = 65535);
 	std::uint32_t readStringRc(std::string & str, std::uint32_t rva);
-	std::uint32_t readStringRaw(ByteBuffer & fileData,
+	std::uint32_t readStringRaw(ByteView fileData,
 		                        std::string & str,
 		                        std::size_t offset,
 		                        std::size_t maxLength = 65535,
@@ -399,28 +443,28 @@ class ImageLoader
 	bool processImageRelocations(std::uint64_t oldImageBase, std::uint64_t getImageBase, std::uint32_t VirtualAddress, std::uint32_t Size);
 	void writeNewImageBase(std::uint64_t newImageBase);
 
-	int captureDosHeader(ByteBuffer & fileData);
+	int captureDosHeader(ByteView fileData);
 	int saveToFile(std::ostream & fs, std::streamoff fileOffset, std::size_t rva, std::size_t length);
 	int saveDosHeaderNew(std::ostream & fs, std::streamoff fileOffset);
 	int saveDosHeader(std::ostream & fs, std::streamoff fileOffset);
-	int captureNtHeaders(ByteBuffer & fileData);
+	int captureNtHeaders(ByteView fileData);
 	int saveNtHeadersNew(std::ostream & fs, std::streamoff fileOffset);
 	int saveNtHeaders(std::ostream & fs, std::streamoff fileOffset);
-	int captureSectionName(ByteBuffer & fileData, std::string & sectionName, const std::uint8_t * name);
-	int captureSectionHeaders(ByteBuffer & fileData);
+	int captureSectionName(ByteView fileData, std::string & sectionName, const std::uint8_t * name);
+	int captureSectionHeaders(ByteView fileData);
 	int saveSectionHeadersNew(std::ostream & fs, std::streamoff fileOffset);
 	int saveSectionHeaders(std::ostream & fs, std::streamoff fileOffset);
-	int captureImageSections(ByteBuffer & fileData);
-	int captureOptionalHeader32(std::uint8_t * fileData, std::uint8_t * filePtr, std::uint8_t * fileEnd);
-	int captureOptionalHeader64(std::uint8_t * fileData, std::uint8_t * filePtr, std::uint8_t * fileEnd);
+	int captureImageSections(ByteView fileData);
+	int captureOptionalHeader32(const std::uint8_t * fileData, const std::uint8_t * filePtr, const std::uint8_t * fileEnd);
+	int captureOptionalHeader64(const std::uint8_t * fileData, const std::uint8_t * filePtr, const std::uint8_t * fileEnd);
 	std::uint32_t copyDataDirectories(std::uint8_t * optionalHeaderPtr, std::uint8_t * dataDirectoriesPtr, std::size_t optionalHeaderMax, std::uint32_t numberOfRvaAndSizes);
 
 	int verifyDosHeader(PELIB_IMAGE_DOS_HEADER & hdr, std::size_t fileSize);
 	int verifyDosHeader(std::istream & fs, std::streamoff fileOffset, std::size_t fileSize);
 
-	int loadImageAsIs(ByteBuffer & fileData);
+	int loadImageAsIs(ByteView fileData);
 
-	std::uint32_t captureImageSection(ByteBuffer & fileData,
+	std::uint32_t captureImageSection(ByteView fileData,
 									  std::uint32_t virtualAddress,
 									  std::uint32_t virtualSize,
 									  std::uint32_t pointerToRawData,
@@ -438,7 +482,7 @@ class ImageLoader
 	bool checkForValid32BitMachine();
 	bool isValidMachineForCodeIntegrifyCheck(std::uint32_t Bits);
 	bool checkForSectionTablesWithinHeader(std::uint32_t e_lfanew);
-	bool checkForBadCodeIntegrityImages(ByteBuffer & fileData);
+	bool checkForBadCodeIntegrityImages(ByteView fileData);
 	bool checkForBadArchitectureSpecific();
 	bool checkForImageAfterMapping();
 
@@ -482,6 +526,7 @@ class ImageLoader
 	PELIB_IMAGE_FILE_HEADER fileHeader;                 // Loaded NT file header
 	PELIB_IMAGE_OPTIONAL_HEADER optionalHeader;         // 32/64-bit optional header
 	ByteBuffer rawFileData;                             // Loaded content of the image in case it couldn't have been mapped
+	std::shared_ptr<const ByteBuffer> ownFileData;      // Content of the file read by the loader itself, referenced by pages
 	LoaderError ldrError;
 	std::uint64_t savedFileSize;                        // Size of the raw file
 	std::uint32_t windowsBuildNumber;
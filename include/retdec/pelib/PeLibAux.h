@@ -133,6 +133,26 @@ namespace PeLib
 
 	typedef std::vector<std::uint8_t> ByteBuffer;
 
+	// Read-only view of bytes owned by somebody else (e.g. a memory-mapped file).
+	// Implicitly constructible from ByteBuffer, so the loader can be fed either way.
+	class ByteView
+	{
+		public:
+		  ByteView() = default;
+		  ByteView(const ByteBuffer & buffer) : m_data(buffer.data()), m_size(buffer.size()) {}
+		  ByteView(const std::uint8_t * data, std::size_t size) : m_data(data), m_size(size) {}
+
+		  const std::uint8_t * data() const { return m_data; }
+		  std::size_t size() const { return m_size; }
+		  bool empty() const { return m_size == 0; }
+		  const std::uint8_t * begin() const { return m_data; }
+		  const std::uint8_t * end() const { return m_data + m_size; }
+
+		private:
+		  const std::uint8_t * m_data = nullptr;
+		  std::size_t m_size = 0;
+	};
+
 	enum
 	{
 		PEFILE32 = 32,
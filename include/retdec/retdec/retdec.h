@@ -20,12 +20,7 @@ namespace retdec {
 struct LlvmModuleContextPair
 {
 	LlvmModuleContextPair(LlvmModuleContextPair&&) = default;
-	~LlvmModuleContextPair()
-	{
-		// Order matters: module destructor uses context.
-		module.reset();
-		context.reset();
-	}
+	~LlvmModuleContextPair();
 	std::unique_ptr<llvm::Module> module;
 	std::unique_ptr<llvm::LLVMContext> context;
 };
@@ -45,6 +40,13 @@ LlvmModuleContextPair disassemble(
  * Run a decompilation according to a \p config configuration.
  * If \p outString is set, decompilation output will be returned
  * in this string. Otherwise, output file is expected to be set in \p config.
+ *
+ * Every decompilation uses its own LLVM context and module, so several
+ * decompilations can run concurrently in different threads of a single
+ * process. Log targets are process-wide, so all the concurrently used
+ * configurations should specify the same ones.
+ *
+ * \return \c EXIT_SUCCESS (i.e. \c false) if the decompilation succeeded.
  */
 bool decompile(
 		retdec::config::Config& config,
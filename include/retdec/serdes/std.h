@@ -13,6 +13,8 @@
 #include <rapidjson/document.h>
 #include <rapidjson/encodings.h>
 
+#include "retdec/utils/io/json_output_stream.h"
+
 namespace retdec {
 namespace serdes {
 
@@ -23,12 +25,18 @@ namespace serdes {
  *     void serialize(Writer&, const T&)
  * @endcode
  */
-#define SERIALIZE_EXPLICIT_INSTANTIATION(T)                                    \
-	template void serialize(                                                   \
-		rapidjson::PrettyWriter<rapidjson::StringBuffer>&,                     \
-		const T&);                                                             \
-	template void serialize(                                                   \
-		rapidjson::PrettyWriter<rapidjson::StringBuffer, rapidjson::ASCII<>>&, \
+#define SERIALIZE_EXPLICIT_INSTANTIATION(T)                                        \
+	template void serialize(                                                       \
+		rapidjson::PrettyWriter<rapidjson::StringBuffer>&,                         \
+		const T&);                                                                 \
+	template void serialize(                                                       \
+		rapidjson::PrettyWriter<rapidjson::StringBuffer, rapidjson::ASCII<>>&,     \
+		const T&);                                                                 \
+	template void serialize(                                                       \
+		rapidjson::PrettyWriter<utils::io::JsonOutputStream, rapidjson::ASCII<>>&, \
+		const T&);                                                                 \
+	template void serialize(                                                       \
+		rapidjson::Writer<utils::io::JsonOutputStream, rapidjson::ASCII<>>&,       \
 		const T&);
 
 int64_t deserializeInt64(
@@ -0,0 +1,83 @@
+/**
+* @file include/retdec/utils/disk_cache.h
+* @brief Content-addressed cache of files on disk.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_DISK_CACHE_H
+#define RETDEC_UTILS_DISK_CACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Cache of files stored on disk between runs.
+*
+* Every entry is a set of named files stored in a subdirectory of the cache
+* directory. The subdirectory is named by the key of the entry, so the key
+* has to be a valid file name (e.g. a hash of everything the cached files
+* were computed from).
+*
+* An entry is first written into a temporary subdirectory which is then
+* renamed, so other processes sharing the cache never see partially written
+* entries.
+*
+* When the total size of all entries exceeds the maximal size after an entry
+* is stored, the least recently used entries are removed. Loading an entry
+* marks it as used.
+*/
+class DiskCache: private NonCopyable {
+public:
+	/// Files of an entry: their names mapped to their contents.
+	using Entry = std::map<std::string, std::string>;
+
+	/// Statistics of the cache since its creation.
+	struct Statistics {
+		/// Number of entries that were successfully loaded.
+		std::size_t hits = 0;
+		/// Number of entries that were not found or could not be loaded.
+		std::size_t misses = 0;
+		/// Number of stored entries.
+		std::size_t stores = 0;
+		/// Number of entries removed because the cache was too large.
+		std::size_t evictions = 0;
+		/// Number of entries in the cache after the last store.
+		std::size_t entries = 0;
+		/// Total size of entries in the cache after the last store (in bytes).
+		std::uint64_t size = 0;
+	};
+
+public:
+	DiskCache(const std::string &directory, std::uint64_t maxSize = 0);
+
+	bool load(const std::string &key, Entry &entry);
+	bool store(const std::string &key, const Entry &entry);
+
+	const std::string &getDirectory() const;
+	std::uint64_t getMaxSize() const;
+	const Statistics &getStatistics() const;
+
+private:
+	void evict(const std::string &keptKey);
+
+private:
+	/// Directory with all the entries.
+	std::string directory;
+
+	/// Maximal total size of all entries (in bytes), @c 0 means unlimited.
+	std::uint64_t maxSize = 0;
+
+	Statistics statistics;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -0,0 +1,178 @@
+/**
+* @file include/retdec/utils/interval_index.h
+* @brief An index of possibly overlapping intervals for fast point queries.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_INTERVAL_INDEX_H
+#define RETDEC_UTILS_INTERVAL_INDEX_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief An index of half-open intervals <tt>[start, start + size)</tt>
+*        answering which intervals contain a given point.
+*
+* @tparam T Type of values associated with the intervals.
+*
+* Intervals are added by add() and the index is then built by build(). Point
+* queries take <tt>O(log n + k)</tt> time, where @c k is the number of
+* intervals that start before the point and may reach it. For non-overlapping
+* intervals, @c k is at most one. Moreover, the index remembers the last hit,
+* so repeated queries into the same interval take constant time.
+*
+* Queries may be run concurrently from several threads. Adding intervals and
+* building the index may not.
+*/
+template<typename T>
+class IntervalIndex {
+public:
+	IntervalIndex() = default;
+	IntervalIndex(const IntervalIndex &other):
+		entries(other.entries), maxLasts(other.maxLasts) {}
+	IntervalIndex &operator=(const IntervalIndex &other) {
+		entries = other.entries;
+		maxLasts = other.maxLasts;
+		lastHit = NoHit;
+		return *this;
+	}
+
+	/**
+	* @brief Adds the interval <tt>[start, start + size)</tt> with the given
+	*        value. Empty intervals are ignored.
+	*
+	* build() has to be called before the index is queried again.
+	*/
+	void add(std::uint64_t start, std::uint64_t size, const T &value) {
+		if (size == 0) {
+			return;
+		}
+		entries.push_back({start, size, entries.size(), value});
+	}
+
+	/**
+	* @brief Builds the index from the added intervals.
+	*/
+	void build() {
+		// Intervals with the same start are ordered by the order in which
+		// they were added, see forEachContaining().
+		std::sort(entries.begin(), entries.end(),
+			[](const Entry &e1, const Entry &e2) {
+				return e1.start < e2.start
+					|| (e1.start == e2.start && e1.order > e2.order);
+			}
+		);
+
+		maxLasts.clear();
+		maxLasts.reserve(entries.size());
+		std::uint64_t maxLast = 0;
+		for (const auto &entry : entries) {
+			maxLast = std::max(maxLast, entry.last());
+			maxLasts.push_back(maxLast);
+		}
+		lastHit = NoHit;
+	}
+
+	/**
+	* @brief Removes all the intervals.
+	*/
+	void clear() {
+		entries.clear();
+		maxLasts.clear();
+		lastHit = NoHit;
+	}
+
+	/**
+	* @brief Returns the number of indexed intervals.
+	*/
+	std::size_t size() const {
+		return entries.size();
+	}
+
+	/**
+	* @brief Calls @a func for the values of all the intervals containing
+	*        @a point until it returns @c false.
+	*
+	* The intervals are visited in the order of decreasing starts. Intervals
+	* with the same start are visited in the order in which they were added.
+	*/
+	template<typename Func>
+	void forEachContaining(std::uint64_t point, Func func) const {
+		// Fast path: the interval from the last query is the only one that
+		// contains the point.
+		auto hit = lastHit.load(std::memory_order_relaxed);
+		if (hit < entries.size() && isOnlyContaining(hit, point)) {
+			func(entries[hit].value);
+			return;
+		}
+
+		auto it = std::upper_bound(entries.begin(), entries.end(), point,
+			[](std::uint64_t p, const Entry &e) { return p < e.start; }
+		);
+		for (auto i = static_cast<std::size_t>(it - entries.begin()); i > 0; --i) {
+			// No interval up to this one reaches the point.
+			if (maxLasts[i - 1] < point) {
+				break;
+			}
+
+			if (entries[i - 1].contains(point)) {
+				lastHit.store(i - 1, std::memory_order_relaxed);
+				if (!func(entries[i - 1].value)) {
+					return;
+				}
+			}
+		}
+	}
+
+private:
+	/// An indexed interval.
+	struct Entry {
+		std::uint64_t start;
+		std::uint64_t size;
+		std::size_t order;
+		T value;
+
+		/// The last point of the interval, saturated to the maximal value.
+		std::uint64_t last() const {
+			return size - 1 > std::numeric_limits<std::uint64_t>::max() - start
+				? std::numeric_limits<std::uint64_t>::max()
+				: start + (size - 1);
+		}
+
+		bool contains(std::uint64_t point) const {
+			return point >= start && point - start < size;
+		}
+	};
+
+	/// Is the entry with the given index the only one containing @a point?
+	bool isOnlyContaining(std::size_t i, std::uint64_t point) const {
+		return entries[i].contains(point)
+			&& (i + 1 == entries.size() || entries[i + 1].start > point)
+			&& (i == 0 || maxLasts[i - 1] < point);
+	}
+
+private:
+	static constexpr std::size_t NoHit = std::numeric_limits<std::size_t>::max();
+
+	/// Intervals sorted by their starts.
+	std::vector<Entry> entries;
+
+	/// Maximal last point of the intervals up to the given index.
+	std::vector<std::uint64_t> maxLasts;
+
+	/// Index of the interval that has been hit by the last query.
+	mutable std::atomic<std::size_t> lastHit{NoHit};
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -0,0 +1,65 @@
+/**
+* @file include/retdec/utils/io/json_output_stream.h
+* @brief Output stream for rapidjson writers which writes into std::ostream.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_IO_JSON_OUTPUT_STREAM_H
+#define RETDEC_UTILS_IO_JSON_OUTPUT_STREAM_H
+
+#include <array>
+#include <cstddef>
+#include <ostream>
+
+namespace retdec {
+namespace utils {
+namespace io {
+
+/**
+ * @brief Output stream for rapidjson writers which writes into @c std::ostream
+ * through a buffer of a fixed size, so the written document is never held
+ * in memory as a whole.
+ */
+class JsonOutputStream {
+public:
+	using Ch = char;
+
+public:
+	explicit JsonOutputStream(std::ostream& out) : _out(out) {}
+	JsonOutputStream(const JsonOutputStream&) = delete;
+	~JsonOutputStream() { Flush(); }
+
+	JsonOutputStream& operator=(const JsonOutputStream&) = delete;
+
+	void Put(char c) {
+		if (_size == _buffer.size()) {
+			Flush();
+		}
+		_buffer[_size++] = c;
+	}
+
+	void Flush() {
+		_out.write(_buffer.data(), _size);
+		_size = 0;
+	}
+
+private:
+	/// Underlying stream.
+	std::ostream& _out;
+	/// Buffered characters.
+	std::array<char, 64 * 1024> _buffer;
+	/// Number of buffered characters.
+	std::size_t _size = 0;
+};
+
+/// @name Functions needed by rapidjson for streams outside its namespace
+/// @{
+inline void PutReserve(JsonOutputStream&, std::size_t) {}
+inline void PutUnsafe(JsonOutputStream& stream, char c) { stream.Put(c); }
+/// @}
+
+} // namespace io
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -15,6 +15,9 @@ namespace utils {
 std::size_t getTotalSystemMemory();
 bool limitSystemMemory(std::size_t limit);
 bool limitSystemMemoryToHalfOfTotalSystemMemory();
+std::size_t getProcessMemoryUsage();
+std::size_t getPeakProcessMemoryUsage();
+bool resetPeakProcessMemoryUsage();
 
 } // namespace utils
 } // namespace retdec
@@ -0,0 +1,58 @@
+/**
+* @file include/retdec/utils/memory_mapped_file.h
+* @brief Read-only memory-mapped files.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_MEMORY_MAPPED_FILE_H
+#define RETDEC_UTILS_MEMORY_MAPPED_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief A file mapped read-only into the memory of the process.
+*
+* The content of the file is paged in lazily by the operating system when it
+* is accessed, and the pages are shared with the page cache. Therefore, even
+* huge files can be mapped without allocating memory for their content.
+*
+* The mapping is released when the instance is destroyed. Instances of this
+* class are neither copyable nor movable.
+*/
+class MemoryMappedFile: private NonCopyable {
+public:
+	explicit MemoryMappedFile(const std::string &path);
+	~MemoryMappedFile();
+
+	bool isOpen() const;
+	const std::uint8_t *getData() const;
+	std::size_t getSize() const;
+
+private:
+	void close();
+
+private:
+	/// Beginning of the mapped content.
+	const std::uint8_t *data = nullptr;
+
+	/// Size of the mapped content.
+	std::size_t size = 0;
+
+	/// Has the file been successfully mapped?
+	bool opened = false;
+
+	/// Native handle of the mapping (Windows only).
+	void *mappingHandle = nullptr;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
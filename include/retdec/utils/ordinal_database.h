@@ -0,0 +1,95 @@
+/**
+* @file include/retdec/utils/ordinal_database.h
+* @brief Database of names of functions imported by ordinals.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_ORDINAL_DATABASE_H
+#define RETDEC_UTILS_ORDINAL_DATABASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace utils {
+
+class MemoryMappedFile;
+
+/**
+* @brief Names of functions exported by libraries under ordinal numbers.
+*
+* The database is a single binary file built from the per-library @c .ord
+* files (see write()). It is memory-mapped when opened and entries are looked
+* up in constant time by a perfect hash of the architecture, library name and
+* ordinal, so nothing is parsed or allocated per library.
+*
+* Layout of the file (all numbers are 32-bit little-endian words):
+*  - header: magic, version, buckets offset, buckets count, slots offset,
+*    slots count, entries count,
+*  - buckets: displacement of each bucket of the perfect hash,
+*  - slots: (library hash low word, library hash high word, ordinal, name
+*    offset) for each slot, empty slots have name offset @c 0xffffffff,
+*  - names: each name is its length (one word) followed by its bytes padded
+*    to a multiple of four bytes.
+*/
+class OrdinalDatabase: private NonCopyable {
+public:
+	/// One entry of the database.
+	struct Entry {
+		/// Architecture of the library (e.g. @c x86 or @c arm).
+		std::string arch;
+		/// Name of the library.
+		std::string library;
+		/// Ordinal number of the function.
+		std::uint32_t ordinal = 0;
+		/// Name of the function.
+		std::string name;
+	};
+
+	/// Name of the database file in the directory with @c .ord files.
+	static const std::string DefaultFileName;
+
+public:
+	OrdinalDatabase();
+	~OrdinalDatabase();
+
+	bool open(const std::string &path);
+	bool open(const std::uint8_t *data, std::size_t size);
+	bool isOpen() const;
+
+	std::string getName(const std::string &arch, const std::string &library,
+		std::uint64_t ordinal) const;
+	std::size_t getNumberOfEntries() const;
+
+	static bool write(std::ostream &out, const std::vector<Entry> &entries);
+
+private:
+	std::uint32_t readWord(std::size_t offset) const;
+
+private:
+	/// Mapped database file, if the database was opened from a file.
+	std::unique_ptr<MemoryMappedFile> file;
+
+	/// Content of the database.
+	const std::uint8_t *data = nullptr;
+
+	/// Size of the content of the database.
+	std::size_t size = 0;
+
+	std::uint32_t bucketsOffset = 0;
+	std::uint32_t bucketsCount = 0;
+	std::uint32_t slotsOffset = 0;
+	std::uint32_t slotsCount = 0;
+	std::uint32_t entriesCount = 0;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -0,0 +1,111 @@
+/**
+* @file include/retdec/utils/pass_profiler.h
+* @brief Profiler of passes of the decompilation pipeline.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_PASS_PROFILER_H
+#define RETDEC_UTILS_PASS_PROFILER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Measures wall time, CPU time, memory, and IR size of passes.
+*
+* Every pass is enclosed in a pair of start() and stop() calls. Passes may be
+* nested (e.g. optimizers run inside of a pass), so every stop() finishes the
+* most recently started pass.
+*
+* The results can be written by writeJson() into a JSON file which contains
+* both the detailed records of all passes and events in the Chrome trace
+* format, so the file can be directly opened in chrome://tracing or Perfetto.
+*
+* The CPU time and memory are measured for the whole process, so when a pass
+* runs in parallel with other work, they include the other work, too.
+*
+* Instances of this class are not thread-safe. All passes of a single profiler
+* have to be started and stopped from the same thread.
+*/
+class PassProfiler: private NonCopyable {
+public:
+	/// Size of the profiled IR.
+	struct IrSize {
+		std::size_t functions = 0;
+		std::size_t blocks = 0;
+		std::size_t instructions = 0;
+	};
+
+	/// Measurements of a single pass.
+	struct Record {
+		/// Name of the pass.
+		std::string name;
+		/// Category of the pass (e.g. @c "llvm").
+		std::string category;
+		/// Nesting level of the pass (@c 0 for top-level passes).
+		std::size_t depth = 0;
+		/// Start of the pass since the creation of the profiler (in µs).
+		std::uint64_t startUs = 0;
+		/// Wall time of the pass (in µs).
+		std::uint64_t wallUs = 0;
+		/// CPU time of the whole process during the pass (in µs).
+		std::uint64_t cpuUs = 0;
+		/// Resident set size before the pass (in bytes).
+		std::size_t rssBefore = 0;
+		/// Resident set size after the pass (in bytes).
+		std::size_t rssAfter = 0;
+		/// Increase of the peak resident set size during the pass (in bytes).
+		std::size_t peakRssDelta = 0;
+		/// Size of the IR before the pass.
+		IrSize irBefore;
+		/// Size of the IR after the pass.
+		IrSize irAfter;
+	};
+
+public:
+	PassProfiler();
+
+	void start(const std::string &name, const std::string &category);
+	void start(const std::string &name, const std::string &category,
+		const IrSize &irBefore);
+	void stop();
+	void stop(const IrSize &irAfter);
+
+	const std::vector<Record> &getRecords() const;
+
+	void writeJson(std::ostream &out) const;
+	bool writeJson(const std::string &path) const;
+
+private:
+	/// A pass that has been started but not stopped yet.
+	struct RunningPass {
+		std::size_t recordIndex;
+		std::chrono::steady_clock::time_point wallStart;
+		std::uint64_t cpuStartUs;
+		std::size_t peakRssBefore;
+	};
+
+private:
+	/// Creation of the profiler.
+	const std::chrono::steady_clock::time_point creation;
+
+	/// Records of all passes in the order in which they were started.
+	std::vector<Record> records;
+
+	/// Passes that are running, the innermost one at the back.
+	std::vector<RunningPass> running;
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
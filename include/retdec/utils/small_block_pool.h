@@ -0,0 +1,93 @@
+/**
+* @file include/retdec/utils/small_block_pool.h
+* @brief Process-wide pool of small memory blocks.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_SMALL_BLOCK_POOL_H
+#define RETDEC_UTILS_SMALL_BLOCK_POOL_H
+
+#include <cstddef>
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Process-wide pool of small memory blocks.
+*
+* Blocks are grouped into size classes (multiples of @c Alignment). Blocks of
+* the same size class are carved out of large chunks, so they need no header
+* and are densely packed. Freed blocks are kept in per-thread free lists and
+* reused by later allocations of the same size class. When a thread exits,
+* its free blocks are handed over to the other threads.
+*
+* Memory of chunks is never returned to the system; it is reused by later
+* allocations instead. Therefore, the pool is suitable for many small objects
+* of a few sizes that are created and destroyed repeatedly (e.g. nodes of an
+* IR), not for long-lived objects of arbitrary sizes.
+*
+* Blocks larger than @c MaxBlockSize are allocated by the global
+* <tt>operator new</tt>. All the functions are thread-safe.
+*/
+class SmallBlockPool {
+public:
+	/// Alignment of all blocks (in bytes).
+	static constexpr std::size_t Alignment = 8;
+	/// Size of the largest block that is allocated from the pool (in bytes).
+	static constexpr std::size_t MaxBlockSize = 1024;
+
+public:
+	SmallBlockPool() = delete;
+
+	static void *allocate(std::size_t size);
+	static void deallocate(void *block, std::size_t size) noexcept;
+
+	static std::size_t getReservedSize();
+};
+
+/**
+* @brief An allocator satisfying the requirements of @c Allocator which
+*        allocates from SmallBlockPool.
+*
+* It is intended for node-based containers and control blocks of shared
+* pointers, i.e. for allocations of single objects.
+*
+* @tparam T Type of allocated objects.
+*/
+template<typename T>
+class SmallBlockAllocator {
+	static_assert(alignof(T) <= SmallBlockPool::Alignment,
+		"SmallBlockPool does not support over-aligned types");
+
+public:
+	using value_type = T;
+
+public:
+	SmallBlockAllocator() noexcept = default;
+
+	template<typename U>
+	SmallBlockAllocator(const SmallBlockAllocator<U> &) noexcept {}
+
+	T *allocate(std::size_t n) {
+		return static_cast<T *>(SmallBlockPool::allocate(n * sizeof(T)));
+	}
+
+	void deallocate(T *p, std::size_t n) noexcept {
+		SmallBlockPool::deallocate(p, n * sizeof(T));
+	}
+
+	template<typename U>
+	bool operator==(const SmallBlockAllocator<U> &) const noexcept {
+		return true;
+	}
+
+	template<typename U>
+	bool operator!=(const SmallBlockAllocator<U> &) const noexcept {
+		return false;
+	}
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
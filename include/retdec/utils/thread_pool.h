@@ -0,0 +1,167 @@
+/**
+* @file include/retdec/utils/thread_pool.h
+* @brief A work-stealing pool of worker threads.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef RETDEC_UTILS_THREAD_POOL_H
+#define RETDEC_UTILS_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "retdec/utils/non_copyable.h"
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief A pool of worker threads with per-thread task queues.
+*
+* Every worker owns a double-ended queue of tasks. It takes tasks from the
+* front of its own queue and, when the queue is empty, steals tasks from the
+* back of the queues of the other workers. Tasks submitted from a worker are
+* put into the worker's own queue, so nested parallelism keeps its locality.
+*
+* A thread that waits for tasks (wait(), parallelFor()) does not block
+* idly: it helps the workers by running the queued tasks. Therefore, it is
+* safe to call parallelFor() from a task that is itself run by the pool.
+*
+* Instances of this class are neither copyable nor movable.
+*/
+class ThreadPool: private NonCopyable {
+public:
+	/// A task run by the pool.
+	using Task = std::function<void ()>;
+
+public:
+	explicit ThreadPool(std::size_t threadCount = 0);
+	~ThreadPool();
+
+	std::size_t getThreadCount() const;
+
+	void submit(Task task);
+	void wait();
+
+	/**
+	* @brief Calls @a func(i) for every @c i in <tt>[0, count)</tt>.
+	*
+	* The indexes are distributed dynamically among the workers and the
+	* calling thread, so the calls may run in any order and concurrently. The
+	* function returns when all the calls have finished. If some of them
+	* throws, the first caught exception is rethrown (the remaining indexes
+	* are still processed).
+	*
+	* To get deterministic results, make every call write only into its own
+	* slot of a pre-allocated container.
+	*/
+	template<typename Func>
+	void parallelFor(std::size_t count, Func func) {
+		if (count == 0) {
+			return;
+		}
+
+		auto state = std::make_shared<ParallelForState>(count);
+		auto body = [state, &func]() {
+			for (std::size_t i = state->next++; i < state->count;
+					i = state->next++) {
+				try {
+					func(i);
+				} catch (...) {
+					std::lock_guard<std::mutex> lock(state->errorMutex);
+					if (!state->error) {
+						state->error = std::current_exception();
+					}
+				}
+			}
+		};
+
+		// Let the workers join in and process the indexes also in this thread.
+		std::size_t helpers = std::min(count, getThreadCount()) - 1;
+		state->runningHelpers = helpers;
+		for (std::size_t i = 0; i < helpers; ++i) {
+			submit([state, body]() {
+				body();
+				--state->runningHelpers;
+			});
+		}
+		body();
+		runTasksUntil([state]() { return state->runningHelpers == 0; });
+
+		if (state->error) {
+			std::rethrow_exception(state->error);
+		}
+	}
+
+	static std::size_t getDefaultThreadCount();
+
+private:
+	/// A queue of tasks owned by a single worker.
+	struct TaskQueue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	/// Shared state of a single parallelFor() call.
+	struct ParallelForState {
+		explicit ParallelForState(std::size_t count): count(count) {}
+
+		const std::size_t count;
+		std::atomic<std::size_t> next{0};
+		std::atomic<std::size_t> runningHelpers{0};
+		std::mutex errorMutex;
+		std::exception_ptr error;
+	};
+
+private:
+	void workerLoop(std::size_t index);
+	bool popTask(std::size_t index, Task &task);
+	void runTask(Task &task);
+	void runTasksUntil(const std::function<bool ()> &done);
+	std::size_t getQueueIndexForCurrentThread();
+
+private:
+	/// Queues of tasks, one for every worker.
+	std::vector<std::unique_ptr<TaskQueue>> queues;
+
+	/// The worker threads.
+	std::vector<std::thread> workers;
+
+	/// Guards the counters below and is used with the condition variables.
+	std::mutex stateMutex;
+
+	/// Signalled when a task has been queued or the pool is stopping.
+	std::condition_variable taskQueued;
+
+	/// Signalled when a task has finished.
+	std::condition_variable taskFinished;
+
+	/// Number of tasks that are queued but have not been started yet.
+	std::size_t queuedTasks = 0;
+
+	/// Number of tasks that have been submitted but have not finished yet.
+	std::size_t unfinishedTasks = 0;
+
+	/// The first exception thrown from a task submitted via submit().
+	std::exception_ptr firstError;
+
+	/// Should the workers stop?
+	bool stopping = false;
+
+	/// Index of the queue into which the next external task is put.
+	std::atomic<std::size_t> nextQueue{0};
+};
+
+} // namespace utils
+} // namespace retdec
+
+#endif
@@ -7,6 +7,7 @@
 #ifndef RETDEC_YARACPP_YARA_DETECTOR_H
 #define RETDEC_YARACPP_YARA_DETECTOR_H
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +15,7 @@
 #include "retdec/yaracpp/yara_rule.h"
 
 typedef struct _YR_COMPILER YR_COMPILER;
+typedef struct YR_RULE YR_RULE;
 typedef struct YR_RULES YR_RULES;
 typedef struct YR_SCAN_CONTEXT YR_SCAN_CONTEXT;
 
@@ -38,6 +40,15 @@ class YaraDetector
 				std::vector<YaraRule> &storedDetected;
 				/// link to undetected rules
 				std::vector<YaraRule> &storedUndetected;
+				/// path to rule file of currently scanned rules
+				std::string ruleFile;
+				/// paths to rule files of namespaces of currently scanned
+				/// rules, if they are not from @c ruleFile
+				const std::unordered_map<std::string, std::string>
+						*namespaceFiles = nullptr;
+				/// set to @c true if only rules of namespaces from
+				/// @c namespaceFiles are reported
+				bool onlyNamespaceFiles = false;
 			public:
 				CallbackSettings(
 						bool cStoreAll,
@@ -50,6 +61,14 @@ class YaraDetector
 				void addDetected(YaraRule &rule);
 				void addUndetected(YaraRule &rule);
 				bool storeAllRules() const;
+				void setRuleFile(
+						const std::string &pathToFile,
+						const std::unordered_map<std::string, std::string>
+								*namespacesToFiles = nullptr,
+						bool onlyNamespacesToFiles = false
+				);
+				std::string getRuleFile(const YR_RULE *rule) const;
+				bool isReported(const YR_RULE *rule) const;
 				/// @}
 		};
 
@@ -69,23 +88,54 @@ class YaraDetector
 			FILE* handle;
 		};
 
+		/**
+		 * Text rules which are compiled together
+		 */
+		struct TextRules
+		{
+			/// path to rule file or empty string for rules added as string
+			std::string pathToFile;
+			/// namespace of the rules
+			std::string nameSpace;
+			/// rules added as string
+			std::string content;
+		};
+
 	private:
-		/// compiler or text rules
+		/// compiler used to check rules added as strings
 		YR_COMPILER *compiler = nullptr;
-		/// representation of files with rules
-		std::vector<FILE*> files;
 		/// representation of detected rules
 		std::vector<YaraRule> detectedRules;
 		/// representation of undetected rules
 		std::vector<YaraRule> undetectedRules;
-		/// rules from input text files
-		YR_RULES* textFilesRules = nullptr;
-		/// rules from precompiled files
-		std::vector<YR_RULES*> precompiledRules;
+		/// text rule files and rules added as strings in order of addition
+		std::vector<TextRules> textSources;
+		/// key of @c textSources in the registry of compiled rules
+		std::string textSourcesKey;
+		/// compiled @c textSources (shared with other instances)
+		std::shared_ptr<YR_RULES> textRules;
+		/// namespaces of text rules used by a single rule file and paths
+		/// to these files
+		std::unordered_map<std::string, std::string> namespaceFiles;
+		/**
+		 * Compiled rules from a precompiled rule file
+		 */
+		struct FileRules
+		{
+			/// compiled rules (shared with other instances)
+			std::shared_ptr<YR_RULES> rules;
+			/// path to rule file or empty string for merged rule files
+			std::string pathToFile;
+			/// namespaces of selected rule files of merged rule files and
+			/// paths to these files
+			std::unordered_map<std::string, std::string> namespaceFiles;
+		};
+		/// rules from precompiled rule files
+		std::vector<FileRules> precompiledRules;
 		/// internal state of instance
 		bool stateIsValid = true;
-		/// indicates whether text files need recompilation
-		bool needsRecompilation = true;
+		/// indicates whether text rules need recompilation
+		bool needsRecompilation = false;
 
 		/// @name Static auxiliary methods
 		/// @{
@@ -104,11 +154,19 @@ class YaraDetector
 				bool storeAllRules = false
 		);
 		YR_RULES* getCompiledRules();
+		void addTextRules(TextRules &&source, const std::string &key);
 		/// @}
 	public:
 		YaraDetector();
 		~YaraDetector();
 
+		/// @name Cache of compiled rules
+		/// @{
+		static void setCacheDirectory(const std::string &directory);
+		static std::string getCacheDirectory();
+		static void releaseCompiledRules();
+		/// @}
+
 		/// @name Other methods
 		/// @{
 		bool addRules(const char *string);
@@ -116,6 +174,7 @@ class YaraDetector
 				const std::string &pathToFile,
 				const std::string &nameSpace = std::string()
 		);
+		bool addRuleFiles(const std::vector<std::string> &pathsToFiles);
 		bool isInValidState() const;
 		/// @}
 
@@ -129,6 +188,11 @@ class YaraDetector
 				std::vector<std::uint8_t> &bytes,
 				bool storeAllRules = false
 		);
+		bool analyze(
+				const std::uint8_t *data,
+				std::size_t size,
+				bool storeAllRules = false
+		);
 		const std::vector<YaraRule>& getDetectedRules() const;
 		const std::vector<YaraRule>& getUndetectedRules() const;
 		/// @}
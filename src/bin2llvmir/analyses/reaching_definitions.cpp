@@ -4,12 +4,15 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <deque>
 #include <iomanip>
+#include <limits>
 #include <set>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include <llvm/ADT/BitVector.h>
 #include <llvm/ADT/PostOrderIterator.h>
 #include <llvm/IR/CFG.h>
 #include <llvm/IR/Instruction.h>
@@ -29,6 +32,245 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
+namespace {
+
+/**
+ * Call @a func(i) for every @c i in <0, count) -- in parallel on @a pool if
+ * it is given, serially otherwise.
+ */
+template<typename Func>
+void parallelFor(utils::ThreadPool* pool, std::size_t count, Func func)
+{
+	if (pool && count > 1)
+	{
+		pool->parallelFor(count, func);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			func(i);
+		}
+	}
+}
+
+/// Marks uses of values that are not defined anywhere in a function.
+const unsigned NO_SOURCE = std::numeric_limits<unsigned>::max();
+
+/**
+ * Dense numbering of values defined in a function (sources of definitions).
+ */
+struct SourceNumbering
+{
+	/// Definition index -> its source index.
+	std::vector<unsigned> defSrcs;
+	/// Use index -> its source index (or @c NO_SOURCE).
+	std::vector<unsigned> useSrcs;
+	/// Source index -> indexes of all its definitions.
+	std::vector<std::vector<unsigned>> srcDefs;
+};
+
+SourceNumbering numberSources(const FunctionEntry& fe)
+{
+	SourceNumbering ret;
+	std::unordered_map<const llvm::Value*, unsigned> src2idx;
+
+	ret.defSrcs.reserve(fe.defs.size());
+	for (unsigned i = 0; i < fe.defs.size(); ++i)
+	{
+		auto p = src2idx.emplace(fe.defs[i].src, ret.srcDefs.size());
+		if (p.second)
+		{
+			ret.srcDefs.emplace_back();
+		}
+		ret.srcDefs[p.first->second].push_back(i);
+		ret.defSrcs.push_back(p.first->second);
+	}
+
+	ret.useSrcs.reserve(fe.uses.size());
+	for (auto& u : fe.uses)
+	{
+		auto fIt = src2idx.find(u.src);
+		ret.useSrcs.push_back(fIt != src2idx.end() ? fIt->second : NO_SOURCE);
+	}
+
+	return ret;
+}
+
+void initializeBasicBlocksPrev(const llvm::Function& F, FunctionEntry& fe)
+{
+	std::unordered_map<const BasicBlock*, unsigned> bb2idx;
+	for (unsigned i = 0; i < fe.bbs.size(); ++i)
+	{
+		bb2idx[fe.bbs[i].bb] = i;
+	}
+
+	for (unsigned i = 0; i < fe.bbs.size(); ++i)
+	{
+		for (auto* pred : predecessors(fe.bbs[i].bb))
+		{
+			auto p = bb2idx.find(pred);
+			assert(p != bb2idx.end() && "we should have all BBs stored");
+
+			fe.bbs[i].prevBBs.push_back(p->second);
+			fe.bbs[p->second].nextBBs.push_back(i);
+		}
+	}
+}
+
+/**
+ * Compute definitions reaching entries of basic blocks of @a fe:
+ *
+ * REACH_in[B] = Sum (p in pred[B]) (REACH_out[p])
+ * REACH_out[B] = GEN[B] + ( REACH_in[B] - KILL[B] )
+ *
+ * Sets are bit vectors indexed by definition indexes. Only basic blocks
+ * reachable from the entry are solved, the other ones reach nothing.
+ *
+ * @return REACH_in of all the basic blocks in @a fe.
+ */
+std::vector<BitVector> propagate(
+		const llvm::Function* F,
+		const FunctionEntry& fe,
+		const SourceNumbering& srcs)
+{
+	auto nDefs = fe.defs.size();
+	auto nBbs = fe.bbs.size();
+
+	// The last definition of each source in BB is generated, all the
+	// definitions of the source are killed.
+	//
+	std::vector<BitVector> gen(nBbs, BitVector(nDefs));
+	std::vector<BitVector> kill(nBbs, BitVector(nDefs));
+	for (unsigned i = 0; i < nBbs; ++i)
+	{
+		auto& bbe = fe.bbs[i];
+		for (unsigned d = bbe.defsEnd; d > bbe.defsBegin; --d)
+		{
+			if (kill[i].test(d - 1))
+			{
+				continue;
+			}
+			gen[i].set(d - 1);
+			for (auto sd : srcs.srcDefs[srcs.defSrcs[d - 1]])
+			{
+				kill[i].set(sd);
+			}
+		}
+	}
+
+	std::unordered_map<const BasicBlock*, unsigned> bb2idx;
+	for (unsigned i = 0; i < nBbs; ++i)
+	{
+		bb2idx[fe.bbs[i].bb] = i;
+	}
+
+	std::deque<unsigned> workList;
+	std::vector<bool> inWorkList(nBbs, false);
+	ReversePostOrderTraversal<const Function*> RPOT(F); // Expensive to create
+	for (auto I = RPOT.begin(); I != RPOT.end(); ++I)
+	{
+		auto i = bb2idx[*I];
+		workList.push_back(i);
+		inWorkList[i] = true;
+	}
+
+	std::vector<BitVector> in(nBbs, BitVector(nDefs));
+	std::vector<BitVector> out(nBbs, BitVector(nDefs));
+	BitVector newOut(nDefs);
+	while (!workList.empty())
+	{
+		auto i = workList.front();
+		workList.pop_front();
+		inWorkList[i] = false;
+
+		auto& bbIn = in[i];
+		bbIn.reset();
+		for (auto p : fe.bbs[i].prevBBs)
+		{
+			bbIn |= out[p];
+		}
+
+		newOut = bbIn;
+		newOut.reset(kill[i]);
+		newOut |= gen[i];
+		if (newOut == out[i])
+		{
+			continue;
+		}
+
+		std::swap(out[i], newOut);
+		for (auto s : fe.bbs[i].nextBBs)
+		{
+			if (!inWorkList[s])
+			{
+				workList.push_back(s);
+				inWorkList[s] = true;
+			}
+		}
+	}
+
+	return in;
+}
+
+/**
+ * Connect uses in @a fe with definitions that reach them. A use is reached by
+ * the last definition of its source before it in the same basic block, or by
+ * all the definitions of its source reaching the basic block (@a in).
+ */
+void initializeDefsAndUses(
+		FunctionEntry& fe,
+		const SourceNumbering& srcs,
+		const std::vector<BitVector>& in)
+{
+	std::vector<unsigned> lastDef(srcs.srcDefs.size(), NO_SOURCE);
+
+	for (unsigned i = 0; i < fe.bbs.size(); ++i)
+	{
+		auto& bbe = fe.bbs[i];
+
+		unsigned d = bbe.defsBegin;
+		for (unsigned u = bbe.usesBegin; u < bbe.usesEnd; ++u)
+		{
+			Use& use = fe.uses[u];
+			for (; d < bbe.defsEnd && fe.defs[d].posInBb < use.posInBb; ++d)
+			{
+				lastDef[srcs.defSrcs[d]] = d;
+			}
+
+			auto src = srcs.useSrcs[u];
+			if (src == NO_SOURCE)
+			{
+				continue;
+			}
+
+			if (lastDef[src] != NO_SOURCE)
+			{
+				Definition& def = fe.defs[lastDef[src]];
+				def.uses.insert(&use);
+				use.defs.insert(&def);
+				continue;
+			}
+
+			for (auto sd : srcs.srcDefs[src])
+			{
+				if (in[i].test(sd))
+				{
+					fe.defs[sd].uses.insert(&use);
+					use.defs.insert(&fe.defs[sd]);
+				}
+			}
+		}
+
+		for (unsigned dd = bbe.defsBegin; dd < d; ++dd)
+		{
+			lastDef[srcs.defSrcs[dd]] = NO_SOURCE;
+		}
+	}
+}
+
+} // anonymous namespace
+
 //
 //=============================================================================
 //  ReachingDefinitionsAnalysis
@@ -45,8 +287,14 @@ bool ReachingDefinitionsAnalysis::runOnModule(
 	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(&M);
 
 	clear();
-	initializeBasicBlocks(M);
-	run();
+	for (Function& F : M)
+	{
+		if (auto* fe = resetFunctionEntry(F))
+		{
+			run(F, *fe);
+		}
+	}
+	LOG << *this << "\n";
 
 	_run = true;
 	return false;
@@ -62,38 +310,205 @@ bool ReachingDefinitionsAnalysis::runOnFunction(
 	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(F.getParent());
 
 	clear();
-	initializeBasicBlocks(F);
-	run();
+	if (auto* fe = resetFunctionEntry(F))
+	{
+		run(F, *fe);
+	}
+	LOG << *this << "\n";
 
 	_run = true;
 	return false;
 }
 
-void ReachingDefinitionsAnalysis::run()
+/**
+ * Compute RDA of function @a F into an empty entry @a fe. The computation does
+ * not depend on other functions and does not modify the analysis, so it can
+ * run for several functions in parallel.
+ */
+void ReachingDefinitionsAnalysis::run(
+		llvm::Function& F,
+		FunctionEntry& fe) const
 {
-	initializeBasicBlocksPrev();
-	initializeKillGenSets();
-	propagate();
-	initializeDefsAndUses();
+	initializeBasicBlocks(F, fe);
+	initializeBasicBlocksPrev(F, fe);
 
-	LOG << *this << "\n";
-
-	clearInternal();
+	auto srcs = numberSources(fe);
+	auto in = propagate(&F, fe, srcs);
+	initializeDefsAndUses(fe, srcs, in);
 }
 
-void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Module& M)
+/**
+ * Recompute RDA for all the functions in module @a M that were invalidated
+ * since the last update (or were not analyzed yet), and reuse the results for
+ * all the others. Results of functions that are no longer in @a M are dropped.
+ *
+ * Changes are not detected by the analysis itself. Results keep pointers to
+ * instructions, so every change of a function has to be reported by
+ * invalidate() before the next update. Otherwise, the results may refer to
+ * deleted instructions.
+ *
+ * If @a pool is given, functions are analyzed on it in parallel. The results
+ * are the same as if they were computed serially.
+ */
+void ReachingDefinitionsAnalysis::update(
+		llvm::Module& M,
+		Abi* abi,
+		bool trackFlagRegs,
+		utils::ThreadPool* pool)
 {
+	setParameters(M, abi, trackFlagRegs);
+
+	std::vector<Function*> fncs;
 	for (Function& F : M)
 	{
-		initializeBasicBlocks(F);
+		fncs.push_back(&F);
+	}
+	std::set<const Function*> fncSet(fncs.begin(), fncs.end());
+	for (auto it = fncMap.begin(); it != fncMap.end();)
+	{
+		it = fncSet.count(it->first) ? std::next(it) : fncMap.erase(it);
+	}
+	for (auto it = _upToDate.begin(); it != _upToDate.end();)
+	{
+		it = fncSet.count(*it) ? std::next(it) : _upToDate.erase(it);
+	}
+
+	// Entries are created serially, only their contents are computed in
+	// parallel.
+	//
+	std::vector<std::pair<Function*, FunctionEntry*>> toRun;
+	for (std::size_t i = 0; i < fncs.size(); ++i)
+	{
+		if (_upToDate.count(fncs[i]))
+		{
+			++_cacheStatistics.hits;
+			continue;
+		}
+
+		if (auto* fe = resetFunctionEntry(*fncs[i]))
+		{
+			toRun.emplace_back(fncs[i], fe);
+		}
+		_upToDate.insert(fncs[i]);
+		++_cacheStatistics.recomputes;
+	}
+
+	parallelFor(pool, toRun.size(), [&](std::size_t i)
+	{
+		run(*toRun[i].first, *toRun[i].second);
+	});
+
+	_run = true;
+}
+
+/**
+ * Same as @c update(llvm::Module&, Abi*, bool, utils::ThreadPool*) but only
+ * function @a F is checked. Results of other functions are kept as they are.
+ */
+void ReachingDefinitionsAnalysis::update(
+		llvm::Function& F,
+		Abi* abi,
+		bool trackFlagRegs)
+{
+	setParameters(*F.getParent(), abi, trackFlagRegs);
+	updateFunction(F);
+
+	_run = true;
+}
+
+/**
+ * Make the next update() recompute RDA for function @a F.
+ * The current results are kept until then, so they can still be used by the
+ * pass that changed @a F.
+ */
+void ReachingDefinitionsAnalysis::invalidate(const llvm::Function* F)
+{
+	if (_upToDate.erase(F))
+	{
+		++_cacheStatistics.invalidations;
+	}
+}
+
+/**
+ * Make the next update() recompute RDA for all the functions. This has to be
+ * used after changes that are not reported function by function (e.g. by
+ * passes that do not know about this analysis) and before a function is
+ * deleted.
+ */
+void ReachingDefinitionsAnalysis::invalidateAll()
+{
+	_cacheStatistics.invalidations += _upToDate.size();
+	_upToDate.clear();
+}
+
+const ReachingDefinitionsAnalysis::CacheStatistics&
+ReachingDefinitionsAnalysis::getCacheStatistics() const
+{
+	return _cacheStatistics;
+}
+
+/**
+ * Set parameters of the analysis. If they differ from the parameters used to
+ * compute the current results, the results are dropped.
+ */
+void ReachingDefinitionsAnalysis::setParameters(
+		llvm::Module& M,
+		Abi* abi,
+		bool trackFlagRegs)
+{
+	auto* specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(&M);
+	if (_abi != abi
+			|| _trackFlagRegs != trackFlagRegs
+			|| _specialGlobal != specialGlobal)
+	{
+		clear();
+	}
+
+	_trackFlagRegs = trackFlagRegs;
+	_abi = abi;
+	_specialGlobal = specialGlobal;
+}
+
+void ReachingDefinitionsAnalysis::updateFunction(llvm::Function& F)
+{
+	if (_upToDate.count(&F))
+	{
+		++_cacheStatistics.hits;
+		return;
+	}
+
+	if (auto* fe = resetFunctionEntry(F))
+	{
+		run(F, *fe);
 	}
+
+	_upToDate.insert(&F);
+	++_cacheStatistics.recomputes;
 }
 
-void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
+/**
+ * Drop results of function @a F and create an empty entry for its new ones.
+ * @return Created entry, or @c nullptr if @a F is only a declaration.
+ */
+FunctionEntry* ReachingDefinitionsAnalysis::resetFunctionEntry(
+		llvm::Function& F)
+{
+	fncMap.erase(&F);
+	return F.isDeclaration() ? nullptr : &fncMap[&F];
+}
+
+/**
+ * Collect definitions and uses of function @a F into @a fe.
+ */
+void ReachingDefinitionsAnalysis::initializeBasicBlocks(
+		llvm::Function& F,
+		FunctionEntry& fe) const
 {
 	for (BasicBlock& B : F)
 	{
-		BasicBlockEntry bbe(&B, bbMap.size());
+		BasicBlockEntry bbe(&B, fe.bbs.size());
+		bbe.defsBegin = fe.defs.size();
+		bbe.usesBegin = fe.uses.size();
 
 		int insnPos = -1;
 		for (Instruction& I : B)
@@ -113,7 +528,7 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 					continue;
 				}
 
-				bbe.uses.push_back(Use(l, l->getPointerOperand(), insnPos));
+				fe.uses.push_back(Use(l, l->getPointerOperand(), insnPos));
 			}
 			else if (auto* p2i = dyn_cast<PtrToIntInst>(&I))
 			{
@@ -129,7 +544,7 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 					continue;
 				}
 
-				bbe.uses.push_back(Use(p2i, p2i->getPointerOperand(), insnPos));
+				fe.uses.push_back(Use(p2i, p2i->getPointerOperand(), insnPos));
 			}
 			else if (auto* gep = dyn_cast<GetElementPtrInst>(&I))
 			{
@@ -145,7 +560,7 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 					continue;
 				}
 
-				bbe.uses.push_back(Use(gep, gep->getPointerOperand(), insnPos));
+				fe.uses.push_back(Use(gep, gep->getPointerOperand(), insnPos));
 			}
 			else if (auto* s = dyn_cast<StoreInst>(&I))
 			{
@@ -165,11 +580,11 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 					continue;
 				}
 
-				bbe.defs.push_back(Definition(s, s->getPointerOperand(), insnPos));
+				fe.defs.push_back(Definition(s, s->getPointerOperand(), insnPos));
 			}
 			else if (auto* a = dyn_cast<AllocaInst>(&I))
 			{
-				bbe.defs.push_back(Definition(a, a, insnPos));
+				fe.defs.push_back(Definition(a, a, insnPos));
 			}
 			else if (auto* call = dyn_cast<CallInst>(&I))
 			{
@@ -187,7 +602,7 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 
 					if (isa<AllocaInst>(a) || isa<GlobalVariable>(a))
 					{
-						bbe.uses.push_back(Use(call, a, insnPos));
+						fe.uses.push_back(Use(call, a, insnPos));
 					}
 				}
 
@@ -200,178 +615,64 @@ void ReachingDefinitionsAnalysis::initializeBasicBlocks(llvm::Function& F)
 			}
 		}
 
-		bbMap[&F][&B] = bbe;
+		bbe.defsEnd = fe.defs.size();
+		bbe.usesEnd = fe.uses.size();
+		fe.bbs.push_back(std::move(bbe));
 	}
-}
 
-void ReachingDefinitionsAnalysis::clear()
-{
-	bbMap.clear();
-	_run = false;
-}
-
-bool ReachingDefinitionsAnalysis::wasRun() const
-{
-	return _run;
-}
-
-/**
- * Clear internal structures used to compute RDA, but not needed to use it once
- * it is computed.
- */
-void ReachingDefinitionsAnalysis::clearInternal()
-{
-	for (auto& pair1 : bbMap)
-	for (auto& pair : pair1.second)
-	{
-		BasicBlockEntry& bb = pair.second;
-		bb.defsOut.clear();
-		bb.genDefs.clear();
-		bb.killDefs.clear();
-	}
-}
-
-void ReachingDefinitionsAnalysis::initializeBasicBlocksPrev()
-{
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	for (unsigned i = 0; i < fe.defs.size(); ++i)
 	{
-		auto B = pair.first;
-		auto &entry = pair.second;
-
-		for (auto PI = pred_begin(B), E = pred_end(B); PI != E; ++PI)
-		{
-			auto* pred = *PI;
-			auto p = pair1.second.find(pred);
-
-			assert(p != pair1.second.end() && "we should have all BBs stored in bbMap");
-
-			entry.prevBBs.insert( &p->second );
-		}
+		fe.inst2def.emplace(fe.defs[i].def, i);
 	}
-}
-
-void ReachingDefinitionsAnalysis::initializeKillGenSets()
-{
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
+	for (unsigned i = 0; i < fe.uses.size(); ++i)
 	{
-		pair.second.initializeKillDefSets();
+		fe.inst2use.emplace(fe.uses[i].use, i);
 	}
 }
 
-void ReachingDefinitionsAnalysis::propagate()
+void ReachingDefinitionsAnalysis::clear()
 {
-	for (auto &pair1 : bbMap)
-	{
-		const Function* fnc = pair1.first;
-
-		std::vector<BasicBlockEntry*> workList;
-		workList.reserve(pair1.second.size());
-		ReversePostOrderTraversal<const Function*> RPOT(fnc); // Expensive to create
-		for (auto I = RPOT.begin(); I != RPOT.end(); ++I)
-		{
-			const BasicBlock* bb = *I;
-			auto fIt = pair1.second.find(bb);
-			assert(fIt != pair1.second.end());
-			workList.push_back(&(fIt->second));
-
-			fIt->second.changed = true;
-		}
-
-		bool changed = true;
-		while (changed)
-		{
-			changed = false;
-
-			for (auto* bbe : workList)
-			{
-				changed |= bbe->initDefsOut();
-			}
-		}
-	}
+	fncMap.clear();
+	_upToDate.clear();
+	_run = false;
 }
 
-void ReachingDefinitionsAnalysis::initializeDefsAndUses()
+bool ReachingDefinitionsAnalysis::wasRun() const
 {
-	for (auto &pair1 : bbMap)
-	for (auto& pair : pair1.second)
-	{
-		BasicBlockEntry &bb = pair.second;
-
-		for (Use &u : bb.uses)
-		{
-			for (auto dIt = bb.defs.rbegin(); dIt != bb.defs.rend(); ++dIt)
-			{
-				Definition &d = *dIt;
-
-				if (d.getSource() != u.src)
-				{
-					continue;
-				}
-
-				if (d.dominates(&u))
-				{
-					d.uses.insert(&u);
-					u.defs.insert(&d);
-					break;
-				}
-			}
-
-			if (u.defs.empty())
-			{
-				for (auto p : bb.prevBBs)
-				for (auto d : p->defsOut)
-				{
-					if (d->getSource() == u.src)
-					{
-						d->uses.insert(&u);
-						u.defs.insert(d);
-					}
-				}
-			}
-		}
-	}
+	return _run;
 }
 
-const BasicBlockEntry& ReachingDefinitionsAnalysis::getBasicBlockEntry(
+const FunctionEntry& ReachingDefinitionsAnalysis::getFunctionEntry(
 		const Instruction* I) const
 {
-	auto* F = I->getFunction();
-	auto pair1 = bbMap.find(F);
-	assert(pair1 != bbMap.end() && "we do not have this function in bbMap");
-
-	auto* BB = I->getParent();
-	auto pair = pair1->second.find(BB);
-	assert(pair != pair1->second.end() && "we do not have this basic block in bbMap");
-
-	return pair->second;
+	auto fIt = fncMap.find(I->getFunction());
+	assert(fIt != fncMap.end() && "we do not have this function in fncMap");
+	return fIt->second;
 }
 
 const DefSet& ReachingDefinitionsAnalysis::defsFromUse(const Instruction* I) const
 {
-	return getBasicBlockEntry(I).defsFromUse(I);
+	return getFunctionEntry(I).defsFromUse(I);
 }
 
 const UseSet& ReachingDefinitionsAnalysis::usesFromDef(const Instruction* I) const
 {
-	return getBasicBlockEntry(I).usesFromDef(I);
+	return getFunctionEntry(I).usesFromDef(I);
 }
 
 const Definition* ReachingDefinitionsAnalysis::getDef(const Instruction* I) const
 {
-	return getBasicBlockEntry(I).getDef(I);
+	return getFunctionEntry(I).getDef(I);
 }
 
 const Use* ReachingDefinitionsAnalysis::getUse(const Instruction* I) const
 {
-	return getBasicBlockEntry(I).getUse(I);
+	return getFunctionEntry(I).getUse(I);
 }
 
 std::ostream& operator<<(std::ostream& out, const ReachingDefinitionsAnalysis& rda)
 {
-	for (auto &pair1 : rda.bbMap)
-	for (auto& pair : pair1.second)
+	for (auto& pair : rda.fncMap)
 	{
 		out << pair.second;
 	}
@@ -380,63 +681,82 @@ std::ostream& operator<<(std::ostream& out, const ReachingDefinitionsAnalysis& r
 
 //
 //=============================================================================
-//  BasicBlockEntry
+//  FunctionEntry
 //=============================================================================
 //
 
-BasicBlockEntry::BasicBlockEntry(const llvm::BasicBlock* b, std::size_t _id) :
-	bb(b),
-	id(_id)
+const DefSet& FunctionEntry::defsFromUse(const Instruction* I) const
+{
+	static DefSet emptyDefSet;
+	auto* u = getUse(I);
+	return u ? u->defs : emptyDefSet;
+}
+
+const UseSet& FunctionEntry::usesFromDef(const Instruction* I) const
 {
+	static UseSet emptyUseSet;
+	auto* d = getDef(I);
+	return d ? d->uses : emptyUseSet;
+}
 
+const Definition* FunctionEntry::getDef(const Instruction* I) const
+{
+	auto fIt = inst2def.find(I);
+	return fIt != inst2def.end() ? &defs[fIt->second] : nullptr;
 }
 
-void BasicBlockEntry::initializeKillDefSets()
+const Use* FunctionEntry::getUse(const Instruction* I) const
 {
-	killDefs.clear();
-	genDefs.clear();
+	auto fIt = inst2use.find(I);
+	return fIt != inst2use.end() ? &uses[fIt->second] : nullptr;
+}
 
-	for (auto dIt = defs.rbegin(); dIt != defs.rend(); ++dIt)
+std::ostream& operator<<(std::ostream& out, const FunctionEntry& fe)
+{
+	for (auto& bbe : fe.bbs)
 	{
-		Definition& d = *dIt;
+		out << "Basic Block = " << bbe.getName() << "\n";
 
-		bool added = (killDefs.insert(d.getSource())).second;
-		if (added)
+		out << "\n\tPrev:\n";
+		for (auto prev : bbe.prevBBs)
 		{
-			genDefs.insert(&d);
+			out << "\t\t" << fe.bbs[prev].getName() << "\n";
 		}
-	}
-}
 
-/**
- * REACH_in[B] = Sum (p in pred[B]) (REACH_out[p])
- * REACH_out[B] = GEN[B] + ( REACH_in[B] - KILL[B] )
- */
-Changed BasicBlockEntry::initDefsOut()
-{
-	auto oldSz = defsOut.size();
+		out << "\n\tDef:\n";
+		for (unsigned i = bbe.defsBegin; i < bbe.defsEnd; ++i)
+		{
+			out << "\t\t" << llvmObjToString(fe.defs[i].def) << "\n";
 
-	if (defsOut.empty() && !genDefs.empty())
-	{
-		defsOut = std::move(genDefs);
-	}
+			for (auto u : fe.defs[i].uses)
+				out << "\t\t\t" << llvmObjToString(u->use) << "\n";
+		}
 
-	for (auto* p : prevBBs)
-	{
-		if (p->changed)
+		out << "\n\tUses:\n";
+		for (unsigned i = bbe.usesBegin; i < bbe.usesEnd; ++i)
 		{
-			for (auto* d : p->defsOut)
-			{
-				if (killDefs.find(d->getSource()) == killDefs.end())
-				{
-					defsOut.insert(d);
-				}
-			}
+			out << "\t\t" << llvmObjToString(fe.uses[i].use) << "\n";
+
+			for (auto d : fe.uses[i].defs)
+				out << "\t\t\t" << llvmObjToString(d->def) << "\n";
 		}
+
+		out << "\n";
 	}
+	return out;
+}
+
+//
+//=============================================================================
+//  BasicBlockEntry
+//=============================================================================
+//
+
+BasicBlockEntry::BasicBlockEntry(const llvm::BasicBlock* b, std::size_t _id) :
+	bb(b),
+	id(_id)
+{
 
-	changed = oldSz != defsOut.size();
-	return changed;
 }
 
 std::string BasicBlockEntry::getName() const
@@ -450,70 +770,6 @@ std::string BasicBlockEntry::getName() const
 	return out.str();
 }
 
-const DefSet& BasicBlockEntry::defsFromUse(const Instruction* I) const
-{
-	static DefSet emptyDefSet;
-	auto* u = getUse(I);
-	return u ? u->defs : emptyDefSet;
-}
-
-const UseSet& BasicBlockEntry::usesFromDef(const Instruction* I) const
-{
-	static UseSet emptyUseSet;
-	auto* d = getDef(I);
-	return d ? d->uses : emptyUseSet;
-}
-
-const Definition* BasicBlockEntry::getDef(const Instruction* I) const
-{
-	auto dIt = find(
-			defs.begin(),
-			defs.end(),
-			Definition(const_cast<Instruction*>(I), nullptr, 0));
-	return dIt != defs.end() ? &(*dIt) : nullptr;
-}
-
-const Use* BasicBlockEntry::getUse(const Instruction* I) const
-{
-	auto uIt = find(
-			uses.begin(),
-			uses.end(),
-			Use(const_cast<Instruction*>(I), nullptr, 0));
-	return uIt != uses.end() ? &(*uIt) : nullptr;
-}
-
-std::ostream& operator<<(std::ostream& out, const BasicBlockEntry& bbe)
-{
-	out << "Basic Block = " << bbe.getName() << "\n";
-
-	out << "\n\tPrev:\n";
-	for (auto prev : bbe.prevBBs)
-	{
-		out << "\t\t" << prev->getName() << "\n";
-	}
-
-	out << "\n\tDef:\n";
-	for (auto d : bbe.defs)
-	{
-		out << "\t\t" << llvmObjToString(d.def) << "\n";
-
-		for (auto u : d.uses)
-			out << "\t\t\t" << llvmObjToString(u->use) << "\n";
-	}
-
-	out << "\n\tUses:\n";
-	for (auto u : bbe.uses)
-	{
-		out << "\t\t" << llvmObjToString(u.use) << "\n";
-
-		for (auto d : u.defs)
-			out << "\t\t\t" << llvmObjToString(d->def) << "\n";
-	}
-
-	out << "\n";
-	return out;
-}
-
 //
 //=============================================================================
 //  Definition
@@ -14,6 +14,7 @@
 #include "retdec/utils/string.h"
 #include "retdec/bin2llvmir/analyses/symbolic_tree.h"
 #include "retdec/bin2llvmir/utils/llvm.h"
+#include "retdec/bin2llvmir/providers/abi/abi.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/utils/debug.h"
@@ -210,7 +211,7 @@ void SymbolicTree::expandNode(
 // TODO!!! replace with invalid tree
 				ops.emplace_back(
 						RDA,
-						UndefValue::get(l->getType()),
+						getUndefValue(l->getType()),
 						l,
 						getLevel() + 1,
 						maxNodeLevel,
@@ -239,7 +240,7 @@ void SymbolicTree::expandNode(
 // TODO!!! replace with invalid tree
 				ops.emplace_back(
 						RDA,
-						UndefValue::get(l->getType()),
+						getUndefValue(l->getType()),
 						l,
 						getLevel() + 1,
 						maxNodeLevel,
@@ -405,7 +406,7 @@ void SymbolicTree::_simplifyNode()
 					&load)))
 	{
 		auto addr = AsmInstruction::getFunctionAddress(load->getFunction());
-		value = ConstantInt::get(load->getType(), addr);
+		value = getConstantInt(load->getType(), addr);
 		ops.clear();
 	}
 	else if (match(*this, m_Load(m_GlobalVariable(global), &load))
@@ -422,28 +423,28 @@ void SymbolicTree::_simplifyNode()
 	}
 	else if (match(*this, m_Add(m_ConstantInt(c1), m_ConstantInt(c2))))
 	{
-		value = ConstantInt::get(
+		value = getConstantInt(
 				c1->getType(),
 				c1->getSExtValue() + c2->getSExtValue());
 		ops.clear();
 	}
 	else if (match(*this, m_Sub(m_ConstantInt(c1), m_ConstantInt(c2))))
 	{
-		value = ConstantInt::get(
+		value = getConstantInt(
 				c1->getType(),
 				c1->getSExtValue() - c2->getSExtValue());
 		ops.clear();
 	}
 	else if (match(*this, m_Or(m_ConstantInt(c1), m_ConstantInt(c2))))
 	{
-		value = ConstantInt::get(
+		value = getConstantInt(
 				c1->getType(),
 				c1->getSExtValue() | c2->getSExtValue());
 		ops.clear();
 	}
 	else if (match(*this, m_And(m_ConstantInt(c1), m_ConstantInt(c2))))
 	{
-		value = ConstantInt::get(
+		value = getConstantInt(
 				c1->getType(),
 				c1->getSExtValue() & c2->getSExtValue());
 		ops.clear();
@@ -454,7 +455,7 @@ void SymbolicTree::_simplifyNode()
 	{
 		if (auto addr = _config->getGlobalAddress(global))
 		{
-			value = ConstantInt::get(c1->getType(), addr + c1->getSExtValue());
+			value = getConstantInt(c1->getType(), addr + c1->getSExtValue());
 			ops.clear();
 		}
 	}
@@ -473,7 +474,7 @@ void SymbolicTree::_simplifyNode()
 			m_ConstantInt(c2))))
 	{
 		ops[0] = std::move(ops[0].ops[0]);
-		ops[1].value = ConstantInt::get(
+		ops[1].value = getConstantInt(
 				c1->getType(),
 				c1->getSExtValue() + c2->getSExtValue());
 	}
@@ -516,6 +517,7 @@ void SymbolicTree::solveMemoryLoads(FileImage* image)
 		auto* sec = seg ? seg->getSecSeg() : nullptr;
 		if (seg && (sec == nullptr || !sec->isBss()))
 		{
+			auto lock = lockLlvmContext();
 			auto* res = image->getConstantInt(t, ci->getZExtValue());
 			if (res)
 			{
@@ -634,6 +636,37 @@ std::vector<SymbolicTree*> SymbolicTree::getLevelOrder() const
 	return ret;
 }
 
+/**
+ * Same as @c llvm::UndefValue::get(), but guarded by the LLVM context mutex
+ * of the configuration (if any).
+ */
+llvm::Constant* SymbolicTree::getUndefValue(llvm::Type* t)
+{
+	auto lock = lockLlvmContext();
+	return UndefValue::get(t);
+}
+
+/**
+ * Same as @c llvm::ConstantInt::get(), but guarded by the LLVM context mutex
+ * of the configuration (if any).
+ */
+llvm::Constant* SymbolicTree::getConstantInt(llvm::Type* t, uint64_t v)
+{
+	auto lock = lockLlvmContext();
+	return ConstantInt::get(t, v);
+}
+
+/**
+ * Lock the LLVM context mutex of the configuration.
+ * @return Lock that owns the mutex, or an empty lock if there is no mutex.
+ */
+std::unique_lock<std::mutex> SymbolicTree::lockLlvmContext()
+{
+	return _llvmContextMutex
+			? std::unique_lock<std::mutex>(*_llvmContextMutex)
+			: std::unique_lock<std::mutex>();
+}
+
 void SymbolicTree::_getPreOrder(std::vector<SymbolicTree*>& res) const
 {
 	res.emplace_back(const_cast<SymbolicTree*>(this));
@@ -699,22 +732,77 @@ bool SymbolicTree::isNary(unsigned N) const
 //==============================================================================
 //
 
-Abi* SymbolicTree::_abi = nullptr;
-Config* SymbolicTree::_config = nullptr;
-bool SymbolicTree::_val2valUsed = false;
-bool SymbolicTree::_trackThroughAllocaLoads = true;
-bool SymbolicTree::_trackThroughGeneralRegisterLoads = true;
-bool SymbolicTree::_trackOnlyFlagRegisters = false;
-bool SymbolicTree::_simplifyAtCreation = true;
-unsigned SymbolicTree::_naryLimit = 3;
+thread_local Abi* SymbolicTree::_abi = nullptr;
+thread_local Config* SymbolicTree::_config = nullptr;
+thread_local bool SymbolicTree::_val2valUsed = false;
+thread_local bool SymbolicTree::_trackThroughAllocaLoads = true;
+thread_local bool SymbolicTree::_trackThroughGeneralRegisterLoads = true;
+thread_local bool SymbolicTree::_trackOnlyFlagRegisters = false;
+thread_local bool SymbolicTree::_simplifyAtCreation = true;
+thread_local unsigned SymbolicTree::_naryLimit = 3;
+thread_local std::mutex* SymbolicTree::_llvmContextMutex = nullptr;
 
+/**
+ * Reset the global configuration of the calling thread.
+ */
 void SymbolicTree::clear()
 {
 	_abi = nullptr;
 	_config = nullptr;
+	_llvmContextMutex = nullptr;
 	setToDefaultConfiguration();
 }
 
+/**
+ * Reset the global configuration of the calling thread if it was set up for
+ * the module @a m. Configurations of other modules are kept untouched.
+ *
+ * This has to be called before ABI and config of @a m are removed from their
+ * providers, because they are used to recognize the module.
+ */
+void SymbolicTree::clear(llvm::Module* m)
+{
+	if ((_abi && _abi == AbiProvider::getAbi(m))
+			|| (_config && _config == ConfigProvider::getConfig(m)))
+	{
+		clear();
+	}
+}
+
+/**
+ * Get the global configuration of the calling thread.
+ */
+SymbolicTree::Configuration SymbolicTree::getConfiguration()
+{
+	Configuration c;
+	c.abi = _abi;
+	c.config = _config;
+	c.val2valUsed = _val2valUsed;
+	c.trackThroughAllocaLoads = _trackThroughAllocaLoads;
+	c.trackThroughGeneralRegisterLoads = _trackThroughGeneralRegisterLoads;
+	c.trackOnlyFlagRegisters = _trackOnlyFlagRegisters;
+	c.simplifyAtCreation = _simplifyAtCreation;
+	c.naryLimit = _naryLimit;
+	c.llvmContextMutex = _llvmContextMutex;
+	return c;
+}
+
+/**
+ * Set the global configuration of the calling thread to @a c.
+ */
+void SymbolicTree::setConfiguration(const Configuration& c)
+{
+	_abi = c.abi;
+	_config = c.config;
+	_val2valUsed = c.val2valUsed;
+	_trackThroughAllocaLoads = c.trackThroughAllocaLoads;
+	_trackThroughGeneralRegisterLoads = c.trackThroughGeneralRegisterLoads;
+	_trackOnlyFlagRegisters = c.trackOnlyFlagRegisters;
+	_simplifyAtCreation = c.simplifyAtCreation;
+	_naryLimit = c.naryLimit;
+	_llvmContextMutex = c.llvmContextMutex;
+}
+
 void SymbolicTree::setToDefaultConfiguration()
 {
 	_val2valUsed = false;
@@ -8,6 +8,8 @@
 #include "retdec/bin2llvmir/optimizations/asm_inst_remover/asm_inst_remover.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
 #include "retdec/bin2llvmir/providers/names.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
+#include "retdec/capstone2llvmir/retained_insn.h"
 
 using namespace llvm;
 
@@ -76,10 +78,7 @@ bool AsmInstructionRemover::run(Module& M)
 	// Free Capstone instructions.
 	//
 	auto& insnMap = AsmInstruction::getLlvmToCapstoneInsnMap(&M);
-	for (auto& p : insnMap)
-	{
-		cs_free(p.second, 1);
-	}
+	insnMap.forEach(capstone2llvmir::freeRetainedInsn);
 	insnMap.clear();
 
 	// Remove special global variable.
@@ -95,6 +94,11 @@ bool AsmInstructionRemover::run(Module& M)
 		}
 	}
 
+	// Shared RDA results were computed with the special global variable, so
+	// they are obsolete now.
+	//
+	ReachingDefinitionsProvider::clear(&M);
+
 	return changed;
 }
 
@@ -12,6 +12,7 @@
 
 #include "retdec/bin2llvmir/analyses/symbolic_tree.h"
 #include "retdec/bin2llvmir/optimizations/cond_branch_opt/cond_branch_opt.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
 #define debug_enabled false
 #include "retdec/bin2llvmir/utils/debug.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
@@ -63,8 +64,7 @@ bool CondBranchOpt::run()
 
 	bool changed = false;
 
-	ReachingDefinitionsAnalysis RDA;
-	RDA.runOnModule(*_module, _abi, true);
+	auto& RDA = ReachingDefinitionsProvider::getAnalysis(_module, _abi, true);
 
 	SymbolicTree::setTrackThroughAllocaLoads(false);
 	SymbolicTree::setTrackOnlyFlagRegisters(true);
@@ -75,7 +75,11 @@ bool CondBranchOpt::run()
 		Instruction& insn = *it;
 		++it;
 
-		changed |= runOnInstruction(RDA, insn);
+		if (runOnInstruction(RDA, insn))
+		{
+			ReachingDefinitionsProvider::invalidate(&f);
+			changed = true;
+		}
 	}
 
 	SymbolicTree::setToDefaultConfiguration();
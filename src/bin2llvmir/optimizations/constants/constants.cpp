@@ -22,6 +22,7 @@
 #include "retdec/bin2llvmir/analyses/symbolic_tree.h"
 #include "retdec/bin2llvmir/optimizations/constants/constants.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
 const bool debug_enabled = false;
 #include "retdec/bin2llvmir/utils/llvm.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
@@ -74,8 +75,7 @@ bool ConstantsAnalysis::runOnModuleCustom(
 
 bool ConstantsAnalysis::run()
 {
-	ReachingDefinitionsAnalysis RDA;
-	RDA.runOnModule(*_module, _abi);
+	auto& RDA = ReachingDefinitionsProvider::getAnalysis(_module, _abi);
 
 	for (Function& f : *_module)
 	for (inst_iterator I = inst_begin(&f), E = inst_end(&f); I != E;)
@@ -145,6 +145,8 @@ void ConstantsAnalysis::checkForGlobalInInstruction(
 
 		if (ngv)
 		{
+			ReachingDefinitionsProvider::invalidate(inst->getFunction());
+
 			if (max == &root)
 			{
 				auto* conv = IrModifier::convertConstantToType(ngv, val->getType());
@@ -164,6 +166,7 @@ void ConstantsAnalysis::checkForGlobalInInstruction(
 	auto* gv = dyn_cast<GlobalVariable>(root.value);
 	if (isa<LoadInst>(inst) && gv && root.ops.size() <= 1)
 	{
+		ReachingDefinitionsProvider::invalidate(inst->getFunction());
 		auto* conv = IrModifier::convertConstantToType(gv, val->getType());
 		_toRemove.insert(val);
 		inst->replaceUsesOfWith(val, conv);
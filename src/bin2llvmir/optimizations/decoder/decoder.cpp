@@ -11,6 +11,7 @@
 #include "retdec/utils/string.h"
 #include "retdec/utils/io/log.h"
 #include "retdec/bin2llvmir/optimizations/decoder/decoder.h"
+#include "retdec/bin2llvmir/providers/thread_pool.h"
 #include "retdec/bin2llvmir/utils/llvm.h"
 #include "retdec/bin2llvmir/utils/capstone.h"
 
@@ -112,6 +113,7 @@ bool Decoder::run()
 	LOG << _ranges << std::endl;
 	LOG << _jumpTargets << std::endl;
 
+	disassemble();
 	decode();
 
 	if (debug_enabled && fs::exists(_config->getOutputDirectory()))
@@ -141,6 +143,39 @@ bool Decoder::run()
 	return false;
 }
 
+/**
+ * If there is a thread pool for the module, disassemble code reachable from
+ * the jump targets and ranges to decode on it in advance. Then, decode()
+ * only translates the disassembled instructions. The disassembly runs ahead
+ * of the translation by a limited number of instructions, and it continues
+ * on the pool while decode() takes them.
+ */
+void Decoder::disassemble()
+{
+	auto* pool = ThreadPoolProvider::getThreadPool(_module);
+	if (pool == nullptr)
+	{
+		return;
+	}
+
+	std::vector<Disassembly::Start> starts;
+	for (auto& jt : _jumpTargets._data)
+	{
+		starts.emplace_back(jt.getAddress(), jt.getMode());
+	}
+	for (auto& r : _ranges.getPrimaryRanges())
+	{
+		starts.emplace_back(r.getStart(), _c2l->getBasicMode());
+	}
+
+	_disassembly.run(*pool, *_c2l, _image, _ranges, starts);
+
+	LOG << "\n" << "disassemble(): "
+			<< _disassembly.getInstructionCount() << " instructions in "
+			<< _disassembly.getBasicBlockCount() << " basic blocks"
+			<< std::endl;
+}
+
 void Decoder::decode()
 {
 	LOG << "\n" << "decode():" << std::endl;
@@ -152,6 +187,8 @@ void Decoder::decode()
 		decodeJumpTarget(jt);
 	}
 
+	_disassembly.clear();
+
 	if (!_somethingDecoded)
 	{
 		throw std::runtime_error("No instructions were decoded");
@@ -320,7 +357,7 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 		}
 		_somethingDecoded = true;
 
-		_llvm2capstone->emplace(res.llvmInsn, res.capstoneInsn);
+		_llvm2capstone->add(res.capstoneInsn);
 
 		bbEnd |= getJumpTargetsFromInstruction(oldAddr, res, bytes.second);
 		bbEnd |= instructionBreaksBasicBlock(oldAddr, res);
@@ -338,6 +375,13 @@ void Decoder::decodeJumpTarget(const JumpTarget& jt)
 capstone2llvmir::Capstone2LlvmIrTranslator::TranslationResultOne
 Decoder::translate(ByteData& bytes, common::Address& addr, llvm::IRBuilder<>& irb)
 {
+	if (auto* insn = _disassembly.take(addr, _c2l->getBasicMode(), bytes.second))
+	{
+		bytes.first += insn->size;
+		bytes.second -= insn->size;
+		return _c2l->translateOne(insn, addr, irb);
+	}
+
 	auto res = _c2l->translateOne(bytes.first, bytes.second, addr, irb);
 
 	// MIPS 64-bit mode can decompile more instructions than the 32-bit mode.
@@ -1356,7 +1400,7 @@ void Decoder::handleDelaySlotTypical(
 		{
 			break;
 		}
-		_llvm2capstone->emplace(r.llvmInsn, r.capstoneInsn);
+		_llvm2capstone->add(r.capstoneInsn);
 	}
 
 	irb.SetInsertPoint(oldIp);
@@ -1413,7 +1457,7 @@ void Decoder::handleDelaySlotLikely(
 			{
 				break;
 			}
-			_llvm2capstone->emplace(res.llvmInsn, res.capstoneInsn);
+			_llvm2capstone->add(res.capstoneInsn);
 		}
 
 		_likelyBb2Target.emplace(newBb, target);
@@ -165,6 +165,11 @@ bool RangesToDecode::alternativeEmpty() const
 	return _alternativeRanges.empty();
 }
 
+const common::AddressRangeContainer& RangesToDecode::getPrimaryRanges() const
+{
+	return _primaryRanges;
+}
+
 const common::AddressRange& RangesToDecode::primaryFront() const
 {
 	return *_primaryRanges.begin();
@@ -0,0 +1,394 @@
+/**
+* @file src/bin2llvmir/optimizations/decoder/disassembly.cpp
+* @brief Parallel disassembly of the input binary ahead of its translation.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <optional>
+
+#include "retdec/bin2llvmir/optimizations/decoder/disassembly.h"
+
+using namespace retdec::common;
+
+namespace retdec {
+namespace bin2llvmir {
+
+namespace {
+
+/**
+ * @return The last immediate operand from the given @a ops, if there is any.
+ */
+template<typename Op, typename OpType>
+std::optional<Address> getLastImmediate(
+		const Op* ops,
+		std::size_t count,
+		OpType immType)
+{
+	for (std::size_t i = count; i > 0; --i)
+	{
+		if (ops[i-1].type == immType)
+		{
+			return Address(ops[i-1].imm);
+		}
+	}
+	return std::nullopt;
+}
+
+/**
+ * @return Target of a direct control flow instruction @a insn, or nothing if
+ *         @a insn is indirect.
+ */
+std::optional<Address> getDirectTarget(cs_arch arch, const cs_insn* insn)
+{
+	auto* d = insn->detail;
+	switch (arch)
+	{
+		case CS_ARCH_X86:
+			return getLastImmediate(d->x86.operands, d->x86.op_count, X86_OP_IMM);
+		case CS_ARCH_ARM:
+			return getLastImmediate(d->arm.operands, d->arm.op_count, ARM_OP_IMM);
+		case CS_ARCH_ARM64:
+			return getLastImmediate(
+					d->arm64.operands,
+					d->arm64.op_count,
+					ARM64_OP_IMM);
+		case CS_ARCH_MIPS:
+			return getLastImmediate(
+					d->mips.operands,
+					d->mips.op_count,
+					MIPS_OP_IMM);
+		case CS_ARCH_PPC:
+			return getLastImmediate(d->ppc.operands, d->ppc.op_count, PPC_OP_IMM);
+		default:
+			return std::nullopt;
+	}
+}
+
+} // anonymous namespace
+
+Disassembly::~Disassembly()
+{
+	clear();
+	closeHandles();
+}
+
+/**
+ * Disassemble code reachable from @a starts on @a pool. Only the parts of
+ * @a ranges in @a image are disassembled. @a c2l is used only to get the
+ * architecture and to classify instructions, it is not modified. The
+ * classification does not depend on the basic mode of @a c2l, so @a c2l may
+ * translate instructions while the disassembly continues.
+ *
+ * The function returns when all the reachable code was disassembled, or when
+ * there are @a maxInstructions instructions which were not taken yet. The
+ * rest is disassembled on @a pool as the instructions are taken, so @a pool
+ * must exist until clear() is called.
+ */
+void Disassembly::run(
+		utils::ThreadPool& pool,
+		const capstone2llvmir::Capstone2LlvmIrTranslator& c2l,
+		FileImage* image,
+		const RangesToDecode& ranges,
+		const std::vector<Start>& starts,
+		std::size_t maxInstructions)
+{
+	_pool = &pool;
+	_c2l = &c2l;
+	_arch = c2l.getArchitecture();
+	_extraMode = c2l.getExtraMode();
+	_image = image;
+	_ranges = &ranges;
+	_maxInstructions = maxInstructions;
+
+	for (auto& s : starts)
+	{
+		submitBasicBlock(s);
+	}
+	_pool->wait();
+}
+
+/**
+ * Take the instruction disassembled at address @a a in mode @a m.
+ * @return Instruction owned by the caller from now on (allocated by
+ *         capstone2llvmir::retainInsn()), or @c nullptr if there is no such
+ *         instruction (yet), or if it is larger than @a maxSize.
+ *
+ * When half of the retained instructions are taken, the deferred basic
+ * blocks are submitted to the pool.
+ */
+cs_insn* Disassembly::take(Address a, cs_mode m, std::size_t maxSize)
+{
+	cs_insn* insn = nullptr;
+	std::vector<Start> resumed;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		auto it = _insns.find({a, m});
+		if (it == _insns.end() || it->second->size > maxSize)
+		{
+			return nullptr;
+		}
+
+		insn = it->second;
+		_insns.erase(it);
+
+		if (!_deferred.empty() && _insns.size() <= _maxInstructions / 2)
+		{
+			resumed.swap(_deferred);
+		}
+	}
+
+	for (auto& s : resumed)
+	{
+		submitTask(s);
+	}
+	return insn;
+}
+
+/**
+ * Stop the disassembly running on the pool, and free all the instructions
+ * that were not taken.
+ */
+void Disassembly::clear()
+{
+	if (_pool)
+	{
+		_stopping = true;
+		_pool->wait();
+		_stopping = false;
+		_pool = nullptr;
+	}
+	closeHandles();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	for (auto& p : _insns)
+	{
+		capstone2llvmir::freeRetainedInsn(p.second);
+	}
+	_insns.clear();
+	_deferred.clear();
+	_bbs.clear();
+	_insnCount = 0;
+}
+
+/**
+ * @return Number of instructions disassembled by run().
+ */
+std::size_t Disassembly::getInstructionCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _insnCount;
+}
+
+/**
+ * @return Number of basic blocks disassembled (or deferred) by run().
+ */
+std::size_t Disassembly::getBasicBlockCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _bbs.size();
+}
+
+/**
+ * Disassemble a basic block from @a start and submit its successors.
+ * Calls do not end basic blocks, but their targets are submitted as well.
+ */
+void Disassembly::disassembleBasicBlock(const Start& start)
+{
+	if (_stopping)
+	{
+		return;
+	}
+
+	auto* range = _ranges->get(start.first);
+	auto bytes = _image->getImage()->getRawSegmentData(start.first);
+	if (range == nullptr || bytes.first == nullptr)
+	{
+		return;
+	}
+
+	csh h = acquireHandle(start.second);
+	if (h == 0)
+	{
+		return;
+	}
+
+	const std::uint8_t* code = bytes.first;
+	std::size_t size = std::min<std::uint64_t>(
+			bytes.second,
+			range->getEnd() - start.first);
+	std::uint64_t address = start.first;
+
+	// Instructions are decoded into the scratch instruction and only their
+	// compact copies are kept.
+	cs_insn* insn = cs_malloc(h);
+	std::vector<cs_insn*> insns;
+	std::vector<Start> successors;
+	bool fallThrough = false;
+	std::size_t delaySlots = 0;
+	bool inDelaySlot = false;
+	while (size > 0)
+	{
+		if (!cs_disasm_iter(h, &code, &size, &address, insn))
+		{
+			break;
+		}
+		insns.push_back(
+				capstone2llvmir::retainInsn(_arch, insn));
+
+		if (inDelaySlot)
+		{
+			if (--delaySlots == 0)
+			{
+				break;
+			}
+			continue;
+		}
+
+		bool call = cs_insn_group(h, insn, CS_GRP_CALL)
+				|| _c2l->isCallInstruction(*insn);
+		bool ret = cs_insn_group(h, insn, CS_GRP_RET)
+				|| cs_insn_group(h, insn, CS_GRP_IRET)
+				|| _c2l->isReturnInstruction(*insn);
+		bool jump = cs_insn_group(h, insn, CS_GRP_JUMP)
+				|| _c2l->isBranchInstruction(*insn)
+				|| _c2l->isCondBranchInstruction(*insn);
+
+		if ((call || jump) && !ret)
+		{
+			if (auto t = getDirectTarget(_arch, insn))
+			{
+				successors.emplace_back(*t, start.second);
+			}
+		}
+		if (call || !(jump || ret))
+		{
+			continue;
+		}
+
+		// Only some architectures recognize unconditional branches, so any
+		// other branch may fall through.
+		//
+		fallThrough = jump && !ret && !_c2l->isBranchInstruction(*insn);
+		delaySlots = _c2l->hasDelaySlot(insn->id)
+				? _c2l->getDelaySlot(insn->id)
+				: 0;
+		if (delaySlots == 0)
+		{
+			break;
+		}
+		inDelaySlot = true;
+	}
+	if (fallThrough)
+	{
+		successors.emplace_back(address, start.second);
+	}
+
+	cs_free(insn, 1);
+	releaseHandle(start.second, h);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_insnCount += insns.size();
+		for (cs_insn* i : insns)
+		{
+			// The same instruction might have been disassembled by a block
+			// that jumps into the middle of this one.
+			if (!_insns.emplace(Start(i->address, start.second), i).second)
+			{
+				capstone2llvmir::freeRetainedInsn(i);
+			}
+		}
+	}
+
+	for (auto& s : successors)
+	{
+		submitBasicBlock(s);
+	}
+}
+
+/**
+ * Submit basic block @a start for disassembly if it was not submitted yet.
+ * If there are too many instructions which were not taken, the block is
+ * deferred.
+ */
+void Disassembly::submitBasicBlock(const Start& start)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!start.first.isDefined() || !_bbs.insert(start).second)
+		{
+			return;
+		}
+		if (_insns.size() >= _maxInstructions)
+		{
+			_deferred.push_back(start);
+			return;
+		}
+	}
+
+	submitTask(start);
+}
+
+void Disassembly::submitTask(const Start& start)
+{
+	_pool->submit([this, start]()
+	{
+		disassembleBasicBlock(start);
+	});
+}
+
+/**
+ * Get a Capstone handle in mode @a m that is not used by any other thread.
+ * @return The handle, or @c 0 if it could not be opened.
+ */
+csh Disassembly::acquireHandle(cs_mode m)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		auto& handles = _freeHandles[m];
+		if (!handles.empty())
+		{
+			csh h = handles.back();
+			handles.pop_back();
+			return h;
+		}
+	}
+
+	csh h = 0;
+	auto mode = static_cast<cs_mode>(m + _extraMode);
+	if (cs_open(_arch, mode, &h) != CS_ERR_OK)
+	{
+		return 0;
+	}
+	if (cs_option(h, CS_OPT_DETAIL, CS_OPT_ON) != CS_ERR_OK)
+	{
+		cs_close(&h);
+		return 0;
+	}
+	return h;
+}
+
+void Disassembly::releaseHandle(cs_mode m, csh h)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_freeHandles[m].push_back(h);
+}
+
+void Disassembly::closeHandles()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	for (auto& p : _freeHandles)
+	{
+		for (csh h : p.second)
+		{
+			cs_close(&h);
+		}
+	}
+	_freeHandles.clear();
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
@@ -18,7 +18,7 @@ namespace bin2llvmir {
 //==============================================================================
 //
 
-Config* JumpTarget::config = nullptr;
+thread_local Config* JumpTarget::config = nullptr;
 
 JumpTarget::JumpTarget()
 {
@@ -178,7 +178,7 @@ std::ostream& operator<<(std::ostream &out, const JumpTarget& jt)
 //==============================================================================
 //
 
-Config* JumpTargets::config = nullptr;
+thread_local Config* JumpTargets::config = nullptr;
 
 const JumpTarget* JumpTargets::push(
 		retdec::common::Address a,
@@ -9,6 +9,7 @@
 #include "retdec/bin2llvmir/analyses/reaching_definitions.h"
 #include "retdec/bin2llvmir/optimizations/inst_opt_rda/inst_opt_rda_pass.h"
 #include "retdec/bin2llvmir/optimizations/inst_opt_rda/inst_opt_rda.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 
 using namespace llvm;
@@ -61,8 +62,7 @@ bool InstructionRdaOptimizer::runOnFunction(llvm::Function* f)
 {
 	bool changed = false;
 
-	ReachingDefinitionsAnalysis RDA;
-	RDA.runOnFunction(*f, _abi, true);
+	auto& RDA = ReachingDefinitionsProvider::getAnalysis(f, _abi, true);
 
 	std::unordered_set<llvm::Value*> toRemove;
 
@@ -79,7 +79,12 @@ bool InstructionRdaOptimizer::runOnFunction(llvm::Function* f)
 		);
 	}
 // exit(1);
+	changed |= !toRemove.empty();
 	IrModifier::eraseUnusedInstructionsRecursive(toRemove);
+	if (changed)
+	{
+		ReachingDefinitionsProvider::invalidate(f);
+	}
 	return changed;
 }
 
@@ -13,13 +13,14 @@
 #include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
 #include "retdec/bin2llvmir/providers/abi/abi.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
-#include "retdec/bin2llvmir/providers/calling_convention/calling_convention.h"
 #include "retdec/bin2llvmir/providers/config.h"
 #include "retdec/bin2llvmir/providers/debugformat.h"
 #include "retdec/bin2llvmir/providers/demangler.h"
 #include "retdec/bin2llvmir/providers/fileimage.h"
 #include "retdec/bin2llvmir/providers/lti.h"
 #include "retdec/bin2llvmir/providers/names.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
+#include "retdec/bin2llvmir/providers/thread_pool.h"
 #include "retdec/cpdetect/cpdetect.h"
 #include "retdec/utils/string.h"
 #include "retdec/yaracpp/yara_detector.h"
@@ -168,21 +169,36 @@ void ProviderInitialization::setConfig(retdec::config::Config* c)
 	_config = c;
 }
 
+/**
+ * Remove all the data providers hold for the module @a m.
+ *
+ * Data of other modules are kept untouched, so this can be safely called
+ * while other modules are being decompiled in other threads.
+ */
+void ProviderInitialization::clearProviders(llvm::Module* m)
+{
+	// Needs ABI and config of the module, so it goes first.
+	SymbolicTree::clear(m);
+	AbiProvider::clear(m);
+	AsmInstruction::clear(m);
+	ConfigProvider::clear(m);
+	DebugFormatProvider::clear(m);
+	DemanglerProvider::clear(m);
+	FileImageProvider::clear(m);
+	LtiProvider::clear(m);
+	NamesProvider::clear(m);
+	ReachingDefinitionsProvider::clear(m);
+	ThreadPoolProvider::clear(m);
+}
+
 /**
  * @return Always @c false -- this pass does not modify module.
  */
 bool ProviderInitialization::runOnModule(Module& m)
 {
-	AbiProvider::clear();
-	AsmInstruction::clear();
-	ConfigProvider::clear();
-	DebugFormatProvider::clear();
-	DemanglerProvider::clear();
-	FileImageProvider::clear();
-	LtiProvider::clear();
-	NamesProvider::clear();
-	SymbolicTree::clear();
-	CallingConventionProvider::clear();
+	// The module may have been allocated at the address of an already
+	// destroyed one, so get rid of any stale data first.
+	clearProviders(&m);
 
 	// Config.
 	//
@@ -266,6 +282,10 @@ bool ProviderInitialization::runOnModule(Module& m)
 		throw std::runtime_error("Unsupported target format and architecture combination");
 	}
 
+	// Compiled YARA rules are shared by cpdetect and static code detection.
+	yaracpp::YaraDetector::setCacheDirectory(
+			c->getConfig().parameters.getYaraCacheDirectory());
+
 	// Run cpdetect and set info to config.
 	// TODO: we could probably be using cpdetect results.
 	//
@@ -379,9 +399,18 @@ bool ProviderInitialization::runOnModule(Module& m)
 
 	// ABI.
 	//
+	// The pass pipeline of the module runs in this thread, so the whole
+	// configuration of the thread is set up for the module, replacing any
+	// configuration left by other modules.
 	auto* abi = AbiProvider::addAbi(&m, c);
-	SymbolicTree::setAbi(abi);
-	SymbolicTree::setConfig(c);
+	SymbolicTree::Configuration stConfig;
+	stConfig.abi = abi;
+	stConfig.config = c;
+	SymbolicTree::setConfiguration(stConfig);
+
+	ThreadPoolProvider::addThreadPool(
+			&m,
+			c->getConfig().parameters.getAnalysisJobs());
 
 	// maybe should be in config::Config
 	auto typeConfig = std::make_shared<ctypesparser::TypeConfig>();
@@ -403,7 +432,7 @@ bool ProviderInitialization::runOnModule(Module& m)
 
 	NamesProvider::addNames(&m, c, debug, f, d, lti);
 
-	AsmInstruction::clear();
+	AsmInstruction::clear(&m);
 
 	return false;
 }
@@ -22,6 +22,7 @@
 #include "retdec/bin2llvmir/optimizations/simple_types/simple_types.h"
 #include "retdec/bin2llvmir/providers/abi/abi.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
 #include "retdec/bin2llvmir/utils/debug.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 
@@ -82,20 +83,20 @@ bool SimpleTypesAnalysis::runOnModule(Module& M)
 	module = &M;
 	_specialGlobal = AsmInstruction::getLlvmToAsmGlobalVariable(module);
 
-	static bool first = true;
+	static thread_local bool first = true;
 
 	if (first)
 	{
 		first = false;
 
-		RDA.runOnModule(M, AbiProvider::getAbi(&M));
+		RDA = &ReachingDefinitionsProvider::getAnalysis(&M, AbiProvider::getAbi(&M));
 		buildEqSets(M);
 		buildEquations();
 		eqSets.propagate(module);
 		eqSets.apply(module, config, objf, instToErase);
 		eraseObsoleteInstructions();
 		setGlobalConstants();
-		RDA.clear();
+		RDA = nullptr;
 	}
 	else
 	{
@@ -403,7 +404,7 @@ void SimpleTypesAnalysis::processUse(llvm::Value* current, Value* u, std::queue<
 					}
 					else
 					{
-						auto uses = RDA.usesFromDef(store);
+						auto uses = RDA->usesFromDef(store);
 						for (auto* u : uses)
 						{
 							toProcess.push(u->use);
@@ -529,7 +530,7 @@ void SimpleTypesAnalysis::processUse(llvm::Value* current, Value* u, std::queue<
 			}
 			else
 			{
-				auto uses = RDA.usesFromDef(user);
+				auto uses = RDA->usesFromDef(user);
 				for (auto* u : uses)
 				{
 					toProcess.push(u->use);
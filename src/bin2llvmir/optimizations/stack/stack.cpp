@@ -16,6 +16,8 @@
 #include "retdec/bin2llvmir/analyses/reaching_definitions.h"
 #include "retdec/bin2llvmir/optimizations/stack/stack.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
+#include "retdec/bin2llvmir/providers/thread_pool.h"
 #include "retdec/bin2llvmir/utils/ir_modifier.h"
 #define debug_enabled false
 #include "retdec/bin2llvmir/utils/llvm.h"
@@ -69,63 +71,105 @@ bool StackAnalysis::run()
 		return false;
 	}
 
-	ReachingDefinitionsAnalysis RDA;
-	RDA.runOnModule(*_module, _abi);
+	auto& RDA = ReachingDefinitionsProvider::getAnalysis(_module, _abi);
 
+	std::vector<Function*> fncs;
 	for (auto& f : *_module)
 	{
-		std::map<Value*, Value*> val2val;
-		for (inst_iterator I = inst_begin(f), E = inst_end(f); I != E;)
+		fncs.push_back(&f);
+	}
+	std::vector<std::unordered_set<Value*>> toRemove(fncs.size());
+
+	auto* pool = ThreadPoolProvider::getThreadPool(_module);
+	if (pool && fncs.size() > 1)
+	{
+		// Functions are processed independently, only changes of the module
+		// are serialized. Changes of each function are made in the same order
+		// as in a serial run, so the result does not depend on scheduling.
+		//
+		auto stConfig = SymbolicTree::getConfiguration();
+		stConfig.llvmContextMutex = &_mutex;
+		pool->parallelFor(fncs.size(), [&](std::size_t i)
 		{
-			Instruction& i = *I;
-			++I;
+			auto callerConfig = SymbolicTree::getConfiguration();
+			SymbolicTree::setConfiguration(stConfig);
+			runOnFunction(RDA, *fncs[i], toRemove[i]);
+			SymbolicTree::setConfiguration(callerConfig);
+		});
+	}
+	else
+	{
+		for (std::size_t i = 0; i < fncs.size(); ++i)
+		{
+			runOnFunction(RDA, *fncs[i], toRemove[i]);
+		}
+	}
 
-			if (StoreInst *store = dyn_cast<StoreInst>(&i))
-			{
-				if (AsmInstruction::isLlvmToAsmInstruction(store))
-				{
-					continue;
-				}
+	std::unordered_set<Value*> allToRemove;
+	for (auto& vals : toRemove)
+	{
+		allToRemove.insert(vals.begin(), vals.end());
+	}
+	IrModifier::eraseUnusedInstructionsRecursive(allToRemove);
 
-				handleInstruction(
-						RDA,
-						store,
-						store->getValueOperand(),
-						store->getValueOperand()->getType(),
-						val2val);
+	return false;
+}
 
-				if (isa<GlobalVariable>(store->getPointerOperand()))
-				{
-					continue;
-				}
+void StackAnalysis::runOnFunction(
+		ReachingDefinitionsAnalysis& RDA,
+		llvm::Function& f,
+		std::unordered_set<llvm::Value*>& toRemove)
+{
+	std::map<Value*, Value*> val2val;
+	for (inst_iterator I = inst_begin(f), E = inst_end(f); I != E;)
+	{
+		Instruction& i = *I;
+		++I;
 
-				handleInstruction(
-						RDA,
-						store,
-						store->getPointerOperand(),
-						store->getValueOperand()->getType(),
-						val2val);
+		if (StoreInst *store = dyn_cast<StoreInst>(&i))
+		{
+			if (AsmInstruction::isLlvmToAsmInstruction(store))
+			{
+				continue;
 			}
-			else if (LoadInst* load = dyn_cast<LoadInst>(&i))
+
+			handleInstruction(
+					RDA,
+					store,
+					store->getValueOperand(),
+					store->getValueOperand()->getType(),
+					val2val,
+					toRemove);
+
+			if (isa<GlobalVariable>(store->getPointerOperand()))
 			{
-				if (isa<GlobalVariable>(load->getPointerOperand()))
-				{
-					continue;
-				}
+				continue;
+			}
 
-				handleInstruction(
-						RDA,
-						load,
-						load->getPointerOperand(),
-						load->getType(),
-						val2val);
+			handleInstruction(
+					RDA,
+					store,
+					store->getPointerOperand(),
+					store->getValueOperand()->getType(),
+					val2val,
+					toRemove);
+		}
+		else if (LoadInst* load = dyn_cast<LoadInst>(&i))
+		{
+			if (isa<GlobalVariable>(load->getPointerOperand()))
+			{
+				continue;
 			}
+
+			handleInstruction(
+					RDA,
+					load,
+					load->getPointerOperand(),
+					load->getType(),
+					val2val,
+					toRemove);
 		}
 	}
-
-	IrModifier::eraseUnusedInstructionsRecursive(_toRemove);
-
-	return false;
 }
 
 void StackAnalysis::handleInstruction(
@@ -133,7 +177,8 @@ void StackAnalysis::handleInstruction(
 		llvm::Instruction* inst,
 		llvm::Value* val,
 		llvm::Type* type,
-		std::map<llvm::Value*, llvm::Value*>& val2val)
+		std::map<llvm::Value*, llvm::Value*>& val2val,
+		std::unordered_set<llvm::Value*>& toRemove)
 {
 	LOG << llvmObjToString(inst) << std::endl;
 
@@ -191,6 +236,11 @@ void StackAnalysis::handleInstruction(
 	LOG << "===> " << llvmObjToString(ci) << std::endl;
 	LOG << "===> " << ci->getSExtValue() << std::endl;
 
+	// The rest changes the module (and creates types and constants in its
+	// context), which must not be done by several threads at once.
+	//
+	std::lock_guard<std::mutex> lock(_mutex);
+
 	std::string name = "";
 	Type* t = type;
 
@@ -225,6 +275,7 @@ void StackAnalysis::handleInstruction(
 			debugSv || configSv);
 
 	AllocaInst* a = p.first;
+	ReachingDefinitionsProvider::invalidate(inst->getFunction());
 
 	LOG << "===> " << llvmObjToString(a) << std::endl;
 	LOG << "===> " << llvmObjToString(inst) << std::endl;
@@ -239,19 +290,19 @@ void StackAnalysis::handleInstruction(
 				a->getType()->getElementType(),
 				inst);
 		new StoreInst(conv, a, inst);
-		_toRemove.insert(s);
+		toRemove.insert(s);
 	}
 	else if (l && l->getPointerOperand() == val)
 	{
 		auto* nl = new LoadInst(a, "", l);
 		auto* conv = IrModifier::convertValueToType(nl, l->getType(), l);
 		l->replaceAllUsesWith(conv);
-		_toRemove.insert(l);
+		toRemove.insert(l);
 	}
 	else
 	{
 		auto* conv = IrModifier::convertValueToType(a, val->getType(), inst);
-		_toRemove.insert(val);
+		toRemove.insert(val);
 		inst->replaceUsesOfWith(val, conv);
 	}
 }
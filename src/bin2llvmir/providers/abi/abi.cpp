@@ -298,6 +298,7 @@ Config* Abi::getConfig() const
 //
 
 std::map<llvm::Module*, std::unique_ptr<Abi>> AbiProvider::_module2abi;
+std::shared_mutex AbiProvider::_mutex;
 
 Abi* AbiProvider::addAbi(
 		llvm::Module* m,
@@ -308,30 +309,26 @@ Abi* AbiProvider::addAbi(
 		return nullptr;
 	}
 
+	std::unique_ptr<Abi> abi;
 	if (c->getConfig().architecture.isArm32OrThumb())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiArm>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiArm>(m, c);
 	}
 	else if (c->getConfig().architecture.isArm64())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiArm64>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiArm64>(m, c);
 	}
 	else if (c->getConfig().architecture.isMips())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiMips>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiMips>(m, c);
 	}
 	else if (c->getConfig().architecture.isPic32())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiPic32>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiPic32>(m, c);
 	}
 	else if (c->getConfig().architecture.isPpc())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiPowerpc>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiPowerpc>(m, c);
 	}
 	else if (c->getConfig().architecture.isX86_64())
 	{
@@ -339,25 +336,32 @@ Abi* AbiProvider::addAbi(
 
 		if (isPe || c->getConfig().tools.isMsvc())
 		{
-			auto p = _module2abi.emplace(m, std::make_unique<AbiMS_X64>(m, c));
-			return p.first->second.get();
+			abi = std::make_unique<AbiMS_X64>(m, c);
+		}
+		else
+		{
+			abi = std::make_unique<AbiX64>(m, c);
 		}
-
-		auto p = _module2abi.emplace(m, std::make_unique<AbiX64>(m, c));
-		return p.first->second.get();
 	}
 	else if (c->getConfig().architecture.isX86())
 	{
-		auto p = _module2abi.emplace(m, std::make_unique<AbiX86>(m, c));
-		return p.first->second.get();
+		abi = std::make_unique<AbiX86>(m, c);
 	}
 	// ...
 
-	return nullptr;
+	if (abi == nullptr)
+	{
+		return nullptr;
+	}
+
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	auto p = _module2abi.emplace(m, std::move(abi));
+	return p.first->second.get();
 }
 
 Abi* AbiProvider::getAbi(llvm::Module* m)
 {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
 	auto f = _module2abi.find(m);
 	return f != _module2abi.end() ? f->second.get() : nullptr;
 }
@@ -370,8 +374,15 @@ bool AbiProvider::getAbi(llvm::Module* m, Abi*& abi)
 
 void AbiProvider::clear()
 {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	_module2abi.clear();
 }
 
+void AbiProvider::clear(llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2abi.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
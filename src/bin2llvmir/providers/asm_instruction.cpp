@@ -4,6 +4,8 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+
 #include <llvm/IR/Constants.h>
 #include <llvm/IR/InstIterator.h>
 
@@ -20,8 +22,87 @@ using namespace llvm;
 namespace retdec {
 namespace bin2llvmir {
 
-std::vector<AsmInstruction::ModuleGlobalPair> AsmInstruction::_module2global;
-std::vector<AsmInstruction::ModuleInstructionMap> AsmInstruction::_module2instMap;
+//
+//==============================================================================
+// Llvm2CapstoneInsnMap
+//==============================================================================
+//
+
+/**
+ * Add instruction @a insn under its address. If there already is another
+ * instruction on the address, it is replaced by @a insn.
+ */
+void Llvm2CapstoneInsnMap::add(cs_insn* insn)
+{
+	std::uint64_t pageAddr = insn->address >> PageBits;
+	auto it = std::lower_bound(
+			_pages.begin(),
+			_pages.end(),
+			pageAddr,
+			[](const auto& page, std::uint64_t a) { return page.first < a; });
+	if (it == _pages.end() || it->first != pageAddr)
+	{
+		it = _pages.emplace(it, pageAddr, std::make_unique<Page>());
+	}
+
+	auto*& slot = (*it->second)[insn->address & (PageSize - 1)];
+	if (slot == nullptr)
+	{
+		++_size;
+	}
+	else if (slot != insn)
+	{
+		_replaced.push_back(slot);
+	}
+	slot = insn;
+}
+
+/**
+ * @return Instruction on address @a address, or @c nullptr if there is none.
+ */
+cs_insn* Llvm2CapstoneInsnMap::find(std::uint64_t address) const
+{
+	std::uint64_t pageAddr = address >> PageBits;
+	auto it = std::lower_bound(
+			_pages.begin(),
+			_pages.end(),
+			pageAddr,
+			[](const auto& page, std::uint64_t a) { return page.first < a; });
+	if (it == _pages.end() || it->first != pageAddr)
+	{
+		return nullptr;
+	}
+
+	return (*it->second)[address & (PageSize - 1)];
+}
+
+/**
+ * @return Number of addresses with an instruction.
+ */
+std::size_t Llvm2CapstoneInsnMap::size() const
+{
+	return _size;
+}
+
+/**
+ * Remove all the instructions from the map. They are not freed.
+ */
+void Llvm2CapstoneInsnMap::clear()
+{
+	_pages.clear();
+	_replaced.clear();
+	_size = 0;
+}
+
+//
+//==============================================================================
+// AsmInstruction
+//==============================================================================
+//
+
+std::map<const llvm::Module*, llvm::GlobalVariable*> AsmInstruction::_module2global;
+std::map<const llvm::Module*, Llvm2CapstoneInsnMap> AsmInstruction::_module2instMap;
+std::shared_mutex AsmInstruction::_mutex;
 
 AsmInstruction::AsmInstruction()
 {
@@ -186,38 +267,26 @@ const llvm::GlobalVariable* AsmInstruction::getLlvmToAsmGlobalVariablePrivate(
 Llvm2CapstoneInsnMap& AsmInstruction::getLlvmToCapstoneInsnMap(
 		const llvm::Module* m)
 {
-	for (auto& p : _module2instMap)
-	{
-		if (p.first == m)
-		{
-			return p.second;
-		}
-	}
-
-	auto it = _module2instMap.emplace(_module2instMap.end(), std::make_pair(
-			m,
-			std::map<llvm::StoreInst*, cs_insn*>()));
-	return it->second;
+	// Map nodes are never relocated, so the returned reference stays valid
+	// even when maps for other modules are added or removed.
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	return _module2instMap[m];
 }
 
 llvm::GlobalVariable* AsmInstruction::getLlvmToAsmGlobalVariable(
 		const llvm::Module* m)
 {
-	for (auto& p : _module2global)
-	{
-		if (p.first == m)
-		{
-			return p.second;
-		}
-	}
-	return nullptr;
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	auto it = _module2global.find(m);
+	return it != _module2global.end() ? it->second : nullptr;
 }
 
 void AsmInstruction::setLlvmToAsmGlobalVariable(
 		const llvm::Module* m,
 		llvm::GlobalVariable* gv)
 {
-	_module2global.emplace_back(m, gv);
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2global.emplace(m, gv);
 }
 
 retdec::common::Address AsmInstruction::getInstructionAddress(
@@ -328,10 +397,18 @@ bool AsmInstruction::isLlvmToAsmInstruction(const llvm::Value* inst)
 
 void AsmInstruction::clear()
 {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	_module2global.clear();
 	_module2instMap.clear();
 }
 
+void AsmInstruction::clear(const llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2global.erase(m);
+	_module2instMap.erase(m);
+}
+
 bool AsmInstruction::isValid() const
 {
 	return _llvmToAsmInstr != nullptr;
@@ -344,16 +421,14 @@ bool AsmInstruction::isInvalid() const
 
 cs_insn* AsmInstruction::getCapstoneInsn() const
 {
-	for (auto& p : _module2instMap)
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	auto mIt = _module2instMap.find(_llvmToAsmInstr->getModule());
+	if (mIt == _module2instMap.end())
 	{
-		if (p.first == _llvmToAsmInstr->getModule())
-		{
-			auto it =  p.second.find(_llvmToAsmInstr);
-			return it != p.second.end() ? it->second : nullptr;
-		}
+		return nullptr;
 	}
 
-	return nullptr;
+	return mIt->second.find(getAddress());
 }
 
 std::string AsmInstruction::getDsm() const
@@ -733,15 +733,20 @@ void Config::tagFunctionsWithUsedCryptoGlobals()
 //
 
 std::map<llvm::Module*, Config> ConfigProvider::_module2config;
+std::shared_mutex ConfigProvider::_mutex;
 
 Config* ConfigProvider::addConfig(llvm::Module* m, retdec::config::Config& c)
 {
-	auto p = _module2config.emplace(m, Config::fromConfig(m, c));
+	auto config = Config::fromConfig(m, c);
+
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	auto p = _module2config.emplace(m, std::move(config));
 	return &p.first->second;
 }
 
 Config* ConfigProvider::getConfig(llvm::Module* m)
 {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
 	auto f = _module2config.find(m);
 	return f != _module2config.end() ? &f->second : nullptr;
 }
@@ -766,8 +771,18 @@ void ConfigProvider::doFinalization(llvm::Module* m)
  */
 void ConfigProvider::clear()
 {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	_module2config.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void ConfigProvider::clear(llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2config.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
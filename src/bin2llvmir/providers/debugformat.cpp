@@ -5,6 +5,7 @@
  */
 
 #include "retdec/bin2llvmir/providers/debugformat.h"
+#include "retdec/bin2llvmir/providers/thread_pool.h"
 
 using namespace llvm;
 
@@ -24,10 +25,13 @@ namespace bin2llvmir {
 //
 
 std::map<Module*, DebugFormat> DebugFormatProvider::_module2debug;
+std::shared_mutex DebugFormatProvider::_mutex;
 
 /**
  * Create and add to provider a debug info for the given module @a m, file
  * image @a objf, pdb file path @a pdbFile, and demangler @a demangler.
+ * DWARF compile units are loaded by the thread pool of @a m (if there is one,
+ * see ThreadPoolProvider).
  * @return Created and added debug ingo or @c nullptr if something went wrong
  *         and it was not successfully created.
  */
@@ -42,15 +46,16 @@ DebugFormat* DebugFormatProvider::addDebugFormat(
 		return nullptr;
 	}
 
-	auto p = _module2debug.emplace(
-			m,
-			DebugFormat(
-					objf,
-					pdbFile,
-					nullptr, // symbol table -- not needed.
-					demangler ? demangler->getDemangler() : nullptr
-			)
+	DebugFormat debug(
+			objf,
+			pdbFile,
+			nullptr, // symbol table -- not needed.
+			demangler ? demangler->getDemangler() : nullptr,
+			ThreadPoolProvider::getThreadPool(m)
 	);
+
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	auto p = _module2debug.emplace(m, std::move(debug));
 	return &p.first->second;
 }
 
@@ -61,6 +66,7 @@ DebugFormat* DebugFormatProvider::addDebugFormat(
 DebugFormat* DebugFormatProvider::getDebugFormat(
 		llvm::Module* m)
 {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
 	auto f = _module2debug.find(m);
 	return f != _module2debug.end() ? &f->second : nullptr;
 }
@@ -84,8 +90,18 @@ bool DebugFormatProvider::getDebugFormat(llvm::Module* m, DebugFormat*& df)
  */
 void DebugFormatProvider::clear()
 {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	_module2debug.clear();
 }
 
+/**
+ * Clear data stored for the given module @a m.
+ */
+void DebugFormatProvider::clear(llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2debug.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
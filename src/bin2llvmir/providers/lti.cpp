@@ -16,6 +16,7 @@
 #include "retdec/ctypes/union_type.h"
 #include "retdec/ctypes/unknown_type.h"
 #include "retdec/ctypes/void_type.h"
+#include "retdec/utils/filesystem.h"
 #include "retdec/utils/string.h"
 #include "retdec/bin2llvmir/providers/lti.h"
 #include "retdec/bin2llvmir/utils/ctypes2llvm.h"
@@ -93,18 +94,79 @@ Lti::Lti(
 
 void Lti::loadLtiFile(const std::string& filePath)
 {
+	std::string cc = "cdecl";
+	if (retdec::utils::containsCaseInsensitive(filePath, "win"))
+	{
+		cc = "stdcall";
+	}
+
+	if (loadBinaryLtiFile(filePath, cc))
+	{
+		return;
+	}
+
 	std::ifstream file(filePath);
 	if (file)
 	{
-		std::string cc = "cdecl";
-		if (retdec::utils::containsCaseInsensitive(filePath, "win"))
-		{
-			cc = "stdcall";
-		}
 		_ltiParser.parseInto(file, _ltiModule, _typeConfig->typeWidths(), cc);
 	}
 }
 
+/**
+ * Open a compiled (binary) version of the JSON LTI file @c filePath, if there
+ * is an up-to-date one next to it (e.g. @c cstdlib.lti for @c cstdlib.json).
+ * Functions from the binary file are parsed lazily by getLtiFunction().
+ * @return @c True if the binary file was opened, @c false otherwise.
+ *
+ * Binary files are compiled from all JSON files when RetDec is installed.
+ * If only some of them are available, functions from JSON files take
+ * precedence over functions from binary files.
+ */
+bool Lti::loadBinaryLtiFile(
+		const std::string& filePath,
+		const std::string& callConvention)
+{
+	fs::path binaryPath(filePath);
+	binaryPath.replace_extension(".lti");
+
+	std::error_code ec;
+	auto jsonTime = fs::last_write_time(filePath, ec);
+	if (ec)
+	{
+		jsonTime = fs::file_time_type::min();
+	}
+	auto binaryTime = fs::last_write_time(binaryPath, ec);
+	if (ec || binaryTime < jsonTime)
+	{
+		return false;
+	}
+
+	auto parser = std::make_unique<ctypesparser::BinaryCTypesParser>(
+			static_cast<unsigned>(
+					_config->getConfig().architecture.getBitSize()));
+	try
+	{
+		parser->openInto(
+				binaryPath.string(),
+				_ltiModule,
+				_typeConfig->typeWidths(),
+				callConvention);
+	}
+	catch (const ctypesparser::CTypesParseError&)
+	{
+		return false;
+	}
+
+	std::vector<ctypesparser::BinaryCTypesParser*> previousParsers;
+	for (auto& db : _ltiDatabases)
+	{
+		previousParsers.push_back(db.get());
+	}
+	parser->setPreviousParsers(previousParsers);
+	_ltiDatabases.push_back(std::move(parser));
+	return true;
+}
+
 bool Lti::hasLtiFunction(const std::string& name)
 {
 	return getLtiFunction(name) != nullptr;
@@ -113,7 +175,19 @@ bool Lti::hasLtiFunction(const std::string& name)
 std::shared_ptr<retdec::ctypes::Function> Lti::getLtiFunction(
 		const std::string& name)
 {
-	return _ltiModule->getFunctionWithName(name);
+	if (auto fnc = _ltiModule->getFunctionWithName(name))
+	{
+		return fnc;
+	}
+
+	for (auto& db : _ltiDatabases)
+	{
+		if (auto fnc = db->getFunction(name))
+		{
+			return fnc;
+		}
+	}
+	return nullptr;
 }
 
 /**
@@ -235,6 +309,7 @@ llvm::Type* Lti::getLlvmType(std::shared_ptr<retdec::ctypes::Type> type)
 //
 
 std::map<llvm::Module*, Lti> LtiProvider::_module2lti;
+std::shared_mutex LtiProvider::_mutex;
 
 Lti* LtiProvider::addLti(
 	llvm::Module *m,
@@ -247,12 +322,16 @@ Lti* LtiProvider::addLti(
 		return nullptr;
 	}
 
-	auto p = _module2lti.emplace(m, Lti(m, c, typeConfig, objf));
+	Lti lti(m, c, typeConfig, objf);
+
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	auto p = _module2lti.emplace(m, std::move(lti));
 	return &p.first->second;
 }
 
 Lti* LtiProvider::getLti(llvm::Module* m)
 {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
 	auto f = _module2lti.find(m);
 	return f != _module2lti.end() ? &f->second : nullptr;
 }
@@ -265,8 +344,15 @@ bool LtiProvider::getLti(llvm::Module* m, Lti*& lti)
 
 void LtiProvider::clear()
 {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	_module2lti.clear();
 }
 
+void LtiProvider::clear(llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2lti.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -478,6 +478,11 @@ std::string NameContainer::getNameFromImportLibAndOrd(
 		const std::string& libName,
 		int ord)
 {
+	if (auto* ordinals = getOrdinalDatabase())
+	{
+		return ordinals->getName(getOrdinalsArch(), libName, ord);
+	}
+
 	auto it = _dllOrds.find(libName);
 	if (it == _dllOrds.end())
 	{
@@ -501,12 +506,46 @@ std::string NameContainer::getNameFromImportLibAndOrd(
 	return std::string();
 }
 
+/**
+ * @return Name of the directory with ordinal numbers of the architecture of
+ *         the input, or an empty string if there are no ordinal numbers for it.
+ */
+std::string NameContainer::getOrdinalsArch() const
+{
+	if (_config->getConfig().architecture.isArm()) return "arm";
+	else if (_config->getConfig().architecture.isX86()) return "x86";
+	else return std::string();
+}
+
+/**
+ * @return Database of all ordinal numbers, or @c nullptr if there is no such
+ *         database in the ordinal numbers directory. In such a case, ordinal
+ *         numbers are loaded from per-library files by loadImportOrds().
+ */
+const retdec::utils::OrdinalDatabase* NameContainer::getOrdinalDatabase()
+{
+	if (!_ordinalsOpened)
+	{
+		_ordinalsOpened = true;
+
+		auto dir = _config->getConfig().parameters.getOrdinalNumbersDirectory();
+		auto ordinals = std::make_unique<retdec::utils::OrdinalDatabase>();
+		if (ordinals->open(dir + "/" + retdec::utils::OrdinalDatabase::DefaultFileName))
+		{
+			_ordinals = std::move(ordinals);
+		}
+	}
+
+	return _ordinals.get();
+}
+
 bool NameContainer::loadImportOrds(const std::string& libName)
 {
-	std::string arch;
-	if (_config->getConfig().architecture.isArm()) arch = "arm";
-	else if (_config->getConfig().architecture.isX86()) arch = "x86";
-	else return false;
+	std::string arch = getOrdinalsArch();
+	if (arch.empty())
+	{
+		return false;
+	}
 
 	auto dir = _config->getConfig().parameters.getOrdinalNumbersDirectory();
 	auto filePath = dir + "/" + arch + "/" + libName + ".ord";
@@ -545,6 +584,7 @@ bool NameContainer::loadImportOrds(const std::string& libName)
 //
 
 std::map<llvm::Module*, NameContainer> NamesProvider::_module2names;
+std::shared_mutex NamesProvider::_mutex;
 
 NameContainer* NamesProvider::addNames(
 		llvm::Module* m,
@@ -563,12 +603,16 @@ NameContainer* NamesProvider::addNames(
 		return nullptr;
 	}
 
-	auto p = _module2names.emplace(m, NameContainer(m, c, d, i, dm, lti));
+	NameContainer names(m, c, d, i, dm, lti);
+
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	auto p = _module2names.emplace(m, std::move(names));
 	return &p.first->second;
 }
 
 NameContainer* NamesProvider::getNames(llvm::Module* m)
 {
+	std::shared_lock<std::shared_mutex> lock(_mutex);
 	auto f = _module2names.find(m);
 	return f != _module2names.end() ? &f->second : nullptr;
 }
@@ -581,8 +625,15 @@ bool NamesProvider::getNames(llvm::Module* m, NameContainer*& names)
 
 void NamesProvider::clear()
 {
+	std::unique_lock<std::shared_mutex> lock(_mutex);
 	_module2names.clear();
 }
 
+void NamesProvider::clear(llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2names.erase(m);
+}
+
 } // namespace bin2llvmir
 } // namespace retdec
@@ -0,0 +1,134 @@
+/**
+ * @file src/bin2llvmir/providers/reaching_definitions.cpp
+ * @brief Reaching definitions analysis shared by passes.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
+#include "retdec/bin2llvmir/providers/thread_pool.h"
+#define debug_enabled false
+#include "retdec/bin2llvmir/utils/llvm.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+std::map<
+		std::pair<llvm::Module*, bool>,
+		ReachingDefinitionsAnalysis> ReachingDefinitionsProvider::_module2rda;
+std::shared_mutex ReachingDefinitionsProvider::_mutex;
+
+/**
+ * Get analysis for the whole module @a m. It is updated for all functions
+ * that changed since the last request, in parallel if there is a thread pool
+ * for @a m (see ThreadPoolProvider).
+ */
+ReachingDefinitionsAnalysis& ReachingDefinitionsProvider::getAnalysis(
+		llvm::Module* m,
+		Abi* abi,
+		bool trackFlagRegs)
+{
+	auto& rda = getAnalysisEntry(m, trackFlagRegs);
+	rda.update(*m, abi, trackFlagRegs, ThreadPoolProvider::getThreadPool(m));
+	return rda;
+}
+
+/**
+ * Get analysis for the module of function @a f. It is updated only for @a f,
+ * so results for other functions may be out of date.
+ */
+ReachingDefinitionsAnalysis& ReachingDefinitionsProvider::getAnalysis(
+		llvm::Function* f,
+		Abi* abi,
+		bool trackFlagRegs)
+{
+	auto& rda = getAnalysisEntry(f->getParent(), trackFlagRegs);
+	rda.update(*f, abi, trackFlagRegs);
+	return rda;
+}
+
+/**
+ * Report that function @a f was changed, so its analysis results must be
+ * recomputed when they are requested next time.
+ */
+void ReachingDefinitionsProvider::invalidate(llvm::Function* f)
+{
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	for (bool trackFlagRegs : {false, true})
+	{
+		auto it = _module2rda.find({f->getParent(), trackFlagRegs});
+		if (it != _module2rda.end())
+		{
+			it->second.invalidate(f);
+		}
+	}
+}
+
+/**
+ * Report that any function of module @a m may have been changed, so all the
+ * analysis results must be recomputed when they are requested next time.
+ */
+void ReachingDefinitionsProvider::invalidate(llvm::Module* m)
+{
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	for (bool trackFlagRegs : {false, true})
+	{
+		auto it = _module2rda.find({m, trackFlagRegs});
+		if (it != _module2rda.end())
+		{
+			it->second.invalidateAll();
+		}
+	}
+}
+
+/**
+ * Get counters of reused and recomputed function results summed over all the
+ * analyses of module @a m.
+ */
+ReachingDefinitionsAnalysis::CacheStatistics
+ReachingDefinitionsProvider::getStatistics(llvm::Module* m)
+{
+	ReachingDefinitionsAnalysis::CacheStatistics ret;
+
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	for (bool trackFlagRegs : {false, true})
+	{
+		auto it = _module2rda.find({m, trackFlagRegs});
+		if (it != _module2rda.end())
+		{
+			auto& s = it->second.getCacheStatistics();
+			ret.hits += s.hits;
+			ret.recomputes += s.recomputes;
+			ret.invalidations += s.invalidations;
+		}
+	}
+	return ret;
+}
+
+void ReachingDefinitionsProvider::clear()
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2rda.clear();
+}
+
+void ReachingDefinitionsProvider::clear(llvm::Module* m)
+{
+	auto s = getStatistics(m);
+	LOG << "RDA cache: " << s.hits << " hits, " << s.recomputes
+			<< " recomputes, " << s.invalidations << " invalidations"
+			<< std::endl;
+
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2rda.erase({m, false});
+	_module2rda.erase({m, true});
+}
+
+ReachingDefinitionsAnalysis& ReachingDefinitionsProvider::getAnalysisEntry(
+		llvm::Module* m,
+		bool trackFlagRegs)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	return _module2rda[{m, trackFlagRegs}];
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
@@ -0,0 +1,62 @@
+/**
+ * @file src/bin2llvmir/providers/thread_pool.cpp
+ * @brief Thread pool provider for bin2llvmirl.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include "retdec/bin2llvmir/providers/thread_pool.h"
+
+namespace retdec {
+namespace bin2llvmir {
+
+std::map<
+		llvm::Module*,
+		std::unique_ptr<utils::ThreadPool>> ThreadPoolProvider::_module2pool;
+std::shared_mutex ThreadPoolProvider::_mutex;
+
+/**
+ * Create a thread pool with @a jobs threads for module @a m.
+ * @return Created thread pool, or @c nullptr if @a jobs is less than two --
+ *         functions of @a m are then analyzed serially.
+ */
+utils::ThreadPool* ThreadPoolProvider::addThreadPool(
+		llvm::Module* m,
+		std::size_t jobs)
+{
+	if (m == nullptr || jobs < 2)
+	{
+		return nullptr;
+	}
+
+	auto pool = std::make_unique<utils::ThreadPool>(jobs);
+
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	auto& p = _module2pool[m];
+	p = std::move(pool);
+	return p.get();
+}
+
+/**
+ * @return Thread pool for module @a m, or @c nullptr if there is none.
+ */
+utils::ThreadPool* ThreadPoolProvider::getThreadPool(llvm::Module* m)
+{
+	std::shared_lock<std::shared_mutex> lock(_mutex);
+	auto f = _module2pool.find(m);
+	return f != _module2pool.end() ? f->second.get() : nullptr;
+}
+
+void ThreadPoolProvider::clear()
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2pool.clear();
+}
+
+void ThreadPoolProvider::clear(llvm::Module* m)
+{
+	std::unique_lock<std::shared_mutex> lock(_mutex);
+	_module2pool.erase(m);
+}
+
+} // namespace bin2llvmir
+} // namespace retdec
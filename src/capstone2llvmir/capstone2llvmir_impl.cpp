@@ -172,8 +172,9 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 {
 	TranslationResult res;
 
-	// We want to keep all Capstone instructions -> alloc a new one each time.
-	cs_insn* insn = cs_malloc(_handle);
+	// Instructions are decoded into the scratch instruction and only their
+	// compact copies are kept.
+	cs_insn* insn = _scratchInsn;
 
 	uint64_t address = a;
 
@@ -191,12 +192,13 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 
 	while (disasmRes)
 	{
-		auto* a2l = generateSpecialAsm2LlvmInstr(irb, insn);
+		cs_insn* retained = retainInsn(_arch, insn);
+		auto* a2l = generateSpecialAsm2LlvmInstr(irb, retained);
 
-		res.insns.push_back(std::make_pair(a2l, insn));
-		res.size = (insn->address + insn->size) - a;
+		res.insns.push_back(std::make_pair(a2l, retained));
+		res.size = (retained->address + retained->size) - a;
 
-		translateInstruction(insn, irb);
+		translateInstruction(retained, irb);
 
 		++res.count;
 		if (count && count == res.count)
@@ -211,8 +213,6 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 			return res;
 		}
 
-		insn = cs_malloc(_handle);
-
 		// TODO: hack, solve better.
 		disasmRes = cs_disasm_iter(_handle, &bytes, &size, &address, insn);
 		if (!disasmRes && _arch == CS_ARCH_MIPS && _basicMode == CS_MODE_MIPS32)
@@ -223,8 +223,6 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translate(
 		}
 	}
 
-	cs_free(insn, 1);
-
 	return res;
 }
 
@@ -236,14 +234,9 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
 		retdec::common::Address& a,
 		llvm::IRBuilder<>& irb)
 {
-	TranslationResultOne res;
-
-	// We want to keep all Capstone instructions -> alloc a new one each time.
-	cs_insn* insn = cs_malloc(_handle);
+	cs_insn* insn = _scratchInsn;
 
 	uint64_t address = a;
-	_branchGenerated = nullptr;
-	_inCondition = false;
 
 	// TODO: hack, solve better.
 	bool disasmRes = cs_disasm_iter(_handle, &bytes, &size, &address, insn);
@@ -256,21 +249,36 @@ Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
 
 	if (disasmRes)
 	{
-		auto* a2l = generateSpecialAsm2LlvmInstr(irb, insn);
-		translateInstruction(insn, irb);
-
-		res.llvmInsn = a2l;
-		res.capstoneInsn = insn;
-		res.size = insn->size;
-		res.branchCall = _branchGenerated;
-		res.inCondition = _inCondition;
-
-		a = address;
+		return translateOne(retainInsn(_arch, insn), a, irb);
 	}
 	else
 	{
-		cs_free(insn, 1);
+		return TranslationResultOne();
 	}
+}
+
+template <typename CInsn, typename CInsnOp>
+typename Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::TranslationResultOne
+Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::translateOne(
+		cs_insn* insn,
+		retdec::common::Address& a,
+		llvm::IRBuilder<>& irb)
+{
+	TranslationResultOne res;
+
+	_branchGenerated = nullptr;
+	_inCondition = false;
+
+	auto* a2l = generateSpecialAsm2LlvmInstr(irb, insn);
+	translateInstruction(insn, irb);
+
+	res.llvmInsn = a2l;
+	res.capstoneInsn = insn;
+	res.size = insn->size;
+	res.branchCall = _branchGenerated;
+	res.inCondition = _inCondition;
+
+	a = insn->address + insn->size;
 
 	return res;
 }
@@ -730,11 +738,19 @@ void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::configureHandle()
 	{
 		throw CapstoneError(cs_errno(_handle));
 	}
+
+	// Details are allocated only if they are enabled in the handle.
+	_scratchInsn = cs_malloc(_handle);
 }
 
 template <typename CInsn, typename CInsnOp>
 void Capstone2LlvmIrTranslator_impl<CInsn, CInsnOp>::closeHandle()
 {
+	if (_scratchInsn)
+	{
+		cs_free(_scratchInsn, 1);
+		_scratchInsn = nullptr;
+	}
 	if (_handle != 0)
 	{
 		if (cs_close(&_handle) != CS_ERR_OK)
@@ -77,6 +77,10 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 				std::size_t& size,
 				retdec::common::Address& a,
 				llvm::IRBuilder<>& irb) override;
+		virtual TranslationResultOne translateOne(
+				cs_insn* insn,
+				retdec::common::Address& a,
+				llvm::IRBuilder<>& irb) override;
 //
 //==============================================================================
 // Capstone related getters - from Capstone2LlvmIrTranslator.
@@ -606,6 +610,8 @@ class Capstone2LlvmIrTranslator_impl : virtual public Capstone2LlvmIrTranslator
 //
 	protected:
 		csh _handle = 0;
+		/// Instruction reused for decoding, see retainInsn().
+		cs_insn* _scratchInsn = nullptr;
 		cs_arch _arch = CS_ARCH_ALL;
 		cs_mode _basicMode = CS_MODE_LITTLE_ENDIAN;
 		cs_mode _extraMode = CS_MODE_LITTLE_ENDIAN;
@@ -0,0 +1,128 @@
+/**
+ * @file src/capstone2llvmir/retained_insn.cpp
+ * @brief Compact pooled storage of Capstone instructions that are kept
+ *        after their translation.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+
+#include "retdec/capstone2llvmir/retained_insn.h"
+#include "retdec/utils/small_block_pool.h"
+
+using retdec::utils::SmallBlockPool;
+
+namespace retdec {
+namespace capstone2llvmir {
+
+namespace {
+
+/// Size of the header with the block size, which precedes the instruction.
+constexpr std::size_t HeaderSize = SmallBlockPool::Alignment;
+static_assert(sizeof(std::size_t) <= HeaderSize, "block size does not fit");
+static_assert(alignof(cs_insn) <= SmallBlockPool::Alignment
+		&& alignof(cs_detail) <= SmallBlockPool::Alignment,
+		"instructions are over-aligned");
+
+/// Offset of the details from the instruction.
+constexpr std::size_t DetailOffset =
+		(sizeof(cs_insn) + alignof(cs_detail) - 1)
+		/ alignof(cs_detail) * alignof(cs_detail);
+
+/**
+ * @return Size of the used part of architecture specific details @a d, which
+ *         are located on offset @a offset in @c cs_detail.
+ *
+ * Unused operands are left out only if nothing but padding follows them.
+ * Otherwise, the whole structure is kept.
+ */
+template<typename ArchDetail>
+std::size_t getArchDetailSize(std::size_t offset, const ArchDetail& d)
+{
+	constexpr std::size_t operandsEnd = offsetof(ArchDetail, operands)
+			+ sizeof(d.operands);
+	if (sizeof(ArchDetail) - operandsEnd >= alignof(ArchDetail))
+	{
+		return offset + sizeof(ArchDetail);
+	}
+
+	std::size_t count = std::min<std::size_t>(
+			d.op_count,
+			std::size(d.operands));
+	return offset
+			+ offsetof(ArchDetail, operands)
+			+ count * sizeof(d.operands[0]);
+}
+
+/**
+ * @return Size of the used part of details @a d of architecture @a arch.
+ */
+std::size_t getDetailSize(cs_arch arch, const cs_detail& d)
+{
+	switch (arch)
+	{
+		case CS_ARCH_X86:
+			return getArchDetailSize(offsetof(cs_detail, x86), d.x86);
+		case CS_ARCH_ARM:
+			return getArchDetailSize(offsetof(cs_detail, arm), d.arm);
+		case CS_ARCH_ARM64:
+			return getArchDetailSize(offsetof(cs_detail, arm64), d.arm64);
+		case CS_ARCH_MIPS:
+			return getArchDetailSize(offsetof(cs_detail, mips), d.mips);
+		case CS_ARCH_PPC:
+			return getArchDetailSize(offsetof(cs_detail, ppc), d.ppc);
+		default:
+			return sizeof(cs_detail);
+	}
+}
+
+} // anonymous namespace
+
+cs_insn* retainInsn(cs_arch arch, const cs_insn* insn)
+{
+	std::size_t size = getRetainedInsnSize(arch, insn);
+	auto* block = static_cast<unsigned char*>(SmallBlockPool::allocate(size));
+	std::memcpy(block, &size, sizeof(size));
+
+	auto* copy = reinterpret_cast<cs_insn*>(block + HeaderSize);
+	std::memcpy(copy, insn, sizeof(cs_insn));
+	if (insn->detail)
+	{
+		copy->detail = reinterpret_cast<cs_detail*>(
+				reinterpret_cast<unsigned char*>(copy) + DetailOffset);
+		std::memcpy(
+				copy->detail,
+				insn->detail,
+				size - HeaderSize - DetailOffset);
+	}
+	return copy;
+}
+
+void freeRetainedInsn(cs_insn* insn)
+{
+	if (insn == nullptr)
+	{
+		return;
+	}
+
+	auto* block = reinterpret_cast<unsigned char*>(insn) - HeaderSize;
+	std::size_t size = 0;
+	std::memcpy(&size, block, sizeof(size));
+	SmallBlockPool::deallocate(block, size);
+}
+
+std::size_t getRetainedInsnSize(cs_arch arch, const cs_insn* insn)
+{
+	if (insn->detail == nullptr)
+	{
+		return HeaderSize + sizeof(cs_insn);
+	}
+
+	return HeaderSize + DetailOffset + getDetailSize(arch, *insn->detail);
+}
+
+} // namespace capstone2llvmir
+} // namespace retdec
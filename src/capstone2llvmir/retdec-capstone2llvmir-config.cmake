@@ -4,6 +4,7 @@ if(NOT TARGET retdec::capstone2llvmir)
         REQUIRED
         COMPONENTS
             common
+            utils
             capstone
             llvm
     )
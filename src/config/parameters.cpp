@@ -18,6 +18,10 @@ const std::string JSON_verboseOut               = "verboseOut";
 const std::string JSON_keepAllFuncs             = "keepAllFuncs";
 const std::string JSON_selectedDecodeOnly       = "selectedDecodeOnly";
 const std::string JSON_ordinalNumDir            = "ordinalNumDirectory";
+const std::string JSON_yaraCacheDir             = "yaraCacheDirectory";
+const std::string JSON_profilePassesFile        = "profilePassesFile";
+const std::string JSON_bin2llvmirCacheDir       = "bin2llvmirCacheDirectory";
+const std::string JSON_bin2llvmirCacheMaxSize   = "bin2llvmirCacheMaxSize";
 const std::string JSON_userStaticSigPaths       = "userStaticSignPaths";
 const std::string JSON_staticSigPaths           = "staticSignPaths";
 const std::string JSON_libraryTypeInfoPaths     = "libraryTypeInfoPaths";
@@ -48,6 +52,7 @@ const std::string JSON_backendDisabledOpts      = "backendDisabledOpts";
 const std::string JSON_backendEnabledOpts       = "backendEnabledOpts";
 const std::string JSON_backendCallInfoObtainer  = "backendCallInfoObtainer";
 const std::string JSON_backendVarRenamer        = "backendVarRenamer";
+const std::string JSON_backendJobs              = "backendJobs";
 const std::string JSON_backendNoOpts            = "backendNoOpts";
 const std::string JSON_backendEmitCfg           = "backendEmitCfg";
 const std::string JSON_backendEmitCg            = "backendEmitCg";
@@ -59,6 +64,7 @@ const std::string JSON_backendNoCompoundOperators = "backendNoCompoundOperators"
 const std::string JSON_backendNoSymbolicNames   = "backendNoSymbolicNames";
 
 const std::string JSON_timeout                  = "timeout";
+const std::string JSON_analysisJobs             = "analysisJobs";
 const std::string JSON_maxMemoryLimit           = "maxMemoryLimit";
 const std::string JSON_maxMemoryLimitHalfRam    = "maxMemoryLimitHalfRam";
 
@@ -226,6 +232,26 @@ void Parameters::setOrdinalNumbersDirectory(const std::string& n)
 	_ordinalNumbersDirectory = n;
 }
 
+void Parameters::setYaraCacheDirectory(const std::string& n)
+{
+	_yaraCacheDirectory = n;
+}
+
+void Parameters::setProfilePassesFile(const std::string& n)
+{
+	_profilePassesFile = n;
+}
+
+void Parameters::setBin2llvmirCacheDirectory(const std::string& n)
+{
+	_bin2llvmirCacheDirectory = n;
+}
+
+void Parameters::setBin2llvmirCacheMaxSize(uint64_t size)
+{
+	_bin2llvmirCacheMaxSize = size;
+}
+
 void Parameters::setInputFile(const std::string& file)
 {
 	_inputFile = file;
@@ -251,6 +277,11 @@ void Parameters::setTimeout(uint64_t seconds)
 	_timeout = seconds;
 }
 
+void Parameters::setAnalysisJobs(uint64_t jobs)
+{
+	_analysisJobs = jobs;
+}
+
 void Parameters::setEntryPoint(const retdec::common::Address& a)
 {
 	_entryPoint = a;
@@ -285,6 +316,11 @@ void Parameters::setBackendVarRenamer(const std::string& val)
 	_backendVarRenamer = val;
 }
 
+void Parameters::setBackendJobs(uint64_t jobs)
+{
+	_backendJobs = jobs;
+}
+
 void Parameters::setIsBackendNoOpts(bool b)
 {
 	_backendNoOpts = b;
@@ -340,6 +376,26 @@ const std::string& Parameters::getOrdinalNumbersDirectory() const
 	return _ordinalNumbersDirectory;
 }
 
+const std::string& Parameters::getYaraCacheDirectory() const
+{
+	return _yaraCacheDirectory;
+}
+
+const std::string& Parameters::getProfilePassesFile() const
+{
+	return _profilePassesFile;
+}
+
+const std::string& Parameters::getBin2llvmirCacheDirectory() const
+{
+	return _bin2llvmirCacheDirectory;
+}
+
+uint64_t Parameters::getBin2llvmirCacheMaxSize() const
+{
+	return _bin2llvmirCacheMaxSize;
+}
+
 const std::string& Parameters::getInputFile() const
 {
 	return _inputFile;
@@ -405,6 +461,11 @@ uint64_t Parameters::getTimeout() const
 	return _timeout;
 }
 
+uint64_t Parameters::getAnalysisJobs() const
+{
+	return _analysisJobs;
+}
+
 retdec::common::Address Parameters::getEntryPoint() const
 {
 	return _entryPoint;
@@ -440,6 +501,11 @@ const std::string& Parameters::getBackendVarRenamer() const
 	return _backendVarRenamer;
 }
 
+uint64_t Parameters::getBackendJobs() const
+{
+	return _backendJobs;
+}
+
 void fixPath(std::string& path, fs::path root)
 {
 	fs::path p(path);
@@ -487,6 +553,10 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeBool(writer, JSON_keepAllFuncs, isKeepAllFunctions());
 	serdes::serializeBool(writer, JSON_selectedDecodeOnly, isSelectedDecodeOnly());
 	serdes::serializeString(writer, JSON_ordinalNumDir, getOrdinalNumbersDirectory());
+	serdes::serializeString(writer, JSON_yaraCacheDir, getYaraCacheDirectory());
+	serdes::serializeString(writer, JSON_profilePassesFile, getProfilePassesFile());
+	serdes::serializeString(writer, JSON_bin2llvmirCacheDir, getBin2llvmirCacheDirectory());
+	serdes::serializeUint64(writer, JSON_bin2llvmirCacheMaxSize, getBin2llvmirCacheMaxSize());
 
 	serdes::serializeString(writer, JSON_inputFile, getInputFile());
 	serdes::serializeString(writer, JSON_inputPdbFile, getInputPdbFile());
@@ -504,6 +574,7 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeString(writer, JSON_backendEnabledOpts, getBackendEnabledOpts());
 	serdes::serializeString(writer, JSON_backendCallInfoObtainer, getBackendCallInfoObtainer());
 	serdes::serializeString(writer, JSON_backendVarRenamer, getBackendVarRenamer());
+	serdes::serializeUint64(writer, JSON_backendJobs, getBackendJobs());
 	serdes::serializeBool(writer, JSON_backendNoOpts, isBackendNoOpts());
 	serdes::serializeBool(writer, JSON_backendEmitCfg, isBackendEmitCfg());
 	serdes::serializeBool(writer, JSON_backendEmitCg, isBackendEmitCg());
@@ -516,6 +587,7 @@ void Parameters::serialize(Writer& writer) const
 	serdes::serializeBool(writer, JSON_backendNoSymbolicNames, isBackendNoSymbolicNames());
 
 	serdes::serializeUint64(writer, JSON_timeout, getTimeout());
+	serdes::serializeUint64(writer, JSON_analysisJobs, getAnalysisJobs());
 	serdes::serializeUint64(writer, JSON_maxMemoryLimit, getMaxMemoryLimit());
 	serdes::serializeBool(writer, JSON_maxMemoryLimitHalfRam, isMaxMemoryLimitHalfRam());
 
@@ -555,6 +627,10 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setIsKeepAllFunctions( serdes::deserializeBool(val, JSON_keepAllFuncs) );
 	setIsSelectedDecodeOnly( serdes::deserializeBool(val, JSON_selectedDecodeOnly) );
 	setOrdinalNumbersDirectory( serdes::deserializeString(val, JSON_ordinalNumDir) );
+	setYaraCacheDirectory( serdes::deserializeString(val, JSON_yaraCacheDir) );
+	setProfilePassesFile( serdes::deserializeString(val, JSON_profilePassesFile) );
+	setBin2llvmirCacheDirectory( serdes::deserializeString(val, JSON_bin2llvmirCacheDir) );
+	setBin2llvmirCacheMaxSize( serdes::deserializeUint64(val, JSON_bin2llvmirCacheMaxSize, 1024 * 1024 * 1024) );
 
 	setInputFile( serdes::deserializeString(val, JSON_inputFile) );
 	setInputPdbFile( serdes::deserializeString(val, JSON_inputPdbFile) );
@@ -573,6 +649,7 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setBackendEnabledOpts( serdes::deserializeString(val, JSON_backendEnabledOpts) );
 	setBackendCallInfoObtainer( serdes::deserializeString(val, JSON_backendCallInfoObtainer, "optim") );
 	setBackendVarRenamer( serdes::deserializeString(val, JSON_backendVarRenamer, "readable") );
+	setBackendJobs( serdes::deserializeUint64(val, JSON_backendJobs, 1) );
 	setIsBackendNoOpts( serdes::deserializeBool(val, JSON_backendNoOpts, false) );
 	setIsBackendEmitCfg( serdes::deserializeBool(val, JSON_backendEmitCfg, false) );
 	setIsBackendEmitCg( serdes::deserializeBool(val, JSON_backendEmitCg, false) );
@@ -584,6 +661,7 @@ void Parameters::deserialize(const rapidjson::Value& val)
 	setIsBackendNoSymbolicNames( serdes::deserializeBool(val, JSON_backendNoSymbolicNames, false) );
 
 	setTimeout( serdes::deserializeUint64(val, JSON_timeout, 0) );
+	setAnalysisJobs( serdes::deserializeUint64(val, JSON_analysisJobs, 1) );
 	setMaxMemoryLimit( serdes::deserializeUint64(val, JSON_maxMemoryLimit, 0) );
 	setIsMaxMemoryLimitHalfRam( serdes::deserializeBool(val, JSON_maxMemoryLimitHalfRam, true) );
 
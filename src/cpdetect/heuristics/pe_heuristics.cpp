@@ -16,6 +16,7 @@
 #include "retdec/cpdetect/heuristics/pe_heuristics.h"
 #include "retdec/cpdetect/settings.h"
 #include "retdec/cpdetect/signature.h"
+#include "retdec/cpdetect/signature_matcher.h"
 #include "retdec/fileformat/utils/conversions.h"
 #include "retdec/fileformat/utils/file_io.h"
 #include "retdec/fileformat/utils/other.h"
@@ -76,6 +77,16 @@ const std::vector<Signature> x86SlashedSignatures =
 	{"yoda's Protector", "1.03.3", "E803000000/BB55000000E803000000/E88E000000E803000000EB01--E881000000E803000000EB01--E8B7000000E803000000EB01--E8AA000000E803000000EB01--83FB55E803000000EB01--75;", "Ashkbiz Danehkar", 0, 0}
 };
 
+const SignatureMatcher x86SlashedSignaturesMatcher = []()
+{
+	std::vector<std::string> patterns;
+	for (const auto &sig : x86SlashedSignatures)
+	{
+		patterns.push_back(sig.pattern);
+	}
+	return SignatureMatcher(patterns);
+}();
+
 const std::vector<std::string> enigmaPatterns =
 {
 	"60E8000000005D81ED--------81ED--------E9;",
@@ -85,14 +96,42 @@ const std::vector<std::string> enigmaPatterns =
 	"558BEC83C4--B8--------E8--------9A------------/60E8000000005D--ED;"
 };
 
-const std::vector<std::string> dotNetShrinkPatterns =
+const std::vector<std::string> mprmmgvaPatterns =
+{
+	"64FF3500000000",
+	"64892500000000"
+};
+
+const SignatureMatcher mprmmgvaMatcher(mprmmgvaPatterns);
+
+const std::vector<std::string> ezirizReactorPatterns =
+{
+	"558BECB90F0000006A006A004975F951535657B8--------E8;",
+	"5266686E204D182276B5331112330C6D0A204D18229EA129611C76B505190158;"
+};
+
+const SignatureMatcher ezirizReactorMatcher(ezirizReactorPatterns);
+
+/// Patterns of .NET tools searched in the first section. The first three
+/// are Phoenix, AssemblyInvoke and CliSecure, the rest are .netshrink ones.
+const std::vector<std::string> dotNetToolPatterns =
 {
+	"0000010B160C----------0208----------0D0906085961D21304091E630861D21305070811051E62110460D19D081758;",
+	"282D00000A6F2E00000A14146F2F00000A;",
+	"436C69005300650063007500720065;",
 	"20FE2B136028--------13--203B28136028--------13--11--11--161F4028--------26;",
 	"20AD65133228--------13--206866133228--------13--11--11--161F4028--------26;",
 	"20B9059F0728--------13--2066059F0728--------13--11--11--161F4028--------26;",
 	"20E6EA19BE28--------13--2039EA19BE28--------13--11--11--161F4028--------26;"
 };
 
+const std::size_t phoenixPatternIndex = 0;
+const std::size_t assemblyInvokePatternIndex = 1;
+const std::size_t cliSecurePatternIndex = 2;
+const std::size_t firstDotNetShrinkPatternIndex = 3;
+
+const SignatureMatcher dotNetToolsMatcher(dotNetToolPatterns);
+
 const std::string msvcRuntimeString = "Microsoft Visual C++ Runtime Library";
 
 const std::vector<std::string> msvcRuntimeStrings =
@@ -434,7 +473,9 @@ void PeHeuristics::getSlashedSignatures()
 		return;
 	}
 
+	// All signatures are searched in one pass over the scanned area
 	const auto stopOffset = toolInfo.epOffset + LIGHTWEIGHT_FILE_SCAN_AREA;
+	std::vector<SignatureMatcher::Area> areas;
 	for (const auto &sig : x86SlashedSignatures)
 	{
 		auto start = toolInfo.epOffset;
@@ -455,7 +496,15 @@ void PeHeuristics::getSlashedSignatures()
 			);
 		}
 
-		const auto nibbles = search.findSlashedSignature(sig.pattern, start, end);
+		areas.push_back({start, end});
+	}
+
+	std::vector<unsigned long long> result;
+	x86SlashedSignaturesMatcher.findPatterns(search, areas, result);
+	for (std::size_t i = 0, e = x86SlashedSignatures.size(); i < e; ++i)
+	{
+		const auto &sig = x86SlashedSignatures[i];
+		const auto nibbles = result[i];
 		if (nibbles)
 		{
 			addPacker(nibbles, nibbles, sig.name, sig.version, sig.additional);
@@ -732,22 +781,25 @@ void PeHeuristics::getMPRMMGVAHeuristics()
 	{
 		if (search.exactComparison("892504----00", toolInfo.epOffset))
 		{
-			offset1 = search.findUnslashedSignature(
-					"64FF3500000000",
-					toolInfo.epOffset,
-					toolInfo.epOffset + 0x80);
-			if (offset1 != 0)
+			// The second pattern is searched behind the number of significant
+			// nibbles of the first one, which does not depend on where the
+			// first one is found, so both are searched in one pass
+			offset1 = search.countImpNibbles(mprmmgvaPatterns[0]);
+			std::vector<unsigned long long> result;
+			mprmmgvaMatcher.findPatterns(
+					search,
+					{
+						{toolInfo.epOffset, toolInfo.epOffset + 0x80},
+						{toolInfo.epOffset + offset1,
+							toolInfo.epOffset + offset1 + 0x40}
+					},
+					result);
+			if (result[0] && result[1])
 			{
-				if (search.findUnslashedSignature(
-						"64892500000000",
-						toolInfo.epOffset + offset1,
-						toolInfo.epOffset + offset1 + 0x40))
-				{
-					addPacker(
-							DetectionMethod::STRING_SEARCH_H,
-							DetectionStrength::HIGH,
-							"MPRMMGVA");
-				}
+				addPacker(
+						DetectionMethod::STRING_SEARCH_H,
+						DetectionStrength::HIGH,
+						"MPRMMGVA");
 			}
 		}
 	}
@@ -842,20 +894,28 @@ void PeHeuristics::getEzirizReactorHeuristics()
 		const auto *sec0 = peParser.getPeSection(0);
 		const auto *sec1 = peParser.getPeSection(1);
 
-		if (sec0
-				&& search.findUnslashedSignature(
-						"558BECB90F0000006A006A004975F951535657B8--------E8;",
-						sec0->getOffset(),
-						sec0->getOffset() + sec0->getLoadedSize() - 1))
+		// Areas of sections which are not searched are left empty
+		std::vector<SignatureMatcher::Area> areas(2, {1, 0});
+		if (sec0)
+		{
+			areas[0] = {
+					sec0->getOffset(),
+					sec0->getOffset() + sec0->getLoadedSize() - 1};
+		}
+		if (sec1 && sec1->getPeCoffFlags() == 0xC0000040)
+		{
+			areas[1] = {
+					sec1->getOffset(),
+					sec1->getOffset() + sec1->getLoadedSize() - 1};
+		}
+		std::vector<unsigned long long> result;
+		ezirizReactorMatcher.findPatterns(search, areas, result);
+
+		if (result[0])
 		{
 			version = "3.X";
 		}
-		else if (sec1
-				&& sec1->getPeCoffFlags() == 0xC0000040
-				&& search.findUnslashedSignature(
-						"5266686E204D182276B5331112330C6D0A204D18229EA129611C76B505190158;",
-						sec1->getOffset(),
-						sec1->getOffset() + sec1->getLoadedSize() - 1))
+		else if (result[1])
 		{
 			version = "4.0.0.0 - 6.0.0.0";
 		}
@@ -1220,9 +1280,15 @@ void PeHeuristics::getNetHeuristic()
 		const auto start = sec->getOffset();
 		const auto end = start + sec->getLoadedSize() - 1;
 
-		const std::string sig =
-			"0000010B160C----------0208----------0D0906085961D21304091E630861D21305070811051E62110460D19D081758;";
-		if (search.findUnslashedSignature(sig, start, end))
+		std::vector<unsigned long long> result;
+		dotNetToolsMatcher.findPatterns(
+				search,
+				std::vector<SignatureMatcher::Area>(
+						dotNetToolPatterns.size(),
+						{start, end}),
+				result);
+
+		if (result[phoenixPatternIndex])
 		{
 			version = "1.7 - 1.8";
 		}
@@ -1235,27 +1301,20 @@ void PeHeuristics::getNetHeuristic()
 			addPacker(source, strength, "Phoenix", version);
 		}
 
-		if (search.findUnslashedSignature(
-				"282D00000A6F2E00000A14146F2F00000A;",
-				start,
-				end))
+		if (result[assemblyInvokePatternIndex])
 		{
 			addPacker(source, strength, "AssemblyInvoke");
 		}
 
-		if (search.findUnslashedSignature(
-				"436C69005300650063007500720065;",
-				start,
-				end))
+		if (result[cliSecurePatternIndex])
 		{
 			addPacker(source, strength, "CliSecure");
 		}
 
-		// Note: Before modifying the following loop to std::any_of(),
-		//       please see #231 (compilation bug with GCC 5).
-		for (const auto& str : dotNetShrinkPatterns)
+		for (std::size_t i = firstDotNetShrinkPatternIndex, e = result.size();
+				i < e; ++i)
 		{
-			if (search.findUnslashedSignature(str, start, end))
+			if (result[i])
 			{
 				addPacker(source, strength, ".netshrink", "2.01 (demo)");
 				break;
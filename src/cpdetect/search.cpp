@@ -37,6 +37,16 @@ const std::map<Architecture, std::vector<Search::RelativeJump>> jumpMap =
 	},
 };
 
+/**
+ * Get the lower nibble of @a value as uppercase hexadecimal digit
+ * @param value Value to convert
+ * @return Hexadecimal digit
+ */
+char hexDigit(unsigned char value)
+{
+	return "0123456789ABCDEF"[value & 0x0F];
+}
+
 } // anonymous namespace
 
 /**
@@ -47,12 +57,44 @@ Search::Search(retdec::fileformat::FileFormat &fileParser)
 		: parser(fileParser)
 		, averageSlashLen(0)
 {
-	const auto &bytes = parser.getLoadedBytes();
-	bytesToHexString(bytes, nibbles);
-	bytesToString(bytes, plain);
-	fileLoaded = !bytes.empty();
-	fileSupported = parser.hexToLittle(nibbles)
-			&& parser.getNumberOfNibblesInByte();
+	const auto loadedBytes = parser.getLoadedBytes();
+	bytesToString(loadedBytes.data(), loadedBytes.size(), plain);
+	fileLoaded = !loadedBytes.empty();
+	bytes = loadedBytes;
+
+	// Signatures are in little endian, so bytes in words of big endian files
+	// must be swapped. Search works only with bytes of two nibbles.
+	fileSupported = true;
+	if (parser.getNumberOfNibblesInByte() != 2)
+	{
+		bytes = {};
+		fileSupported = false;
+	}
+	else if (parser.isBigEndian())
+	{
+		const auto wordSize = parser.getBytesPerWord();
+		if (wordSize && loadedBytes.size() >= wordSize)
+		{
+			swappedBytes.assign(
+					loadedBytes.begin(),
+					loadedBytes.end() - loadedBytes.size() % wordSize);
+			for (auto it = swappedBytes.begin(); it != swappedBytes.end();
+					it += wordSize)
+			{
+				std::reverse(it, it + wordSize);
+			}
+			bytes = swappedBytes;
+		}
+		else
+		{
+			fileSupported = false;
+		}
+	}
+	else if (!parser.isLittleEndian())
+	{
+		fileSupported = false;
+	}
+
 	jumps = mapGetValueOrDefault(
 			jumpMap,
 			parser.getTargetArchitecture(),
@@ -145,6 +187,74 @@ std::size_t Search::bytesFromNibbles(std::size_t nNibbles) const
 	return parser.bytesFromNibbles(nNibbles);
 }
 
+/**
+ * Get number of nibbles in content of file
+ * @return Number of nibbles in content of file
+ */
+std::size_t Search::getNumberOfNibbles() const
+{
+	return bytes.size() * 2;
+}
+
+/**
+ * Get matcher of single signature pattern
+ * @param signPattern Signature pattern
+ * @return Matcher of @a signPattern
+ *
+ * Matchers are compiled only once for each pattern. Sets of patterns searched
+ * in the same areas should be rather searched by one shared matcher.
+ */
+const SignatureMatcher& Search::getMatcher(const std::string &signPattern) const
+{
+	auto &matcher = matchers[signPattern];
+	if (!matcher)
+	{
+		matcher = std::make_unique<SignatureMatcher>(
+				std::vector<std::string>{signPattern});
+	}
+
+	return *matcher;
+}
+
+/**
+ * Get nibble of content of file as hexadecimal digit
+ * @param nibbleIndex Index of nibble (the high nibble of each byte is first)
+ * @return Nibble on index @a nibbleIndex as uppercase hexadecimal digit
+ */
+char Search::getNibble(std::size_t nibbleIndex) const
+{
+	const auto byte = bytes[nibbleIndex / 2];
+	return hexDigit(nibbleIndex % 2 ? byte : byte >> 4);
+}
+
+/**
+ * Check if content of file has given nibbles on specified position
+ * @param hexNibbles Nibbles as uppercase hexadecimal digits
+ * @param nibbleIndex Index of the first nibble
+ * @return @c true if nibbles on @a nibbleIndex are @a hexNibbles,
+ *    @c false otherwise
+ */
+bool Search::hasNibblesOnPosition(
+		const std::string &hexNibbles,
+		std::size_t nibbleIndex) const
+{
+	if (nibbleIndex >= getNumberOfNibbles()
+			|| hexNibbles.size() > getNumberOfNibbles() - nibbleIndex)
+	{
+		return false;
+	}
+
+	for (std::size_t i = 0, e = hexNibbles.size(); i < e; ++i)
+	{
+		if (getNibble(nibbleIndex + i) != hexNibbles[i])
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
 /**
  * Check if input file was successfully loaded
  * @return @c true if file was successfully loaded, @c false otherwise
@@ -164,12 +274,12 @@ bool Search::isFileSupported() const
 }
 
 /**
- * Get content of file in hexadecimal string representation
- * @return Content of file in hexadecimal string representation
+ * Get content of file in little endian
+ * @return Content of file in little endian
  */
-const std::string& Search::getNibbles() const
+llvm::ArrayRef<unsigned char> Search::getBytes() const
 {
-	return nibbles;
+	return bytes;
 }
 
 /**
@@ -201,9 +311,9 @@ const Search::RelativeJump* Search::getRelativeJump(
 	for (const auto &jump : jumps)
 	{
 		const auto nibblesAfter = nibblesFromBytes(jump.getBytesAfter());
-		if (!hasSubstringOnPosition(nibbles, jump.getSlash(), nibbleOffset)
+		if (!hasNibblesOnPosition(jump.getSlash(), nibbleOffset)
 				|| (nibbleOffset + jump.getSlashNibbleSize() + nibblesAfter - 1
-						>= nibbles.length()))
+						>= getNumberOfNibbles()))
 		{
 			continue;
 		}
@@ -282,31 +392,7 @@ unsigned long long Search::findUnslashedSignature(
 		std::size_t startOffset,
 		std::size_t stopOffset) const
 {
-	if (startOffset > stopOffset)
-	{
-		return 0;
-	}
-
-	const auto startIterator = nibbles.begin() + nibblesFromBytes(startOffset);
-	const auto stopIndex = nibblesFromBytes(stopOffset) + 1;
-	const auto stopIterator = stopIndex < nibbles.size()
-			? nibbles.begin() + stopIndex
-			: nibbles.end();
-	const auto it = std::search(
-			startIterator,
-			stopIterator,
-			signPattern.begin(),
-			signPattern.end(),
-			[] (const char fileNibble, const char signatureNibble)
-			{
-				return fileNibble == signatureNibble
-						|| signatureNibble == '-'
-						|| signatureNibble == '?'
-						|| signatureNibble == ';';
-			}
-	);
-
-	return (it != stopIterator) ? countImpNibbles(signPattern) : 0;
+	return findSlashedSignature(signPattern, startOffset, stopOffset);
 }
 
 /**
@@ -322,30 +408,12 @@ unsigned long long Search::findSlashedSignature(
 		std::size_t startOffset,
 		std::size_t stopOffset) const
 {
-	if (startOffset > stopOffset)
-	{
-		return 0;
-	}
-
-	const auto areaSize = nibblesFromBytes(stopOffset - startOffset + 1);
-	const auto signSize = signPattern.length()
-			- std::count(signPattern.begin(), signPattern.end(), ';');
-	if (areaSize < signSize)
-	{
-		return false;
-	}
-	const auto iters = startOffset == stopOffset ? 1 : areaSize - signSize + 1;
-
-	for (std::size_t i = 0; i < iters; ++i)
-	{
-		const auto result = exactComparison(signPattern, startOffset, i);
-		if (result)
-		{
-			return result;
-		}
-	}
-
-	return 0;
+	std::vector<unsigned long long> result;
+	getMatcher(signPattern).findPatterns(
+			*this,
+			{{startOffset, stopOffset}},
+			result);
+	return result.front();
 }
 
 /**
@@ -363,7 +431,7 @@ unsigned long long Search::exactComparison(
 {
 	for (std::size_t sigIndex = 0,
 			fileIndex = nibblesFromBytes(fileOffset) + shift,
-			fileLen = nibbles.length()
+			fileLen = getNumberOfNibbles()
 			;
 			fileIndex < fileLen
 			;
@@ -398,7 +466,7 @@ unsigned long long Search::exactComparison(
 					+ moveSize
 					- 1;
 		}
-		else if (signPattern[sigIndex] != nibbles[fileIndex]
+		else if (signPattern[sigIndex] != getNibble(fileIndex)
 				&& signPattern[sigIndex] != '-'
 				&& signPattern[sigIndex] != '?')
 		{
@@ -430,7 +498,7 @@ bool Search::countSimilarity(
 
 	for (std::size_t sigIndex = 0,
 			fileIndex = nibblesFromBytes(fileOffset) + shift,
-			fileLen = nibbles.length()
+			fileLen = getNumberOfNibbles()
 			;
 			fileIndex < fileLen
 			;
@@ -475,7 +543,7 @@ bool Search::countSimilarity(
 			}
 			continue;
 		}
-		else if (signPattern[sigIndex] == nibbles[fileIndex])
+		else if (signPattern[sigIndex] == getNibble(fileIndex))
 		{
 			++result.same;
 		}
@@ -641,7 +709,7 @@ bool Search::createSignature(
 
 	for (std::size_t i = 0,
 			fileIndex = nibblesFromBytes(fileOffset),
-			fileLen = nibbles.length(),
+			fileLen = getNumberOfNibbles(),
 			nibbleSize = nibblesFromBytes(size)
 			;
 			fileIndex < fileLen && i < nibbleSize
@@ -664,7 +732,7 @@ bool Search::createSignature(
 		}
 		else
 		{
-			pattern += nibbles[fileIndex];
+			pattern += getNibble(fileIndex);
 		}
 	}
 
@@ -0,0 +1,434 @@
+/**
+ * @file src/cpdetect/signature_matcher.cpp
+ * @brief Matcher of several signature patterns in one pass over file.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <deque>
+#include <limits>
+
+#include "retdec/cpdetect/search.h"
+#include "retdec/cpdetect/signature_matcher.h"
+
+namespace retdec {
+namespace cpdetect {
+
+namespace
+{
+
+/// maximal length of anchor inserted into automaton (in bytes)
+const std::size_t MAX_ANCHOR_LENGTH = 8;
+
+/// marker of missing transition during construction of automaton
+const std::uint32_t NO_STATE = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * Get value of hexadecimal digit in signature pattern
+ * @param c Uppercase hexadecimal digit
+ * @param value Into this parameter is stored value of @a c
+ * @return @c true if @a c is valid digit, @c false otherwise
+ */
+bool getNibbleValue(char c, std::uint8_t &value)
+{
+	if (c >= '0' && c <= '9')
+	{
+		value = c - '0';
+		return true;
+	}
+	else if (c >= 'A' && c <= 'F')
+	{
+		value = c - 'A' + 10;
+		return true;
+	}
+
+	return false;
+}
+
+} // anonymous namespace
+
+/**
+ * Constructor
+ * @param signPatterns Signature patterns
+ */
+SignatureMatcher::SignatureMatcher(const std::vector<std::string> &signPatterns)
+		: numberOfPatterns(signPatterns.size())
+{
+	// Both variants of each pattern are stored next to each other
+	patterns.reserve(2 * signPatterns.size());
+	for (std::size_t i = 0, e = signPatterns.size(); i < e; ++i)
+	{
+		for (std::size_t shift = 0; shift < 2; ++shift)
+		{
+			CompiledPattern compiledPattern;
+			compiledPattern.pattern = signPatterns[i];
+			compiledPattern.index = i;
+			compiledPattern.shift = shift;
+			compiledPattern.compiled = compilePattern(compiledPattern);
+			patterns.push_back(std::move(compiledPattern));
+		}
+	}
+
+	buildAutomaton();
+}
+
+/**
+ * Compile signature pattern into masked bytes
+ * @param compiledPattern Pattern to compile
+ * @return @c true if pattern was compiled, @c false if it cannot be matched
+ *    on byte boundaries
+ */
+bool SignatureMatcher::compilePattern(CompiledPattern &compiledPattern)
+{
+	const auto pattern = std::string(compiledPattern.shift, '-')
+			+ compiledPattern.pattern;
+	compiledPattern.nibbleLength = pattern.length()
+			- std::count(pattern.begin(), pattern.end(), ';');
+	compiledPattern.parts.emplace_back();
+	auto highNibble = true;
+
+	for (const auto c : pattern)
+	{
+		if (c == ';')
+		{
+			break;
+		}
+		else if (c == '/')
+		{
+			if (!highNibble)
+			{
+				return false;
+			}
+
+			compiledPattern.parts.emplace_back();
+			continue;
+		}
+
+		std::uint8_t value = 0, mask = 0;
+		if (c != '-' && c != '?')
+		{
+			if (!getNibbleValue(c, value))
+			{
+				return false;
+			}
+			mask = 0x0F;
+		}
+
+		auto &part = compiledPattern.parts.back();
+		if (highNibble)
+		{
+			part.push_back({
+					static_cast<std::uint8_t>(value << 4),
+					static_cast<std::uint8_t>(mask << 4)});
+		}
+		else
+		{
+			part.back().value |= value;
+			part.back().mask |= mask;
+		}
+		highNibble = !highNibble;
+	}
+
+	// The longest run of fixed bytes before the first slash is the anchor
+	const auto &firstPart = compiledPattern.parts.front();
+	for (std::size_t i = 0, e = firstPart.size(); i < e; )
+	{
+		if (firstPart[i].mask != 0xFF)
+		{
+			++i;
+			continue;
+		}
+
+		auto j = i;
+		while (j < e && firstPart[j].mask == 0xFF)
+		{
+			++j;
+		}
+
+		if (j - i > compiledPattern.anchorLength)
+		{
+			compiledPattern.anchorOffset = i;
+			compiledPattern.anchorLength = j - i;
+		}
+		i = j;
+	}
+	compiledPattern.anchorLength = std::min(
+			compiledPattern.anchorLength,
+			MAX_ANCHOR_LENGTH);
+
+	return true;
+}
+
+/**
+ * Build Aho-Corasick automaton from anchors of compiled patterns
+ */
+void SignatureMatcher::buildAutomaton()
+{
+	states.emplace_back();
+	states[0].next.fill(NO_STATE);
+
+	// Trie of anchors
+	for (std::size_t i = 0, e = patterns.size(); i < e; ++i)
+	{
+		const auto &compiledPattern = patterns[i];
+		if (!compiledPattern.compiled || !compiledPattern.anchorLength)
+		{
+			continue;
+		}
+
+		std::uint32_t state = 0;
+		const auto &firstPart = compiledPattern.parts.front();
+		for (std::size_t j = 0; j < compiledPattern.anchorLength; ++j)
+		{
+			const auto byte = firstPart[compiledPattern.anchorOffset + j].value;
+			if (states[state].next[byte] == NO_STATE)
+			{
+				states[state].next[byte] = states.size();
+				states.emplace_back();
+				states.back().next.fill(NO_STATE);
+			}
+			state = states[state].next[byte];
+		}
+		states[state].outputs.push_back(i);
+	}
+
+	// Failure transitions are computed in breadth-first order and merged
+	// into transitions, so each byte of file is processed in constant time
+	std::vector<std::uint32_t> failures(states.size(), 0);
+	std::deque<std::uint32_t> queue;
+	for (auto &next : states[0].next)
+	{
+		if (next == NO_STATE)
+		{
+			next = 0;
+		}
+		else
+		{
+			queue.push_back(next);
+		}
+	}
+
+	while (!queue.empty())
+	{
+		const auto state = queue.front();
+		queue.pop_front();
+
+		const auto failure = failures[state];
+		states[state].outputs.insert(
+				states[state].outputs.end(),
+				states[failure].outputs.begin(),
+				states[failure].outputs.end());
+
+		for (std::size_t byte = 0; byte < 256; ++byte)
+		{
+			auto &next = states[state].next[byte];
+			if (next == NO_STATE)
+			{
+				next = states[failure].next[byte];
+			}
+			else
+			{
+				failures[next] = states[failure].next[byte];
+				queue.push_back(next);
+			}
+		}
+	}
+}
+
+/**
+ * Check if compiled pattern matches content of file on given offset
+ * @param search Search engine of file
+ * @param compiledPattern Compiled pattern
+ * @param offset Offset in file (in bytes)
+ * @return @c true if pattern matches, @c false otherwise
+ */
+bool SignatureMatcher::matchesAt(
+		const Search &search,
+		const CompiledPattern &compiledPattern,
+		std::size_t offset) const
+{
+	const auto bytes = search.getBytes();
+	auto position = offset;
+
+	for (std::size_t i = 0, e = compiledPattern.parts.size(); i < e; ++i)
+	{
+		// Slashes are ignored if no jumps are defined for target architecture
+		if (i && search.haveSlashes())
+		{
+			std::int64_t moveSize = 0;
+			const auto *jump = search.getRelativeJump(position, 0, moveSize);
+			if (!jump)
+			{
+				return false;
+			}
+
+			// Size of jump and slash is in nibbles
+			const auto newPosition = static_cast<std::int64_t>(position
+					+ jump->getSlashNibbleSize() / 2
+					+ jump->getBytesAfter())
+					+ moveSize / 2;
+			if (newPosition < 0)
+			{
+				return false;
+			}
+			position = newPosition;
+		}
+
+		const auto &part = compiledPattern.parts[i];
+		if (position > bytes.size() || part.size() > bytes.size() - position)
+		{
+			return false;
+		}
+
+		for (const auto &byte : part)
+		{
+			if ((bytes[position++] & byte.mask) != byte.value)
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+/**
+ * Get number of patterns
+ * @return Number of patterns
+ */
+std::size_t SignatureMatcher::getNumberOfPatterns() const
+{
+	return numberOfPatterns;
+}
+
+/**
+ * Find patterns in their areas of file
+ * @param search Search engine of file
+ * @param areas Area of file for each pattern
+ * @param result Into this parameter is stored number of significant nibbles
+ *    of each pattern or zero if pattern was not found in its area
+ *
+ * Pattern is found if it starts in its area on such nibble that the whole
+ * pattern (with each slash counted as one nibble) fits into the area.
+ * Patterns without area are not searched.
+ */
+void SignatureMatcher::findPatterns(
+		const Search &search,
+		const std::vector<Area> &areas,
+		std::vector<unsigned long long> &result) const
+{
+	result.assign(numberOfPatterns, 0);
+	const auto bytes = search.getBytes();
+	if (bytes.empty())
+	{
+		return;
+	}
+
+	// Range of offsets on which each anchored pattern may start
+	std::vector<std::pair<std::size_t, std::size_t>> starts(
+			patterns.size(),
+			{1, 0});
+	auto scanStart = bytes.size(), scanEnd = std::size_t(0);
+	std::size_t pending = 0;
+
+	const auto found = [&](const CompiledPattern &compiledPattern)
+	{
+		result[compiledPattern.index] = search.countImpNibbles(
+				compiledPattern.pattern);
+
+		// The other variant of the pattern need not be searched any more
+		for (std::size_t shift = 0; shift < 2; ++shift)
+		{
+			auto &start = starts[2 * compiledPattern.index + shift];
+			if (start.first <= start.second)
+			{
+				start = {1, 0};
+				--pending;
+			}
+		}
+	};
+
+	for (std::size_t i = 0, e = patterns.size(); i < e; ++i)
+	{
+		const auto &compiledPattern = patterns[i];
+		if (compiledPattern.index >= areas.size()
+				|| result[compiledPattern.index])
+		{
+			continue;
+		}
+
+		const auto &area = areas[compiledPattern.index];
+		if (area.startOffset > area.stopOffset
+				|| area.startOffset >= bytes.size())
+		{
+			continue;
+		}
+
+		const auto areaSize = area.stopOffset - area.startOffset + 1;
+		const auto patternSize = (compiledPattern.nibbleLength + 1) / 2;
+		if (areaSize < patternSize)
+		{
+			continue;
+		}
+
+		const auto first = area.startOffset;
+		const auto last = std::min(
+				first + (areaSize - patternSize),
+				bytes.size() - 1);
+		if (!compiledPattern.compiled || !compiledPattern.anchorLength)
+		{
+			for (auto offset = first; offset <= last; ++offset)
+			{
+				const auto matches = compiledPattern.compiled
+						? matchesAt(search, compiledPattern, offset)
+						: search.exactComparison(
+								compiledPattern.pattern,
+								offset,
+								compiledPattern.shift);
+				if (matches)
+				{
+					found(compiledPattern);
+					break;
+				}
+			}
+			continue;
+		}
+
+		starts[i] = {first, last};
+		scanStart = std::min(scanStart, first + compiledPattern.anchorOffset);
+		scanEnd = std::max(
+				scanEnd,
+				std::min(
+						last
+							+ compiledPattern.anchorOffset
+							+ compiledPattern.anchorLength,
+						bytes.size()));
+		++pending;
+	}
+
+	std::uint32_t state = 0;
+	for (auto position = scanStart; pending && position < scanEnd; ++position)
+	{
+		state = states[state].next[bytes[position]];
+		for (const auto i : states[state].outputs)
+		{
+			const auto &compiledPattern = patterns[i];
+			const auto anchorEnd = compiledPattern.anchorOffset
+					+ compiledPattern.anchorLength;
+			if (position + 1 < anchorEnd)
+			{
+				continue;
+			}
+
+			const auto offset = position + 1 - anchorEnd;
+			if (offset >= starts[i].first && offset <= starts[i].second
+					&& matchesAt(search, compiledPattern, offset))
+			{
+				found(compiledPattern);
+			}
+		}
+	}
+}
+
+} // namespace cpdetect
+} // namespace retdec
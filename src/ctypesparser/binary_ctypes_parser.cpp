@@ -0,0 +1,543 @@
+/**
+* @file src/ctypesparser/binary_ctypes_parser.cpp
+* @brief Lazy parser for C-types from binary files.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <cassert>
+#include <cstring>
+
+#include "retdec/ctypes/ctypes.h"
+#include "retdec/ctypesparser/binary_ctypes_format.h"
+#include "retdec/ctypesparser/binary_ctypes_parser.h"
+#include "retdec/utils/memory_mapped_file.h"
+#include "retdec/utils/string.h"
+
+using namespace retdec::ctypesparser::binary_ctypes;
+
+namespace {
+
+const std::string CORRUPTED_FILE = "Corrupted binary C-types file.";
+
+} // anonymous namespace
+
+namespace retdec {
+namespace ctypesparser {
+
+/**
+* @brief Creates new binary C-types parser.
+*/
+BinaryCTypesParser::BinaryCTypesParser() = default;
+
+/**
+* @brief Creates new binary C-types parser.
+*
+* @param defaultBitWidth BitWidth used for types that are not in typeWidths.
+*/
+BinaryCTypesParser::BinaryCTypesParser(unsigned defaultBitWidth):
+	CTypesParser(defaultBitWidth) {}
+
+BinaryCTypesParser::~BinaryCTypesParser() = default;
+
+/**
+* @brief Opens binary C-types file @a path. Functions from the file are parsed
+*        into @a module when they are requested.
+*
+* @param[in] path Path to the file.
+* @param[in] module Module into which functions are parsed.
+* @param[in] typeWidths C-types' bit widths.
+* @param[in] callConvention Function call convention.
+*
+* @throw CTypesParseError when the file cannot be opened or it is corrupted.
+*
+* The module has to outlive this parser.
+*/
+void BinaryCTypesParser::openInto(
+	const std::string &path,
+	std::unique_ptr<retdec::ctypes::Module> &module,
+	const CTypesParser::TypeWidths &typeWidths,
+	const retdec::ctypes::CallConvention &callConvention)
+{
+	auto mappedFile = std::make_unique<retdec::utils::MemoryMappedFile>(path);
+	if (!mappedFile->isOpen())
+	{
+		throw CTypesParseError("Failed to open binary C-types file: " + path);
+	}
+
+	openInto(
+		mappedFile->getData(),
+		mappedFile->getSize(),
+		module,
+		typeWidths,
+		callConvention
+	);
+	file = std::move(mappedFile);
+}
+
+/**
+* @brief Opens binary C-types file stored in memory. Functions from the file
+*        are parsed into @a module when they are requested.
+*
+* @param[in] data Content of the file.
+* @param[in] size Size of the file.
+* @param[in] module Module into which functions are parsed.
+* @param[in] typeWidths C-types' bit widths.
+* @param[in] callConvention Function call convention.
+*
+* @throw CTypesParseError when the file is corrupted.
+*
+* Both @a data and the module have to outlive this parser.
+*/
+void BinaryCTypesParser::openInto(
+	const std::uint8_t *data,
+	std::size_t size,
+	std::unique_ptr<retdec::ctypes::Module> &module,
+	const CTypesParser::TypeWidths &typeWidths,
+	const retdec::ctypes::CallConvention &callConvention)
+{
+	assert(module && "violated precondition - module cannot be null");
+
+	this->file.reset();
+	this->data = data;
+	this->size = size;
+	this->module = module.get();
+	context = module->getContext();
+	defaultCallConv = callConvention;
+	this->typeWidths = typeWidths;
+	parsedTypes.clear();
+
+	if (size < 4 * HeaderWord::Count
+		|| readWord(4 * HeaderWord::Magic) != MAGIC
+		|| readWord(4 * HeaderWord::Version) != VERSION)
+	{
+		this->data = nullptr;
+		this->size = 0;
+		throw CTypesParseError("Not a binary C-types file.");
+	}
+
+	functionsOffset = readWord(4 * HeaderWord::FunctionsOffset);
+	functionsCount = readWord(4 * HeaderWord::FunctionsCount);
+	namedTypesOffset = readWord(4 * HeaderWord::NamedTypesOffset);
+	namedTypesCount = readWord(4 * HeaderWord::NamedTypesCount);
+	typesOffset = readWord(4 * HeaderWord::TypesOffset);
+	typesCount = readWord(4 * HeaderWord::TypesCount);
+
+	if (functionsOffset + 8 * std::uint64_t(functionsCount) > size
+		|| namedTypesOffset + 8 * std::uint64_t(namedTypesCount) > size
+		|| typesOffset + 4 * std::uint64_t(typesCount) > size)
+	{
+		this->data = nullptr;
+		this->size = 0;
+		throw CTypesParseError(CORRUPTED_FILE);
+	}
+
+	parsedTypes.resize(typesCount);
+}
+
+/**
+* @brief Sets parsers of files that were opened into the same module before
+*        this one.
+*
+* Named types from these files take precedence over named types from this
+* file, even if they have not been parsed yet.
+*/
+void BinaryCTypesParser::setPreviousParsers(
+	const std::vector<BinaryCTypesParser*> &parsers)
+{
+	previousParsers = parsers;
+}
+
+/**
+* @brief Returns number of functions in the opened file.
+*/
+std::size_t BinaryCTypesParser::getFunctionCount() const
+{
+	return functionsCount;
+}
+
+/**
+* @brief Checks if the opened file contains function @a name.
+*/
+bool BinaryCTypesParser::hasFunction(const std::string &name) const
+{
+	return findInIndex(functionsOffset, functionsCount, name) != functionsCount;
+}
+
+/**
+* @brief Returns function @a name and adds it into the module.
+*
+* @return Requested function or @c nullptr if the file does not contain it.
+*
+* When the module already contains a function with the same name (e.g. from
+* a previously opened file), that function is returned.
+*/
+std::shared_ptr<retdec::ctypes::Function> BinaryCTypesParser::getFunction(
+	const std::string &name)
+{
+	auto i = findInIndex(functionsOffset, functionsCount, name);
+	if (i == functionsCount)
+	{
+		return nullptr;
+	}
+
+	auto function = context->getFunctionWithName(name);
+	if (!function)
+	{
+		function = parseFunction(name, readWord(functionsOffset + 8 * i + 4));
+	}
+	module->addFunction(function);
+	return function;
+}
+
+/**
+* @brief Returns named type @a name from the opened file.
+*
+* @return Requested type or @c nullptr if the file does not contain it.
+*/
+std::shared_ptr<retdec::ctypes::Type> BinaryCTypesParser::getNamedType(
+	const std::string &name)
+{
+	auto i = findInIndex(namedTypesOffset, namedTypesCount, name);
+	if (i == namedTypesCount)
+	{
+		return nullptr;
+	}
+
+	return getOrParseType(readWord(namedTypesOffset + 8 * i + 4));
+}
+
+/**
+* @brief Returns little-endian word on @a offset.
+*
+* @throw CTypesParseError when the word is outside of the file.
+*/
+std::uint32_t BinaryCTypesParser::readWord(std::size_t offset) const
+{
+	if (offset > size || size - offset < 4)
+	{
+		throw CTypesParseError(CORRUPTED_FILE);
+	}
+
+	const auto *p = data + offset;
+	return std::uint32_t(p[0])
+		| std::uint32_t(p[1]) << 8
+		| std::uint32_t(p[2]) << 16
+		| std::uint32_t(p[3]) << 24;
+}
+
+/**
+* @brief Returns string on @a offset.
+*/
+std::string BinaryCTypesParser::readString(std::uint32_t offset) const
+{
+	return std::string(readStringView(offset));
+}
+
+/**
+* @brief Returns string on @a offset without copying it.
+*
+* @throw CTypesParseError when the string is outside of the file.
+*/
+std::string_view BinaryCTypesParser::readStringView(std::uint32_t offset) const
+{
+	auto length = readWord(offset);
+	if (size - offset - 4 < length)
+	{
+		throw CTypesParseError(CORRUPTED_FILE);
+	}
+	return std::string_view(
+		reinterpret_cast<const char*>(data + offset + 4), length);
+}
+
+/**
+* @brief Finds @a name in index sorted by names.
+*
+* @param indexOffset Offset of the index.
+* @param count Number of (name, value) pairs in the index.
+* @param name Name to find.
+*
+* @return Position of @a name in the index or @a count if it is not there.
+*/
+std::size_t BinaryCTypesParser::findInIndex(
+	std::uint32_t indexOffset,
+	std::uint32_t count,
+	const std::string &name) const
+{
+	std::size_t low = 0;
+	std::size_t high = count;
+	while (low < high)
+	{
+		auto middle = low + (high - low) / 2;
+		auto middleName = readStringView(readWord(indexOffset + 8 * middle));
+		auto cmp = middleName.compare(name);
+		if (cmp == 0)
+		{
+			return middle;
+		}
+		else if (cmp < 0)
+		{
+			low = middle + 1;
+		}
+		else
+		{
+			high = middle;
+		}
+	}
+	return count;
+}
+
+/**
+* @brief Parses function record on @a offset.
+*
+* @param name Name of the function.
+* @param offset Offset of the function record.
+*/
+std::shared_ptr<retdec::ctypes::Function> BinaryCTypesParser::parseFunction(
+	const std::string &name,
+	std::uint32_t offset)
+{
+	auto declaration = readString(readWord(offset + 4));
+	auto header = readString(readWord(offset + 8));
+	auto callConv = parseCallConv(readWord(offset + 12));
+	auto returnType = getOrParseType(readWord(offset + 16));
+	auto varArgness = readWord(offset + 20)
+		? retdec::ctypes::FunctionType::VarArgness::IsVarArg
+		: retdec::ctypes::FunctionType::VarArgness::IsNotVarArg;
+
+	retdec::ctypes::Function::Parameters parameters;
+	auto paramCount = readWord(offset + 24);
+	std::size_t paramOffset = std::size_t(offset) + 28;
+	for (std::uint32_t i = 0; i < paramCount; ++i, paramOffset += 12)
+	{
+		auto paramName = readString(readWord(paramOffset));
+		auto paramType = getOrParseType(readWord(paramOffset + 4));
+		auto annotationStr = readString(readWord(paramOffset + 8));
+		retdec::ctypes::Parameter::Annotations annots;
+		if (!annotationStr.empty())
+		{
+			annots = parseAnnotations(annotationStr);
+		}
+		parameters.emplace_back(paramName, paramType, annots);
+	}
+
+	auto newFunction = retdec::ctypes::Function::create(
+		context, name, returnType, parameters, callConv, varArgness);
+	newFunction->setDeclaration(retdec::ctypes::FunctionDeclaration(declaration));
+	newFunction->setHeaderFile(retdec::ctypes::HeaderFile(header));
+	return newFunction;
+}
+
+/**
+* @brief Returns already parsed type with @a index, otherwise parses it.
+*/
+std::shared_ptr<retdec::ctypes::Type> BinaryCTypesParser::getOrParseType(
+	std::uint32_t index)
+{
+	if (index == NO_TYPE)
+	{
+		return retdec::ctypes::UnknownType::create();
+	}
+	if (index >= typesCount)
+	{
+		throw CTypesParseError(CORRUPTED_FILE);
+	}
+
+	if (!parsedTypes[index])
+	{
+		parsedTypes[index] = parseType(index);
+	}
+	return parsedTypes[index];
+}
+
+/**
+* @brief Parses type record of type with @a index.
+*
+* Named types that are already in the context or in previously opened files
+* are not parsed again, like in @c JSONCTypesParser.
+*/
+std::shared_ptr<retdec::ctypes::Type> BinaryCTypesParser::parseType(
+	std::uint32_t index)
+{
+	auto offset = readWord(typesOffset + 4 * std::size_t(index));
+	auto kind = static_cast<TypeKind>(readWord(offset));
+
+	switch (kind)
+	{
+		case TypeKind::Void:
+			return retdec::ctypes::VoidType::create();
+		case TypeKind::Unknown:
+			return retdec::ctypes::UnknownType::create();
+		case TypeKind::Pointer:
+			return retdec::ctypes::PointerType::create(
+				context,
+				getOrParseType(readWord(offset + 4)),
+				getBitWidthOrDefault("*")
+			);
+		case TypeKind::Array:
+		{
+			auto elementType = getOrParseType(readWord(offset + 4));
+			retdec::ctypes::ArrayType::Dimensions dimensions;
+			auto count = readWord(offset + 8);
+			for (std::uint32_t i = 0; i < count; ++i)
+			{
+				dimensions.emplace_back(static_cast<std::int32_t>(
+					readWord(offset + 12 + 4 * std::size_t(i))));
+			}
+			return retdec::ctypes::ArrayType::create(context, elementType, dimensions);
+		}
+		case TypeKind::Function:
+			return parseFunctionType(offset);
+		default:
+			break;
+	}
+
+	auto nameOffset = readWord(offset + 4);
+	if (auto cachedType = getPreviousNamedType(nameOffset))
+	{
+		return cachedType;
+	}
+
+	auto typeName = readString(nameOffset);
+	switch (kind)
+	{
+		case TypeKind::Integral:
+		{
+			auto bitWidth = readWord(offset + 8);
+			auto sign = retdec::utils::contains(typeName, "unsigned") ?
+				retdec::ctypes::IntegralType::Signess::Unsigned :
+				retdec::ctypes::IntegralType::Signess::Signed;
+			return retdec::ctypes::IntegralType::create(
+				context,
+				typeName,
+				bitWidth == NO_BIT_WIDTH ? getIntegralTypeBitWidth(typeName) : bitWidth,
+				sign
+			);
+		}
+		case TypeKind::FloatingPoint:
+		{
+			auto bitWidth = readWord(offset + 8);
+			return retdec::ctypes::FloatingPointType::create(
+				context,
+				typeName,
+				bitWidth == NO_BIT_WIDTH ? getBitWidthOrDefault(typeName) : bitWidth
+			);
+		}
+		case TypeKind::Typedef:
+		{
+			// Breaks recursive typedefs in corrupted files.
+			parsedTypes[index] = retdec::ctypes::UnknownType::create();
+			auto aliasedType = getOrParseType(readWord(offset + 8));
+			return retdec::ctypes::TypedefedType::create(context, typeName, aliasedType);
+		}
+		case TypeKind::Struct:
+		case TypeKind::Union:
+			return parseComposite(index, offset, kind == TypeKind::Struct);
+		case TypeKind::Enum:
+		{
+			retdec::ctypes::EnumType::Values values;
+			auto count = readWord(offset + 8);
+			std::size_t itemOffset = std::size_t(offset) + 12;
+			for (std::uint32_t i = 0; i < count; ++i, itemOffset += 12)
+			{
+				auto value = std::uint64_t(readWord(itemOffset + 4))
+					| std::uint64_t(readWord(itemOffset + 8)) << 32;
+				values.emplace_back(
+					readString(readWord(itemOffset)),
+					static_cast<std::int64_t>(value)
+				);
+			}
+			return retdec::ctypes::EnumType::create(context, typeName, values);
+		}
+		default:
+			throw CTypesParseError(CORRUPTED_FILE);
+	}
+}
+
+/**
+* @brief Returns named type with name on @a offset if it is already in the
+*        context or in previously opened files.
+*/
+std::shared_ptr<retdec::ctypes::Type> BinaryCTypesParser::getPreviousNamedType(
+	std::uint32_t offset)
+{
+	auto typeName = readString(offset);
+	for (auto *parser : previousParsers)
+	{
+		if (auto type = parser->getNamedType(typeName))
+		{
+			return type;
+		}
+	}
+	return context->getNamedType(typeName);
+}
+
+/**
+* @brief Parses struct or union record on @a offset.
+*
+* A new type is created at the beginning (like a forward declaration) and its
+* members are set subsequently, so members may refer to the type itself.
+*/
+std::shared_ptr<retdec::ctypes::Type> BinaryCTypesParser::parseComposite(
+	std::uint32_t index,
+	std::uint32_t offset,
+	bool isStruct)
+{
+	auto typeName = readString(readWord(offset + 4));
+	std::shared_ptr<retdec::ctypes::CompositeType> newType;
+	if (isStruct)
+	{
+		newType = retdec::ctypes::StructType::create(context, typeName, {});
+	}
+	else
+	{
+		newType = retdec::ctypes::UnionType::create(context, typeName, {});
+	}
+	parsedTypes[index] = newType;
+
+	retdec::ctypes::CompositeType::Members members;
+	auto count = readWord(offset + 8);
+	std::size_t memberOffset = std::size_t(offset) + 12;
+	for (std::uint32_t i = 0; i < count; ++i, memberOffset += 8)
+	{
+		auto memberName = readString(readWord(memberOffset));
+		members.emplace_back(memberName, getOrParseType(readWord(memberOffset + 4)));
+	}
+	newType->setMembers(members);
+	return newType;
+}
+
+/**
+* @brief Parses function type record on @a offset.
+*/
+std::shared_ptr<retdec::ctypes::Type> BinaryCTypesParser::parseFunctionType(
+	std::uint32_t offset)
+{
+	auto returnType = getOrParseType(readWord(offset + 4));
+	auto callConv = parseCallConv(readWord(offset + 8));
+	auto varArgness = readWord(offset + 12)
+		? retdec::ctypes::FunctionType::VarArgness::IsVarArg
+		: retdec::ctypes::FunctionType::VarArgness::IsNotVarArg;
+
+	retdec::ctypes::FunctionType::Parameters params;
+	auto count = readWord(offset + 16);
+	for (std::uint32_t i = 0; i < count; ++i)
+	{
+		params.push_back(getOrParseType(readWord(offset + 20 + 4 * std::size_t(i))));
+	}
+	return retdec::ctypes::FunctionType::create(
+		context, returnType, params, callConv, varArgness);
+}
+
+/**
+* @brief Returns call convention on @a stringOffset, default if there is none.
+*/
+retdec::ctypes::CallConvention BinaryCTypesParser::parseCallConv(
+	std::uint32_t stringOffset) const
+{
+	return stringOffset == NO_STRING
+		? defaultCallConv
+		: retdec::ctypes::CallConvention(readString(stringOffset));
+}
+
+} // namespace ctypesparser
+} // namespace retdec
@@ -0,0 +1,765 @@
+/**
+* @file src/ctypesparser/binary_ctypes_writer.cpp
+* @brief Compiler of JSON C-types files into binary C-types files.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <istream>
+#include <sstream>
+
+#include <rapidjson/error/en.h>
+
+#include "retdec/ctypes/array_type.h"
+#include "retdec/ctypes/enum_type.h"
+#include "retdec/ctypesparser/binary_ctypes_format.h"
+#include "retdec/ctypesparser/binary_ctypes_writer.h"
+#include "retdec/utils/container.h"
+
+using namespace retdec::ctypesparser::binary_ctypes;
+
+namespace {
+
+const std::string JSON_functions   = "functions";
+const std::string JSON_types       = "types";
+
+const std::string JSON_call_conv   = "call_conv";
+const std::string JSON_decl        = "decl";
+const std::string JSON_header      = "header";
+const std::string JSON_name        = "name";
+const std::string JSON_params      = "params";
+const std::string JSON_ret_type    = "ret_type";
+const std::string JSON_vararg      = "vararg";
+
+const std::string JSON_annotations          = "annotations";
+const std::string JSON_array                = "array";
+const std::string JSON_bit_width            = "bit_width";
+const std::string JSON_array_dimensions     = "dimensions";
+const std::string JSON_array_element        = "element_type";
+const std::string JSON_enum                 = "enum";
+const std::string JSON_enum_items           = "items";
+const std::string JSON_enum_value           = "value";
+const std::string JSON_integral_type        = "integral_type";
+const std::string JSON_floating_point_type  = "floating_point_type";
+const std::string JSON_function_type        = "function";
+const std::string JSON_members              = "members";
+const std::string JSON_modified_type        = "modified_type";
+const std::string JSON_pointed_type         = "pointed_type";
+const std::string JSON_pointer              = "pointer";
+const std::string JSON_qualifier            = "qualifier";
+const std::string JSON_structure            = "structure";
+const std::string JSON_type                 = "type";
+const std::string JSON_typedef              = "typedef";
+const std::string JSON_typedefed_type       = "typedefed_type";
+const std::string JSON_union                = "union";
+const std::string JSON_unknown_type         = "unknown";
+const std::string JSON_void                 = "void";
+
+using retdec::ctypesparser::CTypesParseError;
+
+const rapidjson::Value &getObject(const rapidjson::Value &val, const std::string &name)
+{
+	auto res = val.FindMember(name.c_str());
+	if (res == val.MemberEnd() || !res->value.IsObject())
+	{
+		throw CTypesParseError(name + " must be an object value");
+	}
+	return res->value;
+}
+
+const rapidjson::Value &getArray(const rapidjson::Value &val, const std::string &name)
+{
+	auto res = val.FindMember(name.c_str());
+	if (res == val.MemberEnd() || !res->value.IsArray())
+	{
+		throw CTypesParseError(name + " must be an array value");
+	}
+	return res->value;
+}
+
+/**
+* @brief Returns string member @a name of @a val.
+*
+* @param[out] present Set to @c false when the member is missing. If it is
+*                     @c nullptr, the member is required.
+*/
+std::string getString(
+	const rapidjson::Value &val,
+	const std::string &name,
+	bool *present = nullptr)
+{
+	auto res = val.FindMember(name.c_str());
+	if (res != val.MemberEnd() && res->value.IsString())
+	{
+		if (present)
+		{
+			*present = true;
+		}
+		return res->value.GetString();
+	}
+	else if (present)
+	{
+		*present = false;
+		return std::string();
+	}
+
+	throw CTypesParseError(name + " must be a string value");
+}
+
+} // anonymous namespace
+
+namespace retdec {
+namespace ctypesparser {
+
+/**
+* @brief Compiles C-types from JSON representation into binary representation.
+*
+* @param[in] json Input stream containing C-types in JSON.
+* @param[out] out Output stream for the binary C-types file.
+*
+* @throw CTypesParseError when the input JSON is invalid or the output cannot
+*        be written.
+*/
+void BinaryCTypesWriter::write(std::istream &json, std::ostream &out)
+{
+	clear();
+
+	std::ostringstream sstr;
+	sstr << json.rdbuf();
+	if (!json.good())
+	{
+		throw CTypesParseError("Failed to read from the input stream.");
+	}
+	std::string buffer = sstr.str();
+	buffer.push_back('\0');
+
+	rapidjson::Document root;
+	rapidjson::ParseResult res = root.ParseInsitu(&buffer[0]);
+	if (!res)
+	{
+		std::ostringstream errMsg;
+		errMsg << "Failed to parse JSON.\n";
+		errMsg << "Error (offset " << res.Offset() << "): "
+			<< rapidjson::GetParseError_En(res.Code()) << std::endl;
+		throw CTypesParseError(errMsg.str());
+	}
+
+	const rapidjson::Value &jsonFunctions = getObject(root, JSON_functions);
+	const rapidjson::Value &jsonTypes = getObject(root, JSON_types);
+	for (auto i = jsonTypes.MemberBegin(), e = jsonTypes.MemberEnd(); i != e; ++i)
+	{
+		typesMap.emplace(i->name.GetString(), i);
+	}
+	for (auto i = jsonFunctions.MemberBegin(), e = jsonFunctions.MemberEnd(); i != e; ++i)
+	{
+		addFunction(i->name.GetString(), i->value);
+	}
+
+	// Header.
+	std::vector<std::uint8_t> data;
+	for (std::uint32_t i = 0; i < HeaderWord::Count; ++i)
+	{
+		emitWord(data, 0);
+	}
+
+	// Strings.
+	for (const auto &p : functions)
+	{
+		const auto &function = p.second;
+		emitString(data, function.name);
+		emitString(data, function.declaration);
+		emitString(data, function.header);
+		emitOptionalString(data, function.callConv, function.hasCallConv);
+		for (const auto &param : function.parameters)
+		{
+			emitString(data, param.name);
+			emitString(data, param.annotations);
+		}
+	}
+	for (const auto &type : types)
+	{
+		emitString(data, type.name);
+		emitOptionalString(data, type.callConv, type.hasCallConv);
+		for (const auto &member : type.members)
+		{
+			emitString(data, member.first);
+		}
+		for (const auto &item : type.items)
+		{
+			emitString(data, item.first);
+		}
+	}
+
+	// Tables, they are filled when records are emitted.
+	std::vector<std::pair<std::string, std::uint32_t>> sortedNamedTypes(
+		namedTypes.begin(), namedTypes.end());
+	std::sort(sortedNamedTypes.begin(), sortedNamedTypes.end());
+
+	std::size_t functionsOffset = data.size();
+	data.resize(data.size() + 8 * functions.size());
+	std::size_t namedTypesOffset = data.size();
+	data.resize(data.size() + 8 * sortedNamedTypes.size());
+	std::size_t typesOffset = data.size();
+	data.resize(data.size() + 4 * types.size());
+
+	// Records.
+	for (std::size_t i = 0; i < types.size(); ++i)
+	{
+		patchWord(data, typesOffset + 4 * i, emitType(data, types[i]));
+	}
+	std::size_t i = 0;
+	for (const auto &p : functions)
+	{
+		patchWord(data, functionsOffset + 8 * i, strings.at(p.first));
+		patchWord(data, functionsOffset + 8 * i + 4, emitFunction(data, p.second));
+		++i;
+	}
+	i = 0;
+	for (const auto &p : sortedNamedTypes)
+	{
+		patchWord(data, namedTypesOffset + 8 * i, strings.at(p.first));
+		patchWord(data, namedTypesOffset + 8 * i + 4, p.second);
+		++i;
+	}
+
+	if (data.size() > 0xffffffffu)
+	{
+		throw CTypesParseError("Binary C-types file is too large.");
+	}
+
+	patchWord(data, 4 * HeaderWord::Magic, MAGIC);
+	patchWord(data, 4 * HeaderWord::Version, VERSION);
+	patchWord(data, 4 * HeaderWord::FunctionsOffset, functionsOffset);
+	patchWord(data, 4 * HeaderWord::FunctionsCount, functions.size());
+	patchWord(data, 4 * HeaderWord::NamedTypesOffset, namedTypesOffset);
+	patchWord(data, 4 * HeaderWord::NamedTypesCount, sortedNamedTypes.size());
+	patchWord(data, 4 * HeaderWord::TypesOffset, typesOffset);
+	patchWord(data, 4 * HeaderWord::TypesCount, types.size());
+
+	out.write(reinterpret_cast<const char*>(data.data()), data.size());
+	if (!out.good())
+	{
+		throw CTypesParseError("Failed to write to the output stream.");
+	}
+
+	clear();
+}
+
+/**
+* @brief Clears all the resolved functions and types.
+*/
+void BinaryCTypesWriter::clear()
+{
+	typesMap.clear();
+	keysToTypes.clear();
+	namedTypes.clear();
+	previousTypedefs.clear();
+	voidType = NO_TYPE;
+	unknownType = NO_TYPE;
+	types.clear();
+	functions.clear();
+	strings.clear();
+}
+
+/**
+* @brief Resolves function from JSON representation.
+*
+* When there are more functions with the same name, the first one is used.
+*/
+void BinaryCTypesWriter::addFunction(
+	const std::string &name,
+	const rapidjson::Value &jsonFunction)
+{
+	if (functions.count(name))
+	{
+		return;
+	}
+
+	FunctionNode function;
+	function.name = name;
+	function.returnType = getOrAddType(getString(jsonFunction, JSON_ret_type));
+
+	const auto &jsonParams = getArray(jsonFunction, JSON_params);
+	for (auto i = jsonParams.Begin(), e = jsonParams.End(); i != e; ++i)
+	{
+		ParameterNode param;
+		bool hasAnnotations = false;
+		param.annotations = getString(*i, JSON_annotations, &hasAnnotations);
+		param.name = getString(*i, JSON_name);
+		param.type = getOrAddType(getString(*i, JSON_type));
+		function.parameters.push_back(std::move(param));
+	}
+
+	auto varArg = jsonFunction.FindMember(JSON_vararg.c_str());
+	function.varArg = varArg != jsonFunction.MemberEnd()
+		&& varArg->value.IsBool() && varArg->value.GetBool();
+	function.callConv = getString(jsonFunction, JSON_call_conv, &function.hasCallConv);
+	function.declaration = getString(jsonFunction, JSON_decl);
+	function.header = getString(jsonFunction, JSON_header);
+
+	functions.emplace(name, std::move(function));
+}
+
+/**
+* @brief Returns index of already resolved type or resolves a new one.
+*
+* @param typeKey Key of type stored in JSON types.
+*/
+std::uint32_t BinaryCTypesWriter::getOrAddType(const std::string &typeKey)
+{
+	auto it = keysToTypes.find(typeKey);
+	if (it != keysToTypes.end())
+	{
+		return it->second;
+	}
+
+	auto index = addType(typeKey);
+	keysToTypes.emplace(typeKey, index);
+	return index;
+}
+
+/**
+* @brief Resolves type from JSON representation.
+*
+* @param typeKey Key of type stored in JSON types.
+*/
+std::uint32_t BinaryCTypesWriter::addType(const std::string &typeKey)
+{
+	auto it = typesMap.find(typeKey);
+	if (it == typesMap.end())
+	{
+		throw CTypesParseError("Unknown type key: " + typeKey);
+	}
+
+	const rapidjson::Value &jsonType = it->second->value;
+	std::string typeOfType = getString(jsonType, JSON_type);
+
+	if (typeOfType == JSON_typedef)
+	{
+		return getOrAddNamedType(jsonType, std::uint32_t(TypeKind::Typedef));
+	}
+	else if (typeOfType == JSON_pointer)
+	{
+		TypeNode node;
+		node.kind = std::uint32_t(TypeKind::Pointer);
+		node.type = getOrAddType(getString(jsonType, JSON_pointed_type));
+		return addNode(std::move(node));
+	}
+	else if (typeOfType == JSON_integral_type)
+	{
+		return getOrAddNamedType(jsonType, std::uint32_t(TypeKind::Integral));
+	}
+	else if (typeOfType == JSON_structure)
+	{
+		return getOrAddNamedType(jsonType, std::uint32_t(TypeKind::Struct));
+	}
+	else if (typeOfType == JSON_void)
+	{
+		if (voidType == NO_TYPE)
+		{
+			TypeNode node;
+			node.kind = std::uint32_t(TypeKind::Void);
+			voidType = addNode(std::move(node));
+		}
+		return voidType;
+	}
+	else if (typeOfType == JSON_function_type)
+	{
+		return addFunctionType(jsonType);
+	}
+	else if (typeOfType == JSON_array)
+	{
+		return addArray(jsonType);
+	}
+	else if (typeOfType == JSON_floating_point_type)
+	{
+		return getOrAddNamedType(jsonType, std::uint32_t(TypeKind::FloatingPoint));
+	}
+	else if (typeOfType == JSON_enum)
+	{
+		return getOrAddNamedType(jsonType, std::uint32_t(TypeKind::Enum));
+	}
+	else if (typeOfType == JSON_union)
+	{
+		return getOrAddNamedType(jsonType, std::uint32_t(TypeKind::Union));
+	}
+	else if (typeOfType == JSON_qualifier)
+	{
+		return getOrAddType(getString(jsonType, JSON_modified_type));
+	}
+
+	if (unknownType == NO_TYPE)
+	{
+		TypeNode node;
+		node.kind = std::uint32_t(TypeKind::Unknown);
+		unknownType = addNode(std::move(node));
+	}
+	return unknownType;
+}
+
+/**
+* @brief Stores resolved type and returns its index.
+*/
+std::uint32_t BinaryCTypesWriter::addNode(TypeNode node)
+{
+	types.push_back(std::move(node));
+	return types.size() - 1;
+}
+
+/**
+* @brief Returns index of named type with the same name, if already resolved,
+*        otherwise resolves a new type.
+*
+* @param jsonType Type to get/resolve.
+* @param kind Kind of the type (typedef, struct...).
+*/
+std::uint32_t BinaryCTypesWriter::getOrAddNamedType(
+	const rapidjson::Value &jsonType,
+	std::uint32_t kind)
+{
+	auto typeName = getString(jsonType, JSON_name);
+	auto it = namedTypes.find(typeName);
+	if (it != namedTypes.end())
+	{
+		return it->second;
+	}
+
+	std::uint32_t index = 0;
+	switch (static_cast<TypeKind>(kind))
+	{
+		case TypeKind::Typedef:
+			return addTypedef(jsonType, typeName);
+		case TypeKind::Struct:
+		case TypeKind::Union:
+			return addComposite(jsonType, typeName, kind);
+		case TypeKind::Enum:
+			return addEnum(jsonType, typeName);
+		default:
+		{
+			TypeNode node;
+			node.kind = kind;
+			node.name = typeName;
+			auto bitWidth = jsonType.FindMember(JSON_bit_width.c_str());
+			node.bitWidth = bitWidth != jsonType.MemberEnd()
+					&& bitWidth->value.IsInt64()
+				? static_cast<std::uint32_t>(bitWidth->value.GetInt64())
+				: NO_BIT_WIDTH;
+			index = addNode(std::move(node));
+			break;
+		}
+	}
+
+	namedTypes.emplace(typeName, index);
+	return index;
+}
+
+/**
+* @brief Resolves typedef from JSON representation.
+*
+* Recursive typedefs are broken by unknown types in the same way as in
+* @c JSONCTypesParser.
+*/
+std::uint32_t BinaryCTypesWriter::addTypedef(
+	const rapidjson::Value &jsonTypedef,
+	const std::string &typeName)
+{
+	if (retdec::utils::hasItem(previousTypedefs, typeName))
+	{
+		if (unknownType == NO_TYPE)
+		{
+			TypeNode node;
+			node.kind = std::uint32_t(TypeKind::Unknown);
+			unknownType = addNode(std::move(node));
+		}
+		return unknownType;
+	}
+
+	previousTypedefs.emplace_back(typeName);
+	std::string aliasedTypeKey = getString(jsonTypedef, JSON_typedefed_type);
+	auto aliasedType = (aliasedTypeKey == JSON_unknown_type)
+		? NO_TYPE
+		: getOrAddType(aliasedTypeKey);
+	if (typeName == previousTypedefs[0])
+	{
+		previousTypedefs.clear();
+	}
+
+	// The aliased type may already contain a typedef with the same name. If
+	// it contains another type with the same name (typedef struct X X), the
+	// new typedef is used only here and the name keeps referring to the other
+	// type, see TypedefedType::create().
+	auto it = namedTypes.find(typeName);
+	if (it != namedTypes.end()
+		&& types[it->second].kind == std::uint32_t(TypeKind::Typedef))
+	{
+		return it->second;
+	}
+
+	TypeNode node;
+	node.kind = std::uint32_t(TypeKind::Typedef);
+	node.name = typeName;
+	node.type = aliasedType;
+	auto index = addNode(std::move(node));
+	namedTypes.emplace(typeName, index);
+	return index;
+}
+
+/**
+* @brief Resolves struct or union from JSON representation.
+*
+* The type is stored before its members are resolved, so members may refer
+* to the type itself.
+*/
+std::uint32_t BinaryCTypesWriter::addComposite(
+	const rapidjson::Value &jsonComposite,
+	const std::string &typeName,
+	std::uint32_t kind)
+{
+	TypeNode node;
+	node.kind = kind;
+	node.name = typeName;
+	auto index = addNode(std::move(node));
+	namedTypes.emplace(typeName, index);
+
+	const auto &jsonMembers = getArray(jsonComposite, JSON_members);
+	std::vector<std::pair<std::string, std::uint32_t>> members;
+	for (auto i = jsonMembers.Begin(), e = jsonMembers.End(); i != e; ++i)
+	{
+		std::string memberTypeKey = getString(*i, JSON_type);
+		std::string memberName = getString(*i, JSON_name);
+		members.emplace_back(memberName, getOrAddType(memberTypeKey));
+	}
+	types[index].members = std::move(members);
+	return index;
+}
+
+/**
+* @brief Resolves function type from JSON representation.
+*/
+std::uint32_t BinaryCTypesWriter::addFunctionType(const rapidjson::Value &jsonFuncType)
+{
+	TypeNode node;
+	node.kind = std::uint32_t(TypeKind::Function);
+	node.type = getOrAddType(getString(jsonFuncType, JSON_ret_type));
+
+	const auto &jsonParams = getArray(jsonFuncType, JSON_params);
+	for (auto i = jsonParams.Begin(), e = jsonParams.End(); i != e; ++i)
+	{
+		node.words.push_back(getOrAddType(getString(*i, JSON_type)));
+	}
+
+	auto varArg = jsonFuncType.FindMember(JSON_vararg.c_str());
+	node.varArg = varArg != jsonFuncType.MemberEnd()
+		&& varArg->value.IsBool() && varArg->value.GetBool();
+	node.callConv = getString(jsonFuncType, JSON_call_conv, &node.hasCallConv);
+	return addNode(std::move(node));
+}
+
+/**
+* @brief Resolves array from JSON representation.
+*/
+std::uint32_t BinaryCTypesWriter::addArray(const rapidjson::Value &jsonArray)
+{
+	TypeNode node;
+	node.kind = std::uint32_t(TypeKind::Array);
+	node.type = getOrAddType(getString(jsonArray, JSON_array_element));
+
+	const auto &jsonDimensions = getArray(jsonArray, JSON_array_dimensions);
+	for (auto i = jsonDimensions.Begin(), e = jsonDimensions.End(); i != e; ++i)
+	{
+		node.words.push_back(i->IsInt()
+			? static_cast<std::uint32_t>(i->GetInt())
+			: retdec::ctypes::ArrayType::UNKNOWN_DIMENSION);
+	}
+	return addNode(std::move(node));
+}
+
+/**
+* @brief Resolves enum from JSON representation.
+*/
+std::uint32_t BinaryCTypesWriter::addEnum(
+	const rapidjson::Value &jsonEnum,
+	const std::string &typeName)
+{
+	TypeNode node;
+	node.kind = std::uint32_t(TypeKind::Enum);
+	node.name = typeName;
+
+	const auto &jsonItems = getArray(jsonEnum, JSON_enum_items);
+	for (auto i = jsonItems.Begin(), e = jsonItems.End(); i != e; ++i)
+	{
+		auto value = i->FindMember(JSON_enum_value.c_str());
+		node.items.emplace_back(
+			getString(*i, JSON_name),
+			value != i->MemberEnd() && value->value.IsInt64()
+				? value->value.GetInt64()
+				: retdec::ctypes::EnumType::DEFAULT_VALUE
+		);
+	}
+
+	auto index = addNode(std::move(node));
+	namedTypes.emplace(typeName, index);
+	return index;
+}
+
+/**
+* @brief Appends little-endian @a word to @a out.
+*/
+void BinaryCTypesWriter::emitWord(
+	std::vector<std::uint8_t> &out,
+	std::uint32_t word) const
+{
+	out.push_back(word & 0xff);
+	out.push_back((word >> 8) & 0xff);
+	out.push_back((word >> 16) & 0xff);
+	out.push_back((word >> 24) & 0xff);
+}
+
+/**
+* @brief Overwrites little-endian word on @a offset in @a out.
+*/
+void BinaryCTypesWriter::patchWord(
+	std::vector<std::uint8_t> &out,
+	std::size_t offset,
+	std::uint32_t word) const
+{
+	out[offset] = word & 0xff;
+	out[offset + 1] = (word >> 8) & 0xff;
+	out[offset + 2] = (word >> 16) & 0xff;
+	out[offset + 3] = (word >> 24) & 0xff;
+}
+
+/**
+* @brief Appends @a str to @a out, if not already appended, and returns its
+*        offset.
+*/
+std::uint32_t BinaryCTypesWriter::emitString(
+	std::vector<std::uint8_t> &out,
+	const std::string &str)
+{
+	auto it = strings.find(str);
+	if (it != strings.end())
+	{
+		return it->second;
+	}
+
+	std::uint32_t offset = out.size();
+	emitWord(out, str.size());
+	out.insert(out.end(), str.begin(), str.end());
+	out.resize((out.size() + 3) & ~std::size_t(3), 0);
+	strings.emplace(str, offset);
+	return offset;
+}
+
+/**
+* @brief Appends @a str to @a out like emitString() if it is @a present.
+*/
+void BinaryCTypesWriter::emitOptionalString(
+	std::vector<std::uint8_t> &out,
+	const std::string &str,
+	bool present)
+{
+	if (present)
+	{
+		emitString(out, str);
+	}
+}
+
+/**
+* @brief Appends record of @a function to @a out and returns its offset.
+*/
+std::uint32_t BinaryCTypesWriter::emitFunction(
+	std::vector<std::uint8_t> &out,
+	const FunctionNode &function)
+{
+	std::uint32_t offset = out.size();
+	emitWord(out, strings.at(function.name));
+	emitWord(out, strings.at(function.declaration));
+	emitWord(out, strings.at(function.header));
+	emitWord(out, function.hasCallConv ? strings.at(function.callConv) : NO_STRING);
+	emitWord(out, function.returnType);
+	emitWord(out, function.varArg);
+	emitWord(out, function.parameters.size());
+	for (const auto &param : function.parameters)
+	{
+		emitWord(out, strings.at(param.name));
+		emitWord(out, param.type);
+		emitWord(out, strings.at(param.annotations));
+	}
+	return offset;
+}
+
+/**
+* @brief Appends record of @a type to @a out and returns its offset.
+*/
+std::uint32_t BinaryCTypesWriter::emitType(
+	std::vector<std::uint8_t> &out,
+	const TypeNode &type)
+{
+	std::uint32_t offset = out.size();
+	emitWord(out, type.kind);
+	switch (static_cast<TypeKind>(type.kind))
+	{
+		case TypeKind::Void:
+		case TypeKind::Unknown:
+			break;
+		case TypeKind::Integral:
+		case TypeKind::FloatingPoint:
+			emitWord(out, strings.at(type.name));
+			emitWord(out, type.bitWidth);
+			break;
+		case TypeKind::Typedef:
+			emitWord(out, strings.at(type.name));
+			emitWord(out, type.type);
+			break;
+		case TypeKind::Struct:
+		case TypeKind::Union:
+			emitWord(out, strings.at(type.name));
+			emitWord(out, type.members.size());
+			for (const auto &member : type.members)
+			{
+				emitWord(out, strings.at(member.first));
+				emitWord(out, member.second);
+			}
+			break;
+		case TypeKind::Pointer:
+			emitWord(out, type.type);
+			break;
+		case TypeKind::Array:
+			emitWord(out, type.type);
+			emitWord(out, type.words.size());
+			for (auto dimension : type.words)
+			{
+				emitWord(out, dimension);
+			}
+			break;
+		case TypeKind::Enum:
+			emitWord(out, strings.at(type.name));
+			emitWord(out, type.items.size());
+			for (const auto &item : type.items)
+			{
+				auto value = static_cast<std::uint64_t>(item.second);
+				emitWord(out, strings.at(item.first));
+				emitWord(out, value & 0xffffffff);
+				emitWord(out, value >> 32);
+			}
+			break;
+		case TypeKind::Function:
+			emitWord(out, type.type);
+			emitWord(out, type.hasCallConv ? strings.at(type.callConv) : NO_STRING);
+			emitWord(out, type.varArg);
+			emitWord(out, type.words.size());
+			for (auto param : type.words)
+			{
+				emitWord(out, param);
+			}
+			break;
+		default:
+			throw CTypesParseError("Unknown type kind "
+				+ std::to_string(type.kind) + ".");
+	}
+	return offset;
+}
+
+} // namespace ctypesparser
+} // namespace retdec
@@ -0,0 +1,105 @@
+/**
+ * @file src/ctypesparsertool/ctypesparser.cpp
+ * @brief Compiler of JSON C-types files into binary C-types files.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "retdec/ctypesparser/binary_ctypes_writer.h"
+#include "retdec/utils/io/log.h"
+#include "retdec/utils/version.h"
+
+using namespace retdec::utils::io;
+using namespace retdec::ctypesparser;
+
+/**
+ * Print usage.
+ */
+void printUsage()
+{
+	Log::info() << "\nCompiler of JSON C-types files into binary C-types files.\n"
+		<< "Usage: retdec-ctypesparser INPUT_JSON_FILE OUTPUT_LTI_FILE\n\n";
+}
+
+/**
+ * Print error message and return non-zero value.
+ *
+ * @param errorMessage message to print
+ * @return non-zero value
+ */
+int printError(
+	const std::string &errorMessage)
+{
+	Log::error() << Log::Error << errorMessage << "\n";
+	return 1;
+}
+
+/**
+ * Do actions according to command line arguments.
+ *
+ * @param args command line arguments
+ */
+int doActions(
+	const std::vector<std::string> &args)
+{
+	std::vector<std::string> paths;
+	for (const auto &arg : args) {
+		if (arg == "-h" || arg == "--help") {
+			printUsage();
+			return 0;
+		}
+		else if (arg == "--version") {
+			Log::info() << retdec::utils::version::getVersionStringLong()
+					<< "\n";
+			return 0;
+		}
+		else {
+			paths.push_back(arg);
+		}
+	}
+
+	if (paths.size() != 2) {
+		printUsage();
+		return 1;
+	}
+
+	std::ifstream input(paths[0], std::ios::binary);
+	if (!input) {
+		return printError("could not open input file '" + paths[0] + "'");
+	}
+
+	// Write into a temporary file first, so that readers never see
+	// a partially written output.
+	const std::string tmpPath = paths[1] + ".tmp";
+	{
+		std::ofstream output(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!output) {
+			return printError("could not open output file '" + tmpPath + "'");
+		}
+
+		try {
+			BinaryCTypesWriter().write(input, output);
+		}
+		catch (const CTypesParseError &e) {
+			output.close();
+			std::remove(tmpPath.c_str());
+			return printError(paths[0] + ": " + e.what());
+		}
+	}
+
+	std::remove(paths[1].c_str());
+	if (std::rename(tmpPath.c_str(), paths[1].c_str()) != 0) {
+		std::remove(tmpPath.c_str());
+		return printError("could not write output file '" + paths[1] + "'");
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	return doActions(std::vector<std::string>(argv + 1, argv + argc));
+}
@@ -24,12 +24,15 @@ DebugFormat::DebugFormat()
  * @param pdbFile   Input PDB file to load debugging information from.
  * @param symtab    Symbol table.
  * @param demangler Demangled instance used for this input file.
+ * @param pool      Thread pool used to load DWARF compile units in parallel,
+ *                  or @c nullptr to load them serially.
  */
 DebugFormat::DebugFormat(
 		retdec::loader::Image* inFile,
 		const std::string& pdbFile,
 		SymbolTable* symtab,
-		retdec::demangler::Demangler* demangler)
+		retdec::demangler::Demangler* demangler,
+		retdec::utils::ThreadPool* pool)
 		:
 		_symtab(symtab),
 		_inFile(inFile),
@@ -53,7 +56,7 @@ DebugFormat::DebugFormat(
 		loadPdb();
 	}
 
-	loadDwarf();
+	loadDwarf(pool);
 
 	loadSymtab();
 }
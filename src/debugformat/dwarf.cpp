@@ -25,19 +25,30 @@ std::string getDefaultDataType()
 namespace retdec {
 namespace debugformat {
 
-void DebugFormat::loadDwarf()
+void DebugFormat::loadDwarf(retdec::utils::ThreadPool* pool)
 {
-	// Open input file as buffer.
+	// Use the input file already loaded by fileformat. Read it again only if
+	// the loaded content is not available.
 	//
-	llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffOrErr =
-			llvm::MemoryBuffer::getFileOrSTDIN(
-				_inFile->getFileFormat()->getPathToFile());
-	if (buffOrErr.getError())
+	auto* fileFormat = _inFile->getFileFormat();
+	std::unique_ptr<llvm::MemoryBuffer> bufferPtr;
+	llvm::MemoryBufferRef buffer(
+			llvm::StringRef(
+					reinterpret_cast<const char*>(fileFormat->getBytesData()),
+					fileFormat->getFileLength()),
+			fileFormat->getPathToFile());
+	if (fileFormat->getFileLength() == 0)
 	{
-		return;
+		llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>> buffOrErr =
+				llvm::MemoryBuffer::getFileOrSTDIN(
+					fileFormat->getPathToFile());
+		if (buffOrErr.getError())
+		{
+			return;
+		}
+		bufferPtr = std::move(buffOrErr.get());
+		buffer = *bufferPtr;
 	}
-	std::unique_ptr<llvm::MemoryBuffer> bufferPtr = std::move(buffOrErr.get());
-	llvm::MemoryBufferRef buffer = *bufferPtr;
 
 	// Open buffer as a binary file.
 	//
@@ -63,18 +74,108 @@ void DebugFormat::loadDwarf()
 
 	LOG << "\n*** DebugFormat::DebugFormat(): DWARF" << std::endl;
 
-	// Inspect compilation unit DIEs.
+	// DWARFContext and DWARFUnit parse DIEs, line tables and compilation
+	// directories lazily and they are not thread-safe. Parse everything
+	// the units need here, so that they are only read when loaded below.
 	//
+	std::vector<llvm::DWARFDie> unitDies;
+	std::vector<DwarfUnitInfo> infos;
 	for (auto& unit : DICtx->compile_units())
 	{
 		if (auto unitDie = unit->getUnitDIE(false))
 		{
-			loadDwarf_CU(unitDie);
+			unit->getCompilationDir();
+
+			unitDies.push_back(unitDie);
+			infos.emplace_back();
+			infos.back().lines = DICtx->getLineTableForUnit(unit.get());
+		}
+	}
+
+	// Inspect compilation unit DIEs.
+	//
+	auto loadUnit = [this, &unitDies, &infos](std::size_t i)
+	{
+		loadDwarf_CU(infos[i], unitDies[i]);
+		infos[i].dieOff2type = {};
+	};
+	if (pool)
+	{
+		pool->parallelFor(infos.size(), loadUnit);
+	}
+	else
+	{
+		for (std::size_t i = 0; i < infos.size(); ++i)
+		{
+			loadUnit(i);
+		}
+	}
+
+	// Merge the units in their order in the file, so that the result is the
+	// same no matter in which order they were loaded.
+	//
+	std::unordered_map<uint64_t, const retdec::fileformat::Symbol*> symbols;
+	for (const auto* table : fileFormat->getSymbolTables())
+	{
+		if (table)
+		{
+			for (const auto& sym : *table)
+			{
+				unsigned long long a = 0;
+				if (sym->getAddress(a))
+				{
+					symbols.emplace(a, sym.get());
+				}
+			}
+		}
+	}
+	for (auto& info : infos)
+	{
+		mergeDwarfUnit(info, symbols);
+	}
+}
+
+/**
+ * Add debug information loaded from one compile unit to the already loaded
+ * information. If an entity was already loaded from a preceding unit, it is
+ * kept.
+ * @param info    Debug information of the unit.
+ * @param symbols Map of addresses to symbols of the input file.
+ */
+void DebugFormat::mergeDwarfUnit(
+		DwarfUnitInfo& info,
+		const std::unordered_map<uint64_t, const retdec::fileformat::Symbol*>& symbols)
+{
+	for (auto& f : info.functions)
+	{
+		// Demangler is not thread-safe, so the linkage name is stored as
+		// demangled name while the unit is loaded.
+		auto linkageName = f.getDemangledName();
+		if (_demangler && !linkageName.empty())
+		{
+			auto dn = _demangler->demangleToString(linkageName);
+			if (!dn.empty())
+			{
+				f.setDemangledName(dn);
+			}
 		}
+
+		auto sym = symbols.find(f.getStart().getValue() + 1);
+		f.setIsThumb(sym != symbols.end() && sym->second->isThumbSymbol());
+
+		functions.insert({f.getStart(), std::move(f)});
+	}
+	for (auto& g : info.globals)
+	{
+		globals.insert(g);
+	}
+	for (auto& t : info.types)
+	{
+		types.insert(t);
 	}
 }
 
-void DebugFormat::loadDwarf_CU(llvm::DWARFDie die)
+void DebugFormat::loadDwarf_CU(DwarfUnitInfo& info, llvm::DWARFDie die) const
 {
 	for (auto c : die.children())
 	{
@@ -82,19 +183,19 @@ void DebugFormat::loadDwarf_CU(llvm::DWARFDie die)
 		{
 			case llvm::dwarf::DW_TAG_subprogram:
 			{
-				auto f = loadDwarf_subprogram(c);
+				auto f = loadDwarf_subprogram(info, c);
 				if (!f.getName().empty() && f.getStart().isDefined())
 				{
-					functions.insert({f.getStart(), f});
+					info.functions.push_back(std::move(f));
 				}
 				break;
 			}
 			case llvm::dwarf::DW_TAG_variable:
 			{
-				auto v = loadDwarf_variable(c);
+				auto v = loadDwarf_variable(info, c);
 				if (!v.getName().empty())
 				{
-					globals.insert(v);
+					info.globals.push_back(std::move(v));
 				}
 			}
 			default:
@@ -103,7 +204,9 @@ void DebugFormat::loadDwarf_CU(llvm::DWARFDie die)
 	}
 }
 
-retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
+retdec::common::Function DebugFormat::loadDwarf_subprogram(
+		DwarfUnitInfo& info,
+		llvm::DWARFDie die) const
 {
 	// Start & end address.
 	//
@@ -134,7 +237,7 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 
 	// Names
 	//
-	std::string name, linkageName, demangledName;
+	std::string name, linkageName;
 	if (auto n = llvm::dwarf::toString(die.find(
 			llvm::dwarf::DW_AT_name)))
 	{
@@ -148,8 +251,6 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 	if (ln.hasValue())
 	{
 		linkageName = ln.getValue();
-		auto dn = _demangler->demangleToString(linkageName);
-		demangledName = dn.empty() ? linkageName : dn;
 	}
 	if (name.empty() && linkageName.empty())
 	{
@@ -157,16 +258,14 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 	}
 
 	auto* unit = die.getDwarfUnit();
-	auto* lines = unit->getContext().getLineTableForUnit(unit);
+	auto* lines = info.lines;
 
 	retdec::common::Function dif(linkageName.empty() ? name : linkageName);
 
 	dif.setIsFromDebug(true);
 	dif.setStartEnd(start, end);
-	dif.setDemangledName(demangledName);
-
-	auto* sym = _inFile->getFileFormat()->getSymbol(start + 1);
-	dif.setIsThumb(sym && sym->isThumbSymbol());
+	// Demangled in mergeDwarfUnit().
+	dif.setDemangledName(linkageName);
 
 	// Source file name.
 	//
@@ -216,7 +315,7 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 	{
 		if (auto odie = unit->getDIEForOffset(o.getValue()))
 		{
-			dif.returnType = loadDwarf_type(odie);
+			dif.returnType = loadDwarf_type(info, odie);
 		}
 	}
 	else
@@ -235,11 +334,11 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 				dif.setIsVariadic(true);
 				break;
 			case llvm::dwarf::DW_TAG_formal_parameter:
-				dif.parameters.push_back(loadDwarf_formal_parameter(c, argCntr++));
+				dif.parameters.push_back(loadDwarf_formal_parameter(info, c, argCntr++));
 				break;
 			case llvm::dwarf::DW_TAG_variable:
 			{
-				auto var = loadDwarf_variable(c);
+				auto var = loadDwarf_variable(info, c);
 				if (!var.getName().empty())
 				{
 					dif.locals.insert(var);
@@ -254,11 +353,13 @@ retdec::common::Function DebugFormat::loadDwarf_subprogram(llvm::DWARFDie die)
 	return dif;
 }
 
-std::string DebugFormat::loadDwarf_type(llvm::DWARFDie die)
+std::string DebugFormat::loadDwarf_type(
+		DwarfUnitInfo& info,
+		llvm::DWARFDie die) const
 {
 	// Try to use cache.
-	auto it = dieOff2type.find({die.getDwarfUnit(), die.getOffset()});
-	if (it != dieOff2type.end())
+	auto it = info.dieOff2type.find(die.getOffset());
+	if (it != info.dieOff2type.end())
 	{
 		return it->second;
 	}
@@ -270,18 +371,18 @@ std::string DebugFormat::loadDwarf_type(llvm::DWARFDie die)
 	// If it does end up here, this will protect us from infinite recursion.
 	// Named types (e.g. structures) needs some more hacking in their
 	/// processing.
-	dieOff2type.insert(
-			{{die.getDwarfUnit(), die.getOffset()},
-			getDefaultDataType()});
+	info.dieOff2type.insert({die.getOffset(), getDefaultDataType()});
 
-	auto ret = _loadDwarf_type(die);
+	auto ret = _loadDwarf_type(info, die);
 
-	dieOff2type[{die.getDwarfUnit(), die.getOffset()}] = ret;
+	info.dieOff2type[die.getOffset()] = ret;
 
 	return ret;
 }
 
-std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
+std::string DebugFormat::_loadDwarf_type(
+		DwarfUnitInfo& info,
+		llvm::DWARFDie die) const
 {
 	switch (die.getTag())
 	{
@@ -341,7 +442,7 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 			{
 				if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
 				{
-					return loadDwarf_type(odie) + "*";
+					return loadDwarf_type(info, odie) + "*";
 				}
 			}
 			// Default here is pointer to void.
@@ -355,7 +456,7 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 			{
 				if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
 				{
-					type = loadDwarf_type(odie);
+					type = loadDwarf_type(info, odie);
 				}
 			}
 			unsigned dimensions = 0;
@@ -399,7 +500,7 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 			{
 				if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
 				{
-					return loadDwarf_type(odie);
+					return loadDwarf_type(info, odie);
 				}
 			}
 			return getDefaultDataType();
@@ -407,25 +508,26 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 		case llvm::dwarf::DW_TAG_structure_type:
 		case llvm::dwarf::DW_TAG_class_type:
 		{
-			auto it = dieOff2type.find({die.getDwarfUnit(), die.getOffset()});
+			auto it = info.dieOff2type.find(die.getOffset());
 			// Because we insert default type to cache before processing the
 			// type, we need to ignore default types in the map.
-			if (it != dieOff2type.end() && it->second != getDefaultDataType())
+			if (it != info.dieOff2type.end() && it->second != getDefaultDataType())
 			{
 				return it->second;
 			}
 
-			static unsigned anonStuctCntr = 0;
+			// Anonymous structures are named by their DIE offsets, so that
+			// their names do not depend on the order of loading of the units.
 			auto n = llvm::dwarf::toString(die.find(llvm::dwarf::DW_AT_name));
 			std::string name = n
 					? std::string("%") + n.getValue()
-					: "%anon_struct_" + std::to_string(anonStuctCntr++);
+					: "%anon_struct_" + std::to_string(die.getOffset());
 
 			// It is important to insert an entry into cache container before
 			// calling loadDwarf_type() recursively.
 			// This will prevent infinite cycle if structure contains pointer to
 			// itself.
-			dieOff2type[{die.getDwarfUnit(), die.getOffset()}] = name;
+			info.dieOff2type[die.getOffset()] = name;
 
 			std::string body;
 			for (auto c : die.children())
@@ -437,7 +539,7 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 					{
 						if (auto odie = c.getDwarfUnit()->getDIEForOffset(o.getValue()))
 						{
-							elem = loadDwarf_type(odie);
+							elem = loadDwarf_type(info, odie);
 						}
 					}
 
@@ -447,7 +549,7 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 			}
 			body += body.empty() ? "{" + getDefaultDataType() + "}" : "}";
 
-			types.insert(name + " = type " + body);
+			info.types.push_back(name + " = type " + body);
 			return name;
 		}
 		case llvm::dwarf::DW_TAG_subroutine_type:
@@ -457,7 +559,7 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 			{
 				if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
 				{
-					ret = loadDwarf_type(odie);
+					ret = loadDwarf_type(info, odie);
 				}
 			}
 
@@ -471,7 +573,7 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 					{
 						if (auto odie = c.getDwarfUnit()->getDIEForOffset(o.getValue()))
 						{
-							param = loadDwarf_type(odie);
+							param = loadDwarf_type(info, odie);
 						}
 					}
 
@@ -490,8 +592,9 @@ std::string DebugFormat::_loadDwarf_type(llvm::DWARFDie die)
 }
 
 retdec::common::Object DebugFormat::loadDwarf_formal_parameter(
+		DwarfUnitInfo& info,
 		llvm::DWARFDie die,
-		unsigned argCntr)
+		unsigned argCntr) const
 {
 	std::string name = std::string("a") + std::to_string(argCntr);
 	if (auto n = llvm::dwarf::toString(die.find(
@@ -510,13 +613,15 @@ retdec::common::Object DebugFormat::loadDwarf_formal_parameter(
 	{
 		if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
 		{
-			arg.type = loadDwarf_type(odie);
+			arg.type = loadDwarf_type(info, odie);
 		}
 	}
 	return arg;
 }
 
-retdec::common::Object DebugFormat::loadDwarf_variable(llvm::DWARFDie die)
+retdec::common::Object DebugFormat::loadDwarf_variable(
+		DwarfUnitInfo& info,
+		llvm::DWARFDie die) const
 {
 	std::string name;
 	if (auto n = llvm::dwarf::toString(die.find(
@@ -581,7 +686,7 @@ retdec::common::Object DebugFormat::loadDwarf_variable(llvm::DWARFDie die)
 	{
 		if (auto odie = die.getDwarfUnit()->getDIEForOffset(o.getValue()))
 		{
-			var.type = loadDwarf_type(odie);
+			var.type = loadDwarf_type(info, odie);
 		}
 	}
 	return var;
@@ -8,6 +8,7 @@ if(NOT TARGET retdec::debugformat)
             fileformat
             common
             pdbparser
+            utils
             llvm
     )
 
@@ -14,6 +14,7 @@
 
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/file_io.h"
+#include "retdec/utils/interval_index.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/system.h"
 #include "retdec/utils/io/log.h"
@@ -21,7 +22,7 @@
 #include "retdec/fileformat/utils/byte_array_buffer.h"
 #include "retdec/fileformat/file_format/intel_hex/intel_hex_format.h"
 #include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
-#include "retdec/fileformat/types/strings/character_iterator.h"
+#include "retdec/fileformat/types/strings/string_scanner.h"
 #include "retdec/fileformat/utils/conversions.h"
 #include "retdec/fileformat/utils/crypto.h"
 #include "retdec/fileformat/utils/file_io.h"
@@ -113,22 +114,55 @@ bool isAddressFromRegion(const SecSeg *actualRegion, const SecSeg *newRegion, st
 
 } // anonymous namespace
 
+/**
+ * Index of sections and segments by their offsets and addresses. It is built
+ * lazily and rebuilt whenever sections, segments or their layout change.
+ */
+struct FileFormat::SecSegIndex
+{
+	bool valid = false;
+	const void *sectionsData = nullptr;
+	std::size_t sectionsSize = 0;
+	const void *segmentsData = nullptr;
+	std::size_t segmentsSize = 0;
+	std::uint64_t layoutGeneration = 0;
+
+	IntervalIndex<const SecSeg*> sectionsByOffset;
+	IntervalIndex<const SecSeg*> segmentsByOffset;
+	IntervalIndex<const SecSeg*> sectionsByAddress;
+	IntervalIndex<const SecSeg*> segmentsByAddress;
+};
+
 /**
  * Constructor
  * @param pathToFile Path to input file
  * @param loadFlags Load flags
+ *
+ * Input file is mapped into memory whenever possible, so its content is
+ * neither copied nor read until it is really accessed. If the file cannot be
+ * mapped, it is read into memory.
  */
 FileFormat::FileFormat(const std::string & pathToFile, LoadFlags loadFlags) :
-		auxBuff(nullptr, nullptr),
+		mappedFile(std::make_unique<MemoryMappedFile>(pathToFile)),
+		auxBuff(mappedFile->getData(), mappedFile->getSize()),
 		auxIStream(&auxBuff),
-		loadedBytes(&bytes),
 		loadFlags(loadFlags),
 		filePath(pathToFile),
-		fileStream(auxFStream),
+		fileStream(mappedFile->isOpen() ? auxIStream : auxFStream),
 		_ldrErrInfo()
 {
-	auxFStream.open(filePath, std::ifstream::binary);
-	stateIsValid = auxFStream.is_open();
+	if(mappedFile->isOpen())
+	{
+		stateIsValid = true;
+		initBytes(mappedFile->getData(), mappedFile->getSize());
+	}
+	else
+	{
+		mappedFile.reset();
+		auxFStream.open(filePath, std::ifstream::binary);
+		stateIsValid = auxFStream.is_open();
+		initBytes();
+	}
 	init();
 }
 
@@ -140,12 +174,12 @@ FileFormat::FileFormat(const std::string & pathToFile, LoadFlags loadFlags) :
 FileFormat::FileFormat(std::istream &inputStream, LoadFlags loadFlags) :
 		auxBuff(nullptr, nullptr),
 		auxIStream(&auxBuff),
-		loadedBytes(&bytes),
 		loadFlags(loadFlags),
 		fileStream(inputStream),
 		_ldrErrInfo()
 {
 	stateIsValid = !inputStream.fail();
+	initBytes();
 	init();
 }
 
@@ -154,16 +188,20 @@ FileFormat::FileFormat(std::istream &inputStream, LoadFlags loadFlags) :
  * @param data Input data.
  * @param size Input data size.
  * @param loadFlags Load flags
+ *
+ * Input data are copied, so they may be released once the instance is
+ * created. Use the constructor taking a path to a file to avoid the copy.
  */
 FileFormat::FileFormat(const std::uint8_t *data, std::size_t size, LoadFlags loadFlags) :
-		auxBuff(data, size),
+		streamBytes(data, data + size),
+		auxBuff(streamBytes.data(), streamBytes.size()),
 		auxIStream(&auxBuff),
-		loadedBytes(&bytes),
 		loadFlags(loadFlags),
 		fileStream(auxIStream),
 		_ldrErrInfo()
 {
 	stateIsValid = true;
+	initBytes(streamBytes.data(), streamBytes.size());
 	init();
 }
 
@@ -180,6 +218,7 @@ FileFormat::~FileFormat()
  */
 void FileFormat::init()
 {
+	secSegIndex = std::make_unique<SecSegIndex>();
 	importTable = nullptr;
 	exportTable = nullptr;
 	resourceTable = nullptr;
@@ -190,20 +229,116 @@ void FileFormat::init()
 	tlsInfo = nullptr;
 	elfCoreInfo = nullptr;
 	fileFormat = Format::UNDETECTABLE;
-	stateIsValid = readFile(fileStream, bytes) && stateIsValid;
-	if (getLoadFlags() & LoadFlags::NO_FILE_HASHES)
+	initStream();
+}
+
+/**
+ * Read content of input file from member @c fileStream
+ */
+void FileFormat::initBytes()
+{
+	stateIsValid = readFile(fileStream, streamBytes) && stateIsValid;
+	bytes = streamBytes;
+	loadedBytes = bytes;
+}
+
+/**
+ * Use content of input file which is already present in memory
+ * @param data Content of input file
+ * @param size Size of content of input file
+ */
+void FileFormat::initBytes(const std::uint8_t *data, std::size_t size)
+{
+	bytes = llvm::ArrayRef<unsigned char>(data, size);
+	loadedBytes = bytes;
+}
+
+/**
+ * Compute hashes of file content. They are computed only once, when any
+ * of them is requested for the first time.
+ */
+void FileFormat::computeFileHashes() const
+{
+	std::call_once(fileHashesComputed, [this]() {
+		if(getLoadFlags() & LoadFlags::NO_FILE_HASHES)
+		{
+			return;
+		}
+
+		getCrc32Md5Sha256(bytes.data(), bytes.size(), crc32, md5, sha256);
+	});
+}
+
+/**
+ * Make sure that the index of sections and segments is up to date and lock it
+ * for reading
+ * @return Lock which keeps the index locked for reading
+ */
+std::shared_lock<std::shared_mutex> FileFormat::lockSecSegIndex() const
+{
+	const auto isUpToDate = [this]()
+	{
+		return secSegIndex->valid
+			&& secSegIndex->sectionsData == sections.data()
+			&& secSegIndex->sectionsSize == sections.size()
+			&& secSegIndex->segmentsData == segments.data()
+			&& secSegIndex->segmentsSize == segments.size()
+			&& secSegIndex->layoutGeneration == secSegLayoutGeneration;
+	};
+
+	std::shared_lock<std::shared_mutex> lock(secSegIndexMutex);
+	if(isUpToDate())
 	{
-		crc32.clear();
-		md5.clear();
-		sha256.clear();
+		return lock;
 	}
-	else
+	lock.unlock();
+
 	{
-		crc32 = retdec::fileformat::getCrc32(bytes.data(), bytes.size());
-		md5 = retdec::fileformat::getMd5(bytes.data(), bytes.size());
-		sha256 = retdec::fileformat::getSha256(bytes.data(), bytes.size());
+		std::unique_lock<std::shared_mutex> writeLock(secSegIndexMutex);
+		if(!isUpToDate())
+		{
+			auto &index = *secSegIndex;
+			index.layoutGeneration = secSegLayoutGeneration;
+			index.sectionsData = sections.data();
+			index.sectionsSize = sections.size();
+			index.segmentsData = segments.data();
+			index.segmentsSize = segments.size();
+
+			const auto fill = [this](const auto &secSegs, auto &byOffset, auto &byAddress)
+			{
+				byOffset.clear();
+				byAddress.clear();
+				for(auto *item : secSegs)
+				{
+					if(!item)
+					{
+						continue;
+					}
+
+					item->layoutOwner.format = this;
+
+					byOffset.add(item->getOffset(), item->getSizeInFile(), item);
+					if(item->getMemory())
+					{
+						unsigned long long size = 0;
+						if(!item->getSizeInMemory(size))
+						{
+							size = item->getSizeInFile();
+						}
+						byAddress.add(item->getAddress(), size, item);
+					}
+				}
+				byOffset.build();
+				byAddress.build();
+			};
+			fill(sections, index.sectionsByOffset, index.sectionsByAddress);
+			fill(segments, index.segmentsByOffset, index.segmentsByAddress);
+			index.valid = true;
+		}
 	}
-	initStream();
+
+	lock.lock();
+	return lock;
 }
 
 /**
@@ -266,6 +401,7 @@ void FileFormat::clear()
 	symbolTables.clear();
 	relocationTables.clear();
 	dynamicTables.clear();
+	invalidateSecSegIndex();
 }
 
 /**
@@ -316,9 +452,7 @@ void FileFormat::computeSectionTableHashes()
 
 	if(!data.empty())
 	{
-		sectionCrc32 = retdec::fileformat::getCrc32(data.data(), data.size());
-		sectionMd5 = retdec::fileformat::getMd5(data.data(), data.size());
-		sectionSha256 = retdec::fileformat::getSha256(data.data(), data.size());
+		getCrc32Md5Sha256(data.data(), data.size(), sectionCrc32, sectionMd5, sectionSha256);
 	}
 }
 
@@ -330,7 +464,29 @@ void FileFormat::computeSectionTableHashes()
  */
 void FileFormat::setLoadedBytes(std::vector<unsigned char> *lBytes)
 {
-	loadedBytes = lBytes;
+	loadedBytes = *lBytes;
+}
+
+/**
+ * Append bytes to the content of input file. If the content is not owned by
+ * this instance (e.g. input file is mapped into memory), it is copied first.
+ * @param data Bytes to append
+ * @param size Number of bytes to append
+ */
+void FileFormat::appendBytes(const unsigned char *data, std::size_t size)
+{
+	const bool loadedAreBytes = loadedBytes.data() == bytes.data();
+	if(bytes.data() != streamBytes.data())
+	{
+		streamBytes.assign(bytes.begin(), bytes.end());
+	}
+
+	streamBytes.insert(streamBytes.end(), data, data + size);
+	bytes = streamBytes;
+	if(loadedAreBytes)
+	{
+		loadedBytes = bytes;
+	}
 }
 
 /**
@@ -377,22 +533,6 @@ void FileFormat::loadStrings()
 	if (!(getLoadFlags() & LoadFlags::DETECT_STRINGS))
 		return;
 
-	loadStrings(StringType::Ascii, 1);
-	loadStrings(StringType::Wide, 2);
-
-	// Sort and remove duplicates
-	std::sort(strings.begin(), strings.end());
-	auto endItr = std::unique(strings.begin(), strings.end());
-	strings.erase(endItr, strings.end());
-}
-
-/**
- * Load strings of specified type and with specified character size.
- * @param type Type of the strings.
- * @param charSize Character size.
- */
-void FileFormat::loadStrings(StringType type, std::size_t charSize)
-{
 	if (!sections.empty())
 	{
 		for (const auto* sec : sections)
@@ -400,7 +540,7 @@ void FileFormat::loadStrings(StringType type, std::size_t charSize)
 			if (!sec->isSomeData() && !sec->isDebug())
 				continue;
 
-			loadStrings(type, charSize, sec);
+			loadStrings(sec);
 		}
 	}
 	else
@@ -410,33 +550,27 @@ void FileFormat::loadStrings(StringType type, std::size_t charSize)
 			if (!seg->isSomeData() && !seg->isDebug())
 				continue;
 
-			loadStrings(type, charSize, seg);
+			loadStrings(seg);
 		}
 	}
+
+	// Sort and remove duplicates
+	std::sort(strings.begin(), strings.end());
+	auto endItr = std::unique(strings.begin(), strings.end());
+	strings.erase(endItr, strings.end());
 }
 
-void FileFormat::loadStrings(StringType type, std::size_t charSize, const SecSeg* secSeg)
+/**
+ * Load ASCII and wide strings from the specified section or segment.
+ * @param secSeg Section or segment.
+ */
+void FileFormat::loadStrings(const SecSeg* secSeg)
 {
 	CharacterEndianness endian = isLittleEndian() ? CharacterEndianness::Little : CharacterEndianness::Big;
+	StringScanner scanner(DefaultMinStringLength, endian);
 
-	for (auto begin = secSeg->getBytes().begin(), end = secSeg->getBytes().end(), itr = begin; itr != end;)
-	{
-		if (makeCharacterIterator(itr, begin, end, charSize).pointsToValidCharacter(endian))
-		{
-			auto stringBeginItr = makeCharacterIterator(itr, begin, end, charSize);
-			auto stringDataEndItr = makeCharacterIterator(end, begin, end, charSize);
-			auto stringEndItr = stringBeginItr + 1;
-			while (stringEndItr != stringDataEndItr && stringEndItr.pointsToValidCharacter(endian))
-				++stringEndItr;
-
-			if (static_cast<std::size_t>(stringEndItr - stringBeginItr) >= DefaultMinStringLength)
-				strings.emplace_back(type, secSeg->getOffset() + (itr - begin), secSeg->getName(), std::string{stringBeginItr, stringEndItr});
-
-			itr = stringEndItr.getUnderlyingIterator();
-		}
-		else
-			++itr;
-	}
+	auto bytes = secSeg->getBytes();
+	scanner.scan(bytes.bytes_begin(), bytes.size(), secSeg->getOffset(), secSeg->getName(), strings);
 }
 
 /**
@@ -496,6 +630,18 @@ LoadFlags FileFormat::getLoadFlags() const
 	return loadFlags;
 }
 
+/**
+ * Mark the index of sections and segments as outdated
+ *
+ * Changes of offsets, addresses and sizes of sections and segments call this
+ * method by themselves. It has to be called explicitly after sections or
+ * segments are reordered or replaced in place.
+ */
+void FileFormat::invalidateSecSegIndex() const
+{
+	++secSegLayoutGeneration;
+}
+
 /**
  * Get section which is located at offset @a offset
  * @param offset Offset in file
@@ -504,17 +650,21 @@ LoadFlags FileFormat::getLoadFlags() const
  */
 const Section* FileFormat::getSectionFromOffset(unsigned long long offset) const
 {
-	const Section *actSec = nullptr;
+	const SecSeg *actSec = nullptr;
+	const auto lock = lockSecSegIndex();
 
-	for(const auto *item : sections)
+	// Candidates are visited from the greatest offset, so we can stop once
+	// they start before the best one found so far.
+	secSegIndex->sectionsByOffset.forEachContaining(offset, [&](const SecSeg *item)
 	{
 		if(isOffsetFromRegion(actSec, item, offset))
 		{
 			actSec = item;
 		}
-	}
+		return item->getOffset() == actSec->getOffset();
+	});
 
-	return actSec;
+	return static_cast<const Section*>(actSec);
 }
 
 /**
@@ -525,17 +675,19 @@ const Section* FileFormat::getSectionFromOffset(unsigned long long offset) const
  */
 const Segment* FileFormat::getSegmentFromOffset(unsigned long long offset) const
 {
-	const Segment *actSeg = nullptr;
+	const SecSeg *actSeg = nullptr;
+	const auto lock = lockSecSegIndex();
 
-	for(const auto *item : segments)
+	secSegIndex->segmentsByOffset.forEachContaining(offset, [&](const SecSeg *item)
 	{
 		if(isOffsetFromRegion(actSeg, item, offset))
 		{
 			actSeg = item;
 		}
-	}
+		return item->getOffset() == actSeg->getOffset();
+	});
 
-	return actSeg;
+	return static_cast<const Segment*>(actSeg);
 }
 
 /**
@@ -586,17 +738,21 @@ bool FileFormat::haveDataOnOffset(unsigned long long offset) const
  */
 const Section* FileFormat::getSectionFromAddress(unsigned long long address) const
 {
-	const Section *actSec = nullptr;
+	const SecSeg *actSec = nullptr;
+	const auto lock = lockSecSegIndex();
 
-	for(const auto *item : sections)
+	// Candidates are visited from the greatest address, so we can stop once
+	// they start before the best one found so far.
+	secSegIndex->sectionsByAddress.forEachContaining(address, [&](const SecSeg *item)
 	{
 		if(isAddressFromRegion(actSec, item, address))
 		{
 			actSec = item;
 		}
-	}
+		return item->getAddress() == actSec->getAddress();
+	});
 
-	return actSec;
+	return static_cast<const Section*>(actSec);
 }
 
 /**
@@ -607,17 +763,19 @@ const Section* FileFormat::getSectionFromAddress(unsigned long long address) con
  */
 const Segment* FileFormat::getSegmentFromAddress(unsigned long long address) const
 {
-	const Segment *actSeg = nullptr;
+	const SecSeg *actSeg = nullptr;
+	const auto lock = lockSecSegIndex();
 
-	for(const auto *item : segments)
+	secSegIndex->segmentsByAddress.forEachContaining(address, [&](const SecSeg *item)
 	{
 		if(isAddressFromRegion(actSeg, item, address))
 		{
 			actSeg = item;
 		}
-	}
+		return item->getAddress() == actSeg->getAddress();
+	});
 
-	return actSeg;
+	return static_cast<const Segment*>(actSeg);
 }
 
 /**
@@ -878,6 +1036,7 @@ bool FileFormat::isWindowsDriver() const
  */
 bool FileFormat::hasCrc32() const
 {
+	computeFileHashes();
 	return !crc32.empty();
 }
 
@@ -887,6 +1046,7 @@ bool FileFormat::hasCrc32() const
  */
 bool FileFormat::hasMd5() const
 {
+	computeFileHashes();
 	return !md5.empty();
 }
 
@@ -896,6 +1056,7 @@ bool FileFormat::hasMd5() const
  */
 bool FileFormat::hasSha256() const
 {
+	computeFileHashes();
 	return !sha256.empty();
 }
 
@@ -932,6 +1093,7 @@ bool FileFormat::hasSectionTableSha256() const
  */
 std::string FileFormat::getCrc32() const
 {
+	computeFileHashes();
 	return crc32;
 }
 
@@ -941,6 +1103,7 @@ std::string FileFormat::getCrc32() const
  */
 std::string FileFormat::getMd5() const
 {
+	computeFileHashes();
 	return md5;
 }
 
@@ -950,6 +1113,7 @@ std::string FileFormat::getMd5() const
  */
 std::string FileFormat::getSha256() const
 {
+	computeFileHashes();
 	return sha256;
 }
 
@@ -1060,7 +1224,7 @@ std::size_t FileFormat::getFileLength() const
  */
 std::size_t FileFormat::getLoadedFileLength() const
 {
-	return loadedBytes->size();
+	return loadedBytes.size();
 }
 
 /**
@@ -1194,7 +1358,7 @@ bool FileFormat::getBytes(std::vector<std::uint8_t> &result, unsigned long long
 	numberOfBytes = offset + numberOfBytes > getLoadedFileLength() ? getLoadedFileLength() - offset : numberOfBytes;
 	result.clear();
 	result.reserve(numberOfBytes);
-	std::copy(loadedBytes->begin() + offset, loadedBytes->begin() + offset + numberOfBytes, std::back_inserter(result));
+	std::copy(loadedBytes.begin() + offset, loadedBytes.begin() + offset + numberOfBytes, std::back_inserter(result));
 	return true;
 }
 
@@ -1230,7 +1394,7 @@ bool FileFormat::getEpBytes(std::vector<std::uint8_t> &result, unsigned long lon
  */
 bool FileFormat::getHexBytes(std::string &result, unsigned long long offset, unsigned long long numberOfBytes) const
 {
-	bytesToHexString(*loadedBytes, result, offset, numberOfBytes);
+	bytesToHexString(loadedBytes.data(), loadedBytes.size(), result, offset, numberOfBytes);
 	return offset < getLoadedFileLength();
 }
 
@@ -1281,7 +1445,7 @@ bool FileFormat::getHexBytesFromEnd(std::string &result, unsigned long long numb
  */
 bool FileFormat::getString(std::string &result, unsigned long long offset, unsigned long long numberOfBytes) const
 {
-	bytesToString(*loadedBytes, result, offset, numberOfBytes);
+	bytesToString(loadedBytes.data(), loadedBytes.size(), result, offset, numberOfBytes);
 	return offset < getLoadedFileLength();
 }
 
@@ -1878,7 +2042,7 @@ const std::vector<DynamicTable*>& FileFormat::getDynamicTables() const
  * Get content of input file as bytes
  * @return Content of input file as bytes
  */
-const std::vector<unsigned char>& FileFormat::getBytes() const
+llvm::ArrayRef<unsigned char> FileFormat::getBytes() const
 {
 	return bytes;
 }
@@ -1887,9 +2051,9 @@ const std::vector<unsigned char>& FileFormat::getBytes() const
  * Get serialized loaded content of input file as bytes
  * @return Serialized content of input file as bytes
  */
-const std::vector<unsigned char>& FileFormat::getLoadedBytes() const
+llvm::ArrayRef<unsigned char> FileFormat::getLoadedBytes() const
 {
-	return *loadedBytes;
+	return loadedBytes;
 }
 
 /**
@@ -1907,7 +2071,7 @@ const unsigned char* FileFormat::getBytesData() const
  */
 const unsigned char* FileFormat::getLoadedBytesData() const
 {
-	return loadedBytes->data();
+	return loadedBytes.data();
 }
 
 /**
@@ -1966,7 +2130,7 @@ bool FileFormat::getXByte(std::uint64_t address, std::uint64_t x, std::uint64_t
 	const auto secOffset = address - secSeg->getAddress();
 	const auto offset = secSeg->getOffset() + secOffset;
 	return (secOffset + x > secSeg->getLoadedSize() || offset + x > getLoadedFileLength()) ?
-		false : createValueFromBytes(*loadedBytes, res, e, offset, x);
+		false : createValueFromBytes(loadedBytes.data(), loadedBytes.size(), res, e, offset, x);
 }
 
 /**
@@ -2106,7 +2270,7 @@ bool FileFormat::getXByteOffset(std::uint64_t offset, std::uint64_t x, std::uint
 		return true;
 	}
 
-	return createValueFromBytes(*loadedBytes, res, e, offset, x);
+	return createValueFromBytes(loadedBytes.data(), loadedBytes.size(), res, e, offset, x);
 }
 
 /**
@@ -2121,7 +2285,7 @@ bool FileFormat::getXBytesOffset(std::uint64_t offset, std::uint64_t x, std::vec
 	res.clear();
 	if(offset + x <= getLoadedFileLength())
 	{
-		res.assign(loadedBytes->begin() + offset, loadedBytes->begin() + offset + x);
+		res.assign(loadedBytes.begin() + offset, loadedBytes.begin() + offset + x);
 		return res.size() == x;
 	}
 
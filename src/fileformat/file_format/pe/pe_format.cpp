@@ -612,10 +612,11 @@ void PeFormat::initStructures(const std::string & dllListFile)
 	{
 		try
 		{
-			if(file->loadPeHeaders(bytes) == ERROR_NONE)
+			const ByteView fileData(bytes.data(), bytes.size());
+			if(file->loadPeHeaders(fileData) == ERROR_NONE)
 				stateIsValid = true;
 
-			file->readCoffSymbolTable(bytes);
+			file->readCoffSymbolTable(fileData);
 			file->readImportDirectory();
 			file->readIatDirectory();
 			file->readBoundImportDirectory();
@@ -766,7 +767,7 @@ void PeFormat::loadRichHeader()
 	}
 
 	std::string plainText;
-	bytesToString(bytes, plainText, getMzHeaderSize(), getPeHeaderOffset() - getMzHeaderSize());
+	bytesToString(bytes.data(), bytes.size(), plainText, getMzHeaderSize(), getPeHeaderOffset() - getMzHeaderSize());
 	auto offset = getRichHeaderOffset(plainText);
 	auto standardOffset = (offset == STANDARD_RICH_HEADER_OFFSET);
 	if(offset >= getPeHeaderOffset())
@@ -32,6 +32,18 @@ void SecSeg::computeHashes()
 	sha256 = retdec::fileformat::getSha256(hashData, bytes.size());
 }
 
+/**
+ * Notify the file format which owns this section or segment that its offset,
+ * address, size or presence in memory has changed
+ */
+void SecSeg::layoutChanged()
+{
+	if(layoutOwner.format)
+	{
+		layoutOwner.format->invalidateSecSegIndex();
+	}
+}
+
 /**
  * Check if section type is undefined
  * @return @c true if section type is undefined, @c false otherwise
@@ -469,6 +481,7 @@ void SecSeg::setIndex(unsigned long long sIndex)
 void SecSeg::setOffset(unsigned long long sOffset)
 {
 	offset = sOffset;
+	layoutChanged();
 }
 
 /**
@@ -478,6 +491,7 @@ void SecSeg::setOffset(unsigned long long sOffset)
 void SecSeg::setSizeInFile(unsigned long long sFileSize)
 {
 	fileSize = sFileSize;
+	layoutChanged();
 }
 
 /**
@@ -487,6 +501,7 @@ void SecSeg::setSizeInFile(unsigned long long sFileSize)
 void SecSeg::setAddress(unsigned long long sAddress)
 {
 	address = sAddress;
+	layoutChanged();
 }
 
 /**
@@ -497,6 +512,7 @@ void SecSeg::setSizeInMemory(unsigned long long sMemorySize)
 {
 	memorySize = sMemorySize;
 	memorySizeIsValid = true;
+	layoutChanged();
 }
 
 /**
@@ -516,6 +532,7 @@ void SecSeg::setSizeOfOneEntry(unsigned long long sEntrySize)
 void SecSeg::setMemory(bool sMemory)
 {
 	isInMemory = sMemory;
+	layoutChanged();
 }
 
 /**
@@ -549,6 +566,7 @@ void SecSeg::computeEntropy()
 void SecSeg::invalidateMemorySize()
 {
 	memorySizeIsValid = false;
+	layoutChanged();
 }
 
 /**
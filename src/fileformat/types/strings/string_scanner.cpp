@@ -0,0 +1,297 @@
+/**
+ * @file src/fileformat/types/strings/string_scanner.cpp
+ * @brief Class for finding strings in raw bytes.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+
+#include <llvm/Support/MathExtras.h>
+
+#include "retdec/fileformat/types/strings/string_scanner.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define RETDEC_STRING_SCANNER_SSE2
+	#include <emmintrin.h>
+	#if defined(__GNUC__) || defined(__clang__)
+		#define RETDEC_STRING_SCANNER_AVX2
+		#include <immintrin.h>
+	#endif
+#endif
+
+namespace retdec {
+namespace fileformat {
+
+namespace
+{
+
+/// Number of bytes classified at once.
+const std::size_t BlockSize = 64;
+
+/**
+ * Bit masks of a block of bytes. Bit @c i corresponds to byte @c i.
+ */
+struct BlockMasks
+{
+	std::uint64_t printable = 0; ///< bytes in the range 0x20-0x7e
+	std::uint64_t zero = 0;      ///< zero bytes
+};
+
+using ClassifyFunction = BlockMasks (*)(const std::uint8_t*);
+
+bool isPrintable(std::uint8_t byte)
+{
+	return static_cast<std::uint8_t>(byte - 0x20) < 0x5f;
+}
+
+BlockMasks classifyScalar(const std::uint8_t* data)
+{
+	BlockMasks masks;
+	for (std::size_t i = 0; i < BlockSize; ++i)
+	{
+		masks.printable |= static_cast<std::uint64_t>(isPrintable(data[i])) << i;
+		masks.zero |= static_cast<std::uint64_t>(data[i] == 0) << i;
+	}
+	return masks;
+}
+
+#ifdef RETDEC_STRING_SCANNER_SSE2
+BlockMasks classifySse2(const std::uint8_t* data)
+{
+	// Byte b is printable if (b - 0x20) <= 0x5e as an unsigned number, which
+	// is (b - 0x20) == min(b - 0x20, 0x5e) in SSE2.
+	const auto low = _mm_set1_epi8(0x20);
+	const auto range = _mm_set1_epi8(0x5e);
+	const auto zero = _mm_setzero_si128();
+
+	BlockMasks masks;
+	for (std::size_t i = 0; i < BlockSize; i += 16)
+	{
+		auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+		auto shifted = _mm_sub_epi8(bytes, low);
+		auto printable = _mm_cmpeq_epi8(_mm_min_epu8(shifted, range), shifted);
+		auto zeros = _mm_cmpeq_epi8(bytes, zero);
+		masks.printable |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(printable))) << i;
+		masks.zero |= static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(zeros))) << i;
+	}
+	return masks;
+}
+#endif
+
+#ifdef RETDEC_STRING_SCANNER_AVX2
+__attribute__((target("avx2")))
+BlockMasks classifyAvx2(const std::uint8_t* data)
+{
+	const auto low = _mm256_set1_epi8(0x20);
+	const auto range = _mm256_set1_epi8(0x5e);
+	const auto zero = _mm256_setzero_si256();
+
+	BlockMasks masks;
+	for (std::size_t i = 0; i < BlockSize; i += 32)
+	{
+		auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+		auto shifted = _mm256_sub_epi8(bytes, low);
+		auto printable = _mm256_cmpeq_epi8(_mm256_min_epu8(shifted, range), shifted);
+		auto zeros = _mm256_cmpeq_epi8(bytes, zero);
+		masks.printable |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(printable))) << i;
+		masks.zero |= static_cast<std::uint64_t>(static_cast<std::uint32_t>(_mm256_movemask_epi8(zeros))) << i;
+	}
+	return masks;
+}
+#endif
+
+ClassifyFunction getClassifyFunction(StringScanner::Implementation implementation)
+{
+	switch (implementation)
+	{
+#ifdef RETDEC_STRING_SCANNER_AVX2
+		case StringScanner::Implementation::Avx2:
+			return classifyAvx2;
+#endif
+#ifdef RETDEC_STRING_SCANNER_SSE2
+		case StringScanner::Implementation::Sse2:
+			return classifySse2;
+#endif
+		default:
+			return classifyScalar;
+	}
+}
+
+/**
+ * Start of a run of characters that is being scanned.
+ */
+struct Run
+{
+	bool active = false;
+	std::size_t start = 0;
+};
+
+} // anonymous namespace
+
+/**
+ * Constructor. Uses the best implementation supported by the CPU.
+ * @param minLength Minimal length of found strings (in characters).
+ * @param endian Endianness of wide characters.
+ */
+StringScanner::StringScanner(std::size_t minLength, CharacterEndianness endian)
+	: StringScanner(minLength, endian, getBestImplementation())
+{
+}
+
+/**
+ * Constructor.
+ * @param minLength Minimal length of found strings (in characters).
+ * @param endian Endianness of wide characters.
+ * @param implementation Implementation to be used. If it is not supported by
+ *                       the CPU, the scalar implementation is used instead.
+ */
+StringScanner::StringScanner(std::size_t minLength, CharacterEndianness endian, Implementation implementation)
+	: minLength(minLength), endian(endian), implementation(isSupported(implementation) ? implementation : Implementation::Scalar)
+{
+}
+
+/**
+ * Returns the implementation that is used by the scanner.
+ */
+StringScanner::Implementation StringScanner::getImplementation() const
+{
+	return implementation;
+}
+
+/**
+ * Finds all ASCII and wide strings in the given bytes and appends them to
+ * @a strings.
+ * @param data Scanned bytes.
+ * @param size Number of scanned bytes.
+ * @param fileOffset Offset of @a data in the file.
+ * @param sectionName Name of the section (or segment) with @a data.
+ * @param strings Into this parameter the found strings are appended.
+ */
+void StringScanner::scan(
+		const std::uint8_t* data,
+		std::size_t size,
+		std::uint64_t fileOffset,
+		const std::string& sectionName,
+		std::vector<String>& strings) const
+{
+	const auto classify = getClassifyFunction(implementation);
+	const bool littleEndian = endian == CharacterEndianness::Little;
+
+	auto addAscii = [&](std::size_t start, std::size_t end) {
+		if (end - start >= minLength)
+		{
+			strings.emplace_back(StringType::Ascii, fileOffset + start, sectionName,
+					std::string(reinterpret_cast<const char*>(data + start), end - start));
+		}
+	};
+	auto addWide = [&](std::size_t start, std::size_t end) {
+		if ((end - start) / 2 < minLength)
+			return;
+
+		std::string content;
+		content.reserve((end - start) / 2);
+		for (auto i = start + (littleEndian ? 0 : 1); i < end; i += 2)
+			content.push_back(static_cast<char>(data[i]));
+		strings.emplace_back(StringType::Wide, fileOffset + start, sectionName, std::move(content));
+	};
+
+	// Bit i of the wide mask is set if bytes i and i + 1 form a wide
+	// character. Runs of wide characters are runs of set bits at the same
+	// parity, so the two parities are tracked separately. Runs are delimited
+	// by toggles, i.e. bits that differ from the bit one (ASCII) or two
+	// (wide) positions before. The extra block after the data closes all
+	// runs that reach the end.
+	Run ascii, wide[2];
+	std::uint64_t prevPrintable = 0, prevWide = 0;
+	for (std::size_t base = 0; base <= size; base += BlockSize)
+	{
+		BlockMasks masks;
+		if (base + BlockSize <= size)
+		{
+			masks = classify(data + base);
+		}
+		else if (base < size)
+		{
+			std::uint8_t tail[BlockSize] = {};
+			std::copy(data + base, data + size, tail);
+			masks = classify(tail);
+			auto valid = (std::uint64_t{1} << (size - base)) - 1;
+			masks.printable &= valid;
+			masks.zero &= valid;
+		}
+
+		std::uint64_t next = 0;
+		if (base + BlockSize < size)
+			next = littleEndian ? data[base + BlockSize] == 0 : isPrintable(data[base + BlockSize]);
+		auto wideMask = littleEndian
+			? masks.printable & ((masks.zero >> 1) | (next << 63))
+			: masks.zero & ((masks.printable >> 1) | (next << 63));
+
+		auto asciiToggles = masks.printable ^ ((masks.printable << 1) | (prevPrintable >> 63));
+		while (asciiToggles)
+		{
+			auto pos = base + llvm::countTrailingZeros(asciiToggles);
+			if (ascii.active)
+				addAscii(ascii.start, pos);
+			else
+				ascii.start = pos;
+			ascii.active = !ascii.active;
+			asciiToggles &= asciiToggles - 1;
+		}
+
+		auto wideToggles = wideMask ^ ((wideMask << 2) | (prevWide >> 62));
+		while (wideToggles)
+		{
+			auto pos = base + llvm::countTrailingZeros(wideToggles);
+			auto& run = wide[pos & 1];
+			if (run.active)
+				addWide(run.start, pos);
+			else
+				run.start = pos;
+			run.active = !run.active;
+			wideToggles &= wideToggles - 1;
+		}
+
+		prevPrintable = masks.printable;
+		prevWide = wideMask;
+	}
+}
+
+/**
+ * Returns the fastest implementation supported by the CPU.
+ */
+StringScanner::Implementation StringScanner::getBestImplementation()
+{
+	if (isSupported(Implementation::Avx2))
+		return Implementation::Avx2;
+	else if (isSupported(Implementation::Sse2))
+		return Implementation::Sse2;
+	else
+		return Implementation::Scalar;
+}
+
+/**
+ * Checks whether the given implementation is supported by the CPU and by the
+ * compiler this library was built with.
+ */
+bool StringScanner::isSupported(Implementation implementation)
+{
+	switch (implementation)
+	{
+		case Implementation::Scalar:
+			return true;
+#ifdef RETDEC_STRING_SCANNER_SSE2
+		case Implementation::Sse2:
+			return true;
+#endif
+#ifdef RETDEC_STRING_SCANNER_AVX2
+		case Implementation::Avx2:
+			return __builtin_cpu_supports("avx2");
+#endif
+		default:
+			return false;
+	}
+}
+
+} // namespace fileformat
+} // namespace retdec
@@ -4,10 +4,13 @@
  * @copyright (c) 2020 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
 #include <climits>
 #include <cmath>
+#include <memory>
 #include <vector>
 
+#include <openssl/evp.h>
 #include <openssl/md5.h>
 #include <openssl/sha.h>
 
@@ -18,6 +21,47 @@
 namespace retdec {
 namespace fileformat {
 
+namespace
+{
+
+/**
+ * Number of bytes fed to all the digests at once. The chunk is small enough
+ * to stay in the cache while it is being hashed by all of them.
+ */
+const std::uint64_t HashChunkSize = 64 * 1024;
+
+using EvpMdCtxPtr = std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>;
+
+/**
+ * @brief Create digest context initialized for the given message digest.
+ */
+EvpMdCtxPtr createDigest(const EVP_MD *type)
+{
+	EvpMdCtxPtr ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+	if (ctx)
+	{
+		EVP_DigestInit_ex(ctx.get(), type, nullptr);
+	}
+	return ctx;
+}
+
+/**
+ * @brief Finish the digest and return it as a lowercase hex string.
+ */
+std::string finishDigest(EVP_MD_CTX *ctx)
+{
+	std::vector<unsigned char> digest(EVP_MAX_MD_SIZE);
+	unsigned int digestLength = 0;
+	EVP_DigestFinal_ex(ctx, digest.data(), &digestLength);
+	digest.resize(digestLength);
+
+	std::string result;
+	retdec::utils::bytesToHexString(digest, result, 0, 0, false);
+	return result;
+}
+
+} // anonymous namespace
+
 /**
  * @brief Count CRC32 of @a data.
  * @param[in] data Input data.
@@ -78,5 +122,50 @@ std::string getSha256(const unsigned char *data, std::uint64_t length)
 	return sha;
 }
 
+/**
+ * @brief Count CRC32, MD5 and SHA256 of @a data in a single pass.
+ * @param[in] data Input data.
+ * @param[in] length Length of input data.
+ * @param[out] crc32 CRC32 of input data.
+ * @param[out] md5 MD5 of input data.
+ * @param[out] sha256 SHA256 of input data.
+ *
+ * The result is the same as when calling getCrc32(), getMd5() and getSha256()
+ * one after another, but input data are read from memory only once. They are
+ * processed in chunks which are fed to all the digests while they are still
+ * in the cache.
+ */
+void getCrc32Md5Sha256(
+		const unsigned char *data,
+		std::uint64_t length,
+		std::string &crc32,
+		std::string &md5,
+		std::string &sha256)
+{
+	auto md5Ctx = createDigest(EVP_md5());
+	auto sha256Ctx = createDigest(EVP_sha256());
+	if (!md5Ctx || !sha256Ctx)
+	{
+		crc32 = getCrc32(data, length);
+		md5 = getMd5(data, length);
+		sha256 = getSha256(data, length);
+		return;
+	}
+
+	retdec::utils::CRC32 crc;
+	for (std::uint64_t offset = 0; offset < length; offset += HashChunkSize)
+	{
+		const auto *chunk = data + offset;
+		const auto chunkSize = std::min(HashChunkSize, length - offset);
+		crc.add(chunk, chunkSize);
+		EVP_DigestUpdate(md5Ctx.get(), chunk, chunkSize);
+		EVP_DigestUpdate(sha256Ctx.get(), chunk, chunkSize);
+	}
+
+	crc32 = crc.getHash();
+	md5 = finishDigest(md5Ctx.get());
+	sha256 = finishDigest(sha256Ctx.get());
+}
+
 } // namespace fileformat
 } // namespace retdec
@@ -0,0 +1,421 @@
+/**
+ * @file src/fileinfo/batch_processor/batch_processor.cpp
+ * @brief Methods of BatchProcessor class.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <thread>
+
+#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/os.h"
+#include "retdec/utils/string.h"
+#include "fileinfo/batch_processor/batch_processor.h"
+
+#ifdef OS_POSIX
+	#include <cerrno>
+	#include <poll.h>
+	#include <signal.h>
+	#include <sys/wait.h>
+	#include <unistd.h>
+#endif
+
+namespace retdec {
+namespace fileinfo {
+
+namespace
+{
+
+#ifdef OS_POSIX
+
+using Clock = std::chrono::steady_clock;
+
+/// Exit code of a child whose result is the result of the analysis.
+const int ChildSucceeded = 0;
+/// Exit code of a child whose result is an error record.
+const int ChildFailed = 1;
+
+/// Write end of the pipe to the parent if the current process is a child
+/// which analyzes a file of a batch.
+int resultFd = -1;
+
+/**
+ * Child process which analyzes a single file
+ */
+struct Child
+{
+	pid_t pid;                    ///< process ID of the child
+	int fd;                       ///< read end of the pipe with the result
+	std::string filePath;         ///< analyzed file
+	std::string result;           ///< part of the result read so far
+	Clock::time_point deadline;   ///< time when the analysis times out
+};
+
+/**
+ * Send @a result to the parent and terminate the current child
+ *
+ * The child terminates without destroying static objects and flushing
+ * streams, which are copies of the objects of the parent.
+ */
+[[noreturn]] void finishChild(const std::string& result, bool failed)
+{
+	const char* data = result.data();
+	std::size_t size = result.size();
+	while (size > 0)
+	{
+		auto written = write(resultFd, data, size);
+		if (written < 0 && errno == EINTR)
+		{
+			continue;
+		}
+		else if (written <= 0)
+		{
+			break;
+		}
+		data += written;
+		size -= written;
+	}
+	_exit(failed ? ChildFailed : ChildSucceeded);
+}
+
+/**
+ * Wait until the child @a pid terminates
+ * @return Status of the child as returned by @c waitpid()
+ */
+int waitForChild(pid_t pid)
+{
+	int status = 0;
+	while (waitpid(pid, &status, 0) < 0 && errno == EINTR)
+	{
+	}
+	return status;
+}
+
+/**
+ * Get the time in milliseconds until the nearest deadline of @a children
+ * for @c poll() (-1 means no deadline)
+ */
+int getPollTimeout(const std::vector<Child>& children)
+{
+	auto nearest = std::min_element(children.begin(), children.end(), [](const auto& a, const auto& b) {
+		return a.deadline < b.deadline;
+	});
+	if (nearest == children.end() || nearest->deadline == Clock::time_point::max())
+	{
+		return -1;
+	}
+
+	auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(nearest->deadline - Clock::now());
+	// Round up, so that the deadline has passed when poll() times out.
+	return static_cast<int>(std::max<std::chrono::milliseconds::rep>(0, remaining.count() + 1));
+}
+
+#endif
+
+} // anonymous namespace
+
+/**
+ * Constructor
+ * @param analysis Analysis of a single file
+ * @param jobs Maximal number of files analyzed at once (0 means the number of
+ *             hardware threads)
+ * @param timeout Time limit of the analysis of one file (0 means no limit)
+ */
+BatchProcessor::BatchProcessor(Analysis analysis, std::size_t jobs, std::chrono::seconds timeout)
+	: analysis(std::move(analysis)), jobs(jobs), timeout(timeout)
+{
+	if (this->jobs == 0)
+	{
+		this->jobs = std::max(1u, std::thread::hardware_concurrency());
+	}
+}
+
+/**
+ * Analyze all @a files and print their results into @a out
+ * @return Number of files for which an error record was printed
+ *
+ * On POSIX systems, the current process forks children, so it must not run
+ * any other threads when this method is called.
+ */
+std::size_t BatchProcessor::process(const std::vector<std::string>& files, std::ostream& out)
+{
+#ifdef OS_POSIX
+	return processInChildren(files, out);
+#else
+	return processInCurrentProcess(files, out);
+#endif
+}
+
+/**
+ * Run the analysis of @a filePath in the current process
+ * @param filePath Path to the file
+ * @param failed Set to @c true if the returned result is an error record
+ * @return Result of the analysis or error record
+ */
+std::string BatchProcessor::analyzeFile(const std::string& filePath, bool& failed) const
+{
+	failed = true;
+	try
+	{
+		auto result = analysis(filePath);
+		failed = false;
+		return result;
+	}
+	catch (const std::exception& e)
+	{
+		return getErrorRecord(filePath, std::string("Analysis failed: ") + e.what());
+	}
+	catch (...)
+	{
+		return getErrorRecord(filePath, "Analysis failed.");
+	}
+}
+
+#ifdef OS_POSIX
+/**
+ * Analyze every file of @a files in its own child process
+ * @return Number of files for which an error record was printed
+ */
+std::size_t BatchProcessor::processInChildren(const std::vector<std::string>& files, std::ostream& out)
+{
+	std::vector<Child> running;
+	std::size_t failures = 0;
+	std::size_t next = 0;
+
+	// Children must not inherit unflushed output.
+	out.flush();
+	while (next < files.size() || !running.empty())
+	{
+		while (running.size() < jobs && next < files.size())
+		{
+			const auto& filePath = files[next++];
+			int fds[2];
+			pid_t pid = -1;
+			if (pipe(fds) == 0)
+			{
+				pid = fork();
+				if (pid == 0)
+				{
+					close(fds[0]);
+					for (const auto& child : running)
+					{
+						close(child.fd);
+					}
+					resultFd = fds[1];
+					bool failed = false;
+					auto result = analyzeFile(filePath, failed);
+					finishChild(result, failed);
+				}
+				close(fds[1]);
+				if (pid < 0)
+				{
+					close(fds[0]);
+				}
+			}
+			if (pid < 0)
+			{
+				out << getErrorRecord(filePath, "Failed to start the analysis.") << '\n';
+				++failures;
+				continue;
+			}
+
+			auto deadline = timeout.count() ? Clock::now() + timeout : Clock::time_point::max();
+			running.push_back({pid, fds[0], filePath, std::string(), deadline});
+		}
+
+		std::vector<pollfd> fds;
+		for (const auto& child : running)
+		{
+			fds.push_back({child.fd, POLLIN, 0});
+		}
+		if (!fds.empty() && poll(fds.data(), fds.size(), getPollTimeout(running)) < 0)
+		{
+			// Interrupted by a signal, so nothing is ready.
+			for (auto& fd : fds)
+			{
+				fd.revents = 0;
+			}
+		}
+
+		auto now = Clock::now();
+		std::vector<Child> stillRunning;
+		for (std::size_t i = 0; i < running.size(); ++i)
+		{
+			auto& child = running[i];
+			bool finished = false;
+			if (fds[i].revents)
+			{
+				char buffer[4096];
+				auto size = read(child.fd, buffer, sizeof(buffer));
+				if (size > 0)
+				{
+					child.result.append(buffer, size);
+				}
+				else if (size == 0 || errno != EINTR)
+				{
+					finished = true;
+				}
+			}
+
+			if (finished)
+			{
+				close(child.fd);
+				auto status = waitForChild(child.pid);
+				if (WIFEXITED(status)
+						&& (WEXITSTATUS(status) == ChildSucceeded || WEXITSTATUS(status) == ChildFailed)
+						&& !child.result.empty())
+				{
+					out << child.result << '\n';
+					failures += WEXITSTATUS(status) == ChildFailed;
+				}
+				else
+				{
+					auto message = WIFSIGNALED(status)
+							? "Analysis crashed with signal " + std::to_string(WTERMSIG(status)) + "."
+							: std::string("Analysis failed.");
+					out << getErrorRecord(child.filePath, message) << '\n';
+					++failures;
+				}
+			}
+			else if (now >= child.deadline)
+			{
+				kill(child.pid, SIGKILL);
+				close(child.fd);
+				waitForChild(child.pid);
+				out << getErrorRecord(child.filePath,
+						"Analysis timed out after " + std::to_string(timeout.count()) + " seconds.") << '\n';
+				++failures;
+			}
+			else
+			{
+				stillRunning.push_back(std::move(child));
+			}
+		}
+		running = std::move(stillRunning);
+		out.flush();
+	}
+
+	return failures;
+}
+#endif
+
+/**
+ * Analyze @a files one after another in the current process
+ * @return Number of files for which an error record was printed
+ */
+std::size_t BatchProcessor::processInCurrentProcess(const std::vector<std::string>& files, std::ostream& out)
+{
+	std::size_t failures = 0;
+	for (const auto& filePath : files)
+	{
+		bool failed = false;
+		out << analyzeFile(filePath, failed) << '\n';
+		out.flush();
+		failures += failed;
+	}
+	return failures;
+}
+
+/**
+ * Is the time limit of the analysis of one file supported on this system?
+ */
+bool BatchProcessor::isTimeoutSupported()
+{
+#ifdef OS_POSIX
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * Get list of files to process
+ * @param dirOrList Directory whose regular files (including files in its
+ *                  subdirectories) are processed, or a file with one path
+ *                  per line
+ * @param files Into this parameter the paths are stored
+ * @return @c true if the list was obtained, @c false otherwise
+ */
+bool BatchProcessor::getInputFiles(const std::string& dirOrList, std::vector<std::string>& files)
+{
+	std::error_code ec;
+	if (fs::is_directory(dirOrList, ec))
+	{
+		for (fs::recursive_directory_iterator it(dirOrList, ec), end; !ec && it != end; it.increment(ec))
+		{
+			if (it->is_regular_file(ec))
+			{
+				files.push_back(it->path().string());
+			}
+		}
+		std::sort(files.begin(), files.end());
+		return !ec;
+	}
+
+	std::ifstream list(dirOrList);
+	if (!list)
+	{
+		return false;
+	}
+	for (std::string line; std::getline(list, line);)
+	{
+		line = utils::trim(line);
+		if (!line.empty())
+		{
+			files.push_back(line);
+		}
+	}
+	return true;
+}
+
+/**
+ * Get one line of JSON that describes an error of the analysis of a file
+ * @param filePath Path to the file
+ * @param message Error message
+ * @return JSON object with the same keys as the output of the analysis
+ */
+std::string BatchProcessor::getErrorRecord(const std::string& filePath, const std::string& message)
+{
+	rapidjson::StringBuffer sb;
+	rapidjson::Writer<rapidjson::StringBuffer, rapidjson::ASCII<>> writer(sb);
+	writer.StartObject();
+	writer.String("inputFile");
+	writer.String(utils::replaceNonprintableChars(filePath));
+	writer.String("errors");
+	writer.StartArray();
+	writer.String(message);
+	writer.EndArray();
+	writer.EndObject();
+	return sb.GetString();
+}
+
+/**
+ * Finish the analysis of the file processed by the current process with
+ * the given result and terminate the process
+ *
+ * This is meant for errors after which the analysis cannot continue (e.g.
+ * fatal errors of LLVM). If the current process is a child analyzing a file
+ * of a batch, @a result is sent to the parent as an error record of the file
+ * and the other files can still be processed. Otherwise, the process is
+ * terminated with a failure.
+ */
+void BatchProcessor::finishCurrentFile(const std::string& result)
+{
+#ifdef OS_POSIX
+	if (resultFd >= 0)
+	{
+		finishChild(result, true);
+	}
+#else
+	static_cast<void>(result);
+#endif
+	std::exit(EXIT_FAILURE);
+}
+
+} // namespace fileinfo
+} // namespace retdec
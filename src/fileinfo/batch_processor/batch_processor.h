@@ -0,0 +1,73 @@
+/**
+ * @file src/fileinfo/batch_processor/batch_processor.h
+ * @brief Definition of BatchProcessor class.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#ifndef FILEINFO_BATCH_PROCESSOR_BATCH_PROCESSOR_H
+#define FILEINFO_BATCH_PROCESSOR_BATCH_PROCESSOR_H
+
+#include <chrono>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace retdec {
+namespace fileinfo {
+
+/**
+ * Processor of many input files by one command
+ *
+ * On POSIX systems, every file is analyzed in its own child process forked
+ * from the current process, and at most @c jobs files at once. Children
+ * inherit everything the current process prepared before process() was
+ * called (e.g. compiled signatures and YARA rules). Result of every file is
+ * printed as one line of JSON (NDJSON) as soon as the file is finished, so
+ * the order of lines may differ from the order of files.
+ *
+ * Errors are isolated per file: if the analysis throws an exception,
+ * crashes, or runs longer than the timeout, an error record is printed for
+ * the file and the processing continues. A child that exceeds the timeout
+ * is killed, and its slot is reused only after the child has terminated.
+ *
+ * On other systems, files are analyzed one after another in the current
+ * process and the timeout is not supported.
+ */
+class BatchProcessor
+{
+	public:
+		/// Analyzes the given file and returns its result as one line of JSON.
+		using Analysis = std::function<std::string(const std::string&)>;
+	private:
+		Analysis analysis;            ///< analysis of a single file
+		std::size_t jobs;             ///< maximal number of files analyzed at once
+		std::chrono::seconds timeout; ///< time limit of one file (0 means no limit)
+
+		/// @name Auxiliary methods
+		/// @{
+		std::string analyzeFile(const std::string& filePath, bool& failed) const;
+		std::size_t processInChildren(const std::vector<std::string>& files, std::ostream& out);
+		std::size_t processInCurrentProcess(const std::vector<std::string>& files, std::ostream& out);
+		/// @}
+	public:
+		BatchProcessor(Analysis analysis, std::size_t jobs, std::chrono::seconds timeout);
+
+		/// @name Processing
+		/// @{
+		std::size_t process(const std::vector<std::string>& files, std::ostream& out);
+		/// @}
+
+		/// @name Auxiliary methods
+		/// @{
+		static bool isTimeoutSupported();
+		static bool getInputFiles(const std::string& dirOrList, std::vector<std::string>& files);
+		static std::string getErrorRecord(const std::string& filePath, const std::string& message);
+		[[noreturn]] static void finishCurrentFile(const std::string& result);
+		/// @}
+};
+
+} // namespace fileinfo
+} // namespace retdec
+
+#endif
@@ -173,6 +173,22 @@ void FileDetector::getManifestInfo()
 void FileDetector::getImports()
 {
 	fileInfo.setImportTable(fileParser->getImportTable());
+
+	if(ordinals)
+	{
+		switch(fileParser->getTargetArchitecture())
+		{
+			case retdec::fileformat::Architecture::X86:
+			case retdec::fileformat::Architecture::X86_64:
+				fileInfo.setImportOrdinalDatabase(ordinals, "x86");
+				break;
+			case retdec::fileformat::Architecture::ARM:
+				fileInfo.setImportOrdinalDatabase(ordinals, "arm");
+				break;
+			default:
+				break;
+		}
+	}
 }
 
 /**
@@ -325,6 +341,17 @@ void FileDetector::setConfigFile(retdec::config::Config &config)
 			config.parameters.getSectionVMA());
 }
 
+/**
+ * Set database used to get names of functions imported only by ordinals
+ * @param database Database of ordinals or @c nullptr
+ *
+ * Database must outlive the detector.
+ */
+void FileDetector::setOrdinalDatabase(const retdec::utils::OrdinalDatabase *database)
+{
+	ordinals = database;
+}
+
 /**
  * Get all supported information about binary file
  */
@@ -9,6 +9,7 @@
 
 #include "retdec/config/config.h"
 #include "retdec/utils/non_copyable.h"
+#include "retdec/utils/ordinal_database.h"
 #include "fileinfo/file_information/file_information.h"
 
 namespace retdec {
@@ -45,6 +46,7 @@ class FileDetector : private retdec::utils::NonCopyable
 		retdec::config::Config *fileConfig;                         ///< configuration of input file
 		std::shared_ptr<retdec::fileformat::FileFormat> fileParser; ///< parser of input file
 		retdec::fileformat::LoadFlags loadFlags;                    ///< load flags for configurable running
+		const retdec::utils::OrdinalDatabase *ordinals = nullptr;   ///< names of functions imported by ordinals
 		bool loaded;                                                ///< internal state of instance
 
 		/// @name Pure virtual detection methods
@@ -64,6 +66,7 @@ class FileDetector : private retdec::utils::NonCopyable
 		virtual ~FileDetector() = default;
 
 		void setConfigFile(retdec::config::Config &config);
+		void setOrdinalDatabase(const retdec::utils::OrdinalDatabase *database);
 		void getAllInformation();
 		const retdec::fileformat::FileFormat* getFileParser() const;
 };
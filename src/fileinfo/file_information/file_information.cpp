@@ -3811,6 +3811,16 @@ void FileInformation::setImportTable(const retdec::fileformat::ImportTable *sTab
 	importTable.setTable(sTable);
 }
 
+/**
+ * Set database of names of functions imported by ordinals
+ * @param sOrdinals Database of ordinals
+ * @param sArch Architecture of imported libraries in @a sOrdinals
+ */
+void FileInformation::setImportOrdinalDatabase(const retdec::utils::OrdinalDatabase *sOrdinals, const std::string &sArch)
+{
+	importTable.setOrdinalDatabase(sOrdinals, sArch);
+}
+
 /**
  * Set export table
  * @param sTable Information about export table
@@ -560,6 +560,7 @@ class FileInformation
 		void setPdbAge(std::size_t sAge);
 		void setPdbTimeStamp(std::size_t sTimeStamp);
 		void setImportTable(const retdec::fileformat::ImportTable *sTable);
+		void setImportOrdinalDatabase(const retdec::utils::OrdinalDatabase *sOrdinals, const std::string &sArch);
 		void setExportTable(const retdec::fileformat::ExportTable *sTable);
 		void setResourceTable(const retdec::fileformat::ResourceTable *sTable);
 		void setStrings(const std::vector<retdec::fileformat::String> *sStrings);
@@ -74,11 +74,25 @@ const retdec::fileformat::Import* ImportTable::getImport(std::size_t position) c
  * Get import name
  * @param position Index of selected import from table (indexed from 0)
  * @return Import name
+ *
+ * If the import has no name but it has an ordinal number, the name is looked
+ * up in the database of ordinals (if it was set).
  */
 std::string ImportTable::getImportName(std::size_t position) const
 {
 	const auto *record = table ? table->getImport(position) : nullptr;
-	return record ? record->getName() : "";
+	if(!record)
+	{
+		return "";
+	}
+
+	std::uint64_t ordinal;
+	if(record->getName().empty() && ordinals && record->getOrdinalNumber(ordinal))
+	{
+		return ordinals->getName(ordinalsArch, table->getLibrary(record->getLibraryIndex()), ordinal);
+	}
+
+	return record->getName();
 }
 
 std::string ImportTable::getImportUsageType(std::size_t position) const
@@ -174,6 +188,17 @@ void ImportTable::setTable(const retdec::fileformat::ImportTable *importTable)
 	table = importTable;
 }
 
+/**
+ * Set database used to get names of imports without a name
+ * @param database Database of ordinals
+ * @param arch Architecture of imported libraries in @a database
+ */
+void ImportTable::setOrdinalDatabase(const retdec::utils::OrdinalDatabase *database, const std::string &arch)
+{
+	ordinals = database;
+	ordinalsArch = arch;
+}
+
 /**
  * Find out if there are any imports
  * @return @c true if there are some imports, @c false otherwise
@@ -8,6 +8,7 @@
 #define FILEINFO_FILE_INFORMATION_FILE_INFORMATION_TYPES_IMPORT_TABLE_H
 
 #include "retdec/fileformat/types/import_table/import_table.h"
+#include "retdec/utils/ordinal_database.h"
 
 namespace retdec {
 namespace fileinfo {
@@ -19,6 +20,8 @@ class ImportTable
 {
 	private:
 		const retdec::fileformat::ImportTable *table = nullptr;
+		const retdec::utils::OrdinalDatabase *ordinals = nullptr;
+		std::string ordinalsArch;
 	public:
 		/// @name Getters
 		/// @{
@@ -42,6 +45,7 @@ class ImportTable
 		/// @name Setters
 		/// @{
 		void setTable(const retdec::fileformat::ImportTable *importTable);
+		void setOrdinalDatabase(const retdec::utils::OrdinalDatabase *database, const std::string &arch);
 		/// @}
 
 		/// @name Other methods
@@ -4,10 +4,11 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <iostream>
+
 #include "retdec/fileformat/types/certificate_table/certificate_table.h"
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/string.h"
-#include "retdec/utils/io/log.h"
 #include "retdec/utils/time.h"
 #include "retdec/utils/version.h"
 #include "retdec/fileformat/utils/conversions.h"
@@ -19,7 +20,6 @@
 
 using namespace retdec;
 using namespace retdec::utils;
-using namespace retdec::utils::io;
 using namespace retdec::cpdetect;
 using namespace retdec::fileformat;
 
@@ -56,9 +56,10 @@ void serializeString(
  * @param key If set then everything is written into a JSO object with the name.
  * @return @c true if at least one record from getter is presented, @c false otherwise
  */
+template <typename Writer>
 bool presentSimple(
 		const SimpleGetter &getter,
-		JsonPresentation::Writer& writer,
+		Writer& writer,
 		const std::string& key = std::string())
 {
 	bool result = false;
@@ -97,13 +98,15 @@ bool presentSimple(
 /**
  * Constructor
  */
-JsonPresentation::JsonPresentation(FileInformation &fileinfo_, bool verbose_)
+JsonPresentation::JsonPresentation(FileInformation &fileinfo_, bool verbose_, bool singleLine_)
 		: FilePresentation(fileinfo_)
 		, verbose(verbose_)
+		, singleLine(singleLine_)
 {
 
 }
 
+template <typename Writer>
 void JsonPresentation::presentFileinfoVersion(Writer& writer) const
 {
 	writer.String("fileinfoVersion");
@@ -117,6 +120,7 @@ void JsonPresentation::presentFileinfoVersion(Writer& writer) const
 /**
  * Present information about warning and error messages
  */
+template <typename Writer>
 void JsonPresentation::presentErrors(Writer& writer) const
 {
 	std::vector<std::string> messages;
@@ -178,6 +182,7 @@ void JsonPresentation::presentErrors(Writer& writer) const
 /**
 * Present information about Windows PE loader error
 */
+template <typename Writer>
 void JsonPresentation::presentLoaderError(Writer& writer) const
 {
 	auto ldrErrInfo = fileinfo.getLoaderErrorInfo();
@@ -203,6 +208,7 @@ void JsonPresentation::presentLoaderError(Writer& writer) const
 /**
  * Present information about detected compilers and packers
  */
+template <typename Writer>
 void JsonPresentation::presentCompiler(Writer& writer) const
 {
 	if (fileinfo.toolInfo.detectedTools.empty())
@@ -253,6 +259,7 @@ void JsonPresentation::presentCompiler(Writer& writer) const
 /**
  * Present information about detected languages
  */
+template <typename Writer>
 void JsonPresentation::presentLanguages(Writer& writer) const
 {
 	if (fileinfo.toolInfo.detectedLanguages.empty())
@@ -278,6 +285,7 @@ void JsonPresentation::presentLanguages(Writer& writer) const
 /**
  * Present basic information about rich header
  */
+template <typename Writer>
 void JsonPresentation::presentRichHeader(Writer& writer) const
 {
 	const auto offset = fileinfo.getRichHeaderOffsetStr(hexWithPrefix);
@@ -308,6 +316,7 @@ void JsonPresentation::presentRichHeader(Writer& writer) const
 /**
  * Present information about packing
  */
+template <typename Writer>
 void JsonPresentation::presentPackingInfo(Writer& writer) const
 {
 	const auto packed = fileinfo.toolInfo.isPacked();
@@ -317,6 +326,7 @@ void JsonPresentation::presentPackingInfo(Writer& writer) const
 /**
  * Present information about overlay
  */
+template <typename Writer>
 void JsonPresentation::presentOverlay(Writer& writer) const
 {
 	const auto offset = fileinfo.getOverlayOffsetStr(hexWithPrefix);
@@ -336,6 +346,7 @@ void JsonPresentation::presentOverlay(Writer& writer) const
 /**
  * Present detected patterns
  */
+template <typename Writer>
 void JsonPresentation::presentPatterns(Writer& writer) const
 {
 	auto pcg = PatternConfigGetter(fileinfo);
@@ -350,6 +361,7 @@ void JsonPresentation::presentPatterns(Writer& writer) const
 /**
  * Present information about missing dependencies
  */
+template <typename Writer>
 void JsonPresentation::presentMissingDepsInfo(Writer& writer) const
 {
 	if (returnCode == ReturnCode::FILE_NOT_EXIST
@@ -370,6 +382,7 @@ void JsonPresentation::presentMissingDepsInfo(Writer& writer) const
 /**
  * Present information about loader
  */
+template <typename Writer>
 void JsonPresentation::presentLoaderInfo(Writer& writer) const
 {
 	if(returnCode == ReturnCode::FILE_NOT_EXIST
@@ -389,7 +402,8 @@ void JsonPresentation::presentLoaderInfo(Writer& writer) const
 	writer.EndObject();
 }
 
-void WriteCertificateChain(JsonPresentation::Writer& writer, const std::vector<Certificate>& certificates)
+template <typename Writer>
+void WriteCertificateChain(Writer& writer, const std::vector<Certificate>& certificates)
 {
 	writer.StartArray();
 	for (auto&& cert : certificates)
@@ -456,7 +470,8 @@ void WriteCertificateChain(JsonPresentation::Writer& writer, const std::vector<C
 	writer.EndArray();
 }
 
-void WriteSigner(JsonPresentation::Writer& writer, const Signer& signer)
+template <typename Writer>
+void WriteSigner(Writer& writer, const Signer& signer)
 {
 	writer.StartObject();
 	writer.String("warnings");
@@ -485,7 +500,8 @@ void WriteSigner(JsonPresentation::Writer& writer, const Signer& signer)
 	writer.EndObject();
 }
 
-void WriteSignature(JsonPresentation::Writer& writer, const DigitalSignature& signature)
+template <typename Writer>
+void WriteSignature(Writer& writer, const DigitalSignature& signature)
 {
 	writer.StartObject();
 	writer.String("signatureVerified");
@@ -514,6 +530,7 @@ void WriteSignature(JsonPresentation::Writer& writer, const DigitalSignature& si
 /**
  * Present information about certificates into certificate table
  */
+template <typename Writer>
 void JsonPresentation::presentCertificates(Writer& writer) const
 {
 
@@ -539,6 +556,7 @@ void JsonPresentation::presentCertificates(Writer& writer) const
 /**
  * Present information about TLS
  */
+template <typename Writer>
 void JsonPresentation::presentTlsInfo(Writer& writer) const
 {
 	if (!fileinfo.isTlsUsed())
@@ -573,6 +591,7 @@ void JsonPresentation::presentTlsInfo(Writer& writer) const
 /**
  * Present information about .NET
  */
+template <typename Writer>
 void JsonPresentation::presentDotnetInfo(Writer& writer) const
 {
 	if (!fileinfo.isDotnetUsed())
@@ -812,6 +831,7 @@ void JsonPresentation::presentDotnetInfo(Writer& writer) const
 /**
  * Present information about Visual Basic
  */
+template <typename Writer>
 void JsonPresentation::presentVisualBasicInfo(Writer& writer) const
 {
 	if (!fileinfo.isVisualBasicUsed())
@@ -948,6 +968,7 @@ void JsonPresentation::presentVisualBasicInfo(Writer& writer) const
 /**
  * Present version information
  */
+template <typename Writer>
 void JsonPresentation::presentVersionInfo(Writer& writer) const
 {
 	writer.String("versionInfo");
@@ -995,6 +1016,7 @@ void JsonPresentation::presentVersionInfo(Writer& writer) const
 /**
  * Present ELF notes
  */
+template <typename Writer>
 void JsonPresentation::presentElfNotes(Writer& writer) const
 {
 	auto& noteSection = fileinfo.getElfNotes();
@@ -1099,6 +1121,7 @@ void JsonPresentation::presentElfNotes(Writer& writer) const
  * @param flags Flags in binary string representation
  * @param desc Vector of descriptors (descriptor is complete information about flag)
  */
+template <typename Writer>
 void JsonPresentation::presentFlags(
 		Writer& writer,
 		const std::string &title,
@@ -1132,6 +1155,7 @@ void JsonPresentation::presentFlags(
 /**
  * Present information from one structure of iterative subtitle getter
  */
+template <typename Writer>
 void JsonPresentation::presentIterativeSubtitleStructure(
 		Writer& writer,
 		const IterativeSubtitleGetter &getter,
@@ -1226,6 +1250,7 @@ void JsonPresentation::presentIterativeSubtitleStructure(
 /**
  * Present information from iterative subtitle getter
  */
+template <typename Writer>
 void JsonPresentation::presentIterativeSubtitle(
 		Writer& writer,
 		const IterativeSubtitleGetter &getter) const
@@ -1254,7 +1279,8 @@ void JsonPresentation::presentIterativeSubtitle(
 	}
 }
 
-void presentPeTimestamps(JsonPresentation::Writer& writer, FileInformation& fileinfo)
+template <typename Writer>
+void presentPeTimestamps(Writer& writer, FileInformation& fileinfo)
 {
 	PeTimestamps pe_timestamps = fileinfo.pe_timestamps;
 
@@ -1298,10 +1324,12 @@ void presentPeTimestamps(JsonPresentation::Writer& writer, FileInformation& file
 	writer.EndObject();
 }
 
-bool JsonPresentation::present()
+/**
+ * Present all information about file into @a writer
+ */
+template <typename Writer>
+void JsonPresentation::presentAll(Writer& writer) const
 {
-	rapidjson::StringBuffer sb;
-	Writer writer(sb);
 	writer.StartObject();
 
 	if(verbose)
@@ -1374,7 +1402,40 @@ bool JsonPresentation::present()
 	presentIterativeSubtitle(writer, StringsJsonGetter(fileinfo));
 
 	writer.EndObject();
-	Log::info() << sb.GetString() << std::endl;
+}
+
+bool JsonPresentation::present()
+{
+	present(std::cout);
+	std::cout << std::endl;
+
+	return true;
+}
+
+/**
+ * Present information about file into @a out
+ * @param out Stream into which the JSON document is written
+ * @return @c true if presentation went OK, @c false otherwise
+ *
+ * The document is written section by section through a buffer of a fixed
+ * size, so the memory needed does not depend on the size of the output. If the
+ * presentation is single-line, the document contains no line breaks, so it
+ * can be used as one line of NDJSON output. No line break is written after
+ * the document.
+ */
+bool JsonPresentation::present(std::ostream& out)
+{
+	utils::io::JsonOutputStream stream(out);
+	if(singleLine)
+	{
+		SingleLineWriter writer(stream);
+		presentAll(writer);
+	}
+	else
+	{
+		PrettyWriter writer(stream);
+		presentAll(writer);
+	}
 
 	return true;
 }
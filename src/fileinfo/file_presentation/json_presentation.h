@@ -7,10 +7,13 @@
 #ifndef FILEINFO_FILE_PRESENTATION_JSON_PRESENTATION_H
 #define FILEINFO_FILE_PRESENTATION_JSON_PRESENTATION_H
 
+#include <ostream>
+
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/stringbuffer.h>
+#include <rapidjson/writer.h>
 #include <rapidjson/encodings.h>
 
+#include "retdec/utils/io/json_output_stream.h"
 #include "fileinfo/file_presentation/file_presentation.h"
 #include "fileinfo/file_presentation/getters/iterative_getter/iterative_subtitle_getter/iterative_subtitle_getter.h"
 
@@ -23,49 +26,55 @@ namespace fileinfo {
 class JsonPresentation : public FilePresentation
 {
 	public:
-		using Writer = rapidjson::PrettyWriter<
-				rapidjson::StringBuffer,
+		using PrettyWriter = rapidjson::PrettyWriter<
+				utils::io::JsonOutputStream,
+				rapidjson::ASCII<>>;
+		using SingleLineWriter = rapidjson::Writer<
+				utils::io::JsonOutputStream,
 				rapidjson::ASCII<>>;
 
 	private:
-		bool verbose; ///< @c true - print all information about file
+		bool verbose;    ///< @c true - print all information about file
+		bool singleLine; ///< @c true - print whole JSON document on one line
 
 		/// @name Auxiliary presentation methods
 		/// @{
-		void presentFileinfoVersion(Writer& writer) const;
-		void presentErrors(Writer& writer) const;
-		void presentLoaderError(Writer& writer) const;
-		void presentCompiler(Writer& writer) const;
-		void presentLanguages(Writer& writer) const;
-		void presentRichHeader(Writer& writer) const;
-		void presentPackingInfo(Writer& writer) const;
-		void presentOverlay(Writer& writer) const;
-		void presentPatterns(Writer& writer) const;
-		void presentMissingDepsInfo(Writer& writer) const;
-		void presentLoaderInfo(Writer& writer) const;
-		void presentCertificates(Writer& writer) const;
-		void presentTlsInfo(Writer& writer) const;
-		void presentDotnetInfo(Writer& writer) const;
-		void presentVersionInfo(Writer& writer) const;
-		void presentVisualBasicInfo(Writer& writer) const;
-		void presentElfNotes(Writer& writer) const;
-		void presentFlags(
+		template <typename Writer> void presentFileinfoVersion(Writer& writer) const;
+		template <typename Writer> void presentErrors(Writer& writer) const;
+		template <typename Writer> void presentLoaderError(Writer& writer) const;
+		template <typename Writer> void presentCompiler(Writer& writer) const;
+		template <typename Writer> void presentLanguages(Writer& writer) const;
+		template <typename Writer> void presentRichHeader(Writer& writer) const;
+		template <typename Writer> void presentPackingInfo(Writer& writer) const;
+		template <typename Writer> void presentOverlay(Writer& writer) const;
+		template <typename Writer> void presentPatterns(Writer& writer) const;
+		template <typename Writer> void presentMissingDepsInfo(Writer& writer) const;
+		template <typename Writer> void presentLoaderInfo(Writer& writer) const;
+		template <typename Writer> void presentCertificates(Writer& writer) const;
+		template <typename Writer> void presentTlsInfo(Writer& writer) const;
+		template <typename Writer> void presentDotnetInfo(Writer& writer) const;
+		template <typename Writer> void presentVersionInfo(Writer& writer) const;
+		template <typename Writer> void presentVisualBasicInfo(Writer& writer) const;
+		template <typename Writer> void presentElfNotes(Writer& writer) const;
+		template <typename Writer> void presentFlags(
 				Writer& writer,
 				const std::string &title,
 				const std::string &flags,
 				const std::vector<std::string> &desc) const;
-		void presentIterativeSubtitleStructure(
+		template <typename Writer> void presentIterativeSubtitleStructure(
 				Writer& writer,
 				const IterativeSubtitleGetter &getter,
 				std::size_t structIndex) const;
-		void presentIterativeSubtitle(
+		template <typename Writer> void presentIterativeSubtitle(
 				Writer& writer,
 				const IterativeSubtitleGetter &getter) const;
+		template <typename Writer> void presentAll(Writer& writer) const;
 		/// @}
 	public:
-		JsonPresentation(FileInformation &fileinfo_, bool verbose_);
+		JsonPresentation(FileInformation &fileinfo_, bool verbose_, bool singleLine_ = false);
 
 		virtual bool present() override;
+		bool present(std::ostream& out);
 };
 
 } // namespace fileinfo
@@ -4,7 +4,12 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
 #include <regex>
+#include <sstream>
 
 #include <rapidjson/document.h>
 #include <llvm/Support/ErrorHandling.h>
@@ -13,6 +18,7 @@
 #include "retdec/utils/conversion.h"
 #include "retdec/utils/memory.h"
 #include "retdec/utils/io/log.h"
+#include "retdec/utils/ordinal_database.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/version.h"
 #include "retdec/ar-extractor/detection.h"
@@ -21,6 +27,7 @@
 #include "retdec/fileformat/utils/format_detection.h"
 #include "retdec/fileformat/utils/other.h"
 #include "retdec/serdes/std.h"
+#include "fileinfo/batch_processor/batch_processor.h"
 #include "fileinfo/file_detector/detector_factory.h"
 #include "fileinfo/file_detector/macho_detector.h"
 #include "fileinfo/file_presentation/config_presentation.h"
@@ -63,6 +70,10 @@ struct ProgParams
 	std::string configFile;
 	///< name of the file with the DLL list
 	std::string dllListFile;
+	///< name of the ordinal database file
+	std::string ordinalsFile;
+	///< ordinal database opened from @a ordinalsFile
+	std::shared_ptr<OrdinalDatabase> ordinals;
 	///< paths to YARA malware rules
 	std::set<std::string> yaraMalwarePaths;
 	///< paths to YARA crypto rules
@@ -76,6 +87,12 @@ struct ProgParams
 	std::size_t epBytesCount = EP_BYTES_SIZE;
 	/// load flags for `fileformat`
 	LoadFlags loadFlags = LoadFlags::NONE;
+	/// directory or list of files processed in batch mode
+	std::string batchPath;
+	/// number of files processed at once in batch mode (0 means all CPUs)
+	std::size_t jobs = 0;
+	/// time limit of one file in batch mode in seconds (0 means no limit)
+	std::size_t timeout = 0;
 
 	friend std::ostream& operator<<(std::ostream& os, const ProgParams& pp);
 };
@@ -92,10 +109,14 @@ std::ostream& operator<<(std::ostream& os, const ProgParams& pp)
 	os << "generate config    : " << pp.generateConfigFile << "\n";
 	os << "config file        : " << pp.configFile << "\n";
 	os << "dll list file      : " << pp.dllListFile << "\n";
+	os << "ordinals file      : " << pp.ordinalsFile << "\n";
 	os << "maximal memory     : " << pp.maxMemory << "\n";
 	os << "max half memory    : " << pp.maxMemoryHalfRAM << "\n";
 	os << "ep bytes count     : " << pp.epBytesCount << "\n";
 	os << "load flags         : " << pp.loadFlags << "\n";
+	os << "batch              : " << pp.batchPath << "\n";
+	os << "jobs               : " << pp.jobs << "\n";
+	os << "timeout            : " << pp.timeout << "\n";
 
 	os << "yara malware rules : " << "\n";
 	for (auto& r : pp.yaraMalwarePaths)
@@ -115,24 +136,39 @@ std::ostream& operator<<(std::ostream& os, const ProgParams& pp)
  */
 struct ErrorHandlerInfo
 {
-	ProgParams* params;
+	const ProgParams* params;
 	FileInformation* fileinfo;
 };
 
+/// Information about the file analyzed by the current thread
+thread_local ErrorHandlerInfo* errorHandlerInfo = nullptr;
+
 /**
  * LLVM fatal error handler
- * @param user_data Data necessary for error handling
+ * @param user_data Unused (handler information is stored per thread)
  * @param reason Unused
  * @param gen_crash_diag Unused
  */
-void fatalErrorHandler(void *user_data, const std::string& /*reason*/, bool /*gen_crash_diag*/)
+void fatalErrorHandler(void * /*user_data*/, const std::string& /*reason*/, bool /*gen_crash_diag*/)
 {
-	ProgParams* params = static_cast<ErrorHandlerInfo*>(user_data)->params;
-	FileInformation *fileinfo = static_cast<ErrorHandlerInfo*>(user_data)->fileinfo;
+	if(!errorHandlerInfo)
+	{
+		exit(static_cast<int>(ReturnCode::FORMAT_PARSER_PROBLEM));
+	}
+
+	const ProgParams* params = errorHandlerInfo->params;
+	FileInformation *fileinfo = errorHandlerInfo->fileinfo;
 
 	fileinfo->setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
 
-	if(params->plainText)
+	if(!params->batchPath.empty())
+	{
+		// Other files in the batch can still be processed.
+		std::ostringstream output;
+		JsonPresentation(*fileinfo, params->verbose, true).present(output);
+		BatchProcessor::finishCurrentFile(output.str());
+	}
+	else if(params->plainText)
 	{
 		PlainPresentation(*fileinfo, params->verbose, params->explanatory).present();
 	}
@@ -222,7 +258,29 @@ void printHelp()
 				<< "\n"
 				<< "Options for specifying list of available DLLs:\n"
 				<< "    --dlls=filename\n"
-				<< "                          Load the list of present DLLs from the file.\n";
+				<< "                          Load the list of present DLLs from the file.\n"
+				<< "\n"
+				<< "Options for specifying names of imports by ordinals:\n"
+				<< "    --ordinals=file       Get names of functions imported only by ordinal\n"
+				<< "                          numbers from the ordinal database (generated by\n"
+				<< "                          retdec-ordinals).\n"
+				<< "\n"
+				<< "Options for processing many files in one process:\n"
+				<< "    --batch=dirOrList     Process all files in the directory (including its\n"
+				<< "                          subdirectories) or all files listed in the file\n"
+				<< "                          (one path per line) instead of a single file.\n"
+				<< "                          Result of every file is printed in JSON format on\n"
+				<< "                          a single line, in the order in which the files are\n"
+				<< "                          finished. Cannot be used with --config.\n"
+				<< "    --jobs=N              Number of files processed at once in batch mode.\n"
+				<< "                          Every file is processed in its own process\n"
+				<< "                          (on Windows, files are processed one by one).\n"
+				<< "                          (Default: number of CPUs)\n"
+				<< "    --timeout=N           Time limit of one file in batch mode in seconds\n"
+				<< "                          (0 means no limit). When the limit is exceeded,\n"
+				<< "                          the process of the file is killed and an error\n"
+				<< "                          is printed for the file. Not supported on\n"
+				<< "                          Windows. (Default: 0)\n";
 }
 
 std::string getParamOrDie(const std::vector<std::string> &argv, std::size_t &i)
@@ -432,6 +490,29 @@ bool doConfigString(
 		}
 	}
 
+	if (root.HasMember("ordinals"))
+	{
+		if (root["ordinals"].IsString())
+		{
+			if (root["ordinals"].GetStringLength())
+			{
+				auto path = fixRelativePath(
+						root["ordinals"].GetString(),
+						configPath
+				);
+				if (fs::exists(path))
+				{
+					params.ordinalsFile = path;
+				}
+			}
+		}
+		else
+		{
+			Log::error() << Log::Error << "JSON config: \"ordinals\" has bad value!\n";
+			return false;
+		}
+	}
+
 	params.epBytesCount = retdec::serdes::deserializeUint64(root, "epBytes", params.epBytesCount);
 	params.maxMemory = retdec::serdes::deserializeUint64(root, "maxMemory", params.maxMemory);
 
@@ -514,7 +595,7 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 	std::set<std::string> withArgs = {
 			"malware", "m", "crypto", "C", "other", "o", "config",
 			"fileinfo-config", "c", "no-hashes", "max-memory", "ep-bytes",
-			"dlls"
+			"dlls", "ordinals", "batch", "jobs", "timeout"
 	};
 	for (int i = 1; i < argc; ++i)
 	{
@@ -687,6 +768,26 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 
 			params.dllListFile = dllListFile;
 		}
+		else if (c == "--ordinals")
+		{
+			params.ordinalsFile = getParamOrDie(argv, i);
+		}
+		else if (c == "--batch")
+		{
+			params.batchPath = getParamOrDie(argv, i);
+		}
+		else if (c == "--jobs")
+		{
+			if (!strToNum(getParamOrDie(argv, i), params.jobs))
+				return false;
+		}
+		else if (c == "--timeout")
+		{
+			if (!strToNum(getParamOrDie(argv, i), params.timeout))
+				return false;
+			if (params.timeout && !BatchProcessor::isTimeoutSupported())
+				return false;
+		}
 		else if (params.filePath.empty())
 		{
 			params.filePath = argv[i];
@@ -697,6 +798,13 @@ bool doParams(int argc, char **_argv, ProgParams &params)
 		}
 	}
 
+	if(!params.batchPath.empty())
+	{
+		// In batch mode, files are given by the batch and results are
+		// printed only to standard output.
+		return params.filePath.empty() && !params.generateConfigFile;
+	}
+
 	if(params.filePath.empty())
 	{
 		return false;
@@ -723,59 +831,30 @@ void limitMaximalMemoryIfRequested(const ProgParams& params)
 	}
 }
 
-} // anonymous namespace
-
 /**
- * Main function
- * @param argc Number of parameters
- * @param argv Vector of parameters
- * @return Program status
+ * Analyze one file and present information about it
+ * @param params Program parameters
+ * @param filePath Path to the analyzed file
+ * @param config Configuration of the decompilation of the file, or @c nullptr
+ *               if there is no such configuration
+ * @param output If not @c nullptr, information is stored into this parameter
+ *               as a single line of JSON instead of being printed
+ * @return Status of the analysis
  */
-int main(int argc, char* argv[])
+ReturnCode analyzeFile(
+		const ProgParams& params,
+		const std::string& filePath,
+		retdec::config::Config* config,
+		std::string* output = nullptr)
 {
-	ProgParams params;
-	if(!doConfigFile(params))
-	{
-		Log::error() << getErrorMessage(ReturnCode::ARG) << "\n\n";
-		printHelp();
-		return static_cast<int>(ReturnCode::ARG);
-	}
-
-	if(!doParams(argc, argv, params))
-	{
-		Log::error() << getErrorMessage(ReturnCode::ARG) << "\n\n";
-		printHelp();
-		return static_cast<int>(ReturnCode::ARG);
-	}
-
-	limitMaximalMemoryIfRequested(params);
-
-	bool useConfig = true;
-	retdec::config::Config config;
-	if(params.generateConfigFile && !params.configFile.empty())
-	{
-		try
-		{
-			config.readJsonFile(params.configFile);
-		}
-		catch (const retdec::config::FileNotFoundException&)
-		{
-			useConfig = false;
-		}
-		catch (const retdec::config::ParseException&)
-		{
-			useConfig = false;
-		}
-	}
-
 	DetectParams searchPar(params.searchMode, params.internalDatabase, params.externalDatabase, params.epBytesCount);
-	const auto fileFormat = detectFileFormat(params.filePath, useConfig && config.fileFormat.isRaw());
+	const auto fileFormat = detectFileFormat(filePath, config && config->fileFormat.isRaw());
 	FileInformation fileinfo;
-	FileDetector *fileDetector = nullptr;
-	fileinfo.setPathToFile(params.filePath);
+	std::unique_ptr<FileDetector> fileDetector;
+	fileinfo.setPathToFile(filePath);
 	fileinfo.setFileFormatEnum(fileFormat);
 	ErrorHandlerInfo hInfo { &params, &fileinfo };
-	llvm::install_fatal_error_handler(fatalErrorHandler, &hInfo);
+	errorHandlerInfo = &hInfo;
 	switch(fileFormat)
 	{
 		case Format::UNDETECTABLE:
@@ -785,7 +864,7 @@ int main(int argc, char* argv[])
 		}
 		default:
 		{
-			fileDetector = createFileDetector(params.filePath, params.dllListFile, fileFormat, fileinfo, searchPar, params.loadFlags);
+			fileDetector.reset(createFileDetector(filePath, params.dllListFile, fileFormat, fileinfo, searchPar, params.loadFlags));
 			if(fileDetector)
 			{
 				if(!fileDetector->getFileParser()->isInValidState())
@@ -793,7 +872,7 @@ int main(int argc, char* argv[])
 					// Check if Mach-O is archive.
 					if (fileFormat == Format::MACHO)
 					{
-						auto machoDetecor = static_cast<MachODetector*>(fileDetector);
+						auto machoDetecor = static_cast<MachODetector*>(fileDetector.get());
 						if (machoDetecor->isMachoUniversalArchive())
 						{
 							fileinfo.setStatus(ReturnCode::MACHO_AR_DETECTED);
@@ -805,15 +884,16 @@ int main(int argc, char* argv[])
 					break;
 				}
 
-				if(useConfig)
+				if(config)
 				{
-					fileDetector->setConfigFile(config);
+					fileDetector->setConfigFile(*config);
 				}
+				fileDetector->setOrdinalDatabase(params.ordinals.get());
 				fileDetector->getAllInformation();
 			}
 			else
 			{
-				if(isArchive(params.filePath))
+				if(isArchive(filePath))
 				{
 					fileinfo.setStatus(ReturnCode::ARCHIVE_DETECTED);
 				}
@@ -831,7 +911,13 @@ int main(int argc, char* argv[])
 	}
 
 	// print results on standard output
-	if(params.plainText)
+	if(output)
+	{
+		std::ostringstream json;
+		JsonPresentation(fileinfo, params.verbose, true).present(json);
+		*output = json.str();
+	}
+	else if(params.plainText)
 	{
 		PlainPresentation(fileinfo, params.verbose, params.explanatory).present();
 	}
@@ -852,6 +938,109 @@ int main(int argc, char* argv[])
 		}
 	}
 
-	delete fileDetector;
+	errorHandlerInfo = nullptr;
+	return res;
+}
+
+/**
+ * Analyze all files of the batch and print information about them as lines
+ * of JSON
+ * @param params Program parameters
+ * @return Program status
+ */
+int processBatch(const ProgParams& params)
+{
+	std::vector<std::string> files;
+	if(!BatchProcessor::getInputFiles(params.batchPath, files))
+	{
+		Log::error() << Log::Error << "Failed to read the list of files to process: " << params.batchPath << "\n";
+		return static_cast<int>(ReturnCode::FILE_PROBLEM);
+	}
+
+	// Compile YARA rules only once, before the files are analyzed.
+	FileInformation fileinfo;
+	PatternDetector patternDetector(nullptr, fileinfo);
+	patternDetector.addFilePaths("malware", params.yaraMalwarePaths);
+	patternDetector.addFilePaths("crypto", params.yaraCryptoPaths);
+	patternDetector.addFilePaths("other", params.yaraOtherPaths);
+	patternDetector.compileRules();
+
+	BatchProcessor processor(
+			[&params](const std::string& filePath) {
+				// Use the same default configuration as for a single file.
+				retdec::config::Config config;
+				std::string output;
+				analyzeFile(params, filePath, &config, &output);
+				return output;
+			},
+			params.jobs,
+			std::chrono::seconds(params.timeout));
+	processor.process(files, std::cout);
+
+	return static_cast<int>(ReturnCode::OK);
+}
+
+} // anonymous namespace
+
+/**
+ * Main function
+ * @param argc Number of parameters
+ * @param argv Vector of parameters
+ * @return Program status
+ */
+int main(int argc, char* argv[])
+{
+	ProgParams params;
+	if(!doConfigFile(params))
+	{
+		Log::error() << getErrorMessage(ReturnCode::ARG) << "\n\n";
+		printHelp();
+		return static_cast<int>(ReturnCode::ARG);
+	}
+
+	if(!doParams(argc, argv, params))
+	{
+		Log::error() << getErrorMessage(ReturnCode::ARG) << "\n\n";
+		printHelp();
+		return static_cast<int>(ReturnCode::ARG);
+	}
+
+	if(!params.ordinalsFile.empty())
+	{
+		params.ordinals = std::make_shared<OrdinalDatabase>();
+		if(!params.ordinals->open(params.ordinalsFile))
+		{
+			Log::error() << Log::Error << "Failed to open the ordinal database: " << params.ordinalsFile << "\n";
+			return static_cast<int>(ReturnCode::ARG);
+		}
+	}
+
+	limitMaximalMemoryIfRequested(params);
+	llvm::install_fatal_error_handler(fatalErrorHandler, nullptr);
+
+	if(!params.batchPath.empty())
+	{
+		return processBatch(params);
+	}
+
+	bool useConfig = true;
+	retdec::config::Config config;
+	if(params.generateConfigFile && !params.configFile.empty())
+	{
+		try
+		{
+			config.readJsonFile(params.configFile);
+		}
+		catch (const retdec::config::FileNotFoundException&)
+		{
+			useConfig = false;
+		}
+		catch (const retdec::config::ParseException&)
+		{
+			useConfig = false;
+		}
+	}
+
+	auto res = analyzeFile(params, params.filePath, useConfig ? &config : nullptr);
 	return isFatalError(res) ? static_cast<int>(res) : static_cast<int>(ReturnCode::OK);
 }
@@ -370,5 +370,27 @@ void PatternDetector::analyze()
 	fileinfo.sortOtherPatternMatches();
 }
 
+/**
+ * Compile YARA patterns without analyzing any file
+ *
+ * Compiled patterns are shared within the process, so later analyses (also
+ * in child processes forked after this call) do not compile them again.
+ */
+void PatternDetector::compileRules()
+{
+	for(const auto &category : categories)
+	{
+		YaraDetector yara;
+
+		for(const auto &item : category.second)
+		{
+			yara.addRuleFile(item);
+		}
+
+		std::vector<std::uint8_t> noBytes;
+		yara.analyze(noBytes);
+	}
+}
+
 } // namespace fileinfo
 } // namespace retdec
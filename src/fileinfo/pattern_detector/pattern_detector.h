@@ -53,6 +53,7 @@ class PatternDetector
 		/// @{
 		void addFilePaths(const std::string &category, const std::set<std::string> &paths);
 		void analyze();
+		void compileRules();
 		/// @}
 };
 
@@ -671,6 +671,18 @@ bool ValueAnalysis::mayBePointed(ShPtr<Variable> var) const {
 	return aliasAnalysis->mayBePointed(var);
 }
 
+/**
+* @brief Creates a new analysis that uses the same alias analysis as this one.
+*
+* The new analysis caches results if and only if this one does but it starts
+* with an empty cache of its own. Therefore, the two analyses can be used from
+* different threads, provided that the shared alias analysis is not
+* initialized again meanwhile.
+*/
+ShPtr<ValueAnalysis> ValueAnalysis::clone() const {
+	return create(aliasAnalysis, isCachingEnabled());
+}
+
 /**
 * @brief Creates a new analysis.
 *
@@ -48,7 +48,7 @@ void AddressOpExpr::accept(Visitor *v) {
 ShPtr<AddressOpExpr> AddressOpExpr::create(ShPtr<Expression> op) {
 	PRECONDITION_NON_NULL(op);
 
-	ShPtr<AddressOpExpr> expr(new AddressOpExpr(op));
+	ShPtr<AddressOpExpr> expr(makeValuePtr(new AddressOpExpr(op)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
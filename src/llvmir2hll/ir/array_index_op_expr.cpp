@@ -83,7 +83,7 @@ ShPtr<ArrayIndexOpExpr> ArrayIndexOpExpr::create(ShPtr<Expression> base,
 	PRECONDITION_NON_NULL(base);
 	PRECONDITION_NON_NULL(index);
 
-	ShPtr<ArrayIndexOpExpr> expr(new ArrayIndexOpExpr(base, index));
+	ShPtr<ArrayIndexOpExpr> expr(makeValuePtr(new ArrayIndexOpExpr(base, index)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -63,7 +63,7 @@ bool ArrayType::hasEmptyDimensions() const {
 */
 ShPtr<ArrayType> ArrayType::create(ShPtr<Type> elemType, const Dimensions &dims) {
 	// There is no special initialization needed.
-	return ShPtr<ArrayType>(new ArrayType(elemType, dims));
+	return makeValuePtr(new ArrayType(elemType, dims));
 }
 
 void ArrayType::accept(Visitor *v) {
@@ -49,7 +49,7 @@ ShPtr<AssignOpExpr> AssignOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<AssignOpExpr> expr(new AssignOpExpr(op1, op2));
+	ShPtr<AssignOpExpr> expr(makeValuePtr(new AssignOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
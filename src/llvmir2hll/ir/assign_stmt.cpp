@@ -115,7 +115,7 @@ ShPtr<AssignStmt> AssignStmt::create(ShPtr<Expression> lhs, ShPtr<Expression> rh
 	PRECONDITION_NON_NULL(lhs);
 	PRECONDITION_NON_NULL(rhs);
 
-	ShPtr<AssignStmt> stmt(new AssignStmt(lhs, rhs, a));
+	ShPtr<AssignStmt> stmt(makeValuePtr(new AssignStmt(lhs, rhs, a)));
 	stmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
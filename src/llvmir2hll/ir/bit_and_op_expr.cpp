@@ -47,7 +47,7 @@ ShPtr<BitAndOpExpr> BitAndOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<BitAndOpExpr> expr(new BitAndOpExpr(op1, op2));
+	ShPtr<BitAndOpExpr> expr(makeValuePtr(new BitAndOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -52,7 +52,7 @@ ShPtr<BitCastExpr> BitCastExpr::create(ShPtr<Expression> op,
 	PRECONDITION_NON_NULL(op);
 	PRECONDITION_NON_NULL(dstType);
 
-	ShPtr<BitCastExpr> expr(new BitCastExpr(op, dstType));
+	ShPtr<BitCastExpr> expr(makeValuePtr(new BitCastExpr(op, dstType)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -47,7 +47,7 @@ ShPtr<BitOrOpExpr> BitOrOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression>
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<BitOrOpExpr> expr(new BitOrOpExpr(op1, op2));
+	ShPtr<BitOrOpExpr> expr(makeValuePtr(new BitOrOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -47,7 +47,7 @@ ShPtr<BitShlOpExpr> BitShlOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<BitShlOpExpr> expr(new BitShlOpExpr(op1, op2));
+	ShPtr<BitShlOpExpr> expr(makeValuePtr(new BitShlOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -72,7 +72,7 @@ ShPtr<BitShrOpExpr> BitShrOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<BitShrOpExpr> expr(new BitShrOpExpr(op1, op2, variant));
+	ShPtr<BitShrOpExpr> expr(makeValuePtr(new BitShrOpExpr(op1, op2, variant)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
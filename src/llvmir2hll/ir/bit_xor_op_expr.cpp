@@ -47,7 +47,7 @@ ShPtr<BitXorOpExpr> BitXorOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<BitXorOpExpr> expr(new BitXorOpExpr(op1, op2));
+	ShPtr<BitXorOpExpr> expr(makeValuePtr(new BitXorOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -37,7 +37,7 @@ ShPtr<Value> BreakStmt::clone() {
 * @param[in] a Address.
 */
 ShPtr<BreakStmt> BreakStmt::create(Address a) {
-	return ShPtr<BreakStmt>(new BreakStmt(a));
+	return makeValuePtr(new BreakStmt(a));
 }
 
 void BreakStmt::accept(Visitor *v) {
@@ -232,7 +232,7 @@ void CallExpr::replaceArg(ShPtr<Expression> oldArg, ShPtr<Expression> newArg) {
 ShPtr<CallExpr> CallExpr::create(ShPtr<Expression> calledExpr, ExprVector args) {
 	PRECONDITION_NON_NULL(calledExpr);
 
-	ShPtr<CallExpr> expr(new CallExpr(calledExpr, args));
+	ShPtr<CallExpr> expr(makeValuePtr(new CallExpr(calledExpr, args)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
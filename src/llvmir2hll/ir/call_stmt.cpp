@@ -82,7 +82,7 @@ ShPtr<CallStmt> CallStmt::create(ShPtr<CallExpr> call, ShPtr<Statement> succ,
 		Address a) {
 	PRECONDITION_NON_NULL(call);
 
-	ShPtr<CallStmt> callStmt(new CallStmt(call, a));
+	ShPtr<CallStmt> callStmt(makeValuePtr(new CallStmt(call, a)));
 	callStmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
@@ -49,7 +49,7 @@ ShPtr<CommaOpExpr> CommaOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression>
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<CommaOpExpr> expr(new CommaOpExpr(op1, op2));
+	ShPtr<CommaOpExpr> expr(makeValuePtr(new CommaOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -183,7 +183,7 @@ ShPtr<ConstArray> ConstArray::create(ArrayValue value, ShPtr<ArrayType> type) {
 	PRECONDITION(!value.empty(), "missing value for an initialized array");
 	PRECONDITION_NON_NULL(type);
 
-	ShPtr<ConstArray> array(new ConstArray(value, type));
+	ShPtr<ConstArray> array(makeValuePtr(new ConstArray(value, type)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -205,7 +205,7 @@ ShPtr<ConstArray> ConstArray::create(ArrayValue value, ShPtr<ArrayType> type) {
 ShPtr<ConstArray> ConstArray::createUninitialized(ShPtr<ArrayType> type) {
 	PRECONDITION_NON_NULL(type);
 
-	return ShPtr<ConstArray>(new ConstArray({}, type));
+	return makeValuePtr(new ConstArray({}, type));
 }
 
 /**
@@ -78,7 +78,7 @@ bool ConstBool::isFalse() const {
 * value.
 */
 ShPtr<ConstBool> ConstBool::create(Type value) {
-	return ShPtr<ConstBool>(new ConstBool(value));
+	return makeValuePtr(new ConstBool(value));
 }
 
 void ConstBool::accept(Visitor *v) {
@@ -247,7 +247,7 @@ bool ConstFloat::isZero() const {
 * @param[in] value Value of the constant.
 */
 ShPtr<ConstFloat> ConstFloat::create(Type value) {
-	return ShPtr<ConstFloat>(new ConstFloat(value));
+	return makeValuePtr(new ConstFloat(value));
 }
 
 void ConstFloat::accept(Visitor *v) {
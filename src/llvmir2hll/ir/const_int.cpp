@@ -314,7 +314,7 @@ ShPtr<ConstInt> ConstInt::create(std::int64_t value, unsigned bitWidth,
 ShPtr<ConstInt> ConstInt::create(const llvm::APInt &value, bool isSigned) {
 	// Since the second parameter of llvm::APSInt() is "isUnsigned", we have to
 	// negate the value of isSigned.
-	return ShPtr<ConstInt>(new ConstInt(llvm::APSInt(value, !isSigned)));
+	return makeValuePtr(new ConstInt(llvm::APSInt(value, !isSigned)));
 }
 
 /**
@@ -323,7 +323,7 @@ ShPtr<ConstInt> ConstInt::create(const llvm::APInt &value, bool isSigned) {
 * @param[in] value Value of the constant.
 */
 ShPtr<ConstInt> ConstInt::create(const llvm::APSInt &value) {
-	return ShPtr<ConstInt>(new ConstInt(value));
+	return makeValuePtr(new ConstInt(value));
 }
 
 /**
@@ -50,7 +50,7 @@ void ConstNullPointer::replace(ShPtr<Expression> oldExpr, ShPtr<Expression> newE
 * @param[in] type Type of the pointer.
 */
 ShPtr<ConstNullPointer> ConstNullPointer::create(ShPtr<PointerType> type) {
-	return ShPtr<ConstNullPointer>(new ConstNullPointer(type));
+	return makeValuePtr(new ConstNullPointer(type));
 }
 
 void ConstNullPointer::accept(Visitor *v) {
@@ -100,7 +100,7 @@ ShPtr<ConstString> ConstString::create(const UnderlyingStringType &value,
 	PRECONDITION(charSize == 8 || charSize == 16 || charSize == 32,
 		"invalid charSize " << charSize);
 
-	return ShPtr<ConstString>(new ConstString(value, charSize));
+	return makeValuePtr(new ConstString(value, charSize));
 }
 
 /**
@@ -88,7 +88,7 @@ ConstStruct::Type ConstStruct::getValue() const {
 ShPtr<ConstStruct> ConstStruct::create(Type value, ShPtr<StructType> type) {
 	PRECONDITION_NON_NULL(type);
 
-	ShPtr<ConstStruct> constStruct(new ConstStruct(value, type));
+	ShPtr<ConstStruct> constStruct(makeValuePtr(new ConstStruct(value, type)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -67,7 +67,7 @@ ShPtr<ConstSymbol> ConstSymbol::create(const std::string &name,
 		ShPtr<Constant> value) {
 	PRECONDITION_NON_NULL(value);
 
-	ShPtr<ConstSymbol> constSymbol(new ConstSymbol(name, value));
+	ShPtr<ConstSymbol> constSymbol(makeValuePtr(new ConstSymbol(name, value)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -40,7 +40,7 @@ ShPtr<Expression> ContinueStmt::asExpression() const {
 * @param[in] a Address.
 */
 ShPtr<ContinueStmt> ContinueStmt::create(Address a) {
-	return ShPtr<ContinueStmt>(new ContinueStmt(a));
+	return makeValuePtr(new ContinueStmt(a));
 }
 
 void ContinueStmt::accept(Visitor *v) {
@@ -44,7 +44,7 @@ ShPtr<Value> DerefOpExpr::clone() {
 ShPtr<DerefOpExpr> DerefOpExpr::create(ShPtr<Expression> op) {
 	PRECONDITION_NON_NULL(op);
 
-	ShPtr<DerefOpExpr> expr(new DerefOpExpr(op));
+	ShPtr<DerefOpExpr> expr(makeValuePtr(new DerefOpExpr(op)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
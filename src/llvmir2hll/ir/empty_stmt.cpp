@@ -39,7 +39,7 @@ ShPtr<Expression> EmptyStmt::asExpression() const {
 * @param[in] a Address.
 */
 ShPtr<EmptyStmt> EmptyStmt::create(ShPtr<Statement> succ, Address a) {
-	ShPtr<EmptyStmt> stmt(new EmptyStmt(a));
+	ShPtr<EmptyStmt> stmt(makeValuePtr(new EmptyStmt(a)));
 	stmt->setSuccessor(succ);
 	return stmt;
 }
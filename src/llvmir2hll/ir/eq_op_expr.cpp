@@ -53,7 +53,7 @@ ShPtr<EqOpExpr> EqOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op2) {
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<EqOpExpr> expr(new EqOpExpr(op1, op2));
+	ShPtr<EqOpExpr> expr(makeValuePtr(new EqOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
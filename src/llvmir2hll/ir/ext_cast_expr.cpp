@@ -62,7 +62,7 @@ ShPtr<ExtCastExpr> ExtCastExpr::create(ShPtr<Expression> op, ShPtr<Type> dstType
 	PRECONDITION_NON_NULL(op);
 	PRECONDITION_NON_NULL(dstType);
 
-	ShPtr<ExtCastExpr> expr(new ExtCastExpr(op, dstType, variant));
+	ShPtr<ExtCastExpr> expr(makeValuePtr(new ExtCastExpr(op, dstType, variant)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
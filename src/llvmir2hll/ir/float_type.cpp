@@ -55,6 +55,7 @@ bool FloatType::existsFloatTypeWith(unsigned size) const {
 * @return Returns true if exists float type, else false.
 */
 bool FloatType::existsFloatType() const {
+	std::lock_guard<std::mutex> lock(createdTypesMutex);
 	if (createdTypes.empty()) {
 		return false;
 	}
@@ -69,6 +70,10 @@ bool FloatType::existsFloatType() const {
 ShPtr<FloatType> FloatType::create(unsigned size) {
 	PRECONDITION(size > 0, "invalid size " << size);
 
+	// Types may be created from several threads when functions are optimized
+	// in parallel.
+	std::lock_guard<std::mutex> lock(createdTypesMutex);
+
 	// To reduce the amount of created types, we use a set of already created
 	// float types of the given size. If the wanted type has already been
 	// created, reuse it.
@@ -79,7 +84,7 @@ ShPtr<FloatType> FloatType::create(unsigned size) {
 
 	// Create the type and store it for later use. There is no special
 	// initialization.
-	createdTypes[size] = ShPtr<FloatType>(new FloatType(size));
+	createdTypes[size] = makeValuePtr(new FloatType(size));
 	return createdTypes[size];
 }
 
@@ -89,6 +94,7 @@ void FloatType::accept(Visitor *v) {
 
 // Static variables and constants definitions.
 std::map<unsigned, ShPtr<FloatType>> FloatType::createdTypes;
+std::mutex FloatType::createdTypesMutex;
 
 } // namespace llvmir2hll
 } // namespace retdec
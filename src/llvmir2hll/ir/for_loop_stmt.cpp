@@ -219,8 +219,8 @@ ShPtr<ForLoopStmt> ForLoopStmt::create(ShPtr<Variable> indVar,
 	PRECONDITION_NON_NULL(step);
 	PRECONDITION_NON_NULL(body);
 
-	ShPtr<ForLoopStmt> stmt(new ForLoopStmt(indVar, startValue, endCond,
-		step, body, a));
+	ShPtr<ForLoopStmt> stmt(makeValuePtr(new ForLoopStmt(indVar, startValue,
+		endCond, step, body, a)));
 	stmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
@@ -52,7 +52,7 @@ ShPtr<FPToIntCastExpr> FPToIntCastExpr::create(ShPtr<Expression> op,
 	PRECONDITION_NON_NULL(op);
 	PRECONDITION_NON_NULL(dstType);
 
-	ShPtr<FPToIntCastExpr> expr(new FPToIntCastExpr(op, dstType));
+	ShPtr<FPToIntCastExpr> expr(makeValuePtr(new FPToIntCastExpr(op, dstType)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
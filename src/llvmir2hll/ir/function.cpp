@@ -516,8 +516,8 @@ ShPtr<Value> Function::clone() {
 ShPtr<Function> Function::create(ShPtr<Module> module, ShPtr<Type> retType,
 		std::string name, VarVector params, VarSet localVars,
 		ShPtr<Statement> body, bool isVarArg) {
-	ShPtr<Function> func(
-		new Function(module, retType, name, params, localVars, body, isVarArg));
+	ShPtr<Function> func(makeValuePtr(
+		new Function(module, retType, name, params, localVars, body, isVarArg)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
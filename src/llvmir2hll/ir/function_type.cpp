@@ -166,7 +166,7 @@ bool FunctionType::isVarArg() const {
 * @brief Creates a new function type.
 */
 ShPtr<FunctionType> FunctionType::create(ShPtr<Type> retType) {
-	return ShPtr<FunctionType>(new FunctionType(retType));
+	return makeValuePtr(new FunctionType(retType));
 }
 
 void FunctionType::accept(Visitor *v) {
@@ -138,7 +138,7 @@ void GlobalVarDef::removeInitializer() {
 ShPtr<GlobalVarDef> GlobalVarDef::create(ShPtr<Variable> var, ShPtr<Expression> init) {
 	PRECONDITION_NON_NULL(var);
 
-	ShPtr<GlobalVarDef> varDef(new GlobalVarDef(var, init));
+	ShPtr<GlobalVarDef> varDef(makeValuePtr(new GlobalVarDef(var, init)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -77,7 +77,7 @@ void GotoStmt::setTarget(ShPtr<Statement> newTarget) {
 ShPtr<GotoStmt> GotoStmt::create(ShPtr<Statement> target, Address a) {
 	PRECONDITION_NON_NULL(target);
 
-	ShPtr<GotoStmt> gotoStmt(new GotoStmt(target, a));
+	ShPtr<GotoStmt> gotoStmt(makeValuePtr(new GotoStmt(target, a)));
 
 	// Initialization (recall that shared_from_this(), which is called in
 	// setTarget(), cannot be called in a constructor).
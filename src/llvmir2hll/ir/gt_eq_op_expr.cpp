@@ -63,7 +63,7 @@ ShPtr<GtEqOpExpr> GtEqOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<GtEqOpExpr> expr(new GtEqOpExpr(op1, op2, variant));
+	ShPtr<GtEqOpExpr> expr(makeValuePtr(new GtEqOpExpr(op1, op2, variant)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -64,7 +64,7 @@ ShPtr<GtOpExpr> GtOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op2,
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<GtOpExpr> expr(new GtOpExpr(op1, op2, variant));
+	ShPtr<GtOpExpr> expr(makeValuePtr(new GtOpExpr(op1, op2, variant)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
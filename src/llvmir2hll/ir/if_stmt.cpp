@@ -266,7 +266,7 @@ ShPtr<IfStmt> IfStmt::create(ShPtr<Expression> cond, ShPtr<Statement> body,
 	PRECONDITION_NON_NULL(cond);
 	PRECONDITION_NON_NULL(body);
 
-	ShPtr<IfStmt> stmt(new IfStmt(cond, body, a));
+	ShPtr<IfStmt> stmt(makeValuePtr(new IfStmt(cond, body, a)));
 	stmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
@@ -61,7 +61,8 @@ ShPtr<IntToFPCastExpr> IntToFPCastExpr::create(ShPtr<Expression> op,
 	PRECONDITION_NON_NULL(op);
 	PRECONDITION_NON_NULL(dstType);
 
-	ShPtr<IntToFPCastExpr> expr(new IntToFPCastExpr(op, dstType, variant));
+	ShPtr<IntToFPCastExpr> expr(makeValuePtr(
+		new IntToFPCastExpr(op, dstType, variant)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
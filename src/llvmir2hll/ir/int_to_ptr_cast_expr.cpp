@@ -52,7 +52,7 @@ ShPtr<IntToPtrCastExpr> IntToPtrCastExpr::create(ShPtr<Expression> op,
 	PRECONDITION_NON_NULL(op);
 	PRECONDITION_NON_NULL(dstType);
 
-	ShPtr<IntToPtrCastExpr> expr(new IntToPtrCastExpr(op, dstType));
+	ShPtr<IntToPtrCastExpr> expr(makeValuePtr(new IntToPtrCastExpr(op, dstType)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
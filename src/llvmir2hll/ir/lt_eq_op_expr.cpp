@@ -63,7 +63,7 @@ ShPtr<LtEqOpExpr> LtEqOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<LtEqOpExpr> expr(new LtEqOpExpr(op1, op2, variant));
+	ShPtr<LtEqOpExpr> expr(makeValuePtr(new LtEqOpExpr(op1, op2, variant)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -63,7 +63,7 @@ ShPtr<LtOpExpr> LtOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op2,
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<LtOpExpr> expr(new LtOpExpr(op1, op2, variant));
+	ShPtr<LtOpExpr> expr(makeValuePtr(new LtOpExpr(op1, op2, variant)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
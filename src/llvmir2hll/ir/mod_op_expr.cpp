@@ -57,7 +57,7 @@ ShPtr<ModOpExpr> ModOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op2,
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<ModOpExpr> expr(new ModOpExpr(op1, op2, variant));
+	ShPtr<ModOpExpr> expr(makeValuePtr(new ModOpExpr(op1, op2, variant)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -47,7 +47,7 @@ ShPtr<MulOpExpr> MulOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op2)
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<MulOpExpr> expr(new MulOpExpr(op1, op2));
+	ShPtr<MulOpExpr> expr(makeValuePtr(new MulOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -43,7 +43,7 @@ ShPtr<Value> NegOpExpr::clone() {
 ShPtr<NegOpExpr> NegOpExpr::create(ShPtr<Expression> op) {
 	PRECONDITION_NON_NULL(op);
 
-	ShPtr<NegOpExpr> expr(new NegOpExpr(op));
+	ShPtr<NegOpExpr> expr(makeValuePtr(new NegOpExpr(op)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
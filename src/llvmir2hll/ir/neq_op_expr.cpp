@@ -53,7 +53,7 @@ ShPtr<NeqOpExpr> NeqOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op2)
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<NeqOpExpr> expr(new NeqOpExpr(op1, op2));
+	ShPtr<NeqOpExpr> expr(makeValuePtr(new NeqOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -49,7 +49,7 @@ ShPtr<Type> NotOpExpr::getType() const {
 ShPtr<NotOpExpr> NotOpExpr::create(ShPtr<Expression> op) {
 	PRECONDITION_NON_NULL(op);
 
-	ShPtr<NotOpExpr> expr(new NotOpExpr(op));
+	ShPtr<NotOpExpr> expr(makeValuePtr(new NotOpExpr(op)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
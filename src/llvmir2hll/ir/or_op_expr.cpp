@@ -53,7 +53,7 @@ ShPtr<OrOpExpr> OrOpExpr::create(ShPtr<Expression> op1, ShPtr<Expression> op2) {
 	PRECONDITION_NON_NULL(op1);
 	PRECONDITION_NON_NULL(op2);
 
-	ShPtr<OrOpExpr> expr(new OrOpExpr(op1, op2));
+	ShPtr<OrOpExpr> expr(makeValuePtr(new OrOpExpr(op1, op2)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
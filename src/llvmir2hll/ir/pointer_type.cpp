@@ -62,7 +62,7 @@ ShPtr<PointerType> PointerType::create(ShPtr<Type> containedType) {
 	PRECONDITION_NON_NULL(containedType);
 
 	// There is no special initialization.
-	return ShPtr<PointerType>(new PointerType(containedType));
+	return makeValuePtr(new PointerType(containedType));
 }
 
 void PointerType::accept(Visitor *v) {
@@ -52,7 +52,7 @@ ShPtr<PtrToIntCastExpr> PtrToIntCastExpr::create(ShPtr<Expression> op,
 	PRECONDITION_NON_NULL(op);
 	PRECONDITION_NON_NULL(dstType);
 
-	ShPtr<PtrToIntCastExpr> expr(new PtrToIntCastExpr(op, dstType));
+	ShPtr<PtrToIntCastExpr> expr(makeValuePtr(new PtrToIntCastExpr(op, dstType)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -99,7 +99,7 @@ bool ReturnStmt::hasRetVal() const {
 */
 ShPtr<ReturnStmt> ReturnStmt::create(ShPtr<Expression> retVal,
 	ShPtr<Statement> succ, Address a) {
-	ShPtr<ReturnStmt> stmt(new ReturnStmt(retVal, a));
+	ShPtr<ReturnStmt> stmt(makeValuePtr(new ReturnStmt(retVal, a)));
 	stmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
@@ -643,8 +643,8 @@ ShPtr<Statement> Statement::getParent() const {
 	// If there are no non-goto predecessors, we're done, i.e. we can use the
 	// set of observers.
 	if (preds.empty() || containsJustGotosToCurrentStatement(preds)) {
-		for (auto i = observer_begin(), e = observer_end(); i != e ; ++i) {
-			if (ShPtr<Statement> observerStmt = cast<Statement>(i->lock())) {
+		for (const auto &observer : getObservers()) {
+			if (ShPtr<Statement> observerStmt = cast<Statement>(observer.lock())) {
 				// Skip goto observers.
 				if (isa<GotoStmt>(observerStmt)) {
 					continue;
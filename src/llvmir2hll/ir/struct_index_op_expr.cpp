@@ -74,7 +74,8 @@ ShPtr<StructIndexOpExpr> StructIndexOpExpr::create(ShPtr<Expression> base,
 	PRECONDITION_NON_NULL(base);
 	PRECONDITION_NON_NULL(fieldNumber);
 
-	ShPtr<StructIndexOpExpr> expr(new StructIndexOpExpr(base, fieldNumber));
+	ShPtr<StructIndexOpExpr> expr(makeValuePtr(
+		new StructIndexOpExpr(base, fieldNumber)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -81,7 +81,7 @@ const ShPtr<Type> StructType::getTypeOfElement(ShPtr<ConstInt> index) const {
 */
 ShPtr<StructType> StructType::create(ElementTypes elementTypes,
 		const std::string &name) {
-	return ShPtr<StructType>(new StructType(elementTypes, name));
+	return makeValuePtr(new StructType(elementTypes, name));
 }
 
 void StructType::accept(Visitor *v) {
@@ -303,7 +303,7 @@ ShPtr<SwitchStmt> SwitchStmt::create(ShPtr<Expression> controlExpr,
 		ShPtr<Statement> succ, Address a) {
 	PRECONDITION_NON_NULL(controlExpr);
 
-	ShPtr<SwitchStmt> stmt(new SwitchStmt(controlExpr, a));
+	ShPtr<SwitchStmt> stmt(makeValuePtr(new SwitchStmt(controlExpr, a)));
 	stmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
@@ -151,7 +151,8 @@ ShPtr<TernaryOpExpr> TernaryOpExpr::create(ShPtr<Expression> cond,
 	PRECONDITION_NON_NULL(trueValue);
 	PRECONDITION_NON_NULL(falseValue);
 
-	ShPtr<TernaryOpExpr> expr(new TernaryOpExpr(cond, trueValue, falseValue));
+	ShPtr<TernaryOpExpr> expr(makeValuePtr(
+		new TernaryOpExpr(cond, trueValue, falseValue)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -51,7 +51,7 @@ ShPtr<TruncCastExpr> TruncCastExpr::create(ShPtr<Expression> op, ShPtr<Type> dst
 	PRECONDITION_NON_NULL(op);
 	PRECONDITION_NON_NULL(dstType);
 
-	ShPtr<TruncCastExpr> expr(new TruncCastExpr(op, dstType));
+	ShPtr<TruncCastExpr> expr(makeValuePtr(new TruncCastExpr(op, dstType)));
 
 	// Initialization (recall that shared_from_this() cannot be called in a
 	// constructor).
@@ -196,7 +196,8 @@ ShPtr<UForLoopStmt> UForLoopStmt::create(
 		Address a) {
 	PRECONDITION_NON_NULL(body);
 
-	ShPtr<UForLoopStmt> stmt(new UForLoopStmt(init, cond, step, body, a));
+	ShPtr<UForLoopStmt> stmt(makeValuePtr(
+		new UForLoopStmt(init, cond, step, body, a)));
 	stmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
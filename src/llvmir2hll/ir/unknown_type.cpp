@@ -44,7 +44,7 @@ std::size_t UnknownType::getSize() const {
 * instance.
 */
 ShPtr<UnknownType> UnknownType::create() {
-	static ShPtr<UnknownType> createdType(new UnknownType());
+	static ShPtr<UnknownType> createdType(makeValuePtr(new UnknownType()));
 	return createdType;
 }
 
@@ -40,7 +40,7 @@ void UnreachableStmt::accept(Visitor *v) {
 }
 
 ShPtr<UnreachableStmt> UnreachableStmt::create(Address a) {
-	return ShPtr<UnreachableStmt>(new UnreachableStmt(a));
+	return makeValuePtr(new UnreachableStmt(a));
 }
 
 } // namespace llvmir2hll
@@ -32,6 +32,24 @@ ShPtr<Value> Value::getSelf() {
 	return shared_from_this();
 }
 
+/**
+* @brief Allocates memory for a value of the given @a size.
+*
+* Values are small, numerous, and created and destroyed repeatedly by
+* optimizations, so they are allocated from utils::SmallBlockPool instead of
+* the general-purpose heap.
+*/
+void *Value::operator new(std::size_t size) {
+	return retdec::utils::SmallBlockPool::allocate(size);
+}
+
+/**
+* @brief Frees memory of a value of the given @a size.
+*/
+void Value::operator delete(void *ptr, std::size_t size) noexcept {
+	retdec::utils::SmallBlockPool::deallocate(ptr, size);
+}
+
 /**
 * @brief Returns a textual representation of the value.
 *
@@ -133,7 +133,7 @@ ShPtr<VarDefStmt> VarDefStmt::create(ShPtr<Variable> var,
 		ShPtr<Expression> init, ShPtr<Statement> succ, Address a) {
 	PRECONDITION_NON_NULL(var);
 
-	ShPtr<VarDefStmt> stmt(new VarDefStmt(var, init, a));
+	ShPtr<VarDefStmt> stmt(makeValuePtr(new VarDefStmt(var, init, a)));
 	stmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
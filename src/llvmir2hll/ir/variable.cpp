@@ -181,7 +181,7 @@ ShPtr<Variable> Variable::create(const std::string &name, ShPtr<Type> type,
 	PRECONDITION_NON_NULL(type);
 
 	// Currently, there is no special initialization.
-	return ShPtr<Variable>(new Variable(name, type, a));
+	return makeValuePtr(new Variable(name, type, a));
 }
 
 void Variable::accept(Visitor *v) {
@@ -40,7 +40,7 @@ std::size_t VoidType::getSize() const {
 * instance.
 */
 ShPtr<VoidType> VoidType::create() {
-	static ShPtr<VoidType> createdType(new VoidType());
+	static ShPtr<VoidType> createdType(makeValuePtr(new VoidType()));
 	return createdType;
 }
 
@@ -114,7 +114,7 @@ ShPtr<WhileLoopStmt> WhileLoopStmt::create(ShPtr<Expression> cond, ShPtr<Stateme
 	PRECONDITION_NON_NULL(cond);
 	PRECONDITION_NON_NULL(body);
 
-	ShPtr<WhileLoopStmt> stmt(new WhileLoopStmt(cond, body, a));
+	ShPtr<WhileLoopStmt> stmt(makeValuePtr(new WhileLoopStmt(cond, body, a)));
 	stmt->setSuccessor(succ);
 
 	// Initialization (recall that shared_from_this() cannot be called in a
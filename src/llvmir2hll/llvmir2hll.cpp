@@ -140,6 +140,19 @@ void LlvmIr2Hll::setOutputString(std::string* outString)
 	}
 }
 
+/**
+* @brief Makes the backend optimizations, variable renaming, and emission of
+*        the target code measured by @a profiler.
+*
+* Parts of the backend run over functions in parallel are recorded in category
+* OptimizerManager::ParallelCategory, the serial ones in
+* OptimizerManager::SerialCategory.
+*/
+void LlvmIr2Hll::setPassProfiler(retdec::utils::PassProfiler* profiler)
+{
+	passProfiler = profiler;
+}
+
 void LlvmIr2Hll::getAnalysisUsage(llvm::AnalysisUsage &au) const
 {
 	au.addRequired<llvm::LoopInfoWrapperPass>();
@@ -603,9 +616,11 @@ void LlvmIr2Hll::runOptimizations()
 					llvmir2hll::ValueAnalysis::create(aliasAnalysis, true),
 					cio,
 					arithmExprEvaluator,
-					Debug
+					Debug,
+					globalConfig->parameters.getBackendJobs()
 			)
 	);
+	optManager->setPassProfiler(passProfiler);
 	optManager->optimize(resModule);
 }
 
@@ -615,7 +630,18 @@ void LlvmIr2Hll::runOptimizations()
 */
 void LlvmIr2Hll::renameVariables()
 {
+	if (passProfiler)
+	{
+		passProfiler->start(
+			"VarRenamer",
+			llvmir2hll::OptimizerManager::SerialCategory
+		);
+	}
 	varRenamer->renameVars(resModule);
+	if (passProfiler)
+	{
+		passProfiler->stop();
+	}
 }
 
 /**
@@ -677,7 +703,18 @@ void LlvmIr2Hll::emitTargetHLLCode()
 	hllWriter->setOptionUseCompoundOperators(
 		!globalConfig->parameters.isBackendNoCompoundOperators()
 	);
+	if (passProfiler)
+	{
+		passProfiler->start(
+			"HLLWriter",
+			llvmir2hll::OptimizerManager::SerialCategory
+		);
+	}
 	hllWriter->emitTargetCode(resModule);
+	if (passProfiler)
+	{
+		passProfiler->stop();
+	}
 }
 
 /**
@@ -25,15 +25,51 @@ FuncOptimizer::FuncOptimizer(ShPtr<Module> module):
 		PRECONDITION_NON_NULL(module);
 	}
 
+/**
+* @brief Performs the part of the optimization that is not local to a
+*        function.
+*
+* It is called once before functions are optimized, either by doOptimization()
+* or before functions are optimized independently by optimizeFunction(). Its
+* typical use is the initialization of analyses of the whole module.
+*
+* By default, this function does nothing.
+*/
+void FuncOptimizer::doModuleOptimization() {}
+
+/**
+* @brief Performs the optimization only on the given function.
+*
+* @param[in,out] func Function to be optimized.
+*
+* This function is an alternative to optimize() that allows optimizing
+* functions of a module independently of each other, each one by its own
+* optimizer. doModuleOptimization() has to be called before that by a single
+* optimizer.
+*
+* @par Preconditions
+*  - @a func is non-null
+*/
+void FuncOptimizer::optimizeFunction(ShPtr<Function> func) {
+	PRECONDITION_NON_NULL(func);
+
+	doInitialization();
+	runOnFunction(func);
+	doFinalization();
+}
+
 /**
 * @brief Performs the optimization on all functions in the module.
 *
-* This function calls runOnFunction() for each function in the module.
+* This function calls doModuleOptimization() and then runOnFunction() for each
+* function in the module.
 *
 * Only redefine if you want to prescribe the order in which functions are
 * optimized; otherwise, just override runOnFunction().
 */
 void FuncOptimizer::doOptimization() {
+	doModuleOptimization();
+
 	// For each function in the module...
 	for (auto i = module->func_begin(), e = module->func_end(); i != e; ++i) {
 		runOnFunction(*i);
@@ -8,8 +8,12 @@
 #include <thread>
 
 #include "retdec/llvmir2hll/analysis/value_analysis.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluator.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluator_factory.h"
 #include "retdec/llvmir2hll/graphs/cg/cg_builder.h"
 #include "retdec/llvmir2hll/hll/hll_writer.h"
+#include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/module.h"
 #include "retdec/llvmir2hll/obtainer/call_info_obtainer.h"
 #include "retdec/llvmir2hll/optimizer/optimizer_manager.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/bit_op_to_log_op_optimizer.h"
@@ -45,6 +49,7 @@
 #include "retdec/llvmir2hll/optimizer/optimizers/while_true_to_ufor_loop_optimizer.h"
 #include "retdec/llvmir2hll/optimizer/optimizers/while_true_to_while_cond_optimizer.h"
 #include "retdec/llvmir2hll/support/debug.h"
+#include "retdec/llvmir2hll/support/statements_counter.h"
 #include "retdec/utils/container.h"
 #include "retdec/utils/string.h"
 #include "retdec/utils/system.h"
@@ -83,8 +88,50 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 	return result;
 }
 
+/**
+* @brief Returns an analysis of values for a single thread of
+*        OptimizerManager::runPerFunc().
+*
+* The returned analysis shares the alias analysis with @a va but has its own
+* cache.
+*/
+ShPtr<ValueAnalysis> getCopyForThread(ShPtr<ValueAnalysis> va) {
+	return va->clone();
+}
+
+/**
+* @brief Returns an evaluator for a single thread of
+*        OptimizerManager::runPerFunc().
+*
+* Evaluators keep the state of the current evaluation, so every thread needs
+* its own instance of the same kind as @a arithmExprEvaluator.
+*/
+ShPtr<ArithmExprEvaluator> getCopyForThread(
+		ShPtr<ArithmExprEvaluator> arithmExprEvaluator) {
+	return ArithmExprEvaluatorFactory::getInstance().createObject(
+		arithmExprEvaluator->getId());
+}
+
+/**
+* @brief Invalidates @a va after functions have been optimized by its copies.
+*
+* The copies do not update the cache of @a va, so it may be out of date.
+*/
+void invalidateAfterThreads(ShPtr<ValueAnalysis> va) {
+	va->invalidateState();
+}
+
+/**
+* @brief Does nothing because evaluators have no state kept between
+*        evaluations.
+*/
+void invalidateAfterThreads(ShPtr<ArithmExprEvaluator>) {}
+
 } // anonymous namespace
 
+const std::string OptimizerManager::SerialCategory = "backend";
+const std::string OptimizerManager::ParallelCategory = "backend-parallel";
+
 /**
 * @brief Constructs a new optimizer manager.
 *
@@ -97,6 +144,8 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 * @param[in] cio Call info obtainer.
 * @param[in] arithmExprEvaluator Used evaluator of arithmetical expressions.
 * @param[in] enableDebug Enables emission of debug messages.
+* @param[in] jobs Number of threads used to optimize functions in parallel. If
+*                 it is @c 1, all optimizations are run serially.
 *
 * To perform the actual optimizations, call optimize(). To get a list of
 * available optimizations and their names, see our wiki.
@@ -110,25 +159,60 @@ StringSet trimOptimizerSuffix(const StringSet &opts) {
 * @a hllWriter, @a va, and @a cio are needed in some optimizations, so they
 * have to be provided.
 *
+* When @a jobs is greater than one, optimizations that are local to a function
+* (see runPerFunc()) are run over the functions in parallel. The result is the
+* same as when they are run serially. The remaining optimizations are run
+* serially. The copy propagations ask @a cio about calls, and its results for
+* a function depend on the bodies of the called functions, which would be
+* modified concurrently. Others work on the whole module (e.g. they remove
+* global variables or functions). Variable renaming and the emission of the
+* code are not done here and stay serial as well because names have to be
+* unique in the whole module and the code is emitted into a single stream.
+*
+* The share of the backend that stays serial is measured by the profiler set
+* by setPassProfiler(): optimizations that are run over the functions in
+* parallel when @a jobs is greater than one are recorded in ParallelCategory
+* (whatever @a jobs is), the other ones in SerialCategory (LlvmIr2Hll
+* records variable renaming and the emission of the code there as well). The
+* @c BackendSerialShare benchmark in @c retdec-benchmarks reports the share
+* for a synthetic module.
+*
 * @par Preconditions
 *  - @a hllWriter, @a va, @a cio, and @a arithmExprEvaluator are non-null
 */
 OptimizerManager::OptimizerManager(const StringSet &enabledOpts,
 	const StringSet &disabledOpts, ShPtr<HLLWriter> hllWriter,
 	ShPtr<ValueAnalysis> va, ShPtr<CallInfoObtainer> cio,
-	ShPtr<ArithmExprEvaluator> arithmExprEvaluator, bool enableDebug):
+	ShPtr<ArithmExprEvaluator> arithmExprEvaluator, bool enableDebug,
+	std::size_t jobs):
 		enabledOpts(trimOptimizerSuffix(enabledOpts)),
 		disabledOpts(trimOptimizerSuffix(disabledOpts)),
 		hllWriter(hllWriter), va(va), cio(cio),
 		arithmExprEvaluator(arithmExprEvaluator),
 		enableDebug(enableDebug),
-		recoverFromOutOfMemory(true), backendRunOpts() {
+		recoverFromOutOfMemory(true), backendRunOpts(),
+		threadPool(jobs > 1 ? std::make_unique<utils::ThreadPool>(jobs) : nullptr) {
 			PRECONDITION_NON_NULL(hllWriter);
 			PRECONDITION_NON_NULL(va);
 			PRECONDITION_NON_NULL(cio);
 			PRECONDITION_NON_NULL(arithmExprEvaluator);
 		}
 
+/**
+* @brief Makes the manager measure every run optimization by @a profiler.
+*
+* Optimizations that may be run over functions in parallel (see runPerFunc())
+* are recorded in ParallelCategory, the other ones in SerialCategory. As the
+* backend IR
+* has no basic blocks, the number of statements is recorded as the number of
+* instructions and the number of blocks is always zero.
+*
+* If @a profiler is the null pointer, optimizations are not measured.
+*/
+void OptimizerManager::setPassProfiler(retdec::utils::PassProfiler *profiler) {
+	this->profiler = profiler;
+}
+
 /**
 * @brief Runs the optimizations over @a m.
 */
@@ -146,11 +230,11 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	if (!enableDebug) {
 		// Since we will not emit debug comments, empty statements are useless,
 		// so we can remove them.
-		run<EmptyStmtOptimizer>(m);
+		runPerFunc<EmptyStmtOptimizer>(m);
 	}
 
-	run<GotoStmtOptimizer>(m);
-	run<RemoveUselessCastsOptimizer>(m);
+	runPerFunc<GotoStmtOptimizer>(m);
+	runPerFunc<RemoveUselessCastsOptimizer>(m);
 
 	// Data-flow optimizations.
 	// The following optimizations should be run before CopyPropagation to
@@ -161,22 +245,22 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	run<CopyPropagationOptimizer>(m, va, cio);
 
 	// SimplifyArithmExprOptimizer should be run before loop optimizations.
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runPerFunc<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
 
 	// Structure optimizations.
 	// IfStructureOptimizer should be run before loop optimizations because
 	// it may make induction variables easier to find.
-	run<IfStructureOptimizer>(m);
+	runPerFunc<IfStructureOptimizer>(m);
 	// LoopLastContinueOptimizer should be run after IfStructureOptimizer
 	// because IfBeforeLoopOptimizer may introduce continue statements to the
 	// end of loops.
-	run<LoopLastContinueOptimizer>(m);
+	runPerFunc<LoopLastContinueOptimizer>(m);
 	// PreWhileTrueLoopConvOptimizer should be run before other `while True`
 	// loop optimizers.
-	run<PreWhileTrueLoopConvOptimizer>(m, va);
+	runPerFunc<PreWhileTrueLoopConvOptimizer>(m, va);
 	// WhileTrueToForLoopOptimizer should be run before
 	// WhileTrueToWhileCondOptimizer.
-	run<WhileTrueToForLoopOptimizer>(m, va, arithmExprEvaluator);
+	runPerFunc<WhileTrueToForLoopOptimizer>(m, va, arithmExprEvaluator);
 	// TODO The WhileTrueToUForLoopOptimizer does nothing at the moment, so it
 	//      makes no sense to run it.
 	#if 0
@@ -188,20 +272,20 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 		run<WhileTrueToUForLoopOptimizer>(m, va);
 	}
 	#endif
-	run<WhileTrueToWhileCondOptimizer>(m);
-	run<IfBeforeLoopOptimizer>(m, va);
+	runPerFunc<WhileTrueToWhileCondOptimizer>(m);
+	runPerFunc<IfBeforeLoopOptimizer>(m, va);
 
 	// The second part of removal of non-compound statements.
 	run<LLVMIntrinsicsOptimizer>(m);
-	run<VoidReturnOptimizer>(m);
-	run<BreakContinueReturnOptimizer>(m);
+	runPerFunc<VoidReturnOptimizer>(m);
+	runPerFunc<BreakContinueReturnOptimizer>(m);
 
 	// Expression optimizations.
 	run<BitShiftOptimizer>(m);
-	run<DerefAddressOptimizer>(m);
+	runPerFunc<DerefAddressOptimizer>(m);
 	run<EmptyArrayToStringOptimizer>(m);
 	run<BitOpToLogOpOptimizer>(m, va);
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runPerFunc<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
 
 	// Data-flow optimizations.
 	// Run the CopyPropagationOptimizer once more to produce more readable
@@ -217,7 +301,7 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	// This is best to be run after DeadLocalAssignOptimizer and
 	// CopyPropagationOptimizer because it can get rid of statements like `v =
 	// v`, where v is a variable.
-	run<SelfAssignOptimizer>(m);
+	runPerFunc<SelfAssignOptimizer>(m);
 
 	// VarDefForLoopOptimizer and VarDefStmtOptimizer are utilized also if the
 	// output is Python because in this way, we may emit addresses of
@@ -225,15 +309,15 @@ void OptimizerManager::optimize(ShPtr<Module> m) {
 	// Indeed, recall that in Python, we do not emit definitions without an
 	// initializer, so if we didn't move the definitions to the usages, there
 	// wouldn't be initializers.
-	run<VarDefForLoopOptimizer>(m);
+	runPerFunc<VarDefForLoopOptimizer>(m);
 	run<VarDefStmtOptimizer>(m, va);
 
-	run<EmptyStmtOptimizer>(m);
-	run<GotoStmtOptimizer>(m);
+	runPerFunc<EmptyStmtOptimizer>(m);
+	runPerFunc<GotoStmtOptimizer>(m);
 
 	// SimplifyArithmExprOptimizer should be run at the end to produce the most
 	// readable output.
-	run<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
+	runPerFunc<SimplifyArithmExprOptimizer>(m, arithmExprEvaluator);
 
 	// DeadCodeOptimizer should be run at the end because it is better when
 	// SimplifyArithmExprOptimizer optimizes expressions in conditions and then
@@ -271,14 +355,36 @@ bool OptimizerManager::optShouldBeRun(const std::string &optId) const {
 /**
 * @brief Runs the given optimizer provided that it should be run.
 */
-void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimizer) {
-	const std::string OPT_ID = optimizer->getId();
+void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Module> m,
+		ShPtr<Optimizer> optimizer) {
+	runProvidedItShouldBeRun(optimizer->getId(), m, SerialCategory,
+		[&optimizer]() {
+			optimizer->optimize();
+		});
+}
+
+/**
+* @brief Runs the optimization with @a optId by calling @a optimize, provided
+*        that it should be run.
+*
+* @a m is the module optimized by @a optimize. It is used only to measure its
+* size when a profiler is set. @a category is the profiler category of the
+* optimization (SerialCategory or ParallelCategory).
+*/
+void OptimizerManager::runProvidedItShouldBeRun(const std::string &optId,
+		ShPtr<Module> m, const std::string &category,
+		const std::function<void ()> &optimize) {
+	const std::string OPT_ID = optId;
 	if (!optShouldBeRun(OPT_ID)) {
 		return;
 	}
 
 	printOptimization(OPT_ID);
 
+	if (profiler) {
+		profiler->start(OPT_ID + OPT_SUFFIX, category, getIrSize(m));
+	}
+
 	if (recoverFromOutOfMemory) {
 		// Some optimizations, most notable CopyPropagation, may run out of
 		// memory on huge inputs. We try to recover from such situations by
@@ -287,19 +393,37 @@ void OptimizerManager::runOptimizerProvidedItShouldBeRun(ShPtr<Optimizer> optimi
 		// memory requirements of the optimizations, or to generate smaller
 		// code in the first place.
 		try {
-			optimizer->optimize();
+			optimize();
 		} catch (const std::bad_alloc &) {
 			Log::error() << Log::Warning << "out of memory; trying to recover" << std::endl;
 			std::this_thread::sleep_for(std::chrono::seconds(1));
 		}
 	} else {
 		// Just run the optimizer and let std::bad_alloc propagate.
-		optimizer->optimize();
+		optimize();
+	}
+
+	if (profiler) {
+		profiler->stop(getIrSize(m));
 	}
 
 	backendRunOpts.insert(OPT_ID);
 }
 
+/**
+* @brief Returns the size of @a m for the profiler.
+*/
+retdec::utils::PassProfiler::IrSize OptimizerManager::getIrSize(
+		ShPtr<Module> m) {
+	retdec::utils::PassProfiler::IrSize size;
+	for (auto i = m->func_definition_begin(), e = m->func_definition_end();
+			i != e; ++i) {
+		++size.functions;
+		size.instructions += StatementsCounter::count((*i)->getBody());
+	}
+	return size;
+}
+
 /**
 * @brief Prints debug information about the currently run optimization with @a
 *        optId.
@@ -353,7 +477,52 @@ template<typename Optimization, typename... Args>
 void OptimizerManager::run(ShPtr<Module> m, Args &&... args) {
 	auto optimizer = std::make_shared<Optimization>(m,
 		std::forward<Args>(args)...);
-	runOptimizerProvidedItShouldBeRun(optimizer);
+	runOptimizerProvidedItShouldBeRun(m, optimizer);
+}
+
+/**
+* @brief Runs the given function optimization (specified in the template
+*        parameter) over every function in @a m, possibly in parallel.
+*
+* @tparam Optimization Optimization to be performed. It has to be a subclass
+*                      of FuncOptimizer.
+*
+* @param[in] m Module to be optimized.
+* @param[in] args Arguments to be passed to the optimization.
+*
+* Only optimizations that are local to a function may be run in this way: they
+* may modify only the optimized function and their result for a function may
+* not depend on other functions. The part of the optimization that is not
+* local (see FuncOptimizer::doModuleOptimization()) is done first, serially.
+* Then, every function is optimized by a separate instance of the optimization
+* with its own copies of @a args (see getCopyForThread()), so the instances
+* share no state.
+*
+* When there is no thread pool, the optimization is run as by run(). It is
+* recorded in ParallelCategory in both cases, so the profiler shows which share
+* of the optimizations may be run in parallel also when it is run by one job.
+*/
+template<typename Optimization, typename... Args>
+void OptimizerManager::runPerFunc(ShPtr<Module> m, const Args &... args) {
+	auto optimizer = std::make_shared<Optimization>(m, args...);
+	if (!threadPool) {
+		runProvidedItShouldBeRun(optimizer->getId(), m, ParallelCategory,
+			[&optimizer]() {
+				optimizer->optimize();
+			});
+		return;
+	}
+
+	runProvidedItShouldBeRun(optimizer->getId(), m, ParallelCategory, [&]() {
+		optimizer->doModuleOptimization();
+		FuncVector funcs(m->func_begin(), m->func_end());
+		threadPool->parallelFor(funcs.size(), [&](std::size_t i) {
+			auto funcOptimizer = std::make_shared<Optimization>(m,
+				getCopyForThread(args)...);
+			funcOptimizer->optimizeFunction(funcs[i]);
+		});
+		(invalidateAfterThreads(args), ...);
+	});
 }
 
 } // namespace llvmir2hll
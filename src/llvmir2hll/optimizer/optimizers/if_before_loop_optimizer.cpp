@@ -36,12 +36,13 @@ IfBeforeLoopOptimizer::IfBeforeLoopOptimizer(ShPtr<Module> module,
 		PRECONDITION_NON_NULL(va);
 	}
 
-void IfBeforeLoopOptimizer::doOptimization() {
+void IfBeforeLoopOptimizer::doInitialization() {
 	if (!va->isInValidState()) {
 		va->clearCache();
 	}
-	FuncOptimizer::doOptimization();
+}
 
+void IfBeforeLoopOptimizer::doFinalization() {
 	// Currently, we do not update the used analysis of values (va) during this
 	// optimization, so here, at the end of the optimization, we have to put it
 	// into an invalid state.
@@ -41,16 +41,20 @@ PreWhileTrueLoopConvOptimizer::PreWhileTrueLoopConvOptimizer(ShPtr<Module> modul
 		PRECONDITION_NON_NULL(va);
 	}
 
-void PreWhileTrueLoopConvOptimizer::doOptimization() {
+void PreWhileTrueLoopConvOptimizer::doInitialization() {
 	if (!va->isInValidState()) {
 		va->clearCache();
 	}
-	va->initAliasAnalysis(module);
 	// It is more faster without pre-computation, so do not pass the module to
 	// the following create() call.
 	vuv = VarUsesVisitor::create(va, true);
-	FuncOptimizer::doOptimization();
+}
+
+void PreWhileTrueLoopConvOptimizer::doModuleOptimization() {
+	va->initAliasAnalysis(module);
+}
 
+void PreWhileTrueLoopConvOptimizer::doFinalization() {
 	// Currently, we do not update the used analysis of values (va) during this
 	// optimization, so here, at the end of the optimization, we have to put it
 	// into an invalid state.
@@ -47,14 +47,14 @@ namespace llvmir2hll {
 */
 SimplifyArithmExprOptimizer::SimplifyArithmExprOptimizer(ShPtr<Module> module,
 		ShPtr<ArithmExprEvaluator> arithmExprEvaluator):
-			Optimizer(module) {
+			FuncOptimizer(module) {
 	PRECONDITION_NON_NULL(module);
 	PRECONDITION_NON_NULL(arithmExprEvaluator);
 
 	createSubOptimizers(arithmExprEvaluator);
 }
 
-void SimplifyArithmExprOptimizer::doOptimization() {
+void SimplifyArithmExprOptimizer::doModuleOptimization() {
 	// Visit the initializer of all global variables.
 	for (auto i = module->global_var_begin(), e = module->global_var_end();
 			i != e; ++i) {
@@ -66,17 +66,18 @@ void SimplifyArithmExprOptimizer::doOptimization() {
 			}
 		} while (codeChanged);
 	}
+}
 
-	// Visit all functions.
-	for (auto i = module->func_definition_begin(),
-			e = module->func_definition_end(); i != e; ++i) {
-		// Keep optimizing until there are no changes.
-		do {
-			codeChanged = false;
-			restart();
-			(*i)->accept(this);
-		} while (codeChanged);
+void SimplifyArithmExprOptimizer::runOnFunction(ShPtr<Function> func) {
+	if (func->isDeclaration()) {
+		return;
 	}
+
+	// Keep optimizing until there are no changes.
+	do {
+		codeChanged = false;
+		FuncOptimizer::runOnFunction(func);
+	} while (codeChanged);
 }
 
 void SimplifyArithmExprOptimizer::visit(ShPtr<AddOpExpr> expr) {
@@ -50,12 +50,13 @@ WhileTrueToForLoopOptimizer::WhileTrueToForLoopOptimizer(ShPtr<Module> module,
 		PRECONDITION_NON_NULL(arithmExprEvaluator);
 	}
 
-void WhileTrueToForLoopOptimizer::doOptimization() {
+void WhileTrueToForLoopOptimizer::doInitialization() {
 	if (!va->isInValidState()) {
 		va->clearCache();
 	}
-	FuncOptimizer::doOptimization();
+}
 
+void WhileTrueToForLoopOptimizer::doFinalization() {
 	// Currently, we do not update the used analysis of values (va) during this
 	// optimization, so here, at the end of the optimization, we have to put it
 	// into an invalid state.
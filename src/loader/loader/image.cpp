@@ -4,6 +4,7 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
 #include <climits>
 #include <cstring>
 
@@ -438,10 +439,12 @@ const retdec::fileformat::LoaderErrorInfo & Image::getLoaderErrorInfo() const
 Segment* Image::insertSegment(std::unique_ptr<Segment> segment)
 {
 	_segments.push_back(std::move(segment));
+	_invalidateSegmentIndex();
 
 	// We have used move constructor, segment is no longer valid pointer
 	// Now give segment name
 	Segment* retSegment = _segments.back().get();
+	retSegment->_image = this;
 	nameSegment(retSegment);
 	return retSegment;
 }
@@ -453,6 +456,7 @@ void Image::removeSegment(Segment* segment)
 		if (itr->get() == segment)
 		{
 			_segments.erase(itr);
+			_invalidateSegmentIndex();
 			return;
 		}
 	}
@@ -472,6 +476,7 @@ void Image::sortSegments()
 			{
 				return seg1->getAddress() < seg2->getAddress();
 			});
+	_invalidateSegmentIndex();
 }
 
 const Segment* Image::_getSegment(std::size_t index) const
@@ -506,13 +511,56 @@ const Segment* Image::_getSegmentWithIndex(std::size_t index) const
 
 const Segment* Image::_getSegmentFromAddress(std::uint64_t address) const
 {
-	for (const auto& segment : getSegments())
+	const auto lock = _lockSegmentIndex();
+
+	// The first segment in the order of _segments wins if they overlap.
+	std::size_t found = _segments.size();
+	_segmentIndex.forEachContaining(address, [&](std::size_t pos)
 	{
-		if (segment->containsAddress(address))
-			return segment.get();
+		if (pos < found && _segments[pos]->containsAddress(address))
+			found = pos;
+		return true;
+	});
+
+	return found < _segments.size() ? _segments[found].get() : nullptr;
+}
+
+std::shared_lock<std::shared_mutex> Image::_lockSegmentIndex() const
+{
+	const auto isUpToDate = [this]()
+	{
+		return _segmentIndexValid;
+	};
+
+	std::shared_lock<std::shared_mutex> lock(_segmentIndexMutex);
+	if (isUpToDate())
+		return lock;
+	lock.unlock();
+
+	{
+		std::unique_lock<std::shared_mutex> writeLock(_segmentIndexMutex);
+		if (!isUpToDate())
+		{
+			_segmentIndex.clear();
+			for (std::size_t i = 0; i < _segments.size(); ++i)
+			{
+				// Empty segments still contain their start address.
+				const auto& segment = _segments[i];
+				_segmentIndex.add(segment->getAddress(), std::max<std::uint64_t>(segment->getSize(), 1), i);
+			}
+			_segmentIndex.build();
+			_segmentIndexValid = true;
+		}
 	}
 
-	return nullptr;
+	lock.lock();
+	return lock;
+}
+
+void Image::_invalidateSegmentIndex()
+{
+	std::unique_lock<std::shared_mutex> lock(_segmentIndexMutex);
+	_segmentIndexValid = false;
 }
 
 } // namespace loader
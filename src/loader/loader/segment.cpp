@@ -8,6 +8,7 @@
 #include <cstring>
 
 #include "retdec/utils/conversion.h"
+#include "retdec/loader/loader/image.h"
 #include "retdec/loader/loader/segment.h"
 
 namespace retdec {
@@ -258,6 +259,7 @@ bool Segment::setBytes(const std::vector<unsigned char>& value, std::uint64_t ad
 void Segment::resize(std::uint64_t newSize)
 {
 	_size = newSize;
+	_layoutChanged();
 
 	if (_dataSource != nullptr)
 		_dataSource->resize(newSize);
@@ -287,6 +289,7 @@ void Segment::shrink(std::uint64_t newAddress, std::uint64_t newSize)
 
 	_address = newAddress;
 	_size = newSize;
+	_layoutChanged();
 
 	if (_dataSource != nullptr)
 		_dataSource->shrink(shrinkOffset, newSize);
@@ -310,5 +313,14 @@ void Segment::addNonDecodableRange(retdec::common::Range<std::uint64_t> range)
 	_nonDecodableRanges.insert(std::move(range));
 }
 
+/**
+ * Notifies the image which contains the segment that its address or size has changed.
+ */
+void Segment::_layoutChanged()
+{
+	if (_image != nullptr)
+		_image->_invalidateSegmentIndex();
+}
+
 } // namespace loader
 } // namespace retdec
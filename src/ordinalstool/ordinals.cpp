@@ -0,0 +1,159 @@
+/**
+ * @file src/ordinalstool/ordinals.cpp
+ * @brief Generator of the ordinal database from .ord files.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/io/log.h"
+#include "retdec/utils/ordinal_database.h"
+#include "retdec/utils/version.h"
+
+using namespace retdec::utils::io;
+using retdec::utils::OrdinalDatabase;
+
+/**
+ * Print usage.
+ */
+void printUsage()
+{
+	Log::info() << "\nGenerator of the ordinal database from .ord files.\n"
+		<< "Usage: retdec-ordinals ORDINALS_DIR OUTPUT_FILE\n\n"
+		<< "ORDINALS_DIR contains a subdirectory for each architecture (e.g. x86)\n"
+		<< "with LIBRARY.ord files. Each line of these files is an ordinal number\n"
+		<< "followed by the name of the function.\n\n";
+}
+
+/**
+ * Print error message and return non-zero value.
+ *
+ * @param errorMessage message to print
+ * @return non-zero value
+ */
+int printError(
+	const std::string &errorMessage)
+{
+	Log::error() << Log::Error << errorMessage << "\n";
+	return 1;
+}
+
+/**
+ * Read entries from all .ord files in @a dir.
+ *
+ * @param dir directory with architecture subdirectories
+ * @param entries read entries are appended here
+ * @return @c true if all the files were read, @c false otherwise
+ */
+bool readOrdFiles(
+	const fs::path &dir,
+	std::vector<OrdinalDatabase::Entry> &entries)
+{
+	std::error_code ec;
+	std::vector<fs::path> files;
+	for (fs::directory_iterator archIt(dir, ec), end; !ec && archIt != end; archIt.increment(ec)) {
+		if (!archIt->is_directory(ec)) {
+			continue;
+		}
+		for (fs::directory_iterator it(archIt->path(), ec); !ec && it != end; it.increment(ec)) {
+			if (it->path().extension() == ".ord") {
+				files.push_back(it->path());
+			}
+		}
+	}
+	if (ec) {
+		return false;
+	}
+
+	// Sort the files, so that the database does not depend on the order
+	// of files in the directory.
+	std::sort(files.begin(), files.end());
+	for (const auto &path : files) {
+		std::ifstream file(path);
+		if (!file) {
+			return false;
+		}
+
+		const auto arch = path.parent_path().filename().string();
+		const auto library = path.stem().string();
+		for (std::string line; std::getline(file, line);) {
+			std::istringstream ordDecl(line);
+			long long ord = -1;
+			std::string funcName;
+			ordDecl >> ord >> funcName;
+			if (ord >= 0 && ord <= 0xffffffff) {
+				entries.push_back({arch, library, static_cast<std::uint32_t>(ord), funcName});
+			}
+		}
+	}
+	return true;
+}
+
+/**
+ * Do actions according to command line arguments.
+ *
+ * @param args command line arguments
+ */
+int doActions(
+	const std::vector<std::string> &args)
+{
+	std::vector<std::string> paths;
+	for (const auto &arg : args) {
+		if (arg == "-h" || arg == "--help") {
+			printUsage();
+			return 0;
+		}
+		else if (arg == "--version") {
+			Log::info() << retdec::utils::version::getVersionStringLong()
+					<< "\n";
+			return 0;
+		}
+		else {
+			paths.push_back(arg);
+		}
+	}
+
+	if (paths.size() != 2) {
+		printUsage();
+		return 1;
+	}
+
+	std::vector<OrdinalDatabase::Entry> entries;
+	if (!readOrdFiles(paths[0], entries)) {
+		return printError("could not read .ord files from '" + paths[0] + "'");
+	}
+
+	// Write into a temporary file first, so that readers never see
+	// a partially written output.
+	const std::string tmpPath = paths[1] + ".tmp";
+	{
+		std::ofstream output(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!output) {
+			return printError("could not open output file '" + tmpPath + "'");
+		}
+
+		if (!OrdinalDatabase::write(output, entries)) {
+			output.close();
+			std::remove(tmpPath.c_str());
+			return printError("could not write output file '" + tmpPath + "'");
+		}
+	}
+
+	std::remove(paths[1].c_str());
+	if (std::rename(tmpPath.c_str(), paths[1].c_str()) != 0) {
+		std::remove(tmpPath.c_str());
+		return printError("could not write output file '" + paths[1] + "'");
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	return doActions(std::vector<std::string>(argv + 1, argv + argc));
+}
@@ -20,7 +20,9 @@ namespace pdbparser {
 // =================================================================
 
 /**
- * Loads PDB file into memory and separates all streams.
+ * Maps PDB file into memory and separates all streams.
+ * Streams are only located here, non-linear streams are copied into linear
+ * memory when they are requested by get_stream().
  * Must be called before using of any method.
  * Can be called only once.
  * @param filename Name of PDB file to load.
@@ -31,23 +33,20 @@ PDBFileState PDBFile::load_pdb_file(const char *filename)
 	if (pdb_loaded)
 		return PDB_STATE_ALREADY_LOADED;
 
-	// Load PDB file into memory
+	// Map PDB file into memory
 	pdb_filename = filename;
-	FILE *fp = fopen(filename,"rb");
-	if (fp == nullptr)
+	pdb_file = std::make_unique<retdec::utils::MemoryMappedFile>(filename);
+	if (!pdb_file->isOpen())
 	{
 		return PDB_STATE_ERR_FILE_OPEN;
 	}
-	fseek(fp, 0, SEEK_END);  // Determine file size
-	pdb_file_size = ftell(fp);
-	fseek(fp, 0, SEEK_SET);
-	pdb_file_data = new char[pdb_file_size]; // Allocate memory
-	size_t result = fread(pdb_file_data,1,pdb_file_size,fp); // Read the file
-	fclose(fp);
-	if (result != pdb_file_size)
+	if (pdb_file->getSize() < sizeof(PDB_HEADER) || pdb_file->getSize() > 0xFFFFFFFF)
 	{
-		return PDB_STATE_ERR_FILE_OPEN;
+		return PDB_STATE_INVALID_FILE;
 	}
+	pdb_file_size = pdb_file->getSize();
+	// The mapping is read-only, streams are only read by the parsers.
+	pdb_file_data = const_cast<char *>(reinterpret_cast<const char *>(pdb_file->getData()));
 
 	// Get the version of PDB file and parse it
 	pdb_header = reinterpret_cast<PDB_HEADER *>(pdb_file_data);
@@ -66,7 +65,7 @@ PDBFileState PDBFile::load_pdb_file(const char *filename)
 		// Get pointer to PDB info header
 		if (streams.size() > PDB_STREAM_PDB)
 		{
-			pdb_info_v700 = reinterpret_cast<PDBInfo70 *>(streams[PDB_STREAM_PDB].data);
+			pdb_info_v700 = reinterpret_cast<PDBInfo70 *>(get_stream(PDB_STREAM_PDB)->data);
 		}
 		else
 		{
@@ -96,7 +95,7 @@ void PDBFile::initialize(uint64_t image_base)
 	}
 
 	// Initialize types
-	pdb_types = new PDBTypes(&streams[PDB_STREAM_TPI]);
+	pdb_types = new PDBTypes(get_stream(PDB_STREAM_TPI));
 	pdb_types->parse_types();
 
 	// Check if DBI stream is present
@@ -106,7 +105,7 @@ void PDBFile::initialize(uint64_t image_base)
 	{
 		// Get DBI stream
 		unsigned int pdb_dbi_size = streams[PDB_STREAM_DBI].size;
-		char * pdb_dbi_data = streams[PDB_STREAM_DBI].data;
+		char * pdb_dbi_data = get_stream(PDB_STREAM_DBI)->data;
 
 		// Get pointer to DBI header
 		dbi_header_v700 = reinterpret_cast<NewDBIHdr *>(pdb_dbi_data);
@@ -129,7 +128,8 @@ void PDBFile::initialize(uint64_t image_base)
 		int pdb_gsi_num = dbi_header_v700->snGSSyms;
 		int pdb_psi_num = dbi_header_v700->snPSSyms;
 		int pdb_sym_num = dbi_header_v700->snSymRecs;
-		pdb_symbols = new PDBSymbols(&streams[pdb_gsi_num],&streams[pdb_psi_num],&streams[pdb_sym_num],modules,sections,pdb_types);
+		// GSI and PSI streams are not used by the parser, so they are not requested.
+		pdb_symbols = new PDBSymbols(&streams[pdb_gsi_num],&streams[pdb_psi_num],get_stream(pdb_sym_num),modules,sections,pdb_types);
 		pdb_symbols->parse_symbols();
 	}
 	pdb_initialized = true;
@@ -154,7 +154,7 @@ bool PDBFile::save_streams_to_files(void)
 		if (fs == nullptr)
 			return false;
 		if (!streams[i].unused)
-			fwrite(streams[i].data,1,streams[i].size,fs);
+			fwrite(get_stream(i)->data,1,streams[i].size,fs);
 		fclose(fs);
 	}
 	return true;
@@ -240,7 +240,7 @@ void PDBFile::dump_FPO(void)
 		return;
 	}
 
-	PDBStream *pdb_fpo_stream = &streams[pdb_fpo_num];
+	PDBStream *pdb_fpo_stream = get_stream(pdb_fpo_num);
 	int fpoSize = pdb_fpo_stream->size;
 	PDB_FPO_DATA *fpo = reinterpret_cast<PDB_FPO_DATA *>(pdb_fpo_stream->data);
 
@@ -282,7 +282,7 @@ void PDBFile::dump_PE_sections(void)
 		return;
 	}
 
-	PDBStream *pdb_sect_stream = &streams[pdb_sec_num];
+	PDBStream *pdb_sect_stream = get_stream(pdb_sec_num);
 	PDB_PVOID pSect = pdb_sect_stream->data;
 	unsigned long sectSize = pdb_sect_stream->size;
 
@@ -300,13 +300,33 @@ void PDBFile::dump_PE_sections(void)
 	puts("");
 }
 
+/**
+ * Gets stream with the given number.
+ * Non-linear stream is copied into linear memory when it is requested for
+ * the first time, linear stream points directly into the mapped file.
+ * Can be called after load_pdb_file() was executed.
+ * @param num Number of stream
+ * @return Stream or nullptr if there is no such stream
+ */
+PDBStream * PDBFile::get_stream(unsigned int num)
+{
+	if (num >= num_streams)
+		return nullptr;
+
+	PDBStream &stream = streams[num];
+	if (!stream.unused && stream.data == nullptr)
+	{
+		int pages_per_stream = (stream.size + page_size - 1) / page_size;
+		stream.data = extract_stream(stream.pages, pages_per_stream);
+	}
+	return &stream;
+}
+
 /**
  * Destructor
  */
 PDBFile::~PDBFile()
 {
-	if (pdb_file_data)
-		delete [] pdb_file_data;
 	// Delete all non-linear (copied) streams
 	for (unsigned int i = 0; i < num_streams;i++)
 		if (!streams[i].unused && !streams[i].linear)
@@ -323,6 +343,8 @@ PDBFile::~PDBFile()
 
 /**
  * Determines whether stream is stored linear in PDB file or not
+ * Stream whose pages reach past the end of the file is not linear, so that
+ * its missing pages are zeroed by extract_stream().
  * @param pages Index of pages used by stream
  * @param num_pages Number of pages used by stream
  * @return Stream is linear
@@ -333,7 +355,7 @@ bool PDBFile::stream_is_linear(PDB_DWORD *pages, int num_pages)
 	for (int i = 1;i < num_pages;i++)
 		if (pages[i] != ++cur_page)
 			return false;
-	return true;
+	return cur_page < pdb_file_size / page_size;
 }
 
 /**
@@ -344,11 +366,14 @@ bool PDBFile::stream_is_linear(PDB_DWORD *pages, int num_pages)
  */
 char *PDBFile::extract_stream(PDB_DWORD *pages, int num_pages)
 {
-	// Copy data from each page
+	// Copy data from each page, pages outside of the file are zeroed
 	char *stream_data = new char[num_pages * page_size];
 	for (int i = 0;i < num_pages;i++)
 	{
-		memcpy(stream_data + page_size * i, pdb_file_data + pages[i] * page_size, page_size);
+		if (pages[i] < pdb_file_size / page_size)
+			memcpy(stream_data + page_size * i, pdb_file_data + pages[i] * page_size, page_size);
+		else
+			memset(stream_data + page_size * i, 0, page_size);
 	}
 	return stream_data;
 }
@@ -381,6 +406,8 @@ PDBFileState PDBFile::load_pdb_v700(void)
 		return PDB_STATE_INVALID_FILE;
 
 	// Get root directory
+	if (pdb_header->V700.dRootIndexesPage >= pdb_header->V700.dNumPages)
+		return PDB_STATE_INVALID_FILE;
 	int pages_per_root = (pdb_header->V700.dRootSize + page_size - 1) / page_size;
 	PDB_DWORD *root_dir_indexes = reinterpret_cast<PDB_DWORD *>(pdb_file_data + (pdb_header->V700.dRootIndexesPage) * page_size);
 	if (stream_is_linear(root_dir_indexes, pages_per_root))
@@ -396,7 +423,7 @@ PDBFileState PDBFile::load_pdb_v700(void)
 	streams.resize(num_streams);
 	int cur_pagedir_index = num_streams + 0;  // Skip dwords with stream sizes
 
-	// Extract each stream
+	// Locate each stream
 	for (unsigned int i = 0; i < num_streams;i++)
 	{
 		streams[i].size = pdb_root_dir->V700.adStreamSizes[i];
@@ -406,22 +433,25 @@ PDBFileState PDBFile::load_pdb_v700(void)
 			streams[i].unused = true;
 			streams[i].linear = false;
 			streams[i].data = nullptr;
+			streams[i].pages = nullptr;
 		}
 		// Stream is not empty
 		else
 		{
 			streams[i].unused = false;
+			streams[i].pages = &pdb_root_dir->V700.adStreamSizes[cur_pagedir_index];
 			int pages_per_stream = (streams[i].size + page_size - 1) / page_size;
 			// Stream is linear in pdb file, we just get a pointer to it
-			if (stream_is_linear(&pdb_root_dir->V700.adStreamSizes[cur_pagedir_index], pages_per_stream))
+			if (stream_is_linear(streams[i].pages, pages_per_stream))
 			{
-				streams[i].data = pdb_file_data + pdb_root_dir->V700.adStreamSizes[cur_pagedir_index] * page_size;
+				streams[i].data = pdb_file_data + streams[i].pages[0] * page_size;
 				streams[i].linear = true;
 			}
-			// Stream is not linear in pdb file, we must copy it to linear memory
+			// Stream is not linear in pdb file, it is copied to linear memory
+			// in get_stream() when requested
 			else
 			{
-				streams[i].data = extract_stream(&pdb_root_dir->V700.adStreamSizes[cur_pagedir_index], pages_per_stream);
+				streams[i].data = nullptr;
 				streams[i].linear = false;
 			}
 			cur_pagedir_index += pages_per_stream;  // Increase index to next stream
@@ -437,7 +467,7 @@ PDBFileState PDBFile::load_pdb_v700(void)
 void PDBFile::parse_modules(void)
 {
 	// Get DBI stream size and data
-	PDBStream * pdb_dbi_stream = &streams[PDB_STREAM_DBI];
+	PDBStream * pdb_dbi_stream = get_stream(PDB_STREAM_DBI);
 	unsigned int pdb_dbi_size = pdb_dbi_stream->size;
 	char * pdb_dbi_data = pdb_dbi_stream->data;
 
@@ -473,7 +503,7 @@ void PDBFile::parse_modules(void)
 		}
 
 		// Add module into vector
-		PDBStream *s = (entry->sn == 0xffff)?nullptr:&streams[entry->sn]; // Get module stream
+		PDBStream *s = (entry->sn == 0xffff)?nullptr:get_stream(entry->sn); // Get module stream
 		PDBModule new_module =
 		{
 			reinterpret_cast<char *>(entry->rgch),  // name
@@ -497,7 +527,7 @@ void PDBFile::parse_sections(uint64_t image_base)
 		return;
 
 	// Get stream with section info
-	PDBStream * pdb_sect_stream = &streams[pdb_sec_num];
+	PDBStream * pdb_sect_stream = get_stream(pdb_sec_num);
 	unsigned int pdb_sect_size = pdb_sect_stream->size;
 	char * pdb_sect_data = pdb_sect_stream->data;
 
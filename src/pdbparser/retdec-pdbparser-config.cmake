@@ -1,4 +1,9 @@
 
 if(NOT TARGET retdec::pdbparser)
+    find_package(retdec @PROJECT_VERSION@ REQUIRED
+        COMPONENTS
+            utils
+    )
+
     include(${CMAKE_CURRENT_LIST_DIR}/retdec-pdbparser-targets.cmake)
 endif()
@@ -220,16 +220,26 @@ std::uint32_t PeLib::ImageLoader::stringLength(
 					const std::uint8_t * dataBegin;
 					const std::uint8_t * dataPtr;
 					std::uint32_t rvaEndPage = (pageIndex + 1) * PELIB_PAGE_SIZE;
+					std::uint32_t offsetInPage = rva & (PELIB_PAGE_SIZE - 1);
 
 					// If zero page, means this is a zeroed page. This is the end of the string.
-					if(page.buffer.empty())
+					if(page.getData() == nullptr)
 						break;
-					dataBegin = dataPtr = page.buffer.data() + (rva & (PELIB_PAGE_SIZE - 1));
+					dataBegin = dataPtr = page.getData() + offsetInPage;
 
 					// Perhaps the last page loaded?
 					if(rvaEndPage > rvaEnd)
 						rvaEndPage = rvaEnd;
 
+					// The page data may end before the page does. The rest of the page is zeroed,
+					// so the string ends at the end of the data at the latest
+					std::uint32_t dataSize = (offsetInPage < page.getDataSize()) ? (page.getDataSize() - offsetInPage) : 0;
+					if(dataSize < (rvaEndPage - rva))
+					{
+						dataPtr = (const std::uint8_t *)memchr(dataPtr, 0, dataSize);
+						return (dataPtr != nullptr) ? (rva + (dataPtr - dataBegin) - rvaBegin) : (rva + dataSize - rvaBegin);
+					}
+
 					// Try to find the zero byte on the page
 					dataPtr = (const std::uint8_t *)memchr(dataPtr, 0, (rvaEndPage - rva));
 					if(dataPtr != nullptr)
@@ -345,7 +355,7 @@ std::uint32_t PeLib::ImageLoader::readStringRc(
 }
 
 std::uint32_t PeLib::ImageLoader::readStringRaw(
-	ByteBuffer & fileData,
+	ByteView fileData,
 	std::string & str,
 	std::size_t offset,
 	std::size_t maxLength,
@@ -356,8 +366,8 @@ std::uint32_t PeLib::ImageLoader::readStringRaw(
 
 	if(offset < fileData.size())
 	{
-		std::uint8_t * stringBegin = fileData.data() + offset;
-		std::uint8_t * stringEnd;
+		const std::uint8_t * stringBegin = fileData.data() + offset;
+		const std::uint8_t * stringEnd;
 
 		// Make sure we won't read past the end of the buffer
 		if((offset + maxLength) > fileData.size())
@@ -366,7 +376,7 @@ std::uint32_t PeLib::ImageLoader::readStringRaw(
 		// Get the length of the string. Do not go beyond the maximum length
 		// Note that there is no guaratee that the string is zero terminated, so can't use strlen
 		// retdec-regression-tests\tools\fileinfo\bugs\issue-451-strange-section-names\4383fe67fec6ea6e44d2c7d075b9693610817edc68e8b2a76b2246b53b9186a1-unpacked
-		stringEnd = (std::uint8_t *)memchr(stringBegin, 0, maxLength);
+		stringEnd = (const std::uint8_t *)memchr(stringBegin, 0, maxLength);
 		if(stringEnd == nullptr)
 		{
 			// No zero terminator means that the string is limited by max length
@@ -405,15 +415,14 @@ std::uint32_t PeLib::ImageLoader::dumpImage(const char * fileName)
 
 	if(fs.is_open())
 	{
-		// Allocate one page filled with zeros
-		std::uint8_t zeroPage[PELIB_PAGE_SIZE] = {0};
-		char * dataToWrite;
+		// Allocate one page for the page data
+		std::uint8_t pageData[PELIB_PAGE_SIZE];
 
 		// Write each page to the file
 		for(auto & page : pages)
 		{
-			dataToWrite = (char *)(page.buffer.size() ? page.buffer.data() : zeroPage);
-			fs.write(dataToWrite, PELIB_PAGE_SIZE);
+			page.readFromPage(pageData, 0, PELIB_PAGE_SIZE);
+			fs.write(reinterpret_cast<char *>(pageData), PELIB_PAGE_SIZE);
 			bytesWritten += PELIB_PAGE_SIZE;
 		}
 	}
@@ -913,7 +922,7 @@ PeLib::LoaderError PeLib::ImageLoader::loaderError() const
 //-----------------------------------------------------------------------------
 // Interface for loading files
 int PeLib::ImageLoader::Load(
-	ByteBuffer & fileData,
+	ByteView fileData,
 	bool loadHeadersOnly)
 {
 	int fileError;
@@ -982,7 +991,7 @@ int PeLib::ImageLoader::Load(
 	std::streamoff fileOffset,
 	bool loadHeadersOnly)
 {
-	ByteBuffer fileData;
+	auto fileData = std::make_shared<ByteBuffer>();
 	std::streampos fileSize;
 	std::size_t fileSize2;
 	int fileError;
@@ -1013,7 +1022,7 @@ int PeLib::ImageLoader::Load(
 	// potentially allocate a very large memory block, so we need to handle that carefully
 	try
 	{
-		fileData.resize(fileSize2);
+		fileData->resize(fileSize2);
 	}
 	catch(const std::bad_alloc&)
 	{
@@ -1025,14 +1034,23 @@ int PeLib::ImageLoader::Load(
 	// can fail on low memory. When that happens, fs.read will read less than
 	// required. We need to verify the number of bytes read and return the apropriate error code.
 	fs.seekg(fileOffset);
-	fs.read(reinterpret_cast<char*>(fileData.data()), fileSize2);
+	fs.read(reinterpret_cast<char*>(fileData->data()), fileSize2);
 	if(fs.gcount() < (fileSize - fileOffset))
 	{
 		return ERROR_NOT_ENOUGH_SPACE;
 	}
 
-	// Call the Load interface on char buffer
-	return Load(fileData, loadHeadersOnly);
+	return Load(std::shared_ptr<const ByteBuffer>(std::move(fileData)), loadHeadersOnly);
+}
+
+int PeLib::ImageLoader::Load(
+	std::shared_ptr<const ByteBuffer> fileData,
+	bool loadHeadersOnly)
+{
+	// Call the Load interface on char buffer. Pages of the image reference the buffer,
+	// so keep it for the lifetime of the loader
+	ownFileData = std::move(fileData);
+	return Load(ByteView(*ownFileData), loadHeadersOnly);
 }
 
 int PeLib::ImageLoader::Load(
@@ -1157,15 +1175,8 @@ void PeLib::ImageLoader::readFromPage(
 	std::size_t offsetInPage,
 	std::size_t bytesInPage)
 {
-	// Is it a page with actual data?
-	if(page.buffer.size())
-	{
-		memcpy(buffer, page.buffer.data() + offsetInPage, bytesInPage);
-	}
-	else
-	{
-		memset(buffer, 0, bytesInPage);
-	}
+	// Read the data of the page. Pages without data are zeroed
+	page.readFromPage(buffer, offsetInPage, bytesInPage);
 }
 
 void PeLib::ImageLoader::writeToPage(
@@ -1174,7 +1185,7 @@ void PeLib::ImageLoader::writeToPage(
 	std::size_t offsetInPage,
 	std::size_t bytesInPage)
 {
-	// Write the data to the page
+	// Write the data to the page. This makes a private copy of the page
 	page.writeToPage(buffer, offsetInPage, bytesInPage);
 }
 
@@ -1632,10 +1643,10 @@ void PeLib::ImageLoader::writeNewImageBase(std::uint64_t newImageBase)
 	}
 }
 
-int PeLib::ImageLoader::captureDosHeader(ByteBuffer & fileData)
+int PeLib::ImageLoader::captureDosHeader(ByteView fileData)
 {
-	std::uint8_t * fileBegin = fileData.data();
-	std::uint8_t * fileEnd = fileBegin + fileData.size();
+	const std::uint8_t * fileBegin = fileData.data();
+	const std::uint8_t * fileEnd = fileBegin + fileData.size();
 
 	// Capture the DOS header
 	if((fileBegin + sizeof(PELIB_IMAGE_DOS_HEADER)) >= fileEnd)
@@ -1680,11 +1691,11 @@ int PeLib::ImageLoader::saveDosHeader(
 	return saveToFile(fs, fileOffset, 0, dosHeader.e_lfanew);
 }
 
-int PeLib::ImageLoader::captureNtHeaders(ByteBuffer & fileData)
+int PeLib::ImageLoader::captureNtHeaders(ByteView fileData)
 {
-	std::uint8_t * fileBegin = fileData.data();
-	std::uint8_t * filePtr = fileBegin + dosHeader.e_lfanew;
-	std::uint8_t * fileEnd = fileBegin + fileData.size();
+	const std::uint8_t * fileBegin = fileData.data();
+	const std::uint8_t * filePtr = fileBegin + dosHeader.e_lfanew;
+	const std::uint8_t * fileEnd = fileBegin + fileData.size();
 	std::size_t ntHeaderSize;
 	std::uint16_t optionalHeaderMagic = PELIB_IMAGE_NT_OPTIONAL_HDR32_MAGIC;
 
@@ -1939,7 +1950,7 @@ int PeLib::ImageLoader::saveNtHeaders(
 }
 
 int PeLib::ImageLoader::captureSectionName(
-	ByteBuffer & fileData,
+	ByteView fileData,
 	std::string & sectionName,
 	const std::uint8_t * Name)
 {
@@ -1980,11 +1991,11 @@ int PeLib::ImageLoader::captureSectionName(
 	return ERROR_NONE;
 }
 
-int PeLib::ImageLoader::captureSectionHeaders(ByteBuffer & fileData)
+int PeLib::ImageLoader::captureSectionHeaders(ByteView fileData)
 {
-	std::uint8_t * fileBegin = fileData.data();
-	std::uint8_t * filePtr;
-	std::uint8_t * fileEnd = fileBegin + fileData.size();
+	const std::uint8_t * fileBegin = fileData.data();
+	const std::uint8_t * filePtr;
+	const std::uint8_t * fileEnd = fileBegin + fileData.size();
 	bool bRawDataBeyondEOF = false;
 
 	// If there are no sections, then we're done
@@ -2193,7 +2204,7 @@ int PeLib::ImageLoader::saveSectionHeaders(
 	return saveToFile(fs, fileOffset, offsetOfHeaders, sizeOfHeaders);
 }
 
-int PeLib::ImageLoader::captureImageSections(ByteBuffer & fileData)
+int PeLib::ImageLoader::captureImageSections(ByteView fileData)
 {
 	std::uint32_t virtualAddress = 0;
 	std::uint32_t sizeOfHeaders = optionalHeader.SizeOfHeaders;
@@ -2310,9 +2321,9 @@ int PeLib::ImageLoader::verifyDosHeader(
 	return (ldrError == LDR_ERROR_E_LFANEW_OUT_OF_FILE) ? ERROR_INVALID_FILE : ERROR_NONE;
 }
 
-int PeLib::ImageLoader::loadImageAsIs(ByteBuffer & fileData)
+int PeLib::ImageLoader::loadImageAsIs(ByteView fileData)
 {
-	rawFileData = fileData;
+	rawFileData.assign(fileData.begin(), fileData.end());
 	return ERROR_NONE;
 }
 
@@ -2346,9 +2357,9 @@ std::uint32_t PeLib::ImageLoader::copyDataDirectories(
 }
 
 int PeLib::ImageLoader::captureOptionalHeader64(
-	std::uint8_t * fileBegin,
-	std::uint8_t * filePtr,
-	std::uint8_t * fileEnd)
+	const std::uint8_t * fileBegin,
+	const std::uint8_t * filePtr,
+	const std::uint8_t * fileEnd)
 {
 	PELIB_IMAGE_OPTIONAL_HEADER64 optionalHeader64{};
 	std::uint32_t sizeOfOptionalHeader = sizeof(PELIB_IMAGE_OPTIONAL_HEADER64);
@@ -2407,9 +2418,9 @@ int PeLib::ImageLoader::captureOptionalHeader64(
 }
 
 int PeLib::ImageLoader::captureOptionalHeader32(
-	std::uint8_t * fileBegin,
-	std::uint8_t * filePtr,
-	std::uint8_t * fileEnd)
+	const std::uint8_t * fileBegin,
+	const std::uint8_t * filePtr,
+	const std::uint8_t * fileEnd)
 {
 	PELIB_IMAGE_OPTIONAL_HEADER32 optionalHeader32{};
 	std::uint32_t sizeOfOptionalHeader = sizeof(PELIB_IMAGE_OPTIONAL_HEADER32);
@@ -2469,7 +2480,7 @@ int PeLib::ImageLoader::captureOptionalHeader32(
 }
 
 std::uint32_t PeLib::ImageLoader::captureImageSection(
-	ByteBuffer & fileData,
+	ByteView fileData,
 	std::uint32_t virtualAddress,
 	std::uint32_t virtualSize,
 	std::uint32_t pointerToRawData,
@@ -2477,10 +2488,10 @@ std::uint32_t PeLib::ImageLoader::captureImageSection(
 	std::uint32_t characteristics,
 	bool isImageHeader)
 {
-	std::uint8_t * fileBegin = fileData.data();
-	std::uint8_t * rawDataPtr;
-	std::uint8_t * rawDataEnd;
-	std::uint8_t * fileEnd = fileBegin + fileData.size();
+	const std::uint8_t * fileBegin = fileData.data();
+	const std::uint8_t * rawDataPtr;
+	const std::uint8_t * rawDataEnd;
+	const std::uint8_t * fileEnd = fileBegin + fileData.size();
 	std::uint32_t sizeOfInitializedPages;            // The part of section with initialized pages
 	std::uint32_t sizeOfValidPages;                  // The part of section with valid pages
 	std::uint32_t sizeOfSection;                     // Total virtual size of the section
@@ -2702,7 +2713,7 @@ bool PeLib::ImageLoader::isValidMachineForCodeIntegrifyCheck(std::uint32_t Bits)
 // there are some more checks implemented by CI!HashpParsePEHeader
 // (nt!SeValidateImageHeader -> CI!CiValidateImageHeader -> ... -> CI!HashpParsePEHeader in Win7)
 // This function does the same checks like CI!HashpParsePEHeader
-bool PeLib::ImageLoader::checkForBadCodeIntegrityImages(ByteBuffer & fileData)
+bool PeLib::ImageLoader::checkForBadCodeIntegrityImages(ByteView fileData)
 {
 	if(optionalHeader.DllCharacteristics & PELIB_IMAGE_DLLCHARACTERISTICS_FORCE_INTEGRITY)
 	{
@@ -2802,7 +2813,7 @@ bool PeLib::ImageLoader::checkForBadCodeIntegrityImages(ByteBuffer & fileData)
 		// just check for the most blatantly corrupt certificates
 		if(forceIntegrityCheckCertificate)
 		{
-			std::uint8_t * certPtr = fileData.data() + SecurityDir.VirtualAddress;
+			const std::uint8_t * certPtr = fileData.data() + SecurityDir.VirtualAddress;
 			if(SecurityDir.Size > 2 && certPtr[0] == 0 && certPtr[1] == 0)
 				return true;
 		}
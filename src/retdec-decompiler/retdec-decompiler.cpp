@@ -47,6 +47,7 @@
 #include "retdec/utils/io/log.h"
 #include "retdec/utils/memory.h"
 #include "retdec/utils/string.h"
+#include "retdec/utils/thread_pool.h"
 #include "retdec/utils/version.h"
 
 using namespace retdec::utils::io;
@@ -426,6 +427,40 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 		}
 		params.setBackendVarRenamer(s);
 	}
+	else if (isParam(i, "", "--backend-jobs"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			auto jobs = std::stoull(val);
+			params.setBackendJobs(
+				jobs == 0 ? retdec::utils::ThreadPool::getDefaultThreadCount() : jobs
+			);
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--backend-jobs] invalid value: " + val
+			);
+		}
+	}
+	else if (isParam(i, "", "--analysis-jobs"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			auto jobs = std::stoull(val);
+			params.setAnalysisJobs(
+				jobs == 0 ? retdec::utils::ThreadPool::getDefaultThreadCount() : jobs
+			);
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--analysis-jobs] invalid value: " + val
+			);
+		}
+	}
 	else if (isParam(i, "", "--backend-no-opts"))
 	{
 		params.setIsBackendNoOpts(true);
@@ -501,6 +536,32 @@ void ProgramOptions::loadOption(std::list<std::string>::iterator& i)
 		auto file = checkFile(getParamOrDie(i), "[--static-code-sigfile]");
 		params.userStaticSignaturePaths.insert(file);
 	}
+	else if (isParam(i, "", "--yara-cache-dir"))
+	{
+		params.setYaraCacheDirectory(getParamOrDie(i));
+	}
+	else if (isParam(i, "", "--profile-passes"))
+	{
+		params.setProfilePassesFile(getParamOrDie(i));
+	}
+	else if (isParam(i, "", "--bin2llvmir-cache-dir"))
+	{
+		params.setBin2llvmirCacheDirectory(getParamOrDie(i));
+	}
+	else if (isParam(i, "", "--bin2llvmir-cache-size"))
+	{
+		auto val = getParamOrDie(i);
+		try
+		{
+			params.setBin2llvmirCacheMaxSize(std::stoull(val));
+		}
+		catch (...)
+		{
+			throw std::runtime_error(
+				"[--bin2llvmir-cache-size] invalid value: " + val
+			);
+		}
+	}
 	else if (isParam(i, "", "--timeout"))
 	{
 		auto t = getParamOrDie(i);
@@ -642,11 +703,13 @@ Archive decompilation arguments:
 	[--ar-index INDEX] Pick file from archive for decompilation by its zero-based index.
 	[--ar-name NAME] Pick file from archive for decompilation by its name.
 	[--static-code-sigfile FILE] Adds additional signature file for static code detection.
+	[--yara-cache-dir DIR] Directory in which compiled YARA rules are cached between runs.
 Backend arguments:
 	[--backend-disabled-opts LIST] Prevents the optimizations from the given comma-separated list of optimizations to be run.
 	[--backend-enabled-opts LIST] Runs only the optimizations from the given comma-separated list of optimizations.
 	[--backend-call-info-obtainer NAME] Name of the obtainer of information about function calls [optim|pessim] (Default: optim).
 	[--backend-var-renamer STYLE] Used renamer of variables [address|hungarian|readable|simple|unified] (Default: readable).
+	[--backend-jobs N] Number of threads used to optimize functions in the backend, 0 means all available cores (Default: 1).
 	[--backend-no-opts] Disables backend optimizations.
 	[--backend-emit-cfg] Emits a CFG for each function in the backend IR (in the .dot format).
 	[--backend-emit-cg] Emits a CG for the decompiled module in the backend IR (in the .dot format).
@@ -660,6 +723,10 @@ Decompilation process arguments:
 	[--timeout SECONDS]
 	[--max-memory MAX_MEMORY] Limits the maximal memory used by the given number of bytes.
 	[--no-memory-limit] Disables the default memory limit (half of system RAM).
+	[--analysis-jobs N] Number of threads used to analyze functions in bin2llvmir, 0 means all available cores (Default: 1).
+	[--profile-passes FILE] Writes time, memory, and IR size of every pass into FILE (JSON with Chrome trace events).
+	[--bin2llvmir-cache-dir DIR] Directory in which bin2llvmir outputs are cached between runs, so that repeated decompilations of the same input run only the backend.
+	[--bin2llvmir-cache-size BYTES] Maximal size of the bin2llvmir cache, least recently used outputs are removed when it is exceeded, 0 means unlimited (Default: 1073741824).
 LLVM IR debug arguments:
 	[--print-after-all] Dump LLVM IR to stderr after every LLVM pass.
 	[--print-before-all] Dump LLVM IR to stderr before every LLVM pass.
@@ -4,6 +4,14 @@
  * @copyright (c) 2019 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <tuple>
+
 #include <llvm/ADT/Triple.h>
 #include <llvm/Analysis/CallGraph.h>
 #include <llvm/Analysis/CallGraphSCCPass.h>
@@ -12,6 +20,8 @@
 #include <llvm/Analysis/ScalarEvolution.h>
 #include <llvm/Analysis/TargetLibraryInfo.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Bitcode/BitcodeReader.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/CodeGen/CommandFlags.inc>
 #include <llvm/IR/CFG.h>
 #include <llvm/IR/DataLayout.h>
@@ -40,16 +50,27 @@
 #include <llvm/Transforms/IPO/PassManagerBuilder.h>
 #include <llvm/Transforms/Utils/Cloning.h>
 
+#include "retdec/bin2llvmir/optimizations/cond_branch_opt/cond_branch_opt.h"
+#include "retdec/bin2llvmir/optimizations/constants/constants.h"
 #include "retdec/bin2llvmir/optimizations/decoder/decoder.h"
+#include "retdec/bin2llvmir/optimizations/inst_opt_rda/inst_opt_rda_pass.h"
 #include "retdec/bin2llvmir/optimizations/provider_init/provider_init.h"
+#include "retdec/bin2llvmir/optimizations/stack/stack.h"
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
 #include "retdec/bin2llvmir/providers/config.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
 
 #include "retdec/llvmir2hll/llvmir2hll.h"
 
 #include "retdec/config/config.h"
+#include "retdec/fileformat/utils/crypto.h"
 #include "retdec/retdec/retdec.h"
+#include "retdec/utils/disk_cache.h"
+#include "retdec/utils/filesystem.h"
 #include "retdec/utils/memory.h"
+#include "retdec/utils/memory_mapped_file.h"
+#include "retdec/utils/pass_profiler.h"
+#include "retdec/utils/version.h"
 #include "retdec/utils/io/log.h"
 
 using namespace retdec::utils::io;
@@ -298,6 +319,19 @@ void fillFunctions(
 	}
 }
 
+LlvmModuleContextPair::~LlvmModuleContextPair()
+{
+	// Data held by providers must not outlive the module.
+	if (module)
+	{
+		bin2llvmir::ProviderInitialization::clearProviders(module.get());
+	}
+
+	// Order matters: module destructor uses context.
+	module.reset();
+	context.reset();
+}
+
 LlvmModuleContextPair disassemble(
 		const std::string& inputPath,
 		retdec::common::FunctionSet* fs)
@@ -323,6 +357,363 @@ LlvmModuleContextPair disassemble(
 	return LlvmModuleContextPair{std::move(module), std::move(context)};
 }
 
+//==============================================================================
+// bin2llvmir cache
+//==============================================================================
+
+/**
+ * The first backend pass. Passes before it are bin2llvmir passes, whose
+ * output may be cached between runs.
+ */
+const std::string BackendPassArgument = "retdec-llvmir2hll";
+
+/// Names of files in entries of the bin2llvmir cache.
+const std::string CachedBitcodeFile = "module.bc";
+const std::string CachedConfigFile = "config.json";
+const std::string CachedAsmFile = "module.dsm";
+
+static bool readFile(const std::string& path, std::string& content)
+{
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+	{
+		return false;
+	}
+	content.assign(
+			std::istreambuf_iterator<char>(in),
+			std::istreambuf_iterator<char>());
+	return !in.bad();
+}
+
+static void writeFile(const std::string& path, const std::string& content)
+{
+	std::ofstream out(path, std::ios::binary);
+	out.write(content.data(), content.size());
+}
+
+/**
+ * @return SHA256 of the content of file @a path, or an empty string if it
+ *         cannot be read.
+ */
+static std::string getFileSha256(const std::string& path)
+{
+	utils::MemoryMappedFile file(path);
+	if (!file.isOpen())
+	{
+		return std::string();
+	}
+	return fileformat::getSha256(file.getData(), file.getSize());
+}
+
+/**
+ * Append the path, size and modification time of file @a path to @a stamp.
+ * Files that do not exist are recorded as missing.
+ */
+static void addFileStamp(const fs::path& path, std::string& stamp)
+{
+	std::error_code sizeEc;
+	std::error_code timeEc;
+	auto size = fs::file_size(path, sizeEc);
+	auto time = fs::last_write_time(path, timeEc);
+	stamp += path.string();
+	stamp += sizeEc || timeEc
+			? std::string(" missing")
+			: " " + std::to_string(size)
+				+ " " + std::to_string(time.time_since_epoch().count());
+	stamp += "\n";
+}
+
+/**
+ * @return Paths, sizes and modification times of the data files that
+ *         bin2llvmir reads according to @a params: static signatures,
+ *         library type information, crypto patterns, and all the files in
+ *         the ordinal numbers directory.
+ */
+static std::string getDataFilesStamp(const retdec::config::Parameters& params)
+{
+	std::string stamp;
+	for (auto* paths : {
+			&params.userStaticSignaturePaths,
+			&params.staticSignaturePaths,
+			&params.libraryTypeInfoPaths,
+			&params.cryptoPatternPaths})
+	{
+		for (auto& p : *paths)
+		{
+			addFileStamp(p, stamp);
+		}
+	}
+
+	auto& ordinalsDir = params.getOrdinalNumbersDirectory();
+	if (!ordinalsDir.empty())
+	{
+		std::set<fs::path> ordinals;
+		std::error_code ec;
+		for (fs::recursive_directory_iterator it(ordinalsDir, ec), end;
+				!ec && it != end;
+				it.increment(ec))
+		{
+			if (fs::is_regular_file(it->path(), ec))
+			{
+				ordinals.insert(it->path());
+			}
+		}
+		for (auto& p : ordinals)
+		{
+			addFileStamp(p, stamp);
+		}
+	}
+
+	return stamp;
+}
+
+/**
+ * Copy parameters that do not influence the output of bin2llvmir from
+ * @a from to @a to. These are the input files (their contents are hashed
+ * instead), outputs, logs, resources of the run, and backend options.
+ */
+static void copyRunParameters(
+		const retdec::config::Parameters& from,
+		retdec::config::Parameters& to)
+{
+	to.setInputFile(from.getInputFile());
+	to.setInputPdbFile(from.getInputPdbFile());
+	to.setOutputFile(from.getOutputFile());
+	to.setOutputBitcodeFile(from.getOutputBitcodeFile());
+	to.setOutputAsmFile(from.getOutputAsmFile());
+	to.setOutputLlvmirFile(from.getOutputLlvmirFile());
+	to.setOutputConfigFile(from.getOutputConfigFile());
+	to.setOutputUnpackedFile(from.getOutputUnpackedFile());
+	to.setOutputFormat(from.getOutputFormat());
+	to.setLogFile(from.getLogFile());
+	to.setErrFile(from.getErrFile());
+	to.setIsVerboseOutput(from.isVerboseOutput());
+	to.setYaraCacheDirectory(from.getYaraCacheDirectory());
+	to.setProfilePassesFile(from.getProfilePassesFile());
+	to.setBin2llvmirCacheDirectory(from.getBin2llvmirCacheDirectory());
+	to.setBin2llvmirCacheMaxSize(from.getBin2llvmirCacheMaxSize());
+	to.setMaxMemoryLimit(from.getMaxMemoryLimit());
+	to.setIsMaxMemoryLimitHalfRam(from.isMaxMemoryLimitHalfRam());
+	to.setTimeout(from.getTimeout());
+	to.setAnalysisJobs(from.getAnalysisJobs());
+
+	to.setBackendDisabledOpts(from.getBackendDisabledOpts());
+	to.setBackendEnabledOpts(from.getBackendEnabledOpts());
+	to.setBackendCallInfoObtainer(from.getBackendCallInfoObtainer());
+	to.setBackendVarRenamer(from.getBackendVarRenamer());
+	to.setBackendJobs(from.getBackendJobs());
+	to.setIsBackendNoOpts(from.isBackendNoOpts());
+	to.setIsBackendEmitCfg(from.isBackendEmitCfg());
+	to.setIsBackendEmitCg(from.isBackendEmitCg());
+	to.setIsBackendKeepAllBrackets(from.isBackendKeepAllBrackets());
+	to.setIsBackendKeepLibraryFuncs(from.isBackendKeepLibraryFuncs());
+	to.setIsBackendNoTimeVaryingInfo(from.isBackendNoTimeVaryingInfo());
+	to.setIsBackendNoVarRenaming(from.isBackendNoVarRenaming());
+	to.setIsBackendNoCompoundOperators(from.isBackendNoCompoundOperators());
+	to.setIsBackendNoSymbolicNames(from.isBackendNoSymbolicNames());
+
+	to.llvmPasses = from.llvmPasses;
+}
+
+/**
+ * @return Key of the output of @a bin2llvmirPasses run with @a config in the
+ *         bin2llvmir cache, or an empty string if the input cannot be read.
+ *
+ * The key is SHA256 of the RetDec version, of the contents of the input
+ * files, of the paths, sizes and modification times of the data files read by
+ * bin2llvmir, and of the configuration without parameters of the run.
+ */
+static std::string getCacheKey(
+		const retdec::config::Config& config,
+		const std::vector<std::string>& bin2llvmirPasses)
+{
+	auto inputHash = getFileSha256(config.parameters.getInputFile());
+	if (inputHash.empty())
+	{
+		return std::string();
+	}
+	std::string pdbHash;
+	if (!config.parameters.getInputPdbFile().empty())
+	{
+		pdbHash = getFileSha256(config.parameters.getInputPdbFile());
+		if (pdbHash.empty())
+		{
+			return std::string();
+		}
+	}
+
+	auto c = config;
+	copyRunParameters(retdec::config::Parameters(), c.parameters);
+	c.parameters.llvmPasses = bin2llvmirPasses;
+
+	auto key = utils::version::getCommitHash()
+			+ "\n" + inputHash
+			+ "\n" + pdbHash
+			+ "\n" + getDataFilesStamp(config.parameters)
+			+ "\n" + c.generateJsonString();
+	return fileformat::getSha256(
+			reinterpret_cast<const unsigned char*>(key.data()),
+			key.size());
+}
+
+/**
+ * Store the output of bin2llvmir -- @a module and @a config -- into @a cache.
+ */
+static void storeBin2llvmirOutput(
+		utils::DiskCache& cache,
+		const std::string& key,
+		llvm::Module& module,
+		const retdec::config::Config& config)
+{
+	utils::DiskCache::Entry entry;
+
+	llvm::raw_string_ostream bc(entry[CachedBitcodeFile]);
+	bool ShouldPreserveUseListOrder = true;
+	WriteBitcodeToFile(module, bc, ShouldPreserveUseListOrder);
+	bc.flush();
+
+	entry[CachedConfigFile] = config.generateJsonString();
+
+	// The assembly is generated by bin2llvmir, but it is not a part of the
+	// module, so it is read back from its output file.
+	std::string dsm;
+	auto& asmFile = config.parameters.getOutputAsmFile();
+	if (!asmFile.empty() && readFile(asmFile, dsm))
+	{
+		entry[CachedAsmFile] = dsm;
+	}
+
+	if (!cache.store(key, entry))
+	{
+		Log::error() << Log::Warning
+				<< "failed to store bin2llvmir output into "
+				<< cache.getDirectory() << std::endl;
+	}
+}
+
+/**
+ * Load the output of bin2llvmir from cache @a entry into @a module and
+ * @a config. Parameters of the current run in @a config are kept.
+ * @return @c True if the output was loaded, @c false if @a entry is broken.
+ */
+static bool loadBin2llvmirOutput(
+		const utils::DiskCache::Entry& entry,
+		llvm::LLVMContext& context,
+		std::unique_ptr<llvm::Module>& module,
+		retdec::config::Config& config)
+{
+	auto bc = entry.find(CachedBitcodeFile);
+	auto json = entry.find(CachedConfigFile);
+	if (bc == entry.end() || json == entry.end())
+	{
+		return false;
+	}
+
+	auto m = llvm::parseBitcodeFile(
+			llvm::MemoryBufferRef(bc->second, CachedBitcodeFile),
+			context);
+	if (!m)
+	{
+		llvm::consumeError(m.takeError());
+		return false;
+	}
+
+	auto params = config.parameters;
+	try
+	{
+		config.readJsonString(json->second);
+	}
+	catch (const retdec::config::ParseException&)
+	{
+		return false;
+	}
+	copyRunParameters(params, config.parameters);
+
+	module = std::move(*m);
+	return true;
+}
+
+/**
+ * Write the output files that @a bin2llvmirPasses would write, using the
+ * cached @a entry that was loaded into @a module and @a config.
+ */
+static void writeBin2llvmirOutputs(
+		const utils::DiskCache::Entry& entry,
+		llvm::Module& module,
+		const retdec::config::Config& config,
+		const std::vector<std::string>& bin2llvmirPasses)
+{
+	auto hasPass = [&bin2llvmirPasses](const std::string& p)
+	{
+		return std::find(bin2llvmirPasses.begin(), bin2llvmirPasses.end(), p)
+				!= bin2llvmirPasses.end();
+	};
+	auto& params = config.parameters;
+
+	auto dsm = entry.find(CachedAsmFile);
+	if (hasPass("retdec-write-dsm")
+			&& !params.getOutputAsmFile().empty()
+			&& dsm != entry.end())
+	{
+		writeFile(params.getOutputAsmFile(), dsm->second);
+	}
+
+	if (hasPass("retdec-write-ll") && !params.getOutputLlvmirFile().empty())
+	{
+		std::error_code ec;
+		llvm::raw_fd_ostream out(
+				params.getOutputLlvmirFile(),
+				ec,
+				llvm::sys::fs::F_None);
+		if (!ec)
+		{
+			bool ShouldPreserveUseListOrder = true;
+			module.print(out, nullptr, ShouldPreserveUseListOrder);
+		}
+	}
+
+	if (hasPass("retdec-write-bc") && !params.getOutputBitcodeFile().empty())
+	{
+		writeFile(
+				params.getOutputBitcodeFile(),
+				entry.find(CachedBitcodeFile)->second);
+	}
+
+	if (hasPass("retdec-provider-init") && !params.getOutputConfigFile().empty())
+	{
+		config.generateJsonFile(params.getOutputConfigFile());
+	}
+}
+
+/**
+ * Log whether the output of bin2llvmir was found in @a cache, and the
+ * current size of the cache.
+ */
+static void logCacheReport(
+		const utils::DiskCache& cache,
+		const std::string& key,
+		bool hit)
+{
+	Log::phase("bin2llvmir cache");
+	if (key.empty())
+	{
+		Log::phase("input cannot be read, nothing is cached", Log::SubPhase);
+		return;
+	}
+
+	Log::phase((hit ? "hit: " : "miss: ") + key, Log::SubPhase);
+
+	auto& s = cache.getStatistics();
+	if (s.stores > 0)
+	{
+		Log::phase(
+				"stored, " + std::to_string(s.entries) + " entries ("
+				+ std::to_string(s.size) + " B) in " + cache.getDirectory()
+				+ ", " + std::to_string(s.evictions) + " evicted",
+				Log::SubPhase);
+	}
+}
+
 //==============================================================================
 // decompiler
 //==============================================================================
@@ -357,7 +748,7 @@ class ModulePassPrinter : public ModulePass
 		std::string PhaseArg;
 		std::string PassName;
 
-		static std::string LastPhase;
+		static thread_local std::string LastPhase;
 		inline static const std::string LlvmAggregatePhaseName = "LLVM";
 
 	public:
@@ -406,21 +797,171 @@ class ModulePassPrinter : public ModulePass
 		}
 };
 char ModulePassPrinter::ID = 0;
-std::string ModulePassPrinter::LastPhase;
+thread_local std::string ModulePassPrinter::LastPhase;
+
+/**
+ * This pass starts or stops profiling of another pass.
+ * In pass manager, the starting one should be placed right before the
+ * profiled pass, and the stopping one right after it.
+ * Analyses required by the profiled pass are scheduled in between, so they
+ * are accounted to the profiled pass.
+ */
+class ModulePassProfiler : public ModulePass
+{
+	public:
+		static char ID;
+		utils::PassProfiler* Profiler;
+		std::string ProfiledPassArg;
+		bool Start;
+		std::string PassName;
+
+	public:
+		ModulePassProfiler(
+				utils::PassProfiler* profiler,
+				const std::string& profiledPassArg,
+				bool start)
+				: ModulePass(ID)
+				, Profiler(profiler)
+				, ProfiledPassArg(profiledPassArg)
+				, Start(start)
+				, PassName("ModulePass Profiler: " + ProfiledPassArg)
+		{
+
+		}
+
+		bool runOnModule(Module &M) override
+		{
+			if (Start)
+			{
+				Profiler->start(ProfiledPassArg, "llvm", getIrSize(M));
+			}
+			else
+			{
+				Profiler->stop(getIrSize(M));
+			}
+			return false;
+		}
+
+		llvm::StringRef getPassName() const override
+		{
+			return PassName.c_str();
+		}
+
+		void getAnalysisUsage(AnalysisUsage &AU) const override
+		{
+			AU.setPreservesAll();
+		}
+
+	private:
+		static utils::PassProfiler::IrSize getIrSize(Module& M)
+		{
+			utils::PassProfiler::IrSize size;
+			for (auto& f : M)
+			{
+				if (f.isDeclaration())
+				{
+					continue;
+				}
+				++size.functions;
+				size.blocks += f.size();
+				for (auto& bb : f)
+				{
+					size.instructions += bb.size();
+				}
+			}
+			return size;
+		}
+};
+char ModulePassProfiler::ID = 0;
+
+/**
+ * This pass invalidates the reaching definitions analysis shared by passes
+ * (see bin2llvmir::ReachingDefinitionsProvider) for all the functions of the
+ * module. It should be placed right after every pass that may change the
+ * module without reporting the changed functions to the analysis.
+ */
+class ReachingDefinitionsInvalidator : public ModulePass
+{
+	public:
+		static char ID;
+
+	public:
+		ReachingDefinitionsInvalidator()
+				: ModulePass(ID)
+		{
+
+		}
+
+		bool runOnModule(Module &M) override
+		{
+			bin2llvmir::ReachingDefinitionsProvider::invalidate(&M);
+			return false;
+		}
+
+		llvm::StringRef getPassName() const override
+		{
+			return "Reaching Definitions Invalidator";
+		}
+
+		void getAnalysisUsage(AnalysisUsage &AU) const override
+		{
+			AU.setPreservesAll();
+		}
+};
+char ReachingDefinitionsInvalidator::ID = 0;
+
+/**
+ * Does the pass report all the functions it changes to the shared reaching
+ * definitions analysis (see bin2llvmir::ReachingDefinitionsProvider)?
+ */
+static bool reportsChangesToReachingDefinitions(const PassInfo* PI)
+{
+	static const std::set<const void*> reportingPasses = {
+		&bin2llvmir::CondBranchOpt::ID,
+		&bin2llvmir::ConstantsAnalysis::ID,
+		&bin2llvmir::InstructionRdaOptimizer::ID,
+		&bin2llvmir::StackAnalysis::ID,
+	};
+	return PI->isAnalysis() || reportingPasses.count(PI->getTypeInfo());
+}
 
 /**
  * Add the pass to the pass manager - no verification.
+ * If @a profiler is set, the pass is profiled by it.
+ * If the pass does not report its changes to the shared reaching definitions
+ * analysis, the analysis is invalidated after it.
  */
 static inline void addPass(
 		legacy::PassManagerBase& PM,
 		Pass* P,
-		const PassInfo* PI)
+		const PassInfo* PI,
+		utils::PassProfiler* profiler = nullptr)
 {
 	PM.add(new ModulePassPrinter(
 			PI->getPassName().str(),
 			PI->getPassArgument().str()
 	));
+	if (profiler)
+	{
+		PM.add(new ModulePassProfiler(
+				profiler,
+				PI->getPassArgument().str(),
+				true
+		));
+	}
 	PM.add(P);
+	if (profiler)
+	{
+		PM.add(new ModulePassProfiler(
+				profiler,
+				PI->getPassArgument().str(),
+				false
+		));
+	}
+	if (!reportsChangesToReachingDefinitions(PI))
+	{
+		PM.add(new ReachingDefinitionsInvalidator());
+	}
 
 // if (!PI->isAnalysis())
 // PM.add(P->createPrinterPass(
@@ -445,6 +986,19 @@ void setLogsFrom(const retdec::config::Parameters& params)
 	auto errFile = params.getErrFile();
 	auto verbose = params.isVerboseOutput();
 
+	// Loggers are shared by all the decompilations running in this process.
+	// Do not replace them when they are already set up in the same way
+	// because some other decompilation may be using them right now.
+	static std::mutex logsMutex;
+	static std::optional<std::tuple<std::string, std::string, bool>> logsSetup;
+	std::lock_guard<std::mutex> lock(logsMutex);
+	auto setup = std::make_tuple(logFile, errFile, verbose);
+	if (logsSetup == setup)
+	{
+		return;
+	}
+	logsSetup = setup;
+
 	Logger::Ptr outLog = nullptr;
 
 	outLog.reset(
@@ -460,6 +1014,49 @@ void setLogsFrom(const retdec::config::Parameters& params)
 	}
 }
 
+/**
+ * Add passes with the given names to the pass manager and set them up for
+ * the decompilation of @a config.
+ * If @a profiler is set, the passes are profiled by it.
+ */
+static void addPasses(
+		legacy::PassManagerBase& PM,
+		llvm::PassRegistry& passRegistry,
+		const std::vector<std::string>& passes,
+		const TargetLibraryInfoImpl& TLII,
+		retdec::config::Config& config,
+		std::string* outString,
+		utils::PassProfiler* profiler)
+{
+	PM.add(new TargetLibraryInfoWrapperPass(TLII));
+
+	for (auto& p : passes)
+	{
+		if (auto* info = passRegistry.getPassInfo(p))
+		{
+			auto* pass = info->createPass();
+			addPass(PM, pass, info, profiler);
+
+			if (info->getTypeInfo() == &bin2llvmir::ProviderInitialization::ID)
+			{
+				auto* p = static_cast<bin2llvmir::ProviderInitialization*>(pass);
+				p->setConfig(&config);
+			}
+			if (info->getTypeInfo() == &llvmir2hll::LlvmIr2Hll::ID)
+			{
+				auto* p = static_cast<llvmir2hll::LlvmIr2Hll*>(pass);
+				p->setConfig(&config);
+				p->setOutputString(outString);
+				p->setPassProfiler(profiler);
+			}
+		}
+		else
+		{
+			throw std::runtime_error("cannot create pass: " + p);
+		}
+	}
+}
+
 bool decompile(retdec::config::Config& config, std::string* outString)
 {
 	setLogsFrom(config.parameters);
@@ -473,10 +1070,6 @@ bool decompile(retdec::config::Config& config, std::string* outString)
 	auto context = std::make_unique<llvm::LLVMContext>();
 	auto module = createLlvmModule(*context);
 
-	// Create a PassManager to hold and optimize the collection of passes we
-	// are about to build.
-	llvm::legacy::PassManager pm;
-
 	// Without this LLVM does more opts than we would like it to.
 	// e.g. printf() call -> puts() call
 	//
@@ -485,35 +1078,87 @@ bool decompile(retdec::config::Config& config, std::string* outString)
 	TargetLibraryInfoImpl TLII(ModuleTriple);
 	// The -disable-simplify-libcalls flag actually disables all builtin optzns.
 	TLII.disableAllFunctions();
-	pm.add(new TargetLibraryInfoWrapperPass(TLII));
 
-	for (auto& p : config.parameters.llvmPasses)
+	// Passes are profiled only when requested because measuring the IR size
+	// around every pass takes time.
+	std::unique_ptr<utils::PassProfiler> profiler;
+	auto& profileFile = config.parameters.getProfilePassesFile();
+	if (!profileFile.empty())
 	{
-		if (auto* info = passRegistry.getPassInfo(p))
+		profiler = std::make_unique<utils::PassProfiler>();
+	}
+
+	// When the bin2llvmir cache is used, bin2llvmir passes and the backend
+	// are run by separate pass managers, so that the output of bin2llvmir is
+	// complete (and may be cached) before the backend starts.
+	auto& passes = config.parameters.llvmPasses;
+	auto backendIt = std::find(passes.begin(), passes.end(), BackendPassArgument);
+	std::vector<std::string> bin2llvmirPasses(passes.begin(), backendIt);
+	std::vector<std::string> backendPasses(backendIt, passes.end());
+
+	std::unique_ptr<utils::DiskCache> cache;
+	std::string cacheKey;
+	auto& cacheDir = config.parameters.getBin2llvmirCacheDirectory();
+	if (!cacheDir.empty() && !backendPasses.empty())
+	{
+		cache = std::make_unique<utils::DiskCache>(
+				cacheDir,
+				config.parameters.getBin2llvmirCacheMaxSize());
+		cacheKey = getCacheKey(config, bin2llvmirPasses);
+	}
+
+	auto runPasses = [&](const std::vector<std::string>& names)
+	{
+		llvm::legacy::PassManager pm;
+		addPasses(
+				pm,
+				passRegistry,
+				names,
+				TLII,
+				config,
+				outString,
+				profiler.get());
+		pm.run(*module);
+	};
+
+	if (cacheKey.empty())
+	{
+		if (cache)
 		{
-			auto* pass = info->createPass();
-			addPass(pm, pass, info);
+			logCacheReport(*cache, cacheKey, false);
+		}
 
-			if (info->getTypeInfo() == &bin2llvmir::ProviderInitialization::ID)
-			{
-				auto* p = static_cast<bin2llvmir::ProviderInitialization*>(pass);
-				p->setConfig(&config);
-			}
-			if (info->getTypeInfo() == &llvmir2hll::LlvmIr2Hll::ID)
-			{
-				auto* p = static_cast<llvmir2hll::LlvmIr2Hll*>(pass);
-				p->setConfig(&config);
-				p->setOutputString(outString);
-			}
+		// Without the cache, bin2llvmir and the backend share a single pass
+		// manager, as they always did.
+		runPasses(passes);
+	}
+	else
+	{
+		utils::DiskCache::Entry cached;
+		bool hit = cache->load(cacheKey, cached)
+				&& loadBin2llvmirOutput(cached, *context, module, config);
+		if (hit)
+		{
+			writeBin2llvmirOutputs(cached, *module, config, bin2llvmirPasses);
 		}
 		else
 		{
-			throw std::runtime_error("cannot create pass: " + p);
+			runPasses(bin2llvmirPasses);
+			storeBin2llvmirOutput(*cache, cacheKey, *module, config);
 		}
+		logCacheReport(*cache, cacheKey, hit);
+
+		runPasses(backendPasses);
+	}
+	if (profiler && !profiler->writeJson(profileFile))
+	{
+		Log::error() << Log::Warning
+				<< "failed to write pass profile into " << profileFile
+				<< std::endl;
 	}
 
-	// Now that we have all of the passes ready, run them.
-	pm.run(*module);
+	// The module dies with this function, data held by providers must too.
+	bin2llvmir::ProviderInitialization::clearProviders(module.get());
 
 	return EXIT_SUCCESS;
 }
@@ -695,19 +695,37 @@ const DetectedFunctionsPtrMap& Finder::getConfirmedDetections() const
 void Finder::search(
 	const Image& image,
 	const std::string& yaraFile)
+{
+	search(image, std::set<std::string>{yaraFile});
+}
+
+/**
+ * Search for static code in input file.
+ *
+ * @param image input file image
+ * @param yaraFiles static code signature files
+ *
+ * All the signature files are scanned in a single pass over the loaded bytes
+ * of the input file. Detected functions are attributed to their signature
+ * files by the rule file of the detected rule.
+ */
+void Finder::search(
+	const retdec::loader::Image& image,
+	const std::set<std::string>& yaraFiles)
 {
 	// Get FileFormat instance.
 	const auto* fileFormat = image.getFileFormat();
-	if (!fileFormat)
+	if (!fileFormat || yaraFiles.empty())
 	{
 		return;
 	}
 
 	// Start Yara detector.
 	YaraDetector detector;
-	detector.addRuleFile(yaraFile);
+	detector.addRuleFiles(
+			std::vector<std::string>(yaraFiles.begin(), yaraFiles.end()));
 	auto inputBytes = fileFormat->getLoadedBytes();
-	detector.analyze(inputBytes);
+	detector.analyze(inputBytes.data(), inputBytes.size());
 	if (!detector.isInValidState())
 	{
 		return;
@@ -717,7 +735,7 @@ void Finder::search(
 	for (const YaraRule &detectedRule : detector.getDetectedRules())
 	{
 		DetectedFunction detectedFunction;
-		detectedFunction.signaturePath = yaraFile;
+		detectedFunction.signaturePath = detectedRule.getRuleFile();
 
 		for (const YaraMeta &ruleMeta : detectedRule.getMetas())
 		{
@@ -770,22 +788,6 @@ void Finder::search(
 	}
 }
 
-/**
- * Search for static code in input file.
- *
- * @param image input file image
- * @param yaraFiles static code signature files
- */
-void Finder::search(
-	const retdec::loader::Image& image,
-	const std::set<std::string>& yaraFiles)
-{
-	for (const auto& f : yaraFiles)
-	{
-		search(image, f);
-	}
-}
-
 /**
  * Search for static code in input file based on information in config file.
  *
@@ -0,0 +1,223 @@
+/**
+* @file src/utils/disk_cache.cpp
+* @brief Content-addressed cache of files on disk.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <system_error>
+#include <vector>
+
+#include "retdec/utils/disk_cache.h"
+#include "retdec/utils/filesystem.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/**
+* @brief Reads the whole file @a path into @a content.
+*
+* @return @c true if the file was read, @c false otherwise.
+*/
+bool readFile(const fs::path &path, std::string &content) {
+	std::ifstream in(path, std::ios::binary);
+	if (!in) {
+		return false;
+	}
+	content.assign(std::istreambuf_iterator<char>(in),
+		std::istreambuf_iterator<char>());
+	return !in.bad();
+}
+
+/**
+* @brief Writes @a content into the file @a path.
+*
+* @return @c true if the file was written, @c false otherwise.
+*/
+bool writeFile(const fs::path &path, const std::string &content) {
+	std::ofstream out(path, std::ios::binary);
+	if (!out) {
+		return false;
+	}
+	out.write(content.data(), content.size());
+	out.close();
+	return static_cast<bool>(out);
+}
+
+} // anonymous namespace
+
+/**
+* @brief Creates a cache of entries in @a directory.
+*
+* @param[in] directory Directory with the entries. It is created when the first
+*                      entry is stored.
+* @param[in] maxSize Maximal total size of all entries (in bytes), @c 0 means
+*                    that the size is not limited.
+*/
+DiskCache::DiskCache(const std::string &directory, std::uint64_t maxSize):
+	directory(directory), maxSize(maxSize) {}
+
+/**
+* @brief Loads the entry with the given @a key into @a entry.
+*
+* @return @c true if the entry was loaded, @c false if it is not in the cache
+*         or it could not be read.
+*/
+bool DiskCache::load(const std::string &key, Entry &entry) {
+	std::error_code ec;
+	const auto path = fs::path(directory) / key;
+	if (key.empty() || !fs::is_directory(path, ec)) {
+		++statistics.misses;
+		return false;
+	}
+
+	Entry loaded;
+	for (const auto &file : fs::directory_iterator(path, ec)) {
+		if (!file.is_regular_file(ec)) {
+			continue;
+		}
+		auto &content = loaded[file.path().filename().string()];
+		if (!readFile(file.path(), content)) {
+			++statistics.misses;
+			return false;
+		}
+	}
+	if (ec || loaded.empty()) {
+		++statistics.misses;
+		return false;
+	}
+
+	// Mark the entry as recently used so that it is evicted last.
+	fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+
+	entry = std::move(loaded);
+	++statistics.hits;
+	return true;
+}
+
+/**
+* @brief Stores @a entry under the given @a key.
+*
+* If there already is an entry with the same key (e.g. stored by another
+* process in the meantime), it is kept. Least recently used entries are then
+* removed until the cache fits into its maximal size.
+*
+* @return @c true if the entry is in the cache, @c false otherwise.
+*/
+bool DiskCache::store(const std::string &key, const Entry &entry) {
+	std::error_code ec;
+	const fs::path dir(directory);
+	const auto path = dir / key;
+	const auto tmpPath = dir / (key + ".tmp" +
+		std::to_string(std::random_device{}()));
+
+	fs::create_directories(tmpPath, ec);
+	if (key.empty() || ec) {
+		return false;
+	}
+	for (const auto &file : entry) {
+		if (!writeFile(tmpPath / file.first, file.second)) {
+			fs::remove_all(tmpPath, ec);
+			return false;
+		}
+	}
+
+	fs::rename(tmpPath, path, ec);
+	if (ec) {
+		fs::remove_all(tmpPath, ec);
+		if (!fs::is_directory(path, ec)) {
+			return false;
+		}
+	} else {
+		++statistics.stores;
+	}
+
+	evict(key);
+	return true;
+}
+
+/**
+* @brief Returns the directory with the entries.
+*/
+const std::string &DiskCache::getDirectory() const {
+	return directory;
+}
+
+/**
+* @brief Returns the maximal total size of all entries (in bytes).
+*
+* @c 0 means that the size is not limited.
+*/
+std::uint64_t DiskCache::getMaxSize() const {
+	return maxSize;
+}
+
+/**
+* @brief Returns statistics of the cache since its creation.
+*/
+const DiskCache::Statistics &DiskCache::getStatistics() const {
+	return statistics;
+}
+
+/**
+* @brief Removes the least recently used entries until all entries fit into
+*        the maximal size, and updates the size in the statistics.
+*
+* The entry with @a keptKey is never removed. Temporary directories of entries
+* that are just being stored are neither removed nor counted.
+*/
+void DiskCache::evict(const std::string &keptKey) {
+	struct EntryInfo {
+		fs::path path;
+		fs::file_time_type lastUse;
+		std::uint64_t size;
+	};
+
+	std::error_code ec;
+	std::vector<EntryInfo> entries;
+	std::uint64_t totalSize = 0;
+	for (const auto &dir : fs::directory_iterator(directory, ec)) {
+		auto name = dir.path().filename().string();
+		if (!dir.is_directory(ec) || name.find('.') != std::string::npos) {
+			continue;
+		}
+
+		EntryInfo info{dir.path(), fs::last_write_time(dir.path(), ec), 0};
+		for (const auto &file : fs::directory_iterator(dir.path(), ec)) {
+			auto size = file.file_size(ec);
+			info.size += ec ? 0 : size;
+		}
+		totalSize += info.size;
+		if (name != keptKey) {
+			entries.push_back(std::move(info));
+		}
+	}
+
+	std::sort(entries.begin(), entries.end(),
+		[](const EntryInfo &a, const EntryInfo &b) {
+			return a.lastUse < b.lastUse;
+		});
+
+	std::size_t remaining = entries.size() + 1;
+	for (const auto &e : entries) {
+		if (maxSize == 0 || totalSize <= maxSize) {
+			break;
+		}
+		if (fs::remove_all(e.path, ec) != static_cast<std::uintmax_t>(-1)) {
+			totalSize -= e.size;
+			--remaining;
+			++statistics.evictions;
+		}
+	}
+
+	statistics.entries = remaining;
+	statistics.size = totalSize;
+}
+
+} // namespace utils
+} // namespace retdec
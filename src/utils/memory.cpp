@@ -11,11 +11,19 @@
 
 #ifdef OS_WINDOWS
 	#include <windows.h>
+	#include <psapi.h>
 #elif defined(OS_MACOS) || defined(OS_BSD)
 	#include <sys/types.h>
 	#include <sys/sysctl.h>
 #else
+	#include <fstream>
+	#include <string>
 	#include <sys/sysinfo.h>
+	#include <unistd.h>
+#endif
+
+#ifdef OS_MACOS
+	#include <mach/mach.h>
 #endif
 
 #ifdef OS_POSIX
@@ -45,6 +53,18 @@ bool limitSystemMemoryOnPOSIX(std::size_t limit) {
 
 #ifdef OS_WINDOWS
 
+/**
+* @brief Returns memory counters of the current process on Windows.
+*/
+PROCESS_MEMORY_COUNTERS getProcessMemoryCountersOnWindows() {
+	PROCESS_MEMORY_COUNTERS counters{};
+	counters.cb = sizeof(counters);
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+		return PROCESS_MEMORY_COUNTERS{};
+	}
+	return counters;
+}
+
 /**
 * @brief Implementation of @c getTotalSystemMemory() on Windows.
 */
@@ -100,6 +120,17 @@ bool limitSystemMemoryOnWindows(std::size_t limit) {
 
 #elif defined(OS_MACOS)
 
+/**
+* @brief Returns basic information about the current task on MacOS.
+*/
+mach_task_basic_info getTaskBasicInfoOnMacOS() {
+	mach_task_basic_info info{};
+	mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+	auto rc = task_info(mach_task_self(), MACH_TASK_BASIC_INFO,
+		reinterpret_cast<task_info_t>(&info), &count);
+	return rc == KERN_SUCCESS ? info : mach_task_basic_info{};
+}
+
 /**
 * @brief Implementation of @c getTotalSystemMemory() on MacOS.
 */
@@ -163,6 +194,46 @@ bool limitSystemMemoryOnLinux(std::size_t limit) {
 	return limitSystemMemoryOnPOSIX(limit);
 }
 
+/**
+* @brief Implementation of @c getProcessMemoryUsage() on Linux.
+*/
+std::size_t getProcessMemoryUsageOnLinux() {
+	// The second field of /proc/self/statm is the resident set size in pages.
+	std::ifstream statm("/proc/self/statm");
+	std::size_t size = 0;
+	std::size_t resident = 0;
+	if (!(statm >> size >> resident)) {
+		return 0;
+	}
+	return resident * static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+}
+
+/**
+* @brief Implementation of @c getPeakProcessMemoryUsage() on Linux.
+*/
+std::size_t getPeakProcessMemoryUsageOnLinux() {
+	// VmHWM is computed from the same counters as /proc/self/statm, so unlike
+	// ru_maxrss from getrusage(), it is never lower than the current size.
+	std::ifstream status("/proc/self/status");
+	std::string line;
+	while (std::getline(status, line)) {
+		if (line.compare(0, 6, "VmHWM:") == 0) {
+			return std::stoull(line.substr(6)) * 1024;
+		}
+	}
+	return 0;
+}
+
+/**
+* @brief Implementation of @c resetPeakProcessMemoryUsage() on Linux.
+*/
+bool resetPeakProcessMemoryUsageOnLinux() {
+	// Writing 5 into clear_refs resets VmHWM to the current resident set size
+	// (since Linux 4.0).
+	std::ofstream clearRefs("/proc/self/clear_refs");
+	return static_cast<bool>(clearRefs << "5" << std::flush);
+}
+
 #endif
 
 } // anonymous namespace
@@ -210,6 +281,61 @@ bool limitSystemMemory(std::size_t limit) {
 #endif
 }
 
+/**
+* @brief Returns the current resident set size of this process (in bytes).
+*
+* When the size cannot be obtained, it returns @c 0.
+*/
+std::size_t getProcessMemoryUsage() {
+#ifdef OS_WINDOWS
+	return getProcessMemoryCountersOnWindows().WorkingSetSize;
+#elif defined(OS_MACOS)
+	return getTaskBasicInfoOnMacOS().resident_size;
+#elif defined(OS_BSD)
+	// There is no cheap way of getting the current size on *BSD, so the peak
+	// size is the best approximation we have.
+	return getPeakProcessMemoryUsage();
+#else
+	return getProcessMemoryUsageOnLinux();
+#endif
+}
+
+/**
+* @brief Returns the peak resident set size of this process (in bytes).
+*
+* When the size cannot be obtained, it returns @c 0.
+*/
+std::size_t getPeakProcessMemoryUsage() {
+#ifdef OS_WINDOWS
+	return getProcessMemoryCountersOnWindows().PeakWorkingSetSize;
+#elif defined(OS_MACOS)
+	return getTaskBasicInfoOnMacOS().resident_size_max;
+#elif defined(OS_BSD)
+	// ru_maxrss is in kilobytes on *BSD.
+	struct rusage usage;
+	auto rc = getrusage(RUSAGE_SELF, &usage);
+	return rc == 0 ? static_cast<std::size_t>(usage.ru_maxrss) * 1024 : 0;
+#else
+	return getPeakProcessMemoryUsageOnLinux();
+#endif
+}
+
+/**
+* @brief Resets the peak resident set size of this process to its current
+*        size, so that getPeakProcessMemoryUsage() returns the peak size since
+*        this call.
+*
+* @return @c true if the peak size was reset, @c false if this is not
+*         supported on this system.
+*/
+bool resetPeakProcessMemoryUsage() {
+#if defined(OS_WINDOWS) || defined(OS_MACOS) || defined(OS_BSD)
+	return false;
+#else
+	return resetPeakProcessMemoryUsageOnLinux();
+#endif
+}
+
 /**
 * @brief Limits system memory to half of the total memory.
 */
@@ -0,0 +1,150 @@
+/**
+* @file src/utils/memory_mapped_file.cpp
+* @brief Read-only memory-mapped files.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include "retdec/utils/memory_mapped_file.h"
+#include "retdec/utils/os.h"
+
+#ifdef OS_WINDOWS
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+namespace retdec {
+namespace utils {
+
+/**
+* @brief Maps the file at the given path.
+*
+* Only regular files can be mapped. Use isOpen() to check whether the file has
+* been successfully mapped.
+*/
+MemoryMappedFile::MemoryMappedFile(const std::string &path) {
+#ifdef OS_WINDOWS
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ,
+		nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (GetFileType(file) != FILE_TYPE_DISK || !GetFileSizeEx(file, &fileSize)) {
+		CloseHandle(file);
+		return;
+	}
+
+	// Empty files cannot be mapped, but there is nothing to map anyway.
+	if (fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		opened = true;
+		return;
+	}
+
+	// The mapping keeps the file open, so its handle is not needed anymore.
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0,
+		nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr) {
+		return;
+	}
+
+	void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (view == nullptr) {
+		CloseHandle(mapping);
+		return;
+	}
+
+	mappingHandle = mapping;
+	data = static_cast<const std::uint8_t *>(view);
+	size = static_cast<std::size_t>(fileSize.QuadPart);
+	opened = true;
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		return;
+	}
+
+	// Empty files cannot be mapped, but there is nothing to map anyway.
+	if (st.st_size == 0) {
+		::close(fd);
+		opened = true;
+		return;
+	}
+
+	// The mapping keeps the file open, so its descriptor is not needed
+	// anymore.
+	void *view = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (view == MAP_FAILED) {
+		return;
+	}
+
+	data = static_cast<const std::uint8_t *>(view);
+	size = static_cast<std::size_t>(st.st_size);
+	opened = true;
+#endif
+}
+
+/**
+* @brief Unmaps the file.
+*/
+MemoryMappedFile::~MemoryMappedFile() {
+	close();
+}
+
+/**
+* @brief Has the file been successfully mapped?
+*/
+bool MemoryMappedFile::isOpen() const {
+	return opened;
+}
+
+/**
+* @brief Returns the beginning of the mapped content.
+*
+* For empty files and files that have not been mapped, @c nullptr is returned.
+*/
+const std::uint8_t *MemoryMappedFile::getData() const {
+	return data;
+}
+
+/**
+* @brief Returns the size of the mapped content in bytes.
+*/
+std::size_t MemoryMappedFile::getSize() const {
+	return size;
+}
+
+/**
+* @brief Releases the mapping.
+*/
+void MemoryMappedFile::close() {
+	if (data != nullptr) {
+#ifdef OS_WINDOWS
+		UnmapViewOfFile(data);
+		CloseHandle(mappingHandle);
+#else
+		munmap(const_cast<std::uint8_t *>(data), size);
+#endif
+	}
+
+	data = nullptr;
+	size = 0;
+	opened = false;
+	mappingHandle = nullptr;
+}
+
+} // namespace utils
+} // namespace retdec
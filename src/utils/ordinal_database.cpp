@@ -0,0 +1,353 @@
+/**
+* @file src/utils/ordinal_database.cpp
+* @brief Database of names of functions imported by ordinals.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <utility>
+
+#include "retdec/utils/memory_mapped_file.h"
+#include "retdec/utils/ordinal_database.h"
+#include "retdec/utils/string.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/// Magic bytes at the beginning of the file ("RORD").
+constexpr std::uint32_t MAGIC = 0x44524f52;
+/// Version of the layout.
+constexpr std::uint32_t VERSION = 1;
+/// Name offset of an empty slot.
+constexpr std::uint32_t NO_NAME = 0xffffffff;
+
+/// Words of the header.
+enum HeaderWord: std::uint32_t {
+	Magic = 0,
+	Version,
+	BucketsOffset,
+	BucketsCount,
+	SlotsOffset,
+	SlotsCount,
+	EntriesCount,
+	Count
+};
+
+/// Number of words of one slot.
+constexpr std::size_t SLOT_WORDS = 4;
+/// Average number of entries in one bucket of the perfect hash.
+constexpr std::size_t ENTRIES_PER_BUCKET = 4;
+/// Maximal number of tried displacements of one bucket.
+constexpr std::uint32_t MAX_DISPLACEMENT = 1u << 24;
+
+/**
+* @brief Returns a hash of the library @a library of architecture @a arch.
+*
+* Library names are case-insensitive and the @c .dll suffix is optional.
+*/
+std::uint64_t hashLibrary(const std::string &arch, const std::string &library) {
+	auto key = arch + "/" + toLower(library);
+	removeSuffix(key, ".dll");
+
+	// FNV-1a
+	std::uint64_t hash = 0xcbf29ce484222325ULL;
+	for (unsigned char c : key) {
+		hash = (hash ^ c) * 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+/**
+* @brief Mixes bits of @a x (finalizer of SplitMix64).
+*/
+std::uint64_t mix(std::uint64_t x) {
+	x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+	return x ^ (x >> 31);
+}
+
+/**
+* @brief Returns a hash of the key (@a libraryHash, @a ordinal) with the
+*        given seed.
+*
+* Seed @c 0 selects the bucket of the key, the displacement of the bucket
+* selects its slot.
+*/
+std::uint64_t hashKey(std::uint64_t libraryHash, std::uint32_t ordinal,
+		std::uint32_t seed) {
+	return mix(libraryHash ^ mix(ordinal + seed * 0x9e3779b97f4a7c15ULL));
+}
+
+void appendWord(std::string &out, std::uint32_t word) {
+	out.push_back(static_cast<char>(word & 0xff));
+	out.push_back(static_cast<char>((word >> 8) & 0xff));
+	out.push_back(static_cast<char>((word >> 16) & 0xff));
+	out.push_back(static_cast<char>((word >> 24) & 0xff));
+}
+
+void setWord(std::string &out, std::size_t offset, std::uint32_t word) {
+	out[offset] = static_cast<char>(word & 0xff);
+	out[offset + 1] = static_cast<char>((word >> 8) & 0xff);
+	out[offset + 2] = static_cast<char>((word >> 16) & 0xff);
+	out[offset + 3] = static_cast<char>((word >> 24) & 0xff);
+}
+
+} // anonymous namespace
+
+const std::string OrdinalDatabase::DefaultFileName = "ordinals.ordb";
+
+OrdinalDatabase::OrdinalDatabase() = default;
+
+OrdinalDatabase::~OrdinalDatabase() = default;
+
+/**
+* @brief Opens (memory-maps) the database file @a path.
+*
+* @return @c true if the file was opened and it is a valid database,
+*         @c false otherwise.
+*/
+bool OrdinalDatabase::open(const std::string &path) {
+	auto mappedFile = std::make_unique<MemoryMappedFile>(path);
+	if (!mappedFile->isOpen()
+			|| !open(mappedFile->getData(), mappedFile->getSize())) {
+		return false;
+	}
+
+	file = std::move(mappedFile);
+	return true;
+}
+
+/**
+* @brief Opens the database stored in memory.
+*
+* @return @c true if @a data are a valid database, @c false otherwise.
+*
+* @a data have to outlive the database.
+*/
+bool OrdinalDatabase::open(const std::uint8_t *data, std::size_t size) {
+	file.reset();
+	this->data = data;
+	this->size = size;
+
+	if (size < 4 * HeaderWord::Count
+			|| readWord(4 * HeaderWord::Magic) != MAGIC
+			|| readWord(4 * HeaderWord::Version) != VERSION) {
+		this->data = nullptr;
+		this->size = 0;
+		return false;
+	}
+
+	bucketsOffset = readWord(4 * HeaderWord::BucketsOffset);
+	bucketsCount = readWord(4 * HeaderWord::BucketsCount);
+	slotsOffset = readWord(4 * HeaderWord::SlotsOffset);
+	slotsCount = readWord(4 * HeaderWord::SlotsCount);
+	entriesCount = readWord(4 * HeaderWord::EntriesCount);
+
+	if (bucketsCount == 0 || slotsCount == 0
+			|| bucketsOffset + 4 * std::uint64_t(bucketsCount) > size
+			|| slotsOffset + 4 * SLOT_WORDS * std::uint64_t(slotsCount) > size) {
+		this->data = nullptr;
+		this->size = 0;
+		return false;
+	}
+
+	return true;
+}
+
+/**
+* @brief Has the database been successfully opened?
+*/
+bool OrdinalDatabase::isOpen() const {
+	return data != nullptr;
+}
+
+/**
+* @brief Returns the name of the function exported by library @a library of
+*        architecture @a arch under ordinal number @a ordinal.
+*
+* @return The name, or an empty string if the database does not contain it.
+*/
+std::string OrdinalDatabase::getName(const std::string &arch,
+		const std::string &library, std::uint64_t ordinal) const {
+	if (!isOpen() || ordinal > 0xffffffff) {
+		return std::string();
+	}
+
+	const auto libraryHash = hashLibrary(arch, library);
+	const auto ord = static_cast<std::uint32_t>(ordinal);
+	const auto bucket = hashKey(libraryHash, ord, 0) % bucketsCount;
+	const auto displacement = readWord(bucketsOffset + 4 * bucket);
+	if (displacement == 0) {
+		return std::string();
+	}
+
+	const auto slot = hashKey(libraryHash, ord, displacement) % slotsCount;
+	const std::size_t slotOffset = slotsOffset + 4 * SLOT_WORDS * slot;
+	const auto nameOffset = readWord(slotOffset + 12);
+	if (nameOffset == NO_NAME
+			|| readWord(slotOffset) != (libraryHash & 0xffffffff)
+			|| readWord(slotOffset + 4) != (libraryHash >> 32)
+			|| readWord(slotOffset + 8) != ord) {
+		return std::string();
+	}
+
+	const auto nameLength = readWord(nameOffset);
+	if (nameOffset + 4 + std::uint64_t(nameLength) > size) {
+		return std::string();
+	}
+	return std::string(reinterpret_cast<const char *>(data + nameOffset + 4),
+		nameLength);
+}
+
+/**
+* @brief Returns the number of entries in the database.
+*/
+std::size_t OrdinalDatabase::getNumberOfEntries() const {
+	return entriesCount;
+}
+
+/**
+* @brief Writes a database with the given entries into @a out.
+*
+* If there are more entries with the same architecture, library, and ordinal,
+* the last one is used.
+*
+* @return @c true if the database was written, @c false otherwise.
+*/
+bool OrdinalDatabase::write(std::ostream &out,
+		const std::vector<Entry> &entries) {
+	using Key = std::pair<std::uint64_t, std::uint32_t>;
+	std::map<Key, std::string> uniqueEntries;
+	for (const auto &entry : entries) {
+		uniqueEntries[{hashLibrary(entry.arch, entry.library), entry.ordinal}]
+			= entry.name;
+	}
+	using UniqueEntry = std::map<Key, std::string>::value_type;
+
+	// Perfect hash by hash and displace: keys are distributed into buckets
+	// and every bucket (the largest ones first) gets the first displacement
+	// that maps all its keys into free slots.
+	const auto entriesCount = uniqueEntries.size();
+	const auto bucketsCount = entriesCount / ENTRIES_PER_BUCKET + 1;
+	const auto slotsCount = entriesCount + entriesCount / 4 + 1;
+	if (slotsCount > 0xffffffff) {
+		return false;
+	}
+
+	std::vector<std::vector<const UniqueEntry *>> buckets(bucketsCount);
+	for (const auto &entry : uniqueEntries) {
+		const auto &key = entry.first;
+		buckets[hashKey(key.first, key.second, 0) % bucketsCount].push_back(&entry);
+	}
+	std::vector<std::size_t> order(bucketsCount);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+		[&buckets](std::size_t a, std::size_t b) {
+			return buckets[a].size() > buckets[b].size();
+		});
+
+	std::vector<const UniqueEntry *> slots(slotsCount, nullptr);
+	std::vector<std::uint32_t> displacements(bucketsCount, 0);
+	std::vector<std::size_t> bucketSlots;
+	for (auto bucket : order) {
+		if (buckets[bucket].empty()) {
+			break;
+		}
+
+		std::uint32_t displacement = 1;
+		for (; displacement < MAX_DISPLACEMENT; ++displacement) {
+			bucketSlots.clear();
+			for (const auto *entry : buckets[bucket]) {
+				const auto &key = entry->first;
+				auto slot = hashKey(key.first, key.second, displacement) % slotsCount;
+				if (slots[slot] != nullptr
+						|| std::find(bucketSlots.begin(), bucketSlots.end(), slot)
+							!= bucketSlots.end()) {
+					break;
+				}
+				bucketSlots.push_back(slot);
+			}
+			if (bucketSlots.size() == buckets[bucket].size()) {
+				break;
+			}
+		}
+		if (displacement == MAX_DISPLACEMENT) {
+			return false;
+		}
+
+		displacements[bucket] = displacement;
+		for (std::size_t i = 0; i < bucketSlots.size(); ++i) {
+			slots[bucketSlots[i]] = buckets[bucket][i];
+		}
+	}
+
+	std::string content;
+	appendWord(content, MAGIC);
+	appendWord(content, VERSION);
+	appendWord(content, 4 * HeaderWord::Count);
+	appendWord(content, bucketsCount);
+	appendWord(content, 4 * (HeaderWord::Count + bucketsCount));
+	appendWord(content, slotsCount);
+	appendWord(content, entriesCount);
+	for (auto displacement : displacements) {
+		appendWord(content, displacement);
+	}
+	const auto slotsOffset = content.size();
+	for (std::size_t i = 0; i < slotsCount; ++i) {
+		for (std::size_t w = 0; w < SLOT_WORDS; ++w) {
+			appendWord(content, w == SLOT_WORDS - 1 ? NO_NAME : 0);
+		}
+	}
+
+	// Names are stored after the slots, each distinct name only once.
+	std::map<std::string, std::uint32_t> nameOffsets;
+	for (std::size_t i = 0; i < slotsCount; ++i) {
+		if (slots[i] == nullptr) {
+			continue;
+		}
+
+		const auto &key = slots[i]->first;
+		const auto &name = slots[i]->second;
+		auto it = nameOffsets.find(name);
+		if (it == nameOffsets.end()) {
+			if (content.size() > 0xffffffff) {
+				return false;
+			}
+			it = nameOffsets.emplace(name, content.size()).first;
+			appendWord(content, name.size());
+			content += name;
+			content.append((4 - name.size() % 4) % 4, '\0');
+		}
+
+		const auto slotOffset = slotsOffset + 4 * SLOT_WORDS * i;
+		setWord(content, slotOffset, key.first & 0xffffffff);
+		setWord(content, slotOffset + 4, key.first >> 32);
+		setWord(content, slotOffset + 8, key.second);
+		setWord(content, slotOffset + 12, it->second);
+	}
+
+	out.write(content.data(), content.size());
+	return static_cast<bool>(out);
+}
+
+/**
+* @brief Returns little-endian word on @a offset, or @c 0 if the word is
+*        outside of the database.
+*/
+std::uint32_t OrdinalDatabase::readWord(std::size_t offset) const {
+	if (offset > size || size - offset < 4) {
+		return 0;
+	}
+
+	return static_cast<std::uint32_t>(data[offset])
+		| static_cast<std::uint32_t>(data[offset + 1]) << 8
+		| static_cast<std::uint32_t>(data[offset + 2]) << 16
+		| static_cast<std::uint32_t>(data[offset + 3]) << 24;
+}
+
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,261 @@
+/**
+* @file src/utils/pass_profiler.cpp
+* @brief Profiler of passes of the decompilation pipeline.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <cstdio>
+#include <fstream>
+
+#include "retdec/utils/memory.h"
+#include "retdec/utils/os.h"
+#include "retdec/utils/pass_profiler.h"
+
+#ifdef OS_WINDOWS
+	#include <windows.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/**
+* @brief Returns CPU time (user and system) consumed so far by this process
+*        (in µs).
+*/
+std::uint64_t getProcessCpuTimeUs() {
+#ifdef OS_WINDOWS
+	FILETIME creationTime, exitTime, kernelTime, userTime;
+	if (!GetProcessTimes(GetCurrentProcess(), &creationTime, &exitTime,
+			&kernelTime, &userTime)) {
+		return 0;
+	}
+	auto toUs = [](const FILETIME &t) {
+		// FILETIME is in 100 ns units.
+		return ((static_cast<std::uint64_t>(t.dwHighDateTime) << 32)
+			| t.dwLowDateTime) / 10;
+	};
+	return toUs(kernelTime) + toUs(userTime);
+#else
+	struct rusage usage;
+	if (getrusage(RUSAGE_SELF, &usage) != 0) {
+		return 0;
+	}
+	auto toUs = [](const struct timeval &t) {
+		return static_cast<std::uint64_t>(t.tv_sec) * 1000000 + t.tv_usec;
+	};
+	return toUs(usage.ru_utime) + toUs(usage.ru_stime);
+#endif
+}
+
+/**
+* @brief Writes @a str into @a out as a JSON string (including quotes).
+*/
+void writeJsonString(std::ostream &out, const std::string &str) {
+	out << '"';
+	for (unsigned char c : str) {
+		switch (c) {
+			case '"': out << "\\\""; break;
+			case '\\': out << "\\\\"; break;
+			case '\n': out << "\\n"; break;
+			case '\r': out << "\\r"; break;
+			case '\t': out << "\\t"; break;
+			default:
+				if (c < 0x20) {
+					char buf[8];
+					std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+					out << buf;
+				} else {
+					out << c;
+				}
+		}
+	}
+	out << '"';
+}
+
+/**
+* @brief Writes @a size into @a out as a JSON object.
+*/
+void writeJsonIrSize(std::ostream &out, const PassProfiler::IrSize &size) {
+	out << "{\"functions\": " << size.functions
+		<< ", \"blocks\": " << size.blocks
+		<< ", \"instructions\": " << size.instructions << "}";
+}
+
+/**
+* @brief Writes measurements from @a r (without the name and timestamps) into
+*        @a out as members of a JSON object.
+*/
+void writeJsonMeasurements(std::ostream &out, const PassProfiler::Record &r) {
+	out << "\"cpuUs\": " << r.cpuUs
+		<< ", \"rssBefore\": " << r.rssBefore
+		<< ", \"rssAfter\": " << r.rssAfter
+		<< ", \"peakRssDelta\": " << r.peakRssDelta
+		<< ", \"irBefore\": ";
+	writeJsonIrSize(out, r.irBefore);
+	out << ", \"irAfter\": ";
+	writeJsonIrSize(out, r.irAfter);
+}
+
+} // anonymous namespace
+
+/**
+* @brief Creates a profiler. Start times of passes are relative to the
+*        creation of the profiler.
+*/
+PassProfiler::PassProfiler():
+	creation(std::chrono::steady_clock::now()) {}
+
+/**
+* @brief Starts a pass whose IR size is not known.
+*
+* The pass has to be finished by stop().
+*/
+void PassProfiler::start(const std::string &name,
+		const std::string &category) {
+	start(name, category, IrSize());
+}
+
+/**
+* @brief Starts a pass.
+*
+* @param[in] name Name of the pass.
+* @param[in] category Category of the pass (e.g. @c "llvm" or @c "backend").
+* @param[in] irBefore Size of the IR before the pass.
+*
+* The pass has to be finished by stop().
+*/
+void PassProfiler::start(const std::string &name,
+		const std::string &category, const IrSize &irBefore) {
+	Record record;
+	record.name = name;
+	record.category = category;
+	record.depth = running.size();
+	record.rssBefore = getProcessMemoryUsage();
+	record.irBefore = irBefore;
+	records.push_back(std::move(record));
+
+	// Sample the clocks as the last thing so that the profiler itself is not
+	// measured.
+	RunningPass pass;
+	pass.recordIndex = records.size() - 1;
+	pass.peakRssBefore = getPeakProcessMemoryUsage();
+	pass.cpuStartUs = getProcessCpuTimeUs();
+	pass.wallStart = std::chrono::steady_clock::now();
+	running.push_back(pass);
+
+	records.back().startUs = std::chrono::duration_cast<
+		std::chrono::microseconds>(pass.wallStart - creation).count();
+}
+
+/**
+* @brief Stops the most recently started pass that is still running without
+*        knowing its IR size.
+*/
+void PassProfiler::stop() {
+	stop(IrSize());
+}
+
+/**
+* @brief Stops the most recently started pass that is still running.
+*
+* @param[in] irAfter Size of the IR after the pass.
+*
+* If there is no running pass, this function does nothing.
+*/
+void PassProfiler::stop(const IrSize &irAfter) {
+	auto wallEnd = std::chrono::steady_clock::now();
+	auto cpuEndUs = getProcessCpuTimeUs();
+	if (running.empty()) {
+		return;
+	}
+
+	auto pass = running.back();
+	running.pop_back();
+
+	auto &record = records[pass.recordIndex];
+	record.wallUs = std::chrono::duration_cast<std::chrono::microseconds>(
+		wallEnd - pass.wallStart).count();
+	record.cpuUs = cpuEndUs > pass.cpuStartUs ? cpuEndUs - pass.cpuStartUs : 0;
+	record.rssAfter = getProcessMemoryUsage();
+	auto peakRssAfter = getPeakProcessMemoryUsage();
+	record.peakRssDelta = peakRssAfter > pass.peakRssBefore
+		? peakRssAfter - pass.peakRssBefore : 0;
+	record.irAfter = irAfter;
+}
+
+/**
+* @brief Returns records of all passes in the order in which they were
+*        started.
+*
+* Records of passes that are still running contain only the data known at
+* their start.
+*/
+const std::vector<PassProfiler::Record> &PassProfiler::getRecords() const {
+	return records;
+}
+
+/**
+* @brief Writes the records into @a out in JSON.
+*
+* The output is a JSON object with these members:
+*  - @c passes: detailed records of all passes,
+*  - @c traceEvents: complete events (phase @c X) of all passes in the Chrome
+*    trace format, with the measurements as their arguments.
+*/
+void PassProfiler::writeJson(std::ostream &out) const {
+	out << "{\n\t\"passes\": [";
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		const auto &r = records[i];
+		out << (i == 0 ? "\n" : ",\n") << "\t\t{\"name\": ";
+		writeJsonString(out, r.name);
+		out << ", \"category\": ";
+		writeJsonString(out, r.category);
+		out << ", \"depth\": " << r.depth
+			<< ", \"startUs\": " << r.startUs
+			<< ", \"wallUs\": " << r.wallUs << ", ";
+		writeJsonMeasurements(out, r);
+		out << "}";
+	}
+	out << "\n\t],\n";
+
+	out << "\t\"traceEvents\": [";
+	for (std::size_t i = 0; i < records.size(); ++i) {
+		const auto &r = records[i];
+		out << (i == 0 ? "\n" : ",\n") << "\t\t{\"name\": ";
+		writeJsonString(out, r.name);
+		out << ", \"cat\": ";
+		writeJsonString(out, r.category);
+		out << ", \"ph\": \"X\", \"pid\": 1, \"tid\": 1"
+			<< ", \"ts\": " << r.startUs
+			<< ", \"dur\": " << r.wallUs
+			<< ", \"args\": {";
+		writeJsonMeasurements(out, r);
+		out << "}}";
+	}
+	out << "\n\t],\n";
+	out << "\t\"displayTimeUnit\": \"ms\"\n}\n";
+}
+
+/**
+* @brief Writes the records into the file with the given @a path in JSON.
+*
+* @return @c true if the file was written, @c false otherwise.
+*
+* See writeJson(std::ostream&) for the format of the file.
+*/
+bool PassProfiler::writeJson(const std::string &path) const {
+	std::ofstream out(path);
+	if (!out) {
+		return false;
+	}
+	writeJson(out);
+	out.close();
+	return static_cast<bool>(out);
+}
+
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,237 @@
+/**
+* @file src/utils/small_block_pool.cpp
+* @brief Process-wide pool of small memory blocks.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <mutex>
+#include <new>
+
+#include "retdec/utils/small_block_pool.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/// Number of size classes.
+constexpr std::size_t ClassCount =
+	SmallBlockPool::MaxBlockSize / SmallBlockPool::Alignment;
+
+/// Size of chunks from which blocks are carved (in bytes).
+constexpr std::size_t ChunkSize = 64 * 1024;
+
+/**
+* @brief A block that is not used, linked into a free list.
+*/
+struct FreeBlock {
+	FreeBlock *next;
+};
+
+/**
+* @brief A free list of blocks of a single size class.
+*/
+struct FreeList {
+	FreeBlock *head = nullptr;
+	std::size_t count = 0;
+
+	void push(FreeBlock *block) {
+		block->next = head;
+		head = block;
+		++count;
+	}
+
+	FreeBlock *pop() {
+		auto *block = head;
+		head = block->next;
+		--count;
+		return block;
+	}
+
+	/// Moves at most @a maxCount blocks from @a other to this list.
+	void takeFrom(FreeList &other, std::size_t maxCount) {
+		while (other.head != nullptr && maxCount-- > 0) {
+			push(other.pop());
+		}
+	}
+};
+
+std::size_t getSizeClass(std::size_t size) {
+	return size == 0 ? 0 : (size - 1) / SmallBlockPool::Alignment;
+}
+
+std::size_t getBlockSize(std::size_t sizeClass) {
+	return (sizeClass + 1) * SmallBlockPool::Alignment;
+}
+
+/**
+* @brief Returns the number of blocks of the given size class that are moved
+*        between threads at once.
+*/
+std::size_t getBatchCount(std::size_t sizeClass) {
+	return ChunkSize / getBlockSize(sizeClass);
+}
+
+/**
+* @brief Free blocks that do not belong to any thread.
+*/
+struct Depot {
+	std::mutex mutex;
+	FreeList freeLists[ClassCount];
+	std::size_t reservedSize = 0;
+};
+
+Depot &getDepot() {
+	// Never destroyed because blocks may be freed during the destruction of
+	// static objects.
+	static auto *depot = new Depot();
+	return *depot;
+}
+
+/**
+* @brief Moves a batch of blocks of the given size class from the depot into
+*        @a list. If there are no blocks in the depot, a new chunk is carved.
+*/
+void refill(FreeList &list, std::size_t sizeClass) {
+	auto &depot = getDepot();
+	std::lock_guard<std::mutex> lock(depot.mutex);
+
+	auto &depotList = depot.freeLists[sizeClass];
+	if (depotList.head != nullptr) {
+		list.takeFrom(depotList, getBatchCount(sizeClass));
+		return;
+	}
+
+	auto *chunk = static_cast<char *>(::operator new(ChunkSize));
+	depot.reservedSize += ChunkSize;
+	auto blockSize = getBlockSize(sizeClass);
+	for (std::size_t offset = 0; offset + blockSize <= ChunkSize;
+			offset += blockSize) {
+		list.push(reinterpret_cast<FreeBlock *>(chunk + offset));
+	}
+}
+
+/**
+* @brief Moves at most @a maxCount blocks of the given size class from
+*        @a list into the depot.
+*/
+void release(FreeList &list, std::size_t sizeClass, std::size_t maxCount) {
+	auto &depot = getDepot();
+	std::lock_guard<std::mutex> lock(depot.mutex);
+	depot.freeLists[sizeClass].takeFrom(list, maxCount);
+}
+
+/**
+* @brief Free blocks that belong to a thread.
+*/
+struct ThreadCache {
+	FreeList freeLists[ClassCount];
+
+	~ThreadCache() {
+		for (std::size_t i = 0; i < ClassCount; ++i) {
+			release(freeLists[i], i, freeLists[i].count);
+		}
+	}
+};
+
+// A trivially destructible pointer to the cache of the current thread, so that
+// it can be checked even after the cache itself has been destroyed.
+thread_local ThreadCache *threadCache = nullptr;
+thread_local bool threadCacheDestroyed = false;
+
+/**
+* @brief Returns the cache of the current thread, or @c nullptr if the thread
+*        is exiting and the cache has already been destroyed.
+*/
+ThreadCache *getThreadCache() {
+	struct Owner {
+		ThreadCache cache;
+		~Owner() {
+			threadCache = nullptr;
+			threadCacheDestroyed = true;
+		}
+	};
+
+	if (threadCache == nullptr && !threadCacheDestroyed) {
+		thread_local Owner owner;
+		threadCache = &owner.cache;
+	}
+	return threadCache;
+}
+
+} // anonymous namespace
+
+/**
+* @brief Allocates a block of at least @a size bytes.
+*
+* The block has to be freed by deallocate() with the same @a size.
+*
+* @throws std::bad_alloc When there is not enough memory.
+*/
+void *SmallBlockPool::allocate(std::size_t size) {
+	if (size > MaxBlockSize) {
+		return ::operator new(size);
+	}
+
+	auto sizeClass = getSizeClass(size);
+	if (auto *cache = getThreadCache()) {
+		auto &list = cache->freeLists[sizeClass];
+		if (list.head == nullptr) {
+			refill(list, sizeClass);
+		}
+		return list.pop();
+	}
+
+	// The thread is exiting, so there is nothing to cache the rest of the
+	// batch in.
+	FreeList list;
+	refill(list, sizeClass);
+	auto *block = list.pop();
+	release(list, sizeClass, list.count);
+	return block;
+}
+
+/**
+* @brief Frees @a block of @a size bytes allocated by allocate().
+*
+* If @a block is the null pointer, this function does nothing.
+*/
+void SmallBlockPool::deallocate(void *block, std::size_t size) noexcept {
+	if (block == nullptr) {
+		return;
+	}
+	if (size > MaxBlockSize) {
+		::operator delete(block);
+		return;
+	}
+
+	auto sizeClass = getSizeClass(size);
+	auto *freeBlock = static_cast<FreeBlock *>(block);
+	if (auto *cache = getThreadCache()) {
+		// Keep at most two batches so that blocks freed by one thread can be
+		// reused by other threads.
+		auto &list = cache->freeLists[sizeClass];
+		list.push(freeBlock);
+		if (list.count > 2 * getBatchCount(sizeClass)) {
+			release(list, sizeClass, getBatchCount(sizeClass));
+		}
+		return;
+	}
+
+	FreeList list;
+	list.push(freeBlock);
+	release(list, sizeClass, 1);
+}
+
+/**
+* @brief Returns the total size of memory reserved by the pool for blocks up
+*        to @c MaxBlockSize (in bytes).
+*/
+std::size_t SmallBlockPool::getReservedSize() {
+	auto &depot = getDepot();
+	std::lock_guard<std::mutex> lock(depot.mutex);
+	return depot.reservedSize;
+}
+
+} // namespace utils
+} // namespace retdec
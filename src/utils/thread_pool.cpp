@@ -0,0 +1,242 @@
+/**
+* @file src/utils/thread_pool.cpp
+* @brief A work-stealing pool of worker threads.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include "retdec/utils/thread_pool.h"
+
+namespace retdec {
+namespace utils {
+
+namespace {
+
+/// Pool whose worker is the current thread (if any).
+thread_local const ThreadPool *currentPool = nullptr;
+
+/// Index of the worker that is the current thread.
+thread_local std::size_t currentWorkerIndex = 0;
+
+} // anonymous namespace
+
+/**
+* @brief Creates a pool with the given number of worker threads.
+*
+* @param[in] threadCount Number of worker threads. If it is zero,
+*                        getDefaultThreadCount() threads are created.
+*/
+ThreadPool::ThreadPool(std::size_t threadCount) {
+	if (threadCount == 0) {
+		threadCount = getDefaultThreadCount();
+	}
+
+	for (std::size_t i = 0; i < threadCount; ++i) {
+		queues.push_back(std::make_unique<TaskQueue>());
+	}
+	for (std::size_t i = 0; i < threadCount; ++i) {
+		workers.emplace_back([this, i]() { workerLoop(i); });
+	}
+}
+
+/**
+* @brief Waits for all the submitted tasks and stops the workers.
+*
+* Exceptions thrown from the tasks that have not been reported by wait() are
+* ignored.
+*/
+ThreadPool::~ThreadPool() {
+	runTasksUntil([this]() { return unfinishedTasks == 0; });
+
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		stopping = true;
+	}
+	taskQueued.notify_all();
+
+	for (auto &worker : workers) {
+		worker.join();
+	}
+}
+
+/**
+* @brief Returns the number of worker threads.
+*/
+std::size_t ThreadPool::getThreadCount() const {
+	return workers.size();
+}
+
+/**
+* @brief Returns the number of threads the hardware can run concurrently.
+*
+* When it cannot be determined, @c 1 is returned.
+*/
+std::size_t ThreadPool::getDefaultThreadCount() {
+	auto count = std::thread::hardware_concurrency();
+	return count > 0 ? count : 1;
+}
+
+/**
+* @brief Schedules the given task to be run by some of the workers.
+*
+* Use wait() to wait for the completion of the submitted tasks.
+*/
+void ThreadPool::submit(Task task) {
+	auto index = getQueueIndexForCurrentThread();
+
+	{
+		// The counter has to be updated together with the push so that
+		// popTask() never sees a task that has not been counted yet.
+		std::lock_guard<std::mutex> stateLock(stateMutex);
+		{
+			std::lock_guard<std::mutex> queueLock(queues[index]->mutex);
+			queues[index]->tasks.push_back(std::move(task));
+		}
+		++queuedTasks;
+		++unfinishedTasks;
+	}
+	taskQueued.notify_one();
+}
+
+/**
+* @brief Waits until all the tasks submitted via submit() have finished.
+*
+* The calling thread helps with running the queued tasks. If some of the tasks
+* has thrown an exception, the first one of them is rethrown.
+*/
+void ThreadPool::wait() {
+	runTasksUntil([this]() { return unfinishedTasks == 0; });
+
+	std::exception_ptr error;
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		std::swap(error, firstError);
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+/**
+* @brief The main loop of the worker with the given index.
+*/
+void ThreadPool::workerLoop(std::size_t index) {
+	currentPool = this;
+	currentWorkerIndex = index;
+
+	while (true) {
+		Task task;
+		if (popTask(index, task)) {
+			runTask(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(stateMutex);
+		taskQueued.wait(lock, [this]() { return stopping || queuedTasks > 0; });
+		if (stopping && queuedTasks == 0) {
+			return;
+		}
+	}
+}
+
+/**
+* @brief Takes a task from the queue with the given index or steals one from
+*        the other queues.
+*
+* @return @c true if a task has been stored into @a task, @c false otherwise.
+*/
+bool ThreadPool::popTask(std::size_t index, Task &task) {
+	for (std::size_t i = 0, e = queues.size(); i < e; ++i) {
+		auto &queue = *queues[(index + i) % e];
+		std::unique_lock<std::mutex> queueLock(queue.mutex, std::try_to_lock);
+		if (!queueLock.owns_lock() && i == 0) {
+			// Our own queue is worth waiting for.
+			queueLock.lock();
+		}
+		if (!queueLock.owns_lock() || queue.tasks.empty()) {
+			continue;
+		}
+
+		// Take the oldest task from our own queue, the newest one from the
+		// queues of the others.
+		if (i == 0) {
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+		} else {
+			task = std::move(queue.tasks.back());
+			queue.tasks.pop_back();
+		}
+		queueLock.unlock();
+
+		std::lock_guard<std::mutex> stateLock(stateMutex);
+		--queuedTasks;
+		return true;
+	}
+	return false;
+}
+
+/**
+* @brief Runs the given task and records its completion.
+*/
+void ThreadPool::runTask(Task &task) {
+	std::exception_ptr error;
+	try {
+		task();
+	} catch (...) {
+		error = std::current_exception();
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(stateMutex);
+		if (error && !firstError) {
+			firstError = error;
+		}
+		--unfinishedTasks;
+	}
+	taskFinished.notify_all();
+}
+
+/**
+* @brief Runs the queued tasks in the calling thread until @a done returns
+*        @c true.
+*
+* @a done is always called with @c stateMutex locked.
+*/
+void ThreadPool::runTasksUntil(const std::function<bool ()> &done) {
+	auto index = getQueueIndexForCurrentThread();
+
+	while (true) {
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+			if (done()) {
+				return;
+			}
+		}
+
+		Task task;
+		if (popTask(index, task)) {
+			runTask(task);
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(stateMutex);
+		taskFinished.wait(lock, [this, &done]() {
+			return done() || queuedTasks > 0;
+		});
+	}
+}
+
+/**
+* @brief Returns the index of the queue that the current thread should use.
+*
+* Workers use their own queues, other threads spread their tasks among all
+* the queues.
+*/
+std::size_t ThreadPool::getQueueIndexForCurrentThread() {
+	if (currentPool == this) {
+		return currentWorkerIndex;
+	}
+	return nextQueue++ % queues.size();
+}
+
+} // namespace utils
+} // namespace retdec
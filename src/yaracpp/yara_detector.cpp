@@ -4,10 +4,19 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+
 #include <yara.h>
 #include <yara/compiler.h>
 #include <yara/types.h>
 
+#include "retdec/utils/filesystem.h"
 #include "retdec/yaracpp/yara_detector.h"
 
 namespace retdec {
@@ -15,6 +24,29 @@ namespace yaracpp {
 
 namespace {
 
+/**
+ * Returns the mutex that guards initialization and finalization of YARA.
+ * YARA counts how many times it was initialized, but the counter is not
+ * thread-safe, so detectors created in several threads need to be serialized.
+ */
+std::mutex& getYaraInitMutex()
+{
+	static std::mutex mutex;
+	return mutex;
+}
+
+bool initializeYara()
+{
+	std::lock_guard<std::mutex> lock(getYaraInitMutex());
+	return yr_initialize() == ERROR_SUCCESS;
+}
+
+void finalizeYara()
+{
+	std::lock_guard<std::mutex> lock(getYaraInitMutex());
+	yr_finalize();
+}
+
 /**
  * Interface for YARA scanning interface. Uses template specialization
  * to decide whether to scan file or memory buffer.
@@ -67,6 +99,38 @@ struct Scanner<std::vector<std::uint8_t>>
 	}
 };
 
+/**
+ * Contiguous block of memory owned by somebody else.
+ */
+struct MemoryBlock
+{
+	const std::uint8_t* data;
+	std::size_t size;
+};
+
+/**
+ * Specialization for scanning memory blocks without copying them.
+ */
+template <>
+struct Scanner<MemoryBlock>
+{
+	static bool scan(
+			YR_RULES* rules,
+			YR_CALLBACK_FUNC callback,
+			YaraDetector::CallbackSettings& settings,
+			const MemoryBlock& block)
+	{
+		return yr_rules_scan_mem(
+				rules,
+				const_cast<uint8_t*>(block.data),
+				block.size,
+				0,
+				callback,
+				&settings, 0
+		) == ERROR_SUCCESS;
+	}
+};
+
 /**
  * Interface for Scanner. Provides template type deduction and
  * always passes correct type into Scanner template.
@@ -86,6 +150,507 @@ bool scan(
 	);
 }
 
+/**
+ * Registry of compiled rules shared by all instances of @c YaraDetector in
+ * the process. Rules are identified by ordered paths, content hashes and
+ * namespaces of rule files which they were compiled from.
+ *
+ * At most @c Capacity sets of rules are kept. When there are more, the least
+ * recently used ones are released. Released rules stay alive as long as some
+ * detector uses them.
+ */
+class RulesRegistry
+{
+	public:
+		static RulesRegistry& get()
+		{
+			static RulesRegistry registry;
+			return registry;
+		}
+
+		std::shared_ptr<YR_RULES> find(const std::string& key)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			auto it = rules.find(key);
+			if (it == rules.end())
+				return nullptr;
+
+			it->second.lastUse = ++uses;
+			return it->second.rules;
+		}
+
+		/**
+		 * Insert @a newRules into registry. If other rules with the same key
+		 * were inserted in the meantime, @a newRules are destroyed and the
+		 * rules from registry are returned instead.
+		 */
+		std::shared_ptr<YR_RULES> insert(
+				const std::string& key,
+				YR_RULES* newRules)
+		{
+			std::shared_ptr<YR_RULES> ptr(newRules, yr_rules_destroy);
+			std::lock_guard<std::mutex> lock(mutex);
+			auto& entry = rules.emplace(key, Entry{ptr, 0}).first->second;
+			entry.lastUse = ++uses;
+			ptr = entry.rules;
+
+			if (rules.size() > Capacity)
+			{
+				auto leastUsed = std::min_element(rules.begin(), rules.end(),
+						[](const auto& a, const auto& b) {
+							return a.second.lastUse < b.second.lastUse;
+						});
+				rules.erase(leastUsed);
+			}
+			return ptr;
+		}
+
+		void release()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			rules.clear();
+		}
+
+		void setCacheDirectory(const std::string& directory)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			cacheDirectory = directory;
+		}
+
+		std::string getCacheDirectory()
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			return cacheDirectory;
+		}
+
+	private:
+		/// Maximal number of registered sets of rules.
+		static const std::size_t Capacity = 16;
+
+		struct Entry
+		{
+			std::shared_ptr<YR_RULES> rules;
+			std::uint64_t lastUse;
+		};
+
+		// Registered rules may outlive all detectors, so keep YARA
+		// initialized as long as the registry exists.
+		RulesRegistry()
+		{
+			initialized = initializeYara();
+		}
+
+		~RulesRegistry()
+		{
+			rules.clear();
+			if (initialized)
+				finalizeYara();
+		}
+
+		std::mutex mutex;
+		bool initialized = false;
+		std::string cacheDirectory;
+		std::uint64_t uses = 0;
+		std::unordered_map<std::string, Entry> rules;
+};
+
+/**
+ * Update 64-bit FNV-1a @a hash by @a data.
+ */
+std::uint64_t updateHash(std::uint64_t hash, const std::string& data)
+{
+	for (auto c : data)
+	{
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 0x100000001b3ULL;
+	}
+	return hash;
+}
+
+/**
+ * Return @a hash as hexadecimal string.
+ */
+std::string toHex(std::uint64_t hash)
+{
+	std::string result(16, '0');
+	for (std::size_t i = 0; i < result.size(); ++i, hash >>= 4)
+	{
+		result[result.size() - i - 1] = "0123456789abcdef"[hash & 0xF];
+	}
+	return result;
+}
+
+/**
+ * Compute 64-bit FNV-1a hash of @a data and return it as hexadecimal string.
+ */
+std::string hashToHex(const std::string& data)
+{
+	return toHex(updateHash(0xcbf29ce484222325ULL, data));
+}
+
+/**
+ * Read the whole file @a pathToFile into @a content.
+ * @return @c true if the file was read, @c false otherwise.
+ */
+bool readFile(const std::string& pathToFile, std::string& content)
+{
+	std::ifstream file(pathToFile, std::ios::binary);
+	if (!file)
+		return false;
+
+	content.assign(
+			std::istreambuf_iterator<char>(file),
+			std::istreambuf_iterator<char>());
+	return !file.bad();
+}
+
+/**
+ * Get paths from include directives of text rules @a content.
+ */
+std::vector<std::string> getIncludes(const std::string& content)
+{
+	std::vector<std::string> includes;
+	std::size_t lineStart = 0;
+	while (lineStart < content.size())
+	{
+		const auto first = content.find_first_not_of(" \t", lineStart);
+		if (first != std::string::npos
+				&& content.compare(first, 7, "include") == 0)
+		{
+			const auto begin = content.find('"', first);
+			const auto end = begin == std::string::npos
+					? std::string::npos
+					: content.find('"', begin + 1);
+			const auto lineEnd = content.find('\n', first);
+			if (end != std::string::npos && end < lineEnd)
+				includes.push_back(content.substr(begin + 1, end - begin - 1));
+		}
+
+		lineStart = content.find('\n', lineStart);
+		if (lineStart == std::string::npos)
+			break;
+		++lineStart;
+	}
+
+	return includes;
+}
+
+/**
+ * Add text rules @a content and the content of all the files they include
+ * (recursively) into @a hash.
+ * @param hash Hash to update
+ * @param content Text rules
+ * @param directory Directory against which relative includes are resolved
+ * @param visited Canonical paths of files which are already hashed
+ */
+std::uint64_t hashWithIncludes(
+		std::uint64_t hash,
+		const std::string& content,
+		const fs::path& directory,
+		std::set<std::string>& visited)
+{
+	hash = updateHash(hash, content);
+	for (const auto& include : getIncludes(content))
+	{
+		auto path = fs::path(include);
+		if (path.is_relative())
+			path = directory / path;
+
+		std::error_code ec;
+		const auto canonical = fs::weakly_canonical(path, ec);
+		const auto key = ec ? path.string() : canonical.string();
+		hash = updateHash(hash, std::string(1, '\0') + include + '\0');
+		if (!visited.insert(key).second)
+			continue;
+
+		std::string includedContent;
+		if (!readFile(key, includedContent))
+		{
+			hash = updateHash(hash, "missing");
+			continue;
+		}
+		hash = hashWithIncludes(hash, includedContent, path.parent_path(), visited);
+	}
+	return hash;
+}
+
+/**
+ * Get key of text rules @a content which changes whenever the rules or any
+ * of the files they include change.
+ * @param content Text rules
+ * @param directory Directory against which relative includes are resolved
+ */
+std::string getContentKey(const std::string& content, const fs::path& directory)
+{
+	std::set<std::string> visited;
+	return toHex(hashWithIncludes(
+			0xcbf29ce484222325ULL,
+			content,
+			directory,
+			visited));
+}
+
+/**
+ * Check whether @a content of a rule file starts with the magic of
+ * precompiled rules.
+ */
+bool isPrecompiledRules(const std::string& content)
+{
+	return content.compare(0, 4, "YARA") == 0;
+}
+
+/// Name of the file with rules of all the precompiled rule files in its
+/// directory, each in the namespace named after its rule file (created by
+/// @c support/install-yara.py).
+const char* MergedRulesFileName = "merged.yaracm";
+
+/**
+ * Get compiled rules from precompiled rule file @a pathToFile with the given
+ * @a content. The rules are looked up in the registry at first.
+ * @return Compiled rules or @c nullptr if they cannot be loaded.
+ */
+std::shared_ptr<YR_RULES> loadPrecompiledRules(
+		const std::string& pathToFile,
+		const std::string& content)
+{
+	auto& registry = RulesRegistry::get();
+	const auto key = "precompiled" + pathToFile + '\0' + hashToHex(content);
+	if (auto rules = registry.find(key))
+		return rules;
+
+	YR_RULES* loaded = nullptr;
+	if (yr_rules_load(pathToFile.c_str(), &loaded) != ERROR_SUCCESS)
+		return nullptr;
+
+	return registry.insert(key, loaded);
+}
+
+/**
+ * Merged rules of precompiled rule files in a directory
+ */
+struct MergedRules
+{
+	/// compiled rules or @c nullptr if there are no merged rules
+	std::shared_ptr<YR_RULES> rules;
+	/// namespaces of the rules
+	std::set<std::string> namespaces;
+	/// last modification time of the merged rule file
+	fs::file_time_type time;
+	/// namespaces of selected rule files and paths to these files
+	std::unordered_map<std::string, std::string> selected;
+};
+
+/**
+ * Load merged rules of precompiled rule files in @a directory.
+ * @return Merged rules without any rules if there is no merged rule file.
+ */
+MergedRules loadMergedRules(const fs::path& directory)
+{
+	MergedRules merged;
+	const auto pathToFile = (directory / MergedRulesFileName).string();
+	std::error_code ec;
+	merged.time = fs::last_write_time(pathToFile, ec);
+	std::string content;
+	if (ec || !readFile(pathToFile, content) || !isPrecompiledRules(content))
+		return merged;
+
+	merged.rules = loadPrecompiledRules(pathToFile, content);
+	if (merged.rules)
+	{
+		const YR_RULE* rule;
+		yr_rules_foreach(merged.rules.get(), rule)
+		{
+			if (rule->ns && rule->ns->name)
+				merged.namespaces.insert(rule->ns->name);
+		}
+	}
+	return merged;
+}
+
+/**
+ * Add text rules from @a source into @a compiler.
+ * @return @c true if the rules were added, @c false otherwise.
+ */
+bool addToCompiler(YR_COMPILER* compiler, const YaraDetector::TextRules& source)
+{
+	const char* ns = source.nameSpace.empty()
+			? nullptr
+			: source.nameSpace.c_str();
+	if (source.pathToFile.empty())
+		return yr_compiler_add_string(compiler, source.content.c_str(), ns) == 0;
+
+	auto file = fopen(source.pathToFile.c_str(), "r");
+	if (!file)
+		return false;
+
+	// File name makes relative includes resolved against directory of the file
+	const auto errors = yr_compiler_add_file(
+			compiler,
+			file,
+			ns,
+			source.pathToFile.c_str()
+	);
+	fclose(file);
+	return errors == 0;
+}
+
+/**
+ * Compile text rules from @a sources into one set of rules. Sources which
+ * cannot be compiled are left out, so an error in one rule file does not
+ * affect the others.
+ * @param sources Sources of rules in order in which they are compiled
+ * @return Compiled rules or @c nullptr if compilation failed.
+ */
+YR_RULES* compileTextRules(const std::vector<YaraDetector::TextRules>& sources)
+{
+	std::vector<const YaraDetector::TextRules*> compiled;
+	YR_COMPILER* compiler = nullptr;
+	for (const auto& source : sources)
+	{
+		// Compiler cannot be used anymore after the first error, so a new one
+		// gets all the sources compiled so far
+		if (!compiler)
+		{
+			if (yr_compiler_create(&compiler) != ERROR_SUCCESS)
+				return nullptr;
+
+			for (const auto* previous : compiled)
+			{
+				if (!addToCompiler(compiler, *previous))
+				{
+					yr_compiler_destroy(compiler);
+					return nullptr;
+				}
+			}
+		}
+
+		if (addToCompiler(compiler, source))
+		{
+			compiled.push_back(&source);
+		}
+		else
+		{
+			yr_compiler_destroy(compiler);
+			compiler = nullptr;
+		}
+	}
+
+	if (compiled.empty())
+	{
+		if (compiler)
+			yr_compiler_destroy(compiler);
+		return nullptr;
+	}
+
+	if (!compiler)
+	{
+		if (yr_compiler_create(&compiler) != ERROR_SUCCESS)
+			return nullptr;
+
+		for (const auto* previous : compiled)
+		{
+			if (!addToCompiler(compiler, *previous))
+			{
+				yr_compiler_destroy(compiler);
+				return nullptr;
+			}
+		}
+	}
+
+	YR_RULES* rules = nullptr;
+	if (yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
+		rules = nullptr;
+	yr_compiler_destroy(compiler);
+	return rules;
+}
+
+/**
+ * Store compiled @a rules into file @a pathToCache. The rules are stored into
+ * a temporary file first, so other processes never load partially written
+ * rules.
+ */
+void saveCachedRules(YR_RULES* rules, const std::string& pathToCache)
+{
+	std::error_code ec;
+	const fs::path cachePath(pathToCache);
+	fs::create_directories(cachePath.parent_path(), ec);
+
+	const auto tmpPath = pathToCache + "." + std::to_string(std::random_device{}());
+	if (yr_rules_save(rules, tmpPath.c_str()) != ERROR_SUCCESS)
+	{
+		fs::remove(tmpPath, ec);
+		return;
+	}
+
+	fs::rename(tmpPath, cachePath, ec);
+	if (ec)
+		fs::remove(tmpPath, ec);
+}
+
+/**
+ * Get compiled rules from @a sources identified by @a key. The rules are
+ * looked up in the registry and in the persistent cache at first and they are
+ * compiled only if they are not found there.
+ * @return Compiled rules or @c nullptr if compilation failed.
+ *
+ * The key covers the contents of the sources and of all the files they
+ * include, so the rules found in the persistent cache can be used without
+ * compiling the sources.
+ */
+std::shared_ptr<YR_RULES> getCompiledTextRules(
+		const std::string& key,
+		const std::vector<YaraDetector::TextRules>& sources)
+{
+	auto& registry = RulesRegistry::get();
+	if (auto rules = registry.find(key))
+		return rules;
+
+	const auto cacheDirectory = registry.getCacheDirectory();
+	const auto pathToCache = cacheDirectory.empty()
+			? std::string()
+			: (fs::path(cacheDirectory) / (hashToHex(key) + ".yarac")).string();
+	YR_RULES* rules = nullptr;
+	if (!pathToCache.empty()
+			&& yr_rules_load(pathToCache.c_str(), &rules) != ERROR_SUCCESS)
+		rules = nullptr;
+
+	if (!rules)
+	{
+		rules = compileTextRules(sources);
+		if (!rules)
+			return nullptr;
+
+		if (!pathToCache.empty())
+			saveCachedRules(rules, pathToCache);
+	}
+
+	return registry.insert(key, rules);
+}
+
+/**
+ * Get paths to rule files from @a sources of namespaces which are used only
+ * by a single rule file.
+ */
+std::unordered_map<std::string, std::string> getNamespaceFiles(
+		const std::vector<YaraDetector::TextRules>& sources)
+{
+	std::unordered_map<std::string, std::string> files;
+	std::unordered_map<std::string, std::size_t> counts;
+	for (const auto& source : sources)
+	{
+		// Rules without namespace are in the default namespace
+		const auto ns = source.nameSpace.empty()
+				? std::string("default")
+				: source.nameSpace;
+		if (++counts[ns] == 1 && !source.pathToFile.empty())
+			files[ns] = source.pathToFile;
+		else
+			files.erase(ns);
+	}
+
+	return files;
+}
+
 } // anonymous namespace
 
 /**
@@ -93,7 +658,7 @@ bool scan(
  */
 YaraDetector::YaraDetector()
 {
-	stateIsValid = ((yr_initialize() == ERROR_SUCCESS)
+	stateIsValid = (initializeYara()
 			&& (yr_compiler_create(&compiler) == ERROR_SUCCESS));
 	std::uint32_t max_match_data = 65536;
 	yr_set_configuration(YR_CONFIG_MAX_MATCH_DATA, &max_match_data);
@@ -104,13 +669,6 @@ YaraDetector::YaraDetector()
  */
 YaraDetector::~YaraDetector()
 {
-	for (auto* file : files)
-	{
-		if (file)
-			fclose(file);
-	}
-
-	files.clear();
 	detectedRules.clear();
 	undetectedRules.clear();
 
@@ -119,16 +677,10 @@ YaraDetector::~YaraDetector()
 		yr_compiler_destroy(compiler);
 	}
 
-	if (textFilesRules)
-		yr_rules_destroy(textFilesRules);
+	textRules.reset();
+	precompiledRules.clear();
 
-	for (auto* rules : precompiledRules)
-	{
-		if (rules)
-			yr_rules_destroy(rules);
-	}
-
-	yr_finalize();
+	finalizeYara();
 }
 
 /**
@@ -176,6 +728,63 @@ bool YaraDetector::CallbackSettings::storeAllRules() const
 	return storeAll;
 }
 
+/**
+ * Set rule file of rules which are going to be scanned
+ * @param pathToFile Path to rule file
+ * @param namespacesToFiles Paths to rule files of rules in the given
+ *                          namespaces, which take precedence over
+ *                          @a pathToFile
+ * @param onlyNamespacesToFiles If this parameter is set to @c true, only
+ *                              rules in namespaces from @a namespacesToFiles
+ *                              are reported
+ */
+void YaraDetector::CallbackSettings::setRuleFile(
+		const std::string &pathToFile,
+		const std::unordered_map<std::string, std::string> *namespacesToFiles,
+		bool onlyNamespacesToFiles)
+{
+	ruleFile = pathToFile;
+	namespaceFiles = namespacesToFiles;
+	onlyNamespaceFiles = onlyNamespacesToFiles;
+}
+
+/**
+ * Get path to rule file of scanned rule
+ * @param rule Scanned rule
+ * @return Path to rule file or empty string if rule was added as string
+ */
+std::string YaraDetector::CallbackSettings::getRuleFile(
+		const YR_RULE *rule) const
+{
+	if (namespaceFiles && rule->ns && rule->ns->name)
+	{
+		auto it = namespaceFiles->find(rule->ns->name);
+		if (it != namespaceFiles->end())
+		{
+			return it->second;
+		}
+	}
+
+	return ruleFile;
+}
+
+/**
+ * Check if scanned rule is reported
+ * @param rule Scanned rule
+ * @return @c true if rule is reported, @c false if it is from a rule file
+ *    which was not selected
+ */
+bool YaraDetector::CallbackSettings::isReported(const YR_RULE *rule) const
+{
+	if (!onlyNamespaceFiles)
+	{
+		return true;
+	}
+
+	return namespaceFiles && rule->ns && rule->ns->name
+			&& namespaceFiles->count(rule->ns->name);
+}
+
 /**
  * Callback function for scanning of input file
  * @param context YARA context
@@ -223,9 +832,14 @@ int YaraDetector::yaraCallback(
 	{
 		return CALLBACK_ERROR;
 	}
+	else if(!settings->isReported(actRule))
+	{
+		return CALLBACK_CONTINUE;
+	}
 
 	YaraRule actual;
 	actual.setName(actRule->identifier);
+	actual.setRuleFile(settings->getRuleFile(actRule));
 	YR_META *meta;
 	yr_rule_metas_foreach(actRule, meta)
 	{
@@ -277,16 +891,59 @@ int YaraDetector::yaraCallback(
 	return CALLBACK_CONTINUE;
 }
 
+/**
+ * Set directory in which compiled rules from text rule files are cached
+ * @param directory Path to the directory. If empty, compiled rules are
+ *                  cached only in memory of the current process.
+ *
+ * Compiled rules are stored as @c .yarac files named after a hash of
+ * ordered paths, contents and namespaces of the rule files and contents of
+ * the files they include, so they can be reused by other processes.
+ */
+void YaraDetector::setCacheDirectory(const std::string &directory)
+{
+	RulesRegistry::get().setCacheDirectory(directory);
+}
+
+/**
+ * Get directory in which compiled rules from text rule files are cached
+ * @return Path to the directory or empty string if there is no such directory
+ */
+std::string YaraDetector::getCacheDirectory()
+{
+	return RulesRegistry::get().getCacheDirectory();
+}
+
+/**
+ * Release compiled rules kept in memory of the process
+ *
+ * Rules used by existing instances are released when the last of them is
+ * destroyed. Rules added to instances created later are loaded from the
+ * cache directory or compiled again.
+ */
+void YaraDetector::releaseCompiledRules()
+{
+	RulesRegistry::get().release();
+}
+
 /**
  * Add text rules to compiler
  * @param string YARA rules to add
  */
 bool YaraDetector::addRules(const char *string)
 {
-	const auto result = yr_compiler_add_string(compiler, string, nullptr);
+	// Rules are checked immediately, but they are compiled together with
+	// text rule files later
+	if (yr_compiler_add_string(compiler, string, nullptr) != 0)
+		return false;
 
-	needsRecompilation = (result == 0);
-	return needsRecompilation;
+	const std::string content(string);
+	addTextRules(
+			{std::string(), std::string(), content},
+			// Relative includes are resolved against the current directory
+			"string" + getContentKey(content, fs::path())
+	);
+	return true;
 }
 
 /**
@@ -296,36 +953,115 @@ bool YaraDetector::addRules(const char *string)
  *                  already compiled, this has no effect. If it is a text file,
  *                  this allows to have multiple rules with the same ID across
  *                  multiple rule files.
+ * @return @c false if the file does not exist, @c true otherwise
+ *
+ * All the text rule files and rules added as strings are compiled together
+ * when analyze() is called for the first time, so the input is scanned only
+ * once for all of them. Rules from a file which cannot be compiled are left
+ * out. Compiled rules are shared by all instances in the process (see
+ * releaseCompiledRules()) and they are cached in the cache directory (see
+ * setCacheDirectory()) under a key made of paths and hashes of contents of the
+ * rule files and of all the files they include, so the rule files are read,
+ * but not compiled, if the compiled rules are found.
+ *
+ * Precompiled files cannot be merged and they are scanned separately (see
+ * addRuleFiles() for files with rules merged at installation).
  */
 bool YaraDetector::addRuleFile(
 		const std::string &pathToFile,
 		const std::string &nameSpace)
 {
-	// AT first, try to load the files as precompiled file
-	YR_RULES* rules = nullptr;
-	if (yr_rules_load(pathToFile.c_str(), &rules) == ERROR_SUCCESS)
+	std::string content;
+	if (!readFile(pathToFile, content))
+		return false;
+
+	// At first, try to load the file as precompiled file
+	if (isPrecompiledRules(content))
 	{
-		precompiledRules.push_back(rules);
+		if (auto rules = loadPrecompiledRules(pathToFile, content))
+		{
+			precompiledRules.push_back({rules, pathToFile, {}});
+			return true;
+		}
 	}
-	// If we didn't succeeded consider it as text file
-	else
-	{
-		auto file = fopen(pathToFile.c_str(), "r");
-		if (!file)
-			return false;
 
-		const char* ns = nameSpace.empty() ? nullptr : nameSpace.c_str();
-		if (yr_compiler_add_file(compiler, file, ns, nullptr) != 0)
+	// If we didn't succeed, consider it as text file
+	addTextRules(
+			{pathToFile, nameSpace, std::string()},
+			"file" + pathToFile + '\0'
+					+ getContentKey(content, fs::path(pathToFile).parent_path())
+	);
+	return true;
+}
+
+/**
+ * Add external files with rules which are scanned together
+ * @param pathsToFiles Paths to rule files
+ * @return @c true if all the files were added, @c false otherwise
+ *
+ * Each text rule file gets its own namespace named after its path, so
+ * YaraRule::getRuleFile() reports from which file a rule comes. See
+ * addRuleFile() for details.
+ *
+ * Precompiled rule files (@c .yarac) in a directory with merged rules of all
+ * of them (@c merged.yaracm, each file in the namespace named after its file
+ * name) are not loaded one by one. The merged rules are loaded instead and
+ * the input is scanned only once for all the selected files of the directory.
+ * Only rules from the selected files are reported. The merged rules are used
+ * only if they are newer than the selected files and contain all of them.
+ */
+bool YaraDetector::addRuleFiles(const std::vector<std::string> &pathsToFiles)
+{
+	std::map<fs::path, MergedRules> mergedRules;
+	auto result = true;
+	for (const auto& pathToFile : pathsToFiles)
+	{
+		const fs::path path(pathToFile);
+		if (path.extension() == ".yarac")
 		{
-			fclose(file);
-			return false;
+			const auto directory = path.parent_path();
+			auto it = mergedRules.find(directory);
+			if (it == mergedRules.end())
+				it = mergedRules.emplace(directory, loadMergedRules(directory)).first;
+
+			auto& merged = it->second;
+			const auto nameSpace = path.filename().string();
+			std::error_code ec;
+			const auto time = fs::last_write_time(path, ec);
+			if (merged.rules && !ec && time <= merged.time
+					&& merged.namespaces.count(nameSpace))
+			{
+				merged.selected.emplace(nameSpace, pathToFile);
+				continue;
+			}
 		}
 
-		files.push_back(file);
-		needsRecompilation = true;
+		result = addRuleFile(pathToFile, pathToFile) && result;
 	}
 
-	return true;
+	for (auto& item : mergedRules)
+	{
+		auto& merged = item.second;
+		if (!merged.selected.empty())
+		{
+			precompiledRules.push_back(
+					{merged.rules, std::string(), std::move(merged.selected)});
+		}
+	}
+
+	return result;
+}
+
+/**
+ * Add text rules which are compiled together with the other text rules
+ * @param source Text rules to add
+ * @param key Key which changes whenever the rules change
+ */
+void YaraDetector::addTextRules(TextRules &&source, const std::string &key)
+{
+	textSourcesKey += key + '\0' + source.nameSpace + '\n';
+	textSources.push_back(std::move(source));
+	needsRecompilation = true;
 }
 
 /**
@@ -363,6 +1099,25 @@ bool YaraDetector::analyze(std::vector<std::uint8_t> &bytes, bool storeAllRules)
 	return analyzeWithScan(bytes, storeAllRules);
 }
 
+/**
+ * Analyze input bytes in place
+ * @param data Pointer to input bytes
+ * @param size Number of input bytes
+ * @param storeAllRules If this parameter is set to @c true,
+ *                      store all rules (not only detected)
+ * @return @c true if analysis completed without any error, otherwise @c false.
+ *
+ * Unlike the vector overload, this one does not require the bytes to be
+ * copied, so it can be used e.g. for memory-mapped files.
+ */
+bool YaraDetector::analyze(
+		const std::uint8_t *data,
+		std::size_t size,
+		bool storeAllRules)
+{
+	return analyzeWithScan(MemoryBlock{data, size}, storeAllRules);
+}
+
 /**
  * Get detected rules
  * @return Detected rules
@@ -397,16 +1152,25 @@ bool YaraDetector::analyzeWithScan(T&& value, bool storeAllRules)
 			undetectedRules
 	);
 
-	auto rules = getCompiledRules();
-	if (!(rules))
-		return false;
+	if (!textSources.empty())
+	{
+		auto rules = getCompiledRules();
+		if (!(rules))
+			return false;
 
-	if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
-		return false;
+		settings.setRuleFile(std::string(), &namespaceFiles);
+		if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
+			return false;
+	}
 
-	for (auto* rules : precompiledRules)
+	for (const auto& rules : precompiledRules)
 	{
-		if (!scan(rules, yaraCallback, settings, std::forward<T>(value)))
+		settings.setRuleFile(
+				rules.pathToFile,
+				&rules.namespaceFiles,
+				rules.pathToFile.empty()
+		);
+		if (!scan(rules.rules.get(), yaraCallback, settings, std::forward<T>(value)))
 			return false;
 	}
 
@@ -414,30 +1178,23 @@ bool YaraDetector::analyzeWithScan(T&& value, bool storeAllRules)
 }
 
 /**
- * Returns the compiled rules from text files.
+ * Returns the compiled text rules.
  * @return Compiled rules.
  */
 YR_RULES* YaraDetector::getCompiledRules()
 {
-	// File is text file and needs to be compiled first
-	// All text files are compiled into single YR_RULES structure and
-	// we shouldn't compile it twice if it's not needed
-	// analyze() called for the first time or the file was added since the
+	// All text rules are compiled into single YR_RULES structure and we
+	// shouldn't compile it twice if it's not needed
+	// analyze() called for the first time or the rules were added since the
 	// last analyze() call
 	if (needsRecompilation)
 	{
-		YR_RULES* rules = nullptr;
-		if (yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
-			return nullptr;
-
-		if (textFilesRules)
-			yr_rules_destroy(textFilesRules);
-
-		textFilesRules = rules;
+		textRules = getCompiledTextRules(textSourcesKey, textSources);
+		namespaceFiles = getNamespaceFiles(textSources);
 		needsRecompilation = false;
 	}
 
-	return textFilesRules;
+	return textRules.get();
 }
 
 } // namespace yaracpp
@@ -20,6 +20,15 @@ const std::string &YaraRule::getName() const
 	return name;
 }
 
+/**
+ * Get path to rule file from which this rule was loaded
+ * @return Path to rule file or empty string if rule was added as string
+ */
+const std::string &YaraRule::getRuleFile() const
+{
+	return ruleFile;
+}
+
 /**
  * Get selected meta related to this rule
  * @param id Name of selected meta
@@ -135,6 +144,15 @@ void YaraRule::setName(const std::string &ruleName)
 	name = ruleName;
 }
 
+/**
+ * Set path to rule file from which this rule was loaded
+ * @param pathToFile Path to rule file
+ */
+void YaraRule::setRuleFile(const std::string &pathToFile)
+{
+	ruleFile = pathToFile;
+}
+
 /**
  * Add meta
  * @param meta Meta related to this rule
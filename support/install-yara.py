@@ -61,10 +61,16 @@ def copy_yara_patterns(yara_patterns_dir, install_dir):
                 shutil.copy(input, output)
 
 
+# Name of the file with rules of all the *.yarac files in a directory, each in
+# the namespace named after its *.yarac file. Its suffix differs from the
+# suffixes of rule files, so it is not picked up as another rule file (see
+# retdec::yaracpp::YaraDetector::addRuleFiles()).
+MERGED_RULES_FILE = 'merged.yaracm'
+
+
 def compile_yara_file(input_file, yarac, install_dir, stdout_lock):
     """ Compile the given .yara file in the given installation directory using
     the provided YARAC program into a *.yarac file.
-    Remove the source *.yara file.
     """
     with stdout_lock:
         print('-- Compiling:', input_file)
@@ -76,12 +82,58 @@ def compile_yara_file(input_file, yarac, install_dir, stdout_lock):
         print('Error: yarac failed during compilation of file', input_file, file=sys.stderr)
         sys.exit(1)
 
-    os.remove(input_file)
+
+def get_merged_sources(directory, install_dir, yara_patterns_dir):
+    """ Get sources of all the *.yarac files in the given directory of the
+    installation directory, or None if some of them is not available.
+    Sources of files compiled by a previous installation are taken from the
+    source YARA patterns directory.
+    """
+    patterns_dir = os.path.join(install_dir, 'generic', 'yara_patterns')
+    sources = []
+    for filename in sorted(fnmatch.filter(os.listdir(directory), '*.yarac')):
+        source = str(pathlib.Path(directory, filename).with_suffix('.yara'))
+        if not os.path.isfile(source):
+            source = os.path.join(
+                yara_patterns_dir,
+                os.path.relpath(source, patterns_dir)
+            )
+        if not os.path.isfile(source):
+            return None
+        sources.append((filename, source))
+    return sources
+
+
+def merge_yara_files(directory, yarac, install_dir, yara_patterns_dir, stdout_lock):
+    """ Compile all the *.yarac files in the given directory into one file
+    (MERGED_RULES_FILE) from their sources using the provided YARAC program,
+    so the files selected from the directory can be scanned at once.
+    If some of the sources is not available, the merged file is removed and
+    the *.yarac files are scanned one by one.
+    """
+    output_file = os.path.join(directory, MERGED_RULES_FILE)
+    sources = get_merged_sources(directory, install_dir, yara_patterns_dir)
+    if not sources or len(sources) < 2:
+        if os.path.isfile(output_file):
+            os.remove(output_file)
+        return
+
+    with stdout_lock:
+        print('-- Merging:', output_file)
+
+    cmd = [yarac, '-w']
+    cmd.extend('%s:%s' % (namespace, source) for namespace, source in sources)
+    cmd.append(output_file)
+    ret = subprocess.call(cmd)
+    if ret != 0:
+        print('Error: yarac failed during merging of files in', directory, file=sys.stderr)
+        sys.exit(1)
 
 
-def compile_yara_files(yarac, install_dir):
+def compile_yara_files(yarac, install_dir, yara_patterns_dir):
     """ Compile all *.yara files in the given installation directory using the
-    provided YARAC program into *.yarac files.
+    provided YARAC program into *.yarac files, and merge the *.yarac files in
+    every directory with a new *.yarac file.
     Remove the source *.yara files.
     """
     inputs = []
@@ -93,19 +145,31 @@ def compile_yara_files(yarac, install_dir):
         return
 
     stdout_lock = threading.Lock()
+    directories = sorted(set(os.path.dirname(input_file) for input_file in inputs))
     with multiprocessing.pool.ThreadPool() as pool:
         args = [
             (input_file, yarac, install_dir, stdout_lock) for input_file in inputs
         ]
         pool.starmap(compile_yara_file, args)
 
+        # Merged files are newer than all the *.yarac files, which is how
+        # YaraDetector tells that they are up to date.
+        args = [
+            (directory, yarac, install_dir, yara_patterns_dir, stdout_lock)
+            for directory in directories
+        ]
+        pool.starmap(merge_yara_files, args)
+
+    for input_file in inputs:
+        os.remove(input_file)
+
 
 def main():
     yarac, install_dir, yara_patterns_dir, compile = get_arguments()
     copy_yara_patterns(yara_patterns_dir, install_dir)
 
     if compile:
-        compile_yara_files(yarac, install_dir)
+        compile_yara_files(yarac, install_dir, yara_patterns_dir)
 
     sys.exit(0)
 
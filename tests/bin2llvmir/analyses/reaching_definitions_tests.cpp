@@ -5,6 +5,7 @@
 */
 
 #include "retdec/bin2llvmir/analyses/reaching_definitions.h"
+#include "retdec/utils/thread_pool.h"
 #include "bin2llvmir/utils/llvmir_tests.h"
 
 using namespace ::testing;
@@ -44,6 +45,235 @@ DummyTest)
 	EXPECT_EQ( nullptr, module->getGlobalVariable("glob1") );
 }
 
+TEST_F(ReachingDefinitionsTests,
+definitionsFromBothBranchesReachUseAfterJoin)
+{
+	parseInput(R"(
+		@r = global i32 0
+		define void @func1(i1 %c) {
+			br i1 %c, label %left, label %right
+		left:
+			store i32 1, i32* @r
+			br label %join
+		right:
+			store i32 2, i32* @r
+			br label %join
+		join:
+			%x = load i32, i32* @r
+			ret void
+		}
+	)");
+
+	RDA.runOnModule(*module);
+
+	auto* x = getInstructionByName("x");
+	auto* s1 = getNthInstruction<StoreInst>();
+	auto* s2 = getNthInstruction<StoreInst>(1);
+	std::set<Instruction*> defs;
+	for (auto* d : RDA.defsFromUse(x))
+	{
+		defs.insert(d->def);
+	}
+	std::set<Instruction*> exp = {s1, s2};
+	EXPECT_EQ(exp, defs);
+	EXPECT_EQ(1, RDA.usesFromDef(s1).size());
+	EXPECT_EQ(1, RDA.usesFromDef(s2).size());
+}
+
+TEST_F(ReachingDefinitionsTests,
+definitionInBasicBlockKillsDefinitionsFromPredecessors)
+{
+	parseInput(R"(
+		@r = global i32 0
+		define void @func1(i1 %c) {
+			store i32 1, i32* @r
+			br label %loop
+		loop:
+			%x = load i32, i32* @r
+			store i32 2, i32* @r
+			%y = load i32, i32* @r
+			br i1 %c, label %loop, label %exit
+		exit:
+			%z = load i32, i32* @r
+			ret void
+		}
+	)");
+
+	RDA.runOnModule(*module);
+
+	auto* s1 = getNthInstruction<StoreInst>();
+	auto* s2 = getNthInstruction<StoreInst>(1);
+	std::set<Instruction*> defs;
+	for (auto* d : RDA.defsFromUse(getInstructionByName("x")))
+	{
+		defs.insert(d->def);
+	}
+	std::set<Instruction*> exp = {s1, s2};
+	EXPECT_EQ(exp, defs);
+	ASSERT_EQ(1, RDA.defsFromUse(getInstructionByName("y")).size());
+	EXPECT_EQ(s2, (*RDA.defsFromUse(getInstructionByName("y")).begin())->def);
+	ASSERT_EQ(1, RDA.defsFromUse(getInstructionByName("z")).size());
+	EXPECT_EQ(s2, (*RDA.defsFromUse(getInstructionByName("z")).begin())->def);
+	EXPECT_EQ(3, RDA.usesFromDef(s2).size());
+}
+
+//
+// update()
+//
+
+TEST_F(ReachingDefinitionsTests,
+updateReusesResultsOfUnchangedFunctions)
+{
+	parseInput(R"(
+		@r = global i32 0
+		define void @func1() {
+			store i32 1, i32* @r
+			%x = load i32, i32* @r
+			ret void
+		}
+		define void @func2() {
+			%y = load i32, i32* @r
+			ret void
+		}
+	)");
+
+	RDA.update(*module);
+	RDA.update(*module);
+
+	EXPECT_EQ(2, RDA.getCacheStatistics().recomputes);
+	EXPECT_EQ(2, RDA.getCacheStatistics().hits);
+	auto* x = getInstructionByName("x");
+	EXPECT_EQ(1, RDA.defsFromUse(x).size());
+}
+
+TEST_F(ReachingDefinitionsTests,
+updateRecomputesOnlyInvalidatedChangedFunction)
+{
+	parseInput(R"(
+		@r = global i32 0
+		define void @func1() {
+			store i32 1, i32* @r
+			%x = load i32, i32* @r
+			ret void
+		}
+		define void @func2() {
+			%y = load i32, i32* @r
+			ret void
+		}
+	)");
+	RDA.update(*module);
+	auto* x = getInstructionByName("x");
+
+	new StoreInst(
+			ConstantInt::get(Type::getInt32Ty(context), 2),
+			getGlobalByName("r"),
+			x);
+	RDA.invalidate(getFunctionByName("func1"));
+	RDA.update(*module);
+
+	EXPECT_EQ(3, RDA.getCacheStatistics().recomputes);
+	EXPECT_EQ(1, RDA.getCacheStatistics().hits);
+	ASSERT_EQ(1, RDA.defsFromUse(x).size());
+	auto* s = (*RDA.defsFromUse(x).begin())->def;
+	EXPECT_EQ(x->getPrevNode(), s);
+}
+
+TEST_F(ReachingDefinitionsTests,
+updateRecomputesInvalidatedFunction)
+{
+	parseInput(R"(
+		@r = global i32 0
+		define void @func1() {
+			%x = load i32, i32* @r
+			ret void
+		}
+	)");
+	RDA.update(*module);
+
+	RDA.invalidate(getFunctionByName("func1"));
+	RDA.update(*module);
+
+	EXPECT_EQ(2, RDA.getCacheStatistics().recomputes);
+	EXPECT_EQ(0, RDA.getCacheStatistics().hits);
+	EXPECT_EQ(1, RDA.getCacheStatistics().invalidations);
+}
+
+TEST_F(ReachingDefinitionsTests,
+updateRecomputesAllFunctionsAfterInvalidateAll)
+{
+	parseInput(R"(
+		@r = global i32 0
+		define void @func1() {
+			%x = load i32, i32* @r
+			ret void
+		}
+		define void @func2() {
+			%y = load i32, i32* @r
+			ret void
+		}
+	)");
+	RDA.update(*module);
+
+	RDA.invalidateAll();
+	RDA.update(*module);
+
+	EXPECT_EQ(4, RDA.getCacheStatistics().recomputes);
+	EXPECT_EQ(0, RDA.getCacheStatistics().hits);
+	EXPECT_EQ(2, RDA.getCacheStatistics().invalidations);
+}
+
+TEST_F(ReachingDefinitionsTests,
+updateOnThreadPoolGivesSameResultsAsSerialUpdate)
+{
+	parseInput(R"(
+		@r = global i32 0
+		define void @func1() {
+			store i32 1, i32* @r
+			br i1 undef, label %left, label %right
+		left:
+			store i32 2, i32* @r
+			br label %join
+		right:
+			br label %join
+		join:
+			%x = load i32, i32* @r
+			ret void
+		}
+		define void @func2() {
+			store i32 3, i32* @r
+			%y = load i32, i32* @r
+			ret void
+		}
+		define void @func3() {
+			%z = load i32, i32* @r
+			ret void
+		}
+		declare void @func4()
+	)");
+	utils::ThreadPool pool(4);
+	ReachingDefinitionsAnalysis serialRDA;
+
+	RDA.update(*module, nullptr, false, &pool);
+	serialRDA.update(*module);
+
+	EXPECT_EQ(4, RDA.getCacheStatistics().recomputes);
+	for (auto* name : {"x", "y", "z"})
+	{
+		auto* i = getInstructionByName(name);
+		std::set<Instruction*> defs, serialDefs;
+		for (auto* d : RDA.defsFromUse(i))
+		{
+			defs.insert(d->def);
+		}
+		for (auto* d : serialRDA.defsFromUse(i))
+		{
+			serialDefs.insert(d->def);
+		}
+		EXPECT_EQ(serialDefs, defs) << name;
+	}
+	EXPECT_EQ(2, RDA.defsFromUse(getInstructionByName("x")).size());
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
@@ -0,0 +1,303 @@
+/**
+* @file tests/bin2llvmir/optimizations/decoder/disassembly_tests.cpp
+* @brief Tests for the parallel @c Disassembly used by the decoder.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <array>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <set>
+#include <vector>
+
+#include "bin2llvmir/utils/llvmir_tests.h"
+#include "retdec/bin2llvmir/optimizations/decoder/disassembly.h"
+#include "retdec/bin2llvmir/providers/fileimage.h"
+#include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
+
+using namespace ::testing;
+using namespace llvm;
+using namespace retdec::common;
+
+namespace retdec {
+namespace bin2llvmir {
+namespace tests {
+
+namespace {
+
+/**
+ * x86 code with data bytes between instructions and with two instructions
+ * that overlap each other. Offsets:
+ * @code
+ * 00: 55                push ebp
+ * 01: 74 05             je 0x08
+ * 03: e8 18 00 00 00    call 0x20
+ * 08: e8 23 00 00 00    call 0x30
+ * 0d: eb 03             jmp 0x12
+ * 0f: ff ff ff          data
+ * 12: 5d                pop ebp
+ * 13: c3                ret
+ * 14: 00 ...            padding
+ * 20: eb 01             jmp 0x23
+ * 22: b8                data (the first byte of mov eax, imm32 if decoded)
+ * 23: 31 c0             xor eax, eax
+ * 25: c3                ret
+ * 26: 00 ...            padding
+ * 30: b8 c3 00 00 00    mov eax, 0xc3
+ * 35: eb fa             jmp 0x31 (into the middle of the mov)
+ * 31: c3                ret (overlaps the mov)
+ * 37: 00 ...            padding
+ * @endcode
+ */
+const std::array<std::uint8_t, 0x40> code = {
+	0x55, 0x74, 0x05, 0xe8, 0x18, 0x00, 0x00, 0x00,
+	0xe8, 0x23, 0x00, 0x00, 0x00, 0xeb, 0x03, 0xff,
+	0xff, 0xff, 0x5d, 0xc3, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xeb, 0x01, 0xb8, 0x31, 0xc0, 0xc3, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xb8, 0xc3, 0x00, 0x00, 0x00, 0xeb, 0xfa, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+/// Offsets of the instructions reachable from the start of @c code.
+const std::set<std::size_t> reachableOffsets = {
+	0x00, 0x01, 0x03, 0x08, 0x0d, 0x12, 0x13,
+	0x20, 0x23, 0x25,
+	0x30, 0x31, 0x35,
+};
+
+} // anonymous namespace
+
+/**
+ * @brief Tests for the @c Disassembly.
+ */
+class DisassemblyTests: public LlvmIrTests
+{
+	protected:
+		void SetUp() override
+		{
+			format = createFormat();
+			base = format->appendData(code);
+			config = std::make_unique<Config>(Config::empty(module.get()));
+			image = std::make_unique<FileImage>(module.get(), format, config.get());
+			c2l = capstone2llvmir::Capstone2LlvmIrTranslator::createX86_32(
+					module.get());
+			ASSERT_NE(nullptr, c2l);
+			ASSERT_EQ(CS_ERR_OK, cs_open(CS_ARCH_X86, CS_MODE_32, &handle));
+			ASSERT_EQ(CS_ERR_OK, cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON));
+		}
+
+		void TearDown() override
+		{
+			if (handle)
+			{
+				cs_close(&handle);
+			}
+		}
+
+		/**
+		 * Disassemble @c code from its start by a pool with @a threads
+		 * threads. Only @a ranges are disassembled, and at most
+		 * @a maxInstructions instructions are retained. The pool exists
+		 * until the end of the test.
+		 */
+		void run(
+				Disassembly& disassembly,
+				std::size_t threads,
+				const RangesToDecode& ranges,
+				std::size_t maxInstructions = Disassembly::DefaultMaxInstructions)
+		{
+			pools.push_back(std::make_unique<utils::ThreadPool>(threads));
+			disassembly.run(
+					*pools.back(),
+					*c2l,
+					image.get(),
+					ranges,
+					{{base, CS_MODE_32}},
+					maxInstructions);
+		}
+
+		RangesToDecode getWholeCode()
+		{
+			RangesToDecode ranges;
+			ranges.addPrimary(base, base + code.size());
+			return ranges;
+		}
+
+		/**
+		 * Check that @a insn is the same as the instruction serially
+		 * disassembled by Capstone at offset @a offset of @c code.
+		 */
+		void expectSameAsSerial(const cs_insn* insn, std::size_t offset)
+		{
+			const std::uint8_t* bytes = code.data() + offset;
+			std::size_t size = code.size() - offset;
+			std::uint64_t address = base + offset;
+			cs_insn* serial = cs_malloc(handle);
+			ASSERT_TRUE(cs_disasm_iter(handle, &bytes, &size, &address, serial));
+
+			EXPECT_EQ(serial->id, insn->id);
+			EXPECT_EQ(serial->address, insn->address);
+			EXPECT_EQ(serial->size, insn->size);
+			EXPECT_EQ(0, std::memcmp(serial->bytes, insn->bytes, serial->size));
+			EXPECT_STREQ(serial->mnemonic, insn->mnemonic);
+			EXPECT_STREQ(serial->op_str, insn->op_str);
+			ASSERT_NE(nullptr, insn->detail);
+			ASSERT_EQ(serial->detail->x86.op_count, insn->detail->x86.op_count);
+			EXPECT_EQ(0, std::memcmp(
+					serial->detail->x86.operands,
+					insn->detail->x86.operands,
+					serial->detail->x86.op_count * sizeof(cs_x86_op)));
+
+			cs_free(serial, 1);
+		}
+
+		/**
+		 * Take all the instructions of @a disassembly at offsets of @c code
+		 * and check them against the serially disassembled ones.
+		 * @return Offsets of the taken instructions.
+		 */
+		std::set<std::size_t> takeAll(Disassembly& disassembly)
+		{
+			std::set<std::size_t> offsets;
+			for (std::size_t offset = 0; offset < code.size(); ++offset)
+			{
+				if (cs_insn* insn = disassembly.take(base + offset, CS_MODE_32, 16))
+				{
+					offsets.insert(offset);
+					expectSameAsSerial(insn, offset);
+					capstone2llvmir::freeRetainedInsn(insn);
+				}
+			}
+			return offsets;
+		}
+
+	protected:
+		std::shared_ptr<fileformat::RawDataFormat> format;
+		Address base;
+		std::unique_ptr<Config> config;
+		std::unique_ptr<FileImage> image;
+		std::unique_ptr<capstone2llvmir::Capstone2LlvmIrTranslator> c2l;
+		csh handle = 0;
+		std::vector<std::unique_ptr<utils::ThreadPool>> pools;
+};
+
+TEST_F(DisassemblyTests, instructionsAreSameAsSerialDisassembly)
+{
+	Disassembly disassembly;
+	run(disassembly, 4, getWholeCode());
+
+	EXPECT_EQ(reachableOffsets, takeAll(disassembly));
+}
+
+TEST_F(DisassemblyTests, resultDoesNotDependOnNumberOfThreads)
+{
+	Disassembly single;
+	run(single, 1, getWholeCode());
+
+	for (std::size_t threads : {2, 4, 8})
+	{
+		Disassembly multi;
+		run(multi, threads, getWholeCode());
+
+		EXPECT_EQ(single.getBasicBlockCount(), multi.getBasicBlockCount());
+		EXPECT_EQ(single.getInstructionCount(), multi.getInstructionCount());
+		EXPECT_EQ(reachableOffsets, takeAll(multi)) << threads << " threads";
+	}
+}
+
+TEST_F(DisassemblyTests, dataInCodeAreNotDisassembled)
+{
+	Disassembly disassembly;
+	run(disassembly, 4, getWholeCode());
+
+	for (std::size_t offset : {0x0f, 0x10, 0x11, 0x14, 0x22, 0x26, 0x37})
+	{
+		EXPECT_EQ(nullptr, disassembly.take(base + offset, CS_MODE_32, 16))
+				<< "offset " << offset;
+	}
+}
+
+TEST_F(DisassemblyTests, overlappingInstructionsAreBothDisassembled)
+{
+	Disassembly disassembly;
+	run(disassembly, 4, getWholeCode());
+
+	cs_insn* mov = disassembly.take(base + 0x30, CS_MODE_32, 16);
+	cs_insn* ret = disassembly.take(base + 0x31, CS_MODE_32, 16);
+	ASSERT_NE(nullptr, mov);
+	ASSERT_NE(nullptr, ret);
+	EXPECT_EQ(X86_INS_MOV, mov->id);
+	EXPECT_EQ(5, mov->size);
+	EXPECT_EQ(X86_INS_RET, ret->id);
+	EXPECT_EQ(1, ret->size);
+
+	capstone2llvmir::freeRetainedInsn(mov);
+	capstone2llvmir::freeRetainedInsn(ret);
+}
+
+TEST_F(DisassemblyTests, codeOutsideOfRangesIsNotDisassembled)
+{
+	RangesToDecode ranges = getWholeCode();
+	ranges.remove(base + 0x30, base + 0x3f);
+
+	Disassembly disassembly;
+	run(disassembly, 4, ranges);
+
+	std::set<std::size_t> expected;
+	for (auto offset : reachableOffsets)
+	{
+		if (offset < 0x30)
+		{
+			expected.insert(offset);
+		}
+	}
+	EXPECT_EQ(expected, takeAll(disassembly));
+}
+
+TEST_F(DisassemblyTests, takenInstructionIsNotReturnedAgain)
+{
+	Disassembly disassembly;
+	run(disassembly, 4, getWholeCode());
+
+	cs_insn* insn = disassembly.take(base, CS_MODE_32, 16);
+	ASSERT_NE(nullptr, insn);
+	EXPECT_EQ(nullptr, disassembly.take(base, CS_MODE_32, 16));
+	capstone2llvmir::freeRetainedInsn(insn);
+}
+
+TEST_F(DisassemblyTests, instructionLargerThanMaxSizeIsNotTaken)
+{
+	Disassembly disassembly;
+	run(disassembly, 4, getWholeCode());
+
+	EXPECT_EQ(nullptr, disassembly.take(base + 0x30, CS_MODE_32, 4));
+	cs_insn* mov = disassembly.take(base + 0x30, CS_MODE_32, 5);
+	EXPECT_NE(nullptr, mov);
+	capstone2llvmir::freeRetainedInsn(mov);
+}
+
+TEST_F(DisassemblyTests, lookAheadIsBoundedAndResumedWhenInstructionsAreTaken)
+{
+	Disassembly disassembly;
+	run(disassembly, 4, getWholeCode(), 2);
+
+	// The first basic block (push, je) fills the look-ahead.
+	EXPECT_EQ(2, disassembly.getInstructionCount());
+
+	std::set<std::size_t> offsets;
+	for (bool taken = true; taken; )
+	{
+		auto newOffsets = takeAll(disassembly);
+		taken = !newOffsets.empty();
+		offsets.insert(newOffsets.begin(), newOffsets.end());
+		pools.back()->wait();
+	}
+	EXPECT_EQ(reachableOffsets, offsets);
+}
+
+} // namespace tests
+} // namespace bin2llvmir
+} // namespace retdec
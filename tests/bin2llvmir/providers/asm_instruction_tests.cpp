@@ -4,6 +4,8 @@
  * @copyright (c) 2017 Avast Software, licensed under the MIT license
  */
 
+#include <set>
+
 #include <gtest/gtest.h>
 
 #include "retdec/bin2llvmir/providers/asm_instruction.h"
@@ -1706,6 +1708,95 @@ TEST_F(AsmInstructionTests, getInstructionFirstReturnsNullptrIfItDoesNotContainI
 	EXPECT_EQ(nullptr, ai.getInstructionFirst<llvm::CallInst>());
 }
 
+//
+// Llvm2CapstoneInsnMap
+//
+
+TEST_F(AsmInstructionTests, llvm2CapstoneInsnMapFindsInstructionsByTheirAddresses)
+{
+	cs_insn i1{};
+	cs_insn i2{};
+	cs_insn i3{};
+	cs_insn i4{};
+	i1.address = 0x1000;
+	i2.address = 0x1004;
+	i3.address = 0x400000;
+	i4.address = 0x0;
+	Llvm2CapstoneInsnMap map;
+
+	map.add(&i3);
+	map.add(&i1);
+	map.add(&i2);
+	map.add(&i4);
+
+	EXPECT_EQ(4, map.size());
+	EXPECT_EQ(&i1, map.find(0x1000));
+	EXPECT_EQ(&i2, map.find(0x1004));
+	EXPECT_EQ(&i3, map.find(0x400000));
+	EXPECT_EQ(&i4, map.find(0x0));
+	EXPECT_EQ(nullptr, map.find(0x1002));
+	EXPECT_EQ(nullptr, map.find(0x2000));
+	EXPECT_EQ(nullptr, map.find(0x400000000));
+}
+
+TEST_F(AsmInstructionTests, llvm2CapstoneInsnMapReplacesInstructionOnSameAddressButKeepsItForFreeing)
+{
+	cs_insn i1{};
+	cs_insn i2{};
+	i1.address = 0x1000;
+	i2.address = 0x1000;
+	Llvm2CapstoneInsnMap map;
+
+	map.add(&i1);
+	map.add(&i2);
+	std::set<cs_insn*> all;
+	map.forEach([&all](cs_insn* i) { all.insert(i); });
+
+	EXPECT_EQ(1, map.size());
+	EXPECT_EQ(&i2, map.find(0x1000));
+	EXPECT_EQ(std::set<cs_insn*>({&i1, &i2}), all);
+}
+
+TEST_F(AsmInstructionTests, llvm2CapstoneInsnMapIsEmptyAfterClear)
+{
+	cs_insn i1{};
+	i1.address = 0x1000;
+	Llvm2CapstoneInsnMap map;
+	map.add(&i1);
+
+	map.clear();
+	std::size_t count = 0;
+	map.forEach([&count](cs_insn*) { ++count; });
+
+	EXPECT_EQ(0, map.size());
+	EXPECT_EQ(0, count);
+	EXPECT_EQ(nullptr, map.find(0x1000));
+}
+
+TEST_F(AsmInstructionTests, getCapstoneInsnReturnsInstructionOnAddressOfMapInstruction)
+{
+	parseInput(R"(
+		define void @fnc() {
+			store volatile i64 4096, i64* @llvm2asm
+			store volatile i64 4100, i64* @llvm2asm
+			ret void
+		}
+		@llvm2asm = global i64 0
+	)");
+	auto* mapGv = getGlobalByName("llvm2asm");
+	AsmInstruction::setLlvmToAsmGlobalVariable(module.get(), mapGv);
+	cs_insn i1{};
+	cs_insn i2{};
+	i1.address = 4096;
+	i2.address = 4100;
+	auto& map = AsmInstruction::getLlvmToCapstoneInsnMap(module.get());
+	map.add(&i1);
+	map.add(&i2);
+
+	EXPECT_EQ(&i1, AsmInstruction(module.get(), 4096).getCapstoneInsn());
+	EXPECT_EQ(&i2, AsmInstruction(module.get(), 4100).getCapstoneInsn());
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
@@ -4,6 +4,9 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <thread>
+#include <vector>
+
 #include "retdec/bin2llvmir/providers/config.h"
 #include "bin2llvmir/utils/llvmir_tests.h"
 
@@ -583,6 +586,81 @@ class ConfigProviderTests: public LlvmIrTests
 
 };
 
+TEST_F(ConfigProviderTests, getConfigReturnsConfigAddedForModule)
+{
+	retdec::config::Config c;
+	auto* config = ConfigProvider::addConfig(module.get(), c);
+
+	EXPECT_NE(nullptr, config);
+	EXPECT_EQ(config, ConfigProvider::getConfig(module.get()));
+	EXPECT_EQ(&c, &config->getConfig());
+}
+
+TEST_F(ConfigProviderTests, clearForModuleKeepsConfigsOfOtherModules)
+{
+	LLVMContext otherContext;
+	auto otherModule = std::make_unique<Module>("other", otherContext);
+	retdec::config::Config c1;
+	retdec::config::Config c2;
+	ConfigProvider::addConfig(module.get(), c1);
+	auto* otherConfig = ConfigProvider::addConfig(otherModule.get(), c2);
+
+	ConfigProvider::clear(module.get());
+
+	EXPECT_EQ(nullptr, ConfigProvider::getConfig(module.get()));
+	EXPECT_EQ(otherConfig, ConfigProvider::getConfig(otherModule.get()));
+}
+
+TEST_F(ConfigProviderTests, providersKeepDataOfModulesProcessedInParallelSeparated)
+{
+	const std::size_t threadCount = 8;
+	const std::size_t iterations = 100;
+	std::vector<std::size_t> failures(threadCount, 0);
+
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([t, iterations, &failures]()
+		{
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				LLVMContext ctx;
+				auto m = std::make_unique<Module>("m", ctx);
+				auto* gv = new GlobalVariable(
+						*m,
+						Type::getInt64Ty(ctx),
+						false,
+						GlobalValue::ExternalLinkage,
+						nullptr);
+				auto inputFile = std::to_string(t) + "_" + std::to_string(i);
+				retdec::config::Config c;
+				c.parameters.setInputFile(inputFile);
+
+				auto* config = ConfigProvider::addConfig(m.get(), c);
+				AsmInstruction::setLlvmToAsmGlobalVariable(m.get(), gv);
+
+				if (ConfigProvider::getConfig(m.get()) != config
+						|| config->getConfig().parameters.getInputFile()
+								!= inputFile
+						|| AsmInstruction::getLlvmToAsmGlobalVariable(m.get())
+								!= gv)
+				{
+					++failures[t];
+				}
+
+				ConfigProvider::clear(m.get());
+				AsmInstruction::clear(m.get());
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	EXPECT_EQ(std::vector<std::size_t>(threadCount, 0), failures);
+}
+
 } // namespace tests
 } // namespace bin2llvmir
 } // namespace retdec
@@ -33,6 +33,8 @@
 #include "retdec/bin2llvmir/providers/fileimage.h"
 #include "retdec/bin2llvmir/providers/lti.h"
 #include "retdec/bin2llvmir/providers/names.h"
+#include "retdec/bin2llvmir/providers/reaching_definitions.h"
+#include "retdec/bin2llvmir/providers/thread_pool.h"
 #include "retdec/bin2llvmir/utils/debug.h"
 #include "retdec/utils/string.h"
 
@@ -67,6 +69,8 @@ class LlvmIrTests : public ::testing::Test
 			FileImageProvider::clear();
 			LtiProvider::clear();
 			NamesProvider::clear();
+			ReachingDefinitionsProvider::clear();
+			ThreadPoolProvider::clear();
 			SymbolicTree::clear();
 			CallingConventionProvider::clear();
 		}
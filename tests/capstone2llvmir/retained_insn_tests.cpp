@@ -0,0 +1,295 @@
+/**
+ * @file tests/capstone2llvmir/retained_insn_tests.cpp
+ * @brief Tests for the compact storage of retained Capstone instructions.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/capstone2llvmir/retained_insn.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace capstone2llvmir {
+namespace tests {
+
+class RetainedInsnTests : public Test
+{
+	protected:
+		virtual void SetUp() override
+		{
+			ASSERT_EQ(CS_ERR_OK, cs_open(CS_ARCH_X86, CS_MODE_32, &_handle));
+			ASSERT_EQ(CS_ERR_OK, cs_option(_handle, CS_OPT_DETAIL, CS_OPT_ON));
+			_insn = cs_malloc(_handle);
+		}
+
+		virtual void TearDown() override
+		{
+			if (_insn)
+			{
+				cs_free(_insn, 1);
+			}
+			if (_handle)
+			{
+				cs_close(&_handle);
+			}
+		}
+
+		void disassemble(const std::vector<uint8_t>& bytes)
+		{
+			const uint8_t* code = bytes.data();
+			std::size_t size = bytes.size();
+			uint64_t address = 0x1000;
+			ASSERT_TRUE(cs_disasm_iter(_handle, &code, &size, &address, _insn));
+		}
+
+	protected:
+		csh _handle = 0;
+		cs_insn* _insn = nullptr;
+};
+
+TEST_F(RetainedInsnTests, CopyHasSameInstructionAndUsedDetails)
+{
+	disassemble({0x05, 0x78, 0x56, 0x34, 0x12}); // add eax, 0x12345678
+
+	cs_insn* copy = retainInsn(CS_ARCH_X86, _insn);
+
+	ASSERT_NE(nullptr, copy->detail);
+	EXPECT_NE(_insn->detail, copy->detail);
+	EXPECT_EQ(_insn->id, copy->id);
+	EXPECT_EQ(_insn->address, copy->address);
+	EXPECT_EQ(_insn->size, copy->size);
+	EXPECT_STREQ(_insn->mnemonic, copy->mnemonic);
+	EXPECT_STREQ(_insn->op_str, copy->op_str);
+	EXPECT_EQ(_insn->detail->regs_write_count, copy->detail->regs_write_count);
+	EXPECT_EQ(_insn->detail->groups_count, copy->detail->groups_count);
+	ASSERT_EQ(2, copy->detail->x86.op_count);
+	EXPECT_EQ(0, std::memcmp(
+			_insn->detail->x86.operands,
+			copy->detail->x86.operands,
+			2 * sizeof(cs_x86_op)));
+	EXPECT_EQ(0x12345678, copy->detail->x86.operands[1].imm);
+
+	freeRetainedInsn(copy);
+}
+
+TEST_F(RetainedInsnTests, CopyIsIndependentOfScratchInstruction)
+{
+	disassemble({0x89, 0xe5}); // mov ebp, esp
+	cs_insn* copy = retainInsn(CS_ARCH_X86, _insn);
+
+	disassemble({0x5d}); // pop ebp
+
+	EXPECT_EQ(X86_INS_MOV, copy->id);
+	EXPECT_EQ(2, copy->detail->x86.op_count);
+	EXPECT_EQ(X86_INS_POP, _insn->id);
+
+	freeRetainedInsn(copy);
+}
+
+TEST_F(RetainedInsnTests, CopyIsSmallerThanCapstoneInstruction)
+{
+	disassemble({0x5d}); // pop ebp
+
+	EXPECT_LT(
+			getRetainedInsnSize(CS_ARCH_X86, _insn),
+			sizeof(cs_insn) + sizeof(cs_detail));
+}
+
+TEST_F(RetainedInsnTests, InstructionWithoutDetailIsCopied)
+{
+	disassemble({0x5d}); // pop ebp
+	cs_insn insn = *_insn;
+	insn.detail = nullptr;
+
+	cs_insn* copy = retainInsn(CS_ARCH_X86, &insn);
+
+	EXPECT_EQ(nullptr, copy->detail);
+	EXPECT_EQ(X86_INS_POP, copy->id);
+
+	freeRetainedInsn(copy);
+}
+
+TEST_F(RetainedInsnTests, FreeOfNullDoesNothing)
+{
+	freeRetainedInsn(nullptr);
+}
+
+/**
+ * Instructions of one architecture and mode used by RetainedInsnRoundTripTests.
+ */
+struct RoundTripInput
+{
+	const char* name;
+	cs_arch arch;
+	cs_mode mode;
+	std::vector<uint8_t> bytes;
+};
+
+std::ostream& operator<<(std::ostream& out, const RoundTripInput& input)
+{
+	return out << input.name;
+}
+
+/**
+ * Tests that every instruction of a short function is the same after it is
+ * retained, for all the architectures whose details are truncated.
+ */
+class RetainedInsnRoundTripTests : public TestWithParam<RoundTripInput>
+{
+	protected:
+		/**
+		 * Check the details of architecture @a arch. Only the fields before
+		 * the operands, the first @c op_count operands and the fields after
+		 * the operands (which are kept whole, if there are any) are compared.
+		 * These are the only parts of the details that may be read.
+		 */
+		template<typename ArchDetail>
+		void expectSameArchDetail(const ArchDetail& orig, const ArchDetail& copy)
+		{
+			ASSERT_EQ(orig.op_count, copy.op_count);
+			EXPECT_EQ(0, std::memcmp(
+					&orig,
+					&copy,
+					offsetof(ArchDetail, operands)));
+			EXPECT_EQ(0, std::memcmp(
+					orig.operands,
+					copy.operands,
+					orig.op_count * sizeof(orig.operands[0])));
+
+			constexpr std::size_t operandsEnd = offsetof(ArchDetail, operands)
+					+ sizeof(orig.operands);
+			if (sizeof(ArchDetail) - operandsEnd >= alignof(ArchDetail))
+			{
+				EXPECT_EQ(0, std::memcmp(
+						reinterpret_cast<const char*>(&orig) + operandsEnd,
+						reinterpret_cast<const char*>(&copy) + operandsEnd,
+						sizeof(ArchDetail) - operandsEnd));
+			}
+		}
+
+		void expectSameInsn(cs_arch arch, const cs_insn* orig, const cs_insn* copy)
+		{
+			EXPECT_EQ(orig->id, copy->id);
+			EXPECT_EQ(orig->address, copy->address);
+			ASSERT_EQ(orig->size, copy->size);
+			EXPECT_EQ(0, std::memcmp(orig->bytes, copy->bytes, orig->size));
+			EXPECT_STREQ(orig->mnemonic, copy->mnemonic);
+			EXPECT_STREQ(orig->op_str, copy->op_str);
+
+			ASSERT_NE(nullptr, copy->detail);
+			const cs_detail& od = *orig->detail;
+			const cs_detail& cd = *copy->detail;
+			ASSERT_EQ(od.regs_read_count, cd.regs_read_count);
+			EXPECT_EQ(0, std::memcmp(od.regs_read, cd.regs_read, od.regs_read_count * sizeof(od.regs_read[0])));
+			ASSERT_EQ(od.regs_write_count, cd.regs_write_count);
+			EXPECT_EQ(0, std::memcmp(od.regs_write, cd.regs_write, od.regs_write_count * sizeof(od.regs_write[0])));
+			ASSERT_EQ(od.groups_count, cd.groups_count);
+			EXPECT_EQ(0, std::memcmp(od.groups, cd.groups, od.groups_count * sizeof(od.groups[0])));
+
+			switch (arch)
+			{
+				case CS_ARCH_X86: expectSameArchDetail(od.x86, cd.x86); break;
+				case CS_ARCH_ARM: expectSameArchDetail(od.arm, cd.arm); break;
+				case CS_ARCH_ARM64: expectSameArchDetail(od.arm64, cd.arm64); break;
+				case CS_ARCH_MIPS: expectSameArchDetail(od.mips, cd.mips); break;
+				case CS_ARCH_PPC: expectSameArchDetail(od.ppc, cd.ppc); break;
+				default: FAIL() << "unexpected architecture"; break;
+			}
+		}
+};
+
+TEST_P(RetainedInsnRoundTripTests, RetainedInstructionsAreSameAsDecodedInstructions)
+{
+	const auto& input = GetParam();
+	csh handle = 0;
+	ASSERT_EQ(CS_ERR_OK, cs_open(input.arch, input.mode, &handle));
+	ASSERT_EQ(CS_ERR_OK, cs_option(handle, CS_OPT_DETAIL, CS_OPT_ON));
+	cs_insn* insn = cs_malloc(handle);
+
+	const uint8_t* code = input.bytes.data();
+	std::size_t size = input.bytes.size();
+	uint64_t address = 0x1000;
+	std::size_t count = 0;
+	while (cs_disasm_iter(handle, &code, &size, &address, insn))
+	{
+		cs_insn* copy = retainInsn(input.arch, insn);
+
+		SCOPED_TRACE(std::string(insn->mnemonic) + " " + insn->op_str);
+		EXPECT_LT(
+				getRetainedInsnSize(input.arch, insn),
+				sizeof(cs_insn) + sizeof(cs_detail));
+		expectSameInsn(input.arch, insn, copy);
+
+		freeRetainedInsn(copy);
+		++count;
+	}
+	EXPECT_EQ(0, size) << "not all the bytes were decoded";
+	EXPECT_LT(0, count);
+
+	cs_free(insn, 1);
+	cs_close(&handle);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+		InstantiateRetainedInsnRoundTripWithAllArchitectures,
+		RetainedInsnRoundTripTests,
+		::testing::Values(
+				RoundTripInput{"x86", CS_ARCH_X86, CS_MODE_32, {
+					0x55,                         // push ebp
+					0x89, 0xe5,                   // mov ebp, esp
+					0x8b, 0x45, 0x08,             // mov eax, [ebp+8]
+					0x05, 0x78, 0x56, 0x34, 0x12, // add eax, 0x12345678
+					0xc9,                         // leave
+					0xc3                          // ret
+				}},
+				RoundTripInput{"x86_64", CS_ARCH_X86, CS_MODE_64, {
+					0x48, 0x89, 0xe5,             // mov rbp, rsp
+					0x48, 0x8b, 0x44, 0x24, 0x08, // mov rax, [rsp+8]
+					0xc3                          // ret
+				}},
+				RoundTripInput{"arm", CS_ARCH_ARM, CS_MODE_ARM, {
+					0x00, 0x48, 0x2d, 0xe9,       // push {fp, lr}
+					0x02, 0x00, 0x81, 0xe0,       // add r0, r1, r2
+					0x00, 0x88, 0xbd, 0xe8        // pop {fp, pc}
+				}},
+				RoundTripInput{"thumb", CS_ARCH_ARM, CS_MODE_THUMB, {
+					0x80, 0xb5,                   // push {r7, lr}
+					0x08, 0x44,                   // add r0, r1
+					0x80, 0xbd                    // pop {r7, pc}
+				}},
+				RoundTripInput{"arm64", CS_ARCH_ARM64, CS_MODE_ARM, {
+					0xfd, 0x7b, 0xbf, 0xa9,       // stp x29, x30, [sp, #-0x10]!
+					0x20, 0x00, 0x02, 0x8b,       // add x0, x1, x2
+					0xc0, 0x03, 0x5f, 0xd6        // ret
+				}},
+				RoundTripInput{"mips", CS_ARCH_MIPS,
+						cs_mode(CS_MODE_MIPS32 | CS_MODE_BIG_ENDIAN), {
+					0x27, 0xbd, 0xff, 0xf8,       // addiu $sp, $sp, -8
+					0x8f, 0xbf, 0x00, 0x04,       // lw $ra, 4($sp)
+					0x03, 0xe0, 0x00, 0x08,       // jr $ra
+					0x00, 0x00, 0x00, 0x00        // nop
+				}},
+				RoundTripInput{"powerpc", CS_ARCH_PPC,
+						cs_mode(CS_MODE_32 | CS_MODE_BIG_ENDIAN), {
+					0x94, 0x21, 0xff, 0xf0,       // stwu r1, -0x10(r1)
+					0x7c, 0x08, 0x02, 0xa6,       // mflr r0
+					0x7c, 0x64, 0x2a, 0x14,       // add r3, r4, r5
+					0x4e, 0x80, 0x00, 0x20        // blr
+				}}
+		),
+		[](const TestParamInfo<RoundTripInput>& info)
+		{
+			return std::string(info.param.name);
+		});
+
+} // namespace tests
+} // namespace capstone2llvmir
+} // namespace retdec
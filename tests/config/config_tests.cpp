@@ -54,6 +54,69 @@ TEST_F(ConfigTests, FailedReadJsonStringKeepsAllConfigData)
 	EXPECT_EQ(expectedAbiPaths, config.parameters.abiPaths);
 }
 
+TEST_F(ConfigTests, BackendJobsAreOneByDefault)
+{
+	ASSERT_EQ(1, config.parameters.getBackendJobs());
+}
+
+TEST_F(ConfigTests, BackendJobsSurviveJsonRoundTrip)
+{
+	config.parameters.setBackendJobs(8);
+
+	auto loaded = Config::fromJsonString(config.generateJsonString());
+
+	EXPECT_EQ(8, loaded.parameters.getBackendJobs());
+}
+
+TEST_F(ConfigTests, AnalysisJobsAreOneByDefault)
+{
+	ASSERT_EQ(1, config.parameters.getAnalysisJobs());
+}
+
+TEST_F(ConfigTests, AnalysisJobsSurviveJsonRoundTrip)
+{
+	config.parameters.setAnalysisJobs(4);
+
+	auto loaded = Config::fromJsonString(config.generateJsonString());
+
+	EXPECT_EQ(4, loaded.parameters.getAnalysisJobs());
+}
+
+TEST_F(ConfigTests, Bin2llvmirCacheIsDisabledByDefault)
+{
+	EXPECT_TRUE(config.parameters.getBin2llvmirCacheDirectory().empty());
+	EXPECT_EQ(1024 * 1024 * 1024, config.parameters.getBin2llvmirCacheMaxSize());
+}
+
+TEST_F(ConfigTests, Bin2llvmirCacheParametersSurviveJsonRoundTrip)
+{
+	config.parameters.setBin2llvmirCacheDirectory("/tmp/bin2llvmir-cache");
+	config.parameters.setBin2llvmirCacheMaxSize(4096);
+
+	auto loaded = Config::fromJsonString(config.generateJsonString());
+
+	EXPECT_EQ("/tmp/bin2llvmir-cache", loaded.parameters.getBin2llvmirCacheDirectory());
+	EXPECT_EQ(4096, loaded.parameters.getBin2llvmirCacheMaxSize());
+}
+
+TEST_F(ConfigTests, YaraCacheDirectorySurvivesJsonRoundTrip)
+{
+	config.parameters.setYaraCacheDirectory("/tmp/yara-cache");
+
+	auto loaded = Config::fromJsonString(config.generateJsonString());
+
+	EXPECT_EQ("/tmp/yara-cache", loaded.parameters.getYaraCacheDirectory());
+}
+
+TEST_F(ConfigTests, ProfilePassesFileSurvivesJsonRoundTrip)
+{
+	config.parameters.setProfilePassesFile("/tmp/profile.json");
+
+	auto loaded = Config::fromJsonString(config.generateJsonString());
+
+	EXPECT_EQ("/tmp/profile.json", loaded.parameters.getProfilePassesFile());
+}
+
 TEST_F(ConfigTests, ClassesGetElementByIdReturnsNullPointerWhenThereIsNoSuchClass)
 {
 	ASSERT_EQ(config.classes.end(), config.classes.find("ClassName"));
@@ -0,0 +1,349 @@
+/**
+ * @file tests/cpdetect/signature_matcher_tests.cpp
+ * @brief Tests for the @c signature_matcher module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/cpdetect/search.h"
+#include "retdec/cpdetect/signature_matcher.h"
+#include "retdec/fileformat/file_format/raw_data/raw_data_format.h"
+
+using namespace ::testing;
+using namespace retdec::fileformat;
+
+namespace retdec {
+namespace cpdetect {
+namespace tests {
+
+namespace {
+
+/**
+ * x86 code with relative jumps. Offsets:
+ * @code
+ * 00: 55 8B EC          push ebp; mov ebp, esp
+ * 03: EB 02             jmp 0x07
+ * 05: 90 90
+ * 07: 5D C3             pop ebp; ret
+ * 09: 12 34 56 78       data
+ * 0d: E9 03 00 00 00    jmp 0x15
+ * 12: CC CC CC
+ * 15: 8B EC 5D C3
+ * 19: 00
+ * 1a: 55 8B EC 90
+ * 1e: AB CD             data at the end of file
+ * @endcode
+ */
+const std::vector<std::uint8_t> code = {
+	0x55, 0x8B, 0xEC, 0xEB, 0x02, 0x90, 0x90, 0x5D,
+	0xC3, 0x12, 0x34, 0x56, 0x78, 0xE9, 0x03, 0x00,
+	0x00, 0x00, 0xCC, 0xCC, 0xCC, 0x8B, 0xEC, 0x5D,
+	0xC3, 0x00, 0x55, 0x8B, 0xEC, 0x90, 0xAB, 0xCD,
+};
+
+/// Patterns without slashes: exact bytes, wildcards, nibble shifts.
+const std::vector<std::string> unslashedPatterns = {
+	"558BEC;",
+	"558BEC90;",
+	"EB--9090;",
+	"55--EC;",
+	"C3-2?4;",
+	"2345;",
+	"456-;",
+	"C5DC;",
+	"ABCD;",
+	"BCD;",
+	"CDEF;",
+	"--------;",
+};
+
+/// Patterns with slashes, which skip relative jumps.
+const std::vector<std::string> slashedPatterns = {
+	"8BEC/5DC3;",
+	"--EC/5D;",
+	"/8BEC5DC3;",
+	"558BEC/5DC3/;",
+	"8BEC/90;",
+	"/;",
+};
+
+/**
+ * Get content of @a bytes as uppercase hexadecimal digits.
+ */
+std::string toNibbles(const std::vector<std::uint8_t>& bytes)
+{
+	const char* digits = "0123456789ABCDEF";
+	std::string nibbles;
+	for (auto b : bytes)
+	{
+		nibbles += digits[b >> 4];
+		nibbles += digits[b & 0x0F];
+	}
+	return nibbles;
+}
+
+/**
+ * Search of unslashed signature used before @c SignatureMatcher, which
+ * compares the pattern nibble by nibble with the hexadecimal representation
+ * of the file.
+ */
+unsigned long long oldFindUnslashedSignature(
+		const Search& search,
+		const std::string& nibbles,
+		const std::string& signPattern,
+		std::size_t startOffset,
+		std::size_t stopOffset)
+{
+	if (startOffset > stopOffset)
+	{
+		return 0;
+	}
+
+	const auto startIterator = nibbles.begin() + 2 * startOffset;
+	const auto stopIndex = 2 * stopOffset + 1;
+	const auto stopIterator = stopIndex < nibbles.size()
+			? nibbles.begin() + stopIndex
+			: nibbles.end();
+	const auto it = std::search(
+			startIterator,
+			stopIterator,
+			signPattern.begin(),
+			signPattern.end(),
+			[] (const char fileNibble, const char signatureNibble)
+			{
+				return fileNibble == signatureNibble
+						|| signatureNibble == '-'
+						|| signatureNibble == '?'
+						|| signatureNibble == ';';
+			}
+	);
+
+	return (it != stopIterator) ? search.countImpNibbles(signPattern) : 0;
+}
+
+/**
+ * Search of slashed signature used before @c SignatureMatcher, which tries
+ * the pattern on each nibble of the area.
+ */
+unsigned long long oldFindSlashedSignature(
+		const Search& search,
+		const std::string& signPattern,
+		std::size_t startOffset,
+		std::size_t stopOffset)
+{
+	if (startOffset > stopOffset)
+	{
+		return 0;
+	}
+
+	const auto areaSize = 2 * (stopOffset - startOffset + 1);
+	const auto signSize = signPattern.length()
+			- std::count(signPattern.begin(), signPattern.end(), ';');
+	if (areaSize < signSize)
+	{
+		return 0;
+	}
+	const auto iters = startOffset == stopOffset ? 1 : areaSize - signSize + 1;
+
+	for (std::size_t i = 0; i < iters; ++i)
+	{
+		const auto result = search.exactComparison(signPattern, startOffset, i);
+		if (result)
+		{
+			return result;
+		}
+	}
+
+	return 0;
+}
+
+} // anonymous namespace
+
+/**
+ * Tests for the @c SignatureMatcher class.
+ */
+class SignatureMatcherTests : public Test
+{
+	protected:
+		SignatureMatcherTests() :
+				format(std::make_unique<RawDataFormat>(code.data(), code.size())),
+				nibbles(toNibbles(code))
+		{
+			format->setTargetArchitecture(Architecture::X86);
+			format->setEndianness(retdec::utils::Endianness::LITTLE);
+			format->setBytesPerWord(4);
+			search = std::make_unique<Search>(*format);
+		}
+
+		/**
+		 * Find @a pattern in area <@a start, @a stop> by a matcher of
+		 * @a pattern only.
+		 */
+		unsigned long long find(
+				const std::string& pattern,
+				std::size_t start,
+				std::size_t stop)
+		{
+			const SignatureMatcher matcher({pattern});
+			std::vector<unsigned long long> result;
+			matcher.findPatterns(*search, {{start, stop}}, result);
+			return result.front();
+		}
+
+	protected:
+		std::unique_ptr<RawDataFormat> format;
+		std::unique_ptr<Search> search;
+		const std::string nibbles;
+};
+
+TEST_F(SignatureMatcherTests, SearchIsSupported)
+{
+	ASSERT_TRUE(search->isFileLoaded());
+	ASSERT_TRUE(search->isFileSupported());
+	ASSERT_TRUE(search->haveSlashes());
+}
+
+TEST_F(SignatureMatcherTests, WildcardsMatchAnyNibble)
+{
+	EXPECT_EQ(6, find("EB--9090;", 0, code.size() - 1));
+	EXPECT_EQ(4, find("55--EC;", 0, code.size() - 1));
+	EXPECT_EQ(4, find("C3-2?4;", 0, code.size() - 1));
+	EXPECT_EQ(0, find("C3-3?4;", 0, code.size() - 1));
+}
+
+TEST_F(SignatureMatcherTests, PatternsAreFoundOnLowNibbles)
+{
+	// 12 34 56 78 at 0x09, EC 5D C3 at 0x16
+	EXPECT_EQ(4, find("2345;", 0, code.size() - 1));
+	EXPECT_EQ(3, find("456-;", 0, code.size() - 1));
+	EXPECT_EQ(4, find("C5DC;", 0, code.size() - 1));
+	EXPECT_EQ(0, find("2345;", 0x0a, code.size() - 1));
+	EXPECT_EQ(0, find("2345;", 0x09, 0x0a));
+}
+
+TEST_F(SignatureMatcherTests, SlashesSkipRelativeJumps)
+{
+	const std::string first = "8BEC/5DC3;";
+	const std::string second = "/8BEC5DC3;";
+	EXPECT_NE(0, search->countImpNibbles(first));
+	EXPECT_EQ(search->countImpNibbles(first), find(first, 0, 0x0f));
+	EXPECT_EQ(search->countImpNibbles(second), find(second, 0x0d, 0x19));
+	EXPECT_EQ(0, find(second, 0x0e, 0x19));
+	EXPECT_EQ(0, find("8BEC/90;", 0, code.size() - 1));
+}
+
+TEST_F(SignatureMatcherTests, PatternMustFitIntoArea)
+{
+	// 558BEC at 0x1a
+	EXPECT_NE(0, find("558BEC90;", 0x1a, 0x1d));
+	EXPECT_EQ(0, find("558BEC90;", 0x1a, 0x1c));
+	EXPECT_EQ(0, find("558BEC90;", 0x1b, 0x1d));
+	EXPECT_EQ(0, find("558BEC90;", 0x1d, 0x1a));
+}
+
+TEST_F(SignatureMatcherTests, PatternEndingAtEndOfFileIsFound)
+{
+	EXPECT_EQ(4, find("ABCD;", 0, code.size() - 1));
+	EXPECT_EQ(3, find("BCD;", 0, code.size() - 1));
+	EXPECT_EQ(3, find("BCD;", 0, code.size() + 10));
+	EXPECT_EQ(0, find("CDEF;", 0, code.size() + 10));
+}
+
+TEST_F(SignatureMatcherTests, SlashedSignaturesAreSameAsOldSearchInAllAreas)
+{
+	// The old search missed patterns which end at the end of file. Areas at
+	// the end of file are covered by PatternEndingAtEndOfFileIsFound.
+	std::vector<std::string> patterns = unslashedPatterns;
+	patterns.insert(patterns.end(), slashedPatterns.begin(), slashedPatterns.end());
+
+	for (const auto& pattern : patterns)
+	{
+		for (std::size_t start = 0; start < code.size(); ++start)
+		{
+			for (std::size_t stop = start; stop + 1 < code.size(); ++stop)
+			{
+				EXPECT_EQ(
+						oldFindSlashedSignature(*search, pattern, start, stop),
+						search->findSlashedSignature(pattern, start, stop))
+						<< pattern << " in <" << start << ", " << stop << ">";
+			}
+		}
+	}
+}
+
+TEST_F(SignatureMatcherTests, UnslashedSignaturesAreSameAsOldSearchInAllAreas)
+{
+	// The old search did not count the terminating semicolon into the area,
+	// so it needed one more nibble behind the area. Areas at the end of file
+	// are covered by PatternEndingAtEndOfFileIsFound.
+	for (const auto& pattern : unslashedPatterns)
+	{
+		for (std::size_t start = 0; start < code.size(); ++start)
+		{
+			for (std::size_t stop = start; stop + 1 < code.size(); ++stop)
+			{
+				EXPECT_EQ(
+						oldFindUnslashedSignature(
+								*search, nibbles, pattern, start, stop + 1),
+						search->findUnslashedSignature(pattern, start, stop))
+						<< pattern << " in <" << start << ", " << stop << ">";
+			}
+		}
+	}
+}
+
+TEST_F(SignatureMatcherTests, SetOfPatternsIsSameAsSinglePatterns)
+{
+	std::vector<std::string> patterns = unslashedPatterns;
+	patterns.insert(patterns.end(), slashedPatterns.begin(), slashedPatterns.end());
+
+	// Areas end before the end of file as in the test above
+	std::vector<SignatureMatcher::Area> areas;
+	for (std::size_t i = 0; i < patterns.size(); ++i)
+	{
+		const auto start = (i * 7) % (code.size() - 1);
+		const auto stop = start + (i * 5) % (code.size() - 1);
+		areas.push_back({start, std::min(stop, code.size() - 2)});
+	}
+	// Patterns without area are not searched
+	areas.push_back({1, 0});
+	patterns.push_back("558BEC;");
+
+	const SignatureMatcher matcher(patterns);
+	ASSERT_EQ(patterns.size(), matcher.getNumberOfPatterns());
+
+	std::vector<unsigned long long> result;
+	matcher.findPatterns(*search, areas, result);
+	ASSERT_EQ(patterns.size(), result.size());
+	for (std::size_t i = 0; i < patterns.size(); ++i)
+	{
+		EXPECT_EQ(
+				oldFindSlashedSignature(
+						*search,
+						patterns[i],
+						areas[i].startOffset,
+						areas[i].stopOffset),
+				result[i])
+				<< patterns[i];
+	}
+	EXPECT_EQ(0, result.back());
+}
+
+TEST_F(SignatureMatcherTests, CachedMatcherGivesSameResults)
+{
+	for (int i = 0; i < 2; ++i)
+	{
+		EXPECT_EQ(6, search->findUnslashedSignature("558BEC;", 0x01, 0x1c));
+		EXPECT_EQ(0, search->findUnslashedSignature("558BEC;", 0x01, 0x1b));
+	}
+}
+
+} // namespace tests
+} // namespace cpdetect
+} // namespace retdec
@@ -0,0 +1,449 @@
+/**
+* @file tests/ctypesparser/binary_ctypes_parser_tests.cpp
+* @brief Tests for the @c BinaryCTypesParser and @c BinaryCTypesWriter modules.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include "retdec/ctypes/array_type.h"
+#include "retdec/ctypes/call_convention.h"
+#include "retdec/ctypes/context.h"
+#include "retdec/ctypes/enum_type.h"
+#include "retdec/ctypes/function.h"
+#include "retdec/ctypes/member.h"
+#include "retdec/ctypes/module.h"
+#include "retdec/ctypes/parameter.h"
+#include "retdec/ctypes/pointer_type.h"
+#include "retdec/ctypes/struct_type.h"
+#include "retdec/ctypes/typedefed_type.h"
+#include "retdec/ctypes/unknown_type.h"
+#include "retdec/ctypesparser/binary_ctypes_parser.h"
+#include "retdec/ctypesparser/binary_ctypes_writer.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace ctypesparser {
+namespace tests {
+
+class BinaryCTypesParserTests : public Test
+{
+	public:
+		BinaryCTypesParserTests():
+			module(std::make_unique<retdec::ctypes::Module>(
+				std::make_shared<retdec::ctypes::Context>())) {}
+
+	protected:
+		/// Compiles @a json and returns content of the binary file.
+		std::string compile(const std::string &json)
+		{
+			std::stringstream in(json);
+			std::stringstream out;
+			BinaryCTypesWriter().write(in, out);
+			return out.str();
+		}
+
+		/// Compiles @a json and opens it by @a parser.
+		void open(
+			BinaryCTypesParser &parser,
+			std::string &data,
+			const std::string &json,
+			const CTypesParser::TypeWidths &typeWidths = {})
+		{
+			data = compile(json);
+			parser.openInto(
+				reinterpret_cast<const std::uint8_t*>(data.data()),
+				data.size(),
+				module,
+				typeWidths
+			);
+		}
+
+	protected:
+		std::unique_ptr<retdec::ctypes::Module> module;
+		BinaryCTypesParser parser;
+		std::string data;
+};
+
+const std::string JSON_FF_INT = R"(
+	{
+		"functions": {
+			"ff": {
+				"decl": "int ff(int b);",
+				"header": "CHeader.h",
+				"name": "ff",
+				"params": [
+					{
+						"annotations": "_In_",
+						"name": "b",
+						"type": "46f8ab7c0cff9df7cd124852e26022a6bf89e315"
+					}
+				],
+				"ret_type": "46f8ab7c0cff9df7cd124852e26022a6bf89e315"
+			},
+			"gg": {
+				"decl": "void gg(void);",
+				"header": "CHeader.h",
+				"name": "gg",
+				"params": [],
+				"ret_type": "void"
+			}
+		},
+		"types": {
+			"46f8ab7c0cff9df7cd124852e26022a6bf89e315": {
+				"name": "int",
+				"type": "integral_type"
+			},
+			"void": {
+				"type": "void"
+			}
+		}
+	}
+)";
+
+TEST_F(BinaryCTypesParserTests,
+WritingBadJSONThrowsException)
+{
+	ASSERT_THROW(compile(R"({ "missing bracket": 1 )"), CTypesParseError);
+}
+
+TEST_F(BinaryCTypesParserTests,
+WritingJSONWithUnknownTypeKeyThrowsException)
+{
+	ASSERT_THROW(compile(R"(
+		{
+			"functions": {
+				"ff": {
+					"decl": "int ff(void);",
+					"header": "CHeader.h",
+					"name": "ff",
+					"params": [],
+					"ret_type": "missing"
+				}
+			},
+			"types": {}
+		}
+	)"), CTypesParseError);
+}
+
+TEST_F(BinaryCTypesParserTests,
+OpeningFileWithBadMagicThrowsException)
+{
+	std::string bad(64, 'x');
+
+	ASSERT_THROW(
+		parser.openInto(
+			reinterpret_cast<const std::uint8_t*>(bad.data()),
+			bad.size(),
+			module
+		),
+		CTypesParseError
+	);
+}
+
+TEST_F(BinaryCTypesParserTests,
+OpeningTruncatedFileThrowsException)
+{
+	auto truncated = compile(JSON_FF_INT).substr(0, 20);
+
+	ASSERT_THROW(
+		parser.openInto(
+			reinterpret_cast<const std::uint8_t*>(truncated.data()),
+			truncated.size(),
+			module
+		),
+		CTypesParseError
+	);
+}
+
+TEST_F(BinaryCTypesParserTests,
+FunctionsAreParsedOnlyWhenRequested)
+{
+	open(parser, data, JSON_FF_INT);
+
+	EXPECT_EQ(2, parser.getFunctionCount());
+	EXPECT_TRUE(parser.hasFunction("ff"));
+	EXPECT_TRUE(parser.hasFunction("gg"));
+	EXPECT_FALSE(parser.hasFunction("hh"));
+	EXPECT_FALSE(module->hasFunctionWithName("ff"));
+	EXPECT_EQ(nullptr, parser.getFunction("hh"));
+
+	auto func = parser.getFunction("ff");
+
+	ASSERT_TRUE(func);
+	EXPECT_TRUE(module->hasFunctionWithName("ff"));
+	EXPECT_FALSE(module->hasFunctionWithName("gg"));
+	EXPECT_EQ(func, parser.getFunction("ff"));
+}
+
+TEST_F(BinaryCTypesParserTests,
+ParsingFunctionCorrectly)
+{
+	open(parser, data, JSON_FF_INT, {{"int", 32}});
+
+	auto func = parser.getFunction("ff");
+
+	ASSERT_TRUE(func);
+	EXPECT_EQ("int", func->getReturnType()->getName());
+	EXPECT_EQ(32, func->getReturnType()->getBitWidth());
+	ASSERT_EQ(1, func->getParameterCount());
+	EXPECT_EQ("b", func->getParameterName(1));
+	EXPECT_EQ(func->getReturnType(), func->getParameterType(1));
+	EXPECT_TRUE(func->getParameter(1).isIn());
+	EXPECT_FALSE(func->isVarArg());
+	EXPECT_EQ("int ff(int b);", std::string(func->getDeclaration()));
+	EXPECT_EQ("CHeader.h", func->getHeaderFile().getPath());
+}
+
+TEST_F(BinaryCTypesParserTests,
+FunctionWithoutCallConventionGetsDefaultOne)
+{
+	data = compile(JSON_FF_INT);
+	parser.openInto(
+		reinterpret_cast<const std::uint8_t*>(data.data()),
+		data.size(),
+		module,
+		{},
+		retdec::ctypes::CallConvention("cdecl")
+	);
+
+	auto func = parser.getFunction("gg");
+
+	ASSERT_TRUE(func);
+	EXPECT_EQ(retdec::ctypes::CallConvention("cdecl"), func->getCallConvention());
+	EXPECT_TRUE(func->getReturnType()->isVoid());
+}
+
+TEST_F(BinaryCTypesParserTests,
+ParsingRecursiveStructCorrectly)
+{
+	open(parser, data, R"(
+		{
+			"functions": {
+				"ff": {
+					"decl": "void ff(struct s *p);",
+					"header": "CHeader.h",
+					"name": "ff",
+					"params": [
+						{
+							"name": "p",
+							"type": "ptr_s"
+						}
+					],
+					"ret_type": "void"
+				}
+			},
+			"types": {
+				"ptr_s": {
+					"pointed_type": "s",
+					"type": "pointer"
+				},
+				"s": {
+					"members": [
+						{
+							"name": "next",
+							"type": "ptr_s"
+						},
+						{
+							"name": "items",
+							"type": "arr"
+						}
+					],
+					"name": "s",
+					"type": "structure"
+				},
+				"arr": {
+					"dimensions": [10, ""],
+					"element_type": "ptr_s",
+					"type": "array"
+				},
+				"void": {
+					"type": "void"
+				}
+			}
+		}
+	)");
+
+	auto func = parser.getFunction("ff");
+
+	ASSERT_TRUE(func);
+	auto ptr = std::dynamic_pointer_cast<retdec::ctypes::PointerType>(
+		func->getParameterType(1));
+	ASSERT_TRUE(ptr);
+	auto s = std::dynamic_pointer_cast<retdec::ctypes::StructType>(
+		ptr->getPointedType());
+	ASSERT_TRUE(s);
+	EXPECT_EQ("s", s->getName());
+	ASSERT_EQ(2, s->getMemberCount());
+	EXPECT_EQ(ptr, s->getMemberType(1));
+	auto arr = std::dynamic_pointer_cast<retdec::ctypes::ArrayType>(
+		s->getMemberType(2));
+	ASSERT_TRUE(arr);
+	retdec::ctypes::ArrayType::Dimensions expectedDimensions{
+		10, retdec::ctypes::ArrayType::UNKNOWN_DIMENSION};
+	EXPECT_EQ(expectedDimensions, arr->getDimensions());
+}
+
+TEST_F(BinaryCTypesParserTests,
+ParsingTypedefsAndEnumsCorrectly)
+{
+	open(parser, data, R"(
+		{
+			"functions": {
+				"ff": {
+					"decl": "MYINT ff(E e, UNK u);",
+					"header": "CHeader.h",
+					"name": "ff",
+					"params": [
+						{
+							"name": "e",
+							"type": "e"
+						},
+						{
+							"name": "u",
+							"type": "unk"
+						}
+					],
+					"ret_type": "myint"
+				}
+			},
+			"types": {
+				"myint": {
+					"name": "MYINT",
+					"type": "typedef",
+					"typedefed_type": "uint"
+				},
+				"uint": {
+					"name": "unsigned int",
+					"type": "integral_type"
+				},
+				"unk": {
+					"name": "UNK",
+					"type": "typedef",
+					"typedefed_type": "unknown"
+				},
+				"e": {
+					"items": [
+						{
+							"name": "A",
+							"value": -1
+						},
+						{
+							"name": "B",
+							"value": 5000000000
+						}
+					],
+					"name": "E",
+					"type": "enum"
+				}
+			}
+		}
+	)");
+
+	auto func = parser.getFunction("ff");
+
+	ASSERT_TRUE(func);
+	auto myint = std::dynamic_pointer_cast<retdec::ctypes::TypedefedType>(
+		func->getReturnType());
+	ASSERT_TRUE(myint);
+	EXPECT_EQ("MYINT", myint->getName());
+	EXPECT_EQ("unsigned int", myint->getAliasedType()->getName());
+	auto unk = std::dynamic_pointer_cast<retdec::ctypes::TypedefedType>(
+		func->getParameterType(2));
+	ASSERT_TRUE(unk);
+	EXPECT_TRUE(unk->getAliasedType()->isUnknown());
+	auto e = std::dynamic_pointer_cast<retdec::ctypes::EnumType>(
+		func->getParameterType(1));
+	ASSERT_TRUE(e);
+	ASSERT_EQ(2, e->getValueCount());
+	EXPECT_EQ(-1, e->getValue(1).getValue());
+	EXPECT_EQ(5000000000, e->getValue(2).getValue());
+}
+
+TEST_F(BinaryCTypesParserTests,
+NamedTypesFromPreviousFilesTakePrecedence)
+{
+	std::string data1;
+	BinaryCTypesParser parser1;
+	open(parser1, data1, R"(
+		{
+			"functions": {
+				"f1": {
+					"decl": "void f1(T t);",
+					"header": "first.h",
+					"name": "f1",
+					"params": [
+						{
+							"name": "t",
+							"type": "t"
+						}
+					],
+					"ret_type": "void"
+				}
+			},
+			"types": {
+				"t": {
+					"name": "T",
+					"type": "typedef",
+					"typedefed_type": "int"
+				},
+				"int": {
+					"name": "int",
+					"type": "integral_type"
+				},
+				"void": {
+					"type": "void"
+				}
+			}
+		}
+	)");
+	open(parser, data, R"(
+		{
+			"functions": {
+				"f2": {
+					"decl": "void f2(T t);",
+					"header": "second.h",
+					"name": "f2",
+					"params": [
+						{
+							"name": "t",
+							"type": "t"
+						}
+					],
+					"ret_type": "void"
+				}
+			},
+			"types": {
+				"t": {
+					"name": "T",
+					"type": "typedef",
+					"typedefed_type": "long"
+				},
+				"long": {
+					"name": "long",
+					"type": "integral_type"
+				},
+				"void": {
+					"type": "void"
+				}
+			}
+		}
+	)");
+	parser.setPreviousParsers({&parser1});
+
+	auto f2 = parser.getFunction("f2");
+
+	ASSERT_TRUE(f2);
+	auto t = std::dynamic_pointer_cast<retdec::ctypes::TypedefedType>(
+		f2->getParameterType(1));
+	ASSERT_TRUE(t);
+	EXPECT_EQ("int", t->getAliasedType()->getName());
+	EXPECT_FALSE(module->hasFunctionWithName("f1"));
+}
+
+} // namespace tests
+} // namespace ctypesparser
+} // namespace retdec
@@ -0,0 +1,449 @@
+/**
+ * @file tests/debugformat/dwarf_tests.cpp
+ * @brief Tests for loading of DWARF debug information.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <rapidjson/prettywriter.h>
+#include <rapidjson/stringbuffer.h>
+
+#include "retdec/debugformat/debugformat.h"
+#include "retdec/demangler/demangler.h"
+#include "retdec/fileformat/format_factory.h"
+#include "retdec/loader/image_factory.h"
+#include "retdec/serdes/function.h"
+#include "retdec/serdes/object.h"
+#include "retdec/utils/thread_pool.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace debugformat {
+namespace tests {
+
+namespace {
+
+/**
+ * 32-bit x86 ELF executable with DWARF 4 debug information of three compile
+ * units (a.c, b.c and c.c), built by
+ * @code
+ * gcc -m32 -g -gdwarf-4 -O1 -fno-asynchronous-unwind-tables -fno-pie -no-pie \
+ *     -nostdlib -static -Wl,--build-id=none -Wl,-N -Wl,-z,max-page-size=16 \
+ *     a.c b.c c.c
+ * @endcode
+ * with @c .comment and @c .debug_frame sections removed. The sources are:
+ * @code
+ * // a.c
+ * struct point { int x; int y; };
+ * int counter;
+ * static int add(int a, int b) { return a + b; }
+ * int scale(struct point *p, int k) { p->x *= k; p->y *= k; return add(p->x, p->y); }
+ * void _start(void) { struct point p = {1, 2}; counter = scale(&p, 3); for (;;); }
+ * // b.c
+ * struct point { int x; int y; };
+ * union value { int i; float f; };
+ * float ratio = 0.5f;
+ * float to_float(union value v) { return v.f * ratio; }
+ * int sum(const int *items, unsigned count) { int s = 0; while (count--) s += *items++; return s; }
+ * // c.c
+ * typedef struct { char name[8]; unsigned flags; } entry_t;
+ * entry_t table[4];
+ * unsigned count_flags(unsigned mask) { unsigned n = 0; for (int i = 0; i < 4; ++i) if (table[i].flags & mask) ++n; return n; }
+ * const char *entry_name(int i) { return table[i].name; }
+ * @endcode
+ */
+const std::vector<std::uint8_t> dwarfElfBytes = {
+	0x7f, 0x45, 0x4c, 0x46, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x02, 0x00, 0x03, 0x00, 0x01, 0x00, 0x00, 0x00, 0xad, 0x80, 0x04, 0x08, 0x34, 0x00, 0x00, 0x00,
+	0x10, 0x0d, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x34, 0x00, 0x20, 0x00, 0x03, 0x00, 0x28, 0x00,
+	0x0e, 0x00, 0x0d, 0x00, 0x01, 0x00, 0x00, 0x00, 0x94, 0x00, 0x00, 0x00, 0x94, 0x80, 0x04, 0x08,
+	0x94, 0x80, 0x04, 0x08, 0x9c, 0x00, 0x00, 0x00, 0x9c, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00,
+	0x04, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x81, 0x04, 0x08,
+	0x40, 0x81, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+	0x20, 0x00, 0x00, 0x00, 0x51, 0xe5, 0x74, 0x64, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
+	0x10, 0x00, 0x00, 0x00, 0x8b, 0x4c, 0x24, 0x04, 0x8b, 0x54, 0x24, 0x08, 0x89, 0xd0, 0x0f, 0xaf,
+	0x01, 0x89, 0x01, 0x0f, 0xaf, 0x51, 0x04, 0x89, 0x51, 0x04, 0x01, 0xd0, 0xc3, 0xc7, 0x05, 0x40,
+	0x81, 0x04, 0x08, 0x09, 0x00, 0x00, 0x00, 0xeb, 0xfe, 0xd9, 0x05, 0x2c, 0x81, 0x04, 0x08, 0xd8,
+	0x4c, 0x24, 0x04, 0xc3, 0x8b, 0x54, 0x24, 0x04, 0x8b, 0x4c, 0x24, 0x08, 0x8d, 0x41, 0xff, 0x85,
+	0xc9, 0x74, 0x16, 0xb9, 0x00, 0x00, 0x00, 0x00, 0x83, 0xc2, 0x04, 0x03, 0x4a, 0xfc, 0x83, 0xe8,
+	0x01, 0x83, 0xf8, 0xff, 0x75, 0xf2, 0x89, 0xc8, 0xc3, 0xb9, 0x00, 0x00, 0x00, 0x00, 0xeb, 0xf6,
+	0x56, 0x53, 0x8b, 0x74, 0x24, 0x0c, 0xb8, 0x60, 0x81, 0x04, 0x08, 0xbb, 0x90, 0x81, 0x04, 0x08,
+	0xba, 0x00, 0x00, 0x00, 0x00, 0x89, 0xf1, 0x23, 0x48, 0x08, 0x83, 0xf9, 0x01, 0x83, 0xda, 0xff,
+	0x83, 0xc0, 0x0c, 0x39, 0xd8, 0x75, 0xee, 0x89, 0xd0, 0x5b, 0x5e, 0xc3, 0x8b, 0x44, 0x24, 0x04,
+	0x8d, 0x04, 0x40, 0x8d, 0x04, 0x85, 0x60, 0x81, 0x04, 0x08, 0xc3, 0x00, 0x00, 0x00, 0x00, 0x3f,
+	0x1c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x94, 0x80, 0x04, 0x08, 0x25, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x1c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x26, 0x01, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xb9, 0x80, 0x04, 0x08, 0x37, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x1c, 0x00, 0x00, 0x00, 0x02, 0x00, 0x19, 0x02, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xf0, 0x80, 0x04, 0x08, 0x3b, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x22, 0x01, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x01, 0x15, 0x00, 0x00, 0x00,
+	0x0c, 0x61, 0x2e, 0x63, 0x00, 0x84, 0x00, 0x00, 0x00, 0x94, 0x80, 0x04, 0x08, 0x25, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x07, 0x00, 0x00, 0x00, 0x08, 0x01, 0x01, 0x08, 0x49, 0x00,
+	0x00, 0x00, 0x03, 0x78, 0x00, 0x01, 0x01, 0x14, 0x49, 0x00, 0x00, 0x00, 0x00, 0x03, 0x79, 0x00,
+	0x01, 0x01, 0x1b, 0x49, 0x00, 0x00, 0x00, 0x04, 0x00, 0x04, 0x04, 0x05, 0x69, 0x6e, 0x74, 0x00,
+	0x05, 0x0d, 0x00, 0x00, 0x00, 0x01, 0x02, 0x05, 0x49, 0x00, 0x00, 0x00, 0x05, 0x03, 0x40, 0x81,
+	0x04, 0x08, 0x06, 0x00, 0x00, 0x00, 0x00, 0x01, 0x05, 0x06, 0xad, 0x80, 0x04, 0x08, 0x0c, 0x00,
+	0x00, 0x00, 0x01, 0x9c, 0x83, 0x00, 0x00, 0x00, 0x07, 0x70, 0x00, 0x01, 0x05, 0x22, 0x25, 0x00,
+	0x00, 0x00, 0x00, 0x08, 0x7e, 0x00, 0x00, 0x00, 0x01, 0x04, 0x05, 0x49, 0x00, 0x00, 0x00, 0x01,
+	0xa9, 0x00, 0x00, 0x00, 0x09, 0x70, 0x00, 0x01, 0x04, 0x19, 0xa9, 0x00, 0x00, 0x00, 0x09, 0x6b,
+	0x00, 0x01, 0x04, 0x20, 0x49, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x04, 0x25, 0x00, 0x00, 0x00, 0x0b,
+	0x61, 0x64, 0x64, 0x00, 0x01, 0x03, 0x0c, 0x49, 0x00, 0x00, 0x00, 0x01, 0xd5, 0x00, 0x00, 0x00,
+	0x09, 0x61, 0x00, 0x01, 0x03, 0x14, 0x49, 0x00, 0x00, 0x00, 0x09, 0x62, 0x00, 0x01, 0x03, 0x1b,
+	0x49, 0x00, 0x00, 0x00, 0x00, 0x0c, 0x83, 0x00, 0x00, 0x00, 0x94, 0x80, 0x04, 0x08, 0x19, 0x00,
+	0x00, 0x00, 0x01, 0x9c, 0x0d, 0x94, 0x00, 0x00, 0x00, 0x02, 0x91, 0x00, 0x0d, 0x9e, 0x00, 0x00,
+	0x00, 0x02, 0x91, 0x04, 0x0e, 0xaf, 0x00, 0x00, 0x00, 0xaa, 0x80, 0x04, 0x08, 0x01, 0xaa, 0x80,
+	0x04, 0x08, 0x02, 0x00, 0x00, 0x00, 0x01, 0x04, 0x42, 0x0f, 0xca, 0x00, 0x00, 0x00, 0x02, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0f, 0xc0, 0x00, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00, 0x15,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xef, 0x00, 0x00, 0x00, 0x04, 0x00, 0xfe, 0x00, 0x00, 0x00,
+	0x04, 0x01, 0x15, 0x00, 0x00, 0x00, 0x0c, 0x62, 0x2e, 0x63, 0x00, 0x84, 0x00, 0x00, 0x00, 0xb9,
+	0x80, 0x04, 0x08, 0x37, 0x00, 0x00, 0x00, 0x72, 0x00, 0x00, 0x00, 0x02, 0x04, 0x05, 0x69, 0x6e,
+	0x74, 0x00, 0x03, 0x25, 0x00, 0x00, 0x00, 0x04, 0x99, 0x00, 0x00, 0x00, 0x04, 0x01, 0x02, 0x07,
+	0x53, 0x00, 0x00, 0x00, 0x05, 0x69, 0x00, 0x01, 0x02, 0x13, 0x25, 0x00, 0x00, 0x00, 0x05, 0x66,
+	0x00, 0x01, 0x02, 0x1c, 0x53, 0x00, 0x00, 0x00, 0x00, 0x06, 0x04, 0x04, 0xa2, 0x00, 0x00, 0x00,
+	0x07, 0xb4, 0x00, 0x00, 0x00, 0x01, 0x03, 0x07, 0x53, 0x00, 0x00, 0x00, 0x05, 0x03, 0x2c, 0x81,
+	0x04, 0x08, 0x08, 0x73, 0x75, 0x6d, 0x00, 0x01, 0x05, 0x05, 0x25, 0x00, 0x00, 0x00, 0xc4, 0x80,
+	0x04, 0x08, 0x2c, 0x00, 0x00, 0x00, 0x01, 0x9c, 0xc1, 0x00, 0x00, 0x00, 0x09, 0xae, 0x00, 0x00,
+	0x00, 0x01, 0x05, 0x14, 0xc1, 0x00, 0x00, 0x00, 0x2e, 0x00, 0x00, 0x00, 0x2a, 0x00, 0x00, 0x00,
+	0x09, 0xa8, 0x00, 0x00, 0x00, 0x01, 0x05, 0x24, 0xc7, 0x00, 0x00, 0x00, 0x53, 0x00, 0x00, 0x00,
+	0x4d, 0x00, 0x00, 0x00, 0x0a, 0x73, 0x00, 0x01, 0x05, 0x31, 0x25, 0x00, 0x00, 0x00, 0x83, 0x00,
+	0x00, 0x00, 0x7d, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x04, 0x2c, 0x00, 0x00, 0x00, 0x06, 0x04, 0x07,
+	0x8c, 0x00, 0x00, 0x00, 0x0c, 0x9f, 0x00, 0x00, 0x00, 0x01, 0x04, 0x07, 0x53, 0x00, 0x00, 0x00,
+	0xb9, 0x80, 0x04, 0x08, 0x0b, 0x00, 0x00, 0x00, 0x01, 0x9c, 0x0d, 0x76, 0x00, 0x01, 0x04, 0x1c,
+	0x31, 0x00, 0x00, 0x00, 0x02, 0x91, 0x00, 0x00, 0x00, 0x1c, 0x01, 0x00, 0x00, 0x04, 0x00, 0xde,
+	0x01, 0x00, 0x00, 0x04, 0x01, 0x15, 0x00, 0x00, 0x00, 0x0c, 0x63, 0x2e, 0x63, 0x00, 0x84, 0x00,
+	0x00, 0x00, 0xf0, 0x80, 0x04, 0x08, 0x3b, 0x00, 0x00, 0x00, 0x07, 0x01, 0x00, 0x00, 0x02, 0x0c,
+	0x01, 0x01, 0x09, 0x49, 0x00, 0x00, 0x00, 0x03, 0xcd, 0x00, 0x00, 0x00, 0x01, 0x01, 0x17, 0x49,
+	0x00, 0x00, 0x00, 0x00, 0x03, 0xde, 0x00, 0x00, 0x00, 0x01, 0x01, 0x29, 0x59, 0x00, 0x00, 0x00,
+	0x08, 0x00, 0x04, 0x60, 0x00, 0x00, 0x00, 0x59, 0x00, 0x00, 0x00, 0x05, 0x59, 0x00, 0x00, 0x00,
+	0x07, 0x00, 0x06, 0x04, 0x07, 0x8c, 0x00, 0x00, 0x00, 0x06, 0x01, 0x06, 0xe4, 0x00, 0x00, 0x00,
+	0x07, 0x60, 0x00, 0x00, 0x00, 0x08, 0xba, 0x00, 0x00, 0x00, 0x01, 0x01, 0x32, 0x25, 0x00, 0x00,
+	0x00, 0x04, 0x6c, 0x00, 0x00, 0x00, 0x88, 0x00, 0x00, 0x00, 0x05, 0x59, 0x00, 0x00, 0x00, 0x03,
+	0x00, 0x09, 0xd2, 0x00, 0x00, 0x00, 0x01, 0x02, 0x09, 0x78, 0x00, 0x00, 0x00, 0x05, 0x03, 0x60,
+	0x81, 0x04, 0x08, 0x0a, 0xc7, 0x00, 0x00, 0x00, 0x01, 0x04, 0x0d, 0xc2, 0x00, 0x00, 0x00, 0x1c,
+	0x81, 0x04, 0x08, 0x0f, 0x00, 0x00, 0x00, 0x01, 0x9c, 0xc2, 0x00, 0x00, 0x00, 0x0b, 0x69, 0x00,
+	0x01, 0x04, 0x1c, 0xc8, 0x00, 0x00, 0x00, 0x02, 0x91, 0x00, 0x00, 0x0c, 0x04, 0x67, 0x00, 0x00,
+	0x00, 0x0d, 0x04, 0x05, 0x69, 0x6e, 0x74, 0x00, 0x0e, 0xd8, 0x00, 0x00, 0x00, 0x01, 0x03, 0x0a,
+	0x59, 0x00, 0x00, 0x00, 0xf0, 0x80, 0x04, 0x08, 0x2c, 0x00, 0x00, 0x00, 0x01, 0x9c, 0x0f, 0xc2,
+	0x00, 0x00, 0x00, 0x01, 0x03, 0x1f, 0x59, 0x00, 0x00, 0x00, 0x02, 0x91, 0x00, 0x10, 0x6e, 0x00,
+	0x01, 0x03, 0x30, 0x59, 0x00, 0x00, 0x00, 0xb2, 0x00, 0x00, 0x00, 0xae, 0x00, 0x00, 0x00, 0x11,
+	0x00, 0x00, 0x00, 0x00, 0x10, 0x69, 0x00, 0x01, 0x03, 0x40, 0xc8, 0x00, 0x00, 0x00, 0xd3, 0x00,
+	0x00, 0x00, 0xd1, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x11, 0x01, 0x25, 0x0e, 0x13, 0x0b,
+	0x03, 0x08, 0x1b, 0x0e, 0x11, 0x01, 0x12, 0x06, 0x10, 0x17, 0x00, 0x00, 0x02, 0x13, 0x01, 0x03,
+	0x0e, 0x0b, 0x0b, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x01, 0x13, 0x00, 0x00, 0x03, 0x0d, 0x00,
+	0x03, 0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x38, 0x0b, 0x00, 0x00, 0x04, 0x24,
+	0x00, 0x0b, 0x0b, 0x3e, 0x0b, 0x03, 0x08, 0x00, 0x00, 0x05, 0x34, 0x00, 0x03, 0x0e, 0x3a, 0x0b,
+	0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x3f, 0x19, 0x02, 0x18, 0x00, 0x00, 0x06, 0x2e, 0x01, 0x3f,
+	0x19, 0x03, 0x0e, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x27, 0x19, 0x11, 0x01, 0x12, 0x06, 0x40,
+	0x18, 0x97, 0x42, 0x19, 0x01, 0x13, 0x00, 0x00, 0x07, 0x34, 0x00, 0x03, 0x08, 0x3a, 0x0b, 0x3b,
+	0x0b, 0x39, 0x0b, 0x49, 0x13, 0x00, 0x00, 0x08, 0x2e, 0x01, 0x3f, 0x19, 0x03, 0x0e, 0x3a, 0x0b,
+	0x3b, 0x0b, 0x39, 0x0b, 0x27, 0x19, 0x49, 0x13, 0x20, 0x0b, 0x01, 0x13, 0x00, 0x00, 0x09, 0x05,
+	0x00, 0x03, 0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x00, 0x00, 0x0a, 0x0f, 0x00,
+	0x0b, 0x0b, 0x49, 0x13, 0x00, 0x00, 0x0b, 0x2e, 0x01, 0x03, 0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39,
+	0x0b, 0x27, 0x19, 0x49, 0x13, 0x20, 0x0b, 0x01, 0x13, 0x00, 0x00, 0x0c, 0x2e, 0x01, 0x31, 0x13,
+	0x11, 0x01, 0x12, 0x06, 0x40, 0x18, 0x97, 0x42, 0x19, 0x00, 0x00, 0x0d, 0x05, 0x00, 0x31, 0x13,
+	0x02, 0x18, 0x00, 0x00, 0x0e, 0x1d, 0x01, 0x31, 0x13, 0x52, 0x01, 0xb8, 0x42, 0x0b, 0x11, 0x01,
+	0x12, 0x06, 0x58, 0x0b, 0x59, 0x0b, 0x57, 0x0b, 0x00, 0x00, 0x0f, 0x05, 0x00, 0x31, 0x13, 0x02,
+	0x17, 0xb7, 0x42, 0x17, 0x00, 0x00, 0x00, 0x01, 0x11, 0x01, 0x25, 0x0e, 0x13, 0x0b, 0x03, 0x08,
+	0x1b, 0x0e, 0x11, 0x01, 0x12, 0x06, 0x10, 0x17, 0x00, 0x00, 0x02, 0x24, 0x00, 0x0b, 0x0b, 0x3e,
+	0x0b, 0x03, 0x08, 0x00, 0x00, 0x03, 0x26, 0x00, 0x49, 0x13, 0x00, 0x00, 0x04, 0x17, 0x01, 0x03,
+	0x0e, 0x0b, 0x0b, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x01, 0x13, 0x00, 0x00, 0x05, 0x0d, 0x00,
+	0x03, 0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x00, 0x00, 0x06, 0x24, 0x00, 0x0b,
+	0x0b, 0x3e, 0x0b, 0x03, 0x0e, 0x00, 0x00, 0x07, 0x34, 0x00, 0x03, 0x0e, 0x3a, 0x0b, 0x3b, 0x0b,
+	0x39, 0x0b, 0x49, 0x13, 0x3f, 0x19, 0x02, 0x18, 0x00, 0x00, 0x08, 0x2e, 0x01, 0x3f, 0x19, 0x03,
+	0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x27, 0x19, 0x49, 0x13, 0x11, 0x01, 0x12, 0x06, 0x40,
+	0x18, 0x97, 0x42, 0x19, 0x01, 0x13, 0x00, 0x00, 0x09, 0x05, 0x00, 0x03, 0x0e, 0x3a, 0x0b, 0x3b,
+	0x0b, 0x39, 0x0b, 0x49, 0x13, 0x02, 0x17, 0xb7, 0x42, 0x17, 0x00, 0x00, 0x0a, 0x34, 0x00, 0x03,
+	0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x02, 0x17, 0xb7, 0x42, 0x17, 0x00, 0x00,
+	0x0b, 0x0f, 0x00, 0x0b, 0x0b, 0x49, 0x13, 0x00, 0x00, 0x0c, 0x2e, 0x01, 0x3f, 0x19, 0x03, 0x0e,
+	0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x27, 0x19, 0x49, 0x13, 0x11, 0x01, 0x12, 0x06, 0x40, 0x18,
+	0x97, 0x42, 0x19, 0x00, 0x00, 0x0d, 0x05, 0x00, 0x03, 0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b,
+	0x49, 0x13, 0x02, 0x18, 0x00, 0x00, 0x00, 0x01, 0x11, 0x01, 0x25, 0x0e, 0x13, 0x0b, 0x03, 0x08,
+	0x1b, 0x0e, 0x11, 0x01, 0x12, 0x06, 0x10, 0x17, 0x00, 0x00, 0x02, 0x13, 0x01, 0x0b, 0x0b, 0x3a,
+	0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x01, 0x13, 0x00, 0x00, 0x03, 0x0d, 0x00, 0x03, 0x0e, 0x3a, 0x0b,
+	0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x38, 0x0b, 0x00, 0x00, 0x04, 0x01, 0x01, 0x49, 0x13, 0x01,
+	0x13, 0x00, 0x00, 0x05, 0x21, 0x00, 0x49, 0x13, 0x2f, 0x0b, 0x00, 0x00, 0x06, 0x24, 0x00, 0x0b,
+	0x0b, 0x3e, 0x0b, 0x03, 0x0e, 0x00, 0x00, 0x07, 0x26, 0x00, 0x49, 0x13, 0x00, 0x00, 0x08, 0x16,
+	0x00, 0x03, 0x0e, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x00, 0x00, 0x09, 0x34, 0x00,
+	0x03, 0x0e, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x3f, 0x19, 0x02, 0x18, 0x00, 0x00,
+	0x0a, 0x2e, 0x01, 0x3f, 0x19, 0x03, 0x0e, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x27, 0x19, 0x49,
+	0x13, 0x11, 0x01, 0x12, 0x06, 0x40, 0x18, 0x97, 0x42, 0x19, 0x01, 0x13, 0x00, 0x00, 0x0b, 0x05,
+	0x00, 0x03, 0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x02, 0x18, 0x00, 0x00, 0x0c,
+	0x0f, 0x00, 0x0b, 0x0b, 0x49, 0x13, 0x00, 0x00, 0x0d, 0x24, 0x00, 0x0b, 0x0b, 0x3e, 0x0b, 0x03,
+	0x08, 0x00, 0x00, 0x0e, 0x2e, 0x01, 0x3f, 0x19, 0x03, 0x0e, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b,
+	0x27, 0x19, 0x49, 0x13, 0x11, 0x01, 0x12, 0x06, 0x40, 0x18, 0x97, 0x42, 0x19, 0x00, 0x00, 0x0f,
+	0x05, 0x00, 0x03, 0x0e, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x02, 0x18, 0x00, 0x00,
+	0x10, 0x34, 0x00, 0x03, 0x08, 0x3a, 0x0b, 0x3b, 0x0b, 0x39, 0x0b, 0x49, 0x13, 0x02, 0x17, 0xb7,
+	0x42, 0x17, 0x00, 0x00, 0x11, 0x0b, 0x01, 0x55, 0x17, 0x00, 0x00, 0x00, 0x6e, 0x00, 0x00, 0x00,
+	0x04, 0x00, 0x1b, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0xfb, 0x0e, 0x0d, 0x00, 0x01, 0x01, 0x01,
+	0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x61, 0x2e, 0x63, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x05, 0x23, 0x00, 0x05, 0x02, 0x94, 0x80, 0x04, 0x08, 0x15, 0x06, 0x01, 0x05, 0x25, 0x06,
+	0x82, 0x05, 0x2a, 0x06, 0x01, 0x05, 0x30, 0x06, 0x74, 0x05, 0x35, 0x06, 0x01, 0x05, 0x3b, 0x06,
+	0x74, 0x05, 0x0c, 0x11, 0x05, 0x20, 0x01, 0x05, 0x29, 0x06, 0x01, 0x05, 0x53, 0x2f, 0x05, 0x13,
+	0x06, 0x21, 0x05, 0x15, 0x01, 0x05, 0x2e, 0x01, 0x05, 0x36, 0x06, 0x01, 0x05, 0x46, 0x00, 0x02,
+	0x04, 0x01, 0x06, 0x9e, 0x00, 0x02, 0x04, 0x01, 0x01, 0x02, 0x02, 0x00, 0x01, 0x01, 0x91, 0x00,
+	0x00, 0x00, 0x04, 0x00, 0x1b, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01, 0xfb, 0x0e, 0x0d, 0x00, 0x01,
+	0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00, 0x62, 0x2e, 0x63, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x05, 0x1f, 0x00, 0x05, 0x02, 0xb9, 0x80, 0x04, 0x08, 0x15, 0x05, 0x21, 0x01,
+	0x05, 0x2c, 0x06, 0x01, 0x05, 0x35, 0x9e, 0x05, 0x2b, 0x06, 0x21, 0x06, 0x01, 0x05, 0x2d, 0x06,
+	0x82, 0x05, 0x38, 0x01, 0x05, 0x3f, 0x01, 0x05, 0x44, 0x06, 0x01, 0x05, 0x3f, 0x3c, 0x05, 0x31,
+	0x4a, 0x05, 0x48, 0x00, 0x02, 0x04, 0x03, 0x06, 0x58, 0x05, 0x53, 0x00, 0x02, 0x04, 0x03, 0x06,
+	0x01, 0x05, 0x4a, 0x00, 0x02, 0x04, 0x03, 0x3c, 0x05, 0x3f, 0x00, 0x02, 0x04, 0x03, 0x06, 0x3c,
+	0x05, 0x44, 0x00, 0x02, 0x04, 0x03, 0x06, 0x01, 0x05, 0x3f, 0x00, 0x02, 0x04, 0x03, 0x3c, 0x05,
+	0x61, 0x58, 0x2e, 0x05, 0x31, 0x20, 0x05, 0x57, 0x06, 0x58, 0x05, 0x5e, 0x06, 0x01, 0x02, 0x02,
+	0x00, 0x01, 0x01, 0x89, 0x00, 0x00, 0x00, 0x04, 0x00, 0x1b, 0x00, 0x00, 0x00, 0x01, 0x01, 0x01,
+	0xfb, 0x0e, 0x0d, 0x00, 0x01, 0x01, 0x01, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x01, 0x00,
+	0x63, 0x2e, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00, 0x05, 0x25, 0x00, 0x05, 0x02, 0xf0, 0x80, 0x04,
+	0x08, 0x14, 0x06, 0x01, 0x05, 0x27, 0x06, 0x66, 0x05, 0x37, 0x01, 0x05, 0x3c, 0x01, 0x05, 0x49,
+	0x01, 0x05, 0x30, 0x06, 0x9e, 0x05, 0x53, 0x00, 0x02, 0x04, 0x06, 0x06, 0x58, 0x05, 0x66, 0x00,
+	0x02, 0x04, 0x06, 0x06, 0x01, 0x05, 0x6e, 0x00, 0x02, 0x04, 0x06, 0x58, 0x05, 0x4e, 0x00, 0x02,
+	0x04, 0x06, 0x06, 0x66, 0x05, 0x49, 0x00, 0x02, 0x04, 0x06, 0x01, 0x05, 0x73, 0x00, 0x02, 0x04,
+	0x07, 0x74, 0x05, 0x7d, 0x00, 0x02, 0x04, 0x07, 0x06, 0x01, 0x05, 0x1f, 0x06, 0x59, 0x06, 0x01,
+	0x05, 0x21, 0x06, 0x4a, 0x05, 0x28, 0x06, 0x01, 0x05, 0x37, 0x9e, 0x02, 0x01, 0x00, 0x01, 0x01,
+	0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x70, 0x6f, 0x69, 0x6e, 0x74, 0x00, 0x63, 0x6f, 0x75,
+	0x6e, 0x74, 0x65, 0x72, 0x00, 0x47, 0x4e, 0x55, 0x20, 0x43, 0x31, 0x37, 0x20, 0x31, 0x32, 0x2e,
+	0x32, 0x2e, 0x30, 0x20, 0x2d, 0x6d, 0x33, 0x32, 0x20, 0x2d, 0x6d, 0x74, 0x75, 0x6e, 0x65, 0x3d,
+	0x67, 0x65, 0x6e, 0x65, 0x72, 0x69, 0x63, 0x20, 0x2d, 0x6d, 0x61, 0x72, 0x63, 0x68, 0x3d, 0x69,
+	0x36, 0x38, 0x36, 0x20, 0x2d, 0x67, 0x20, 0x2d, 0x67, 0x64, 0x77, 0x61, 0x72, 0x66, 0x2d, 0x34,
+	0x20, 0x2d, 0x4f, 0x31, 0x20, 0x2d, 0x66, 0x6e, 0x6f, 0x2d, 0x61, 0x73, 0x79, 0x6e, 0x63, 0x68,
+	0x72, 0x6f, 0x6e, 0x6f, 0x75, 0x73, 0x2d, 0x75, 0x6e, 0x77, 0x69, 0x6e, 0x64, 0x2d, 0x74, 0x61,
+	0x62, 0x6c, 0x65, 0x73, 0x20, 0x2d, 0x66, 0x6e, 0x6f, 0x2d, 0x70, 0x69, 0x65, 0x00, 0x73, 0x63,
+	0x61, 0x6c, 0x65, 0x00, 0x2f, 0x74, 0x6d, 0x70, 0x2f, 0x64, 0x77, 0x00, 0x75, 0x6e, 0x73, 0x69,
+	0x67, 0x6e, 0x65, 0x64, 0x20, 0x69, 0x6e, 0x74, 0x00, 0x76, 0x61, 0x6c, 0x75, 0x65, 0x00, 0x74,
+	0x6f, 0x5f, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x00, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x00, 0x69, 0x74,
+	0x65, 0x6d, 0x73, 0x00, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x00, 0x65, 0x6e, 0x74, 0x72, 0x79, 0x5f,
+	0x74, 0x00, 0x6d, 0x61, 0x73, 0x6b, 0x00, 0x65, 0x6e, 0x74, 0x72, 0x79, 0x5f, 0x6e, 0x61, 0x6d,
+	0x65, 0x00, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x5f, 0x66, 0x6c,
+	0x61, 0x67, 0x73, 0x00, 0x63, 0x68, 0x61, 0x72, 0x00, 0x01, 0x03, 0x16, 0x00, 0x00, 0x00, 0x16,
+	0x00, 0x00, 0x00, 0x01, 0x00, 0x52, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x03,
+	0x16, 0x00, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x01, 0x00, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x02,
+	0x00, 0x91, 0x00, 0x1f, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0x01, 0x00, 0x52, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b, 0x00, 0x00, 0x00,
+	0x16, 0x00, 0x00, 0x00, 0x02, 0x00, 0x91, 0x04, 0x16, 0x00, 0x00, 0x00, 0x2f, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x50, 0x30, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0x01, 0x00, 0x50, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00,
+	0x1f, 0x00, 0x00, 0x00, 0x02, 0x00, 0x30, 0x9f, 0x1f, 0x00, 0x00, 0x00, 0x2d, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x51, 0x30, 0x00, 0x00, 0x00, 0x37, 0x00, 0x00, 0x00, 0x02, 0x00, 0x30, 0x9f, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x15,
+	0x00, 0x00, 0x00, 0x02, 0x00, 0x30, 0x9f, 0x15, 0x00, 0x00, 0x00, 0x2c, 0x00, 0x00, 0x00, 0x01,
+	0x00, 0x52, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x06, 0x00, 0x00, 0x00,
+	0x15, 0x00, 0x00, 0x00, 0x02, 0x00, 0x30, 0x9f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x06, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x15, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0xf1, 0xff, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0xf1, 0xff, 0x09, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0xf1, 0xff, 0x0d, 0x00, 0x00, 0x00, 0xb9, 0x80, 0x04, 0x08,
+	0x0b, 0x00, 0x00, 0x00, 0x12, 0x00, 0x01, 0x00, 0x16, 0x00, 0x00, 0x00, 0xc4, 0x80, 0x04, 0x08,
+	0x2c, 0x00, 0x00, 0x00, 0x12, 0x00, 0x01, 0x00, 0x1a, 0x00, 0x00, 0x00, 0x60, 0x81, 0x04, 0x08,
+	0x30, 0x00, 0x00, 0x00, 0x11, 0x00, 0x03, 0x00, 0x38, 0x00, 0x00, 0x00, 0xad, 0x80, 0x04, 0x08,
+	0x0c, 0x00, 0x00, 0x00, 0x12, 0x00, 0x01, 0x00, 0x20, 0x00, 0x00, 0x00, 0x40, 0x81, 0x04, 0x08,
+	0x04, 0x00, 0x00, 0x00, 0x11, 0x00, 0x03, 0x00, 0x28, 0x00, 0x00, 0x00, 0x1c, 0x81, 0x04, 0x08,
+	0x0f, 0x00, 0x00, 0x00, 0x12, 0x00, 0x01, 0x00, 0x33, 0x00, 0x00, 0x00, 0x30, 0x81, 0x04, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x03, 0x00, 0x3f, 0x00, 0x00, 0x00, 0x2c, 0x81, 0x04, 0x08,
+	0x04, 0x00, 0x00, 0x00, 0x11, 0x00, 0x02, 0x00, 0x45, 0x00, 0x00, 0x00, 0xf0, 0x80, 0x04, 0x08,
+	0x2c, 0x00, 0x00, 0x00, 0x12, 0x00, 0x01, 0x00, 0x51, 0x00, 0x00, 0x00, 0x30, 0x81, 0x04, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x02, 0x00, 0x58, 0x00, 0x00, 0x00, 0x90, 0x81, 0x04, 0x08,
+	0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x03, 0x00, 0x5d, 0x00, 0x00, 0x00, 0x94, 0x80, 0x04, 0x08,
+	0x19, 0x00, 0x00, 0x00, 0x12, 0x00, 0x01, 0x00, 0x00, 0x61, 0x2e, 0x63, 0x00, 0x62, 0x2e, 0x63,
+	0x00, 0x63, 0x2e, 0x63, 0x00, 0x74, 0x6f, 0x5f, 0x66, 0x6c, 0x6f, 0x61, 0x74, 0x00, 0x73, 0x75,
+	0x6d, 0x00, 0x74, 0x61, 0x62, 0x6c, 0x65, 0x00, 0x63, 0x6f, 0x75, 0x6e, 0x74, 0x65, 0x72, 0x00,
+	0x65, 0x6e, 0x74, 0x72, 0x79, 0x5f, 0x6e, 0x61, 0x6d, 0x65, 0x00, 0x5f, 0x5f, 0x62, 0x73, 0x73,
+	0x5f, 0x73, 0x74, 0x61, 0x72, 0x74, 0x00, 0x72, 0x61, 0x74, 0x69, 0x6f, 0x00, 0x63, 0x6f, 0x75,
+	0x6e, 0x74, 0x5f, 0x66, 0x6c, 0x61, 0x67, 0x73, 0x00, 0x5f, 0x65, 0x64, 0x61, 0x74, 0x61, 0x00,
+	0x5f, 0x65, 0x6e, 0x64, 0x00, 0x73, 0x63, 0x61, 0x6c, 0x65, 0x00, 0x00, 0x2e, 0x73, 0x79, 0x6d,
+	0x74, 0x61, 0x62, 0x00, 0x2e, 0x73, 0x74, 0x72, 0x74, 0x61, 0x62, 0x00, 0x2e, 0x73, 0x68, 0x73,
+	0x74, 0x72, 0x74, 0x61, 0x62, 0x00, 0x2e, 0x74, 0x65, 0x78, 0x74, 0x00, 0x2e, 0x64, 0x61, 0x74,
+	0x61, 0x00, 0x2e, 0x62, 0x73, 0x73, 0x00, 0x2e, 0x64, 0x65, 0x62, 0x75, 0x67, 0x5f, 0x61, 0x72,
+	0x61, 0x6e, 0x67, 0x65, 0x73, 0x00, 0x2e, 0x64, 0x65, 0x62, 0x75, 0x67, 0x5f, 0x69, 0x6e, 0x66,
+	0x6f, 0x00, 0x2e, 0x64, 0x65, 0x62, 0x75, 0x67, 0x5f, 0x61, 0x62, 0x62, 0x72, 0x65, 0x76, 0x00,
+	0x2e, 0x64, 0x65, 0x62, 0x75, 0x67, 0x5f, 0x6c, 0x69, 0x6e, 0x65, 0x00, 0x2e, 0x64, 0x65, 0x62,
+	0x75, 0x67, 0x5f, 0x73, 0x74, 0x72, 0x00, 0x2e, 0x64, 0x65, 0x62, 0x75, 0x67, 0x5f, 0x6c, 0x6f,
+	0x63, 0x00, 0x2e, 0x64, 0x65, 0x62, 0x75, 0x67, 0x5f, 0x72, 0x61, 0x6e, 0x67, 0x65, 0x73, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1b, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x07, 0x00, 0x00, 0x00, 0x94, 0x80, 0x04, 0x08, 0x94, 0x00, 0x00, 0x00, 0x97, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x21, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x2c, 0x81, 0x04, 0x08,
+	0x2c, 0x01, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x27, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00,
+	0x03, 0x00, 0x00, 0x00, 0x40, 0x81, 0x04, 0x08, 0x40, 0x01, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x2c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x30, 0x01, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3b, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x90, 0x01, 0x00, 0x00, 0x39, 0x03, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x47, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xc9, 0x04, 0x00, 0x00, 0xe3, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x55, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xac, 0x07, 0x00, 0x00, 0x94, 0x01, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x61, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x40, 0x09, 0x00, 0x00, 0xe9, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x6c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x29, 0x0a, 0x00, 0x00, 0xe7, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x77, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x10, 0x0b, 0x00, 0x00, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28, 0x0b, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00,
+	0x0c, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
+	0x09, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x28, 0x0c, 0x00, 0x00, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x8b, 0x0c, 0x00, 0x00, 0x85, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+};
+
+template<typename T>
+std::string toJson(const T& value)
+{
+	rapidjson::StringBuffer buffer;
+	rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(buffer);
+	serdes::serialize(writer, value);
+	return buffer.GetString();
+}
+
+} // anonymous namespace
+
+class DwarfTests : public Test
+{
+	protected:
+		DwarfTests()
+		{
+			std::shared_ptr<fileformat::FileFormat> format = fileformat::createFileFormat(
+					dwarfElfBytes.data(),
+					dwarfElfBytes.size());
+			image = loader::createImage(format);
+		}
+
+		/**
+		 * Load debug information of the test file by @a jobs jobs.
+		 * One job loads the compile units serially without a thread pool.
+		 */
+		std::unique_ptr<DebugFormat> load(std::size_t jobs)
+		{
+			std::unique_ptr<utils::ThreadPool> pool;
+			if (jobs > 1)
+			{
+				pool = std::make_unique<utils::ThreadPool>(jobs);
+			}
+			return std::make_unique<DebugFormat>(
+					image.get(),
+					"",
+					nullptr,
+					&demangler,
+					pool.get());
+		}
+
+		/**
+		 * Get all functions of @a debug serialized in the order of their
+		 * addresses.
+		 */
+		std::vector<std::string> getFunctions(const DebugFormat& debug)
+		{
+			std::vector<std::string> result;
+			for (const auto& p : debug.functions)
+			{
+				result.push_back(toJson(p.second));
+			}
+			return result;
+		}
+
+		std::vector<std::string> getGlobals(const DebugFormat& debug)
+		{
+			std::vector<std::string> result;
+			for (const auto& global : debug.globals)
+			{
+				result.push_back(toJson(global));
+			}
+			return result;
+		}
+
+		std::set<std::string> getTypes(const DebugFormat& debug)
+		{
+			std::set<std::string> result;
+			for (const auto& type : debug.types)
+			{
+				result.insert(type.getLlvmIr());
+			}
+			return result;
+		}
+
+	protected:
+		std::unique_ptr<loader::Image> image;
+		demangler::ItaniumDemangler demangler;
+};
+
+TEST_F(DwarfTests, FunctionsAreLoadedWithTheirSourceLines)
+{
+	ASSERT_NE(nullptr, image);
+	auto debug = load(1);
+
+	ASSERT_TRUE(debug->hasInformation());
+	std::map<std::string, const common::Function*> functions;
+	for (const auto& p : debug->functions)
+	{
+		functions[p.second.getName()] = &p.second;
+	}
+
+	ASSERT_EQ(1, functions.count("scale"));
+	EXPECT_THAT(functions["scale"]->getSourceFileName(), EndsWith("a.c"));
+	EXPECT_EQ(4, functions["scale"]->getStartLine());
+	EXPECT_EQ(2, functions["scale"]->parameters.size());
+	ASSERT_EQ(1, functions.count("to_float"));
+	EXPECT_THAT(functions["to_float"]->getSourceFileName(), EndsWith("b.c"));
+	EXPECT_EQ(4, functions["to_float"]->getStartLine());
+	ASSERT_EQ(1, functions.count("count_flags"));
+	EXPECT_THAT(functions["count_flags"]->getSourceFileName(), EndsWith("c.c"));
+	EXPECT_EQ(3, functions["count_flags"]->getStartLine());
+
+	EXPECT_NE(nullptr, debug->globals.getObjectByName("counter"));
+	EXPECT_NE(nullptr, debug->globals.getObjectByName("ratio"));
+	EXPECT_NE(nullptr, debug->globals.getObjectByName("table"));
+}
+
+TEST_F(DwarfTests, ParallelLoadingGivesSameResultsAsSerialLoading)
+{
+	ASSERT_NE(nullptr, image);
+	auto serial = load(1);
+
+	for (std::size_t jobs : {2, 3, 8})
+	{
+		auto parallel = load(jobs);
+
+		EXPECT_EQ(getFunctions(*serial), getFunctions(*parallel)) << jobs << " jobs";
+		EXPECT_EQ(getGlobals(*serial), getGlobals(*parallel)) << jobs << " jobs";
+		EXPECT_EQ(getTypes(*serial), getTypes(*parallel)) << jobs << " jobs";
+	}
+}
+
+TEST_F(DwarfTests, RepeatedParallelLoadingGivesSameResults)
+{
+	ASSERT_NE(nullptr, image);
+	auto first = load(4);
+
+	for (int i = 0; i < 10; ++i)
+	{
+		auto next = load(4);
+
+		EXPECT_EQ(getFunctions(*first), getFunctions(*next));
+		EXPECT_EQ(getGlobals(*first), getGlobals(*next));
+		EXPECT_EQ(getTypes(*first), getTypes(*next));
+	}
+}
+
+} // namespace tests
+} // namespace debugformat
+} // namespace retdec
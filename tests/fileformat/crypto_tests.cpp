@@ -0,0 +1,72 @@
+/**
+* @file tests/fileformat/crypto_tests.cpp
+* @brief Tests for the @c crypto module.
+* @copyright (c) 2020 Avast Software, licensed under the MIT license
+*/
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/utils/crypto.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for the @c crypto module.
+ */
+class CryptoTests : public Test
+{
+	protected:
+		void checkFusedHashes(const std::vector<unsigned char> &data)
+		{
+			std::string crc32, md5, sha256;
+			getCrc32Md5Sha256(data.data(), data.size(), crc32, md5, sha256);
+
+			EXPECT_EQ(getCrc32(data.data(), data.size()), crc32);
+			EXPECT_EQ(getMd5(data.data(), data.size()), md5);
+			EXPECT_EQ(getSha256(data.data(), data.size()), sha256);
+		}
+};
+
+TEST_F(CryptoTests, FusedHashesOfKnownInputAreCorrect)
+{
+	const std::string text = "abc";
+	std::string crc32, md5, sha256;
+
+	getCrc32Md5Sha256(
+			reinterpret_cast<const unsigned char*>(text.data()),
+			text.size(),
+			crc32,
+			md5,
+			sha256);
+
+	EXPECT_EQ("352441c2", crc32);
+	EXPECT_EQ("900150983cd24fb0d6963f7d28e17f72", md5);
+	EXPECT_EQ("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", sha256);
+}
+
+TEST_F(CryptoTests, FusedHashesOfEmptyInputAreSameAsSeparateOnes)
+{
+	checkFusedHashes({});
+}
+
+TEST_F(CryptoTests, FusedHashesOfInputSpanningMultipleChunksAreSameAsSeparateOnes)
+{
+	std::vector<unsigned char> data(300 * 1024 + 7);
+	for (std::size_t i = 0; i < data.size(); ++i)
+	{
+		data[i] = static_cast<unsigned char>(i * 31 + (i >> 8));
+	}
+
+	checkFusedHashes(data);
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -4,6 +4,8 @@
 * @copyright (c) 2019 Avast Software, licensed under the MIT license
 */
 
+#include <filesystem>
+#include <fstream>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -204,6 +206,52 @@ TEST_F(PeFormatTests_data, DataInterpretationDefault)
 	EXPECT_EQ(0x105d0040103805c7, res);
 }
 
+/**
+ * Tests for the @c pe_format module - using file constructor, which maps
+ * the input file into memory.
+ */
+class PeFormatTests_file : public Test
+{
+	private:
+		std::filesystem::path path;
+	protected:
+		std::unique_ptr<PeFormat> parser;
+	public:
+		PeFormatTests_file()
+		{
+			path = std::filesystem::temp_directory_path() / "retdec-pe-format-test.exe";
+			std::ofstream(path, std::ios::binary).write(
+					reinterpret_cast<const char*>(peBytes.data()),
+					peBytes.size());
+			parser = std::make_unique<PeFormat>(path.string(), "");
+		}
+
+		~PeFormatTests_file()
+		{
+			parser.reset();
+			std::error_code ec;
+			std::filesystem::remove(path, ec);
+		}
+};
+
+TEST_F(PeFormatTests_file, CorrectParsing)
+{
+	EXPECT_EQ(true, parser->isInValidState());
+	EXPECT_EQ(peBytes.size(), parser->getFileLength());
+	ASSERT_EQ(1, parser->getNumberOfSections());
+	EXPECT_EQ(0x401000, parser->getSection(0)->getAddress());
+	EXPECT_EQ(0x200, parser->getSection(0)->getOffset());
+}
+
+TEST_F(PeFormatTests_file, DataInterpretationDefault)
+{
+	std::uint64_t res;
+	EXPECT_EQ(true, parser->get4Byte(0x401000, res));
+	EXPECT_EQ(0x103805c7, res);
+	EXPECT_EQ(true, parser->get8Byte(0x401000, res));
+	EXPECT_EQ(0x105d0040103805c7, res);
+}
+
 } // namespace tests
 } // namespace fileformat
 } // namespace retdec
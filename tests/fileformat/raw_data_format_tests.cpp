@@ -84,6 +84,27 @@ TEST_F(RawDataFormatTests_istream, TestInvalidEP)
 	EXPECT_EQ(0x8000, result);
 }
 
+TEST_F(RawDataFormatTests_istream, SectionLookupFollowsChangeOfAddress)
+{
+	parser->setBaseAddress(0x8000);
+	EXPECT_EQ(parser->getSections()[0], parser->getSectionFromAddress(0x8002));
+
+	parser->setBaseAddress(0x9000);
+	EXPECT_EQ(nullptr, parser->getSectionFromAddress(0x8002));
+	EXPECT_EQ(parser->getSections()[0], parser->getSectionFromAddress(0x9002));
+}
+
+TEST_F(RawDataFormatTests_istream, ChangeOfCopiedSectionDoesNotChangeSectionLookup)
+{
+	parser->setBaseAddress(0x8000);
+	EXPECT_EQ(parser->getSections()[0], parser->getSectionFromAddress(0x8002));
+
+	Section copy(*parser->getSections()[0]);
+	copy.setAddress(0x9000);
+	EXPECT_EQ(parser->getSections()[0], parser->getSectionFromAddress(0x8002));
+	EXPECT_EQ(nullptr, parser->getSectionFromAddress(0x9002));
+}
+
 /**
  * Tests for the @c raw_data module - using istream constructor.
  */
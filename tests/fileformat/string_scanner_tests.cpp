@@ -0,0 +1,124 @@
+/**
+* @file tests/fileformat/string_scanner_tests.cpp
+* @brief Tests for the @c string_scanner module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/fileformat/types/strings/string_scanner.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileformat {
+namespace tests {
+
+/**
+ * Tests for the @c string_scanner module.
+ */
+class StringScannerTests : public Test
+{
+	protected:
+		std::vector<String> scan(
+				const std::string& data,
+				CharacterEndianness endian = CharacterEndianness::Little,
+				StringScanner::Implementation implementation = StringScanner::getBestImplementation())
+		{
+			std::vector<String> strings;
+			StringScanner(4, endian, implementation).scan(
+					reinterpret_cast<const std::uint8_t*>(data.data()),
+					data.size(),
+					0x100,
+					".data",
+					strings);
+			std::sort(strings.begin(), strings.end());
+			return strings;
+		}
+};
+
+TEST_F(StringScannerTests, AsciiStringsAreFound)
+{
+	auto strings = scan(std::string("\x01hello\0abc\0world!\xff", 19));
+
+	ASSERT_EQ(2, strings.size());
+	EXPECT_EQ(String(StringType::Ascii, 0x101, ".data", "hello"), strings[0]);
+	EXPECT_EQ(String(StringType::Ascii, 0x10b, ".data", "world!"), strings[1]);
+	EXPECT_EQ(".data", strings[0].getSectionName());
+}
+
+TEST_F(StringScannerTests, LittleEndianWideStringsAreFound)
+{
+	auto strings = scan(std::string("\x01w\0i\0d\0e\0\0\0", 12));
+
+	ASSERT_EQ(1, strings.size());
+	EXPECT_EQ(String(StringType::Wide, 0x101, ".data", "wide"), strings[0]);
+}
+
+TEST_F(StringScannerTests, BigEndianWideStringsAreFound)
+{
+	auto strings = scan(std::string("\x01\0w\0i\0d\0e\x01", 11), CharacterEndianness::Big);
+
+	ASSERT_EQ(1, strings.size());
+	EXPECT_EQ(String(StringType::Wide, 0x101, ".data", "wide"), strings[0]);
+}
+
+TEST_F(StringScannerTests, WideCharacterCannotReachBehindEndOfData)
+{
+	auto strings = scan(std::string("w\0i\0d\0e", 7));
+
+	EXPECT_TRUE(strings.empty());
+}
+
+TEST_F(StringScannerTests, StringsCrossingBlocksAndReachingEndAreFound)
+{
+	std::string data(60, '\x01');
+	data += std::string(70, 'a');
+	data += std::string(126, '\x01');
+	for (auto c : std::string("wide"))
+		data += std::string{c, '\0'};
+
+	auto strings = scan(data);
+
+	ASSERT_EQ(2, strings.size());
+	EXPECT_EQ(String(StringType::Ascii, 0x100 + 60, ".data", std::string(70, 'a')), strings[0]);
+	EXPECT_EQ(String(StringType::Wide, 0x100 + 256, ".data", "wide"), strings[1]);
+}
+
+TEST_F(StringScannerTests, ShortStringsAreIgnored)
+{
+	auto strings = scan(std::string("abc\x01" "a\0b\0c\0", 10));
+
+	EXPECT_TRUE(strings.empty());
+}
+
+TEST_F(StringScannerTests, AllImplementationsFindSameStrings)
+{
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> distribution(0, 9);
+	std::string data;
+	for (std::size_t i = 0; i < 100000; ++i)
+	{
+		// Mostly printable characters and zeros, so that there are many
+		// strings of both types.
+		auto r = distribution(generator);
+		data.push_back(r < 5 ? static_cast<char>('a' + r) : r < 8 ? '\0' : static_cast<char>(r * 20));
+	}
+
+	for (auto endian : {CharacterEndianness::Little, CharacterEndianness::Big})
+	{
+		auto expected = scan(data, endian, StringScanner::Implementation::Scalar);
+		EXPECT_FALSE(expected.empty());
+		EXPECT_EQ(expected, scan(data, endian, StringScanner::Implementation::Sse2));
+		EXPECT_EQ(expected, scan(data, endian, StringScanner::Implementation::Avx2));
+	}
+}
+
+} // namespace tests
+} // namespace fileformat
+} // namespace retdec
@@ -0,0 +1,325 @@
+/**
+ * @file tests/fileinfo/batch_processor/batch_processor_tests.cpp
+ * @brief Tests for the @c batch_processor module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/utils/os.h"
+#include "fileinfo/batch_processor/batch_processor.h"
+#include "utils/temporary_directory.h"
+
+#ifdef OS_POSIX
+	#include <cerrno>
+	#include <signal.h>
+	#include <unistd.h>
+#endif
+
+using namespace ::testing;
+
+namespace retdec {
+namespace fileinfo {
+namespace tests {
+
+namespace {
+
+/**
+ * Analysis which returns the path to the file as its only information.
+ */
+std::string getPathRecord(const std::string& filePath)
+{
+	return "{\"inputFile\":\"" + filePath + "\"}";
+}
+
+} // anonymous namespace
+
+class BatchProcessorTests : public Test
+{
+	protected:
+		/**
+		 * Process @a files by @a processor.
+		 * @return Printed lines sorted alphabetically.
+		 */
+		std::vector<std::string> process(
+				BatchProcessor& processor,
+				const std::vector<std::string>& files,
+				std::size_t expectedFailures = 0)
+		{
+			std::ostringstream out;
+			EXPECT_EQ(expectedFailures, processor.process(files, out));
+
+			std::vector<std::string> lines;
+			std::istringstream in(out.str());
+			for (std::string line; std::getline(in, line);)
+			{
+				lines.push_back(line);
+			}
+			std::sort(lines.begin(), lines.end());
+			return lines;
+		}
+
+		/**
+		 * Parse @a line as JSON object and get its only error message.
+		 */
+		std::string getErrorMessage(const std::string& line)
+		{
+			rapidjson::Document doc;
+			doc.Parse(line);
+			if (doc.HasParseError() || !doc.IsObject() || !doc.HasMember("errors")
+					|| !doc["errors"].IsArray() || doc["errors"].Size() != 1)
+			{
+				return "invalid error record: " + line;
+			}
+			return doc["errors"][0].GetString();
+		}
+
+		std::string writeFile(const std::string& name, const std::string& content)
+		{
+			const auto path = directory / name;
+			fs::create_directories(path.parent_path());
+			std::ofstream(path.string(), std::ios::binary) << content;
+			return path.string();
+		}
+
+	protected:
+		const utils::tests::TemporaryDirectory directory{
+				"retdec-fileinfo-tests"};
+};
+
+TEST_F(BatchProcessorTests, ResultOfEveryFileIsPrintedOnOneLine)
+{
+	BatchProcessor processor(getPathRecord, 2, std::chrono::seconds(0));
+
+	auto lines = process(processor, {"c", "a", "b", "e", "d"});
+
+	EXPECT_EQ(
+			std::vector<std::string>({
+				getPathRecord("a"),
+				getPathRecord("b"),
+				getPathRecord("c"),
+				getPathRecord("d"),
+				getPathRecord("e"),
+			}),
+			lines);
+}
+
+TEST_F(BatchProcessorTests, NoFilesPrintNothing)
+{
+	BatchProcessor processor(getPathRecord, 2, std::chrono::seconds(0));
+
+	EXPECT_TRUE(process(processor, {}).empty());
+}
+
+TEST_F(BatchProcessorTests, ExceptionOfAnalysisGivesErrorRecordAndOtherFilesAreProcessed)
+{
+	BatchProcessor processor(
+			[](const std::string& filePath) -> std::string {
+				if (filePath == "bad")
+				{
+					throw std::runtime_error("broken file");
+				}
+				return getPathRecord(filePath);
+			},
+			2,
+			std::chrono::seconds(0));
+
+	auto lines = process(processor, {"a", "bad", "b"}, 1);
+
+	ASSERT_EQ(3, lines.size());
+	EXPECT_EQ(getPathRecord("a"), lines[0]);
+	EXPECT_EQ(getPathRecord("b"), lines[1]);
+	EXPECT_EQ("Analysis failed: broken file", getErrorMessage(lines[2]));
+}
+
+TEST_F(BatchProcessorTests, AtMostJobsFilesAreAnalyzedAtOnce)
+{
+	const auto running = directory / "running";
+	BatchProcessor processor(
+			[&running](const std::string& filePath) -> std::string {
+				if (fs::exists(running))
+				{
+					return "overlap";
+				}
+				std::ofstream(running.string()) << filePath;
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+				fs::remove(running);
+				return getPathRecord(filePath);
+			},
+			1,
+			std::chrono::seconds(0));
+
+	auto lines = process(processor, {"a", "b", "c", "d"});
+
+	EXPECT_EQ(
+			std::vector<std::string>({
+				getPathRecord("a"),
+				getPathRecord("b"),
+				getPathRecord("c"),
+				getPathRecord("d"),
+			}),
+			lines);
+}
+
+#ifdef OS_POSIX
+
+TEST_F(BatchProcessorTests, FinishCurrentFilePrintsGivenResult)
+{
+	BatchProcessor processor(
+			[](const std::string& filePath) -> std::string {
+				if (filePath == "fatal")
+				{
+					BatchProcessor::finishCurrentFile(
+							BatchProcessor::getErrorRecord(filePath, "Fatal error."));
+				}
+				return getPathRecord(filePath);
+			},
+			1,
+			std::chrono::seconds(0));
+
+	auto lines = process(processor, {"fatal", "a"}, 1);
+
+	ASSERT_EQ(2, lines.size());
+	EXPECT_EQ(getPathRecord("a"), lines[0]);
+	EXPECT_EQ("Fatal error.", getErrorMessage(lines[1]));
+}
+
+TEST_F(BatchProcessorTests, CrashOfAnalysisGivesErrorRecordAndOtherFilesAreProcessed)
+{
+	BatchProcessor processor(
+			[](const std::string& filePath) -> std::string {
+				if (filePath == "crash")
+				{
+					std::abort();
+				}
+				return getPathRecord(filePath);
+			},
+			2,
+			std::chrono::seconds(0));
+
+	auto lines = process(processor, {"a", "crash", "b"}, 1);
+
+	ASSERT_EQ(3, lines.size());
+	EXPECT_EQ(getPathRecord("a"), lines[0]);
+	EXPECT_EQ(getPathRecord("b"), lines[1]);
+	EXPECT_EQ(
+			"Analysis crashed with signal " + std::to_string(SIGABRT) + ".",
+			getErrorMessage(lines[2]));
+}
+
+TEST_F(BatchProcessorTests, AnalysisExceedingTimeoutIsKilled)
+{
+	const auto pidFile = directory / "pid";
+	BatchProcessor processor(
+			[&pidFile](const std::string& filePath) -> std::string {
+				if (filePath == "slow")
+				{
+					std::ofstream(pidFile.string()) << getpid();
+					while (true)
+					{
+						std::this_thread::sleep_for(std::chrono::hours(1));
+					}
+				}
+				return getPathRecord(filePath);
+			},
+			2,
+			std::chrono::seconds(1));
+
+	auto start = std::chrono::steady_clock::now();
+	auto lines = process(processor, {"a", "slow", "b", "c"}, 1);
+	auto duration = std::chrono::steady_clock::now() - start;
+
+	ASSERT_EQ(4, lines.size());
+	EXPECT_EQ(getPathRecord("a"), lines[0]);
+	EXPECT_EQ(getPathRecord("b"), lines[1]);
+	EXPECT_EQ(getPathRecord("c"), lines[2]);
+	EXPECT_EQ("Analysis timed out after 1 seconds.", getErrorMessage(lines[3]));
+	EXPECT_LT(duration, std::chrono::seconds(30));
+
+	// The child has been killed and waited for.
+	pid_t pid = 0;
+	std::ifstream(pidFile.string()) >> pid;
+	ASSERT_NE(0, pid);
+	EXPECT_NE(0, kill(pid, 0));
+	EXPECT_EQ(ESRCH, errno);
+}
+
+TEST_F(BatchProcessorTests, LongResultIsReadWhole)
+{
+	const std::string padding(1024 * 1024, 'x');
+	BatchProcessor processor(
+			[&padding](const std::string& filePath) {
+				return "{\"inputFile\":\"" + filePath + "\",\"padding\":\"" + padding + "\"}";
+			},
+			2,
+			std::chrono::seconds(0));
+
+	auto lines = process(processor, {"a", "b"});
+
+	ASSERT_EQ(2, lines.size());
+	for (const auto& line : lines)
+	{
+		rapidjson::Document doc;
+		doc.Parse(line);
+		ASSERT_FALSE(doc.HasParseError());
+		EXPECT_EQ(padding.size(), doc["padding"].GetStringLength());
+	}
+}
+
+#endif
+
+TEST_F(BatchProcessorTests, ErrorRecordIsOneLineOfJson)
+{
+	auto record = BatchProcessor::getErrorRecord("dir/\"file\"\n", "Message\nwith \"quotes\".");
+
+	EXPECT_EQ(std::string::npos, record.find('\n'));
+	rapidjson::Document doc;
+	doc.Parse(record);
+	ASSERT_FALSE(doc.HasParseError());
+	ASSERT_TRUE(doc.IsObject());
+	ASSERT_TRUE(doc.HasMember("inputFile"));
+	EXPECT_EQ(std::string::npos, std::string(doc["inputFile"].GetString()).find('\n'));
+	EXPECT_EQ("Message\nwith \"quotes\".", getErrorMessage(record));
+}
+
+TEST_F(BatchProcessorTests, InputFilesAreFilesOfDirectoryAndItsSubdirectories)
+{
+	auto b = writeFile("b", "");
+	auto a = writeFile("sub/a", "");
+	auto c = writeFile("sub/sub/c", "");
+
+	std::vector<std::string> files;
+	ASSERT_TRUE(BatchProcessor::getInputFiles(directory.getPath().string(), files));
+
+	std::vector<std::string> expected = {a, b, c};
+	std::sort(expected.begin(), expected.end());
+	EXPECT_EQ(expected, files);
+}
+
+TEST_F(BatchProcessorTests, InputFilesAreNonEmptyTrimmedLinesOfList)
+{
+	auto list = writeFile("list", "  a \n\nb\r\n \nsub/c\n");
+
+	std::vector<std::string> files;
+	ASSERT_TRUE(BatchProcessor::getInputFiles(list, files));
+
+	EXPECT_EQ(std::vector<std::string>({"a", "b", "sub/c"}), files);
+}
+
+TEST_F(BatchProcessorTests, InputFilesOfNonexistentListAreNotObtained)
+{
+	std::vector<std::string> files;
+	EXPECT_FALSE(BatchProcessor::getInputFiles((directory / "missing").string(), files));
+}
+
+} // namespace tests
+} // namespace fileinfo
+} // namespace retdec
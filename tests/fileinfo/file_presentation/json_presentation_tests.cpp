@@ -0,0 +1,149 @@
+/**
+ * @file tests/fileinfo/file_presentation/json_presentation_tests.cpp
+ * @brief Tests for the @c json_presentation module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <rapidjson/document.h>
+
+#include "retdec/utils/memory.h"
+#include "retdec/utils/string.h"
+#include "fileinfo/file_information/file_information.h"
+#include "fileinfo/file_presentation/json_presentation.h"
+
+using namespace ::testing;
+using namespace retdec::cpdetect;
+
+namespace retdec {
+namespace fileinfo {
+namespace tests {
+
+class JsonPresentationTests : public Test
+{
+	protected:
+		JsonPresentationTests()
+		{
+			fileinfo.setPathToFile("dir/file\nwith \"line break\"");
+			fileinfo.setStatus(ReturnCode::FORMAT_PARSER_PROBLEM);
+			fileinfo.messages.push_back("Warning: first line\nsecond line");
+		}
+
+		std::string present(bool verbose, bool singleLine)
+		{
+			std::ostringstream out;
+			EXPECT_TRUE(JsonPresentation(fileinfo, verbose, singleLine).present(out));
+			return out.str();
+		}
+
+	protected:
+		FileInformation fileinfo;
+};
+
+TEST_F(JsonPresentationTests, SingleLineDocumentHasNoLineBreaks)
+{
+	for (bool verbose : {false, true})
+	{
+		auto json = present(verbose, true);
+
+		EXPECT_FALSE(json.empty());
+		EXPECT_EQ(std::string::npos, json.find('\n')) << json;
+		EXPECT_EQ(std::string::npos, json.find('\r')) << json;
+	}
+}
+
+TEST_F(JsonPresentationTests, SingleLineDocumentIsSameAsPrettyDocument)
+{
+	for (bool verbose : {false, true})
+	{
+		rapidjson::Document singleLine;
+		singleLine.Parse(present(verbose, true));
+		rapidjson::Document pretty;
+		pretty.Parse(present(verbose, false));
+
+		ASSERT_FALSE(singleLine.HasParseError());
+		ASSERT_FALSE(pretty.HasParseError());
+		EXPECT_TRUE(singleLine == pretty);
+	}
+}
+
+TEST_F(JsonPresentationTests, SingleLineDocumentContainsInputFileAndMessages)
+{
+	rapidjson::Document doc;
+	doc.Parse(present(false, true));
+
+	ASSERT_FALSE(doc.HasParseError());
+	ASSERT_TRUE(doc.IsObject());
+	ASSERT_TRUE(doc.HasMember("inputFile"));
+	EXPECT_EQ(
+			utils::replaceNonprintableChars(fileinfo.getPathToFile()),
+			doc["inputFile"].GetString());
+	ASSERT_TRUE(doc.HasMember("warnings"));
+	ASSERT_EQ(1, doc["warnings"].Size());
+	EXPECT_STREQ("First line\nsecond line.", doc["warnings"][0].GetString());
+}
+
+/**
+ * Stream buffer that only counts the written characters.
+ */
+class CountingBuffer : public std::streambuf
+{
+	public:
+		std::size_t count = 0;
+
+	protected:
+		int_type overflow(int_type c) override
+		{
+			++count;
+			return traits_type::not_eof(c);
+		}
+
+		std::streamsize xsputn(const char*, std::streamsize n) override
+		{
+			count += n;
+			return n;
+		}
+};
+
+TEST_F(JsonPresentationTests, PresentationOfMillionsOfStringsDoesNotKeepOutputInMemory)
+{
+	const std::size_t count = 2 * 1024 * 1024;
+	std::vector<fileformat::String> strings;
+	strings.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		strings.emplace_back(
+				i % 2 ? fileformat::StringType::Ascii : fileformat::StringType::Wide,
+				i * 16,
+				".data",
+				"string number " + std::to_string(i));
+	}
+	fileinfo.setStrings(&strings);
+
+	if (!utils::resetPeakProcessMemoryUsage())
+	{
+		GTEST_SKIP() << "peak memory usage cannot be reset on this system";
+	}
+	auto before = utils::getPeakProcessMemoryUsage();
+	CountingBuffer buffer;
+	std::ostream out(&buffer);
+	ASSERT_TRUE(JsonPresentation(fileinfo, false, true).present(out));
+	auto growth = utils::getPeakProcessMemoryUsage() - before;
+
+	// The strings are presented from the records of the file format, so only
+	// a small fraction of the (hundreds of megabytes large) output may be held
+	// in memory at any time.
+	ASSERT_GT(buffer.count, count * 32);
+	EXPECT_LT(growth, buffer.count / 8) << "output: " << buffer.count;
+}
+
+} // namespace tests
+} // namespace fileinfo
+} // namespace retdec
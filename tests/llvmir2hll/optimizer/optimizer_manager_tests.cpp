@@ -0,0 +1,180 @@
+/**
+* @file tests/llvmir2hll/optimizer/optimizer_manager_tests.cpp
+* @brief Tests for the @c optimizer_manager module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include "retdec/llvmir2hll/analysis/alias_analysis/alias_analyses/simple_alias_analysis.h"
+#include "retdec/llvmir2hll/analysis/value_analysis.h"
+#include "retdec/llvmir2hll/evaluator/arithm_expr_evaluators/strict_arithm_expr_evaluator.h"
+#include "retdec/llvmir2hll/hll/hll_writers/c_hll_writer.h"
+#include "llvmir2hll/hll/hll_writers/hll_writer_tests.h"
+#include "retdec/llvmir2hll/ir/add_op_expr.h"
+#include "retdec/llvmir2hll/ir/assign_stmt.h"
+#include "retdec/llvmir2hll/ir/break_stmt.h"
+#include "retdec/llvmir2hll/ir/const_bool.h"
+#include "retdec/llvmir2hll/ir/const_int.h"
+#include "retdec/llvmir2hll/ir/function.h"
+#include "retdec/llvmir2hll/ir/gt_eq_op_expr.h"
+#include "retdec/llvmir2hll/ir/if_stmt.h"
+#include "retdec/llvmir2hll/ir/int_type.h"
+#include "retdec/llvmir2hll/ir/module.h"
+#include "retdec/llvmir2hll/ir/return_stmt.h"
+#include "retdec/llvmir2hll/ir/var_def_stmt.h"
+#include "retdec/llvmir2hll/ir/variable.h"
+#include "retdec/llvmir2hll/ir/void_type.h"
+#include "retdec/llvmir2hll/ir/while_loop_stmt.h"
+#include "llvmir2hll/obtainer/call_info_obtainer_mock.h"
+#include "retdec/llvmir2hll/optimizer/optimizer_manager.h"
+#include "retdec/utils/pass_profiler.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace llvmir2hll {
+namespace tests {
+
+/**
+* @brief Tests for the @c optimizer_manager module.
+*
+* HLLWriterTests is used as the base class because it sets up the mocks needed
+* to emit the optimized code.
+*/
+class OptimizerManagerTests: public HLLWriterTests {
+protected:
+	ShPtr<Module> createModuleWithFuncs(std::size_t funcCount);
+	std::string optimizeAndEmit(ShPtr<Module> m, std::size_t jobs);
+};
+
+/**
+* @brief Creates a new module with @a funcCount functions.
+*
+* Every function has the following body, where @c g is a global variable
+* shared by all the functions and @c N depends on the function:
+* @code
+* int i = 0;
+* int x = g + 0;
+* while (true) {
+*     x = x + i;
+*     if (i >= N) {
+*         break;
+*     }
+*     i = i + 1;
+* }
+* g = x;
+* return;
+* @endcode
+*/
+ShPtr<Module> OptimizerManagerTests::createModuleWithFuncs(
+		std::size_t funcCount) {
+	auto m = std::make_shared<Module>(&llvmModule,
+		llvmModule.getModuleIdentifier(), semanticsMock, configMock);
+	auto g = Variable::create("g", IntType::create(32));
+	m->addGlobalVar(g, ConstInt::create(0, 32));
+
+	for (std::size_t n = 0; n < funcCount; ++n) {
+		auto i = Variable::create("i", IntType::create(32));
+		auto x = Variable::create("x", IntType::create(32));
+		auto loopBody = AssignStmt::create(x, AddOpExpr::create(x, i),
+			IfStmt::create(
+				GtEqOpExpr::create(i, ConstInt::create(n + 5, 32)),
+				BreakStmt::create(),
+				AssignStmt::create(i,
+					AddOpExpr::create(i, ConstInt::create(1, 32)))));
+		auto body = VarDefStmt::create(i, ConstInt::create(0, 32),
+			VarDefStmt::create(x, AddOpExpr::create(g, ConstInt::create(0, 32)),
+				WhileLoopStmt::create(ConstBool::create(true), loopBody,
+					AssignStmt::create(g, x, ReturnStmt::create()))));
+		m->addFunc(Function::create(m, VoidType::create(),
+			"func" + std::to_string(n), VarVector(), VarSet({i, x}), body));
+	}
+	return m;
+}
+
+/**
+* @brief Optimizes @a m by function-local optimizations using @a jobs threads
+*        and returns the emitted code.
+*/
+std::string OptimizerManagerTests::optimizeAndEmit(ShPtr<Module> m,
+		std::size_t jobs) {
+	INSTANTIATE_CALL_INFO_OBTAINER_MOCK();
+	auto aliasAnalysis = SimpleAliasAnalysis::create();
+	aliasAnalysis->init(m);
+	auto va = ValueAnalysis::create(aliasAnalysis, true);
+
+	std::string code;
+	llvm::raw_string_ostream codeStream(code);
+	auto hllWriter = CHLLWriter::create(codeStream);
+
+	// Only optimizations that are run in parallel are enabled, so the
+	// (serial) copy propagation does not need a real call info obtainer.
+	OptimizerManager optimizerManager(
+		StringSet{
+			"EmptyStmt", "GotoStmt", "RemoveUselessCasts",
+			"SimplifyArithmExpr", "IfStructure", "LoopLastContinue",
+			"PreWhileTrueLoopConv", "WhileTrueToForLoop",
+			"WhileTrueToWhileCond", "IfBeforeLoop", "VoidReturn",
+			"BreakContinueReturn", "DerefAddress", "SelfAssign",
+			"VarDefForLoop"
+		},
+		StringSet(), hllWriter, va, cio, StrictArithmExprEvaluator::create(),
+		false, jobs);
+	optimizerManager.optimize(m);
+
+	hllWriter->emitTargetCode(m);
+	return codeStream.str();
+}
+
+TEST_F(OptimizerManagerTests,
+ParallelOptimizationGivesSameCodeAsSerialOptimization) {
+	const std::size_t FUNC_COUNT = 32;
+	auto serialCode = optimizeAndEmit(createModuleWithFuncs(FUNC_COUNT), 1);
+	ASSERT_FALSE(serialCode.empty());
+
+	for (std::size_t jobs : {2, 4, 8}) {
+		auto parallelCode = optimizeAndEmit(
+			createModuleWithFuncs(FUNC_COUNT), jobs);
+
+		EXPECT_EQ(serialCode, parallelCode) << jobs << " jobs";
+	}
+}
+
+TEST_F(OptimizerManagerTests,
+OptimizationsAreProfiledInCategoryDependingOnWhetherTheyMayBeRunInParallel) {
+	for (std::size_t jobs : {1, 4}) {
+		INSTANTIATE_CALL_INFO_OBTAINER_MOCK();
+		auto m = createModuleWithFuncs(4);
+		auto aliasAnalysis = SimpleAliasAnalysis::create();
+		aliasAnalysis->init(m);
+		std::string code;
+		llvm::raw_string_ostream codeStream(code);
+		OptimizerManager optimizerManager(
+			StringSet{"GotoStmt", "UnusedGlobalVar"}, StringSet(),
+			CHLLWriter::create(codeStream),
+			ValueAnalysis::create(aliasAnalysis, true), cio,
+			StrictArithmExprEvaluator::create(), false, jobs);
+		retdec::utils::PassProfiler profiler;
+		optimizerManager.setPassProfiler(&profiler);
+
+		optimizerManager.optimize(m);
+
+		std::map<std::string, std::string> categories;
+		for (const auto &record : profiler.getRecords()) {
+			categories[record.name] = record.category;
+		}
+		EXPECT_EQ(OptimizerManager::ParallelCategory,
+			categories["GotoStmtOptimizer"]) << jobs << " jobs";
+		EXPECT_EQ(OptimizerManager::SerialCategory,
+			categories["UnusedGlobalVarOptimizer"]) << jobs << " jobs";
+	}
+}
+
+} // namespace tests
+} // namespace llvmir2hll
+} // namespace retdec
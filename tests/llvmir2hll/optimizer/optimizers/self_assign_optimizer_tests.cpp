@@ -204,6 +204,29 @@ FuncWithJustSelfAssignIsOptimizedToEmptyBody) {
 		testFunc->getBody()->getSuccessor();
 }
 
+TEST_F(SelfAssignOptimizerTests,
+OptimizeFunctionOptimizesOnlyGivenFunction) {
+	// Add bodies to the testing function and to another function:
+	//
+	//   void test() { a = a; return; }
+	//   void other() { a = a; return; }
+	//
+	ShPtr<Variable> var(Variable::create("a", IntType::create(16)));
+	testFunc->setBody(AssignStmt::create(var, var, ReturnStmt::create()));
+	ShPtr<Function> otherFunc(addFuncDef("other"));
+	otherFunc->setBody(AssignStmt::create(var, var, ReturnStmt::create()));
+
+	// Optimize only the testing function.
+	ShPtr<SelfAssignOptimizer> optimizer(new SelfAssignOptimizer(module));
+	optimizer->optimizeFunction(testFunc);
+
+	// Check that the output is correct.
+	EXPECT_TRUE(isa<ReturnStmt>(testFunc->getBody())) <<
+		"expected ReturnStmt, got " << testFunc->getBody();
+	EXPECT_TRUE(isa<AssignStmt>(otherFunc->getBody())) <<
+		"expected AssignStmt, got " << otherFunc->getBody();
+}
+
 } // namespace tests
 } // namespace llvmir2hll
 } // namespace retdec
@@ -0,0 +1,259 @@
+/**
+ * @file tests/pdbparser/pdb_file_tests.cpp
+ * @brief Tests for locating and reassembling streams of PDB files.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/pdbparser/pdb_file.h"
+#include "retdec/utils/filesystem.h"
+#include "utils/temporary_directory.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace pdbparser {
+namespace tests {
+
+namespace {
+
+const std::size_t PageSize = 0x200;
+
+/**
+ * Stream of a synthetic PDB file.
+ */
+struct Stream
+{
+	std::uint32_t size;
+	std::vector<std::uint32_t> pages;
+};
+
+void put32(std::vector<char>& data, std::size_t offset, std::uint32_t value)
+{
+	std::memcpy(data.data() + offset, &value, sizeof(value));
+}
+
+} // anonymous namespace
+
+class PDBFileTests : public Test
+{
+	protected:
+		/**
+		 * Write MSF 7.00 file with @a numPages pages and @a streams into
+		 * the test file. Pages of the stream directory are @a rootPages and
+		 * their indexes are stored in page @a rootIndexesPage. All the other
+		 * pages are filled with bytes that identify the page and the offset
+		 * in it.
+		 */
+		void writePdb(
+				std::uint32_t numPages,
+				const std::vector<Stream>& streams,
+				const std::vector<std::uint32_t>& rootPages,
+				std::uint32_t rootIndexesPage)
+		{
+			file.assign(numPages * PageSize, 0);
+			for (std::size_t i = PageSize; i < file.size(); ++i)
+			{
+				file[i] = static_cast<char>((i / PageSize) * 31 + i % 251);
+			}
+
+			std::vector<char> root(4 + 4 * streams.size());
+			put32(root, 0, streams.size());
+			for (std::size_t i = 0; i < streams.size(); ++i)
+			{
+				put32(root, 4 + 4 * i, streams[i].size);
+				for (auto page : streams[i].pages)
+				{
+					root.resize(root.size() + 4);
+					put32(root, root.size() - 4, page);
+				}
+			}
+
+			for (std::size_t i = 0; i < rootPages.size(); ++i)
+			{
+				auto begin = i * PageSize;
+				auto end = std::min(root.size(), begin + PageSize);
+				std::copy(root.begin() + begin, root.begin() + end,
+						file.begin() + rootPages[i] * PageSize);
+				put32(file, rootIndexesPage * PageSize + 4 * i, rootPages[i]);
+			}
+
+			std::memcpy(file.data(), PDB_SIGNATURE_700, PDB_SIGNATURE_700_SIZE);
+			put32(file, 0x20, PageSize);
+			put32(file, 0x24, 1);
+			put32(file, 0x28, numPages);
+			put32(file, 0x2c, root.size());
+			put32(file, 0x30, 0);
+			put32(file, 0x34, rootIndexesPage);
+
+			std::ofstream(path.string(), std::ios::binary).write(
+					file.data(), file.size());
+		}
+
+		/**
+		 * Get the content of @a stream copied page by page from the whole
+		 * file, the way streams were read before the file was mapped.
+		 */
+		std::vector<char> copyStream(const Stream& stream)
+		{
+			std::vector<char> data;
+			for (auto page : stream.pages)
+			{
+				if (page < file.size() / PageSize)
+				{
+					data.insert(data.end(),
+							file.begin() + page * PageSize,
+							file.begin() + (page + 1) * PageSize);
+				}
+				else
+				{
+					data.insert(data.end(), PageSize, 0);
+				}
+			}
+			data.resize(stream.size);
+			return data;
+		}
+
+		std::vector<char> getStreamData(PDBFile& pdb, unsigned num)
+		{
+			auto* stream = pdb.get_stream(num);
+			return std::vector<char>(stream->data, stream->data + stream->size);
+		}
+
+	protected:
+		const utils::tests::TemporaryDirectory directory{
+				"retdec-pdbparser-tests"};
+		const fs::path path = directory / "test.pdb";
+		std::vector<char> file;
+};
+
+TEST_F(PDBFileTests, LinearStreamsAreReadFromFile)
+{
+	std::vector<Stream> streams = {
+		{0, {}},
+		{0x10, {3}},
+		{0x500, {4, 5, 6}},
+	};
+	writePdb(8, streams, {2}, 1);
+
+	PDBFile pdb;
+	ASSERT_EQ(PDB_STATE_OK, pdb.load_pdb_file(path.string().c_str()));
+
+	EXPECT_TRUE(pdb.get_stream(0)->unused);
+	for (unsigned i = 1; i < streams.size(); ++i)
+	{
+		EXPECT_TRUE(pdb.get_stream(i)->linear);
+		EXPECT_EQ(copyStream(streams[i]), getStreamData(pdb, i));
+	}
+}
+
+TEST_F(PDBFileTests, NonLinearStreamsAreReassembledAcrossPageBoundaries)
+{
+	std::vector<Stream> streams = {
+		{0, {}},
+		{0x10, {9}},
+		{0x5ff, {7, 3, 5}},
+		{0x201, {8, 4}},
+		{0x400, {6, 6}},
+	};
+	writePdb(10, streams, {2}, 1);
+
+	PDBFile pdb;
+	ASSERT_EQ(PDB_STATE_OK, pdb.load_pdb_file(path.string().c_str()));
+
+	for (unsigned i = 2; i < streams.size(); ++i)
+	{
+		EXPECT_FALSE(pdb.get_stream(i)->linear);
+		EXPECT_EQ(copyStream(streams[i]), getStreamData(pdb, i));
+	}
+}
+
+TEST_F(PDBFileTests, RequestedStreamIsReassembledOnlyOnce)
+{
+	std::vector<Stream> streams = {
+		{0, {}},
+		{0x10, {3}},
+		{0x400, {5, 4}},
+	};
+	writePdb(6, streams, {2}, 1);
+
+	PDBFile pdb;
+	ASSERT_EQ(PDB_STATE_OK, pdb.load_pdb_file(path.string().c_str()));
+
+	const char* data = pdb.get_stream(2)->data;
+	EXPECT_EQ(data, pdb.get_stream(2)->data);
+}
+
+TEST_F(PDBFileTests, StreamDirectoryInNonLinearPagesIsReassembled)
+{
+	// 0x70 streams of one page each do not fit into one directory page.
+	std::vector<Stream> streams;
+	for (std::uint32_t i = 0; i < 0x70; ++i)
+	{
+		streams.push_back({0x20, {4 + i % 8}});
+	}
+	writePdb(12, streams, {3, 1}, 2);
+
+	PDBFile pdb;
+	ASSERT_EQ(PDB_STATE_OK, pdb.load_pdb_file(path.string().c_str()));
+
+	for (unsigned i = 0; i < streams.size(); ++i)
+	{
+		EXPECT_EQ(copyStream(streams[i]), getStreamData(pdb, i));
+	}
+}
+
+TEST_F(PDBFileTests, PagesOutsideOfFileAreZeroed)
+{
+	std::vector<Stream> streams = {
+		{0, {}},
+		{0x10, {3}},
+		{0x400, {4, 100}},
+		{0x400, {5, 6}},
+	};
+	writePdb(6, streams, {2}, 1);
+
+	PDBFile pdb;
+	ASSERT_EQ(PDB_STATE_OK, pdb.load_pdb_file(path.string().c_str()));
+
+	EXPECT_EQ(copyStream(streams[2]), getStreamData(pdb, 2));
+	EXPECT_FALSE(pdb.get_stream(3)->linear);
+	EXPECT_EQ(copyStream(streams[3]), getStreamData(pdb, 3));
+}
+
+TEST_F(PDBFileTests, NonexistentStreamIsNull)
+{
+	writePdb(4, {{0, {}}, {0x10, {3}}}, {2}, 1);
+
+	PDBFile pdb;
+	ASSERT_EQ(PDB_STATE_OK, pdb.load_pdb_file(path.string().c_str()));
+
+	EXPECT_EQ(nullptr, pdb.get_stream(2));
+}
+
+TEST_F(PDBFileTests, FileShorterThanHeaderIsInvalid)
+{
+	std::ofstream(path.string(), std::ios::binary) << PDB_SIGNATURE_700;
+
+	PDBFile pdb;
+	EXPECT_EQ(PDB_STATE_INVALID_FILE, pdb.load_pdb_file(path.string().c_str()));
+}
+
+TEST_F(PDBFileTests, StreamDirectoryIndexesOutsideOfFileAreInvalid)
+{
+	writePdb(4, {{0, {}}, {0x10, {3}}}, {2}, 1);
+	put32(file, 0x34, 100);
+	std::ofstream(path.string(), std::ios::binary).write(file.data(), file.size());
+
+	PDBFile pdb;
+	EXPECT_EQ(PDB_STATE_INVALID_FILE, pdb.load_pdb_file(path.string().c_str()));
+}
+
+} // namespace tests
+} // namespace pdbparser
+} // namespace retdec
@@ -0,0 +1,269 @@
+/**
+ * @file tests/pelib/image_loader_tests.cpp
+ * @brief Tests for copy-on-write mapping of pages in @c ImageLoader.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/pelib/ImageLoader.h"
+
+using namespace ::testing;
+
+namespace PeLib {
+namespace tests {
+
+namespace {
+
+const std::uint32_t ImageBase = 0x400000;
+const std::uint32_t SectionRva = 0x1000;
+const std::uint32_t SectionSize = 0x1800;
+const std::uint32_t HeadersSize = 0x200;
+
+void put16(ByteBuffer& data, std::size_t offset, std::uint16_t value)
+{
+	data[offset] = value & 0xff;
+	data[offset + 1] = value >> 8;
+}
+
+void put32(ByteBuffer& data, std::size_t offset, std::uint32_t value)
+{
+	put16(data, offset, value & 0xffff);
+	put16(data, offset + 2, value >> 16);
+}
+
+/**
+ * Create a 32-bit PE file with a single data section of @c SectionSize bytes
+ * at @c SectionRva, which spans two pages.
+ */
+ByteBuffer createPeFile()
+{
+	const std::size_t peHeader = 0x40;
+	const std::size_t optionalHeader = peHeader + 4 + 20;
+	const std::size_t sectionTable = optionalHeader + 0xe0;
+
+	ByteBuffer pe(HeadersSize + SectionSize);
+
+	put16(pe, 0x00, 0x5a4d);
+	put32(pe, 0x3c, peHeader);
+
+	put32(pe, peHeader, 0x4550);
+	put16(pe, peHeader + 4, 0x14c);
+	put16(pe, peHeader + 6, 1);
+	put16(pe, peHeader + 20, 0xe0);
+	put16(pe, peHeader + 22, 0x102);
+
+	put16(pe, optionalHeader + 0, 0x10b);
+	put32(pe, optionalHeader + 8, SectionSize);
+	put32(pe, optionalHeader + 28, ImageBase);
+	put32(pe, optionalHeader + 32, 0x1000);
+	put32(pe, optionalHeader + 36, 0x200);
+	put16(pe, optionalHeader + 40, 6);
+	put16(pe, optionalHeader + 48, 6);
+	put32(pe, optionalHeader + 56, SectionRva + 0x2000);
+	put32(pe, optionalHeader + 60, HeadersSize);
+	put16(pe, optionalHeader + 68, 3);
+	put32(pe, optionalHeader + 72, 0x100000);
+	put32(pe, optionalHeader + 76, 0x1000);
+	put32(pe, optionalHeader + 80, 0x100000);
+	put32(pe, optionalHeader + 84, 0x1000);
+	put32(pe, optionalHeader + 92, 16);
+
+	std::memcpy(pe.data() + sectionTable, ".data", 5);
+	put32(pe, sectionTable + 8, SectionSize);
+	put32(pe, sectionTable + 12, SectionRva);
+	put32(pe, sectionTable + 16, SectionSize);
+	put32(pe, sectionTable + 20, HeadersSize);
+	put32(pe, sectionTable + 36, 0xc0000040);
+
+	for (std::size_t i = 0; i < SectionSize; ++i)
+	{
+		pe[HeadersSize + i] = static_cast<std::uint8_t>(i * 7 + 1);
+	}
+	return pe;
+}
+
+} // anonymous namespace
+
+//
+// PELIB_FILE_PAGE
+//
+
+class FilePageTests : public Test
+{
+	protected:
+		FilePageTests() : fileData(PELIB_PAGE_SIZE)
+		{
+			for (std::size_t i = 0; i < fileData.size(); ++i)
+			{
+				fileData[i] = static_cast<std::uint8_t>(i);
+			}
+		}
+
+	protected:
+		ByteBuffer fileData;
+};
+
+TEST_F(FilePageTests, ValidPageSharesFileData)
+{
+	PELIB_FILE_PAGE page;
+	page.setValidPage(fileData.data(), fileData.size());
+
+	EXPECT_EQ(fileData.data(), page.getData());
+	EXPECT_TRUE(page.buffer.empty());
+
+	std::uint8_t data[4] = {};
+	page.readFromPage(data, 0x10, sizeof(data));
+
+	EXPECT_EQ(0x10, data[0]);
+	EXPECT_EQ(0x13, data[3]);
+	EXPECT_EQ(fileData.data(), page.getData());
+	EXPECT_TRUE(page.buffer.empty());
+}
+
+TEST_F(FilePageTests, FirstWriteCopiesFileData)
+{
+	PELIB_FILE_PAGE page;
+	page.setValidPage(fileData.data(), fileData.size());
+	const ByteBuffer original = fileData;
+
+	std::uint8_t data[2] = {0xaa, 0xbb};
+	page.writeToPage(data, 0x20, sizeof(data));
+
+	EXPECT_NE(fileData.data(), page.getData());
+	EXPECT_EQ(nullptr, page.fileData);
+	ASSERT_EQ(PELIB_PAGE_SIZE, page.getDataSize());
+	EXPECT_EQ(0xaa, page.getData()[0x20]);
+	EXPECT_EQ(0xbb, page.getData()[0x21]);
+	EXPECT_EQ(0x1f, page.getData()[0x1f]);
+	EXPECT_EQ(0x22, page.getData()[0x22]);
+	EXPECT_EQ(original, fileData);
+}
+
+TEST_F(FilePageTests, LaterWritesDoNotChangeFileData)
+{
+	PELIB_FILE_PAGE page;
+	page.setValidPage(fileData.data(), fileData.size());
+	const ByteBuffer original = fileData;
+
+	std::uint8_t first = 0xaa;
+	page.writeToPage(&first, 0, 1);
+	const std::uint8_t* copy = page.getData();
+
+	std::uint8_t second[3] = {0x11, 0x22, 0x33};
+	page.writeToPage(second, PELIB_PAGE_SIZE - 2, sizeof(second));
+
+	EXPECT_EQ(copy, page.getData());
+	EXPECT_EQ(0xaa, page.getData()[0]);
+	EXPECT_EQ(0x11, page.getData()[PELIB_PAGE_SIZE - 2]);
+	EXPECT_EQ(0x22, page.getData()[PELIB_PAGE_SIZE - 1]);
+	EXPECT_EQ(original, fileData);
+}
+
+TEST_F(FilePageTests, ShortFileDataAreZeroExtendedOnRead)
+{
+	PELIB_FILE_PAGE page;
+	page.setValidPage(fileData.data(), 0x10);
+
+	std::uint8_t data[4] = {0xff, 0xff, 0xff, 0xff};
+	page.readFromPage(data, 0x0e, sizeof(data));
+
+	EXPECT_EQ(0x0e, data[0]);
+	EXPECT_EQ(0x0f, data[1]);
+	EXPECT_EQ(0x00, data[2]);
+	EXPECT_EQ(0x00, data[3]);
+}
+
+TEST_F(FilePageTests, WriteToShortFileDataZeroExtendsCopy)
+{
+	PELIB_FILE_PAGE page;
+	page.setValidPage(fileData.data(), 0x10);
+
+	std::uint8_t data = 0xaa;
+	page.writeToPage(&data, 0x100, 1);
+
+	ASSERT_EQ(PELIB_PAGE_SIZE, page.getDataSize());
+	EXPECT_EQ(0x0f, page.getData()[0x0f]);
+	EXPECT_EQ(0x00, page.getData()[0x10]);
+	EXPECT_EQ(0xaa, page.getData()[0x100]);
+	EXPECT_EQ(0x10, fileData[0x10]);
+}
+
+//
+// ImageLoader
+//
+
+class ImageLoaderTests : public Test
+{
+	protected:
+		ImageLoaderTests() : file(createPeFile()) {}
+
+	protected:
+		ByteBuffer file;
+};
+
+TEST_F(ImageLoaderTests, ReadOfMappedImageReturnsFileData)
+{
+	ImageLoader loader;
+	ASSERT_EQ(ERROR_NONE, loader.Load(file));
+
+	ByteBuffer section(SectionSize);
+	ASSERT_EQ(SectionSize, loader.readImage(section.data(), SectionRva, SectionSize));
+
+	EXPECT_EQ(ByteBuffer(file.begin() + HeadersSize, file.end()), section);
+}
+
+TEST_F(ImageLoaderTests, WriteToMappedImageDoesNotChangeLoadedData)
+{
+	const ByteBuffer original = file;
+	ImageLoader loader;
+	ASSERT_EQ(ERROR_NONE, loader.Load(file));
+
+	// The write crosses the boundary of the two pages of the section.
+	std::uint8_t data[4] = {0xde, 0xad, 0xbe, 0xef};
+	ASSERT_EQ(sizeof(data), loader.writeImage(data, SectionRva + 0xffe, sizeof(data)));
+
+	std::uint8_t read[8] = {};
+	loader.readImage(read, SectionRva + 0xffc, sizeof(read));
+
+	EXPECT_EQ(file[HeadersSize + 0xffc], read[0]);
+	EXPECT_EQ(file[HeadersSize + 0xffd], read[1]);
+	EXPECT_EQ(0xde, read[2]);
+	EXPECT_EQ(0xad, read[3]);
+	EXPECT_EQ(0xbe, read[4]);
+	EXPECT_EQ(0xef, read[5]);
+	EXPECT_EQ(file[HeadersSize + 0x1002], read[6]);
+	EXPECT_EQ(original, file);
+}
+
+TEST_F(ImageLoaderTests, RelocationDoesNotChangeLoadedData)
+{
+	const ByteBuffer original = file;
+	ImageLoader loader;
+	ASSERT_EQ(ERROR_NONE, loader.Load(file));
+
+	loader.relocateImage(ImageBase + 0x10000);
+
+	EXPECT_EQ(original, file);
+}
+
+TEST_F(ImageLoaderTests, LoaderKeepsSharedFileDataAlive)
+{
+	auto data = std::make_shared<const ByteBuffer>(file);
+	std::weak_ptr<const ByteBuffer> weakData = data;
+
+	ImageLoader loader;
+	ASSERT_EQ(ERROR_NONE, loader.Load(std::move(data)));
+	EXPECT_FALSE(weakData.expired());
+
+	std::uint8_t read = 0;
+	loader.readImage(&read, SectionRva + 0x100, 1);
+	EXPECT_EQ(file[HeadersSize + 0x100], read);
+}
+
+} // namespace tests
+} // namespace PeLib
@@ -0,0 +1,161 @@
+/**
+* @file tests/retdec/retdec_tests.cpp
+* @brief Tests for the @c retdec module.
+* @copyright (c) 2019 Avast Software, licensed under the MIT license
+*/
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/config/config.h"
+#include "retdec/retdec/retdec.h"
+#include "retdec/utils/filesystem.h"
+#include "utils/temporary_directory.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace tests {
+
+/**
+ * Tests for the @c retdec module.
+ */
+class RetdecTests: public Test
+{
+	protected:
+		RetdecTests()
+		{
+			writeInput();
+		}
+
+		/**
+		 * Write raw 32-bit x86 code of several functions calling each other
+		 * into the input file.
+		 */
+		void writeInput()
+		{
+			const std::size_t functions = 16;
+			const std::size_t functionSize = 32;
+
+			std::vector<std::uint8_t> code;
+			for (std::size_t i = 0; i < functions; ++i)
+			{
+				auto start = code.size();
+				auto next = (i + 1) % functions * functionSize;
+				auto rel = static_cast<std::uint32_t>(next - (start + 15));
+				code.insert(code.end(), {
+					0x55,                           // push ebp
+					0x89, 0xe5,                     // mov ebp, esp
+					0x8b, 0x45, 0x08,               // mov eax, [ebp+8]
+					0x83, 0xc0, static_cast<std::uint8_t>(i), // add eax, i
+					0x50,                           // push eax
+					0xe8,                           // call next
+					static_cast<std::uint8_t>(rel),
+					static_cast<std::uint8_t>(rel >> 8),
+					static_cast<std::uint8_t>(rel >> 16),
+					static_cast<std::uint8_t>(rel >> 24),
+					0xc9,                           // leave
+					0xc3                            // ret
+				});
+				code.resize(start + functionSize, 0x90);
+			}
+
+			std::ofstream out(inputFile, std::ios::binary);
+			out.write(reinterpret_cast<const char*>(code.data()), code.size());
+		}
+
+		/**
+		 * Create a configuration of a decompilation of the input file in
+		 * the raw mode with the default pass pipeline of the decompiler.
+		 * Support files (signatures, type information) are not used.
+		 */
+		config::Config createConfig()
+		{
+			auto config = config::Config::fromFile(RETDEC_DECOMPILER_CONFIG);
+			auto& params = config.parameters;
+			params.setInputFile(inputFile.string());
+			params.setIsVerboseOutput(false);
+			params.setIsBackendNoTimeVaryingInfo(true);
+			params.setIsDetectStaticCode(false);
+			params.setOrdinalNumbersDirectory("");
+			params.staticSignaturePaths.clear();
+			params.libraryTypeInfoPaths.clear();
+			params.cryptoPatternPaths.clear();
+			params.setSectionVMA(0x1000);
+			params.setEntryPoint(0x1000);
+			params.setIsKeepAllFunctions(true);
+			config.architecture.setIsX86();
+			config.architecture.setIsEndianLittle();
+			config.architecture.setBitSize(32);
+			config.fileFormat.setIsRaw();
+			config.fileFormat.setFileClassBits(32);
+			return config;
+		}
+
+		/**
+		 * Decompile the input file and return the output, or an empty string
+		 * if the decompilation failed.
+		 */
+		std::string decompileInput()
+		{
+			auto config = createConfig();
+			std::string output;
+			if (decompile(config, &output) != EXIT_SUCCESS)
+			{
+				return std::string();
+			}
+			return output;
+		}
+
+	protected:
+		const utils::tests::TemporaryDirectory directory{"retdec-tests"};
+		const fs::path inputFile = directory / "input.bin";
+};
+
+TEST_F(RetdecTests, decompileProducesOutput)
+{
+	EXPECT_FALSE(decompileInput().empty());
+}
+
+TEST_F(RetdecTests, concurrentDecompilationsGiveSameOutputAsSerialDecompilation)
+{
+	const std::size_t threadCount = 8;
+	const std::size_t iterations = 4;
+
+	auto serialOutput = decompileInput();
+	ASSERT_FALSE(serialOutput.empty());
+
+	std::vector<std::vector<std::string>> outputs(threadCount);
+	std::vector<std::thread> threads;
+	for (std::size_t t = 0; t < threadCount; ++t)
+	{
+		threads.emplace_back([this, t, iterations, &outputs]()
+		{
+			for (std::size_t i = 0; i < iterations; ++i)
+			{
+				outputs[t].push_back(decompileInput());
+			}
+		});
+	}
+	for (auto& thread : threads)
+	{
+		thread.join();
+	}
+
+	for (std::size_t t = 0; t < threadCount; ++t)
+	{
+		for (auto& output : outputs[t])
+		{
+			EXPECT_EQ(serialOutput, output) << "thread " << t;
+		}
+	}
+}
+
+} // namespace tests
+} // namespace retdec
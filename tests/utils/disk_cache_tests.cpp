@@ -0,0 +1,134 @@
+/**
+* @file tests/utils/disk_cache_tests.cpp
+* @brief Tests for the @c disk_cache module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <chrono>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/disk_cache.h"
+#include "retdec/utils/filesystem.h"
+#include "utils/temporary_directory.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c disk_cache module.
+*/
+class DiskCacheTests: public Test {
+protected:
+	/// Marks the entry with the given @a key as used @a hoursAgo hours ago.
+	void setLastUse(const std::string &key, int hoursAgo) {
+		fs::last_write_time(directory / key,
+			fs::file_time_type::clock::now() - std::chrono::hours(hoursAgo));
+	}
+
+protected:
+	const TemporaryDirectory temporaryDirectory{"retdec-disk-cache-tests"};
+	/// Directory of the cache, which is created by the cache itself.
+	const fs::path directory = temporaryDirectory / "cache";
+};
+
+TEST_F(DiskCacheTests,
+LoadOfEntryThatWasNotStoredIsMiss) {
+	DiskCache cache(directory.string());
+	DiskCache::Entry entry;
+
+	ASSERT_FALSE(cache.load("key", entry));
+	EXPECT_EQ(0, cache.getStatistics().hits);
+	EXPECT_EQ(1, cache.getStatistics().misses);
+}
+
+TEST_F(DiskCacheTests,
+StoredEntryCanBeLoadedWithAllItsFiles) {
+	DiskCache cache(directory.string());
+	DiskCache::Entry stored{
+		{"module.bc", std::string("BC\0\xc0\xde", 5)},
+		{"config.json", "{}"}
+	};
+
+	ASSERT_TRUE(cache.store("key", stored));
+	DiskCache::Entry loaded;
+	ASSERT_TRUE(cache.load("key", loaded));
+
+	EXPECT_EQ(stored, loaded);
+	EXPECT_EQ(1, cache.getStatistics().stores);
+	EXPECT_EQ(1, cache.getStatistics().hits);
+	EXPECT_EQ(1, cache.getStatistics().entries);
+	EXPECT_EQ(7, cache.getStatistics().size);
+}
+
+TEST_F(DiskCacheTests,
+EntryStoredByOtherCacheCanBeLoaded) {
+	DiskCache(directory.string()).store("key", {{"file", "content"}});
+
+	DiskCache cache(directory.string());
+	DiskCache::Entry loaded;
+	ASSERT_TRUE(cache.load("key", loaded));
+
+	EXPECT_EQ("content", loaded["file"]);
+}
+
+TEST_F(DiskCacheTests,
+StoreOfExistingEntryKeepsIt) {
+	DiskCache cache(directory.string());
+	cache.store("key", {{"file", "first"}});
+
+	ASSERT_TRUE(cache.store("key", {{"file", "second"}}));
+	DiskCache::Entry loaded;
+	cache.load("key", loaded);
+
+	EXPECT_EQ("first", loaded["file"]);
+	EXPECT_EQ(1, cache.getStatistics().stores);
+}
+
+TEST_F(DiskCacheTests,
+LeastRecentlyUsedEntriesAreEvictedWhenCacheIsTooLarge) {
+	DiskCache cache(directory.string(), 250);
+	cache.store("a", {{"file", std::string(100, 'a')}});
+	cache.store("b", {{"file", std::string(100, 'b')}});
+	setLastUse("a", 2);
+	setLastUse("b", 1);
+	DiskCache::Entry entry;
+	cache.load("a", entry);
+
+	cache.store("c", {{"file", std::string(100, 'c')}});
+
+	EXPECT_TRUE(cache.load("a", entry));
+	EXPECT_FALSE(cache.load("b", entry));
+	EXPECT_TRUE(cache.load("c", entry));
+	EXPECT_EQ(1, cache.getStatistics().evictions);
+	EXPECT_EQ(2, cache.getStatistics().entries);
+	EXPECT_EQ(200, cache.getStatistics().size);
+}
+
+TEST_F(DiskCacheTests,
+EntriesAreNotEvictedWhenSizeIsNotLimited) {
+	DiskCache cache(directory.string());
+	cache.store("a", {{"file", std::string(100, 'a')}});
+	cache.store("b", {{"file", std::string(100, 'b')}});
+
+	EXPECT_EQ(0, cache.getStatistics().evictions);
+	EXPECT_EQ(2, cache.getStatistics().entries);
+}
+
+TEST_F(DiskCacheTests,
+StoreIntoDirectoryThatCannotBeCreatedReturnsFalse) {
+	fs::create_directories(directory);
+	std::ofstream(directory / "file") << "not a directory";
+	DiskCache cache((directory / "file" / "cache").string());
+
+	ASSERT_FALSE(cache.store("key", {{"file", "content"}}));
+	EXPECT_EQ(0, cache.getStatistics().stores);
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,151 @@
+/**
+* @file tests/utils/interval_index_tests.cpp
+* @brief Tests for the @c interval_index module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/interval_index.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c interval_index module.
+*/
+class IntervalIndexTests: public Test {
+protected:
+	std::vector<int> containing(std::uint64_t point) {
+		std::vector<int> result;
+		index.forEachContaining(point, [&result](int value) {
+			result.push_back(value);
+			return true;
+		});
+		return result;
+	}
+
+protected:
+	IntervalIndex<int> index;
+};
+
+TEST_F(IntervalIndexTests,
+EmptyIndexContainsNothing) {
+	index.build();
+
+	ASSERT_EQ(std::vector<int>(), containing(0));
+}
+
+TEST_F(IntervalIndexTests,
+PointIsFoundOnlyInsideHalfOpenInterval) {
+	index.add(0x1000, 0x100, 1);
+	index.build();
+
+	ASSERT_EQ(std::vector<int>(), containing(0xfff));
+	ASSERT_EQ(std::vector<int>{1}, containing(0x1000));
+	ASSERT_EQ(std::vector<int>{1}, containing(0x10ff));
+	ASSERT_EQ(std::vector<int>(), containing(0x1100));
+}
+
+TEST_F(IntervalIndexTests,
+EmptyIntervalsAreIgnored) {
+	index.add(0x1000, 0, 1);
+	index.build();
+
+	ASSERT_EQ(0, index.size());
+	ASSERT_EQ(std::vector<int>(), containing(0x1000));
+}
+
+TEST_F(IntervalIndexTests,
+CorrectIntervalIsFoundAmongManyDisjointIntervals) {
+	for (int i = 0; i < 1000; ++i) {
+		index.add(0x1000 * (999 - i), 0x800, 999 - i);
+	}
+	index.build();
+
+	for (int i = 0; i < 1000; ++i) {
+		ASSERT_EQ(std::vector<int>{i}, containing(0x1000 * i + 0x10));
+		ASSERT_EQ(std::vector<int>(), containing(0x1000 * i + 0x900));
+	}
+}
+
+TEST_F(IntervalIndexTests,
+OverlappingIntervalsAreVisitedByDecreasingStartsThenInOrderOfAddition) {
+	index.add(0x1000, 0x1000, 1);
+	index.add(0x1800, 0x100, 2);
+	index.add(0x1000, 0x900, 3);
+	index.add(0x1c00, 0x100, 4);
+	index.build();
+
+	ASSERT_EQ(std::vector<int>({2, 1, 3}), containing(0x1850));
+	ASSERT_EQ(std::vector<int>({4, 1}), containing(0x1c50));
+	ASSERT_EQ(std::vector<int>({1, 3}), containing(0x1100));
+}
+
+TEST_F(IntervalIndexTests,
+IntervalStartingBeforeManyOthersIsFound) {
+	index.add(0, 0x10000, 0);
+	for (int i = 1; i < 100; ++i) {
+		index.add(0x100 * i, 0x10, i);
+	}
+	index.build();
+
+	ASSERT_EQ(std::vector<int>({50, 0}), containing(0x3205));
+	ASSERT_EQ(std::vector<int>{0}, containing(0x3250));
+}
+
+TEST_F(IntervalIndexTests,
+VisitingStopsWhenFunctionReturnsFalse) {
+	index.add(0x1000, 0x1000, 1);
+	index.add(0x1800, 0x100, 2);
+	index.build();
+
+	std::vector<int> visited;
+	index.forEachContaining(0x1850, [&visited](int value) {
+		visited.push_back(value);
+		return false;
+	});
+
+	ASSERT_EQ(std::vector<int>{2}, visited);
+}
+
+TEST_F(IntervalIndexTests,
+IntervalReachingEndOfAddressSpaceIsFound) {
+	index.add(0xfffffffffffff000, 0x2000, 1);
+	index.build();
+
+	ASSERT_EQ(std::vector<int>{1}, containing(0xffffffffffffffff));
+}
+
+TEST_F(IntervalIndexTests,
+RepeatedQueriesReturnSameResults) {
+	index.add(0x1000, 0x1000, 1);
+	index.add(0x1800, 0x100, 2);
+	index.add(0x3000, 0x100, 3);
+	index.build();
+
+	for (int i = 0; i < 3; ++i) {
+		ASSERT_EQ(std::vector<int>{3}, containing(0x3010));
+		ASSERT_EQ(std::vector<int>({2, 1}), containing(0x1810));
+		ASSERT_EQ(std::vector<int>{1}, containing(0x1010));
+	}
+}
+
+TEST_F(IntervalIndexTests,
+ClearRemovesAllIntervals) {
+	index.add(0x1000, 0x1000, 1);
+	index.build();
+
+	index.clear();
+
+	ASSERT_EQ(std::vector<int>(), containing(0x1000));
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
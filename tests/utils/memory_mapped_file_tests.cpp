@@ -0,0 +1,86 @@
+/**
+* @file tests/utils/memory_mapped_file_tests.cpp
+* @brief Tests for the @c memory_mapped_file module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/memory_mapped_file.h"
+
+using namespace ::testing;
+
+namespace fs = std::filesystem;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c memory_mapped_file module.
+*/
+class MemoryMappedFileTests: public Test {
+protected:
+	virtual void TearDown() override {
+		std::error_code ec;
+		fs::remove(path, ec);
+	}
+
+	void createFile(const std::string &content) {
+		path = fs::temp_directory_path() / ("retdec-mmap-test-"
+			+ std::string(UnitTest::GetInstance()->current_test_info()->name()));
+		std::ofstream file(path, std::ios::binary);
+		file << content;
+	}
+
+protected:
+	fs::path path;
+};
+
+TEST_F(MemoryMappedFileTests,
+MappedFileHasSameContentAsFileOnDisk) {
+	const std::string content("hello\0world\xff", 12);
+	createFile(content);
+
+	MemoryMappedFile file(path.string());
+
+	ASSERT_TRUE(file.isOpen());
+	ASSERT_EQ(content.size(), file.getSize());
+	ASSERT_EQ(content, std::string(
+		reinterpret_cast<const char *>(file.getData()), file.getSize()));
+}
+
+TEST_F(MemoryMappedFileTests,
+EmptyFileIsOpenAndHasZeroSize) {
+	createFile("");
+
+	MemoryMappedFile file(path.string());
+
+	ASSERT_TRUE(file.isOpen());
+	ASSERT_EQ(0, file.getSize());
+	ASSERT_EQ(nullptr, file.getData());
+}
+
+TEST_F(MemoryMappedFileTests,
+NonexistentFileIsNotOpen) {
+	MemoryMappedFile file("/nonexistent/retdec/file");
+
+	ASSERT_FALSE(file.isOpen());
+	ASSERT_EQ(0, file.getSize());
+	ASSERT_EQ(nullptr, file.getData());
+}
+
+TEST_F(MemoryMappedFileTests,
+DirectoryIsNotOpen) {
+	MemoryMappedFile file(fs::temp_directory_path().string());
+
+	ASSERT_FALSE(file.isOpen());
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
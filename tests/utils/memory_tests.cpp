@@ -4,6 +4,8 @@
 * @copyright (c) 2017 Avast Software, licensed under the MIT license
 */
 
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include "retdec/utils/memory.h"
@@ -73,6 +75,29 @@ LimitSystemMemoryToHalfOfTotalSystemMemoryReturnsTrue) {
 	ASSERT_TRUE(limitSystemMemoryToHalfOfTotalSystemMemory());
 }
 
+TEST_F(MemoryTests,
+GetProcessMemoryUsageReturnsNonZeroSizeNotGreaterThanPeakSize) {
+	auto size = getProcessMemoryUsage();
+	auto peakSize = getPeakProcessMemoryUsage();
+
+	ASSERT_GT(size, 0);
+	ASSERT_LE(size, peakSize);
+}
+
+TEST_F(MemoryTests,
+PeakProcessMemoryUsageAfterResetDoesNotIncludeFreedMemory) {
+	const std::size_t size = 64 * 1024 * 1024;
+	{
+		std::vector<char> memory(size, 1);
+		ASSERT_GE(getPeakProcessMemoryUsage(), size);
+	}
+	if (!resetPeakProcessMemoryUsage()) {
+		GTEST_SKIP() << "not supported on this system";
+	}
+
+	EXPECT_LT(getPeakProcessMemoryUsage(), getProcessMemoryUsage() + size);
+}
+
 } // namespace tests
 } // namespace utils
 } // namespace retdec
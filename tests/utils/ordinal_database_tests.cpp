@@ -0,0 +1,134 @@
+/**
+* @file tests/utils/ordinal_database_tests.cpp
+* @brief Tests for the @c ordinal_database module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/ordinal_database.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c ordinal_database module.
+*/
+class OrdinalDatabaseTests: public Test {
+protected:
+	void writeAndOpen(const std::vector<OrdinalDatabase::Entry> &entries) {
+		std::ostringstream out;
+		ASSERT_TRUE(OrdinalDatabase::write(out, entries));
+		content = out.str();
+		ASSERT_TRUE(db.open(
+			reinterpret_cast<const std::uint8_t *>(content.data()),
+			content.size()));
+	}
+
+protected:
+	std::string content;
+	OrdinalDatabase db;
+};
+
+TEST_F(OrdinalDatabaseTests,
+DatabaseIsNotOpenByDefault) {
+	ASSERT_FALSE(db.isOpen());
+	ASSERT_EQ("", db.getName("x86", "ws2_32", 1));
+}
+
+TEST_F(OrdinalDatabaseTests,
+NamesOfAllWrittenEntriesAreFound) {
+	writeAndOpen({
+		{"x86", "ws2_32", 1, "accept"},
+		{"x86", "ws2_32", 2, "bind"},
+		{"x86", "oleaut32", 2, "SysAllocString"},
+		{"arm", "ws2_32", 1, "accept_arm"},
+	});
+
+	ASSERT_TRUE(db.isOpen());
+	ASSERT_EQ(4, db.getNumberOfEntries());
+	ASSERT_EQ("accept", db.getName("x86", "ws2_32", 1));
+	ASSERT_EQ("bind", db.getName("x86", "ws2_32", 2));
+	ASSERT_EQ("SysAllocString", db.getName("x86", "oleaut32", 2));
+	ASSERT_EQ("accept_arm", db.getName("arm", "ws2_32", 1));
+}
+
+TEST_F(OrdinalDatabaseTests,
+LibraryNamesAreCaseInsensitiveAndDllSuffixIsOptional) {
+	writeAndOpen({{"x86", "ws2_32", 1, "accept"}});
+
+	ASSERT_EQ("accept", db.getName("x86", "WS2_32.dll", 1));
+	ASSERT_EQ("accept", db.getName("x86", "Ws2_32", 1));
+}
+
+TEST_F(OrdinalDatabaseTests,
+MissingEntriesAreNotFound) {
+	writeAndOpen({{"x86", "ws2_32", 1, "accept"}});
+
+	ASSERT_EQ("", db.getName("x86", "ws2_32", 2));
+	ASSERT_EQ("", db.getName("x86", "kernel32", 1));
+	ASSERT_EQ("", db.getName("arm", "ws2_32", 1));
+	ASSERT_EQ("", db.getName("x86", "ws2_32", 0x100000001));
+}
+
+TEST_F(OrdinalDatabaseTests,
+LastOfDuplicateEntriesIsUsed) {
+	writeAndOpen({
+		{"x86", "ws2_32", 1, "first"},
+		{"x86", "ws2_32", 1, "second"},
+	});
+
+	ASSERT_EQ(1, db.getNumberOfEntries());
+	ASSERT_EQ("second", db.getName("x86", "ws2_32", 1));
+}
+
+TEST_F(OrdinalDatabaseTests,
+EmptyDatabaseCanBeWrittenAndOpened) {
+	writeAndOpen({});
+
+	ASSERT_EQ(0, db.getNumberOfEntries());
+	ASSERT_EQ("", db.getName("x86", "ws2_32", 1));
+}
+
+TEST_F(OrdinalDatabaseTests,
+ManyEntriesAreFound) {
+	std::vector<OrdinalDatabase::Entry> entries;
+	for (std::uint32_t lib = 0; lib < 50; ++lib) {
+		for (std::uint32_t ord = 1; ord <= 200; ++ord) {
+			entries.push_back({"x86", "lib" + std::to_string(lib), ord,
+				"func" + std::to_string(lib) + "_" + std::to_string(ord)});
+		}
+	}
+	writeAndOpen(entries);
+
+	for (const auto &entry : entries) {
+		ASSERT_EQ(entry.name, db.getName(entry.arch, entry.library, entry.ordinal));
+	}
+}
+
+TEST_F(OrdinalDatabaseTests,
+InvalidDataAreNotOpened) {
+	const std::string invalid = "not an ordinal database";
+
+	ASSERT_FALSE(db.open(
+		reinterpret_cast<const std::uint8_t *>(invalid.data()),
+		invalid.size()));
+	ASSERT_FALSE(db.isOpen());
+}
+
+TEST_F(OrdinalDatabaseTests,
+NonexistentFileIsNotOpened) {
+	ASSERT_FALSE(db.open("/nonexistent/ordinals.ordb"));
+	ASSERT_FALSE(db.isOpen());
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,121 @@
+/**
+* @file tests/utils/pass_profiler_tests.cpp
+* @brief Tests for the @c pass_profiler module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <sstream>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/pass_profiler.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c pass_profiler module.
+*/
+class PassProfilerTests: public Test {
+protected:
+	/// Returns IR size with the given counts.
+	static PassProfiler::IrSize irSize(std::size_t functions,
+			std::size_t blocks, std::size_t instructions) {
+		PassProfiler::IrSize size;
+		size.functions = functions;
+		size.blocks = blocks;
+		size.instructions = instructions;
+		return size;
+	}
+
+protected:
+	PassProfiler profiler;
+};
+
+TEST_F(PassProfilerTests,
+ProfilerWithoutPassesHasNoRecords) {
+	ASSERT_TRUE(profiler.getRecords().empty());
+}
+
+TEST_F(PassProfilerTests,
+StoppedPassIsRecordedWithItsNameCategoryAndIrSizes) {
+	profiler.start("pass", "llvm", irSize(1, 2, 3));
+	profiler.stop(irSize(4, 5, 6));
+
+	ASSERT_EQ(1, profiler.getRecords().size());
+	const auto &r = profiler.getRecords()[0];
+	EXPECT_EQ("pass", r.name);
+	EXPECT_EQ("llvm", r.category);
+	EXPECT_EQ(0, r.depth);
+	EXPECT_EQ(1, r.irBefore.functions);
+	EXPECT_EQ(2, r.irBefore.blocks);
+	EXPECT_EQ(3, r.irBefore.instructions);
+	EXPECT_EQ(4, r.irAfter.functions);
+	EXPECT_EQ(5, r.irAfter.blocks);
+	EXPECT_EQ(6, r.irAfter.instructions);
+	EXPECT_GT(r.rssBefore, 0);
+	EXPECT_GT(r.rssAfter, 0);
+}
+
+TEST_F(PassProfilerTests,
+WallTimeOfPassIncludesTimeSpentInPass) {
+	profiler.start("sleep", "test");
+	std::this_thread::sleep_for(std::chrono::milliseconds(20));
+	profiler.stop();
+
+	ASSERT_GE(profiler.getRecords()[0].wallUs, 20000);
+}
+
+TEST_F(PassProfilerTests,
+NestedPassesAreRecordedInStartOrderWithTheirDepths) {
+	profiler.start("outer", "llvm");
+	profiler.start("inner", "backend");
+	profiler.stop();
+	profiler.stop();
+
+	const auto &records = profiler.getRecords();
+	ASSERT_EQ(2, records.size());
+	EXPECT_EQ("outer", records[0].name);
+	EXPECT_EQ(0, records[0].depth);
+	EXPECT_EQ("inner", records[1].name);
+	EXPECT_EQ(1, records[1].depth);
+	EXPECT_LE(records[0].startUs, records[1].startUs);
+	EXPECT_GE(records[0].wallUs, records[1].wallUs);
+}
+
+TEST_F(PassProfilerTests,
+StopWithoutRunningPassDoesNothing) {
+	profiler.stop();
+
+	ASSERT_TRUE(profiler.getRecords().empty());
+}
+
+TEST_F(PassProfilerTests,
+WriteJsonWritesPassesAndTraceEvents) {
+	profiler.start("a \"quoted\" pass", "llvm", irSize(1, 2, 3));
+	profiler.stop(irSize(1, 2, 4));
+
+	std::stringstream out;
+	profiler.writeJson(out);
+
+	auto json = out.str();
+	EXPECT_NE(std::string::npos, json.find("\"passes\": ["));
+	EXPECT_NE(std::string::npos, json.find("\"traceEvents\": ["));
+	EXPECT_NE(std::string::npos, json.find("\"name\": \"a \\\"quoted\\\" pass\""));
+	EXPECT_NE(std::string::npos, json.find("\"ph\": \"X\""));
+	EXPECT_NE(std::string::npos, json.find(
+		"\"irAfter\": {\"functions\": 1, \"blocks\": 2, \"instructions\": 4}"));
+}
+
+TEST_F(PassProfilerTests,
+WriteJsonToFileInNonexistentDirectoryReturnsFalse) {
+	ASSERT_FALSE(profiler.writeJson("/nonexistent/dir/profile.json"));
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
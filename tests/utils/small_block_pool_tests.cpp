@@ -0,0 +1,146 @@
+/**
+* @file tests/utils/small_block_pool_tests.cpp
+* @brief Tests for the @c small_block_pool module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/small_block_pool.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c small_block_pool module.
+*/
+class SmallBlockPoolTests: public Test {};
+
+TEST_F(SmallBlockPoolTests,
+FreedBlockIsReusedByNextAllocationOfSameSize) {
+	auto *block = SmallBlockPool::allocate(40);
+	SmallBlockPool::deallocate(block, 40);
+
+	auto *reused = SmallBlockPool::allocate(40);
+
+	EXPECT_EQ(block, reused);
+	SmallBlockPool::deallocate(reused, 40);
+}
+
+TEST_F(SmallBlockPoolTests,
+BlocksAreAlignedAndDoNotOverlap) {
+	const std::size_t size = 24;
+	std::vector<void *> blocks;
+	for (std::size_t i = 0; i < 10000; ++i) {
+		auto *block = SmallBlockPool::allocate(size);
+		std::memset(block, static_cast<int>(i % 256), size);
+		blocks.push_back(block);
+	}
+
+	for (std::size_t i = 0; i < blocks.size(); ++i) {
+		auto *bytes = static_cast<unsigned char *>(blocks[i]);
+		EXPECT_EQ(0, reinterpret_cast<std::uintptr_t>(bytes)
+			% SmallBlockPool::Alignment);
+		EXPECT_EQ(i % 256, bytes[0]);
+		EXPECT_EQ(i % 256, bytes[size - 1]);
+	}
+	for (auto *block : blocks) {
+		SmallBlockPool::deallocate(block, size);
+	}
+}
+
+TEST_F(SmallBlockPoolTests,
+LargeBlockIsNotAllocatedFromPool) {
+	auto reservedBefore = SmallBlockPool::getReservedSize();
+
+	auto *block = SmallBlockPool::allocate(SmallBlockPool::MaxBlockSize + 1);
+	std::memset(block, 0, SmallBlockPool::MaxBlockSize + 1);
+	SmallBlockPool::deallocate(block, SmallBlockPool::MaxBlockSize + 1);
+
+	EXPECT_EQ(reservedBefore, SmallBlockPool::getReservedSize());
+}
+
+TEST_F(SmallBlockPoolTests,
+DeallocateOfNullPointerDoesNothing) {
+	SmallBlockPool::deallocate(nullptr, 16);
+}
+
+TEST_F(SmallBlockPoolTests,
+BlocksFreedByExitedThreadAreReusedByOtherThreads) {
+	auto allocateAndFree = []() {
+		const std::size_t size = 1000;
+		std::vector<void *> blocks;
+		for (std::size_t i = 0; i < 1000; ++i) {
+			blocks.push_back(SmallBlockPool::allocate(size));
+		}
+		for (auto *block : blocks) {
+			SmallBlockPool::deallocate(block, size);
+		}
+	};
+	std::thread(allocateAndFree).join();
+	auto reserved = SmallBlockPool::getReservedSize();
+
+	for (int i = 0; i < 5; ++i) {
+		std::thread(allocateAndFree).join();
+	}
+
+	EXPECT_EQ(reserved, SmallBlockPool::getReservedSize());
+}
+
+TEST_F(SmallBlockPoolTests,
+MemoryOfDestroyedObjectGraphIsReusedByNextGraph) {
+	// Mimics BIR modules that are created and destroyed one after another:
+	// shared pointers of several sizes whose control blocks are pooled too.
+	auto buildAndDestroyGraph = []() {
+		std::vector<std::shared_ptr<std::string>> nodes;
+		for (std::size_t i = 0; i < 10000; ++i) {
+			nodes.push_back(std::allocate_shared<std::string>(
+				SmallBlockAllocator<std::string>(), i % 64, 'x'));
+		}
+	};
+	buildAndDestroyGraph();
+	auto reserved = SmallBlockPool::getReservedSize();
+
+	for (int i = 0; i < 5; ++i) {
+		buildAndDestroyGraph();
+	}
+
+	EXPECT_EQ(reserved, SmallBlockPool::getReservedSize());
+}
+
+TEST_F(SmallBlockPoolTests,
+BlockFreedByOtherThreadCanBeReused) {
+	auto *block = SmallBlockPool::allocate(48);
+	std::thread([block]() {
+		SmallBlockPool::deallocate(block, 48);
+	}).join();
+
+	auto *other = SmallBlockPool::allocate(48);
+	SmallBlockPool::deallocate(other, 48);
+}
+
+TEST_F(SmallBlockPoolTests,
+AllocatorCanBeUsedForContainersAndSharedPointers) {
+	std::list<int, SmallBlockAllocator<int>> list{1, 2, 3};
+	auto ptr = std::allocate_shared<std::string>(
+		SmallBlockAllocator<std::string>(), "value");
+
+	EXPECT_EQ(3, list.size());
+	EXPECT_EQ(3, list.back());
+	EXPECT_EQ("value", *ptr);
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
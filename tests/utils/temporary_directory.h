@@ -0,0 +1,68 @@
+/**
+* @file tests/utils/temporary_directory.h
+* @brief A uniquely named directory for files created by tests.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#ifndef TESTS_UTILS_TEMPORARY_DIRECTORY_H
+#define TESTS_UTILS_TEMPORARY_DIRECTORY_H
+
+#include <random>
+#include <string>
+#include <system_error>
+
+#include "retdec/utils/filesystem.h"
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief A uniquely named directory in the system temporary directory.
+*
+* The directory is created when the object is constructed and removed with
+* all its content when the object is destroyed, so a test fixture can simply
+* have it as a data member.
+*/
+class TemporaryDirectory {
+public:
+	/**
+	* @brief Creates a new directory whose name starts with @a prefix.
+	*/
+	explicit TemporaryDirectory(const std::string &prefix):
+		path(fs::temp_directory_path() /
+			(prefix + "-" + std::to_string(std::random_device{}()))) {
+		fs::create_directories(path);
+	}
+
+	~TemporaryDirectory() {
+		std::error_code ec;
+		fs::remove_all(path, ec);
+	}
+
+	TemporaryDirectory(const TemporaryDirectory &) = delete;
+	TemporaryDirectory &operator=(const TemporaryDirectory &) = delete;
+
+	/**
+	* @brief Returns the path to the directory.
+	*/
+	const fs::path &getPath() const {
+		return path;
+	}
+
+	/**
+	* @brief Returns the path to @a name in the directory.
+	*/
+	fs::path operator/(const std::string &name) const {
+		return path / name;
+	}
+
+private:
+	const fs::path path;
+};
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
+
+#endif
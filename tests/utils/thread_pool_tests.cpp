@@ -0,0 +1,144 @@
+/**
+* @file tests/utils/thread_pool_tests.cpp
+* @brief Tests for the @c thread_pool module.
+* @copyright (c) 2017 Avast Software, licensed under the MIT license
+*/
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "retdec/utils/thread_pool.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace utils {
+namespace tests {
+
+/**
+* @brief Tests for the @c thread_pool module.
+*/
+class ThreadPoolTests: public Test {};
+
+TEST_F(ThreadPoolTests,
+PoolHasRequestedNumberOfThreads) {
+	ThreadPool pool(3);
+
+	ASSERT_EQ(3, pool.getThreadCount());
+}
+
+TEST_F(ThreadPoolTests,
+PoolWithZeroThreadsUsesDefaultThreadCount) {
+	ThreadPool pool(0);
+
+	ASSERT_EQ(ThreadPool::getDefaultThreadCount(), pool.getThreadCount());
+}
+
+TEST_F(ThreadPoolTests,
+WaitWaitsForAllSubmittedTasks) {
+	ThreadPool pool(4);
+	std::atomic<int> counter(0);
+
+	for (int i = 0; i < 1000; ++i) {
+		pool.submit([&counter]() { ++counter; });
+	}
+	pool.wait();
+
+	ASSERT_EQ(1000, counter);
+}
+
+TEST_F(ThreadPoolTests,
+WaitRethrowsExceptionFromTask) {
+	ThreadPool pool(2);
+
+	pool.submit([]() { throw std::runtime_error("error"); });
+
+	ASSERT_THROW(pool.wait(), std::runtime_error);
+}
+
+TEST_F(ThreadPoolTests,
+WaitDoesNotRethrowSameExceptionTwice) {
+	ThreadPool pool(2);
+	pool.submit([]() { throw std::runtime_error("error"); });
+	EXPECT_THROW(pool.wait(), std::runtime_error);
+
+	ASSERT_NO_THROW(pool.wait());
+}
+
+TEST_F(ThreadPoolTests,
+ParallelForCallsFunctionForEveryIndexExactlyOnce) {
+	ThreadPool pool(4);
+	std::vector<int> calls(10000, 0);
+
+	pool.parallelFor(calls.size(), [&calls](std::size_t i) { ++calls[i]; });
+
+	ASSERT_EQ(std::vector<int>(calls.size(), 1), calls);
+}
+
+TEST_F(ThreadPoolTests,
+ParallelForWithZeroCountDoesNothing) {
+	ThreadPool pool(2);
+	bool called = false;
+
+	pool.parallelFor(0, [&called](std::size_t) { called = true; });
+
+	ASSERT_FALSE(called);
+}
+
+TEST_F(ThreadPoolTests,
+ParallelForRethrowsExceptionAndProcessesRemainingIndexes) {
+	ThreadPool pool(4);
+	std::vector<int> calls(100, 0);
+
+	ASSERT_THROW(
+		pool.parallelFor(calls.size(), [&calls](std::size_t i) {
+			++calls[i];
+			if (i == 50) {
+				throw std::runtime_error("error");
+			}
+		}),
+		std::runtime_error
+	);
+	ASSERT_EQ(std::vector<int>(calls.size(), 1), calls);
+}
+
+TEST_F(ThreadPoolTests,
+NestedParallelForDoesNotDeadlock) {
+	ThreadPool pool(2);
+	std::vector<std::vector<std::size_t>> results(8);
+
+	pool.parallelFor(results.size(), [&pool, &results](std::size_t i) {
+		results[i].resize(100);
+		pool.parallelFor(results[i].size(), [&results, i](std::size_t j) {
+			results[i][j] = i * j;
+		});
+	});
+
+	for (std::size_t i = 0; i < results.size(); ++i) {
+		ASSERT_EQ(
+			i * (99 * 100 / 2),
+			std::accumulate(results[i].begin(), results[i].end(), std::size_t(0))
+		);
+	}
+}
+
+TEST_F(ThreadPoolTests,
+DestructorWaitsForSubmittedTasks) {
+	std::atomic<int> counter(0);
+	{
+		ThreadPool pool(2);
+		for (int i = 0; i < 100; ++i) {
+			pool.submit([&counter]() { ++counter; });
+		}
+	}
+
+	ASSERT_EQ(100, counter);
+}
+
+} // namespace tests
+} // namespace utils
+} // namespace retdec
@@ -0,0 +1,373 @@
+/**
+ * @file tests/yaracpp/yara_detector_tests.cpp
+ * @brief Tests for the @c yara_detector module.
+ * @copyright (c) 2017 Avast Software, licensed under the MIT license
+ */
+
+#include <chrono>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <yara.h>
+
+#include "retdec/utils/filesystem.h"
+#include "retdec/yaracpp/yara_detector.h"
+#include "utils/temporary_directory.h"
+
+using namespace ::testing;
+
+namespace retdec {
+namespace yaracpp {
+namespace tests {
+
+class YaraDetectorTests : public Test
+{
+	protected:
+		~YaraDetectorTests() override
+		{
+			YaraDetector::setCacheDirectory(std::string());
+		}
+
+		/**
+		 * Write rule file @a name with @a content into the test directory.
+		 * @return Path to the file.
+		 */
+		std::string writeRuleFile(
+				const std::string& name,
+				const std::string& content)
+		{
+			const auto path = (directory / name).string();
+			std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+			return path;
+		}
+
+		/**
+		 * Compile @a sources (pairs of namespace and rules) into precompiled
+		 * rule file @a name in the test directory.
+		 * @return Path to the file.
+		 */
+		std::string writeCompiledRuleFile(
+				const std::string& name,
+				const std::vector<std::pair<std::string, std::string>>& sources)
+		{
+			const auto path = (directory / name).string();
+			EXPECT_EQ(ERROR_SUCCESS, yr_initialize());
+			YR_COMPILER* compiler = nullptr;
+			EXPECT_EQ(ERROR_SUCCESS, yr_compiler_create(&compiler));
+			for (const auto& source : sources)
+			{
+				EXPECT_EQ(0, yr_compiler_add_string(
+						compiler,
+						source.second.c_str(),
+						source.first.empty() ? nullptr : source.first.c_str()));
+			}
+			YR_RULES* rules = nullptr;
+			EXPECT_EQ(ERROR_SUCCESS, yr_compiler_get_rules(compiler, &rules));
+			EXPECT_EQ(ERROR_SUCCESS, yr_rules_save(rules, path.c_str()));
+			yr_rules_destroy(rules);
+			yr_compiler_destroy(compiler);
+			yr_finalize();
+			return path;
+		}
+
+		/**
+		 * Get names and rule files of detected rules of @a detector.
+		 */
+		std::vector<std::pair<std::string, std::string>> getDetected(
+				const YaraDetector& detector)
+		{
+			std::vector<std::pair<std::string, std::string>> result;
+			for (const auto& rule : detector.getDetectedRules())
+			{
+				result.emplace_back(rule.getName(), rule.getRuleFile());
+			}
+			return result;
+		}
+
+	protected:
+		const utils::tests::TemporaryDirectory directory{
+				"retdec-yaracpp-tests"};
+		std::vector<std::uint8_t> input = {0x4d, 0x5a, 0x90, 0x00};
+};
+
+TEST_F(YaraDetectorTests, RulesFromRuleFilesAreDetectedWithTheirFiles)
+{
+	const auto first = writeRuleFile("first.yar", "rule a { condition: true }");
+	const auto second = writeRuleFile("second.yar",
+			"rule b { condition: true }\n"
+			"rule c { condition: false }\n");
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFiles({first, second}));
+	ASSERT_TRUE(detector.analyze(input));
+
+	using Detected = std::vector<std::pair<std::string, std::string>>;
+	EXPECT_EQ(Detected({{"a", first}, {"b", second}}), getDetected(detector));
+}
+
+TEST_F(YaraDetectorTests, RulesWithSameNameInDifferentFilesAreDetectedSeparately)
+{
+	const auto first = writeRuleFile("first.yar", "rule a { condition: true }");
+	const auto second = writeRuleFile("second.yar", "rule a { condition: true }");
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFiles({first, second}));
+	ASSERT_TRUE(detector.analyze(input));
+
+	using Detected = std::vector<std::pair<std::string, std::string>>;
+	EXPECT_EQ(Detected({{"a", first}, {"a", second}}), getDetected(detector));
+}
+
+TEST_F(YaraDetectorTests, RulesFromAllFilesAreUndetectedIfStoreAllRulesIsSet)
+{
+	const auto first = writeRuleFile("first.yar", "rule a { condition: false }");
+	const auto second = writeRuleFile("second.yar", "rule b { condition: false }");
+
+	YaraDetector detector;
+	detector.addRuleFiles({first, second});
+	ASSERT_TRUE(detector.analyze(input, true));
+
+	ASSERT_EQ(2, detector.getUndetectedRules().size());
+	EXPECT_EQ(first, detector.getUndetectedRules()[0].getRuleFile());
+	EXPECT_EQ(second, detector.getUndetectedRules()[1].getRuleFile());
+}
+
+TEST_F(YaraDetectorTests, BrokenRuleFileDoesNotHideOtherRuleFiles)
+{
+	const auto first = writeRuleFile("first.yar", "rule a { condition: true }");
+	const auto broken = writeRuleFile("broken.yar", "rule { condition: }");
+	const auto second = writeRuleFile("second.yar", "rule b { condition: true }");
+
+	YaraDetector detector;
+	detector.addRuleFiles({first, broken, second});
+	ASSERT_TRUE(detector.analyze(input));
+
+	using Detected = std::vector<std::pair<std::string, std::string>>;
+	EXPECT_EQ(Detected({{"a", first}, {"b", second}}), getDetected(detector));
+}
+
+TEST_F(YaraDetectorTests, AddRuleFileFailsForNonexistentFile)
+{
+	YaraDetector detector;
+
+	EXPECT_FALSE(detector.addRuleFile((directory / "missing.yar").string()));
+	EXPECT_FALSE(detector.addRuleFiles({(directory / "missing.yar").string()}));
+}
+
+TEST_F(YaraDetectorTests, RelativeIncludeIsResolvedAgainstDirectoryOfRuleFile)
+{
+	writeRuleFile("included.yar", "rule included { condition: true }");
+	const auto main = writeRuleFile("main.yar",
+			"include \"included.yar\"\n"
+			"rule main { condition: included }\n");
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFile(main));
+	ASSERT_TRUE(detector.analyze(input));
+
+	ASSERT_EQ(2, detector.getDetectedRules().size());
+	EXPECT_EQ("included", detector.getDetectedRules()[0].getName());
+	EXPECT_EQ("main", detector.getDetectedRules()[1].getName());
+}
+
+TEST_F(YaraDetectorTests, RuleCanReferToRuleFromPreviousFileInSameNamespace)
+{
+	const auto first = writeRuleFile("first.yar", "rule a { condition: true }");
+	const auto second = writeRuleFile("second.yar", "rule b { condition: a }");
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFile(first));
+	ASSERT_TRUE(detector.addRuleFile(second));
+	ASSERT_TRUE(detector.analyze(input));
+
+	ASSERT_EQ(2, detector.getDetectedRules().size());
+	EXPECT_EQ("b", detector.getDetectedRules()[1].getName());
+}
+
+TEST_F(YaraDetectorTests, RulesAddedAsStringsAreScannedWithRuleFiles)
+{
+	const auto file = writeRuleFile("file.yar", "rule a { condition: true }");
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRules("rule s { condition: true }"));
+	ASSERT_TRUE(detector.addRuleFile(file, "file"));
+	ASSERT_TRUE(detector.analyze(input));
+
+	using Detected = std::vector<std::pair<std::string, std::string>>;
+	EXPECT_EQ(Detected({{"s", ""}, {"a", file}}), getDetected(detector));
+}
+
+TEST_F(YaraDetectorTests, ModifiedRuleFileIsCompiledAgain)
+{
+	const auto file = writeRuleFile("file.yar", "rule a { condition: true }");
+	{
+		YaraDetector detector;
+		detector.addRuleFile(file);
+		ASSERT_TRUE(detector.analyze(input));
+		ASSERT_EQ(1, detector.getDetectedRules().size());
+		EXPECT_EQ("a", detector.getDetectedRules()[0].getName());
+	}
+
+	writeRuleFile("file.yar", "rule modified { condition: true }");
+	fs::last_write_time(file,
+			fs::last_write_time(file) + std::chrono::seconds(10));
+
+	YaraDetector detector;
+	detector.addRuleFile(file);
+	ASSERT_TRUE(detector.analyze(input));
+	ASSERT_EQ(1, detector.getDetectedRules().size());
+	EXPECT_EQ("modified", detector.getDetectedRules()[0].getName());
+}
+
+TEST_F(YaraDetectorTests, CompiledRulesAreStoredInCacheDirectory)
+{
+	const auto cache = directory / "cache";
+	const auto file = writeRuleFile("cached.yar", "rule a { condition: true }");
+	YaraDetector::setCacheDirectory(cache.string());
+
+	YaraDetector detector;
+	detector.addRuleFile(file);
+	ASSERT_TRUE(detector.analyze(input));
+
+	std::size_t cachedFiles = 0;
+	for (const auto& entry : fs::directory_iterator(cache))
+	{
+		EXPECT_EQ(".yarac", entry.path().extension());
+		++cachedFiles;
+	}
+	EXPECT_EQ(1, cachedFiles);
+}
+
+TEST_F(YaraDetectorTests, RuleFileModifiedWithoutChangingSizeAndTimeIsCompiledAgain)
+{
+	const auto file = writeRuleFile("file.yar", "rule a { condition: true }");
+	const auto time = fs::last_write_time(file);
+	{
+		YaraDetector detector;
+		detector.addRuleFile(file);
+		ASSERT_TRUE(detector.analyze(input));
+		ASSERT_EQ(1, detector.getDetectedRules().size());
+		EXPECT_EQ("a", detector.getDetectedRules()[0].getName());
+	}
+
+	writeRuleFile("file.yar", "rule b { condition: true }");
+	fs::last_write_time(file, time);
+
+	YaraDetector detector;
+	detector.addRuleFile(file);
+	ASSERT_TRUE(detector.analyze(input));
+	ASSERT_EQ(1, detector.getDetectedRules().size());
+	EXPECT_EQ("b", detector.getDetectedRules()[0].getName());
+}
+
+TEST_F(YaraDetectorTests, RuleFileIsCompiledAgainWhenIncludedFileIsModified)
+{
+	writeRuleFile("included.yar", "rule a { condition: true }");
+	const auto main = writeRuleFile("main.yar",
+			"include \"included.yar\"\n"
+			"rule main { condition: true }\n");
+	{
+		YaraDetector detector;
+		detector.addRuleFile(main);
+		ASSERT_TRUE(detector.analyze(input));
+		ASSERT_EQ(2, detector.getDetectedRules().size());
+		EXPECT_EQ("a", detector.getDetectedRules()[0].getName());
+	}
+
+	writeRuleFile("included.yar", "rule b { condition: true }");
+
+	YaraDetector detector;
+	detector.addRuleFile(main);
+	ASSERT_TRUE(detector.analyze(input));
+	ASSERT_EQ(2, detector.getDetectedRules().size());
+	EXPECT_EQ("b", detector.getDetectedRules()[0].getName());
+}
+
+TEST_F(YaraDetectorTests, RulesWithIncludesAreStoredInCacheDirectory)
+{
+	const auto cache = directory / "cache";
+	writeRuleFile("included.yar", "rule included { condition: true }");
+	const auto main = writeRuleFile("main_cached.yar",
+			"include \"included.yar\"\n"
+			"rule main { condition: included }\n");
+	YaraDetector::setCacheDirectory(cache.string());
+
+	YaraDetector detector;
+	detector.addRuleFile(main);
+	ASSERT_TRUE(detector.analyze(input));
+
+	ASSERT_TRUE(fs::exists(cache));
+	EXPECT_FALSE(fs::is_empty(cache));
+}
+
+TEST_F(YaraDetectorTests, ReleasedRulesAreStillUsedByExistingDetectors)
+{
+	const auto file = writeRuleFile("file.yar", "rule a { condition: true }");
+	YaraDetector detector;
+	detector.addRuleFile(file);
+	ASSERT_TRUE(detector.analyze(input));
+
+	YaraDetector::releaseCompiledRules();
+
+	ASSERT_TRUE(detector.analyze(input));
+	EXPECT_EQ(2, detector.getDetectedRules().size());
+
+	YaraDetector other;
+	other.addRuleFile(file);
+	ASSERT_TRUE(other.analyze(input));
+	EXPECT_EQ(1, other.getDetectedRules().size());
+}
+
+TEST_F(YaraDetectorTests, SelectedPrecompiledFilesAreScannedByMergedRulesOfTheirDirectory)
+{
+	// Merged rules differ from the rule files to tell which ones were scanned
+	const auto first = writeCompiledRuleFile("first.yarac",
+			{{"", "rule a { condition: true }"}});
+	const auto second = writeCompiledRuleFile("second.yarac",
+			{{"", "rule b { condition: true }"}});
+	writeCompiledRuleFile("third.yarac", {{"", "rule c { condition: true }"}});
+	writeCompiledRuleFile("merged.yaracm", {
+			{"first.yarac", "rule merged_a { condition: true }"},
+			{"second.yarac", "rule merged_b { condition: true }"},
+			{"third.yarac",
+					"rule merged_c { condition: true }\n"
+					"rule merged_d { condition: false }\n"}});
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFiles({first, second}));
+	ASSERT_TRUE(detector.analyze(input, true));
+
+	using Detected = std::vector<std::pair<std::string, std::string>>;
+	EXPECT_EQ(Detected({{"merged_a", first}, {"merged_b", second}}),
+			getDetected(detector));
+	EXPECT_TRUE(detector.getUndetectedRules().empty());
+}
+
+TEST_F(YaraDetectorTests, PrecompiledFileNewerThanMergedRulesIsScannedAlone)
+{
+	const auto first = writeCompiledRuleFile("first.yarac",
+			{{"", "rule a { condition: true }"}});
+	const auto second = writeCompiledRuleFile("second.yarac",
+			{{"", "rule b { condition: true }"}});
+	const auto third = writeCompiledRuleFile("third.yarac",
+			{{"", "rule c { condition: true }"}});
+	const auto merged = writeCompiledRuleFile("merged.yaracm", {
+			{"first.yarac", "rule merged_a { condition: true }"},
+			{"second.yarac", "rule merged_b { condition: true }"}});
+	fs::last_write_time(first,
+			fs::last_write_time(merged) + std::chrono::seconds(10));
+
+	YaraDetector detector;
+	ASSERT_TRUE(detector.addRuleFiles({first, second, third}));
+	ASSERT_TRUE(detector.analyze(input));
+
+	using Detected = std::vector<std::pair<std::string, std::string>>;
+	EXPECT_EQ(Detected({{"a", first}, {"c", third}, {"merged_b", second}}),
+			getDetected(detector));
+}
+
+} // namespace tests
+} // namespace yaracpp
+} // namespace retdec